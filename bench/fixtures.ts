@@ -0,0 +1,260 @@
+/**
+ * Repeatable benchmark fixtures
+ *
+ * Meshes are generated procedurally so every run (and every machine) remeshes
+ * exactly the same input. Metrics are scaled with the grid spacing, so the
+ * output grows with the input size.
+ */
+
+import { MeshType } from "../src";
+
+/** Generated mesh, with 1-indexed cells (MMG convention) */
+export interface GeneratedMesh {
+  vertices: Float64Array;
+  cells: Int32Array;
+}
+
+export type BenchSize = "small" | "medium" | "large";
+export type BenchMetric = "isotropic" | "anisotropic";
+
+/** One benchmark case: a generated mesh and a metric on it */
+export interface BenchCase {
+  /** Unique name, used as the key in baseline files */
+  name: string;
+  type: MeshType;
+  size: BenchSize;
+  metric: BenchMetric;
+  createMesh: () => GeneratedMesh;
+  /**
+   * Metric values for the generated vertices: one size per vertex
+   * (isotropic) or a symmetric tensor per vertex (anisotropic)
+   */
+  createMetric: (vertices: Float64Array) => Float64Array;
+}
+
+/**
+ * Generate a unit cube split into 6n³ tetrahedra
+ */
+export function generateCubeMesh(gridSize: number): GeneratedMesh {
+  const n = gridSize;
+  const vertices: number[] = [];
+  const tetrahedra: number[] = [];
+
+  for (let i = 0; i <= n; i++) {
+    for (let j = 0; j <= n; j++) {
+      for (let k = 0; k <= n; k++) {
+        vertices.push(i / n, j / n, k / n);
+      }
+    }
+  }
+
+  const idx = (i: number, j: number, k: number) =>
+    i * (n + 1) * (n + 1) + j * (n + 1) + k + 1;
+
+  for (let i = 0; i < n; i++) {
+    for (let j = 0; j < n; j++) {
+      for (let k = 0; k < n; k++) {
+        const v0 = idx(i, j, k);
+        const v1 = idx(i + 1, j, k);
+        const v2 = idx(i + 1, j + 1, k);
+        const v3 = idx(i, j + 1, k);
+        const v4 = idx(i, j, k + 1);
+        const v6 = idx(i + 1, j + 1, k + 1);
+        const v7 = idx(i, j + 1, k + 1);
+
+        tetrahedra.push(v0, v1, v3, v4);
+        tetrahedra.push(v1, v2, v3, v6);
+        tetrahedra.push(v3, v4, v6, v7);
+        tetrahedra.push(v1, v3, v4, v6);
+      }
+    }
+  }
+
+  return {
+    vertices: new Float64Array(vertices),
+    cells: new Int32Array(tetrahedra),
+  };
+}
+
+/**
+ * Generate a unit square split into 2n² triangles
+ */
+export function generateSquareMesh(gridSize: number): GeneratedMesh {
+  const n = gridSize;
+  const vertices: number[] = [];
+  const triangles: number[] = [];
+
+  for (let i = 0; i <= n; i++) {
+    for (let j = 0; j <= n; j++) {
+      vertices.push(i / n, j / n);
+    }
+  }
+
+  const idx = (i: number, j: number) => i * (n + 1) + j + 1;
+
+  for (let i = 0; i < n; i++) {
+    for (let j = 0; j < n; j++) {
+      const v0 = idx(i, j);
+      const v1 = idx(i + 1, j);
+      const v2 = idx(i + 1, j + 1);
+      const v3 = idx(i, j + 1);
+
+      triangles.push(v0, v1, v2);
+      triangles.push(v0, v2, v3);
+    }
+  }
+
+  return {
+    vertices: new Float64Array(vertices),
+    cells: new Int32Array(triangles),
+  };
+}
+
+/**
+ * Generate a surface mesh (UV sphere approximation)
+ */
+export function generateSphereMesh(segments: number): GeneratedMesh {
+  const vertices: number[] = [];
+  const triangles: number[] = [];
+
+  for (let i = 0; i <= segments; i++) {
+    const theta = (i * Math.PI) / segments;
+    for (let j = 0; j <= segments; j++) {
+      const phi = (j * 2 * Math.PI) / segments;
+      vertices.push(
+        Math.sin(theta) * Math.cos(phi),
+        Math.sin(theta) * Math.sin(phi),
+        Math.cos(theta),
+      );
+    }
+  }
+
+  for (let i = 0; i < segments; i++) {
+    for (let j = 0; j < segments; j++) {
+      const v0 = i * (segments + 1) + j + 1;
+      const v1 = v0 + segments + 1;
+      const v2 = v0 + 1;
+      const v3 = v1 + 1;
+
+      triangles.push(v0, v1, v2);
+      triangles.push(v2, v1, v3);
+    }
+  }
+
+  return {
+    vertices: new Float64Array(vertices),
+    cells: new Int32Array(triangles),
+  };
+}
+
+/**
+ * Isotropic size field growing linearly along x, from hmin to hmax
+ */
+export function isotropicMetric(
+  vertices: Float64Array,
+  dimension: 2 | 3,
+  hmin: number,
+  hmax: number,
+): Float64Array {
+  const n = vertices.length / dimension;
+  let xmin = Number.POSITIVE_INFINITY;
+  let xmax = Number.NEGATIVE_INFINITY;
+  for (let i = 0; i < n; i++) {
+    xmin = Math.min(xmin, vertices[i * dimension]);
+    xmax = Math.max(xmax, vertices[i * dimension]);
+  }
+
+  const range = xmax > xmin ? xmax - xmin : 1;
+  const sizes = new Float64Array(n);
+  for (let i = 0; i < n; i++) {
+    const t = (vertices[i * dimension] - xmin) / range;
+    sizes[i] = hmin + (hmax - hmin) * t;
+  }
+  return sizes;
+}
+
+/**
+ * Anisotropic metric refined along the last axis: edges of length hfine in
+ * that direction and hcoarse in the others (m11, m12, m22 in 2D;
+ * m11, m12, m13, m22, m23, m33 in 3D)
+ */
+export function anisotropicMetric(
+  vertices: Float64Array,
+  dimension: 2 | 3,
+  hfine: number,
+  hcoarse: number,
+): Float64Array {
+  const n = vertices.length / dimension;
+  const coarse = 1 / (hcoarse * hcoarse);
+  const fine = 1 / (hfine * hfine);
+  const tensor =
+    dimension === 2 ? [coarse, 0, fine] : [coarse, 0, 0, coarse, 0, fine];
+
+  const values = new Float64Array(n * tensor.length);
+  for (let i = 0; i < n; i++) {
+    values.set(tensor, i * tensor.length);
+  }
+  return values;
+}
+
+/** Grid resolution of each fixture size, per mesh type */
+const GRID_SIZES: Record<MeshType, Record<BenchSize, number>> = {
+  [MeshType.Mesh2D]: { small: 20, medium: 60, large: 150 },
+  [MeshType.Mesh3D]: { small: 6, medium: 12, large: 20 },
+  [MeshType.MeshS]: { small: 16, medium: 40, large: 80 },
+};
+
+function createCase(
+  type: MeshType,
+  size: BenchSize,
+  metric: BenchMetric,
+): BenchCase {
+  const n = GRID_SIZES[type][size];
+  const dimension = type === MeshType.Mesh2D ? 2 : 3;
+
+  let createMesh: () => GeneratedMesh;
+  let spacing: number;
+  switch (type) {
+    case MeshType.Mesh2D:
+      createMesh = () => generateSquareMesh(n);
+      spacing = 1 / n;
+      break;
+    case MeshType.Mesh3D:
+      createMesh = () => generateCubeMesh(n);
+      spacing = 1 / n;
+      break;
+    case MeshType.MeshS:
+      createMesh = () => generateSphereMesh(n);
+      spacing = Math.PI / n;
+      break;
+    default:
+      throw new Error(`Unknown mesh type: ${type}`);
+  }
+
+  return {
+    name: `${type}-${size}-${metric}`,
+    type,
+    size,
+    metric,
+    createMesh,
+    createMetric: (vertices) =>
+      metric === "isotropic"
+        ? isotropicMetric(vertices, dimension, 0.5 * spacing, 2 * spacing)
+        : anisotropicMetric(vertices, dimension, 0.5 * spacing, 2 * spacing),
+  };
+}
+
+/**
+ * Every benchmark case, smallest first within each mesh type
+ */
+export const BENCH_CASES: BenchCase[] = [
+  MeshType.Mesh2D,
+  MeshType.Mesh3D,
+  MeshType.MeshS,
+].flatMap((type) =>
+  (["small", "medium", "large"] as const).flatMap((size) =>
+    (["isotropic", "anisotropic"] as const).map((metric) =>
+      createCase(type, size, metric),
+    ),
+  ),
+);
@@ -0,0 +1,419 @@
+/**
+ * Benchmark suite with per-phase timings and regression baselines
+ *
+ * Remeshes the fixtures of bench/fixtures.ts and reports, for each case, the
+ * median time spent in every phase of a `Mesh.remesh()` round trip (JS to
+ * WASM marshalling, native clone, quality passes, MMG itself, marshalling
+ * back), the most memory the C side held during the timed runs, the WASM
+ * linear memory size and the output vertices per second.
+ *
+ * Usage:
+ *   bun run bench                              # run every case
+ *   bun run bench --filter 3d-medium           # cases whose name contains it
+ *   bun run bench --compare bench/baseline.json
+ *   bun run bench:baseline                     # record bench/baseline.json
+ *
+ * Options:
+ *   --iterations <n>   Timed runs per case (default: 5)
+ *   --warmup <n>       Untimed runs per case (default: 1)
+ *   --filter <text>    Only run cases whose name contains the text
+ *   --variant <name>   WASM build to load: scalar, simd or threads
+ *                      (default: the fastest supported one)
+ *   --save <file>      Write the report as a baseline JSON file
+ *   --compare <file>   Compare against a baseline, exit 1 on regressions or
+ *                      when the baseline has none of the cases run
+ *   --threshold <r>    Relative slowdown counted as a regression (default: 0.2)
+ *   --summary <file>   Append a Markdown table (e.g. $GITHUB_STEP_SUMMARY)
+ */
+
+import { appendFileSync, readFileSync, writeFileSync } from "node:fs";
+import { arch, cpus, platform } from "node:os";
+import { parseArgs } from "node:util";
+import {
+  Mesh,
+  MeshType,
+  type RemeshResult,
+  type WasmModule,
+  type WasmVariant,
+  getMemoryStats,
+  getWasmModule,
+  getWasmModule2D,
+  getWasmModuleS,
+  getWasmVariant,
+  initMMG2D,
+  initMMG3D,
+  initMMGS,
+  resetNativePeak,
+  setWasmVariant,
+} from "../src";
+import { BENCH_CASES, type BenchCase } from "./fixtures";
+
+/** Version of the report format, bumped when results stop being comparable */
+const REPORT_VERSION = 1;
+
+/** Phases of a remesh round trip, in the order they run */
+const PHASES = [
+  "import",
+  "metric",
+  "clone",
+  "sizing",
+  "quality",
+  "remesh",
+  "export",
+] as const;
+
+type Phase = (typeof PHASES)[number];
+
+/** Median measurements of one case */
+interface CaseResult {
+  type: MeshType;
+  size: string;
+  metric: string;
+  iterations: number;
+  inputVertices: number;
+  outputVertices: number;
+  /** Median milliseconds per phase */
+  phases: Record<Phase, number>;
+  /** Median milliseconds of the whole round trip */
+  totalMs: number;
+  /** Most bytes the C side held at once during the timed runs */
+  peakNativeBytes: number;
+  /**
+   * WASM linear memory size when the case finished. It never shrinks and is
+   * shared by every case of the module, so it reflects the largest case so far
+   */
+  heapBytes: number;
+  /** Output vertices per second of MMG time */
+  verticesPerSecond: number;
+}
+
+/** Benchmark report, also the format of baseline files */
+interface BenchReport {
+  version: number;
+  createdAt: string;
+  environment: {
+    runtime: string;
+    platform: string;
+    cpu: string;
+    variant: WasmVariant | null;
+  };
+  results: Record<string, CaseResult>;
+}
+
+function median(values: number[]): number {
+  const sorted = [...values].sort((a, b) => a - b);
+  const mid = sorted.length >> 1;
+  return sorted.length % 2 === 1
+    ? sorted[mid]
+    : (sorted[mid - 1] + sorted[mid]) / 2;
+}
+
+function caseModule(type: MeshType): WasmModule {
+  switch (type) {
+    case MeshType.Mesh2D:
+      return getWasmModule2D();
+    case MeshType.Mesh3D:
+      return getWasmModule();
+    case MeshType.MeshS:
+      return getWasmModuleS();
+    default:
+      throw new Error(`Unknown mesh type: ${type}`);
+  }
+}
+
+/**
+ * Run one case: warmup runs first, then timed runs whose phase times are
+ * reduced to their medians
+ */
+async function runCase(
+  benchCase: BenchCase,
+  iterations: number,
+  warmup: number,
+): Promise<CaseResult> {
+  const input = benchCase.createMesh();
+  const metric = benchCase.createMetric(input.vertices);
+  const dimension = benchCase.type === MeshType.Mesh2D ? 2 : 3;
+  const module = caseModule(benchCase.type);
+
+  const samples = Object.fromEntries(
+    PHASES.map((phase) => [phase, [] as number[]]),
+  ) as Record<Phase, number[]>;
+  const totals: number[] = [];
+  let outputVertices = 0;
+
+  for (let run = 0; run < warmup + iterations; run++) {
+    if (run === warmup) {
+      resetNativePeak(module);
+    }
+    const start = performance.now();
+    const mesh = new Mesh({
+      vertices: input.vertices,
+      cells: input.cells,
+      type: benchCase.type,
+    });
+    const imported = performance.now();
+
+    let metricSet: number;
+    let result: RemeshResult;
+    try {
+      if (benchCase.metric === "isotropic") {
+        mesh.setMetric(metric);
+      } else {
+        mesh.setMetricTensor(metric);
+      }
+      metricSet = performance.now();
+      result = await mesh.remesh();
+    } finally {
+      mesh.free();
+    }
+
+    // Marshal the output back to JS the way consumers do
+    const remeshed = performance.now();
+    void result.mesh.vertices;
+    void result.mesh.cells;
+    void result.mesh.boundaryFaces;
+    const exported = performance.now();
+    result.mesh.free();
+
+    outputVertices = result.nVertices;
+    if (run < warmup) {
+      continue;
+    }
+    const { timings } = result;
+    samples.import.push(imported - start);
+    samples.metric.push(metricSet - imported);
+    samples.clone.push(timings.clone);
+    samples.sizing.push(timings.sizing);
+    samples.quality.push(timings.quality);
+    samples.remesh.push(timings.remesh);
+    samples.export.push(exported - remeshed);
+    // Freeing the input mesh is not part of the round trip
+    totals.push(metricSet - start + result.elapsed + (exported - remeshed));
+  }
+
+  const phases = Object.fromEntries(
+    PHASES.map((phase) => [phase, median(samples[phase])]),
+  ) as Record<Phase, number>;
+
+  return {
+    type: benchCase.type,
+    size: benchCase.size,
+    metric: benchCase.metric,
+    iterations,
+    inputVertices: input.vertices.length / dimension,
+    outputVertices,
+    phases,
+    totalMs: median(totals),
+    peakNativeBytes: getMemoryStats(module).nativePeak,
+    heapBytes: module.HEAPU8.byteLength,
+    verticesPerSecond:
+      phases.remesh > 0 ? outputVertices / (phases.remesh / 1000) : 0,
+  };
+}
+
+/**
+ * Relative change of the total time against the baseline, or null when the
+ * baseline has no such case
+ */
+function relativeChange(
+  current: CaseResult,
+  baseline: BenchReport | null,
+  name: string,
+): number | null {
+  const reference = baseline?.results[name];
+  if (!reference || reference.totalMs <= 0) {
+    return null;
+  }
+  return (current.totalMs - reference.totalMs) / reference.totalMs;
+}
+
+function formatChange(change: number | null): string {
+  if (change === null) {
+    return "new";
+  }
+  const percent = (change * 100).toFixed(1);
+  return change >= 0 ? `+${percent}%` : `${percent}%`;
+}
+
+const COLUMNS = [
+  "Case",
+  "Import",
+  "Metric",
+  "Clone",
+  "Sizing",
+  "Quality",
+  "Remesh",
+  "Export",
+  "Total (ms)",
+  "vs base",
+  "Peak (MB)",
+  "Heap (MB)",
+  "Verts/sec",
+];
+
+function formatRow(
+  name: string,
+  result: CaseResult,
+  change: number | null,
+): string[] {
+  const ms = (value: number) => value.toFixed(1);
+  const megabytes = (bytes: number) => (bytes / (1024 * 1024)).toFixed(1);
+  return [
+    name,
+    ms(result.phases.import),
+    ms(result.phases.metric),
+    ms(result.phases.clone),
+    ms(result.phases.sizing),
+    ms(result.phases.quality),
+    ms(result.phases.remesh),
+    ms(result.phases.export),
+    ms(result.totalMs),
+    formatChange(change),
+    megabytes(result.peakNativeBytes),
+    megabytes(result.heapBytes),
+    Math.round(result.verticesPerSecond).toLocaleString("en-US"),
+  ];
+}
+
+function printTable(rows: string[][]): void {
+  const widths = COLUMNS.map((column, i) =>
+    Math.max(column.length, ...rows.map((row) => row[i].length)),
+  );
+  const line = (cells: string[]) =>
+    cells
+      .map((cell, i) =>
+        i === 0 ? cell.padEnd(widths[i]) : cell.padStart(widths[i]),
+      )
+      .join("  ");
+
+  console.log(line(COLUMNS));
+  console.log(widths.map((width) => "-".repeat(width)).join("  "));
+  for (const row of rows) {
+    console.log(line(row));
+  }
+}
+
+function markdownTable(rows: string[][]): string {
+  const line = (cells: string[]) => `| ${cells.join(" | ")} |`;
+  return [
+    line(COLUMNS),
+    line(COLUMNS.map((_, i) => (i === 0 ? "---" : "---:"))),
+    ...rows.map(line),
+  ].join("\n");
+}
+
+async function main(): Promise<number> {
+  const { values } = parseArgs({
+    options: {
+      iterations: { type: "string", default: "5" },
+      warmup: { type: "string", default: "1" },
+      filter: { type: "string" },
+      variant: { type: "string" },
+      save: { type: "string" },
+      compare: { type: "string" },
+      threshold: { type: "string", default: "0.2" },
+      summary: { type: "string" },
+    },
+  });
+
+  const iterations = Number.parseInt(values.iterations as string, 10);
+  const warmup = Number.parseInt(values.warmup as string, 10);
+  const threshold = Number.parseFloat(values.threshold as string);
+  if (!(iterations > 0) || !(warmup >= 0) || !(threshold >= 0)) {
+    throw new Error("--iterations, --warmup and --threshold must be positive");
+  }
+
+  if (values.variant) {
+    setWasmVariant(values.variant as WasmVariant);
+  }
+  await Promise.all([initMMG2D(), initMMG3D(), initMMGS()]);
+
+  const baseline: BenchReport | null = values.compare
+    ? JSON.parse(readFileSync(values.compare, "utf8"))
+    : null;
+  if (baseline && baseline.version !== REPORT_VERSION) {
+    throw new Error(
+      `Baseline format ${baseline.version} cannot be compared with ` +
+        `format ${REPORT_VERSION}`,
+    );
+  }
+
+  const report: BenchReport = {
+    version: REPORT_VERSION,
+    createdAt: new Date().toISOString(),
+    environment: {
+      runtime: `bun ${Bun.version}`,
+      platform: `${platform()} ${arch()}`,
+      cpu: cpus()[0]?.model ?? "unknown",
+      variant: getWasmVariant(),
+    },
+    results: {},
+  };
+
+  const baselineVariant = baseline?.environment?.variant;
+  if (baselineVariant && baselineVariant !== report.environment.variant) {
+    console.warn(
+      `Warning: the baseline was recorded with the ${baselineVariant} build, ` +
+        `this run uses ${report.environment.variant}`,
+    );
+  }
+
+  const cases = BENCH_CASES.filter(
+    (benchCase) => !values.filter || benchCase.name.includes(values.filter),
+  );
+  const rows: string[][] = [];
+  const regressions: string[] = [];
+  let compared = 0;
+
+  for (const benchCase of cases) {
+    const result = await runCase(benchCase, iterations, warmup);
+    report.results[benchCase.name] = result;
+
+    const change = relativeChange(result, baseline, benchCase.name);
+    if (change !== null) {
+      compared++;
+    }
+    if (change !== null && change > threshold) {
+      regressions.push(`${benchCase.name} (${formatChange(change)})`);
+    }
+    rows.push(formatRow(benchCase.name, result, change));
+  }
+
+  console.log(
+    `mmg-wasm benchmarks (${report.environment.variant} build, ` +
+      `median of ${iterations} runs, times in ms)\n`,
+  );
+  printTable(rows);
+
+  if (values.summary) {
+    appendFileSync(
+      values.summary,
+      `## Benchmarks (${report.environment.variant} build)\n\n` +
+        `${markdownTable(rows)}\n\n`,
+    );
+  }
+
+  if (values.save) {
+    writeFileSync(values.save, `${JSON.stringify(report, null, 2)}\n`);
+    console.log(`\nBaseline written to ${values.save}`);
+  }
+
+  // An empty or unrelated baseline would otherwise pass every comparison
+  if (baseline && compared === 0) {
+    console.error(
+      `\nThe baseline ${values.compare} has none of the ${cases.length} ` +
+        "case(s) run: record one with --save",
+    );
+    return 1;
+  }
+  if (regressions.length > 0) {
+    console.error(
+      `\n${regressions.length} case(s) slower than the baseline by more than ` +
+        `${(threshold * 100).toFixed(0)}%: ${regressions.join(", ")}`,
+    );
+    return 1;
+  }
+  return 0;
+}
+
+process.exit(await main());
@@ -4,6 +4,12 @@
 # - Emscripten version checking
 # - Common link flags for WASM builds
 # - Helper function for configuring WASM targets
+# - Optional SIMD (-msimd128) build variant
+# - Optional pthreads (SharedArrayBuffer) build variant
+# - Optional instrumentation (remesh statistics) build
+# - Optional WASMFS build with OPFS-backed files
+# - Optional Memory64 (wasm64) build for heaps beyond 4GB
+# - Optional per-mesh-type modules next to the combined one
 
 # Minimum recommended Emscripten version
 set(EMSCRIPTEN_MIN_VERSION "4.0.10")
@@ -40,6 +46,90 @@ if(NOT EMSCRIPTEN_VERSION STREQUAL "unknown")
     endif()
 endif()
 
+# SIMD build variant
+# When enabled, everything (including libmmg) is compiled with -msimd128 so
+# the float-heavy MMG kernels can be auto-vectorized. The artifact is named
+# mmg-simd.{js,wasm}; the loader picks it at runtime when SIMD is supported.
+option(MMG_WASM_SIMD "Build the WASM SIMD (-msimd128) variant" OFF)
+if(MMG_WASM_SIMD)
+    add_compile_options(-msimd128)
+    add_link_options(-msimd128)
+endif()
+
+# Pthreads build variant
+# Compiles everything with -pthread so several handles can be remeshed at the
+# same time on a pool of workers sharing one SharedArrayBuffer heap. Requires
+# a cross-origin isolated page (COOP/COEP) at runtime. The artifact is named
+# mmg-mt.{js,wasm}.
+option(MMG_WASM_PTHREADS "Build the pthreads (shared memory) variant" OFF)
+set(MMG_WASM_PTHREAD_POOL_SIZE 4 CACHE STRING
+    "Number of pre-spawned worker threads in the pthreads build")
+# Shared memory is fixed-size: growing a SharedArrayBuffer heap would leave
+# the JS views of other threads stale.
+set(MMG_WASM_PTHREAD_MEMORY 512MB CACHE STRING
+    "Heap size of the pthreads build")
+if(MMG_WASM_PTHREADS)
+    add_compile_options(-pthread)
+    add_link_options(-pthread)
+endif()
+
+# Instrumentation build
+# Records per-phase timings and operation counts of every remesh (src/stats.h),
+# read with mmgX_get_stats and surfaced as RemeshResult.stats. MMG then runs
+# at a higher verbosity whose extra output is parsed and dropped, so this is
+# meant for profiling rather than production. Combines with the other
+# variants and keeps their artifact names.
+option(MMG_WASM_STATS "Build with remesh instrumentation" OFF)
+if(MMG_WASM_STATS)
+    add_compile_definitions(MMGWASM_STATS)
+endif()
+
+# OPFS build variant
+# Replaces MEMFS with WASMFS so directories can be mounted on the Origin
+# Private File System (src/opfs.h): meshes and solutions there are streamed
+# from and to disk instead of being held whole in the heap. The OPFS backend
+# blocks on a helper thread, so this variant requires MMG_WASM_PTHREADS and
+# is only usable from workers; raise MMG_WASM_PTHREAD_MEMORY (up to 4GB) for
+# very large meshes. The artifact is named mmg-opfs.{js,wasm}.
+option(MMG_WASM_WASMFS "Build the WASMFS variant with OPFS-backed files" OFF)
+if(MMG_WASM_WASMFS)
+    if(NOT MMG_WASM_PTHREADS)
+        message(FATAL_ERROR "MMG_WASM_WASMFS requires MMG_WASM_PTHREADS=ON")
+    endif()
+    add_compile_definitions(MMGWASM_WASMFS)
+    add_link_options(-sWASMFS)
+endif()
+
+# Memory64 build variant
+# Compiles everything, libmmg included, with -sMEMORY64 so the heap can grow
+# past the 4GB of wasm32 (up to MMG_WASM_MEMORY64_MAXIMUM). MMG5_int stays
+# 32-bit: 2^31 entities is far more than fits in the heap anyway, so only
+# pointers and sizes widen to 64 bits (see src/memory64.ts for the bindings).
+# The loader only picks it when the meshes need more than the wasm32 heap.
+# The artifact is named mmg-64.{js,wasm}.
+option(MMG_WASM_MEMORY64 "Build the Memory64 (wasm64) variant" OFF)
+set(MMG_WASM_MEMORY64_MAXIMUM 16GB CACHE STRING
+    "Maximum heap size of the Memory64 build")
+if(MMG_WASM_MEMORY64)
+    if(MMG_WASM_PTHREADS)
+        message(FATAL_ERROR "MMG_WASM_MEMORY64 cannot be combined with MMG_WASM_PTHREADS")
+    endif()
+    add_compile_options(-sMEMORY64)
+    add_link_options(-sMEMORY64)
+endif()
+
+# Per-mesh-type modules
+# Also builds mmg3d, mmg2d and mmgs, each linking only its own libmmg library
+# and exporting only its own wrappers, so a page using a single mesh type
+# downloads and compiles a fraction of the combined module. Combines with the
+# other variants, whose suffixes they take (e.g. mmg2d-simd.{js,wasm}).
+option(MMG_WASM_SPLIT_MODULES "Also build one module per mesh type" OFF)
+
+# Output directory for the generated .js/.wasm files. The SIMD and pthreads
+# variants are built in their own trees but installed next to the scalar build.
+set(MMG_WASM_OUTPUT_DIR "${CMAKE_BINARY_DIR}/dist" CACHE PATH
+    "Output directory for generated WASM artifacts")
+
 # Common Emscripten link flags for all WASM targets
 set(MMG_WASM_LINK_FLAGS
     # ES6 module output
@@ -65,6 +155,18 @@ set(MMG_WASM_LINK_FLAGS
     -sEXPORTED_RUNTIME_METHODS=['ccall','cwrap','UTF8ToString','stringToUTF8','lengthBytesUTF8','getValue','setValue','HEAP32','HEAPF64','HEAPU8','FS']
 )
 
+# Additional flags for the pthreads build (override the memory settings above)
+set(MMG_WASM_LINK_FLAGS_PTHREADS
+    -sPTHREAD_POOL_SIZE=${MMG_WASM_PTHREAD_POOL_SIZE}
+    -sALLOW_MEMORY_GROWTH=0
+    -sINITIAL_MEMORY=${MMG_WASM_PTHREAD_MEMORY}
+)
+
+# Additional flags for the Memory64 build (raise the heap limit above)
+set(MMG_WASM_LINK_FLAGS_MEMORY64
+    -sMAXIMUM_MEMORY=${MMG_WASM_MEMORY64_MAXIMUM}
+)
+
 # Additional flags for Release builds
 # Note: --closure=1 is NOT used because it minifies the FS API method names
 # which breaks the file I/O bindings (FS.writeFile, FS.readFile, etc.)
@@ -81,11 +183,24 @@ set(MMG_WASM_LINK_FLAGS_DEBUG
     -sSAFE_HEAP=1
 )
 
-# Helper function to configure a WASM target with standard mmg-wasm settings
+# Helper function to configure a WASM target with standard mmg-wasm settings.
+# An optional second argument names the artifacts (default: the target name).
 function(configure_wasm_target TARGET_NAME)
+    set(OUTPUT_BASE ${TARGET_NAME})
+    if(ARGC GREATER 1)
+        set(OUTPUT_BASE ${ARGV1})
+    endif()
+
     # Apply common link flags
     target_link_options(${TARGET_NAME} PRIVATE ${MMG_WASM_LINK_FLAGS})
 
+    if(MMG_WASM_PTHREADS)
+        target_link_options(${TARGET_NAME} PRIVATE ${MMG_WASM_LINK_FLAGS_PTHREADS})
+    endif()
+    if(MMG_WASM_MEMORY64)
+        target_link_options(${TARGET_NAME} PRIVATE ${MMG_WASM_LINK_FLAGS_MEMORY64})
+    endif()
+
     # Apply build-type specific flags
     target_link_options(${TARGET_NAME} PRIVATE
         $<$<CONFIG:Release>:${MMG_WASM_LINK_FLAGS_RELEASE}>
@@ -95,8 +210,31 @@ function(configure_wasm_target TARGET_NAME)
     # Set output to .js (Emscripten generates both .js and .wasm)
     set_target_properties(${TARGET_NAME} PROPERTIES
         SUFFIX ".js"
-        RUNTIME_OUTPUT_DIRECTORY "${CMAKE_BINARY_DIR}/dist"
+        RUNTIME_OUTPUT_DIRECTORY "${MMG_WASM_OUTPUT_DIR}"
     )
 
+    # Variants ship alongside the scalar build under their own name
+    if(MMG_WASM_WASMFS)
+        set_target_properties(${TARGET_NAME} PROPERTIES
+            OUTPUT_NAME "${OUTPUT_BASE}-opfs"
+        )
+    elseif(MMG_WASM_PTHREADS)
+        set_target_properties(${TARGET_NAME} PROPERTIES
+            OUTPUT_NAME "${OUTPUT_BASE}-mt"
+        )
+    elseif(MMG_WASM_MEMORY64)
+        set_target_properties(${TARGET_NAME} PROPERTIES
+            OUTPUT_NAME "${OUTPUT_BASE}-64"
+        )
+    elseif(MMG_WASM_SIMD)
+        set_target_properties(${TARGET_NAME} PROPERTIES
+            OUTPUT_NAME "${OUTPUT_BASE}-simd"
+        )
+    else()
+        set_target_properties(${TARGET_NAME} PROPERTIES
+            OUTPUT_NAME "${OUTPUT_BASE}"
+        )
+    endif()
+
     message(STATUS "Configured WASM target: ${TARGET_NAME}")
 endfunction()
@@ -25,6 +25,7 @@ fi
 
 # Check if build artifacts exist
 WASM_FILE="build/dist/mmg.wasm"
+WASM_SIMD_FILE="build/dist/mmg-simd.wasm"
 JS_FILE="build/dist/mmg.js"
 TS_FILE="dist/index.js"
 
@@ -70,6 +71,17 @@ echo "  Gzipped size:    $(format_size $WASM_GZIP)"
 echo "  Budget:          $(format_size $WASM_MAX_GZIP) gzipped"
 echo ""
 
+WASM_SIMD_GZIP=0
+if [ -f "$WASM_SIMD_FILE" ]; then
+    WASM_SIMD_SIZE=$(stat -c%s "$WASM_SIMD_FILE" 2>/dev/null || stat -f%z "$WASM_SIMD_FILE")
+    WASM_SIMD_GZIP=$(gzip -c "$WASM_SIMD_FILE" | wc -c)
+    echo "WASM SIMD Binary ($WASM_SIMD_FILE):"
+    echo "  Raw size:        $(format_size $WASM_SIMD_SIZE)"
+    echo "  Gzipped size:    $(format_size $WASM_SIMD_GZIP)"
+    echo "  Budget:          $(format_size $WASM_MAX_GZIP) gzipped"
+    echo ""
+fi
+
 if [ "$JS_SIZE" -gt 0 ]; then
     echo "JS Runtime ($JS_FILE):"
     echo "  Size:            $(format_size $JS_SIZE)"
@@ -108,6 +120,13 @@ else
     echo -e "${GREEN}✓ WASM within budget ($(( (WASM_MAX_GZIP - WASM_GZIP) * 100 / WASM_MAX_GZIP ))% headroom)${NC}"
 fi
 
+if [ "$WASM_SIMD_GZIP" -gt "$WASM_MAX_GZIP" ]; then
+    echo -e "${RED}✗ WASM SIMD exceeds budget by $(format_size $((WASM_SIMD_GZIP - WASM_MAX_GZIP)))${NC}"
+    FAILED=true
+elif [ "$WASM_SIMD_GZIP" -gt 0 ]; then
+    echo -e "${GREEN}✓ WASM SIMD within budget${NC}"
+fi
+
 if [ "$JS_SIZE" -gt "$JS_RUNTIME_MAX" ]; then
     echo -e "${RED}✗ JS Runtime exceeds budget${NC}"
     FAILED=true
@@ -0,0 +1,460 @@
+/**
+ * Per-handle arenas for MMG's allocations (see arena.h)
+ *
+ * An arena is a list of blocks from the regular heap. Small allocations are
+ * carved out of the current chunk, preceded by their size; the most recent
+ * one can be grown or freed in place, and a chunk is reused (or returned to
+ * the heap) once all of its allocations are freed. Large allocations (entity
+ * arrays, hash tables) get a block of their own, returned to the heap as
+ * soon as they are freed.
+ *
+ * Blocks are aligned on and span whole ARENA_PAGE pages, and a page map
+ * gives the block owning each page of the heap, so free and realloc tell
+ * arena memory from regular heap memory with one lock-free load.
+ *
+ * The wrappers also follow the bytes allocated on the heap between reads of
+ * the allocator's own count, for the peak of mmgwasm_native_heap_peak.
+ */
+
+#include <emscripten.h>
+#include <emscripten/heap.h>
+#include <malloc.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "arena.h"
+#include "threads.h"
+
+/* Alignment of every allocation, that of max_align_t */
+#define ARENA_ALIGN 16
+#define ALIGN_UP(n) (((n) + (ARENA_ALIGN - 1)) & ~(size_t)(ARENA_ALIGN - 1))
+
+/* Chunk sizes follow the arena capacity within these bounds */
+#define ARENA_MIN_CHUNK ((size_t)256 * 1024)
+#define ARENA_MAX_CHUNK ((size_t)4 * 1024 * 1024)
+
+/* Allocations above this get a block of their own */
+#define ARENA_LARGE ((size_t)64 * 1024)
+
+/* Largest request served, leaving room for the headers */
+#define ARENA_MAX_REQUEST (SIZE_MAX / 2)
+
+/* Offset of a chunk's last allocation when it cannot be rolled back */
+#define NO_LAST SIZE_MAX
+
+/* Blocks are made of whole pages of the page map (64KB) */
+#define ARENA_PAGE_SHIFT 16
+#define ARENA_PAGE ((size_t)1 << ARENA_PAGE_SHIFT)
+#define PAGE_UP(n) (((n) + (ARENA_PAGE - 1)) & ~(ARENA_PAGE - 1))
+
+struct MmgwasmArenaBlock {
+    MmgwasmArenaBlock* prev;
+    MmgwasmArenaBlock* next;
+    MmgwasmArena* owner;
+    size_t size;    /* usable bytes after the header */
+    size_t used;    /* bytes handed out, for chunks */
+    size_t last;    /* offset of the last allocation in a chunk */
+    size_t live;    /* allocations of a chunk not freed yet */
+    int dedicated;  /* 1 if the block holds a single allocation */
+};
+
+#define BLOCK_HEADER ALIGN_UP(sizeof(MmgwasmArenaBlock))
+#define BLOCK_DATA(block) ((char*)(block) + BLOCK_HEADER)
+
+/* Small allocations are preceded by their requested size */
+#define ALLOC_HEADER ARENA_ALIGN
+#define ALLOC_SIZE(ptr) (*(size_t*)((char*)(ptr) - ALLOC_HEADER))
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+
+/* Arena receiving the allocations of the current thread, NULL for the heap */
+static _Thread_local MmgwasmArena* t_arena = NULL;
+
+/*
+ * Native usage is read from the allocator (mallinfo), which walks the heap,
+ * so the wrappers only follow how usage changed since the last peak reset,
+ * from the usable size of each allocation, to know the peak between reads.
+ * The change is signed: memory allocated inside libc (strdup, stdio buffers)
+ * may be freed through the wrappers, and only makes it go down as it did.
+ */
+static size_t g_heap_base = 0;     /* heap usage at the last reset */
+static ptrdiff_t g_heap_delta = 0; /* change since, through the wrappers */
+static ptrdiff_t g_heap_delta_peak = 0;
+
+static void count_alloc(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    ptrdiff_t delta = __atomic_add_fetch(
+        &g_heap_delta, (ptrdiff_t)malloc_usable_size(ptr), __ATOMIC_RELAXED);
+    ptrdiff_t peak = __atomic_load_n(&g_heap_delta_peak, __ATOMIC_RELAXED);
+    while (delta > peak &&
+           !__atomic_compare_exchange_n(&g_heap_delta_peak, &peak, delta, 1,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+static void count_free(size_t bytes) {
+    __atomic_sub_fetch(&g_heap_delta, (ptrdiff_t)bytes, __ATOMIC_RELAXED);
+}
+
+/* Bytes allocated on the heap; mallinfo's fields may be ints, read unsigned */
+static size_t heap_in_use(void) {
+    struct mallinfo info = mallinfo();
+    if (sizeof(info.uordblks) < sizeof(size_t)) {
+        return (size_t)(unsigned int)info.uordblks;
+    }
+    return (size_t)info.uordblks;
+}
+
+/* Regular heap allocations, counted */
+static void* heap_malloc(size_t size) {
+    void* ptr = __real_malloc(size);
+    count_alloc(ptr);
+    return ptr;
+}
+
+static void* heap_calloc(size_t count, size_t size) {
+    void* ptr = __real_calloc(count, size);
+    count_alloc(ptr);
+    return ptr;
+}
+
+static void* heap_realloc(void* ptr, size_t size) {
+    size_t old = ptr ? malloc_usable_size(ptr) : 0;
+    void* moved = __real_realloc(ptr, size);
+    if (moved) {
+        count_free(old);
+        count_alloc(moved);
+    } else if (size == 0) {
+        count_free(old);  /* realloc(ptr, 0) freed ptr */
+    }
+    return moved;
+}
+
+static void heap_free(void* ptr) {
+    if (ptr) {
+        count_free(malloc_usable_size(ptr));
+        __real_free(ptr);
+    }
+}
+
+/*
+ * Block owning each page the heap can grow to, NULL for regular heap pages.
+ * Created with the first block and then never moved, so lookups need no
+ * lock: a page only changes owner when its block is allocated or freed,
+ * which cannot happen while one of its allocations is being freed.
+ */
+static MmgwasmArenaBlock** g_pages = NULL;
+static size_t g_page_count = 0;
+MMGWASM_MUTEX(g_pages_lock);
+
+/* Create the page map on first use. Returns 1 on success, 0 on failure */
+static int open_pages(void) {
+    if (__atomic_load_n(&g_pages, __ATOMIC_ACQUIRE)) {
+        return 1;
+    }
+    MMGWASM_LOCK(g_pages_lock);
+    if (!g_pages) {
+        size_t count = (size_t)(emscripten_get_heap_max() >> ARENA_PAGE_SHIFT);
+        MmgwasmArenaBlock** pages = (MmgwasmArenaBlock**)heap_calloc(
+            count, sizeof(MmgwasmArenaBlock*));
+        if (pages) {
+            g_page_count = count;
+            __atomic_store_n(&g_pages, pages, __ATOMIC_RELEASE);
+        }
+    }
+    MMGWASM_UNLOCK(g_pages_lock);
+    return g_pages != NULL;
+}
+
+/* Set the owner of the pages of a block of bytes */
+static void map_pages(MmgwasmArenaBlock* block, size_t bytes,
+                      MmgwasmArenaBlock* owner) {
+    size_t first = (uintptr_t)block >> ARENA_PAGE_SHIFT;
+    size_t end = first + (bytes >> ARENA_PAGE_SHIFT);
+    for (size_t i = first; i < end && i < g_page_count; i++) {
+        __atomic_store_n(&g_pages[i], owner, __ATOMIC_RELEASE);
+    }
+}
+
+/* Block holding an allocation, NULL for regular heap memory */
+static MmgwasmArenaBlock* find_block(const void* ptr) {
+    MmgwasmArenaBlock** pages = __atomic_load_n(&g_pages, __ATOMIC_ACQUIRE);
+    size_t i = (uintptr_t)ptr >> ARENA_PAGE_SHIFT;
+    if (!pages || i >= g_page_count) {
+        return NULL;
+    }
+    return __atomic_load_n(&pages[i], __ATOMIC_ACQUIRE);
+}
+
+/* Allocate and map a block of at least size usable bytes */
+static MmgwasmArenaBlock* add_block(MmgwasmArena* arena, size_t size,
+                                    int dedicated) {
+    size_t bytes = PAGE_UP(BLOCK_HEADER + size);
+    if (!open_pages()) {
+        return NULL;
+    }
+    MmgwasmArenaBlock* block = (MmgwasmArenaBlock*)memalign(ARENA_PAGE,
+                                                            bytes);
+    if (!block) {
+        return NULL;
+    }
+    count_alloc(block);
+    block->owner = arena;
+    block->size = bytes - BLOCK_HEADER;
+    block->used = 0;
+    block->last = NO_LAST;
+    block->live = 0;
+    block->dedicated = dedicated;
+    map_pages(block, bytes, block);
+
+    block->prev = NULL;
+    block->next = arena->blocks;
+    if (block->next) {
+        block->next->prev = block;
+    }
+    arena->blocks = block;
+    arena->capacity += block->size;
+    return block;
+}
+
+/* Unlink a block from its arena and return it to the heap */
+static void drop_block(MmgwasmArenaBlock* block) {
+    MmgwasmArena* arena = block->owner;
+    map_pages(block, BLOCK_HEADER + block->size, NULL);
+    if (block->prev) {
+        block->prev->next = block->next;
+    } else {
+        arena->blocks = block->next;
+    }
+    if (block->next) {
+        block->next->prev = block->prev;
+    }
+    if (arena->chunk == block) {
+        arena->chunk = NULL;
+    }
+    arena->capacity -= block->size;
+    heap_free(block);
+}
+
+/* Usable bytes of an allocation request (at least one alignment unit) */
+static size_t payload_size(size_t size) {
+    return size ? ALIGN_UP(size) : ARENA_ALIGN;
+}
+
+static void* arena_alloc(MmgwasmArena* arena, size_t size) {
+    if (size > ARENA_MAX_REQUEST) {
+        return NULL;
+    }
+    size_t need = ALLOC_HEADER + payload_size(size);
+    if (need > ARENA_LARGE) {
+        MmgwasmArenaBlock* block = add_block(arena, payload_size(size), 1);
+        return block ? BLOCK_DATA(block) : NULL;
+    }
+
+    MmgwasmArenaBlock* chunk = arena->chunk;
+    if (!chunk || chunk->size - chunk->used < need) {
+        size_t next = arena->capacity;
+        if (next < ARENA_MIN_CHUNK) next = ARENA_MIN_CHUNK;
+        if (next > ARENA_MAX_CHUNK) next = ARENA_MAX_CHUNK;
+        chunk = add_block(arena, next, 0);
+        if (!chunk) {
+            return NULL;
+        }
+        arena->chunk = chunk;
+    }
+
+    char* header = BLOCK_DATA(chunk) + chunk->used;
+    *(size_t*)header = size;
+    chunk->last = chunk->used;
+    chunk->used += need;
+    chunk->live++;
+    return header + ALLOC_HEADER;
+}
+
+static void arena_free(MmgwasmArenaBlock* block, void* ptr) {
+    if (block->dedicated) {
+        drop_block(block);
+        return;
+    }
+    size_t offset = (size_t)((char*)ptr - ALLOC_HEADER - BLOCK_DATA(block));
+    if (offset == block->last) {
+        block->used = offset;
+        block->last = NO_LAST;
+    }
+
+    /* An empty chunk starts over, or goes back to the heap if not current */
+    if (--block->live == 0) {
+        if (block == block->owner->chunk) {
+            block->used = 0;
+            block->last = NO_LAST;
+        } else {
+            drop_block(block);
+        }
+    }
+}
+
+static void* arena_realloc(MmgwasmArenaBlock* block, void* ptr, size_t size) {
+    MmgwasmArena* arena = block->owner;
+    if (size > ARENA_MAX_REQUEST) {
+        return NULL;
+    }
+
+    if (block->dedicated) {
+        /* Blocks are whole pages, so small changes fit in place */
+        size_t payload = payload_size(size);
+        if (payload <= block->size &&
+            PAGE_UP(BLOCK_HEADER + payload) == BLOCK_HEADER + block->size) {
+            return ptr;
+        }
+        MmgwasmArenaBlock* moved = add_block(arena, payload, 1);
+        if (!moved) {
+            return NULL;
+        }
+        memcpy(BLOCK_DATA(moved), ptr,
+               block->size < moved->size ? block->size : moved->size);
+        drop_block(block);
+        return BLOCK_DATA(moved);
+    }
+
+    /* The last allocation of a chunk grows or shrinks in place */
+    size_t offset = (size_t)((char*)ptr - ALLOC_HEADER - BLOCK_DATA(block));
+    size_t need = ALLOC_HEADER + payload_size(size);
+    if (offset == block->last && need <= ARENA_LARGE &&
+        need <= block->size - offset) {
+        ALLOC_SIZE(ptr) = size;
+        block->used = offset + need;
+        return ptr;
+    }
+
+    size_t old = ALLOC_SIZE(ptr);
+    void* moved = arena_alloc(arena, size);
+    if (!moved) {
+        return NULL;
+    }
+    memcpy(moved, ptr, old < size ? old : size);
+    arena_free(block, ptr);
+    return moved;
+}
+
+void* __wrap_malloc(size_t size) {
+    MmgwasmArena* arena = t_arena;
+    return arena ? arena_alloc(arena, size) : heap_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    MmgwasmArena* arena = t_arena;
+    if (!arena) {
+        return heap_calloc(count, size);
+    }
+    if (size && count > SIZE_MAX / size) {
+        return NULL;
+    }
+    void* ptr = arena_alloc(arena, count * size);
+    if (ptr) {
+        memset(ptr, 0, count * size);
+    }
+    return ptr;
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    if (!ptr) {
+        return __wrap_malloc(size);
+    }
+    MmgwasmArenaBlock* block = find_block(ptr);
+    return block ? arena_realloc(block, ptr, size) : heap_realloc(ptr, size);
+}
+
+void __wrap_free(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    MmgwasmArenaBlock* block = find_block(ptr);
+    if (block) {
+        arena_free(block, ptr);
+    } else {
+        heap_free(ptr);
+    }
+}
+
+MmgwasmArena* mmgwasm_arena_enter(MmgwasmArena* arena) {
+    MmgwasmArena* previous = t_arena;
+    t_arena = arena && arena->enabled ? arena : NULL;
+    return previous;
+}
+
+void mmgwasm_arena_leave(MmgwasmArena* previous) {
+    t_arena = previous;
+}
+
+void mmgwasm_arena_release(MmgwasmArena* arena) {
+    while (arena->blocks) {
+        drop_block(arena->blocks);
+    }
+    arena->chunk = NULL;
+    arena->capacity = 0;
+}
+
+/**
+ * Grow the WASM heap ahead of a large job (see arena.h).
+ * @param bytes - Bytes the job is expected to allocate
+ * @returns 1 on success, 0 if the heap cannot grow that much
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmgwasm_reserve_heap(size_t bytes) {
+    if (bytes == 0) {
+        return 1;
+    }
+    /* The freed block stays in the grown heap for the next allocations */
+    void* ptr = __real_malloc(bytes);
+    if (!ptr) {
+        return 0;
+    }
+    __real_free(ptr);
+    return 1;
+}
+
+/**
+ * Largest size the WASM heap can grow to (see arena.h).
+ * Returned as a double, like the counters below.
+ */
+EMSCRIPTEN_KEEPALIVE
+double mmgwasm_heap_max(void) {
+    return (double)emscripten_get_heap_max();
+}
+
+/**
+ * Bytes currently allocated on the heap, from the allocator itself, so that
+ * nothing allocated or freed outside the wrappers makes it drift.
+ * Returned as a double so that sizes above 2GB stay positive in JavaScript.
+ */
+EMSCRIPTEN_KEEPALIVE
+double mmgwasm_native_heap_used(void) {
+    return (double)heap_in_use();
+}
+
+/**
+ * Most bytes allocated at once since the module started or since the last
+ * mmgwasm_native_heap_reset_peak, never below the current usage.
+ */
+EMSCRIPTEN_KEEPALIVE
+double mmgwasm_native_heap_peak(void) {
+    ptrdiff_t delta = __atomic_load_n(&g_heap_delta_peak, __ATOMIC_RELAXED);
+    double peak = (double)__atomic_load_n(&g_heap_base, __ATOMIC_RELAXED) +
+                  (double)delta;
+    double used = mmgwasm_native_heap_used();
+    return peak > used ? peak : used;
+}
+
+/* Restart peak tracking from the current usage, e.g. before a job */
+EMSCRIPTEN_KEEPALIVE
+void mmgwasm_native_heap_reset_peak(void) {
+    __atomic_store_n(&g_heap_base, heap_in_use(), __ATOMIC_RELAXED);
+    __atomic_store_n(&g_heap_delta, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_heap_delta_peak, 0, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,64 @@
+/**
+ * Per-handle arenas for MMG's allocations
+ *
+ * MMG makes many small allocations (hash tables, boundary data, parameter
+ * arrays) next to its large entity arrays, which fragments the heap of a
+ * long-lived module. In arena mode, the allocations MMG makes for a handle
+ * are carved out of large blocks owned by the handle, and freeing the handle
+ * returns all of them in one step.
+ *
+ * malloc, calloc, realloc and free are linked with -Wl,--wrap (see
+ * CMakeLists.txt). Between mmgwasm_arena_enter and mmgwasm_arena_leave new
+ * allocations of the current thread come from the entered arena; frees and
+ * reallocs find the owner of a pointer from its address with a lock-free
+ * lookup, so memory may be released anywhere. Outside an arena scope every
+ * allocation forwards to the regular allocator.
+ *
+ * Every wrapped allocation is also counted, so the bytes MMG holds can be
+ * read without walking the heap.
+ */
+
+#ifndef MMGWASM_ARENA_H
+#define MMGWASM_ARENA_H
+
+#include <stddef.h>
+
+typedef struct MmgwasmArenaBlock MmgwasmArenaBlock;
+
+typedef struct {
+    int enabled;              /* 0: allocations go to the regular heap */
+    MmgwasmArenaBlock* blocks;
+    MmgwasmArenaBlock* chunk; /* block small allocations are carved from */
+    size_t capacity;          /* bytes held in blocks */
+} MmgwasmArena;
+
+/*
+ * Route the allocations of the current thread to an arena (NULL or a
+ * disabled arena suspends any enclosing scope).
+ * Returns the previous arena, to pass to mmgwasm_arena_leave.
+ */
+MmgwasmArena* mmgwasm_arena_enter(MmgwasmArena* arena);
+
+/* Restore the arena returned by mmgwasm_arena_enter */
+void mmgwasm_arena_leave(MmgwasmArena* previous);
+
+/* Return every block of an arena to the heap and reset it (keeps enabled) */
+void mmgwasm_arena_release(MmgwasmArena* arena);
+
+/*
+ * Grow the WASM heap so that bytes can be allocated without further growth.
+ * Memory never shrinks, so later allocations reuse the grown heap and the
+ * JavaScript views of it stay valid.
+ * Returns 1 on success, 0 if the heap cannot grow that much.
+ */
+int mmgwasm_reserve_heap(size_t bytes);
+
+/* Bytes the heap can grow to: MAXIMUM_MEMORY, 4GB at most in wasm32 */
+double mmgwasm_heap_max(void);
+
+/* Bytes allocated on the heap, now and at most since a reset */
+double mmgwasm_native_heap_used(void);
+double mmgwasm_native_heap_peak(void);
+void mmgwasm_native_heap_reset_peak(void);
+
+#endif /* MMGWASM_ARENA_H */
@@ -0,0 +1,67 @@
+/**
+ * Batch remeshing of many small meshes (see batch.h)
+ */
+
+#include <string.h>
+#include "batch.h"
+
+/* Round a record size up to the 8-byte alignment of the next record */
+static size_t align8(size_t bytes) {
+    return (bytes + 7) & ~(size_t)7;
+}
+
+static size_t entities_bytes(const MmgwasmBatchEntities* entities) {
+    return (size_t)entities->count * ((size_t)entities->size + 1) *
+           sizeof(int32_t);
+}
+
+size_t mmgwasm_batch_record_size(const MmgwasmBatchMesh* mesh) {
+    return align8(sizeof(MmgwasmBatchRecord) +
+                  (size_t)mesh->np * (size_t)mesh->dim * sizeof(double) +
+                  (size_t)mesh->np * sizeof(int32_t) +
+                  entities_bytes(&mesh->cells) +
+                  entities_bytes(&mesh->boundary));
+}
+
+/* Entry k (0-based) of a strided array starting at first */
+static const void* entry(const void* first, size_t stride, int k) {
+    return (const char*)first + (size_t)k * stride;
+}
+
+/* Write the vertex indices of entities, then their references */
+static char* write_entities(char* out, const MmgwasmBatchEntities* entities) {
+    int32_t* verts = (int32_t*)out;
+    for (int k = 0; k < entities->count; k++) {
+        const int* v = (const int*)entry(entities->verts, entities->stride, k);
+        memcpy(verts + (size_t)k * entities->size, v,
+               (size_t)entities->size * sizeof(int32_t));
+    }
+    int32_t* refs = verts + (size_t)entities->count * entities->size;
+    for (int k = 0; k < entities->count; k++) {
+        refs[k] = *(const int*)entry(entities->refs, entities->stride, k);
+    }
+    return (char*)(refs + entities->count);
+}
+
+void mmgwasm_batch_write(const MmgwasmBatchMesh* mesh,
+                         const MmgwasmBatchRecord* stats, void* out) {
+    MmgwasmBatchRecord* record = (MmgwasmBatchRecord*)out;
+    *record = *stats;
+    record->np = mesh->np;
+    record->ne = mesh->cells.count;
+    record->nb = mesh->boundary.count;
+
+    double* coords = (double*)(record + 1);
+    for (int k = 0; k < mesh->np; k++) {
+        const double* c = (const double*)entry(mesh->coords, mesh->stride, k);
+        memcpy(coords + (size_t)k * mesh->dim, c,
+               (size_t)mesh->dim * sizeof(double));
+    }
+    int32_t* refs = (int32_t*)(coords + (size_t)mesh->np * mesh->dim);
+    for (int k = 0; k < mesh->np; k++) {
+        refs[k] = *(const int*)entry(mesh->refs, mesh->stride, k);
+    }
+
+    char* cursor = write_entities((char*)(refs + mesh->np), &mesh->cells);
+    write_entities(cursor, &mesh->boundary);
+}
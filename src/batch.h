@@ -0,0 +1,92 @@
+/**
+ * Batch remeshing of many small meshes
+ *
+ * Parametric studies remesh hundreds of small meshes with the same options.
+ * Remeshing them one by one costs a Mesh, a cloned handle, two quality passes
+ * and an extraction each, and for small meshes those JS/WASM crossings cost
+ * more than MMG itself. The mmgX_remesh_batch wrappers take every input mesh
+ * as an import descriptor (see import.h) in one staging buffer, remesh them
+ * one after another in a single call and write every result into one buffer:
+ *
+ *   int32   count, 0
+ *   count records, each starting on an 8-byte boundary:
+ *     MmgwasmBatchRecord
+ *     float64  vertices       np * dim
+ *     int32    vertex refs    np
+ *     int32    cells          ne * cell_size, 1-based as in MMG
+ *     int32    cell refs      ne
+ *     int32    boundary       nb * boundary_size
+ *     int32    boundary refs  nb
+ *
+ * A mesh that could not be imported or remeshed keeps an empty record, so
+ * records always match the input meshes one to one.
+ */
+
+#ifndef MMGWASM_BATCH_H
+#define MMGWASM_BATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Bytes of the buffer header: count and padding */
+#define MMGWASM_BATCH_HEADER_BYTES 8
+
+/* Kinds of MmgwasmBatchParameter */
+enum {
+    MMGWASM_BATCH_INTEGER = 0,  /* set with MMGX_Set_iparameter */
+    MMGWASM_BATCH_DOUBLE = 1    /* set with MMGX_Set_dparameter */
+};
+
+/* MMG parameter set on every mesh of a batch (16 bytes) */
+typedef struct {
+    int32_t kind;
+    int32_t param;          /* MMGX_IPARAM_* or MMGX_DPARAM_* */
+    double value;
+} MmgwasmBatchParameter;
+
+/* Statistics of one mesh of a batch (48 bytes) */
+typedef struct {
+    int32_t status;         /* MMG return code, -1 if not imported */
+    int32_t np;
+    int32_t ne;
+    int32_t nb;
+    double quality_before;  /* minimum element quality */
+    double quality_after;
+    double quality_ms;      /* milliseconds of both quality passes */
+    double remesh_ms;       /* milliseconds in MMG */
+} MmgwasmBatchRecord;
+
+/*
+ * Entities read in place from MMG's structures: consecutive entries are
+ * stride bytes apart, and vertex indices are 1-based as in MMG.
+ */
+typedef struct {
+    const int* verts;       /* vertex indices of entity 1 */
+    const int* refs;        /* reference of entity 1 */
+    size_t stride;
+    int size;               /* vertices per entity */
+    int count;
+} MmgwasmBatchEntities;
+
+typedef struct {
+    int dim;
+    const double* coords;   /* coordinates of vertex 1 */
+    const int* refs;        /* reference of vertex 1 */
+    size_t stride;
+    int np;
+    MmgwasmBatchEntities cells;
+    MmgwasmBatchEntities boundary;
+} MmgwasmBatchMesh;
+
+/* Bytes of the record of a mesh, a multiple of 8 */
+size_t mmgwasm_batch_record_size(const MmgwasmBatchMesh* mesh);
+
+/*
+ * Write the record of a mesh to out, which must hold
+ * mmgwasm_batch_record_size bytes and be 8-byte aligned. The entity counts
+ * of the record are taken from mesh, its statistics from stats.
+ */
+void mmgwasm_batch_write(const MmgwasmBatchMesh* mesh,
+                         const MmgwasmBatchRecord* stats, void* out);
+
+#endif /* MMGWASM_BATCH_H */
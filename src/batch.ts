@@ -0,0 +1,142 @@
+/**
+ * Batch remeshing of many small meshes
+ *
+ * The mmgX_remesh_batch wrappers remesh every mesh of a batch in one native
+ * call: the inputs go through one staging buffer (see packMeshImports), the
+ * results come back in one buffer (src/batch.h) decoded here, so the cost of
+ * a small remesh is MMG itself rather than the JS/WASM crossings around it.
+ */
+
+import type { MeshImportData, MeshImportLayout } from "./import";
+import type { WasmModule } from "./memory";
+import type { OptionParameter } from "./options";
+import type { BatchRemeshResult } from "./result";
+
+/** Bytes of MmgwasmBatchParameter: two ints and a double */
+export const BATCH_PARAMETER_BYTES = 16;
+
+/** Bytes of the batch buffer header: count and padding */
+const HEADER_BYTES = 8;
+
+/** Bytes of MmgwasmBatchRecord: four ints and four doubles */
+const RECORD_BYTES = 48;
+
+/** Kinds of MmgwasmBatchParameter */
+const BATCH_INTEGER = 0;
+const BATCH_DOUBLE = 1;
+
+/**
+ * Write the parameters of a batch as MmgwasmBatchParameter entries
+ *
+ * @internal Used by the remeshBatch function of each module.
+ * @param module - The WASM module
+ * @param ptr - 8-byte aligned buffer of BATCH_PARAMETER_BYTES per parameter
+ * @param parameters - Parameters set on every mesh
+ */
+export function writeBatchParameters(
+  module: WasmModule,
+  ptr: number,
+  parameters: OptionParameter[],
+): void {
+  parameters.forEach(({ kind, param, value }, i) => {
+    const at = ptr + i * BATCH_PARAMETER_BYTES;
+    module.HEAP32[at / 4] = kind === "double" ? BATCH_DOUBLE : BATCH_INTEGER;
+    module.HEAP32[at / 4 + 1] = param;
+    module.HEAPF64[at / 8 + 1] = value;
+  });
+}
+
+/**
+ * Decode the results of a batch
+ *
+ * The arrays of each mesh are views of the buffer, so nothing is copied.
+ *
+ * @internal Used by the remeshBatch function of each module.
+ * @param bytes - Copy of the buffer returned by mmgX_remesh_batch
+ * @param layout - Entity sizes of the mesh type
+ * @param inputs - Input meshes, in batch order
+ * @returns One result per input mesh
+ */
+export function decodeBatch(
+  bytes: Uint8Array,
+  layout: MeshImportLayout,
+  inputs: MeshImportData[],
+): BatchRemeshResult[] {
+  const { buffer, byteOffset } = bytes;
+  const view = new DataView(buffer, byteOffset, bytes.byteLength);
+  const count = view.getInt32(0, true);
+  const results: BatchRemeshResult[] = [];
+
+  let offset = HEADER_BYTES;
+  for (let i = 0; i < count; i++) {
+    const status = view.getInt32(offset, true);
+    const np = view.getInt32(offset + 4, true);
+    const ne = view.getInt32(offset + 8, true);
+    const nb = view.getInt32(offset + 12, true);
+    const qualityBefore = view.getFloat64(offset + 16, true);
+    const qualityAfter = view.getFloat64(offset + 24, true);
+    const quality = view.getFloat64(offset + 32, true);
+    const remesh = view.getFloat64(offset + 40, true);
+
+    let at = byteOffset + offset + RECORD_BYTES;
+    const doubles = (n: number) => {
+      const array = new Float64Array(buffer, at, n);
+      at += n * 8;
+      return array;
+    };
+    const ints = (n: number) => {
+      const array = new Int32Array(buffer, at, n);
+      at += n * 4;
+      return array;
+    };
+    const vertices = doubles(np * layout.dim);
+    const vertexRefs = ints(np);
+    const cells = ints(ne * layout.cellSize);
+    const cellRefs = ints(ne);
+    const boundaryFaces = ints(nb * layout.boundarySize);
+    const boundaryRefs = ints(nb);
+    offset = Math.ceil((at - byteOffset) / 8) * 8;
+
+    const success = status === 0 || status === 1;
+    const warnings =
+      status === 1
+        ? ["Remeshing completed with warnings (low failure)"]
+        : status < 0
+          ? ["Failed to import mesh"]
+          : success
+            ? []
+            : [`Remeshing failed with strong failure (code ${status})`];
+    const vertexDelta = success
+      ? np - inputs[i].vertices.length / layout.dim
+      : 0;
+
+    results.push({
+      mesh: {
+        vertices,
+        cells,
+        boundaryFaces,
+        vertexRefs,
+        cellRefs,
+        boundaryRefs,
+      },
+      nVertices: np,
+      nCells: ne,
+      nBoundaryFaces: nb,
+      elapsed: quality + remesh,
+      timings: { clone: 0, sizing: 0, quality, remesh },
+      qualityBefore,
+      qualityAfter,
+      qualityImprovement:
+        qualityBefore > 0
+          ? qualityAfter / qualityBefore
+          : Number.POSITIVE_INFINITY,
+      nInserted: vertexDelta > 0 ? vertexDelta : 0,
+      nDeleted: vertexDelta < 0 ? -vertexDelta : 0,
+      nSwapped: 0, // MMG doesn't expose this
+      nMoved: 0, // MMG doesn't expose this
+      success,
+      warnings,
+    });
+  }
+  return results;
+}
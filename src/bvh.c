@@ -0,0 +1,125 @@
+/**
+ * Bounding volume hierarchy over axis-aligned boxes (see bvh.h)
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "bvh.h"
+
+typedef struct {
+    MmgwasmBvh* bvh;
+    const double* boxes;
+    double* centers;  /* 3 per item */
+} Builder;
+
+/* Key of an item along an axis */
+#define KEY(b, item, axis) ((b)->centers[(size_t)(item) * 3 + (axis)])
+
+/*
+ * Partially sort items so that items[k] is the k-th smallest along axis, with
+ * smaller keys before it and larger ones after it (quickselect)
+ */
+static void select_nth(const Builder* b, int* items, int n, int k, int axis) {
+    int lo = 0, hi = n - 1;
+    while (lo < hi) {
+        double pivot = KEY(b, items[(lo + hi) / 2], axis);
+        int i = lo, j = hi;
+        while (i <= j) {
+            while (KEY(b, items[i], axis) < pivot) i++;
+            while (KEY(b, items[j], axis) > pivot) j--;
+            if (i <= j) {
+                int tmp = items[i];
+                items[i] = items[j];
+                items[j] = tmp;
+                i++;
+                j--;
+            }
+        }
+        if (k <= j) {
+            hi = j;
+        } else if (k >= i) {
+            lo = i;
+        } else {
+            return;
+        }
+    }
+}
+
+/* Build the subtree over order[first, first + count), returns its node */
+static int build_node(Builder* b, int first, int count) {
+    MmgwasmBvh* bvh = b->bvh;
+    int index = bvh->nnodes++;
+    MmgwasmBvhNode* node = &bvh->nodes[index];
+    int* items = bvh->order + first;
+
+    for (int d = 0; d < 3; d++) {
+        node->min[d] = b->boxes[(size_t)items[0] * 6 + d];
+        node->max[d] = b->boxes[(size_t)items[0] * 6 + 3 + d];
+    }
+    for (int i = 1; i < count; i++) {
+        const double* box = b->boxes + (size_t)items[i] * 6;
+        for (int d = 0; d < 3; d++) {
+            if (box[d] < node->min[d]) node->min[d] = box[d];
+            if (box[3 + d] > node->max[d]) node->max[d] = box[3 + d];
+        }
+    }
+
+    if (count <= MMGWASM_BVH_LEAF_SIZE) {
+        node->first = first;
+        node->count = count;
+        return index;
+    }
+
+    /* Median split along the longest side */
+    int axis = 0;
+    for (int d = 1; d < 3; d++) {
+        if (node->max[d] - node->min[d] > node->max[axis] - node->min[axis]) {
+            axis = d;
+        }
+    }
+    int half = count / 2;
+    select_nth(b, items, count, half, axis);
+
+    node->count = 0;
+    build_node(b, first, half);  /* left child is index + 1 */
+    int right = build_node(b, first + half, count - half);
+    bvh->nodes[index].first = right;
+    return index;
+}
+
+int mmgwasm_bvh_build(MmgwasmBvh* bvh, const double* boxes, int n) {
+    memset(bvh, 0, sizeof(*bvh));
+    if (n <= 0) {
+        return 1;
+    }
+
+    /* A binary tree with n leaves at most has 2n - 1 nodes */
+    bvh->nodes = (MmgwasmBvhNode*)malloc((size_t)n * 2 * sizeof(MmgwasmBvhNode));
+    bvh->order = (int*)malloc((size_t)n * sizeof(int));
+    double* centers = (double*)malloc((size_t)n * 3 * sizeof(double));
+    if (!bvh->nodes || !bvh->order || !centers) {
+        free(centers);
+        mmgwasm_bvh_free(bvh);
+        return 0;
+    }
+
+    for (int i = 0; i < n; i++) {
+        bvh->order[i] = i;
+        for (int d = 0; d < 3; d++) {
+            centers[(size_t)i * 3 + d] =
+                0.5 * (boxes[(size_t)i * 6 + d] + boxes[(size_t)i * 6 + 3 + d]);
+        }
+    }
+    bvh->nitems = n;
+
+    Builder builder = {bvh, boxes, centers};
+    build_node(&builder, 0, n);
+    free(centers);
+    return 1;
+}
+
+void mmgwasm_bvh_free(MmgwasmBvh* bvh) {
+    free(bvh->nodes);
+    free(bvh->order);
+    memset(bvh, 0, sizeof(*bvh));
+}
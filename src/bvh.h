@@ -0,0 +1,68 @@
+/**
+ * Bounding volume hierarchy over axis-aligned boxes
+ *
+ * Shared acceleration structure of the native queries: sizing constraints
+ * are indexed by their region bounds (sizing.c) and mesh elements by their
+ * bounding boxes (locate.c), so a point only visits the few items whose box
+ * contains it instead of all of them.
+ *
+ * Nodes are stored depth first: the left child of an inner node directly
+ * follows it, so iterating the nodes backwards visits children before their
+ * parents.
+ */
+
+#ifndef MMGWASM_BVH_H
+#define MMGWASM_BVH_H
+
+/* Maximum number of items in a leaf */
+#define MMGWASM_BVH_LEAF_SIZE 4
+
+/* Deepest possible tree, for traversal stacks (median splits keep it
+   logarithmic, this is far above any reachable item count) */
+#define MMGWASM_BVH_MAX_DEPTH 64
+
+typedef struct {
+    double min[3];
+    double max[3];
+    int first;  /* leaf: first slot in order; inner node: right child */
+    int count;  /* number of items of a leaf, 0 for an inner node */
+} MmgwasmBvhNode;
+
+typedef struct {
+    MmgwasmBvhNode* nodes;
+    int* order;  /* item indices, each leaf owns a range of them */
+    int nnodes;
+    int nitems;
+} MmgwasmBvh;
+
+/*
+ * Build a hierarchy over n boxes, given as 6 doubles each (min xyz, max xyz).
+ * 2D items use z = 0. Returns 1 on success, 0 on allocation failure; bvh is
+ * left empty on failure and must be released with mmgwasm_bvh_free either way.
+ */
+int mmgwasm_bvh_build(MmgwasmBvh* bvh, const double* boxes, int n);
+
+/* Release the memory of a hierarchy and reset it to empty */
+void mmgwasm_bvh_free(MmgwasmBvh* bvh);
+
+/* Check whether point x (3 coordinates) lies in the box of a node */
+static inline int mmgwasm_bvh_node_contains(const MmgwasmBvhNode* node,
+                                            const double* x) {
+    return x[0] >= node->min[0] && x[0] <= node->max[0] &&
+           x[1] >= node->min[1] && x[1] <= node->max[1] &&
+           x[2] >= node->min[2] && x[2] <= node->max[2];
+}
+
+/* Squared distance from point x to the box of a node (0 inside) */
+static inline double mmgwasm_bvh_node_dist2(const MmgwasmBvhNode* node,
+                                            const double* x) {
+    double dist2 = 0.0;
+    for (int d = 0; d < 3; d++) {
+        double delta = x[d] < node->min[d] ? node->min[d] - x[d]
+                     : x[d] > node->max[d] ? x[d] - node->max[d] : 0.0;
+        dist2 += delta * delta;
+    }
+    return dist2;
+}
+
+#endif /* MMGWASM_BVH_H */
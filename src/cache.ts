@@ -0,0 +1,373 @@
+/**
+ * Persistent cache of remesh results
+ *
+ * The same input meshes are often remeshed again and again with the same
+ * options. A RemeshCache keys each remesh by a SHA-256 hash of everything it
+ * depends on (see Mesh.contentHash) and keeps the remeshed mesh as a .meshb
+ * file and its metric as a .solb file, written and read with the native
+ * buffer export, next to its statistics. Mesh.remesh and
+ * MeshWorkerPool.remesh consult the cache before remeshing, so a repeated
+ * request is served from storage.
+ *
+ * Entries live in a CacheStore: the Origin Private File System where the
+ * browser has one, IndexedDB otherwise, or memory (see createCacheStore).
+ */
+
+import type { RemeshOptions } from "./options";
+import type { RemeshResult } from "./result";
+
+/**
+ * Version of the cache keys and entries; bump it whenever remeshing or the
+ * entry layout changes so that older entries are no longer hit
+ */
+const CACHE_FORMAT = 2;
+
+/** Default OPFS directory and IndexedDB database of the cache */
+const DEFAULT_CACHE_NAME = "mmg-wasm-cache";
+
+/** IndexedDB object store holding the entries */
+const IDB_STORE = "entries";
+
+/**
+ * Bytes before the contents of an entry: the lengths of its statistics JSON
+ * and of its .meshb, followed by the .solb up to the end
+ */
+const ENTRY_HEADER = 8;
+
+/** Options that do not change the remeshed mesh */
+const KEY_IGNORED_OPTIONS = new Set(["verbose"]);
+
+/**
+ * Byte storage behind a RemeshCache
+ */
+export interface CacheStore {
+  /** Bytes stored under key, undefined if there are none */
+  get(key: string): Promise<Uint8Array | undefined>;
+  /** Store bytes under key, replacing any previous entry */
+  set(key: string, data: Uint8Array): Promise<void>;
+  /** Remove the entry of key, if any */
+  delete(key: string): Promise<void>;
+  /** Remove every entry */
+  clear(): Promise<void>;
+}
+
+/**
+ * Cache store kept in memory, for the lifetime of the page
+ */
+export class MemoryCacheStore implements CacheStore {
+  private entries = new Map<string, Uint8Array>();
+
+  async get(key: string): Promise<Uint8Array | undefined> {
+    return this.entries.get(key)?.slice();
+  }
+
+  async set(key: string, data: Uint8Array): Promise<void> {
+    this.entries.set(key, data.slice());
+  }
+
+  async delete(key: string): Promise<void> {
+    this.entries.delete(key);
+  }
+
+  async clear(): Promise<void> {
+    this.entries.clear();
+  }
+}
+
+/**
+ * Cache store in the Origin Private File System, one file per entry
+ */
+export class OPFSCacheStore implements CacheStore {
+  private directory: Promise<FileSystemDirectoryHandle> | null = null;
+
+  /**
+   * @param name - Directory of the entries, at the root of the origin's
+   *   private file system
+   */
+  constructor(private readonly name = DEFAULT_CACHE_NAME) {}
+
+  async get(key: string): Promise<Uint8Array | undefined> {
+    try {
+      const handle = await (await this.open()).getFileHandle(key);
+      const file = await handle.getFile();
+      return new Uint8Array(await file.arrayBuffer());
+    } catch (error) {
+      if (isNotFound(error)) {
+        return undefined;
+      }
+      throw error;
+    }
+  }
+
+  async set(key: string, data: Uint8Array): Promise<void> {
+    const directory = await this.open();
+    const handle = await directory.getFileHandle(key, { create: true });
+    const writable = await handle.createWritable();
+    try {
+      await writable.write(data);
+    } finally {
+      await writable.close();
+    }
+  }
+
+  async delete(key: string): Promise<void> {
+    try {
+      await (await this.open()).removeEntry(key);
+    } catch (error) {
+      if (!isNotFound(error)) {
+        throw error;
+      }
+    }
+  }
+
+  async clear(): Promise<void> {
+    const root = await navigator.storage.getDirectory();
+    this.directory = null;
+    try {
+      await root.removeEntry(this.name, { recursive: true });
+    } catch (error) {
+      if (!isNotFound(error)) {
+        throw error;
+      }
+    }
+  }
+
+  private open(): Promise<FileSystemDirectoryHandle> {
+    if (!this.directory) {
+      this.directory = navigator.storage
+        .getDirectory()
+        .then((root) => root.getDirectoryHandle(this.name, { create: true }));
+    }
+    return this.directory;
+  }
+}
+
+/**
+ * Cache store in an IndexedDB database, for browsers without OPFS
+ */
+export class IndexedDBCacheStore implements CacheStore {
+  private database: Promise<IDBDatabase> | null = null;
+
+  /**
+   * @param name - Name of the database
+   */
+  constructor(private readonly name = DEFAULT_CACHE_NAME) {}
+
+  async get(key: string): Promise<Uint8Array | undefined> {
+    const value = await this.request("readonly", (store) => store.get(key));
+    return value instanceof Uint8Array ? value : undefined;
+  }
+
+  async set(key: string, data: Uint8Array): Promise<void> {
+    await this.request("readwrite", (store) => store.put(data.slice(), key));
+  }
+
+  async delete(key: string): Promise<void> {
+    await this.request("readwrite", (store) => store.delete(key));
+  }
+
+  async clear(): Promise<void> {
+    await this.request("readwrite", (store) => store.clear());
+  }
+
+  private open(): Promise<IDBDatabase> {
+    if (!this.database) {
+      this.database = new Promise((resolve, reject) => {
+        const request = indexedDB.open(this.name, 1);
+        request.onupgradeneeded = () => {
+          request.result.createObjectStore(IDB_STORE);
+        };
+        request.onsuccess = () => resolve(request.result);
+        request.onerror = () => reject(request.error);
+      });
+    }
+    return this.database;
+  }
+
+  private async request<T>(
+    mode: IDBTransactionMode,
+    run: (store: IDBObjectStore) => IDBRequest<T>,
+  ): Promise<T> {
+    const database = await this.open();
+    return new Promise((resolve, reject) => {
+      const request = run(
+        database.transaction(IDB_STORE, mode).objectStore(IDB_STORE),
+      );
+      request.onsuccess = () => resolve(request.result);
+      request.onerror = () => reject(request.error);
+    });
+  }
+}
+
+/**
+ * Create the most durable cache store available: OPFS, then IndexedDB, then
+ * memory
+ *
+ * @param name - OPFS directory or IndexedDB database of the entries
+ */
+export function createCacheStore(name = DEFAULT_CACHE_NAME): CacheStore {
+  if (typeof navigator !== "undefined" && navigator.storage?.getDirectory) {
+    return new OPFSCacheStore(name);
+  }
+  if (typeof indexedDB !== "undefined") {
+    return new IndexedDBCacheStore(name);
+  }
+  return new MemoryCacheStore();
+}
+
+function isNotFound(error: unknown): boolean {
+  return error instanceof DOMException && error.name === "NotFoundError";
+}
+
+/** Statistics of a cached remesh, stored next to its mesh */
+export type CachedStatistics = Omit<
+  RemeshResult,
+  "mesh" | "elapsed" | "timings" | "memory" | "cached"
+>;
+
+/**
+ * Cached remesh: the remeshed mesh as a .meshb file, its metric as a .solb
+ * file (empty without one) and its statistics
+ */
+export interface CachedRemesh {
+  mesh: Uint8Array;
+  metric: Uint8Array;
+  statistics: CachedStatistics;
+}
+
+/**
+ * Cache of remesh results keyed by content hash
+ *
+ * Pass it to Mesh.remesh (RemeshControl.cache) or MeshWorkerPool (its cache
+ * option). Storage errors never fail a remesh: a failed read is a miss and a
+ * failed write is dropped.
+ *
+ * @example
+ * ```typescript
+ * const cache = new RemeshCache();
+ * const first = await mesh.remesh({ hmax: 0.1 }, { cache });
+ * const again = await mesh.remesh({ hmax: 0.1 }, { cache }); // again.cached
+ * ```
+ */
+export class RemeshCache {
+  /**
+   * @param store - Where entries are kept (default: createCacheStore())
+   */
+  constructor(readonly store: CacheStore = createCacheStore()) {}
+
+  /**
+   * Look up a remesh
+   *
+   * @param key - Content hash of the remesh (see Mesh.contentHash)
+   * @returns The cached remesh, undefined on a miss
+   */
+  async lookup(key: string): Promise<CachedRemesh | undefined> {
+    let data: Uint8Array | undefined;
+    try {
+      data = await this.store.get(key);
+    } catch {
+      return undefined;
+    }
+    if (!data || data.byteLength < ENTRY_HEADER) {
+      return undefined;
+    }
+    const view = new DataView(data.buffer, data.byteOffset, data.byteLength);
+    const jsonEnd = ENTRY_HEADER + view.getUint32(0, true);
+    const meshEnd = jsonEnd + view.getUint32(4, true);
+    if (meshEnd > data.byteLength) {
+      return undefined;
+    }
+    try {
+      const json = new TextDecoder().decode(
+        data.subarray(ENTRY_HEADER, jsonEnd),
+      );
+      return {
+        statistics: JSON.parse(json) as CachedStatistics,
+        mesh: data.subarray(jsonEnd, meshEnd),
+        metric: data.subarray(meshEnd),
+      };
+    } catch {
+      return undefined;
+    }
+  }
+
+  /**
+   * Store a successful remesh
+   *
+   * @param key - Content hash of the remesh (see Mesh.contentHash)
+   * @param result - Its result, whose mesh and metric are exported as
+   *   .meshb and .solb
+   */
+  async save(key: string, result: RemeshResult): Promise<void> {
+    if (!result.success) {
+      return;
+    }
+    const {
+      mesh,
+      elapsed: _elapsed,
+      timings: _timings,
+      memory: _memory,
+      cached: _cached,
+      ...statistics
+    } = result;
+    const json = new TextEncoder().encode(JSON.stringify(statistics));
+    const meshb = mesh.toArrayBuffer("meshb");
+    const solb = mesh.metricBuffer();
+    const meshStart = ENTRY_HEADER + json.byteLength;
+    const data = new Uint8Array(meshStart + meshb.byteLength + solb.byteLength);
+    const view = new DataView(data.buffer);
+    view.setUint32(0, json.byteLength, true);
+    view.setUint32(4, meshb.byteLength, true);
+    data.set(json, ENTRY_HEADER);
+    data.set(meshb, meshStart);
+    data.set(solb, meshStart + meshb.byteLength);
+    try {
+      await this.store.set(key, data);
+    } catch {
+      // A full or unavailable store only costs the next remesh
+    }
+  }
+}
+
+/**
+ * Hash the inputs of a remesh into a cache key
+ *
+ * @internal Used by Mesh.contentHash.
+ * @param type - Mesh type
+ * @param options - Remeshing options
+ * @param buffers - Mesh, metric and sizing constraint contents
+ * @returns Hex SHA-256 digest
+ */
+export async function hashRemeshInputs(
+  type: string,
+  options: RemeshOptions,
+  buffers: Uint8Array[],
+): Promise<string> {
+  const header = new TextEncoder().encode(
+    JSON.stringify([CACHE_FORMAT, type, keyOptions(options)]),
+  );
+  const parts = [header, ...buffers];
+  const total = parts.reduce((sum, part) => sum + 8 + part.byteLength, 0);
+  const data = new Uint8Array(total);
+  const view = new DataView(data.buffer);
+  let offset = 0;
+  for (const part of parts) {
+    // Length prefixes keep consecutive parts from aliasing each other
+    view.setFloat64(offset, part.byteLength, true);
+    data.set(part, offset + 8);
+    offset += 8 + part.byteLength;
+  }
+  const digest = new Uint8Array(await crypto.subtle.digest("SHA-256", data));
+  return Array.from(digest, (byte) => byte.toString(16).padStart(2, "0")).join(
+    "",
+  );
+}
+
+/** Options that change the result, as sorted [name, value] pairs */
+function keyOptions(options: RemeshOptions): [string, unknown][] {
+  return Object.entries(options)
+    .filter(
+      ([name, value]) => value !== undefined && !KEY_IGNORED_OPTIONS.has(name),
+    )
+    .sort(([a], [b]) => (a < b ? -1 : a > b ? 1 : 0));
+}
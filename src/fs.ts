@@ -3,8 +3,27 @@
  *
  * This module provides TypeScript types for Emscripten's FS API,
  * which allows reading and writing files in the browser's virtual filesystem.
+ *
+ * The OPFS build (mmg-opfs, see setWasmVariant) can also mount directories
+ * backed by the Origin Private File System (see mountOPFS). Files there stay
+ * on disk: loadMesh, saveMesh, loadSol and saveSol stream them instead of
+ * holding a whole copy in the WASM heap, so mesh files of several gigabytes
+ * can be used. OPFS directories can only be mounted from a worker.
  */
 
+import { scratchMemory, type WasmModule } from "./memory";
+
+/** Default mount point of the OPFS directory */
+export const OPFS_MOUNT_POINT = "/opfs";
+
+/** Module functions backing OPFS mounts (exported by every MMG module) */
+export interface OPFSModule extends WasmModule {
+  _mmgwasm_has_opfs(): number;
+  _mmgwasm_mount_opfs(pathPtr: number): number;
+  lengthBytesUTF8(str: string): number;
+  stringToUTF8(str: string, ptr: number, maxBytes: number): void;
+}
+
 /**
  * Path analysis result from FS.analyzePath
  */
@@ -141,3 +160,44 @@ export interface EmscriptenFS {
     blocks: number;
   };
 }
+
+/**
+ * Check whether a module is the OPFS build, which can mount OPFS directories.
+ *
+ * @param module - The WASM module
+ */
+export function isOPFSAvailable(module: OPFSModule): boolean {
+  return module._mmgwasm_has_opfs() === 1;
+}
+
+/**
+ * Mount a directory backed by the Origin Private File System.
+ *
+ * Files written under the returned path persist in the origin's private
+ * storage, and files already there (e.g. written with the File System
+ * Access API) can be loaded from it, e.g. with
+ * `MMG3D.loadMesh(handle, "/opfs/part.meshb")`.
+ *
+ * Must be called from a worker: the OPFS backend blocks while it waits for
+ * the browser, which the main thread does not allow.
+ *
+ * @param module - The WASM module, from the OPFS build
+ * @param path - Mount point in the virtual filesystem
+ * @returns The mount point
+ * @throws Error if the build has no OPFS support or the mount fails
+ */
+export function mountOPFS(
+  module: OPFSModule,
+  path: string = OPFS_MOUNT_POINT,
+): string {
+  if (!isOPFSAvailable(module)) {
+    throw new Error("OPFS requires the opfs build, see setWasmVariant()");
+  }
+  const pathLen = module.lengthBytesUTF8(path) + 1;
+  const [pathPtr] = scratchMemory(module, [pathLen]);
+  module.stringToUTF8(path, pathPtr, pathLen);
+  if (module._mmgwasm_mount_opfs(pathPtr) !== 1) {
+    throw new Error(`Failed to mount OPFS at ${path}`);
+  }
+  return path;
+}
@@ -0,0 +1,33 @@
+/**
+ * Packed descriptor for bulk mesh import
+ *
+ * JavaScript copies every array of a mesh into one staging buffer, with this
+ * descriptor at its start, and the mmgX_import_mesh wrappers size the mesh,
+ * set its entities and references and fill the metric in a single call.
+ * Optional arrays are NULL. Indices are 1-based, as everywhere in MMG.
+ *
+ * Layout (4-byte ints, 4-byte pointers in wasm32 for 44 bytes, 8-byte
+ * pointers in the memory64 build for 72 bytes):
+ *
+ *   vertices, vertex_refs, cells, cell_refs, boundary, boundary_refs, metric,
+ *   np, ne, nb, metric_size
+ */
+
+#ifndef MMGWASM_IMPORT_H
+#define MMGWASM_IMPORT_H
+
+typedef struct {
+    const double* vertices;     /* np points, dimension coordinates each */
+    const int* vertex_refs;     /* np references, or NULL */
+    const int* cells;           /* ne tetrahedra (3D) or triangles */
+    const int* cell_refs;       /* ne references, or NULL */
+    const int* boundary;        /* nb triangles (3D) or edges, or NULL */
+    const int* boundary_refs;   /* nb references, or NULL */
+    const double* metric;       /* np * metric_size values, or NULL */
+    int np;
+    int ne;
+    int nb;
+    int metric_size;            /* 0 (none), 1 (scalar) or tensor size */
+} MmgwasmMeshImport;
+
+#endif /* MMGWASM_IMPORT_H */
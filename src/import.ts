@@ -0,0 +1,236 @@
+/**
+ * Bulk mesh import through one staging buffer
+ *
+ * Setting a mesh array by array costs an allocation, a copy and a wrapper
+ * call per array, which dominates the construction of small meshes. Instead,
+ * every array is copied once into a single staging buffer that starts with
+ * a packed descriptor (src/import.h), and one mmgX_import_mesh call sizes
+ * the mesh and sets all of it.
+ */
+
+import { scratchMemory } from "./memory";
+import { type PointerSizeModule, pointerSize } from "./memory64";
+
+/**
+ * Arrays of a mesh to import (indices are 1-based)
+ */
+export interface MeshImportData {
+  /** Vertex coordinates (2 or 3 per vertex depending on the mesh type) */
+  vertices: Float64Array;
+  /** One reference per vertex */
+  vertexRefs?: Int32Array;
+  /** Cells: tetrahedra in 3D, triangles otherwise */
+  cells: Int32Array;
+  /** One reference per cell */
+  cellRefs?: Int32Array;
+  /** Boundary: triangles in 3D, edges otherwise */
+  boundary?: Int32Array;
+  /** One reference per boundary element */
+  boundaryRefs?: Int32Array;
+  /** Metric at the vertices: one size per vertex, or one tensor per vertex */
+  metric?: Float64Array;
+}
+
+/**
+ * Sizes of the entities of a mesh type
+ * @internal
+ */
+export interface MeshImportLayout {
+  /** Coordinates per vertex */
+  dim: number;
+  /** Vertices per cell */
+  cellSize: number;
+  /** Vertices per boundary element */
+  boundarySize: number;
+  /** Values per metric tensor */
+  tensorSize: number;
+}
+
+/** Pointers of MmgwasmMeshImport, followed by 4 ints */
+const DESCRIPTOR_POINTERS = 7;
+
+/**
+ * Element counts of a mesh to import, with its metric if it has one
+ */
+interface CheckedImport {
+  np: number;
+  ne: number;
+  nb: number;
+  metricSize: number;
+  metric?: Float64Array;
+}
+
+/**
+ * Check element counts, then copy the arrays of a mesh into the scratch
+ * memory of the module (see scratchMemory), descriptor first.
+ *
+ * @internal Used by the importMesh function of each module.
+ * @param module - The WASM module
+ * @param data - Arrays to import
+ * @param layout - Entity sizes of the mesh type
+ * @returns Pointer to the descriptor, valid until scratch memory is reused
+ * @throws Error if an array has the wrong length or the allocation fails
+ */
+export function packMeshImport(
+  module: PointerSizeModule,
+  data: MeshImportData,
+  layout: MeshImportLayout,
+): number {
+  return packMeshImports(module, [data], layout)[0];
+}
+
+/**
+ * Copy the arrays of several meshes into the scratch memory of the module,
+ * with their descriptors in one array first, and reserve extra buffers
+ * after them in the same scratch memory.
+ *
+ * @internal Used by the importMesh and remeshBatch functions of each module.
+ * @param module - The WASM module
+ * @param meshes - Arrays to import, one entry per mesh
+ * @param layout - Entity sizes of the mesh type
+ * @param extra - Size in bytes of each extra buffer
+ * @returns Pointer to the descriptors, then to each extra buffer, valid
+ *   until scratch memory is reused
+ * @throws Error if an array has the wrong length or the allocation fails
+ */
+export function packMeshImports(
+  module: PointerSizeModule,
+  meshes: MeshImportData[],
+  layout: MeshImportLayout,
+  extra: number[] = [],
+): number[] {
+  const checked = meshes.map((data) => checkMeshImport(data, layout));
+  const pointerBytes = pointerSize(module);
+  const descriptorBytes = DESCRIPTOR_POINTERS * pointerBytes + 16;
+
+  // Descriptors and the ints of each mesh are 4-byte aligned: pad them so
+  // the doubles of the next mesh stay 8-byte aligned
+  const align8 = (n: number) => Math.ceil(n / 8) * 8;
+  const descriptorsBytes = align8(meshes.length * descriptorBytes);
+  let bytes = descriptorsBytes;
+  meshes.forEach((data, i) => {
+    let meshBytes = 0;
+    for (const array of importArrays(data, checked[i])) {
+      meshBytes += array ? array.byteLength : 0;
+    }
+    bytes += align8(meshBytes);
+  });
+
+  const [ptr, ...extraPtrs] = scratchMemory(module, [bytes, ...extra]);
+  let offset = ptr + descriptorsBytes;
+  const place = (array: Float64Array | Int32Array | undefined): number => {
+    if (!array || array.length === 0) {
+      return 0;
+    }
+    const at = offset;
+    if (array instanceof Float64Array) {
+      module.HEAPF64.set(array, at / 8);
+    } else {
+      module.HEAP32.set(array, at / 4);
+    }
+    offset += array.byteLength;
+    return at;
+  };
+
+  meshes.forEach((data, i) => {
+    const { np, ne, nb, metricSize, metric } = checked[i];
+    // Doubles first so that they stay 8-byte aligned, then the ints
+    const verticesPtr = place(data.vertices);
+    const metricPtr = place(metric);
+    const pointers = [
+      verticesPtr,
+      place(data.vertexRefs),
+      place(data.cells),
+      place(data.cellRefs),
+      place(data.boundary),
+      place(data.boundaryRefs),
+      metricPtr,
+    ];
+    // 8-byte pointers of the memory64 build are written as two ints, low
+    // half first
+    const descriptor =
+      pointerBytes === 8
+        ? pointers.flatMap((p) => [p % 2 ** 32, Math.floor(p / 2 ** 32)])
+        : pointers;
+    module.HEAP32.set(
+      [...descriptor, np, ne, nb, metricSize],
+      (ptr + i * descriptorBytes) / 4,
+    );
+    offset = align8(offset);
+  });
+  return [ptr, ...extraPtrs];
+}
+
+/**
+ * Arrays of a mesh in the order they are copied: doubles first
+ */
+function importArrays(
+  data: MeshImportData,
+  checked: CheckedImport,
+): (Float64Array | Int32Array | undefined)[] {
+  return [
+    data.vertices,
+    checked.metric,
+    data.vertexRefs,
+    data.cells,
+    data.cellRefs,
+    data.boundary,
+    data.boundaryRefs,
+  ];
+}
+
+/**
+ * Check the array lengths of a mesh to import
+ *
+ * @throws Error if an array has the wrong length
+ */
+function checkMeshImport(
+  data: MeshImportData,
+  layout: MeshImportLayout,
+): CheckedImport {
+  const { vertices, vertexRefs, cells, cellRefs, boundary, boundaryRefs } =
+    data;
+  const { metric } = data;
+
+  const count = (array: ArrayLike<number>, size: number, name: string) => {
+    if (array.length % size !== 0) {
+      throw new Error(
+        `${name} array length must be a multiple of ${size}, got ${array.length}`,
+      );
+    }
+    return array.length / size;
+  };
+  const checkRefs = (refs: Int32Array | undefined, n: number, name: string) => {
+    if (refs && refs.length !== n) {
+      throw new Error(
+        `${name} refs array length (${refs.length}) must match ${n} elements`,
+      );
+    }
+  };
+
+  const np = count(vertices, layout.dim, "vertices");
+  const ne = count(cells, layout.cellSize, "cells");
+  const nb = boundary ? count(boundary, layout.boundarySize, "boundary") : 0;
+  checkRefs(vertexRefs, np, "vertex");
+  checkRefs(cellRefs, ne, "cell");
+  checkRefs(boundaryRefs, nb, "boundary");
+
+  let metricSize = 0;
+  if (metric && metric.length > 0) {
+    metricSize = metric.length / np;
+    if (metricSize !== 1 && metricSize !== layout.tensorSize) {
+      throw new Error(
+        `metric array length (${metric.length}) must be 1 or ` +
+          `${layout.tensorSize} values per vertex (${np} vertices)`,
+      );
+    }
+  }
+
+  return {
+    np,
+    ne,
+    nb,
+    metricSize,
+    metric: metricSize > 0 ? metric : undefined,
+  };
+}
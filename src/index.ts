@@ -12,9 +12,16 @@ export {
   MMG_RETURN_CODES,
   SOL_ENTITY,
   SOL_TYPE,
+  SUBDOMAIN_INTERFACE_REF,
   type MeshHandle,
   type MeshSize,
   type SolInfo,
+  type QualityStats,
+  type PointLocation,
+  type SurfaceClip,
+  type SurfaceGeometry,
+  type RemeshPhase,
+  type RemeshProgress,
   type IParamKey,
   type DParamKey,
   type MMG3DModule,
@@ -34,6 +41,10 @@ export {
   type MeshHandle2D,
   type MeshSize2D,
   type SolInfo2D,
+  type QualityStats2D,
+  type PointLocation2D,
+  type RemeshPhase2D,
+  type RemeshProgress2D,
   type IParamKey2D,
   type DParamKey2D,
   type MMG2DModule,
@@ -53,16 +64,33 @@ export {
   type MeshHandleS,
   type MeshSizeS,
   type SolInfoS,
+  type QualityStatsS,
+  type PointLocationS,
+  type RemeshPhaseS,
+  type RemeshProgressS,
   type IParamKeyS,
   type DParamKeyS,
   type MMGSModule,
 } from "./mmgs";
 
-// Export FS types
-export type { EmscriptenFS, PathAnalysis } from "./fs";
+// Export FS types and OPFS mounts
+export {
+  OPFS_MOUNT_POINT,
+  isOPFSAvailable,
+  mountOPFS,
+  type EmscriptenFS,
+  type OPFSModule,
+  type PathAnalysis,
+} from "./fs";
 
 // Export unified Mesh class
-export { Mesh, MeshType, type MeshData, type LoadOptions } from "./mesh";
+export {
+  Mesh,
+  MeshType,
+  type MeshData,
+  type LoadOptions,
+  type RemeshControl,
+} from "./mesh";
 
 // Export local sizing types
 export {
@@ -74,6 +102,9 @@ export {
   BoxSizingConstraint,
   CylinderSizingConstraint,
   combineSizingConstraints,
+  encodeSizingConstraints,
+  SIZING_STRIDE,
+  SIZING_KIND,
 } from "./sizing";
 
 // Export RemeshOptions and presets
@@ -86,15 +117,67 @@ export {
 } from "./options";
 
 // Export RemeshResult
-export type { RemeshResult } from "./result";
+export type {
+  BatchRemeshResult,
+  BufferRemeshResult,
+  PreviewResult,
+  RemeshMemory,
+  RemeshPhases,
+  RemeshResult,
+  RemeshStats,
+  RemeshTimings,
+} from "./result";
+
+// Export the persistent remesh cache
+export {
+  RemeshCache,
+  type CacheStore,
+  type CachedRemesh,
+  type CachedStatistics,
+  MemoryCacheStore,
+  OPFSCacheStore,
+  IndexedDBCacheStore,
+  createCacheStore,
+} from "./cache";
 
 // Export Web Worker API
 export {
   MeshWorker,
+  MeshWorkerPool,
+  estimateJobCost,
   remeshInWorker,
+  remeshPartitioned,
+  runPipeline,
+  validatePipeline,
+  type PartRemesher,
+  type PartitionOptions,
+  type PipelineControl,
+  type PipelineResult,
+  type PipelineStage,
+  type PipelineStageReport,
+  type PoolWorker,
   type ProgressInfo,
+  type SizingRegion,
+  type WorkerPoolOptions,
+  type WorkerPoolStats,
 } from "./worker";
 
+// Export WASM build variant selection
+export {
+  isMemory64Supported,
+  isSimdSupported,
+  isThreadingSupported,
+  setWasmVariant,
+  getWasmVariant,
+  setSplitModules,
+  getCompiledModule,
+  setCompiledModule,
+  type CompiledModule,
+  type InitOptions,
+  type ModuleName,
+  type WasmVariant,
+} from "./loader";
+
 // Export memory utilities
 export {
   toWasmFloat64,
@@ -104,24 +187,53 @@ export {
   fromWasmInt32,
   fromWasmUint32,
   freeWasmArray,
+  isHeapViewValid,
   getMemoryStats,
   configureMemory,
   checkMemoryAvailable,
   estimateMeshMemory,
+  reserveMemory,
+  resetNativePeak,
   resetMemoryTracking,
   MemoryError,
   type WasmModule,
   type MemoryStats,
   type MemoryConfig,
+  type HeapReserveModule,
+  type NativeMemoryModule,
+  type HandleMemoryUsage,
 } from "./memory";
 
+// Export in-memory file utilities
+export {
+  createMemFile,
+  appendToMemFile,
+  appendStreamToMemFile,
+  freeMemFile,
+  readMemFile,
+  type MemFileModule,
+} from "./memfile";
+
+// Export bulk mesh import types
+export type { MeshImportData } from "./import";
+
+// Export compact mesh wire format
+export {
+  decodePackedMesh,
+  type PackOptions,
+  type PackedMesh,
+} from "./packed";
+
 // Export Three.js integration utilities
 export {
   fromThreeGeometry,
+  packedMeshToThreeGeometry,
   toThreeGeometry,
   toThreeGeometrySync,
+  toThreeSurfaceGeometry,
   type FromThreeOptions,
   type ToThreeOptions,
+  type ToThreeSurfaceOptions,
 } from "./three";
 
 // Legacy interface (for backwards compatibility)
@@ -0,0 +1,445 @@
+/**
+ * WASM module loader
+ *
+ * Selects between the scalar, SIMD (-msimd128) and pthreads builds of the mmg
+ * module at runtime. The pthreads build is used on cross-origin isolated pages
+ * (SharedArrayBuffer available), then the SIMD build when the host validates a
+ * minimal SIMD module. When a variant's artifact is not available the next
+ * one is tried, down to the scalar build. The OPFS build (pthreads with
+ * OPFS-backed files, see mountOPFS) is only loaded when selected with
+ * setWasmVariant("opfs"). The memory64 build replaces them all when the
+ * first init call announces meshes too large for a wasm32 heap
+ * (InitOptions.heapBytes) and the host supports Memory64.
+ *
+ * The selected build is instantiated once and shared by MMG3D, MMG2D and MMGS
+ * (one heap, one filesystem). Its compiled WebAssembly.Module is kept so the
+ * workers of MeshWorker can instantiate it without compiling it again.
+ *
+ * With setSplitModules(true), each init function instead loads the module of
+ * its own mesh type (mmg3d, mmg2d or mmgs, built with MMG_WASM_SPLIT_MODULES),
+ * so a page using one mesh type only downloads and compiles that one.
+ */
+
+import {
+  type PointerSignatures,
+  readPointerSignatures,
+  wrapPointerExports,
+} from "./memory64";
+
+/** Factory exported by the Emscripten-generated module */
+export type ModuleFactory = typeof import("../build/dist/mmg.js").default;
+
+/** Options accepted by the initMMG* functions */
+export interface InitOptions {
+  /**
+   * Maximum number of concurrent mesh handles for the module (default 1024,
+   * at most 65536). Can also be changed later with setMaxHandles().
+   */
+  maxHandles?: number;
+  /**
+   * Allocate MMG's memory per handle and release it in one step when the
+   * handle is freed (default false). Can also be changed later with
+   * setArenaMode().
+   */
+  arena?: boolean;
+  /**
+   * Heap the meshes are expected to need, e.g. from estimateMeshMemory().
+   * Beyond what a wasm32 build can hold (2GB), the memory64 build is loaded
+   * instead when the host supports it and the variant is "auto". Only
+   * matters for the first init call, which loads the shared module.
+   */
+  heapBytes?: number;
+}
+
+/** Module of one mesh type, built with MMG_WASM_SPLIT_MODULES */
+export type ModuleName = "mmg3d" | "mmg2d" | "mmgs";
+
+/** Build variant of the WASM module */
+export type WasmVariant =
+  | "memory64"
+  | "opfs"
+  | "threads"
+  | "simd"
+  | "scalar";
+
+/** Compiled WASM module of a build variant */
+export interface CompiledModule {
+  variant: WasmVariant;
+  module: WebAssembly.Module;
+  /** i64 exports of the memory64 build, read from its binary */
+  pointers?: PointerSignatures;
+}
+
+// Smallest valid module using v128 (i8x16.splat + i8x16.popcnt)
+const SIMD_PROBE = new Uint8Array([
+  0, 97, 115, 109, 1, 0, 0, 0, 1, 5, 1, 96, 0, 1, 123, 3, 2, 1, 0, 10, 10, 1, 8,
+  0, 65, 0, 253, 15, 253, 98, 11,
+]);
+
+// Smallest valid module with a 64-bit memory (memory section, flags 0x04)
+const MEMORY64_PROBE = new Uint8Array([
+  0, 97, 115, 109, 1, 0, 0, 0, 5, 3, 1, 4, 0,
+]);
+
+// Largest heap of the wasm32 builds (Emscripten's default MAXIMUM_MEMORY)
+const WASM32_HEAP_MAX = 2 * 1024 * 1024 * 1024;
+
+// Artifact name suffix of each variant (see cmake/EmscriptenConfig.cmake)
+const VARIANT_SUFFIXES: Record<WasmVariant, string> = {
+  memory64: "-64",
+  opfs: "-opfs",
+  threads: "-mt",
+  simd: "-simd",
+  scalar: "",
+};
+
+/**
+ * Path of an artifact, built at runtime so bundlers leave the optional
+ * artifacts unresolved
+ */
+function artifactPath(
+  name: ModuleName | "mmg",
+  variant: WasmVariant,
+  extension: "js" | "wasm",
+): string {
+  return `../build/dist/${name}${VARIANT_SUFFIXES[variant]}.${extension}`;
+}
+
+let simdSupported: boolean | null = null;
+let memory64Supported: boolean | null = null;
+let requiredHeap = 0;
+let preferredVariant: WasmVariant | "auto" = "auto";
+let loadedVariant: WasmVariant | null = null;
+let splitModules = false;
+
+// Instance shared by the initMMG* functions, and the compiled module
+let sharedInstance: Promise<unknown> | null = null;
+let compiledModule: Promise<CompiledModule | null> | null = null;
+
+// Instances of the per-mesh-type modules
+const splitInstances = new Map<ModuleName, Promise<unknown>>();
+
+/**
+ * Check whether the host supports WebAssembly SIMD (fixed-width 128-bit).
+ * The result is computed once and cached.
+ */
+export function isSimdSupported(): boolean {
+  if (simdSupported === null) {
+    try {
+      simdSupported =
+        typeof WebAssembly === "object" && WebAssembly.validate(SIMD_PROBE);
+    } catch {
+      simdSupported = false;
+    }
+  }
+  return simdSupported;
+}
+
+/**
+ * Check whether the host supports WebAssembly Memory64 (64-bit heaps).
+ * The result is computed once and cached.
+ */
+export function isMemory64Supported(): boolean {
+  if (memory64Supported === null) {
+    try {
+      memory64Supported =
+        typeof WebAssembly === "object" &&
+        WebAssembly.validate(MEMORY64_PROBE);
+    } catch {
+      memory64Supported = false;
+    }
+  }
+  return memory64Supported;
+}
+
+/**
+ * Check whether the pthreads build can run here: it needs SharedArrayBuffer,
+ * which browsers only expose on cross-origin isolated pages (COOP/COEP).
+ */
+export function isThreadingSupported(): boolean {
+  return (
+    typeof SharedArrayBuffer !== "undefined" &&
+    (globalThis as { crossOriginIsolated?: boolean }).crossOriginIsolated ===
+      true
+  );
+}
+
+/**
+ * Choose which build variant subsequent init calls load.
+ *
+ * - `"auto"` (default): pthreads, then SIMD, when supported and available,
+ *   else scalar
+ * - `"threads"`: always load the pthreads build (init fails if it cannot be
+ *   loaded)
+ * - `"simd"`: always load the SIMD build (init fails if it cannot be loaded)
+ * - `"scalar"`: always load the scalar build
+ * - `"opfs"`: always load the pthreads build with OPFS-backed files (init
+ *   fails if it cannot be loaded); never picked by `"auto"`
+ * - `"memory64"`: always load the Memory64 build (init fails if it cannot be
+ *   loaded); `"auto"` picks it only for InitOptions.heapBytes beyond 2GB
+ *
+ * The module instance shared by MMG3D, MMG2D and MMGS is not affected once
+ * one of them is initialized.
+ */
+export function setWasmVariant(variant: WasmVariant | "auto"): void {
+  preferredVariant = variant;
+}
+
+/**
+ * Choose whether subsequent init calls load the module of their mesh type
+ * (mmg3d, mmg2d or mmgs) rather than the combined module shared by all three.
+ *
+ * Each of those modules holds a single mesh type, so a page only using one
+ * downloads and compiles a fraction of the combined one. Mesh types loaded
+ * that way don't share a heap. When a module's artifacts are not available,
+ * its init falls back to the combined module. Workers of MeshWorker always
+ * use the combined module.
+ */
+export function setSplitModules(enabled: boolean): void {
+  splitModules = enabled;
+}
+
+/**
+ * Get the variant of the most recently loaded WASM module, or null if no
+ * module has been loaded yet.
+ */
+export function getWasmVariant(): WasmVariant | null {
+  return loadedVariant;
+}
+
+/**
+ * Import the Emscripten module factory for the selected build variant.
+ * @internal Used by loadSharedModule()
+ */
+export async function loadModuleFactory(): Promise<ModuleFactory> {
+  const { variant, factory } = await importFactory("mmg");
+  loadedVariant = variant;
+  return factory;
+}
+
+/**
+ * Import the factory of a module for the selected build variant, falling
+ * back to the next variant when an artifact is not available
+ */
+async function importFactory(
+  name: ModuleName | "mmg",
+): Promise<{ variant: WasmVariant; factory: ModuleFactory }> {
+  const candidates: WasmVariant[] = [];
+  if (
+    preferredVariant === "memory64" ||
+    (preferredVariant === "auto" &&
+      requiredHeap > WASM32_HEAP_MAX &&
+      isMemory64Supported())
+  ) {
+    candidates.push("memory64");
+  }
+  if (preferredVariant === "opfs") {
+    candidates.push("opfs");
+  }
+  if (
+    preferredVariant === "threads" ||
+    (preferredVariant === "auto" && isThreadingSupported())
+  ) {
+    candidates.push("threads");
+  }
+  if (
+    preferredVariant === "simd" ||
+    (preferredVariant === "auto" && isSimdSupported())
+  ) {
+    candidates.push("simd");
+  }
+
+  for (const variant of candidates) {
+    try {
+      const path = artifactPath(name, variant, "js");
+      const factory = (await import(/* @vite-ignore */ path))
+        .default as ModuleFactory;
+      return { variant, factory };
+    } catch (error) {
+      if (preferredVariant === variant) {
+        throw new Error(`Failed to load the ${variant} WASM build: ${error}`);
+      }
+      // Artifact not built or not reachable, try the next variant
+    }
+  }
+
+  const factory =
+    name === "mmg"
+      ? (await import("../build/dist/mmg.js")).default
+      : ((await import(/* @vite-ignore */ artifactPath(name, "scalar", "js")))
+          .default as ModuleFactory);
+  return { variant: "scalar", factory };
+}
+
+/**
+ * Compile the WASM binary of a variant, or null if it cannot be fetched here
+ * (Emscripten then loads it itself)
+ */
+async function compileVariant(
+  variant: WasmVariant,
+  name: ModuleName | "mmg" = "mmg",
+): Promise<CompiledModule | null> {
+  try {
+    const url = new URL(artifactPath(name, variant, "wasm"), import.meta.url);
+    if (variant === "memory64") {
+      // The bindings need the signatures of the exports, in the binary
+      const binary = new Uint8Array(await (await fetch(url)).arrayBuffer());
+      const module = await WebAssembly.compile(binary);
+      return { variant, module, pointers: readPointerSignatures(binary) };
+    }
+    const module =
+      typeof WebAssembly.compileStreaming === "function"
+        ? await WebAssembly.compileStreaming(fetch(url))
+        : await WebAssembly.compile(await (await fetch(url)).arrayBuffer());
+    return { variant, module };
+  } catch {
+    return null;
+  }
+}
+
+/**
+ * Get the compiled WASM module of the selected build variant, compiling it
+ * on first use. Resolves to null when the binary cannot be fetched directly.
+ *
+ * MeshWorker posts it to its worker, so every worker instantiates the same
+ * compiled code instead of compiling the binary again.
+ */
+export async function getCompiledModule(): Promise<CompiledModule | null> {
+  if (!compiledModule) {
+    compiledModule = loadModuleFactory().then(() =>
+      compileVariant(loadedVariant as WasmVariant),
+    );
+  }
+  return compiledModule;
+}
+
+/**
+ * Provide an already compiled WASM module (e.g. received from the main
+ * thread) for the next instantiation. It is only used if its variant is the
+ * one being loaded, which it is selected as unless setWasmVariant() overrides
+ * it.
+ */
+export function setCompiledModule(compiled: CompiledModule): void {
+  preferredVariant = compiled.variant;
+  compiledModule = Promise.resolve(compiled);
+}
+
+/**
+ * Instantiate the selected build once, shared by every MMG module.
+ * @internal Used by the initMMG* functions
+ * @param heapBytes - Heap the meshes are expected to need (see InitOptions)
+ */
+export function loadSharedModule(heapBytes = 0): Promise<unknown> {
+  requiredHeap = Math.max(requiredHeap, heapBytes);
+  if (!sharedInstance) {
+    sharedInstance = (async () => {
+      const createModule = await loadModuleFactory();
+      const compiled = await getCompiledModule();
+      return createInstance(
+        createModule,
+        loadedVariant as WasmVariant,
+        compiled,
+      );
+    })();
+    // Let a later init retry after a failed load
+    sharedInstance.catch(() => {
+      sharedInstance = null;
+    });
+  }
+  return sharedInstance;
+}
+
+/**
+ * Instantiate the module of one mesh type when split modules are enabled
+ * (see setSplitModules), the shared module otherwise or when its artifacts
+ * are not available.
+ * @internal Used by the initMMG* functions
+ * @param name - Module of the mesh type
+ * @param heapBytes - Heap the meshes are expected to need (see InitOptions)
+ */
+export function loadModule(name: ModuleName, heapBytes = 0): Promise<unknown> {
+  if (!splitModules) {
+    return loadSharedModule(heapBytes);
+  }
+  requiredHeap = Math.max(requiredHeap, heapBytes);
+  let instance = splitInstances.get(name);
+  if (!instance) {
+    instance = (async () => {
+      let imported: { variant: WasmVariant; factory: ModuleFactory };
+      try {
+        imported = await importFactory(name);
+      } catch {
+        return loadSharedModule();
+      }
+      loadedVariant = imported.variant;
+      // Emscripten fetches and stream-compiles the binary itself
+      // (WebAssembly.instantiateStreaming); only memory64 needs it first
+      const compiled =
+        imported.variant === "memory64"
+          ? await compileVariant(imported.variant, name)
+          : null;
+      return createInstance(imported.factory, imported.variant, compiled);
+    })();
+    splitInstances.set(name, instance);
+    // Let a later init retry after a failed load
+    instance.catch(() => {
+      splitInstances.delete(name);
+    });
+  }
+  return instance;
+}
+
+/**
+ * Create a module instance of a variant, from its compiled module when it
+ * matches
+ */
+async function createInstance(
+  createModule: ModuleFactory,
+  variant: WasmVariant,
+  compiled: CompiledModule | null,
+): Promise<unknown> {
+  const matching = compiled?.variant === variant ? compiled : null;
+  if (variant === "memory64") {
+    // Its exports take and return BigInt pointers until wrapped
+    if (!matching?.pointers) {
+      throw new Error(
+        "Failed to load the memory64 WASM build: its binary cannot be fetched",
+      );
+    }
+    const instance = await instantiate(createModule, matching);
+    wrapPointerExports(
+      instance as unknown as Record<string, unknown>,
+      matching.pointers,
+    );
+    return instance;
+  }
+  return matching ? instantiate(createModule, matching) : createModule();
+}
+
+/**
+ * Instantiate a build from its compiled module rather than letting Emscripten
+ * fetch and compile the binary again
+ */
+function instantiate(
+  createModule: ModuleFactory,
+  compiled: CompiledModule,
+): ReturnType<ModuleFactory> {
+  // Emscripten has no error path for this hook, so a failed instantiation
+  // rejects through the race
+  let fail: (error: unknown) => void = () => {};
+  const failed = new Promise<never>((_, reject) => {
+    fail = reject;
+  });
+  return Promise.race([
+    createModule({
+      instantiateWasm(imports, receiveInstance) {
+        WebAssembly.instantiate(compiled.module, imports).then(
+          (instance) => receiveInstance(instance, compiled.module),
+          fail,
+        );
+        return {};
+      },
+    }),
+    failed,
+  ]);
+}
@@ -0,0 +1,384 @@
+/**
+ * Native point location in simplex meshes (see locate.h)
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include "locate.h"
+
+/* Coordinates of a 1-based vertex */
+static const double* vertex(const MmgwasmElements* e, int v) {
+    return (const double*)((const char*)e->coords +
+                           (size_t)(v - 1) * e->coord_stride);
+}
+
+/* Vertex indices of a 1-based element */
+static const int* element(const MmgwasmElements* e, int k) {
+    return (const int*)((const char*)e->elems +
+                        (size_t)(k - 1) * e->elem_stride);
+}
+
+/* Point of dim coordinates widened to 3, z = 0 in 2D */
+static void widen(const double* x, int dim, double* p) {
+    p[0] = x[0];
+    p[1] = x[1];
+    p[2] = dim == 3 ? x[2] : 0.0;
+}
+
+static double det3(const double* u, const double* v, const double* w) {
+    return u[0] * (v[1] * w[2] - v[2] * w[1]) -
+           u[1] * (v[0] * w[2] - v[2] * w[0]) +
+           u[2] * (v[0] * w[1] - v[1] * w[0]);
+}
+
+/*
+ * Barycentric coordinates of x relative to a tetrahedron or a planar
+ * triangle, negative outside it. Returns 0 for a degenerate element.
+ */
+static int coordinates(const MmgwasmElements* e, const int* v,
+                       const double* x, double* l) {
+    double a[3], d[3][3], dx[3];
+    widen(vertex(e, v[0]), e->dim, a);
+    for (int i = 1; i < e->nverts; i++) {
+        double p[3];
+        widen(vertex(e, v[i]), e->dim, p);
+        for (int c = 0; c < 3; c++) {
+            d[i - 1][c] = p[c] - a[c];
+        }
+    }
+    for (int c = 0; c < 3; c++) {
+        dx[c] = x[c] - a[c];
+    }
+
+    if (e->nverts == 4) {
+        double vol = det3(d[0], d[1], d[2]);
+        if (vol == 0.0) {
+            return 0;
+        }
+        l[1] = det3(dx, d[1], d[2]) / vol;
+        l[2] = det3(d[0], dx, d[2]) / vol;
+        l[3] = det3(d[0], d[1], dx) / vol;
+        l[0] = 1.0 - l[1] - l[2] - l[3];
+    } else {
+        double area = d[0][0] * d[1][1] - d[0][1] * d[1][0];
+        if (area == 0.0) {
+            return 0;
+        }
+        l[1] = (dx[0] * d[1][1] - dx[1] * d[1][0]) / area;
+        l[2] = (d[0][0] * dx[1] - d[0][1] * dx[0]) / area;
+        l[0] = 1.0 - l[1] - l[2];
+    }
+    return 1;
+}
+
+/*
+ * Barycentric coordinates of x in a tetrahedron or a planar triangle.
+ * Returns 1 if x lies inside (within MMGWASM_LOCATE_EPSILON), 0 otherwise or
+ * for a degenerate element.
+ */
+static int barycentric(const MmgwasmElements* e, const int* v,
+                       const double* x, double* bary) {
+    double l[4];
+    if (!coordinates(e, v, x, l)) {
+        return 0;
+    }
+    for (int i = 0; i < e->nverts; i++) {
+        if (l[i] < -MMGWASM_LOCATE_EPSILON) {
+            return 0;
+        }
+    }
+    for (int i = 0; i < e->nverts; i++) {
+        bary[i] = l[i];
+    }
+    return 1;
+}
+
+/*
+ * Closest point to x on the triangle abc (Ericson, Real-Time Collision
+ * Detection, 5.1.5), returns the squared distance and fills the barycentric
+ * coordinates of that point
+ */
+static double closest_on_triangle(const double* a, const double* b,
+                                  const double* c, const double* x,
+                                  double* bary) {
+    double ab[3], ac[3], ap[3], bp[3], cp[3];
+    for (int i = 0; i < 3; i++) {
+        ab[i] = b[i] - a[i];
+        ac[i] = c[i] - a[i];
+        ap[i] = x[i] - a[i];
+        bp[i] = x[i] - b[i];
+        cp[i] = x[i] - c[i];
+    }
+#define DOT(u, w) ((u)[0] * (w)[0] + (u)[1] * (w)[1] + (u)[2] * (w)[2])
+    double d1 = DOT(ab, ap), d2 = DOT(ac, ap);
+    double d3 = DOT(ab, bp), d4 = DOT(ac, bp);
+    double d5 = DOT(ab, cp), d6 = DOT(ac, cp);
+#undef DOT
+    double u, w;  /* weights of b and c */
+    if (d1 <= 0.0 && d2 <= 0.0) {
+        u = 0.0, w = 0.0;
+    } else if (d3 >= 0.0 && d4 <= d3) {
+        u = 1.0, w = 0.0;
+    } else if (d6 >= 0.0 && d5 <= d6) {
+        u = 0.0, w = 1.0;
+    } else {
+        double vc = d1 * d4 - d3 * d2;
+        double vb = d5 * d2 - d1 * d6;
+        double va = d3 * d6 - d5 * d4;
+        if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0) {
+            u = d1 / (d1 - d3), w = 0.0;
+        } else if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0) {
+            u = 0.0, w = d2 / (d2 - d6);
+        } else if (va <= 0.0 && d4 - d3 >= 0.0 && d5 - d6 >= 0.0) {
+            w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+            u = 1.0 - w;
+        } else {
+            /* A degenerate triangle falls back to its first vertex */
+            double denom = va + vb + vc;
+            u = denom != 0.0 ? vb / denom : 0.0;
+            w = denom != 0.0 ? vc / denom : 0.0;
+        }
+    }
+
+    double dist2 = 0.0;
+    for (int i = 0; i < 3; i++) {
+        double delta = x[i] - (a[i] + u * ab[i] + w * ac[i]);
+        dist2 += delta * delta;
+    }
+    bary[0] = 1.0 - u - w;
+    bary[1] = u;
+    bary[2] = w;
+    return dist2;
+}
+
+/* Squared distance from x to a triangle element of any dimension */
+static double triangle_distance(const MmgwasmElements* e, const int* v,
+                                const double* x, double* bary) {
+    double a[3], b[3], c[3];
+    widen(vertex(e, v[0]), e->dim, a);
+    widen(vertex(e, v[1]), e->dim, b);
+    widen(vertex(e, v[2]), e->dim, c);
+    return closest_on_triangle(a, b, c, x, bary);
+}
+
+/* Squared distance from x to a tetrahedron, 0 inside, else to its faces */
+static double tetrahedron_distance(const MmgwasmElements* e, const int* v,
+                                   const double* x, double* bary) {
+    if (barycentric(e, v, x, bary)) {
+        return 0.0;
+    }
+    double p[4][3];
+    for (int i = 0; i < 4; i++) {
+        widen(vertex(e, v[i]), e->dim, p[i]);
+    }
+    double best = HUGE_VAL;
+    for (int f = 0; f < 4; f++) {
+        /* Face f is opposite vertex f */
+        int i0 = (f + 1) % 4, i1 = (f + 2) % 4, i2 = (f + 3) % 4;
+        double l[3];
+        double dist2 = closest_on_triangle(p[i0], p[i1], p[i2], x, l);
+        if (dist2 < best) {
+            best = dist2;
+            bary[f] = 0.0;
+            bary[i0] = l[0];
+            bary[i1] = l[1];
+            bary[i2] = l[2];
+        }
+    }
+    return best;
+}
+
+/* Squared distance from x to an element, filling the closest point's
+   barycentric coordinates */
+typedef double (*ElementDistance)(const MmgwasmElements* e, const int* v,
+                                  const double* x, double* bary);
+
+/* The element closest to x, visiting nearer nodes first */
+static int locate_closest(const MmgwasmLocator* locator,
+                          const MmgwasmElements* e, const double* x,
+                          ElementDistance distance, double* bary) {
+    const MmgwasmBvh* bvh = &locator->bvh;
+    double best = HUGE_VAL;
+    int found = 0;
+    int stack[MMGWASM_BVH_MAX_DEPTH];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        int n = stack[--top];
+        const MmgwasmBvhNode* node = &bvh->nodes[n];
+        if (mmgwasm_bvh_node_dist2(node, x) >= best) {
+            continue;
+        }
+        if (node->count > 0) {
+            for (int i = 0; i < node->count; i++) {
+                int k = bvh->order[node->first + i] + 1;
+                double l[4];
+                double dist2 = distance(e, element(e, k), x, l);
+                if (dist2 < best) {
+                    best = dist2;
+                    found = k;
+                    if (bary) {
+                        for (int j = 0; j < e->nverts; j++) {
+                            bary[j] = l[j];
+                        }
+                    }
+                }
+            }
+        } else {
+            /* Push the farther child first so the nearer one is popped next */
+            int left = n + 1, right = node->first;
+            if (mmgwasm_bvh_node_dist2(&bvh->nodes[left], x) <
+                mmgwasm_bvh_node_dist2(&bvh->nodes[right], x)) {
+                stack[top++] = right;
+                stack[top++] = left;
+            } else {
+                stack[top++] = left;
+                stack[top++] = right;
+            }
+        }
+    }
+    return found;
+}
+
+int mmgwasm_locator_build(MmgwasmLocator* locator,
+                          const MmgwasmElements* e) {
+    mmgwasm_locator_free(locator);
+    if (e->nelem <= 0) {
+        return 1;
+    }
+
+    double* boxes = (double*)malloc((size_t)e->nelem * 6 * sizeof(double));
+    if (!boxes) {
+        return 0;
+    }
+    for (int k = 1; k <= e->nelem; k++) {
+        const int* v = element(e, k);
+        double* box = boxes + (size_t)(k - 1) * 6;
+        for (int i = 0; i < e->nverts; i++) {
+            double p[3];
+            widen(vertex(e, v[i]), e->dim, p);
+            for (int d = 0; d < 3; d++) {
+                if (i == 0 || p[d] < box[d]) box[d] = p[d];
+                if (i == 0 || p[d] > box[3 + d]) box[3 + d] = p[d];
+            }
+        }
+    }
+    int ok = mmgwasm_bvh_build(&locator->bvh, boxes, e->nelem);
+    free(boxes);
+    return ok;
+}
+
+void mmgwasm_locator_free(MmgwasmLocator* locator) {
+    mmgwasm_bvh_free(&locator->bvh);
+    locator->generation = 0;
+}
+
+int mmgwasm_locate(const MmgwasmLocator* locator,
+                   const MmgwasmElements* e, const double* x,
+                   double* bary) {
+    if (locator->bvh.nnodes == 0) {
+        return 0;
+    }
+    double p[3];
+    widen(x, e->dim, p);
+    if (e->dim == 3 && e->nverts == 3) {
+        return locate_closest(locator, e, p, triangle_distance, bary);
+    }
+
+    const MmgwasmBvh* bvh = &locator->bvh;
+    int stack[MMGWASM_BVH_MAX_DEPTH];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const MmgwasmBvhNode* node = &bvh->nodes[stack[--top]];
+        if (!mmgwasm_bvh_node_contains(node, p)) {
+            continue;
+        }
+        if (node->count > 0) {
+            for (int i = 0; i < node->count; i++) {
+                int k = bvh->order[node->first + i] + 1;
+                double l[4];
+                if (barycentric(e, element(e, k), p, l)) {
+                    if (bary) {
+                        for (int j = 0; j < e->nverts; j++) {
+                            bary[j] = l[j];
+                        }
+                    }
+                    return k;
+                }
+            }
+        } else {
+            stack[top++] = node->first;
+            stack[top++] = (int)(node - bvh->nodes) + 1;
+        }
+    }
+    return 0;
+}
+
+int mmgwasm_locate_nearest(const MmgwasmLocator* locator,
+                           const MmgwasmElements* e, const double* x,
+                           double* bary) {
+    int k = mmgwasm_locate(locator, e, x, bary);
+    if (k || locator->bvh.nnodes == 0 || (e->dim == 3 && e->nverts == 3)) {
+        return k;
+    }
+    double p[3];
+    widen(x, e->dim, p);
+    return locate_closest(locator, e, p,
+                          e->nverts == 4 ? tetrahedron_distance
+                                         : triangle_distance,
+                          bary);
+}
+
+/* Interpolate size values per vertex in element k */
+static void interpolate(const MmgwasmElements* e, int k, const double* bary,
+                        const double* values, int size, double* out) {
+    const int* v = element(e, k);
+    for (int c = 0; c < size; c++) {
+        out[c] = 0.0;
+    }
+    for (int j = 0; j < e->nverts; j++) {
+        const double* src = values + (size_t)(v[j] - 1) * size;
+        for (int c = 0; c < size; c++) {
+            out[c] += bary[j] * src[c];
+        }
+    }
+}
+
+int mmgwasm_locate_sample(const MmgwasmLocator* locator,
+                          const MmgwasmElements* e,
+                          const double* values, int size,
+                          const double* points, int n, double* out) {
+    int located = 0;
+    for (int i = 0; i < n; i++) {
+        double l[4];
+        double* dst = out + (size_t)i * size;
+        int k = mmgwasm_locate(locator, e, points + (size_t)i * e->dim, l);
+        if (!k) {
+            for (int c = 0; c < size; c++) {
+                dst[c] = NAN;
+            }
+            continue;
+        }
+        interpolate(e, k, l, values, size, dst);
+        located++;
+    }
+    return located;
+}
+
+int mmgwasm_locate_transfer(const MmgwasmLocator* locator,
+                            const MmgwasmElements* e,
+                            const double* values, int size,
+                            const double* coords, size_t stride, int np,
+                            double* out) {
+    const char* point = (const char*)coords;
+    for (int i = 0; i < np; i++, point += stride) {
+        double l[4];
+        int k = mmgwasm_locate_nearest(locator, e, (const double*)point, l);
+        if (!k) {
+            return 0;
+        }
+        interpolate(e, k, l, values, size, out + (size_t)i * size);
+    }
+    return 1;
+}
@@ -0,0 +1,100 @@
+/**
+ * Native point location in simplex meshes
+ *
+ * A locator indexes the elements of a mesh (tetrahedra of MMG3D, triangles of
+ * MMG2D and MMGS) in a bounding volume hierarchy (bvh.h) and answers "which
+ * element contains point p" with barycentric coordinates, so solution values
+ * can be probed at arbitrary points.
+ *
+ * Volume meshes (tetrahedra in 3D, triangles in 2D) locate the element that
+ * contains the point. Surface meshes (triangles in 3D) have no interior, so
+ * the point is projected onto the closest triangle instead.
+ *
+ * The wrappers keep one locator per handle and rebuild it lazily when the
+ * mesh generation changes. The locator of a mesh kept from before a remesh
+ * also transfers user fields onto the new vertices.
+ */
+
+#ifndef MMGWASM_LOCATE_H
+#define MMGWASM_LOCATE_H
+
+#include <stddef.h>
+#include "bvh.h"
+
+/* Relative tolerance on barycentric coordinates for points on element faces */
+#define MMGWASM_LOCATE_EPSILON 1e-10
+
+/*
+ * Element arrays read in place from MMG's structures: consecutive entries are
+ * stride bytes apart, and vertex indices are 1-based as in MMG.
+ */
+typedef struct {
+    int dim;              /* coordinates per vertex, 2 or 3 */
+    int nverts;           /* vertices per element, 3 or 4 */
+    const double* coords; /* coordinates of vertex 1 */
+    size_t coord_stride;
+    const int* elems;     /* vertex indices of element 1 */
+    size_t elem_stride;
+    int nelem;
+} MmgwasmElements;
+
+typedef struct {
+    MmgwasmBvh bvh;
+    unsigned int generation;  /* mesh generation at build time, 0 = never */
+} MmgwasmLocator;
+
+/*
+ * Index the elements of a mesh, replacing any previous index.
+ * Returns 1 on success, 0 on allocation failure (the locator is left empty).
+ */
+int mmgwasm_locator_build(MmgwasmLocator* locator,
+                          const MmgwasmElements* elements);
+
+/* Release the memory of a locator and reset it to empty */
+void mmgwasm_locator_free(MmgwasmLocator* locator);
+
+/*
+ * Locate point x (elements->dim coordinates) in an indexed mesh.
+ * bary, if not NULL, receives the nverts barycentric coordinates of the point
+ * (of its projection for surface meshes).
+ * Returns the 1-based element, or 0 if the point lies outside the mesh.
+ */
+int mmgwasm_locate(const MmgwasmLocator* locator,
+                   const MmgwasmElements* elements, const double* x,
+                   double* bary);
+
+/*
+ * Like mmgwasm_locate, but points outside a volume mesh fall back to the
+ * nearest element, with the barycentric coordinates of their closest point on
+ * it, so every point of a non-empty mesh is found. Returns 0 only for an empty mesh.
+ */
+int mmgwasm_locate_nearest(const MmgwasmLocator* locator,
+                           const MmgwasmElements* elements, const double* x,
+                           double* bary);
+
+/*
+ * Interpolate a vertex solution of size components per vertex (values of
+ * vertex 1 first) at n points.
+ * out receives n * size values, NaN for points outside the mesh.
+ * Returns the number of points located.
+ */
+int mmgwasm_locate_sample(const MmgwasmLocator* locator,
+                          const MmgwasmElements* elements,
+                          const double* values, int size,
+                          const double* points, int n, double* out);
+
+/*
+ * Transfer vertex fields of size values per vertex (values of vertex 1 first)
+ * onto np points read in place, stride bytes apart as in mmgwasm_sizing_apply.
+ * Points are found with mmgwasm_locate_nearest, so vertices of a remeshed
+ * boundary that moved slightly outside the source mesh still get values.
+ * out receives np * size values.
+ * Returns 1 on success, 0 for an empty source mesh.
+ */
+int mmgwasm_locate_transfer(const MmgwasmLocator* locator,
+                            const MmgwasmElements* elements,
+                            const double* values, int size,
+                            const double* coords, size_t stride, int np,
+                            double* out);
+
+#endif /* MMGWASM_LOCATE_H */
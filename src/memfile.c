@@ -0,0 +1,198 @@
+/**
+ * In-memory files for MMG's file-based I/O (see memfile.h)
+ */
+
+#define _GNU_SOURCE
+#include <emscripten.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include "memfile.h"
+
+/* Memfile served by fopen on the current thread */
+static _Thread_local MmgwasmMemFile* t_memfile = NULL;
+
+FILE* __real_fopen(const char* path, const char* mode);
+
+/**
+ * Create an empty memfile.
+ * @param capacity - Bytes to preallocate (e.g. the Content-Length), may be 0
+ * @returns The memfile, or NULL on allocation failure
+ */
+EMSCRIPTEN_KEEPALIVE
+MmgwasmMemFile* mmgwasm_memfile_create(int capacity) {
+    MmgwasmMemFile* file = (MmgwasmMemFile*)calloc(1, sizeof(MmgwasmMemFile));
+    if (!file) {
+        return NULL;
+    }
+    if (capacity > 0) {
+        file->data = (char*)malloc((size_t)capacity);
+        if (!file->data) {
+            free(file);
+            return NULL;
+        }
+        file->capacity = (size_t)capacity;
+    }
+    return file;
+}
+
+/**
+ * Reserve room for size more bytes at the end of a memfile.
+ * The capacity grows geometrically, so a file filled in many small chunks
+ * is only copied a logarithmic number of times.
+ * @returns Pointer where the bytes must be written before calling
+ *          mmgwasm_memfile_commit, or NULL on failure. Only valid until the
+ *          next reserve.
+ */
+EMSCRIPTEN_KEEPALIVE
+char* mmgwasm_memfile_reserve(MmgwasmMemFile* file, int size) {
+    if (!file || size < 0) {
+        return NULL;
+    }
+
+    size_t needed = file->size + (size_t)size;
+    if (needed > file->capacity) {
+        size_t capacity = file->capacity ? file->capacity : 64 * 1024;
+        while (capacity < needed) {
+            capacity *= 2;
+        }
+        char* data = (char*)realloc(file->data, capacity);
+        if (!data) {
+            return NULL;
+        }
+        file->data = data;
+        file->capacity = capacity;
+    }
+    return file->data + file->size;
+}
+
+/**
+ * Append size bytes written at the pointer returned by mmgwasm_memfile_reserve.
+ * @returns 1 on success, 0 if size exceeds the reserved room
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmgwasm_memfile_commit(MmgwasmMemFile* file, int size) {
+    if (!file || size < 0 || file->size + (size_t)size > file->capacity) {
+        return 0;
+    }
+    file->size += (size_t)size;
+    return 1;
+}
+
+/**
+ * Get a pointer to the contents of a memfile (mmgwasm_memfile_size bytes).
+ */
+EMSCRIPTEN_KEEPALIVE
+const char* mmgwasm_memfile_data(MmgwasmMemFile* file) {
+    return file ? file->data : NULL;
+}
+
+/**
+ * Get the number of bytes in a memfile.
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmgwasm_memfile_size(MmgwasmMemFile* file) {
+    return file ? (int)file->size : 0;
+}
+
+/**
+ * Free a memfile and its contents.
+ */
+EMSCRIPTEN_KEEPALIVE
+void mmgwasm_memfile_free(MmgwasmMemFile* file) {
+    if (file) {
+        free(file->data);
+        free(file);
+    }
+}
+
+void mmgwasm_memfile_attach(MmgwasmMemFile* file) {
+    t_memfile = file;
+}
+
+/* Write position of a memfile opened for writing */
+typedef struct {
+    MmgwasmMemFile* file;
+    size_t pos;
+} WriteCookie;
+
+/* Write at the current position, growing the memfile past its end */
+static ssize_t memfile_write(void* cookie, const char* buf, size_t size) {
+    WriteCookie* c = (WriteCookie*)cookie;
+    MmgwasmMemFile* file = c->file;
+    size_t end = c->pos + size;
+    if (end > file->size) {
+        size_t extra = end - file->size;
+        if (extra > INT_MAX ||
+            !mmgwasm_memfile_reserve(file, (int)extra)) {
+            return 0;
+        }
+        file->size = end;
+    }
+    memcpy(file->data + c->pos, buf, size);
+    c->pos = end;
+    return (ssize_t)size;
+}
+
+/* Seek within the written bytes (MMG's binary writers may rewind) */
+static int memfile_seek(void* cookie, off_t* offset, int whence) {
+    WriteCookie* c = (WriteCookie*)cookie;
+    off_t base = whence == SEEK_SET ? 0
+               : whence == SEEK_CUR ? (off_t)c->pos
+               : (off_t)c->file->size;
+    off_t pos = base + *offset;
+    if (pos < 0 || (size_t)pos > c->file->size) {
+        return -1;
+    }
+    c->pos = (size_t)pos;
+    *offset = pos;
+    return 0;
+}
+
+static int memfile_close(void* cookie) {
+    free(cookie);
+    return 0;
+}
+
+/*
+ * fopen hook, installed with -Wl,--wrap.
+ * Paths under MMGWASM_MEMFILE_PATH are opened on the attached memfile:
+ * reading serves its contents, writing truncates it and appends to it.
+ * Everything else goes to the Emscripten filesystem.
+ */
+FILE* __wrap_fopen(const char* path, const char* mode) {
+    if (t_memfile && path &&
+        strncmp(path, MMGWASM_MEMFILE_PATH, strlen(MMGWASM_MEMFILE_PATH)) == 0) {
+        if (strchr(mode, 'r')) {
+            if (t_memfile->size == 0) {
+                return NULL;
+            }
+            return fmemopen(t_memfile->data, t_memfile->size, mode);
+        }
+
+        WriteCookie* cookie = (WriteCookie*)malloc(sizeof(WriteCookie));
+        if (!cookie) {
+            return NULL;
+        }
+        if (strchr(mode, 'a') == NULL) {
+            t_memfile->size = 0;
+        }
+        cookie->file = t_memfile;
+        cookie->pos = t_memfile->size;
+
+        cookie_io_functions_t io = {
+            .read = NULL,
+            .write = memfile_write,
+            .seek = memfile_seek,
+            .close = memfile_close,
+        };
+        FILE* stream = fopencookie(cookie, mode, io);
+        if (!stream) {
+            free(cookie);
+        }
+        return stream;
+    }
+    return __real_fopen(path, mode);
+}
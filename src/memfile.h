@@ -0,0 +1,33 @@
+/**
+ * In-memory files for MMG's file-based I/O
+ *
+ * MMG only reads and writes meshes through fopen'ed files. A memfile is a
+ * growable byte buffer in linear memory that JavaScript fills in place
+ * (reserve, write through HEAPU8, commit), chunk by chunk if needed. While a
+ * memfile is attached to the current thread, fopen calls on
+ * MMGWASM_MEMFILE_PATH with any extension are served from it (fopen is linked
+ * with -Wl,--wrap, see CMakeLists.txt): files opened for reading see its
+ * contents, files opened for writing replace them. The data never goes
+ * through the Emscripten filesystem, and JavaScript reads saved output
+ * straight from the heap.
+ */
+
+#ifndef MMGWASM_MEMFILE_H
+#define MMGWASM_MEMFILE_H
+
+#include <stddef.h>
+
+/* Path prefix served from the attached memfile (MMGWASM_MEMFILE_PATH ".meshb") */
+#define MMGWASM_MEMFILE_PATH "/mmgwasm/memfile"
+
+/* Growable in-memory file */
+typedef struct {
+    char* data;
+    size_t size;      /* committed bytes */
+    size_t capacity;  /* allocated bytes */
+} MmgwasmMemFile;
+
+/* Attach a memfile to the current thread, or detach it with NULL */
+void mmgwasm_memfile_attach(MmgwasmMemFile* file);
+
+#endif /* MMGWASM_MEMFILE_H */
@@ -0,0 +1,118 @@
+/**
+ * In-memory files in the WASM heap
+ *
+ * A memfile is a growable byte buffer owned by the C side (src/memfile.c)
+ * that the MMG loaders and writers use as if it were a file. Data goes
+ * straight between JS and WASM memory, so loading or saving a mesh never
+ * keeps a second copy in the Emscripten virtual filesystem.
+ *
+ * A memfile pointer must be released with `freeMemFile`.
+ */
+
+import type { WasmModule } from "./memory";
+
+/** Module functions backing memfiles (exported by every MMG module) */
+export interface MemFileModule extends WasmModule {
+  _mmgwasm_memfile_create(capacity: number): number;
+  _mmgwasm_memfile_reserve(file: number, size: number): number;
+  _mmgwasm_memfile_commit(file: number, size: number): number;
+  _mmgwasm_memfile_data(file: number): number;
+  _mmgwasm_memfile_size(file: number): number;
+  _mmgwasm_memfile_free(file: number): void;
+}
+
+/**
+ * Create an empty memfile.
+ *
+ * @param module - The WASM module
+ * @param capacity - Bytes to preallocate, e.g. a known Content-Length
+ *   (the memfile grows as needed either way)
+ * @returns Pointer to the memfile
+ * @throws Error if the allocation fails
+ */
+export function createMemFile(module: MemFileModule, capacity = 0): number {
+  const file = module._mmgwasm_memfile_create(capacity);
+  if (file === 0) {
+    throw new Error(`Failed to allocate a memfile of ${capacity} bytes`);
+  }
+  return file;
+}
+
+/**
+ * Append bytes to a memfile, copying them directly into WASM memory.
+ *
+ * @param module - The WASM module
+ * @param file - The memfile
+ * @param chunk - Bytes to append
+ * @throws Error if the memfile cannot grow
+ */
+export function appendToMemFile(
+  module: MemFileModule,
+  file: number,
+  chunk: Uint8Array,
+): void {
+  if (chunk.length === 0) {
+    return;
+  }
+  const ptr = module._mmgwasm_memfile_reserve(file, chunk.length);
+  if (ptr === 0) {
+    throw new Error(`Failed to grow memfile by ${chunk.length} bytes`);
+  }
+  // Reserving may grow the heap, so HEAPU8 is read afterwards
+  module.HEAPU8.set(chunk, ptr);
+  module._mmgwasm_memfile_commit(file, chunk.length);
+}
+
+/**
+ * Append everything left in a stream to a memfile, one chunk at a time.
+ *
+ * Only the chunk being copied is held on the JS side, so the whole file is
+ * never materialized outside WASM memory.
+ *
+ * @param module - The WASM module
+ * @param file - The memfile
+ * @param reader - Reader of the byte stream (released when done)
+ * @throws Error if reading fails or the memfile cannot grow
+ */
+export async function appendStreamToMemFile(
+  module: MemFileModule,
+  file: number,
+  reader: ReadableStreamDefaultReader<Uint8Array>,
+): Promise<void> {
+  try {
+    for (;;) {
+      const { done, value } = await reader.read();
+      if (done) {
+        return;
+      }
+      appendToMemFile(module, file, value);
+    }
+  } finally {
+    reader.releaseLock();
+  }
+}
+
+/**
+ * Copy the contents of a memfile out of WASM memory.
+ *
+ * @param module - The WASM module
+ * @param file - The memfile
+ * @returns A copy of the bytes, independent of the WASM heap
+ */
+export function readMemFile(module: MemFileModule, file: number): Uint8Array {
+  const ptr = module._mmgwasm_memfile_data(file);
+  const size = module._mmgwasm_memfile_size(file);
+  return module.HEAPU8.slice(ptr, ptr + size);
+}
+
+/**
+ * Free a memfile and its contents.
+ *
+ * @param module - The WASM module
+ * @param file - The memfile (0 is ignored)
+ */
+export function freeMemFile(module: MemFileModule, file: number): void {
+  if (file !== 0) {
+    module._mmgwasm_memfile_free(file);
+  }
+}
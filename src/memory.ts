@@ -13,6 +13,10 @@
 /**
  * Minimal interface for any Emscripten module with memory operations.
  * This allows the utilities to work with any WASM module (MMG3D, MMGS, MMG2D, etc.)
+ *
+ * Pointers are plain numbers in every build, the memory64 one included (see
+ * memory64.ts), so heap indices are computed as `ptr / bytes`: a bit shift
+ * would truncate pointers beyond 4 GB.
  */
 export interface WasmModule {
   _malloc(size: number): number;
@@ -25,8 +29,8 @@ export interface WasmModule {
 /**
  * Memory statistics for the WASM module.
  *
- * Tracks both the WASM heap size and allocations made through mmg-wasm utilities.
- * Note: heapUsed only tracks JS-side allocations (toWasm* functions), not MMG's internal C mallocs.
+ * Tracks the WASM heap size, allocations made through mmg-wasm utilities
+ * (heapUsed) and the memory held by the C side, MMG included (nativeUsed).
  */
 export interface MemoryStats {
   /** Current WASM heap buffer size in bytes */
@@ -38,10 +42,41 @@ export interface MemoryStats {
    * Note: This only accounts for JS-side allocations, not MMG's internal C mallocs.
    */
   trackedHeapFree: number;
-  /** Maximum heap size allowed (default: 2GB for 32-bit WASM) */
+  /**
+   * Maximum heap size allowed (the build's limit for modules that report it,
+   * 2GB otherwise)
+   */
   heapMax: number;
   /** Percentage of heapMax used (heapUsed / heapMax * 100) */
   usagePercent: number;
+  /**
+   * Bytes currently allocated on the heap besides the tracked JS-side ones:
+   * MMG's meshes, solutions and working memory, and wrapper buffers (0 for
+   * modules without native accounting)
+   */
+  nativeUsed: number;
+  /** Most bytes the C side held at once since the last resetNativePeak() */
+  nativePeak: number;
+}
+
+/** Module functions reading the allocator's usage of the heap */
+export interface NativeMemoryModule extends WasmModule {
+  _mmgwasm_native_heap_used(): number;
+  _mmgwasm_native_heap_peak(): number;
+  _mmgwasm_native_heap_reset_peak(): void;
+  _mmgwasm_heap_max(): number;
+}
+
+/**
+ * Memory held for a single mesh handle
+ */
+export interface HandleMemoryUsage {
+  /** Bytes MMG has allocated for the mesh and its solution */
+  used: number;
+  /** MMG's memory limit for the handle (see the mem parameter) */
+  max: number;
+  /** Bytes of the handle's arena, 0 outside arena mode (see setArenaMode) */
+  arena: number;
 }
 
 /**
@@ -355,6 +390,27 @@ export function fromWasmUint32(
   return result;
 }
 
+/**
+ * Check whether a typed-array view still aliases the live WASM heap.
+ *
+ * Zero-copy views (e.g. `MMG3D.getVerticesView`) are created over the heap
+ * buffer at call time. When the heap grows, Emscripten replaces that buffer
+ * and older views no longer see WASM memory. Empty views are always valid.
+ *
+ * Note: this only detects heap growth. Views are also invalidated when the
+ * mesh is modified, which is tracked by the per-handle generation counter.
+ *
+ * @param module - The WASM module instance
+ * @param view - A view previously obtained from the module heap
+ * @returns true if the view is still backed by the current heap buffer
+ */
+export function isHeapViewValid(
+  module: WasmModule,
+  view: ArrayBufferView,
+): boolean {
+  return view.byteLength === 0 || view.buffer === module.HEAPU8.buffer;
+}
+
 /**
  * Free memory allocated on the WASM heap.
  *
@@ -420,12 +476,118 @@ export function freeWasmArray(module: WasmModule, ptr: number): void {
   module._free(ptr);
 }
 
+// Scratch memory shared by the transfers of a module (not exported)
+interface ScratchRegion {
+  ptr: number;
+  capacity: number;
+  /** Block of one transfer larger than the region may grow, or 0 */
+  oversized: number;
+}
+
+const MIN_SCRATCH_BYTES = 256;
+
+/** Largest region kept between transfers; larger ones are freed after use */
+const MAX_RETAINED_SCRATCH_BYTES = 16 * 1024 * 1024;
+
+const scratchRegions = new WeakMap<WasmModule, ScratchRegion>();
+
+/**
+ * Reserve scratch memory on the WASM heap for one transfer.
+ *
+ * Returns one 8-byte aligned pointer per requested size, all carved out of a
+ * single region owned by the module. The region grows (doubling) up to
+ * MAX_RETAINED_SCRATCH_BYTES and is kept, so repeated transfers such as
+ * re-extracting a mesh on every frame allocate nothing once it is large
+ * enough. A transfer larger than that gets a block of its own, freed by the
+ * next call, so one huge mesh does not pin its size on the heap for good.
+ * The pointers stay valid until the next call for the same module, so they
+ * must not be held across calls that may use scratch memory themselves.
+ *
+ * @internal Used by the transfer functions of each module.
+ * @param module - The WASM module instance
+ * @param sizes - Size in bytes of each buffer (0 gives a valid, empty buffer)
+ * @returns Pointer to each buffer
+ * @throws Error if the region cannot grow
+ */
+export function scratchMemory(module: WasmModule, sizes: number[]): number[] {
+  const offsets: number[] = [];
+  let bytes = 0;
+  for (const size of sizes) {
+    offsets.push(bytes);
+    bytes += Math.ceil(size / 8) * 8;
+  }
+
+  let region = scratchRegions.get(module);
+  if (region?.oversized) {
+    module._free(region.oversized);
+    region.oversized = 0;
+  }
+  if (bytes > MAX_RETAINED_SCRATCH_BYTES) {
+    const ptr = module._malloc(bytes);
+    if (ptr === 0) {
+      throw new Error(`Failed to allocate ${bytes} bytes of scratch memory`);
+    }
+    if (!region) {
+      region = { ptr: 0, capacity: 0, oversized: 0 };
+      scratchRegions.set(module, region);
+    }
+    region.oversized = ptr;
+    return offsets.map((offset) => ptr + offset);
+  }
+  if (!region || region.capacity < bytes) {
+    let capacity = Math.min(
+      Math.max(bytes, 2 * (region?.capacity ?? 0), MIN_SCRATCH_BYTES),
+      MAX_RETAINED_SCRATCH_BYTES,
+    );
+    let ptr = module._malloc(capacity);
+    if (ptr === 0 && capacity > bytes) {
+      // Doubling overshot what the heap can hold, try the exact size
+      capacity = bytes;
+      ptr = module._malloc(capacity);
+    }
+    if (ptr === 0) {
+      throw new Error(`Failed to allocate ${bytes} bytes of scratch memory`);
+    }
+    if (region?.ptr) {
+      module._free(region.ptr);
+    }
+    region = { ptr, capacity, oversized: 0 };
+    scratchRegions.set(module, region);
+  }
+
+  const base = region.ptr;
+  return offsets.map((offset) => base + offset);
+}
+
+/**
+ * Give the scratch memory of a module back to its heap.
+ *
+ * The next transfer allocates a new region. Called once the last mesh of a
+ * module is freed, when no transfer can be pending.
+ *
+ * @internal Used by the free functions of each module.
+ * @param module - The WASM module instance
+ */
+export function releaseScratchMemory(module: WasmModule): void {
+  const region = scratchRegions.get(module);
+  if (!region) {
+    return;
+  }
+  if (region.ptr) {
+    module._free(region.ptr);
+  }
+  if (region.oversized) {
+    module._free(region.oversized);
+  }
+  scratchRegions.delete(module);
+}
+
 /**
  * Get memory statistics for the WASM module.
  *
  * Returns comprehensive memory statistics including heap size, tracked usage,
- * and percentage thresholds. Note that heapUsed only tracks JS-side allocations
- * made through toWasm* functions, not MMG's internal C mallocs.
+ * and percentage thresholds. heapUsed only tracks JS-side allocations made
+ * through toWasm* functions; MMG's allocations are reported in nativeUsed.
  *
  * @param module - The WASM module instance
  * @returns Memory statistics
@@ -440,11 +602,50 @@ export function getMemoryStats(module: WasmModule): MemoryStats {
   const tracker = getOrCreateTracker(module);
   const heapSize = module.HEAPU8.byteLength;
   const heapUsed = tracker.totalAllocated;
-  const heapMax = DEFAULT_HEAP_MAX;
+  const native = hasNativeAccounting(module) ? module : null;
+  const heapMax = native ? native._mmgwasm_heap_max() : DEFAULT_HEAP_MAX;
   const trackedHeapFree = Math.max(0, heapSize - heapUsed);
   const usagePercent = (heapUsed / heapMax) * 100;
+  // The module reports the whole heap, tracked allocations included
+  const nativeUsed = native
+    ? Math.max(0, native._mmgwasm_native_heap_used() - heapUsed)
+    : 0;
+  const nativePeak = native
+    ? Math.max(nativeUsed, native._mmgwasm_native_heap_peak() - heapUsed)
+    : 0;
+
+  return {
+    heapSize,
+    heapUsed,
+    trackedHeapFree,
+    heapMax,
+    usagePercent,
+    nativeUsed,
+    nativePeak,
+  };
+}
 
-  return { heapSize, heapUsed, trackedHeapFree, heapMax, usagePercent };
+function hasNativeAccounting(
+  module: WasmModule,
+): module is NativeMemoryModule {
+  return (
+    typeof (module as Partial<NativeMemoryModule>)
+      ._mmgwasm_native_heap_used === "function"
+  );
+}
+
+/**
+ * Restart native peak tracking from the current usage.
+ *
+ * Call it before a job to read the job's peak from getMemoryStats()
+ * afterwards. Does nothing for modules without native accounting.
+ *
+ * @param module - The WASM module instance
+ */
+export function resetNativePeak(module: WasmModule): void {
+  if (hasNativeAccounting(module)) {
+    module._mmgwasm_native_heap_reset_peak();
+  }
 }
 
 /**
@@ -494,6 +695,7 @@ export function configureMemory(
  *
  * Throws a MemoryError if the allocation would exceed the configured errorThreshold.
  * Use this proactively before large allocations to provide better error messages.
+ * Both the tracked JS-side allocations and the native ones count as used.
  *
  * @param module - The WASM module instance
  * @param bytes - Number of bytes to check
@@ -508,12 +710,14 @@ export function configureMemory(
 export function checkMemoryAvailable(module: WasmModule, bytes: number): void {
   const tracker = getOrCreateTracker(module);
   const stats = getMemoryStats(module);
-  const projectedUsage = (stats.heapUsed + bytes) / stats.heapMax;
+  const used = stats.heapUsed + stats.nativeUsed;
+  const projectedUsage = (used + bytes) / stats.heapMax;
 
   if (projectedUsage >= tracker.config.errorThreshold) {
+    const currentPercent = (used / stats.heapMax) * 100;
     throw new MemoryError(
       `Allocation of ${bytes} bytes would exceed ${(tracker.config.errorThreshold * 100).toFixed(0)}% ` +
-        `memory threshold (current: ${stats.usagePercent.toFixed(1)}%)`,
+        `memory threshold (current: ${currentPercent.toFixed(1)}%)`,
       bytes,
       stats.trackedHeapFree,
       stats,
@@ -565,6 +769,46 @@ export function estimateMeshMemory(
   return Math.ceil(rawBytes * OVERHEAD_FACTOR);
 }
 
+/** Module function pre-growing the heap (exported by every MMG module) */
+export interface HeapReserveModule extends WasmModule {
+  _mmgwasm_reserve_heap(bytes: number): number;
+  _mmgwasm_heap_max(): number;
+}
+
+/**
+ * Grow the WASM heap ahead of a large job.
+ *
+ * The heap grows by copying into a larger buffer, step by step as MMG
+ * allocates, and every growth invalidates the views of the heap. Reserving
+ * the estimated size up front grows it once; WASM memory never shrinks, so
+ * the job then allocates from the reserved space.
+ *
+ * @param module - The WASM module instance
+ * @param bytes - Bytes the job is expected to need
+ * @returns true if the heap can hold that many more bytes, false otherwise
+ *
+ * @example
+ * ```ts
+ * const bytes = estimateMeshMemory(mesh.nVertices, mesh.nCells, 0);
+ * if (!reserveMemory(module, bytes)) {
+ *   console.warn("Not enough memory for this mesh");
+ * }
+ * ```
+ */
+export function reserveMemory(
+  module: HeapReserveModule,
+  bytes: number,
+): boolean {
+  if (!(bytes > 0)) {
+    return true;
+  }
+  // Requests beyond the build's heap limit can never be satisfied
+  if (bytes >= module._mmgwasm_heap_max()) {
+    return false;
+  }
+  return module._mmgwasm_reserve_heap(Math.ceil(bytes)) === 1;
+}
+
 /**
  * Reset memory tracking for a WASM module.
  *
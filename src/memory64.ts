@@ -0,0 +1,186 @@
+/**
+ * Pointers of the memory64 (wasm64) build
+ *
+ * In the memory64 build, pointers and sizes are 64-bit integers, which
+ * WebAssembly only exchanges with JavaScript as BigInt. Mesh indices stay
+ * 32-bit (MMG5_int), so the i64 parameters and results of the exported
+ * functions are exactly their pointers and sizes: wrapPointerExports
+ * converts them at the boundary, from signatures read in the binary itself,
+ * and the bindings keep working with plain numbers in every build.
+ *
+ * Numbers hold pointers exactly up to 2^53 bytes, and heap indices are always
+ * computed as `ptr / bytes`, never with bit shifts, so they stay exact beyond
+ * 4 GB.
+ */
+
+import type { WasmModule } from "./memory";
+
+/**
+ * Signatures of the exports taking or returning i64 values, by export name:
+ * the result type then each parameter type, `p` for i64 (pointer or size),
+ * `i` for other values and `v` for no result
+ */
+export type PointerSignatures = Record<string, string>;
+
+/** Module function reporting the pointer size of the build */
+export interface PointerSizeModule extends WasmModule {
+  _mmgwasm_pointer_size(): number;
+}
+
+const SECTION_TYPE = 1;
+const SECTION_IMPORT = 2;
+const SECTION_FUNCTION = 3;
+const SECTION_EXPORT = 7;
+const KIND_FUNCTION = 0;
+const KIND_TABLE = 1;
+const KIND_MEMORY = 2;
+const KIND_GLOBAL = 3;
+const TYPE_I64 = 0x7e;
+
+/**
+ * Read the signatures of the i64 exports of a WebAssembly binary
+ *
+ * @internal Used by the loader for the memory64 build.
+ * @param binary - Contents of the .wasm file
+ * @returns The signature of every exported function with an i64 parameter
+ *   or result
+ */
+export function readPointerSignatures(binary: Uint8Array): PointerSignatures {
+  let at = 8; // magic and version
+  const byte = () => binary[at++];
+  const uleb = () => {
+    let value = 0;
+    let scale = 1;
+    let b: number;
+    do {
+      b = byte();
+      value += (b & 0x7f) * scale;
+      scale *= 128;
+    } while (b & 0x80);
+    return value;
+  };
+  const skipName = () => {
+    const length = uleb();
+    at += length;
+  };
+  const skipLimits = () => {
+    const flags = byte();
+    uleb();
+    if (flags & 1) {
+      uleb();
+    }
+  };
+
+  const types: string[] = [];
+  const functionTypes: number[] = [];
+  const exports: [string, number][] = [];
+  while (at < binary.length) {
+    const id = byte();
+    const size = uleb();
+    const end = at + size;
+    if (id === SECTION_TYPE) {
+      for (let n = uleb(); n > 0; n--) {
+        byte(); // 0x60, function type
+        let params = "";
+        for (let p = uleb(); p > 0; p--) {
+          params += byte() === TYPE_I64 ? "p" : "i";
+        }
+        let result = "v";
+        for (let r = uleb(); r > 0; r--) {
+          result = byte() === TYPE_I64 ? "p" : "i";
+        }
+        types.push(result + params);
+      }
+    } else if (id === SECTION_IMPORT) {
+      for (let n = uleb(); n > 0; n--) {
+        skipName();
+        skipName();
+        const kind = byte();
+        if (kind === KIND_FUNCTION) {
+          functionTypes.push(uleb());
+        } else if (kind === KIND_TABLE) {
+          byte();
+          skipLimits();
+        } else if (kind === KIND_MEMORY) {
+          skipLimits();
+        } else if (kind === KIND_GLOBAL) {
+          at += 2;
+        } else {
+          at++; // tag attribute, then its type
+          uleb();
+        }
+      }
+    } else if (id === SECTION_FUNCTION) {
+      for (let n = uleb(); n > 0; n--) {
+        functionTypes.push(uleb());
+      }
+    } else if (id === SECTION_EXPORT) {
+      const decoder = new TextDecoder();
+      for (let n = uleb(); n > 0; n--) {
+        const length = uleb();
+        const name = decoder.decode(binary.subarray(at, at + length));
+        at += length;
+        const kind = byte();
+        const index = uleb();
+        if (kind === KIND_FUNCTION) {
+          exports.push([name, index]);
+        }
+      }
+    }
+    at = end;
+  }
+
+  const signatures: PointerSignatures = {};
+  for (const [name, index] of exports) {
+    const signature = types[functionTypes[index]];
+    if (signature?.includes("p")) {
+      signatures[name] = signature;
+    }
+  }
+  return signatures;
+}
+
+/**
+ * Wrap the exported functions of a module instance so that they take and
+ * return plain numbers for their i64 values
+ *
+ * Emscripten exposes export `name` as `_name`. Wrapping is idempotent on
+ * values: numbers and BigInts are both accepted, e.g. by the exports
+ * Emscripten already converts itself (malloc, free).
+ *
+ * @internal Used by the loader for the memory64 build.
+ * @param instance - The Emscripten module instance
+ * @param signatures - Signatures read with readPointerSignatures
+ */
+export function wrapPointerExports(
+  instance: Record<string, unknown>,
+  signatures: PointerSignatures,
+): void {
+  for (const [name, signature] of Object.entries(signatures)) {
+    const key = `_${name}`;
+    const fn = instance[key];
+    if (typeof fn !== "function") {
+      continue;
+    }
+    const returnsPointer = signature[0] === "p";
+    const pointerArgs = [...signature.slice(1)].map((type) => type === "p");
+    instance[key] = (...args: unknown[]) => {
+      const converted = args.map((arg, i) =>
+        pointerArgs[i] && typeof arg === "number" ? BigInt(arg) : arg,
+      );
+      const result = fn(...converted);
+      return returnsPointer && typeof result === "bigint"
+        ? Number(result)
+        : result;
+    };
+  }
+}
+
+/**
+ * Pointer size of a module's build: 4 bytes (wasm32) or 8 (memory64)
+ *
+ * @param module - The WASM module
+ */
+export function pointerSize(module: PointerSizeModule): number {
+  return module._mmgwasm_pointer_size();
+}
@@ -5,22 +5,36 @@
  * with automatic type detection and consistent methods.
  */
 
-import type { EmscriptenFS } from "./fs";
+import { type RemeshCache, hashRemeshInputs } from "./cache";
+import type { MeshImportData } from "./import";
+import {
+  type MemFileModule,
+  appendStreamToMemFile,
+  appendToMemFile,
+  createMemFile,
+  freeMemFile,
+} from "./memfile";
 import {
   IPARAM_2D,
   MMG2D,
   type MeshHandle2D,
   type MeshSize2D,
-  getFS2D,
+  type QualityStats2D,
+  getWasmModule2D,
   initMMG2D,
 } from "./mmg2d";
 import { SOL_ENTITY_2D, SOL_TYPE_2D } from "./mmg2d";
 import {
   IPARAM,
   MMG3D,
+  MMG_RETURN_CODES,
   type MeshHandle,
   type MeshSize,
-  getFS,
+  type QualityStats,
+  type RemeshProgress,
+  type SurfaceClip,
+  type SurfaceGeometry,
+  getWasmModule,
   initMMG3D,
 } from "./mmg3d";
 import { SOL_ENTITY, SOL_TYPE } from "./mmg3d";
@@ -29,12 +43,23 @@ import {
   MMGS,
   type MeshHandleS,
   type MeshSizeS,
-  getFSS,
+  type QualityStatsS,
+  getWasmModuleS,
   initMMGS,
 } from "./mmgs";
 import { SOL_ENTITY_S, SOL_TYPE_S } from "./mmgs";
-import { type RemeshOptions, applyOptions } from "./options";
-import type { RemeshResult } from "./result";
+import {
+  type RemeshOptions,
+  applyOptions,
+  optionParameters,
+} from "./options";
+import type { PackOptions } from "./packed";
+import type {
+  BatchRemeshResult,
+  RemeshResult,
+  RemeshStats,
+  RemeshTimings,
+} from "./result";
 import {
   BoxSizingConstraint,
   CircleSizingConstraint,
@@ -43,8 +68,9 @@ import {
   SphereSizingConstraint,
   type Vec2,
   type Vec3,
-  combineSizingConstraints,
+  encodeSizingConstraints,
 } from "./sizing";
+import { measurePhases, measureStep } from "./stats";
 
 /**
  * Mesh types supported by the library
@@ -74,6 +100,13 @@ export interface MeshData {
   vertexRefs?: Int32Array;
   /** Cell references (material IDs) */
   cellRefs?: Int32Array;
+  /** Boundary face/edge references */
+  boundaryRefs?: Int32Array;
+  /**
+   * Metric at the vertices: one target size per vertex, or one tensor per
+   * vertex (6 components in 3D and on surfaces, 3 in 2D)
+   */
+  metric?: Float64Array;
 }
 
 /**
@@ -86,6 +119,30 @@ export interface LoadOptions {
   format?: "mesh" | "meshb";
 }
 
+/**
+ * Progress reporting, cancellation and caching for Mesh.remesh()
+ */
+export interface RemeshControl {
+  /** Called whenever the progress estimate of the remesh changes */
+  onProgress?: (progress: RemeshProgress) => void;
+  /** Aborts the remesh at its next phase or wavefront boundary */
+  signal?: AbortSignal;
+  /**
+   * Emit every step of the remesh as a performance.measure span named
+   * `${trace}:${step}` (and the MMG phases as `${trace}:mmg:${phase}` with
+   * the instrumentation build), so traces show where the time goes
+   */
+  trace?: string;
+  /**
+   * Cache consulted before remeshing and filled after a successful remesh,
+   * keyed by contentHash
+   */
+  cache?: RemeshCache;
+}
+
+// Bytes inspected to detect the mesh type of a file
+const TYPE_DETECTION_BYTES = 1000;
+
 // Track module initialization with promises to prevent race conditions
 let mmg2dInitPromise: Promise<void> | null = null;
 let mmg3dInitPromise: Promise<void> | null = null;
@@ -117,6 +174,47 @@ async function ensureModuleInitialized(type: MeshType): Promise<void> {
   }
 }
 
+/**
+ * Restore a remesh from a cache, undefined on a miss
+ *
+ * @internal Used by Mesh.remesh and MeshWorkerPool.remesh.
+ * @param cache - Cache to read
+ * @param key - Content hash of the remesh (see Mesh.contentHash)
+ * @param type - Mesh type of the remesh
+ * @param startTime - performance.now() when the remesh was requested
+ * @returns The result, with a new mesh owned by the caller
+ */
+export async function loadCachedRemesh(
+  cache: RemeshCache,
+  key: string,
+  type: MeshType,
+  startTime: number,
+): Promise<RemeshResult | undefined> {
+  const cached = await cache.lookup(key);
+  if (!cached) {
+    return undefined;
+  }
+  let mesh: Mesh;
+  try {
+    mesh = await Mesh.load(cached.mesh, { type, format: "meshb" });
+  } catch {
+    return undefined; // A damaged entry is a miss
+  }
+  try {
+    mesh.loadMetricBuffer(cached.metric);
+  } catch {
+    mesh.free();
+    return undefined;
+  }
+  return {
+    ...cached.statistics,
+    mesh,
+    elapsed: performance.now() - startTime,
+    timings: { clone: 0, sizing: 0, quality: 0, remesh: 0 },
+    cached: true,
+  };
+}
+
 /**
  * Unified mesh class that wraps MMG2D, MMG3D, and MMGS
  *
@@ -156,7 +254,12 @@ export class Mesh {
   constructor(data: MeshData) {
     this._type = data.type ?? this.detectType(data);
     this._handle = this.createHandle();
-    this.setData(data);
+    try {
+      this.setData(data);
+    } catch (error) {
+      this.free();
+      throw error;
+    }
   }
 
   /**
@@ -172,61 +275,68 @@ export class Mesh {
   }
 
   /**
-   * Load a mesh from an ArrayBuffer or file path
+   * Load a mesh from an ArrayBuffer, a byte stream or a URL
    *
-   * @param source - ArrayBuffer or file path (for browser: ArrayBuffer, for Node: path)
+   * The file contents are parsed straight from WASM memory, without a copy in
+   * the virtual filesystem. Streams (including fetched URLs) are copied into
+   * WASM memory chunk by chunk, so large files are never held in full on the
+   * JS side.
+   *
+   * @param source - File contents, a byte stream, or a URL to fetch
    * @param options - Load options including type and format
    * @returns Promise resolving to the loaded Mesh
    */
   static async load(
-    source: ArrayBuffer | Uint8Array | string,
+    source: ArrayBuffer | Uint8Array | ReadableStream<Uint8Array> | string,
     options: LoadOptions = {},
   ): Promise<Mesh> {
-    const format = options.format ?? "mesh";
-
-    // If source is a string (path/URL), fetch it
-    let buffer: Uint8Array;
+    // If source is a string (path/URL), fetch it and stream the body
     if (typeof source === "string") {
       const response = await fetch(source);
       if (!response.ok) {
         throw new Error(`Failed to fetch mesh: ${response.statusText}`);
       }
-      buffer = new Uint8Array(await response.arrayBuffer());
-    } else if (source instanceof ArrayBuffer) {
-      buffer = new Uint8Array(source);
-    } else {
-      buffer = source;
+      if (!response.body) {
+        return Mesh.load(await response.arrayBuffer(), options);
+      }
+      const contentLength = Number(response.headers.get("Content-Length"));
+      return Mesh.loadStream(
+        response.body,
+        options,
+        Number.isFinite(contentLength) ? contentLength : 0,
+      );
+    }
+    if (!(source instanceof ArrayBuffer || source instanceof Uint8Array)) {
+      return Mesh.loadStream(source, options, 0);
     }
 
+    const format = options.format ?? "mesh";
+    const buffer =
+      source instanceof ArrayBuffer ? new Uint8Array(source) : source;
+
     // Try to detect type from file content or use provided type
     const type = options.type ?? (await Mesh.detectTypeFromBuffer(buffer));
     await ensureModuleInitialized(type);
 
-    // Write buffer to virtual filesystem and load
-    const FS = Mesh.getFS(type);
-    const filename = `/input.${format}`;
-
+    const mesh = new Mesh({
+      vertices: new Float64Array(0),
+      cells: new Int32Array(0),
+      type,
+    });
     try {
-      FS.writeFile(filename, buffer);
-
-      const mesh = new Mesh({
-        vertices: new Float64Array(0),
-        cells: new Int32Array(0),
-        type,
-      });
-
-      // Load from file into the handle
-      mesh.loadFromFile(filename);
-
-      return mesh;
-    } finally {
-      // Clean up temporary file
+      const module = Mesh.getWasmModuleFor(type);
+      const file = createMemFile(module, buffer.length);
       try {
-        FS.unlink(filename);
-      } catch {
-        // Ignore cleanup errors
+        appendToMemFile(module, file, buffer);
+        mesh.loadFromMemFile(file, format);
+      } finally {
+        freeMemFile(module, file);
       }
+    } catch (error) {
+      mesh.free();
+      throw error;
     }
+    return mesh;
   }
 
   /**
@@ -240,6 +350,81 @@ export class Mesh {
     return Mesh.load(url, options);
   }
 
+  /**
+   * Load a mesh from a byte stream
+   *
+   * The first chunks are inspected to detect the mesh type, then every chunk
+   * is appended to a memfile in WASM memory as it arrives.
+   */
+  private static async loadStream(
+    stream: ReadableStream<Uint8Array>,
+    options: LoadOptions,
+    sizeHint: number,
+  ): Promise<Mesh> {
+    const format = options.format ?? "mesh";
+    const reader = stream.getReader();
+
+    // Read enough of the stream to detect the mesh type
+    const head: Uint8Array[] = [];
+    let headLength = 0;
+    let ended = false;
+    try {
+      while (headLength < TYPE_DETECTION_BYTES) {
+        const { done, value } = await reader.read();
+        if (done) {
+          ended = true;
+          break;
+        }
+        head.push(value);
+        headLength += value.length;
+      }
+    } catch (error) {
+      reader.releaseLock();
+      throw error;
+    }
+
+    let type = options.type;
+    if (!type) {
+      const prefix = new Uint8Array(Math.min(headLength, TYPE_DETECTION_BYTES));
+      let offset = 0;
+      for (const chunk of head) {
+        if (offset >= prefix.length) break;
+        const part = chunk.subarray(0, prefix.length - offset);
+        prefix.set(part, offset);
+        offset += part.length;
+      }
+      type = await Mesh.detectTypeFromBuffer(prefix);
+    }
+    await ensureModuleInitialized(type);
+
+    const mesh = new Mesh({
+      vertices: new Float64Array(0),
+      cells: new Int32Array(0),
+      type,
+    });
+    const module = Mesh.getWasmModuleFor(type);
+    let file = 0;
+    try {
+      file = createMemFile(module, Math.max(sizeHint, headLength));
+      for (const chunk of head) {
+        appendToMemFile(module, file, chunk);
+      }
+      head.length = 0;
+      if (ended) {
+        reader.releaseLock();
+      } else {
+        await appendStreamToMemFile(module, file, reader);
+      }
+      mesh.loadFromMemFile(file, format);
+    } catch (error) {
+      mesh.free();
+      throw error;
+    } finally {
+      freeMemFile(module, file);
+    }
+    return mesh;
+  }
+
   // =====================
   // Properties
   // =====================
@@ -325,6 +510,146 @@ export class Mesh {
     }
   }
 
+  /**
+   * Modification generation of the underlying mesh.
+   * Changes whenever the mesh data is modified, invalidating the *View arrays.
+   */
+  get generation(): number {
+    this.checkDisposed();
+    switch (this._type) {
+      case MeshType.Mesh2D:
+        return MMG2D.getGeneration(this._handle as MeshHandle2D);
+      case MeshType.Mesh3D:
+        return MMG3D.getGeneration(this._handle as MeshHandle);
+      case MeshType.MeshS:
+        return MMGS.getGeneration(this._handle as MeshHandleS);
+      default:
+        throw new Error(`Unknown mesh type: ${this._type}`);
+    }
+  }
+
+  /**
+   * Zero-copy view of the vertex coordinates inside WASM memory.
+   * Valid until the mesh changes (see `generation`), the mesh is freed or the
+   * heap grows (see `isHeapViewValid`). Use `vertices` for a stable copy.
+   */
+  get verticesView(): Float64Array {
+    this.checkDisposed();
+    switch (this._type) {
+      case MeshType.Mesh2D:
+        return MMG2D.getVerticesView(this._handle as MeshHandle2D);
+      case MeshType.Mesh3D:
+        return MMG3D.getVerticesView(this._handle as MeshHandle);
+      case MeshType.MeshS:
+        return MMGS.getVerticesView(this._handle as MeshHandleS);
+      default:
+        throw new Error(`Unknown mesh type: ${this._type}`);
+    }
+  }
+
+  /** Zero-copy view of the cell indices (1-indexed), see `verticesView` */
+  get cellsView(): Int32Array {
+    this.checkDisposed();
+    switch (this._type) {
+      case MeshType.Mesh2D:
+        return MMG2D.getTrianglesView(this._handle as MeshHandle2D);
+      case MeshType.Mesh3D:
+        return MMG3D.getTetrahedraView(this._handle as MeshHandle);
+      case MeshType.MeshS:
+        return MMGS.getTrianglesView(this._handle as MeshHandleS);
+      default:
+        throw new Error(`Unknown mesh type: ${this._type}`);
+    }
+  }
+
+  /** Zero-copy view of the boundary faces/edges (1-indexed), see `verticesView` */
+  get boundaryFacesView(): Int32Array {
+    this.checkDisposed();
+    switch (this._type) {
+      case MeshType.Mesh2D:
+        return MMG2D.getEdgesView(this._handle as MeshHandle2D);
+      case MeshType.Mesh3D:
+        return MMG3D.getTrianglesView(this._handle as MeshHandle);
+      case MeshType.MeshS:
+        return MMGS.getEdgesView(this._handle as MeshHandleS);
+      default:
+        throw new Error(`Unknown mesh type: ${this._type}`);
+    }
+  }
+
+  /**
+   * Compute element quality statistics (min, max, mean and histogram).
+   *
+   * Qualities range from 0 (degenerate) to 1 (best) and are reduced in a
+   * single pass inside WASM, so no per-element array is copied to JS.
+   *
+   * @param nbins - Number of uniform histogram bins over [0, 1] (default 10)
+   */
+  getQualityStats(nbins = 10): QualityStats | QualityStats2D | QualityStatsS {
+    this.checkDisposed();
+    return this.getQualityStatsFor(this._handle, nbins);
+  }
+
+  /**
+   * Interpolate vertex fields of another mesh onto the vertices of this one
+   *
+   * Typically used after `remesh()` to carry simulation fields from the
+   * original mesh over to `result.mesh`. Elements of the source are located
+   * natively, and vertices outside it take the values of its closest point.
+   *
+   * @param source - Mesh of the same type the fields are defined on
+   * @param fields - `stride` values per source vertex, interleaved
+   * @param stride - Number of values per vertex (default: 1)
+   * @returns `stride` values per vertex of this mesh
+   * @throws Error if the meshes differ in type or the field size is wrong
+   *
+   * @example
+   * ```typescript
+   * const result = await mesh.remesh({ hmax: 0.1 });
+   * const velocity = result.mesh.interpolateFrom(mesh, oldVelocity, 3);
+   * ```
+   */
+  interpolateFrom(
+    source: Mesh,
+    fields: Float64Array,
+    stride = 1,
+  ): Float64Array {
+    this.checkDisposed();
+    source.checkDisposed();
+    if (source._type !== this._type) {
+      throw new Error(
+        `Cannot interpolate fields from a ${source._type} mesh onto a ` +
+          `${this._type} mesh`,
+      );
+    }
+
+    switch (this._type) {
+      case MeshType.Mesh2D:
+        return MMG2D.interpolateFields(
+          this._handle as MeshHandle2D,
+          source._handle as MeshHandle2D,
+          fields,
+          stride,
+        );
+      case MeshType.Mesh3D:
+        return MMG3D.interpolateFields(
+          this._handle as MeshHandle,
+          source._handle as MeshHandle,
+          fields,
+          stride,
+        );
+      case MeshType.MeshS:
+        return MMGS.interpolateFields(
+          this._handle as MeshHandleS,
+          source._handle as MeshHandleS,
+          fields,
+          stride,
+        );
+      default:
+        throw new Error(`Unknown mesh type: ${this._type}`);
+    }
+  }
+
   // =====================
   // Local Sizing Methods
   // =====================
@@ -630,6 +955,57 @@ export class Mesh {
     return this;
   }
 
+  /**
+   * Metric at the vertices, as set by setMetric or setMetricTensor or left
+   * by the last remesh: one target size per vertex, or one tensor per vertex
+   *
+   * @returns A copy of the metric, or undefined if the mesh has no scalar or
+   *   tensor metric
+   */
+  get metric(): Float64Array | undefined {
+    this.checkDisposed();
+    switch (this._type) {
+      case MeshType.Mesh2D: {
+        const handle = this._handle as MeshHandle2D;
+        const { nEntities, typSol } = MMG2D.getSolSize(handle);
+        if (nEntities === 0) {
+          return undefined;
+        }
+        return typSol === SOL_TYPE_2D.SCALAR
+          ? MMG2D.getScalarSols(handle)
+          : typSol === SOL_TYPE_2D.TENSOR
+            ? MMG2D.getTensorSols(handle)
+            : undefined;
+      }
+      case MeshType.Mesh3D: {
+        const handle = this._handle as MeshHandle;
+        const { nEntities, typSol } = MMG3D.getSolSize(handle);
+        if (nEntities === 0) {
+          return undefined;
+        }
+        return typSol === SOL_TYPE.SCALAR
+          ? MMG3D.getScalarSols(handle)
+          : typSol === SOL_TYPE.TENSOR
+            ? MMG3D.getTensorSols(handle)
+            : undefined;
+      }
+      case MeshType.MeshS: {
+        const handle = this._handle as MeshHandleS;
+        const { nEntities, typSol } = MMGS.getSolSize(handle);
+        if (nEntities === 0) {
+          return undefined;
+        }
+        return typSol === SOL_TYPE_S.SCALAR
+          ? MMGS.getScalarSols(handle)
+          : typSol === SOL_TYPE_S.TENSOR
+            ? MMGS.getTensorSols(handle)
+            : undefined;
+      }
+      default:
+        throw new Error(`Unknown mesh type: ${this._type}`);
+    }
+  }
+
   // =====================
   // Export Methods
   // =====================
@@ -643,33 +1019,284 @@ export class Mesh {
   toArrayBuffer(format: "mesh" | "meshb" = "mesh"): Uint8Array {
     this.checkDisposed();
 
-    const FS = Mesh.getFS(this._type);
-    const filename = `/output.${format}`;
+    // Serialized straight into the WASM heap, no virtual filesystem file
+    switch (this._type) {
+      case MeshType.Mesh2D:
+        return MMG2D.saveMeshToBuffer(this._handle as MeshHandle2D, format);
+      case MeshType.Mesh3D:
+        return MMG3D.saveMeshToBuffer(this._handle as MeshHandle, format);
+      case MeshType.MeshS:
+        return MMGS.saveMeshToBuffer(this._handle as MeshHandleS, format);
+      default:
+        throw new Error(`Unknown mesh type: ${this._type}`);
+    }
+  }
+
+  /**
+   * Export the metric of the mesh as a .solb file
+   *
+   * @internal Used by Mesh.contentHash and RemeshCache.save.
+   * @returns The .solb contents, empty for a mesh without a metric
+   */
+  metricBuffer(): Uint8Array {
+    this.checkDisposed();
+    switch (this._type) {
+      case MeshType.Mesh2D: {
+        const handle = this._handle as MeshHandle2D;
+        return MMG2D.getSolSize(handle).nEntities > 0
+          ? MMG2D.saveSolToBuffer(handle, "solb")
+          : new Uint8Array(0);
+      }
+      case MeshType.Mesh3D: {
+        const handle = this._handle as MeshHandle;
+        return MMG3D.getSolSize(handle).nEntities > 0
+          ? MMG3D.saveSolToBuffer(handle, "solb")
+          : new Uint8Array(0);
+      }
+      case MeshType.MeshS: {
+        const handle = this._handle as MeshHandleS;
+        return MMGS.getSolSize(handle).nEntities > 0
+          ? MMGS.saveSolToBuffer(handle, "solb")
+          : new Uint8Array(0);
+      }
+      default:
+        throw new Error(`Unknown mesh type: ${this._type}`);
+    }
+  }
 
-    // Save to virtual filesystem
+  /**
+   * Load a metric exported with metricBuffer, replacing the current one
+   *
+   * @internal Used to restore cached remeshes.
+   * @param data - The .solb contents; an empty buffer leaves the mesh as is
+   */
+  loadMetricBuffer(data: Uint8Array): void {
+    this.checkDisposed();
+    if (data.byteLength === 0) {
+      return;
+    }
     switch (this._type) {
       case MeshType.Mesh2D:
-        MMG2D.saveMesh(this._handle as MeshHandle2D, filename);
+        MMG2D.loadSolFromBuffer(this._handle as MeshHandle2D, data, "solb");
         break;
       case MeshType.Mesh3D:
-        MMG3D.saveMesh(this._handle as MeshHandle, filename);
+        MMG3D.loadSolFromBuffer(this._handle as MeshHandle, data, "solb");
         break;
       case MeshType.MeshS:
-        MMGS.saveMesh(this._handle as MeshHandleS, filename);
+        MMGS.loadSolFromBuffer(this._handle as MeshHandleS, data, "solb");
         break;
+      default:
+        throw new Error(`Unknown mesh type: ${this._type}`);
     }
+  }
 
-    // Read file and return as ArrayBuffer
-    const data = FS.readFile(filename, { encoding: "binary" });
+  /**
+   * Export mesh to the compact wire format for display (see decodePackedMesh)
+   *
+   * Smaller than the separate vertex and element arrays, and a single
+   * buffer, so it is cheap to transfer from a worker.
+   *
+   * @param options - Quantization and boundary-only packing
+   * @returns Packed mesh
+   */
+  toPackedBuffer(options: PackOptions = {}): Uint8Array {
+    this.checkDisposed();
 
-    // Clean up
+    switch (this._type) {
+      case MeshType.Mesh2D:
+        return MMG2D.packMesh(this._handle as MeshHandle2D, options);
+      case MeshType.Mesh3D:
+        return MMG3D.packMesh(this._handle as MeshHandle, options);
+      case MeshType.MeshS:
+        return MMGS.packMesh(this._handle as MeshHandleS, options);
+      default:
+        throw new Error(`Unknown mesh type: ${this._type}`);
+    }
+  }
+
+  /**
+   * Extract the display surface of a 3D mesh natively
+   *
+   * Returns the boundary faces of the tetrahedra, or with a clipping plane
+   * those of the tetrahedra on its negative side, with compacted float32
+   * positions, vertex normals and 0-based indices ready for GPU buffers.
+   *
+   * @param clip - Optional clipping plane
+   * @returns Surface buffers (see SurfaceGeometry)
+   * @throws Error if used with a 2D or surface mesh
+   *
+   * @example
+   * ```typescript
+   * // Cut-away view of the half x <= 0.5
+   * const surface = mesh.extractSurface({ normal: [1, 0, 0], offset: 0.5 });
+   * ```
+   */
+  extractSurface(clip?: SurfaceClip): SurfaceGeometry {
+    this.checkDisposed();
+
+    if (this._type !== MeshType.Mesh3D) {
+      throw new Error(
+        "extractSurface is only available for 3D meshes. Use cells for 2D and surface meshes.",
+      );
+    }
+    return MMG3D.extractSurface(this._handle as MeshHandle, clip);
+  }
+
+  /**
+   * Split a 3D mesh into parts that can be remeshed independently
+   *
+   * Parts are compact and balanced in element count (recursive coordinate
+   * bisection). The faces a part shares with the others become required
+   * triangles with reference SUBDOMAIN_INTERFACE_REF, so remeshing the part
+   * keeps them as they are and the parts still fit together afterwards (see
+   * Mesh.mergeSubdomains). Later passes cut along other axes, to remesh the
+   * interfaces of the previous ones.
+   *
+   * Every part keeps the metric of its vertices. Local sizing regions are
+   * evaluated over the whole mesh first, as a remesh would, so the parts
+   * carry them as their metric.
+   *
+   * @param parts - Number of parts (at most one per cell)
+   * @param pass - Remeshing pass the parts are for (default: 0)
+   * @returns The parts, to free once done
+   * @throws Error if used with a 2D or surface mesh, or if the mesh has
+   *   required entities
+   */
+  splitSubdomains(parts: number, pass = 0): Mesh[] {
+    this.checkDisposed();
+
+    if (this._type !== MeshType.Mesh3D) {
+      throw new Error("splitSubdomains is only available for 3D meshes");
+    }
+    if (!Number.isInteger(parts) || parts < 1) {
+      throw new Error("Number of parts must be a positive integer");
+    }
+    if (!Number.isInteger(pass) || pass < 0) {
+      throw new Error("Pass must be a non-negative integer");
+    }
+
+    // The default size outside the regions depends on the whole mesh
+    const sized = this._sizingConstraints.length > 0;
+    const handle = sized
+      ? (this.cloneHandle() as MeshHandle)
+      : (this._handle as MeshHandle);
+    const count = Math.max(1, Math.min(parts, this.nCells));
+    const subdomains: Mesh[] = [];
     try {
-      FS.unlink(filename);
-    } catch {
-      // Ignore cleanup errors
+      if (sized) {
+        this.applySizingConstraints(handle);
+      }
+      const assignment = MMG3D.partition(handle, count, pass);
+      for (let part = 0; part < count; part++) {
+        subdomains.push(
+          this.extractMeshFromHandle(
+            MMG3D.extractSubdomain(handle, assignment, part),
+          ),
+        );
+      }
+    } catch (error) {
+      for (const subdomain of subdomains) {
+        subdomain.free();
+      }
+      throw error;
+    } finally {
+      if (sized) {
+        this.freeHandle(handle);
+      }
+    }
+    return subdomains;
+  }
+
+  /**
+   * Weld parts split by splitSubdomains back into one mesh, once remeshed
+   *
+   * Interface vertices are matched by position up to rounding, the
+   * interface triangles are dropped and the parts are left unchanged. The
+   * welded mesh keeps the metric of the parts when they all have one of the
+   * same kind.
+   *
+   * @param subdomains - Parts of one mesh, remeshed or not
+   * @returns The welded mesh
+   * @throws Error if a part is not a 3D mesh or merging fails
+   */
+  static mergeSubdomains(subdomains: Mesh[]): Mesh {
+    if (subdomains.length === 0) {
+      throw new Error("No subdomains to merge");
+    }
+    for (const subdomain of subdomains) {
+      subdomain.checkDisposed();
+      if (subdomain._type !== MeshType.Mesh3D) {
+        throw new Error("mergeSubdomains is only available for 3D meshes");
+      }
     }
 
-    return data;
+    const handle = MMG3D.mergeSubdomains(
+      subdomains.map((subdomain) => subdomain._handle as MeshHandle),
+    );
+    return subdomains[0].extractMeshFromHandle(handle);
+  }
+
+  /**
+   * Remesh many small meshes of one type with the same options
+   *
+   * Every mesh is remeshed in a single WASM call, so a batch of small meshes
+   * costs MMG itself rather than a Mesh, a clone and a copy each. The inputs
+   * are left untouched and the results are plain arrays: pass one to
+   * new Mesh() to work on it further. Verbosity defaults to -1.
+   *
+   * @param meshes - Meshes of one type, with optional references and metric
+   * @param options - Remeshing options of every mesh (no local remeshing)
+   * @returns One result per mesh, in order; a mesh that failed has
+   *   success false and an empty mesh
+   * @throws Error if the meshes have different types, an option is invalid
+   *   or the batch cannot be staged
+   */
+  static async remeshBatch(
+    meshes: MeshData[],
+    options: RemeshOptions = {},
+  ): Promise<BatchRemeshResult[]> {
+    if (meshes.length === 0) {
+      return [];
+    }
+    if (options.local) {
+      throw new Error("Batch remeshing does not support local remeshing");
+    }
+    const type = meshes[0].type ?? Mesh.detectTypeStatic(meshes[0]);
+    for (const data of meshes) {
+      if ((data.type ?? Mesh.detectTypeStatic(data)) !== type) {
+        throw new Error("Batch remeshing needs meshes of a single type");
+      }
+    }
+    await ensureModuleInitialized(type);
+
+    const arrays: MeshImportData[] = meshes.map((data) => ({
+      vertices: data.vertices,
+      vertexRefs: data.vertexRefs,
+      cells: data.cells,
+      cellRefs: data.cellRefs,
+      boundary: data.boundaryFaces,
+      boundaryRefs: data.boundaryRefs,
+      metric: data.metric,
+    }));
+    const parameters = optionParameters(type, { verbose: -1, ...options });
+    let results: BatchRemeshResult[];
+    switch (type) {
+      case MeshType.Mesh2D:
+        results = MMG2D.remeshBatch(arrays, parameters);
+        break;
+      case MeshType.Mesh3D:
+        results = MMG3D.remeshBatch(arrays, parameters);
+        break;
+      case MeshType.MeshS:
+        results = MMGS.remeshBatch(arrays, parameters);
+        break;
+      default:
+        throw new Error(`Unknown mesh type: ${type}`);
+    }
+    for (const result of results) {
+      result.mesh.type = type;
+    }
+    return results;
   }
 
   /**
@@ -705,8 +1332,12 @@ export class Mesh {
    * instance is returned in the result.
    *
    * @param options - Remeshing options (hmax, hmin, hausd, etc.)
+   * @param control - Optional progress callback, abort signal, trace and
+   *   cache. Progress and mid-remesh cancellation need the pthreads build;
+   *   other builds block until the remesh returns. A cache hit returns a
+   *   stored result without remeshing
    * @returns Promise resolving to RemeshResult with new mesh and statistics
-   * @throws Error if remeshing fails
+   * @throws Error if remeshing fails or is aborted
    *
    * @example
    * ```typescript
@@ -726,40 +1357,129 @@ export class Mesh {
    * console.log(`Original vertices: ${mesh.nVertices}`);
    * ```
    */
-  async remesh(options: RemeshOptions = {}): Promise<RemeshResult> {
+  async remesh(
+    options: RemeshOptions = {},
+    control: RemeshControl = {},
+  ): Promise<RemeshResult> {
     this.checkDisposed();
+    if (options.local && this._sizingConstraints.length === 0) {
+      throw new Error("Local remeshing needs at least one sizing region");
+    }
+    if (!control.cache) {
+      return this.runRemeshSteps(options, control);
+    }
 
     const startTime = performance.now();
+    const key = await this.contentHash(options);
+    const hit = await loadCachedRemesh(
+      control.cache,
+      key,
+      this._type,
+      startTime,
+    );
+    if (hit) {
+      return hit;
+    }
+    const result = await this.runRemeshSteps(options, control);
+    await control.cache.save(key, result);
+    return result;
+  }
+
+  /**
+   * Hash of everything a remesh of this mesh depends on: its entities
+   * (as a .meshb export), metric, local sizing constraints and the options
+   *
+   * Two meshes with the same hash and options remesh to the same result, so
+   * the hash keys a RemeshCache. Verbosity is not part of it.
+   *
+   * @param options - Remeshing options
+   * @returns Hex SHA-256 digest
+   */
+  async contentHash(options: RemeshOptions = {}): Promise<string> {
+    this.checkDisposed();
+    const dimension = this._type === MeshType.Mesh2D ? 2 : 3;
+    const sizing = encodeSizingConstraints(this._sizingConstraints, dimension);
+    return hashRemeshInputs(this._type, options, [
+      this.toArrayBuffer("meshb"),
+      this.metricBuffer(),
+      new Uint8Array(sizing.buffer, sizing.byteOffset, sizing.byteLength),
+    ]);
+  }
+
+  /**
+   * Clone, size, remesh and extract: the remesh itself, without the cache
+   */
+  private async runRemeshSteps(
+    options: RemeshOptions,
+    control: RemeshControl,
+  ): Promise<RemeshResult> {
+    const startTime = performance.now();
+    const timings: RemeshTimings = {
+      clone: 0,
+      sizing: 0,
+      quality: 0,
+      remesh: 0,
+    };
+    let mark = startTime;
+    const lap = (step: keyof RemeshTimings) => {
+      const now = performance.now();
+      timings[step] += now - mark;
+      if (control.trace) {
+        measureStep(control.trace, step, mark, now);
+      }
+      mark = now;
+    };
 
     // Store original counts for statistics
     const originalVertexCount = this.nVertices;
 
     // Clone mesh to a new handle for immutable pattern
     const workingHandle = this.cloneHandle();
+    lap("clone");
 
     try {
       // Apply local sizing constraints if any
       if (this._sizingConstraints.length > 0) {
         this.applySizingConstraints(workingHandle);
+        if (options.local) {
+          this.freezeOutsideRegions(workingHandle, options.localMargin ?? 0);
+        }
+        lap("sizing");
       }
 
       // Capture quality before remeshing
       const qualityBefore = this.getMinQuality(workingHandle);
+      lap("quality");
 
       // Apply options to the working handle
       applyOptions(workingHandle, this._type, options);
 
-      // Run remeshing
-      const returnCode = this.runRemesh(workingHandle);
+      // Run remeshing (on a pool thread with the pthreads build, so several
+      // meshes can be remeshed concurrently in one module)
+      const returnCode = await this.runRemesh(workingHandle, control);
+      lap("remesh");
+      const stats = this.getStatsFor(workingHandle);
+      if (stats && control.trace) {
+        measurePhases(control.trace, stats, mark);
+      }
 
       // Check return code
       const success = returnCode === 0 || returnCode === 1;
+      if (returnCode === MMG_RETURN_CODES.ABORTED) {
+        throw new Error("Remeshing aborted");
+      }
       if (returnCode === 2) {
         throw new Error("Remeshing failed with strong failure (code 2)");
       }
 
+      // Let the result remesh freely again after a local remesh
+      if (options.local) {
+        this.thawHandle(workingHandle);
+      }
+
       // Capture quality after remeshing
       const qualityAfter = this.getMinQuality(workingHandle);
+      lap("quality");
 
       // Create result mesh from the working handle
       const resultMesh = this.extractMeshFromHandle(workingHandle);
@@ -778,6 +1498,7 @@ export class Mesh {
         nCells: resultMesh.nCells,
         nBoundaryFaces: resultMesh.nBoundaryFaces,
         elapsed,
+        timings,
         qualityBefore,
         qualityAfter,
         qualityImprovement:
@@ -786,13 +1507,15 @@ export class Mesh {
             : Number.POSITIVE_INFINITY,
         nInserted,
         nDeleted,
-        nSwapped: 0, // MMG doesn't expose this
-        nMoved: 0, // MMG doesn't expose this
+        // MMG only reports these to the instrumentation build
+        nSwapped: stats?.swaps ?? 0,
+        nMoved: stats?.moves ?? 0,
         success,
         warnings:
           returnCode === 1
             ? ["Remeshing completed with warnings (low failure)"]
             : [],
+        stats,
       };
     } catch (error) {
       // Free the working handle on error
@@ -803,151 +1526,118 @@ export class Mesh {
 
   /**
    * Clone the current mesh to a new handle
+   *
+   * The copy (including refs, tags and any metric field) is made natively
+   * inside WASM memory, so no mesh data crosses the JS boundary.
    */
   private cloneHandle(): MeshHandle | MeshHandle2D | MeshHandleS {
-    const newHandle = this.createHandle();
-
-    // Copy mesh data to new handle
     switch (this._type) {
-      case MeshType.Mesh2D: {
-        const size = MMG2D.getMeshSize(this._handle as MeshHandle2D);
-        MMG2D.setMeshSize(
-          newHandle as MeshHandle2D,
-          size.nVertices,
-          size.nTriangles,
-          size.nQuads,
-          size.nEdges,
-        );
-        MMG2D.setVertices(
-          newHandle as MeshHandle2D,
-          MMG2D.getVertices(this._handle as MeshHandle2D),
-        );
-        if (size.nTriangles > 0) {
-          MMG2D.setTriangles(
-            newHandle as MeshHandle2D,
-            MMG2D.getTriangles(this._handle as MeshHandle2D),
-          );
-        }
-        if (size.nEdges > 0) {
-          MMG2D.setEdges(
-            newHandle as MeshHandle2D,
-            MMG2D.getEdges(this._handle as MeshHandle2D),
-          );
-        }
-        break;
-      }
-      case MeshType.Mesh3D: {
-        const size = MMG3D.getMeshSize(this._handle as MeshHandle);
-        MMG3D.setMeshSize(
-          newHandle as MeshHandle,
-          size.nVertices,
-          size.nTetrahedra,
-          size.nPrisms,
-          size.nTriangles,
-          size.nQuads,
-          size.nEdges,
-        );
-        MMG3D.setVertices(
-          newHandle as MeshHandle,
-          MMG3D.getVertices(this._handle as MeshHandle),
-        );
-        if (size.nTetrahedra > 0) {
-          MMG3D.setTetrahedra(
-            newHandle as MeshHandle,
-            MMG3D.getTetrahedra(this._handle as MeshHandle),
-          );
-        }
-        if (size.nTriangles > 0) {
-          MMG3D.setTriangles(
-            newHandle as MeshHandle,
-            MMG3D.getTriangles(this._handle as MeshHandle),
-          );
-        }
-        break;
-      }
-      case MeshType.MeshS: {
-        const size = MMGS.getMeshSize(this._handle as MeshHandleS);
-        MMGS.setMeshSize(
-          newHandle as MeshHandleS,
-          size.nVertices,
-          size.nTriangles,
-          size.nEdges,
-        );
-        MMGS.setVertices(
-          newHandle as MeshHandleS,
-          MMGS.getVertices(this._handle as MeshHandleS),
-        );
-        if (size.nTriangles > 0) {
-          MMGS.setTriangles(
-            newHandle as MeshHandleS,
-            MMGS.getTriangles(this._handle as MeshHandleS),
-          );
-        }
-        if (size.nEdges > 0) {
-          MMGS.setEdges(
-            newHandle as MeshHandleS,
-            MMGS.getEdges(this._handle as MeshHandleS),
-          );
-        }
-        break;
-      }
+      case MeshType.Mesh2D:
+        return MMG2D.clone(this._handle as MeshHandle2D);
+      case MeshType.Mesh3D:
+        return MMG3D.clone(this._handle as MeshHandle);
+      case MeshType.MeshS:
+        return MMGS.clone(this._handle as MeshHandleS);
+      default:
+        throw new Error(`Unknown mesh type: ${this._type}`);
     }
-
-    return newHandle;
   }
 
   /**
-   * Get minimum element quality from a handle
+   * Get the statistics of the last remesh of a handle (instrumentation
+   * build only)
    */
-  private getMinQuality(
+  private getStatsFor(
     handle: MeshHandle | MeshHandle2D | MeshHandleS,
-  ): number {
-    let qualities: Float64Array;
-
+  ): RemeshStats | undefined {
     switch (this._type) {
       case MeshType.Mesh2D:
-        qualities = MMG2D.getTrianglesQualities(handle as MeshHandle2D);
-        break;
+        return MMG2D.getStats(handle as MeshHandle2D);
       case MeshType.Mesh3D:
-        qualities = MMG3D.getTetrahedraQualities(handle as MeshHandle);
-        break;
+        return MMG3D.getStats(handle as MeshHandle);
       case MeshType.MeshS:
-        qualities = MMGS.getTrianglesQualities(handle as MeshHandleS);
-        break;
+        return MMGS.getStats(handle as MeshHandleS);
       default:
         throw new Error(`Unknown mesh type: ${this._type}`);
     }
+  }
 
-    if (qualities.length === 0) {
-      return 0;
-    }
-
-    let min = Number.POSITIVE_INFINITY;
-    for (let i = 0; i < qualities.length; i++) {
-      if (qualities[i] < min) {
-        min = qualities[i];
-      }
-    }
-
-    return min === Number.POSITIVE_INFINITY ? 0 : min;
+  /**
+   * Get minimum element quality from a handle
+   */
+  private getMinQuality(
+    handle: MeshHandle | MeshHandle2D | MeshHandleS,
+  ): number {
+    return this.getQualityStatsFor(handle, 0).min;
   }
 
   /**
-   * Run the remeshing algorithm on a handle
+   * Get element quality statistics from a handle (computed in one C pass)
    */
-  private runRemesh(handle: MeshHandle | MeshHandle2D | MeshHandleS): number {
+  private getQualityStatsFor(
+    handle: MeshHandle | MeshHandle2D | MeshHandleS,
+    nbins: number,
+  ): QualityStats | QualityStats2D | QualityStatsS {
     switch (this._type) {
       case MeshType.Mesh2D:
-        return MMG2D.mmg2dlib(handle as MeshHandle2D);
+        return MMG2D.getQualityStats(handle as MeshHandle2D, nbins);
       case MeshType.Mesh3D:
-        return MMG3D.mmg3dlib(handle as MeshHandle);
+        return MMG3D.getQualityStats(handle as MeshHandle, nbins);
       case MeshType.MeshS:
-        return MMGS.mmgslib(handle as MeshHandleS);
+        return MMGS.getQualityStats(handle as MeshHandleS, nbins);
       default:
         throw new Error(`Unknown mesh type: ${this._type}`);
     }
   }
 
+  /**
+   * Run the remeshing algorithm on a handle
+   *
+   * Progress tracking is enabled on the handle when a callback or an abort
+   * signal is given.
+   */
+  private async runRemesh(
+    handle: MeshHandle | MeshHandle2D | MeshHandleS,
+    control: RemeshControl,
+  ): Promise<number> {
+    const { onProgress, signal } = control;
+    if (signal?.aborted) {
+      return MMG_RETURN_CODES.ABORTED;
+    }
+
+    const onAbort = () => {
+      switch (this._type) {
+        case MeshType.Mesh2D:
+          MMG2D.abortRemesh(handle as MeshHandle2D);
+          break;
+        case MeshType.Mesh3D:
+          MMG3D.abortRemesh(handle as MeshHandle);
+          break;
+        case MeshType.MeshS:
+          MMGS.abortRemesh(handle as MeshHandleS);
+          break;
+      }
+    };
+    // A callback is needed to enable tracking, which abortRemesh relies on
+    const report = onProgress ?? (signal ? () => {} : undefined);
+    signal?.addEventListener("abort", onAbort, { once: true });
+
+    try {
+      switch (this._type) {
+        case MeshType.Mesh2D:
+          return await MMG2D.mmg2dlibAsync(handle as MeshHandle2D, report);
+        case MeshType.Mesh3D:
+          return await MMG3D.mmg3dlibAsync(handle as MeshHandle, report);
+        case MeshType.MeshS:
+          return await MMGS.mmgslibAsync(handle as MeshHandleS, report);
+        default:
+          throw new Error(`Unknown mesh type: ${this._type}`);
+      }
+    } finally {
+      signal?.removeEventListener("abort", onAbort);
+    }
+  }
+
   /**
    * Extract a new Mesh instance from a handle
    * Note: The handle ownership is transferred to the new Mesh
@@ -983,118 +1673,74 @@ export class Mesh {
 
   /**
    * Apply local sizing constraints to a handle by setting the metric field
+   *
+   * The constraints are packed once and evaluated natively, in a single pass
+   * over the vertices that writes the metric in place.
    */
   private applySizingConstraints(
     handle: MeshHandle | MeshHandle2D | MeshHandleS,
   ): void {
-    // Get vertices from the handle
-    let vertices: Float64Array;
-    let nVertices: number;
+    const dimension = this._type === MeshType.Mesh2D ? 2 : 3;
+    const constraints = encodeSizingConstraints(
+      this._sizingConstraints,
+      dimension,
+    );
 
     switch (this._type) {
       case MeshType.Mesh2D:
-        vertices = MMG2D.getVertices(handle as MeshHandle2D);
-        nVertices = vertices.length / 2;
+        MMG2D.applySizing(handle as MeshHandle2D, constraints);
         break;
       case MeshType.Mesh3D:
-        vertices = MMG3D.getVertices(handle as MeshHandle);
-        nVertices = vertices.length / 3;
+        MMG3D.applySizing(handle as MeshHandle, constraints);
         break;
       case MeshType.MeshS:
-        vertices = MMGS.getVertices(handle as MeshHandleS);
-        nVertices = vertices.length / 3;
+        MMGS.applySizing(handle as MeshHandleS, constraints);
         break;
-      default:
-        throw new Error(`Unknown mesh type: ${this._type}`);
     }
+  }
 
-    // Compute combined sizes from all constraints
+  /**
+   * Freeze every element of a handle away from the local sizing regions,
+   * so that a local remesh only reworks the elements around them
+   */
+  private freezeOutsideRegions(
+    handle: MeshHandle | MeshHandle2D | MeshHandleS,
+    margin: number,
+  ): void {
     const dimension = this._type === MeshType.Mesh2D ? 2 : 3;
-    const sizes = combineSizingConstraints(
+    const regions = encodeSizingConstraints(
       this._sizingConstraints,
-      vertices,
-      dimension as 2 | 3,
+      dimension,
     );
 
-    // Compute a default size for unconstrained vertices based on mesh bounding box
-    // MMG requires positive metric values - 0 is not valid
-    const defaultSize = this.computeDefaultSize(vertices, dimension);
-
-    // Convert infinite sizes to the default size
-    for (let i = 0; i < sizes.length; i++) {
-      if (!Number.isFinite(sizes[i])) {
-        sizes[i] = defaultSize;
-      }
-    }
-
-    // Set the solution size and values
     switch (this._type) {
       case MeshType.Mesh2D:
-        MMG2D.setSolSize(
-          handle as MeshHandle2D,
-          SOL_ENTITY_2D.VERTEX,
-          nVertices,
-          SOL_TYPE_2D.SCALAR,
-        );
-        MMG2D.setScalarSols(handle as MeshHandle2D, sizes);
+        MMG2D.freezeOutside(handle as MeshHandle2D, regions, margin);
         break;
       case MeshType.Mesh3D:
-        MMG3D.setSolSize(
-          handle as MeshHandle,
-          SOL_ENTITY.VERTEX,
-          nVertices,
-          SOL_TYPE.SCALAR,
-        );
-        MMG3D.setScalarSols(handle as MeshHandle, sizes);
+        MMG3D.freezeOutside(handle as MeshHandle, regions, margin);
         break;
       case MeshType.MeshS:
-        MMGS.setSolSize(
-          handle as MeshHandleS,
-          SOL_ENTITY_S.VERTEX,
-          nVertices,
-          SOL_TYPE_S.SCALAR,
-        );
-        MMGS.setScalarSols(handle as MeshHandleS, sizes);
+        MMGS.freezeOutside(handle as MeshHandleS, regions, margin);
         break;
     }
   }
 
   /**
-   * Compute a reasonable default edge size based on mesh bounding box
+   * Clear the required tags left on a handle by a local remesh
    */
-  private computeDefaultSize(
-    vertices: Float64Array,
-    dimension: number,
-  ): number {
-    if (vertices.length === 0) {
-      return 1.0;
-    }
-
-    // Compute bounding box
-    const min = new Array(dimension).fill(Number.POSITIVE_INFINITY);
-    const max = new Array(dimension).fill(Number.NEGATIVE_INFINITY);
-
-    const nVertices = vertices.length / dimension;
-    for (let i = 0; i < nVertices; i++) {
-      for (let d = 0; d < dimension; d++) {
-        const v = vertices[i * dimension + d];
-        if (v < min[d]) min[d] = v;
-        if (v > max[d]) max[d] = v;
-      }
-    }
-
-    // Compute diagonal length
-    let diag2 = 0;
-    for (let d = 0; d < dimension; d++) {
-      const diff = max[d] - min[d];
-      diag2 += diff * diff;
+  private thawHandle(handle: MeshHandle | MeshHandle2D | MeshHandleS): void {
+    switch (this._type) {
+      case MeshType.Mesh2D:
+        MMG2D.thaw(handle as MeshHandle2D);
+        break;
+      case MeshType.Mesh3D:
+        MMG3D.thaw(handle as MeshHandle);
+        break;
+      case MeshType.MeshS:
+        MMGS.thaw(handle as MeshHandleS);
+        break;
     }
-
-    // Use a fraction of the diagonal as default size
-    // This allows MMG to refine freely while respecting the mesh scale
-    // Handle degenerate case where all vertices are at the same point
-    const diag = Math.sqrt(diag2);
-    return diag > 0 ? diag * 0.2 : 1.0;
   }
 
   // =====================
@@ -1246,7 +1892,7 @@ export class Mesh {
   ): Promise<MeshType> {
     // Check file header for hints
     const text = new TextDecoder("utf-8", { fatal: false }).decode(
-      buffer.slice(0, 1000),
+      buffer.slice(0, TYPE_DETECTION_BYTES),
     );
 
     // Look for Dimension keyword in Medit format
@@ -1313,102 +1959,49 @@ export class Mesh {
    * Set mesh data from MeshData input
    */
   private setData(data: MeshData): void {
-    const { vertices, cells, boundaryFaces, vertexRefs, cellRefs } = data;
+    const { vertices, cells } = data;
 
     // Skip if empty data (for load() path)
     if (vertices.length === 0 && cells.length === 0) {
       return;
     }
 
+    // Every array goes through one staging buffer and one native call
+    const arrays: MeshImportData = {
+      vertices,
+      vertexRefs: data.vertexRefs,
+      cells,
+      cellRefs: data.cellRefs,
+      boundary: data.boundaryFaces,
+      boundaryRefs: data.boundaryRefs,
+      metric: data.metric,
+    };
     switch (this._type) {
       case MeshType.Mesh2D:
-        this.setData2D(vertices, cells, boundaryFaces, vertexRefs, cellRefs);
+        MMG2D.importMesh(this._handle as MeshHandle2D, arrays);
         break;
       case MeshType.Mesh3D:
-        this.setData3D(vertices, cells, boundaryFaces, vertexRefs, cellRefs);
+        MMG3D.importMesh(this._handle as MeshHandle, arrays);
         break;
       case MeshType.MeshS:
-        this.setDataS(vertices, cells, boundaryFaces, vertexRefs, cellRefs);
+        MMGS.importMesh(this._handle as MeshHandleS, arrays);
         break;
     }
   }
 
-  private setData2D(
-    vertices: Float64Array,
-    cells: Int32Array,
-    boundaryFaces?: Int32Array,
-    _vertexRefs?: Int32Array,
-    _cellRefs?: Int32Array,
-  ): void {
-    const handle = this._handle as MeshHandle2D;
-    const nVertices = vertices.length / 2;
-    const nTriangles = cells.length / 3;
-    const nEdges = boundaryFaces ? boundaryFaces.length / 2 : 0;
-
-    MMG2D.setMeshSize(handle, nVertices, nTriangles, 0, nEdges);
-    MMG2D.setVertices(handle, vertices);
-    MMG2D.setTriangles(handle, cells);
-
-    if (boundaryFaces && boundaryFaces.length > 0) {
-      MMG2D.setEdges(handle, boundaryFaces);
-    }
-  }
-
-  private setData3D(
-    vertices: Float64Array,
-    cells: Int32Array,
-    boundaryFaces?: Int32Array,
-    _vertexRefs?: Int32Array,
-    _cellRefs?: Int32Array,
-  ): void {
-    const handle = this._handle as MeshHandle;
-    const nVertices = vertices.length / 3;
-    const nTetrahedra = cells.length / 4;
-    const nTriangles = boundaryFaces ? boundaryFaces.length / 3 : 0;
-
-    MMG3D.setMeshSize(handle, nVertices, nTetrahedra, 0, nTriangles, 0, 0);
-    MMG3D.setVertices(handle, vertices);
-    MMG3D.setTetrahedra(handle, cells);
-
-    if (boundaryFaces && boundaryFaces.length > 0) {
-      MMG3D.setTriangles(handle, boundaryFaces);
-    }
-  }
-
-  private setDataS(
-    vertices: Float64Array,
-    cells: Int32Array,
-    boundaryFaces?: Int32Array,
-    _vertexRefs?: Int32Array,
-    _cellRefs?: Int32Array,
-  ): void {
-    const handle = this._handle as MeshHandleS;
-    const nVertices = vertices.length / 3;
-    const nTriangles = cells.length / 3;
-    const nEdges = boundaryFaces ? boundaryFaces.length / 2 : 0;
-
-    MMGS.setMeshSize(handle, nVertices, nTriangles, nEdges);
-    MMGS.setVertices(handle, vertices);
-    MMGS.setTriangles(handle, cells);
-
-    if (boundaryFaces && boundaryFaces.length > 0) {
-      MMGS.setEdges(handle, boundaryFaces);
-    }
-  }
-
   /**
-   * Load mesh from file into the current handle
+   * Load mesh from a memfile into the current handle
    */
-  private loadFromFile(filename: string): void {
+  private loadFromMemFile(file: number, format: "mesh" | "meshb"): void {
     switch (this._type) {
       case MeshType.Mesh2D:
-        MMG2D.loadMesh(this._handle as MeshHandle2D, filename);
+        MMG2D.loadMeshFromMemFile(this._handle as MeshHandle2D, file, format);
         break;
       case MeshType.Mesh3D:
-        MMG3D.loadMesh(this._handle as MeshHandle, filename);
+        MMG3D.loadMeshFromMemFile(this._handle as MeshHandle, file, format);
         break;
       case MeshType.MeshS:
-        MMGS.loadMesh(this._handle as MeshHandleS, filename);
+        MMGS.loadMeshFromMemFile(this._handle as MeshHandleS, file, format);
         break;
     }
   }
@@ -1430,16 +2023,16 @@ export class Mesh {
   }
 
   /**
-   * Get the appropriate filesystem for the mesh type
+   * Get the WASM module for the mesh type
    */
-  private static getFS(type: MeshType): EmscriptenFS {
+  private static getWasmModuleFor(type: MeshType): MemFileModule {
     switch (type) {
       case MeshType.Mesh2D:
-        return getFS2D();
+        return getWasmModule2D();
       case MeshType.Mesh3D:
-        return getFS();
+        return getWasmModule();
       case MeshType.MeshS:
-        return getFSS();
+        return getWasmModuleS();
       default:
         throw new Error(`Unknown mesh type: ${type}`);
     }
@@ -49,11 +49,32 @@ declare module "*/mmg.js" {
   }
 
   interface EmscriptenModule {
+    _mmgwasm_has_threads(): number;
+    _mmgwasm_has_opfs(): number;
+    _mmgwasm_mount_opfs(pathPtr: number): number;
+    _mmgwasm_memfile_create(capacity: number): number;
+    _mmgwasm_memfile_reserve(file: number, size: number): number;
+    _mmgwasm_memfile_commit(file: number, size: number): number;
+    _mmgwasm_memfile_data(file: number): number;
+    _mmgwasm_memfile_size(file: number): number;
+    _mmgwasm_memfile_free(file: number): void;
+    _mmgwasm_reserve_heap(bytes: number): number;
+    _mmgwasm_heap_max(): number;
+    _mmgwasm_pointer_size(): number;
+    _mmgwasm_native_heap_used(): number;
+    _mmgwasm_native_heap_peak(): number;
+    _mmgwasm_native_heap_reset_peak(): void;
+
     // MMG3D functions
     _mmg3d_init(): number;
     _mmg3d_free(handle: number): number;
+    _mmg3d_clone(handle: number): number;
     _mmg3d_get_available_handles(): number;
     _mmg3d_get_max_handles(): number;
+    _mmg3d_set_max_handles(maxHandles: number): number;
+    _mmg3d_set_arena_mode(enabled: number): void;
+    _mmg3d_get_memory_usage(handle: number, outPtr: number): number;
+    _mmg3d_import_mesh(handle: number, descriptorPtr: number): number;
     _mmg3d_set_mesh_size(
       handle: number,
       np: number,
@@ -133,18 +154,120 @@ declare module "*/mmg.js" {
     _mmg3d_get_scalar_sols(handle: number, outCountPtr: number): number;
     _mmg3d_set_tensor_sols(handle: number, valuesPtr: number): number;
     _mmg3d_get_tensor_sols(handle: number, outCountPtr: number): number;
+    _mmg3d_apply_sizing(
+      handle: number,
+      constraintsPtr: number,
+      count: number,
+    ): number;
+    _mmg3d_freeze_outside(
+      handle: number,
+      regionsPtr: number,
+      count: number,
+      margin: number,
+    ): number;
+    _mmg3d_thaw(handle: number): number;
+    _mmg3d_locate_points(
+      handle: number,
+      pointsPtr: number,
+      n: number,
+      outElementsPtr: number,
+      outBaryPtr: number,
+    ): number;
+    _mmg3d_sample_sol(
+      handle: number,
+      pointsPtr: number,
+      n: number,
+      outPtr: number,
+    ): number;
+    _mmg3d_interpolate_fields(
+      handle: number,
+      source: number,
+      valuesPtr: number,
+      stride: number,
+      outPtr: number,
+    ): number;
     _mmg3d_remesh(handle: number): number;
+    _mmg3d_remesh_async(handle: number): number;
+    _mmg3d_remesh_status(handle: number): number;
+    _mmg3d_get_progress(handle: number): number;
+    _mmg3d_get_stats(handle: number, outPtr: number): number;
     _mmg3d_free_array(ptr: number): void;
     _mmg3d_load_mesh(handle: number, filenamePtr: number): number;
+    _mmg3d_load_mesh_from_memfile(
+      handle: number,
+      file: number,
+      binary: number,
+    ): number;
     _mmg3d_save_mesh(handle: number, filenamePtr: number): number;
+    _mmg3d_save_mesh_to_memfile(
+      handle: number,
+      file: number,
+      binary: number,
+    ): number;
     _mmg3d_load_sol(handle: number, filenamePtr: number): number;
+    _mmg3d_load_sol_from_memfile(
+      handle: number,
+      file: number,
+      binary: number,
+    ): number;
     _mmg3d_save_sol(handle: number, filenamePtr: number): number;
+    _mmg3d_save_sol_to_memfile(
+      handle: number,
+      file: number,
+      binary: number,
+    ): number;
+    _mmg3d_get_quality_stats(
+      handle: number,
+      nbins: number,
+      statsPtr: number,
+      histogramPtr: number,
+    ): number;
+    _mmg3d_get_generation(handle: number): number;
+    _mmg3d_view_vertices(handle: number, outCountPtr: number): number;
+    _mmg3d_view_tetrahedra(handle: number, outCountPtr: number): number;
+    _mmg3d_view_triangles(handle: number, outCountPtr: number): number;
+    _mmg3d_view_sols(
+      handle: number,
+      outCountPtr: number,
+      outSizePtr: number,
+    ): number;
+    _mmg3d_pack_mesh(
+      handle: number,
+      flags: number,
+      outSizePtr: number,
+    ): number;
+    _mmg3d_extract_surface(handle: number, planePtr: number): number;
+    _mmg3d_partition(
+      handle: number,
+      nparts: number,
+      pass: number,
+      outPtr: number,
+    ): number;
+    _mmg3d_extract_subdomain(
+      handle: number,
+      partsPtr: number,
+      part: number,
+    ): number;
+    _mmg3d_merge_subdomains(handlesPtr: number, count: number): number;
+    _mmg3d_remesh_batch(
+      handle: number,
+      meshesPtr: number,
+      count: number,
+      parametersPtr: number,
+      nparameters: number,
+      outSizePtr: number,
+    ): number;
 
     // MMG2D functions
     _mmg2d_init(): number;
     _mmg2d_free(handle: number): number;
+    _mmg2d_clone(handle: number): number;
     _mmg2d_get_available_handles(): number;
     _mmg2d_get_max_handles(): number;
+    _mmg2d_set_max_handles(maxHandles: number): number;
+    _mmg2d_set_arena_mode(enabled: number): void;
+    _mmg2d_get_memory_usage(handle: number, outPtr: number): number;
+    _mmg2d_import_mesh(handle: number, descriptorPtr: number): number;
     _mmg2d_set_mesh_size(
       handle: number,
       np: number,
@@ -175,16 +298,105 @@ declare module "*/mmg.js" {
     _mmg2d_get_scalar_sols(handle: number, outCountPtr: number): number;
     _mmg2d_set_tensor_sols(handle: number, valuesPtr: number): number;
     _mmg2d_get_tensor_sols(handle: number, outCountPtr: number): number;
+    _mmg2d_apply_sizing(
+      handle: number,
+      constraintsPtr: number,
+      count: number,
+    ): number;
+    _mmg2d_freeze_outside(
+      handle: number,
+      regionsPtr: number,
+      count: number,
+      margin: number,
+    ): number;
+    _mmg2d_thaw(handle: number): number;
+    _mmg2d_locate_points(
+      handle: number,
+      pointsPtr: number,
+      n: number,
+      outElementsPtr: number,
+      outBaryPtr: number,
+    ): number;
+    _mmg2d_sample_sol(
+      handle: number,
+      pointsPtr: number,
+      n: number,
+      outPtr: number,
+    ): number;
+    _mmg2d_interpolate_fields(
+      handle: number,
+      source: number,
+      valuesPtr: number,
+      stride: number,
+      outPtr: number,
+    ): number;
     _mmg2d_load_mesh(handle: number, filenamePtr: number): number;
+    _mmg2d_load_mesh_from_memfile(
+      handle: number,
+      file: number,
+      binary: number,
+    ): number;
     _mmg2d_save_mesh(handle: number, filenamePtr: number): number;
+    _mmg2d_save_mesh_to_memfile(
+      handle: number,
+      file: number,
+      binary: number,
+    ): number;
     _mmg2d_load_sol(handle: number, filenamePtr: number): number;
+    _mmg2d_load_sol_from_memfile(
+      handle: number,
+      file: number,
+      binary: number,
+    ): number;
     _mmg2d_save_sol(handle: number, filenamePtr: number): number;
+    _mmg2d_save_sol_to_memfile(
+      handle: number,
+      file: number,
+      binary: number,
+    ): number;
+    _mmg2d_get_quality_stats(
+      handle: number,
+      nbins: number,
+      statsPtr: number,
+      histogramPtr: number,
+    ): number;
+    _mmg2d_remesh_async(handle: number): number;
+    _mmg2d_remesh_status(handle: number): number;
+    _mmg2d_get_progress(handle: number): number;
+    _mmg2d_get_stats(handle: number, outPtr: number): number;
+    _mmg2d_get_generation(handle: number): number;
+    _mmg2d_view_vertices(handle: number, outCountPtr: number): number;
+    _mmg2d_view_triangles(handle: number, outCountPtr: number): number;
+    _mmg2d_view_edges(handle: number, outCountPtr: number): number;
+    _mmg2d_view_sols(
+      handle: number,
+      outCountPtr: number,
+      outSizePtr: number,
+    ): number;
+    _mmg2d_pack_mesh(
+      handle: number,
+      flags: number,
+      outSizePtr: number,
+    ): number;
+    _mmg2d_remesh_batch(
+      handle: number,
+      meshesPtr: number,
+      count: number,
+      parametersPtr: number,
+      nparameters: number,
+      outSizePtr: number,
+    ): number;
 
     // MMGS functions
     _mmgs_init(): number;
     _mmgs_free(handle: number): number;
+    _mmgs_clone(handle: number): number;
     _mmgs_get_available_handles(): number;
     _mmgs_get_max_handles(): number;
+    _mmgs_set_max_handles(maxHandles: number): number;
+    _mmgs_set_arena_mode(enabled: number): void;
+    _mmgs_get_memory_usage(handle: number, outPtr: number): number;
+    _mmgs_import_mesh(handle: number, descriptorPtr: number): number;
     _mmgs_set_mesh_size(
       handle: number,
       np: number,
@@ -213,10 +425,94 @@ declare module "*/mmg.js" {
     _mmgs_get_scalar_sols(handle: number, outCountPtr: number): number;
     _mmgs_set_tensor_sols(handle: number, valuesPtr: number): number;
     _mmgs_get_tensor_sols(handle: number, outCountPtr: number): number;
+    _mmgs_apply_sizing(
+      handle: number,
+      constraintsPtr: number,
+      count: number,
+    ): number;
+    _mmgs_freeze_outside(
+      handle: number,
+      regionsPtr: number,
+      count: number,
+      margin: number,
+    ): number;
+    _mmgs_thaw(handle: number): number;
+    _mmgs_locate_points(
+      handle: number,
+      pointsPtr: number,
+      n: number,
+      outElementsPtr: number,
+      outBaryPtr: number,
+    ): number;
+    _mmgs_sample_sol(
+      handle: number,
+      pointsPtr: number,
+      n: number,
+      outPtr: number,
+    ): number;
+    _mmgs_interpolate_fields(
+      handle: number,
+      source: number,
+      valuesPtr: number,
+      stride: number,
+      outPtr: number,
+    ): number;
     _mmgs_load_mesh(handle: number, filenamePtr: number): number;
+    _mmgs_load_mesh_from_memfile(
+      handle: number,
+      file: number,
+      binary: number,
+    ): number;
     _mmgs_save_mesh(handle: number, filenamePtr: number): number;
+    _mmgs_save_mesh_to_memfile(
+      handle: number,
+      file: number,
+      binary: number,
+    ): number;
     _mmgs_load_sol(handle: number, filenamePtr: number): number;
+    _mmgs_load_sol_from_memfile(
+      handle: number,
+      file: number,
+      binary: number,
+    ): number;
     _mmgs_save_sol(handle: number, filenamePtr: number): number;
+    _mmgs_save_sol_to_memfile(
+      handle: number,
+      file: number,
+      binary: number,
+    ): number;
+    _mmgs_get_quality_stats(
+      handle: number,
+      nbins: number,
+      statsPtr: number,
+      histogramPtr: number,
+    ): number;
+    _mmgs_remesh_async(handle: number): number;
+    _mmgs_remesh_status(handle: number): number;
+    _mmgs_get_progress(handle: number): number;
+    _mmgs_get_stats(handle: number, outPtr: number): number;
+    _mmgs_get_generation(handle: number): number;
+    _mmgs_view_vertices(handle: number, outCountPtr: number): number;
+    _mmgs_view_triangles(handle: number, outCountPtr: number): number;
+    _mmgs_view_edges(handle: number, outCountPtr: number): number;
+    _mmgs_view_sols(
+      handle: number,
+      outCountPtr: number,
+      outSizePtr: number,
+    ): number;
+    _mmgs_pack_mesh(
+      handle: number,
+      flags: number,
+      outSizePtr: number,
+    ): number;
+    _mmgs_remesh_batch(
+      handle: number,
+      meshesPtr: number,
+      count: number,
+      parametersPtr: number,
+      nparameters: number,
+      outSizePtr: number,
+    ): number;
 
     // Memory functions
     _malloc(size: number): number;
@@ -233,5 +529,19 @@ declare module "*/mmg.js" {
     FS: EmscriptenFS;
   }
 
-  export default function createModule(): Promise<EmscriptenModule>;
+  /** Settings passed to the factory, merged into the module */
+  interface ModuleArgs {
+    /** Instantiate the binary instead of letting the module fetch it */
+    instantiateWasm?(
+      imports: WebAssembly.Imports,
+      receiveInstance: (
+        instance: WebAssembly.Instance,
+        module: WebAssembly.Module,
+      ) => void,
+    ): object;
+  }
+
+  export default function createModule(
+    moduleArgs?: ModuleArgs,
+  ): Promise<EmscriptenModule>;
 }
@@ -13,7 +13,18 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include "arena.h"
+#include "batch.h"
+#include "import.h"
+#include "locate.h"
+#include "memfile.h"
+#include "pack.h"
+#include "progress.h"
+#include "sizing.h"
+#include "stats.h"
+#include "threads.h"
 #include "mmg/mmg2d/libmmg2d.h"
+#include "mmg2d/libmmg2d_private.h"
 
 /*
  * Verify MMG5_int is 32-bit. This assumption is used when casting between
@@ -24,12 +35,16 @@ _Static_assert(sizeof(MMG5_int) == sizeof(int32_t),
     "MMG5_int must be 32-bit for JavaScript bindings");
 
 /*
- * Maximum number of concurrent mesh handles.
- * This limit exists because handles are stored in a fixed-size array.
- * For typical browser usage, 64 concurrent meshes should be sufficient.
- * Use mmg2d_get_available_handles() to check current capacity.
+ * Handle registry limits.
+ * Entries live in pages of HANDLE_PAGE_SIZE slots allocated on demand, so the
+ * table grows up to the configured maximum without ever moving an entry.
+ * The maximum defaults to DEFAULT_MAX_HANDLES and can be changed with
+ * mmg2d_set_max_handles(), up to HANDLE_LIMIT.
  */
-#define MAX_HANDLES 64
+#define HANDLE_PAGE_SIZE 64
+#define HANDLE_MAX_PAGES 1024
+#define HANDLE_LIMIT (HANDLE_PAGE_SIZE * HANDLE_MAX_PAGES)
+#define DEFAULT_MAX_HANDLES 1024
 
 /*
  * Helper macro for safe multi-allocation with cleanup.
@@ -50,58 +65,146 @@ static inline void* fail_with_count(int* out_count) {
     return NULL;
 }
 
+/*
+ * Wrapper-owned packed buffer backing a zero-copy view.
+ * The buffer only grows and is repacked lazily when the mesh generation
+ * differs from the one it was packed at.
+ */
+typedef struct {
+    void* data;
+    size_t capacity;          /* allocated bytes */
+    int count;                /* number of packed entities */
+    unsigned int generation;  /* mesh generation at pack time, 0 = never */
+} ViewBuffer;
+
 /* Handle table entry storing mesh and solution pointers */
 typedef struct {
     MMG5_pMesh mesh;
     MMG5_pSol sol;
-    int active;
+    int active;               /* 0 = free, 1 = in use, -1 = reserved */
+    int next_free;            /* next slot on the free list, -1 = end */
+    int busy;                 /* 1 while an asynchronous remesh is running */
+    int async_result;         /* return code of the last asynchronous remesh */
+    unsigned int generation;  /* bumped whenever the mesh is modified */
+    MmgwasmProgress progress; /* progress/abort record shared with JS */
+    MmgwasmStats stats;       /* last remesh, instrumentation build only */
+    ViewBuffer view_vertices;
+    ViewBuffer view_triangles;
+    ViewBuffer view_edges;
+    ViewBuffer packed;        /* last mesh packed by mmg2d_pack_mesh */
+    ViewBuffer batch;         /* results of the last mmg2d_remesh_batch */
+    MmgwasmLocator locator;   /* element index for point queries */
+    MmgwasmArena arena;       /* MMG allocations in arena mode */
 } HandleEntry2D;
 
-/* Global handle table for MMG2D (separate from MMG3D) */
-static HandleEntry2D g_handles_2d[MAX_HANDLES];
-static int g_initialized_2d = 0;
+/*
+ * Global handle registry for MMG2D (separate from MMG3D).
+ * Slots below g_handle_count_2d have been handed out at least once; released
+ * ones are chained into a free list, so allocation and release are O(1).
+ */
+static HandleEntry2D* g_handle_pages_2d[HANDLE_MAX_PAGES];
+static int g_handle_count_2d = 0;   /* slots handed out so far */
+static int g_free_head_2d = -1;     /* most recently released slot, -1 = none */
+static int g_free_count_2d = 0;     /* number of slots on the free list */
+static int g_max_handles_2d = DEFAULT_MAX_HANDLES;
+static int g_arena_mode_2d = 0;      /* 1: new handles allocate from arenas */
 
-/* Initialize the handle table (called automatically on first use) */
-static void ensure_initialized_2d(void) {
-    if (!g_initialized_2d) {
-        memset(g_handles_2d, 0, sizeof(g_handles_2d));
-        g_initialized_2d = 1;
-    }
-}
+/* Entry for a handle, which must be below g_handle_count_2d */
+#define HANDLE_2D(h) \
+    (g_handle_pages_2d[(h) / HANDLE_PAGE_SIZE][(h) % HANDLE_PAGE_SIZE])
 
-/* Find a free handle slot, returns -1 if none available */
+/* Protects the handle table in the pthreads build (no-op otherwise) */
+MMGWASM_MUTEX(g_handles_lock_2d);
+
+/* Global generation counter, so generations stay unique across slot reuse */
+static unsigned int g_generation_2d = 0;
+
+/*
+ * Reserve a handle slot, returns -1 if the maximum is reached.
+ * Reuses the most recently released slot, otherwise takes the next unused
+ * one, allocating its page on first use.
+ * The slot must then be activated or released by the caller.
+ */
 static int find_free_handle_2d(void) {
-    ensure_initialized_2d();
-    for (int i = 0; i < MAX_HANDLES; i++) {
-        if (!g_handles_2d[i].active) {
-            return i;
+    int handle = -1;
+    MMGWASM_LOCK(g_handles_lock_2d);
+    if (g_free_head_2d >= 0) {
+        handle = g_free_head_2d;
+        g_free_head_2d = HANDLE_2D(handle).next_free;
+        g_free_count_2d--;
+    } else if (g_handle_count_2d < g_max_handles_2d) {
+        int page = g_handle_count_2d / HANDLE_PAGE_SIZE;
+        if (!g_handle_pages_2d[page]) {
+            g_handle_pages_2d[page] = (HandleEntry2D*)calloc(HANDLE_PAGE_SIZE, sizeof(HandleEntry2D));
         }
+        if (g_handle_pages_2d[page]) {
+            handle = g_handle_count_2d++;
+        }
+    }
+    if (handle >= 0) {
+        HANDLE_2D(handle).active = -1;
     }
-    return -1;
+    MMGWASM_UNLOCK(g_handles_lock_2d);
+    return handle;
+}
+
+/* Release a reserved handle slot onto the free list */
+static void release_handle_2d(int handle) {
+    MMGWASM_LOCK(g_handles_lock_2d);
+    memset(&HANDLE_2D(handle), 0, sizeof(HandleEntry2D));
+    HANDLE_2D(handle).next_free = g_free_head_2d;
+    g_free_head_2d = handle;
+    g_free_count_2d++;
+    MMGWASM_UNLOCK(g_handles_lock_2d);
 }
 
 /* Validate a handle, returns 1 if valid, 0 otherwise */
 static int validate_handle_2d(int handle) {
-    ensure_initialized_2d();
-    if (handle < 0 || handle >= MAX_HANDLES) {
-        return 0;
+    MMGWASM_LOCK(g_handles_lock_2d);
+    int valid = handle >= 0 && handle < g_handle_count_2d &&
+        HANDLE_2D(handle).active == 1;
+    MMGWASM_UNLOCK(g_handles_lock_2d);
+    return valid;
+}
+
+/* Record that the mesh behind a handle changed, invalidating its views */
+static void mark_modified_2d(int handle) {
+    MMGWASM_LOCK(g_handles_lock_2d);
+    if (++g_generation_2d == 0) {
+        g_generation_2d = 1;  /* 0 is reserved for "never packed" */
+    }
+    HANDLE_2D(handle).generation = g_generation_2d;
+    MMGWASM_UNLOCK(g_handles_lock_2d);
+}
+
+/* Grow a view buffer to at least bytes, returns NULL on allocation failure */
+static void* view_reserve(ViewBuffer* view, size_t bytes) {
+    if (bytes > view->capacity) {
+        void* data = realloc(view->data, bytes);
+        if (!data) {
+            return NULL;
+        }
+        view->data = data;
+        view->capacity = bytes;
     }
-    return g_handles_2d[handle].active;
+    return view->data;
+}
+
+/* Release a view buffer */
+static void view_release(ViewBuffer* view) {
+    free(view->data);
+    memset(view, 0, sizeof(*view));
 }
 
 /**
  * Get the number of available (free) mesh handle slots.
- * Returns a value between 0 and MAX_HANDLES.
+ * Returns a value between 0 and the maximum number of handles.
  */
 EMSCRIPTEN_KEEPALIVE
 int mmg2d_get_available_handles(void) {
-    ensure_initialized_2d();
-    int count = 0;
-    for (int i = 0; i < MAX_HANDLES; i++) {
-        if (!g_handles_2d[i].active) {
-            count++;
-        }
-    }
+    MMGWASM_LOCK(g_handles_lock_2d);
+    int count = g_max_handles_2d - g_handle_count_2d + g_free_count_2d;
+    MMGWASM_UNLOCK(g_handles_lock_2d);
     return count;
 }
 
@@ -110,12 +213,65 @@ int mmg2d_get_available_handles(void) {
  */
 EMSCRIPTEN_KEEPALIVE
 int mmg2d_get_max_handles(void) {
-    return MAX_HANDLES;
+    MMGWASM_LOCK(g_handles_lock_2d);
+    int max_handles = g_max_handles_2d;
+    MMGWASM_UNLOCK(g_handles_lock_2d);
+    return max_handles;
+}
+
+/**
+ * Set the maximum number of concurrent mesh handles.
+ * The maximum cannot be lowered below the number of slots already handed
+ * out, nor raised above HANDLE_LIMIT.
+ * Returns 1 on success, 0 on failure.
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg2d_set_max_handles(int max_handles) {
+    int result = 0;
+    MMGWASM_LOCK(g_handles_lock_2d);
+    if (max_handles > 0 && max_handles <= HANDLE_LIMIT &&
+        max_handles >= g_handle_count_2d) {
+        g_max_handles_2d = max_handles;
+        result = 1;
+    }
+    MMGWASM_UNLOCK(g_handles_lock_2d);
+    return result;
+}
+
+/**
+ * Choose whether handles created from now on allocate MMG's memory from a
+ * per-handle arena (see arena.h), released in one step by mmg2d_free.
+ * Existing handles keep their mode.
+ */
+EMSCRIPTEN_KEEPALIVE
+void mmg2d_set_arena_mode(int enabled) {
+    MMGWASM_LOCK(g_handles_lock_2d);
+    g_arena_mode_2d = enabled != 0;
+    MMGWASM_UNLOCK(g_handles_lock_2d);
+}
+
+/**
+ * Get the memory held for a handle.
+ * out receives 3 doubles: the bytes MMG accounts to the mesh and solution
+ * (mesh->memCur), MMG's memory limit for them (mesh->memMax, set through the
+ * mem parameter) and the bytes of the handle's arena (0 outside arena mode).
+ * Returns 1 on success, 0 on failure.
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg2d_get_memory_usage(int handle, double* out) {
+    if (!validate_handle_2d(handle) || !out) {
+        return 0;
+    }
+    MMG5_pMesh mesh = HANDLE_2D(handle).mesh;
+    out[0] = (double)mesh->memCur;
+    out[1] = (double)mesh->memMax;
+    out[2] = (double)HANDLE_2D(handle).arena.capacity;
+    return 1;
 }
 
 /**
  * Initialize a new MMG2D mesh and solution structure.
- * Returns a handle (0-63) on success, -1 on failure.
+ * Returns a handle (0 to max handles - 1) on success, -1 on failure.
  */
 EMSCRIPTEN_KEEPALIVE
 int mmg2d_init(void) {
@@ -127,24 +283,37 @@ int mmg2d_init(void) {
     MMG5_pMesh mesh = NULL;
     MMG5_pSol sol = NULL;
 
+    MMGWASM_LOCK(g_handles_lock_2d);
+    HANDLE_2D(handle).arena.enabled = g_arena_mode_2d;
+    MMGWASM_UNLOCK(g_handles_lock_2d);
+
+    MmgwasmArena* outer = mmgwasm_arena_enter(&HANDLE_2D(handle).arena);
     int result = MMG2D_Init_mesh(
         MMG5_ARG_start,
         MMG5_ARG_ppMesh, &mesh,
         MMG5_ARG_ppMet, &sol,
         MMG5_ARG_end
     );
+    if (result == 1 && mesh != NULL) {
+        /* Initialize default parameters */
+        MMG2D_Init_parameters(mesh);
+    }
+    mmgwasm_arena_leave(outer);
 
     if (result != 1 || mesh == NULL) {
+        mmgwasm_arena_release(&HANDLE_2D(handle).arena);
+        release_handle_2d(handle);
         return -1;  /* Initialization failed */
     }
 
-    /* Initialize default parameters */
-    MMG2D_Init_parameters(mesh);
-
     /* Store in handle table */
-    g_handles_2d[handle].mesh = mesh;
-    g_handles_2d[handle].sol = sol;
-    g_handles_2d[handle].active = 1;
+    MMGWASM_LOCK(g_handles_lock_2d);
+    HANDLE_2D(handle).mesh = mesh;
+    HANDLE_2D(handle).sol = sol;
+    HANDLE_2D(handle).async_result = -1;
+    HANDLE_2D(handle).active = 1;
+    MMGWASM_UNLOCK(g_handles_lock_2d);
+    mark_modified_2d(handle);
 
     return handle;
 }
@@ -155,27 +324,177 @@ int mmg2d_init(void) {
  */
 EMSCRIPTEN_KEEPALIVE
 int mmg2d_free(int handle) {
-    if (!validate_handle_2d(handle)) {
-        return 0;
+    /* Reserve the slot so it cannot be reused or freed twice meanwhile */
+    MMGWASM_LOCK(g_handles_lock_2d);
+    if (handle < 0 || handle >= g_handle_count_2d ||
+        HANDLE_2D(handle).active != 1 || HANDLE_2D(handle).busy) {
+        MMGWASM_UNLOCK(g_handles_lock_2d);
+        return 0;  /* Invalid handle, or a remesh is still running */
     }
+    HANDLE_2D(handle).active = -1;
+    MMGWASM_UNLOCK(g_handles_lock_2d);
 
-    MMG5_pMesh mesh = g_handles_2d[handle].mesh;
-    MMG5_pSol sol = g_handles_2d[handle].sol;
+    MMG5_pMesh mesh = HANDLE_2D(handle).mesh;
+    MMG5_pSol sol = HANDLE_2D(handle).sol;
 
+    MmgwasmArena* outer = mmgwasm_arena_enter(&HANDLE_2D(handle).arena);
     MMG2D_Free_all(
         MMG5_ARG_start,
         MMG5_ARG_ppMesh, &mesh,
         MMG5_ARG_ppMet, &sol,
         MMG5_ARG_end
     );
+    mmgwasm_arena_leave(outer);
+    mmgwasm_arena_release(&HANDLE_2D(handle).arena);
+
+    view_release(&HANDLE_2D(handle).view_vertices);
+    view_release(&HANDLE_2D(handle).view_triangles);
+    view_release(&HANDLE_2D(handle).view_edges);
+    view_release(&HANDLE_2D(handle).packed);
+    view_release(&HANDLE_2D(handle).batch);
+    mmgwasm_locator_free(&HANDLE_2D(handle).locator);
+    release_handle_2d(handle);
+
+    return 1;
+}
+
+/**
+ * Copy the mesh entities of src into dst, preserving refs and tags.
+ * dst must be a freshly initialized mesh. Scratch arrays are sized for the
+ * largest entity family and reused for each one.
+ * Returns 1 on success, 0 on failure.
+ */
+static int clone_mesh_2d(MMG5_pMesh src, MMG5_pMesh dst) {
+    MMG5_int np, nt, nquad, na;
+    if (MMG2D_Get_meshSize(src, &np, &nt, &nquad, &na) != 1)
+        return 0;
+    if (MMG2D_Set_meshSize(dst, np, nt, nquad, na) != 1)
+        return 0;
+
+    MMG5_int n = np;
+    if (nt > n) n = nt;
+    if (nquad > n) n = nquad;
+    if (na > n) n = na;
+    if (n == 0)
+        return 1;
+
+    int ok = 0;
+
+    /* Initialize all pointers to NULL for safe cleanup */
+    double* coords = NULL;
+    MMG5_int* ids = NULL;
+    MMG5_int* refs = NULL;
+    int* flags_a = NULL;
+    int* flags_b = NULL;
+
+    /* Allocate all arrays - goto cleanup on any failure */
+    ALLOC_OR_FAIL(coords, 2 * np + 1, double);
+    ALLOC_OR_FAIL(ids, 4 * n, MMG5_int);  /* quadrilaterals have 4 vertices */
+    ALLOC_OR_FAIL(refs, n, MMG5_int);
+    ALLOC_OR_FAIL(flags_a, n, int);
+    ALLOC_OR_FAIL(flags_b, n, int);
+
+    if (np > 0) {
+        /* flags_a: corners, flags_b: required */
+        if (MMG2D_Get_vertices(src, coords, refs, flags_a, flags_b) != 1) goto cleanup;
+        if (MMG2D_Set_vertices(dst, coords, refs) != 1) goto cleanup;
+        for (MMG5_int k = 0; k < np; k++) {
+            if (flags_a[k] && MMG2D_Set_corner(dst, k + 1) != 1) goto cleanup;
+            if (flags_b[k] && MMG2D_Set_requiredVertex(dst, k + 1) != 1) goto cleanup;
+        }
+    }
+
+    if (nt > 0) {
+        if (MMG2D_Get_triangles(src, ids, refs, flags_b) != 1) goto cleanup;
+        if (MMG2D_Set_triangles(dst, ids, refs) != 1) goto cleanup;
+        for (MMG5_int k = 0; k < nt; k++) {
+            if (flags_b[k] && MMG2D_Set_requiredTriangle(dst, k + 1) != 1) goto cleanup;
+        }
+    }
+
+    if (nquad > 0) {
+        if (MMG2D_Get_quadrilaterals(src, ids, refs, flags_b) != 1) goto cleanup;
+        if (MMG2D_Set_quadrilaterals(dst, ids, refs) != 1) goto cleanup;
+    }
 
-    g_handles_2d[handle].mesh = NULL;
-    g_handles_2d[handle].sol = NULL;
-    g_handles_2d[handle].active = 0;
+    if (na > 0) {
+        /* flags_a: ridges (not settable in MMG2D), flags_b: required */
+        if (MMG2D_Get_edges(src, ids, refs, flags_a, flags_b) != 1) goto cleanup;
+        if (MMG2D_Set_edges(dst, ids, refs) != 1) goto cleanup;
+        for (MMG5_int k = 0; k < na; k++) {
+            if (flags_b[k] && MMG2D_Set_requiredEdge(dst, k + 1) != 1) goto cleanup;
+        }
+    }
+
+    ok = 1;
+
+cleanup:
+    free(coords);
+    free(ids);
+    free(refs);
+    free(flags_a);
+    free(flags_b);
+    return ok;
+}
+
+/**
+ * Copy the solution (metric) field of src into dst.
+ * The values are copied straight from sol->m, whatever the solution type.
+ * Returns 1 on success (including when src has no solution), 0 on failure.
+ */
+static int clone_sol_2d(MMG5_pMesh src_mesh, MMG5_pSol src,
+                        MMG5_pMesh dst_mesh, MMG5_pSol dst) {
+    int typEntity, typSol;
+    MMG5_int np;
+    if (MMG2D_Get_solSize(src_mesh, src, &typEntity, &np, &typSol) != 1)
+        return 0;
+    if (np == 0 || !src->m)
+        return 1;
+    if (MMG2D_Set_solSize(dst_mesh, dst, typEntity, np, typSol) != 1)
+        return 0;
 
+    /* sol->m is 1-indexed: entity k occupies m[k*size .. k*size+size-1] */
+    memcpy(dst->m, src->m, (size_t)(np + 1) * src->size * sizeof(double));
     return 1;
 }
 
+/**
+ * Duplicate a mesh and its solution into a new handle.
+ * Vertices, triangles, quadrilaterals, edges, refs, corner/required tags
+ * and the metric field are copied inside WASM memory; parameters other than
+ * verbosity keep their defaults.
+ * Returns the new handle on success, -1 on failure.
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg2d_clone(int handle) {
+    if (!validate_handle_2d(handle)) {
+        return -1;
+    }
+
+    int clone = mmg2d_init();
+    if (clone < 0) {
+        return -1;
+    }
+
+    HandleEntry2D* src = &HANDLE_2D(handle);
+    HandleEntry2D* dst = &HANDLE_2D(clone);
+
+    MmgwasmArena* outer = mmgwasm_arena_enter(&dst->arena);
+    int ok = clone_mesh_2d(src->mesh, dst->mesh) &&
+        clone_sol_2d(src->mesh, src->sol, dst->mesh, dst->sol);
+    mmgwasm_arena_leave(outer);
+    if (!ok) {
+        mmg2d_free(clone);
+        return -1;
+    }
+
+    MMG2D_Set_iparameter(dst->mesh, dst->sol, MMG2D_IPARAM_verbose,
+                         src->mesh->info.imprim);
+    mark_modified_2d(clone);
+
+    return clone;
+}
+
 /**
  * Set mesh size (allocate memory for mesh entities).
  * For 2D meshes: np (vertices), nt (triangles), nquad (quadrilaterals), na (edges)
@@ -187,13 +506,19 @@ int mmg2d_set_mesh_size(int handle, int np, int nt, int nquad, int na) {
         return 0;
     }
 
-    return MMG2D_Set_meshSize(
-        g_handles_2d[handle].mesh,
+    MmgwasmArena* outer = mmgwasm_arena_enter(&HANDLE_2D(handle).arena);
+    int result = MMG2D_Set_meshSize(
+        HANDLE_2D(handle).mesh,
         (MMG5_int)np,      /* number of vertices */
         (MMG5_int)nt,      /* number of triangles */
         (MMG5_int)nquad,   /* number of quadrilaterals */
         (MMG5_int)na       /* number of edges */
     );
+    mmgwasm_arena_leave(outer);
+    if (result == 1) {
+        mark_modified_2d(handle);
+    }
+    return result;
 }
 
 /**
@@ -210,7 +535,7 @@ int mmg2d_get_mesh_size(int handle, int* np, int* nt, int* nquad, int* na) {
     MMG5_int _np, _nt, _nquad, _na;
 
     int result = MMG2D_Get_meshSize(
-        g_handles_2d[handle].mesh,
+        HANDLE_2D(handle).mesh,
         &_np, &_nt, &_nquad, &_na
     );
 
@@ -236,12 +561,16 @@ int mmg2d_set_vertex(int handle, double x, double y, int ref, int pos) {
         return 0;
     }
 
-    return MMG2D_Set_vertex(
-        g_handles_2d[handle].mesh,
+    int result = MMG2D_Set_vertex(
+        HANDLE_2D(handle).mesh,
         x, y,
         (MMG5_int)ref,
         (MMG5_int)pos
     );
+    if (result == 1) {
+        mark_modified_2d(handle);
+    }
+    return result;
 }
 
 /**
@@ -256,11 +585,15 @@ int mmg2d_set_vertices(int handle, double* vertices, int* refs) {
         return 0;
     }
 
-    return MMG2D_Set_vertices(
-        g_handles_2d[handle].mesh,
+    int result = MMG2D_Set_vertices(
+        HANDLE_2D(handle).mesh,
         vertices,
         (MMG5_int*)refs
     );
+    if (result == 1) {
+        mark_modified_2d(handle);
+    }
+    return result;
 }
 
 /**
@@ -276,7 +609,7 @@ double* mmg2d_get_vertices(int handle, int* out_count) {
         return fail_with_count(out_count);
 
     MMG5_int np, nt, nquad, na;
-    if (MMG2D_Get_meshSize(g_handles_2d[handle].mesh, &np, &nt, &nquad, &na) != 1)
+    if (MMG2D_Get_meshSize(HANDLE_2D(handle).mesh, &np, &nt, &nquad, &na) != 1)
         return fail_with_count(out_count);
 
     if (np == 0)
@@ -295,7 +628,7 @@ double* mmg2d_get_vertices(int handle, int* out_count) {
     ALLOC_OR_FAIL(required, np, int);
 
     int result = MMG2D_Get_vertices(
-        g_handles_2d[handle].mesh, vertices, refs, corners, required
+        HANDLE_2D(handle).mesh, vertices, refs, corners, required
     );
 
     free(refs);
@@ -330,12 +663,16 @@ int mmg2d_set_triangle(int handle, int v0, int v1, int v2, int ref, int pos) {
         return 0;
     }
 
-    return MMG2D_Set_triangle(
-        g_handles_2d[handle].mesh,
+    int result = MMG2D_Set_triangle(
+        HANDLE_2D(handle).mesh,
         (MMG5_int)v0, (MMG5_int)v1, (MMG5_int)v2,
         (MMG5_int)ref,
         (MMG5_int)pos
     );
+    if (result == 1) {
+        mark_modified_2d(handle);
+    }
+    return result;
 }
 
 /**
@@ -350,11 +687,15 @@ int mmg2d_set_triangles(int handle, int* tria, int* refs) {
         return 0;
     }
 
-    return MMG2D_Set_triangles(
-        g_handles_2d[handle].mesh,
+    int result = MMG2D_Set_triangles(
+        HANDLE_2D(handle).mesh,
         (MMG5_int*)tria,
         (MMG5_int*)refs
     );
+    if (result == 1) {
+        mark_modified_2d(handle);
+    }
+    return result;
 }
 
 /**
@@ -370,7 +711,7 @@ int* mmg2d_get_triangles(int handle, int* out_count) {
         return fail_with_count(out_count);
 
     MMG5_int np, nt, nquad, na;
-    if (MMG2D_Get_meshSize(g_handles_2d[handle].mesh, &np, &nt, &nquad, &na) != 1)
+    if (MMG2D_Get_meshSize(HANDLE_2D(handle).mesh, &np, &nt, &nquad, &na) != 1)
         return fail_with_count(out_count);
 
     if (nt == 0)
@@ -387,7 +728,7 @@ int* mmg2d_get_triangles(int handle, int* out_count) {
     ALLOC_OR_FAIL(required, nt, int);
 
     int result = MMG2D_Get_triangles(
-        g_handles_2d[handle].mesh, tria, refs, required
+        HANDLE_2D(handle).mesh, tria, refs, required
     );
 
     free(refs);
@@ -420,12 +761,16 @@ int mmg2d_set_edge(int handle, int v0, int v1, int ref, int pos) {
         return 0;
     }
 
-    return MMG2D_Set_edge(
-        g_handles_2d[handle].mesh,
+    int result = MMG2D_Set_edge(
+        HANDLE_2D(handle).mesh,
         (MMG5_int)v0, (MMG5_int)v1,
         (MMG5_int)ref,
         (MMG5_int)pos
     );
+    if (result == 1) {
+        mark_modified_2d(handle);
+    }
+    return result;
 }
 
 /**
@@ -440,11 +785,15 @@ int mmg2d_set_edges(int handle, int* edges, int* refs) {
         return 0;
     }
 
-    return MMG2D_Set_edges(
-        g_handles_2d[handle].mesh,
+    int result = MMG2D_Set_edges(
+        HANDLE_2D(handle).mesh,
         (MMG5_int*)edges,
         (MMG5_int*)refs
     );
+    if (result == 1) {
+        mark_modified_2d(handle);
+    }
+    return result;
 }
 
 /**
@@ -460,7 +809,7 @@ int* mmg2d_get_edges(int handle, int* out_count) {
         return fail_with_count(out_count);
 
     MMG5_int np, nt, nquad, na;
-    if (MMG2D_Get_meshSize(g_handles_2d[handle].mesh, &np, &nt, &nquad, &na) != 1)
+    if (MMG2D_Get_meshSize(HANDLE_2D(handle).mesh, &np, &nt, &nquad, &na) != 1)
         return fail_with_count(out_count);
 
     if (na == 0)
@@ -479,7 +828,7 @@ int* mmg2d_get_edges(int handle, int* out_count) {
     ALLOC_OR_FAIL(required, na, int);
 
     int result = MMG2D_Get_edges(
-        g_handles_2d[handle].mesh, edges, refs, ridges, required
+        HANDLE_2D(handle).mesh, edges, refs, ridges, required
     );
 
     free(refs);
@@ -513,12 +862,16 @@ int mmg2d_set_iparameter(int handle, int iparam, int val) {
         return 0;
     }
 
-    return MMG2D_Set_iparameter(
-        g_handles_2d[handle].mesh,
-        g_handles_2d[handle].sol,
+    /* Some parameters allocate (e.g. the local parameter array) */
+    MmgwasmArena* outer = mmgwasm_arena_enter(&HANDLE_2D(handle).arena);
+    int result = MMG2D_Set_iparameter(
+        HANDLE_2D(handle).mesh,
+        HANDLE_2D(handle).sol,
         iparam,
         (MMG5_int)val
     );
+    mmgwasm_arena_leave(outer);
+    return result;
 }
 
 /**
@@ -533,8 +886,8 @@ int mmg2d_set_dparameter(int handle, int dparam, double val) {
     }
 
     return MMG2D_Set_dparameter(
-        g_handles_2d[handle].mesh,
-        g_handles_2d[handle].sol,
+        HANDLE_2D(handle).mesh,
+        HANDLE_2D(handle).sol,
         dparam,
         val
     );
@@ -553,13 +906,16 @@ int mmg2d_set_sol_size(int handle, int typEntity, int np, int typSol) {
         return 0;
     }
 
-    return MMG2D_Set_solSize(
-        g_handles_2d[handle].mesh,
-        g_handles_2d[handle].sol,
+    MmgwasmArena* outer = mmgwasm_arena_enter(&HANDLE_2D(handle).arena);
+    int result = MMG2D_Set_solSize(
+        HANDLE_2D(handle).mesh,
+        HANDLE_2D(handle).sol,
         typEntity,
         (MMG5_int)np,
         typSol
     );
+    mmgwasm_arena_leave(outer);
+    return result;
 }
 
 /**
@@ -577,8 +933,8 @@ int mmg2d_get_sol_size(int handle, int* typEntity, int* np, int* typSol) {
     int _typEntity, _typSol;
 
     int result = MMG2D_Get_solSize(
-        g_handles_2d[handle].mesh,
-        g_handles_2d[handle].sol,
+        HANDLE_2D(handle).mesh,
+        HANDLE_2D(handle).sol,
         &_typEntity,
         &_np,
         &_typSol
@@ -604,7 +960,7 @@ int mmg2d_set_scalar_sols(int handle, double* values) {
         return 0;
     }
 
-    return MMG2D_Set_scalarSols(g_handles_2d[handle].sol, values);
+    return MMG2D_Set_scalarSols(HANDLE_2D(handle).sol, values);
 }
 
 /**
@@ -624,7 +980,7 @@ double* mmg2d_get_scalar_sols(int handle, int* out_count) {
     /* Get solution size to determine number of entities */
     int typEntity, typSol;
     MMG5_int np;
-    if (MMG2D_Get_solSize(g_handles_2d[handle].mesh, g_handles_2d[handle].sol,
+    if (MMG2D_Get_solSize(HANDLE_2D(handle).mesh, HANDLE_2D(handle).sol,
                           &typEntity, &np, &typSol) != 1) {
         if (out_count) *out_count = 0;
         return NULL;
@@ -642,7 +998,7 @@ double* mmg2d_get_scalar_sols(int handle, int* out_count) {
         return NULL;
     }
 
-    int result = MMG2D_Get_scalarSols(g_handles_2d[handle].sol, values);
+    int result = MMG2D_Get_scalarSols(HANDLE_2D(handle).sol, values);
     if (result != 1) {
         free(values);
         if (out_count) *out_count = 0;
@@ -664,7 +1020,54 @@ int mmg2d_set_tensor_sols(int handle, double* values) {
         return 0;
     }
 
-    return MMG2D_Set_tensorSols(g_handles_2d[handle].sol, values);
+    return MMG2D_Set_tensorSols(HANDLE_2D(handle).sol, values);
+}
+
+/**
+ * Import a whole mesh from a packed descriptor (see import.h): sizes the
+ * mesh, sets vertices, triangles, boundary edges and their references,
+ * and fills the metric when one is given (metric_size 1 or 3).
+ * Returns 1 on success, 0 on failure.
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg2d_import_mesh(int handle, const MmgwasmMeshImport* desc) {
+    if (!validate_handle_2d(handle) || !desc || desc->np < 0 || desc->ne < 0 ||
+        desc->nb < 0 || (desc->np > 0 && !desc->vertices) ||
+        (desc->ne > 0 && !desc->cells) || (desc->nb > 0 && !desc->boundary) ||
+        (desc->metric_size != 0 && desc->metric_size != 1 &&
+         desc->metric_size != 3) ||
+        (desc->metric_size != 0 && (!desc->metric || desc->np == 0))) {
+        return 0;
+    }
+
+    MMG5_pMesh mesh = HANDLE_2D(handle).mesh;
+    MMG5_pSol sol = HANDLE_2D(handle).sol;
+    MmgwasmArena* outer = mmgwasm_arena_enter(&HANDLE_2D(handle).arena);
+    int result = MMG2D_Set_meshSize(mesh, desc->np, desc->ne, 0,
+                                    desc->nb) == 1;
+    if (result && desc->np > 0) {
+        result = MMG2D_Set_vertices(mesh, (double*)desc->vertices,
+                                    (MMG5_int*)desc->vertex_refs) == 1;
+    }
+    if (result && desc->ne > 0) {
+        result = MMG2D_Set_triangles(mesh, (MMG5_int*)desc->cells,
+                                      (MMG5_int*)desc->cell_refs) == 1;
+    }
+    if (result && desc->nb > 0) {
+        result = MMG2D_Set_edges(mesh, (MMG5_int*)desc->boundary,
+                                 (MMG5_int*)desc->boundary_refs) == 1;
+    }
+    if (result && desc->metric_size != 0) {
+        int scalar = desc->metric_size == 1;
+        result = MMG2D_Set_solSize(mesh, sol, MMG5_Vertex, desc->np,
+                                   scalar ? MMG5_Scalar : MMG5_Tensor) == 1 &&
+            (scalar ? MMG2D_Set_scalarSols(sol, (double*)desc->metric)
+                    : MMG2D_Set_tensorSols(sol, (double*)desc->metric)) == 1;
+    }
+    mmgwasm_arena_leave(outer);
+
+    mark_modified_2d(handle);  /* a failed import may leave a partial mesh */
+    return result;
 }
 
 /**
@@ -684,7 +1087,7 @@ double* mmg2d_get_tensor_sols(int handle, int* out_count) {
     /* Get solution size to determine number of entities */
     int typEntity, typSol;
     MMG5_int np;
-    if (MMG2D_Get_solSize(g_handles_2d[handle].mesh, g_handles_2d[handle].sol,
+    if (MMG2D_Get_solSize(HANDLE_2D(handle).mesh, HANDLE_2D(handle).sol,
                           &typEntity, &np, &typSol) != 1) {
         if (out_count) *out_count = 0;
         return NULL;
@@ -702,7 +1105,7 @@ double* mmg2d_get_tensor_sols(int handle, int* out_count) {
         return NULL;
     }
 
-    int result = MMG2D_Get_tensorSols(g_handles_2d[handle].sol, values);
+    int result = MMG2D_Get_tensorSols(HANDLE_2D(handle).sol, values);
     if (result != 1) {
         free(values);
         if (out_count) *out_count = 0;
@@ -714,128 +1117,535 @@ double* mmg2d_get_tensor_sols(int handle, int* out_count) {
 }
 
 /**
- * Run the MMG2D remeshing algorithm.
- * Returns MMG5_SUCCESS (0) on success, or an error code.
+ * Evaluate local sizing constraints into a scalar metric, in a single pass
+ * over the vertices that writes straight into the solution.
+ * constraints: count packed constraints of MMGWASM_SIZING_STRIDE doubles
+ * (see sizing.h). Vertices outside every region get a default size.
+ * Replaces any previous solution.
+ * Returns 1 on success, 0 on failure.
  */
 EMSCRIPTEN_KEEPALIVE
-int mmg2d_remesh(int handle) {
+int mmg2d_apply_sizing(int handle, const double* constraints, int count) {
     if (!validate_handle_2d(handle)) {
-        return -1;
+        return 0;
     }
 
-    return MMG2D_mmg2dlib(
-        g_handles_2d[handle].mesh,
-        g_handles_2d[handle].sol
-    );
+    MMG5_pMesh mesh = HANDLE_2D(handle).mesh;
+    MMG5_pSol sol = HANDLE_2D(handle).sol;
+    MmgwasmArena* outer = mmgwasm_arena_enter(&HANDLE_2D(handle).arena);
+    int sized = mesh->np > 0 &&
+        MMG2D_Set_solSize(mesh, sol, MMG5_Vertex, mesh->np, MMG5_Scalar) == 1;
+    mmgwasm_arena_leave(outer);
+    if (!sized) {
+        return 0;
+    }
+    return mmgwasm_sizing_apply(constraints, count, 2, mesh->point[1].c,
+                                sizeof(MMG5_Point), (int)mesh->np, &sol->m[1]);
 }
 
-/**
- * Free an array returned by mmg2d_get_* functions.
+/*
+ * Whether any vertex, edge or triangle is tagged required, as the getters
+ * report it (a triangle when all its edges are), read from the tags so that
+ * the getters' counters stay where they were.
  */
-EMSCRIPTEN_KEEPALIVE
-void mmg2d_free_array(void* ptr) {
-    if (ptr) {
-        free(ptr);
+static int has_required_2d(MMG5_pMesh mesh) {
+    for (MMG5_int k = 1; k <= mesh->np; k++) {
+        if (mesh->point[k].tag & MG_REQ) {
+            return 1;
+        }
+    }
+    for (MMG5_int k = 1; k <= mesh->na; k++) {
+        if (mesh->edge[k].tag & MG_REQ) {
+            return 1;
+        }
+    }
+    for (MMG5_int k = 1; k <= mesh->nt; k++) {
+        const int16_t* tag = mesh->tria[k].tag;
+        if ((tag[0] & MG_REQ) && (tag[1] & MG_REQ) && (tag[2] & MG_REQ)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Whether none of the n vertices v lies in a local region */
+static int outside(const unsigned char* inside, const MMG5_int* v, int n) {
+    for (int j = 0; j < n; j++) {
+        if (inside[v[j] - 1]) {
+            return 0;
+        }
     }
+    return 1;
 }
 
 /**
- * Load a mesh from a file in the virtual filesystem.
- * @param handle - The mesh handle
- * @param filename - Path to the mesh file in the virtual filesystem
- * @returns 1 on success, 0 on failure
+ * Prepare a local remesh: tag as required every triangle and edge with no
+ * vertex inside the given regions, grown by margin, so MMG2D only reworks
+ * the elements around them.
+ * regions: count packed constraints of MMGWASM_SIZING_STRIDE doubles
+ * (see sizing.h), usually the sizing constraints of the remesh.
+ * The tags are cleared by mmg2d_thaw, which cannot tell them apart from
+ * the user's, so meshes with required entities are refused.
+ * Returns the number of frozen triangles, -2 if the mesh already has
+ * required entities, -1 on failure.
  */
 EMSCRIPTEN_KEEPALIVE
-int mmg2d_load_mesh(int handle, const char* filename) {
+int mmg2d_freeze_outside(int handle, const double* regions, int count,
+                         double margin) {
     if (!validate_handle_2d(handle)) {
+        return -1;
+    }
+
+    MMG5_pMesh mesh = HANDLE_2D(handle).mesh;
+    if (mesh->np == 0) {
         return 0;
     }
-    return MMG2D_loadMesh(g_handles_2d[handle].mesh, filename);
+    if (has_required_2d(mesh)) {
+        return -2;
+    }
+
+    unsigned char* inside = (unsigned char*)malloc((size_t)mesh->np);
+    if (!inside) {
+        return -1;
+    }
+    if (!mmgwasm_sizing_contains(regions, count, 2, mesh->point[1].c,
+                                 sizeof(MMG5_Point), (int)mesh->np, margin,
+                                 inside)) {
+        free(inside);
+        return -1;
+    }
+
+    int frozen = 0;
+    for (MMG5_int k = 1; k <= mesh->nt; k++) {
+        if (outside(inside, mesh->tria[k].v, 3)) {
+            MMG2D_Set_requiredTriangle(mesh, k);
+            frozen++;
+        }
+    }
+    for (MMG5_int k = 1; k <= mesh->na; k++) {
+        const MMG5_int v[2] = {mesh->edge[k].a, mesh->edge[k].b};
+        if (outside(inside, v, 2)) {
+            MMG2D_Set_requiredEdge(mesh, k);
+        }
+    }
+    free(inside);
+    return frozen;
 }
 
 /**
- * Save a mesh to a file in the virtual filesystem.
- * @param handle - The mesh handle
- * @param filename - Path to save the mesh file in the virtual filesystem
- * @returns 1 on success, 0 on failure
+ * Clear the required tags of every entity after a local remesh, including
+ * any MMG2D propagated from the frozen elements to their vertices, so the
+ * result remeshes freely afterwards.
+ * Returns 1 on success, 0 on failure.
  */
 EMSCRIPTEN_KEEPALIVE
-int mmg2d_save_mesh(int handle, const char* filename) {
+int mmg2d_thaw(int handle) {
     if (!validate_handle_2d(handle)) {
         return 0;
     }
-    return MMG2D_saveMesh(g_handles_2d[handle].mesh, filename);
+
+    MMG5_pMesh mesh = HANDLE_2D(handle).mesh;
+    for (MMG5_int k = 1; k <= mesh->np; k++) {
+        MMG2D_Unset_requiredVertex(mesh, k);
+    }
+    for (MMG5_int k = 1; k <= mesh->na; k++) {
+        MMG2D_Unset_requiredEdge(mesh, k);
+    }
+    for (MMG5_int k = 1; k <= mesh->nt; k++) {
+        MMG2D_Unset_requiredTriangle(mesh, k);
+    }
+    return 1;
 }
 
-/**
- * Load a solution from a file in the virtual filesystem.
- * @param handle - The mesh handle
- * @param filename - Path to the solution file in the virtual filesystem
- * @returns 1 on success, 0 on failure
+/*
+ * Phase hooks (see progress.h), linked with -Wl,--wrap over the functions
+ * MMG2D_mmg2dlib runs its analysis and meshing phases with. MMG2D runs its
+ * wavefronts inside the translation unit of the meshing phase, out of reach
+ * of the linker, so an abort is only seen between phases. A hook that sees
+ * the abort flag returns the failure value of the function it replaces,
+ * which MMG2D_mmg2dlib handles by unscaling and packing the mesh before
+ * returning MMG5_LOWFAILURE. The declarations take the prototypes of MMG's
+ * private header, so a signature change fails to compile.
  */
-EMSCRIPTEN_KEEPALIVE
-int mmg2d_load_sol(int handle, const char* filename) {
-    if (!validate_handle_2d(handle)) {
+__typeof__(MMG2D_analys) __real_MMG2D_analys, __wrap_MMG2D_analys;
+__typeof__(MMG2D_mmg2d1n) __real_MMG2D_mmg2d1n, __wrap_MMG2D_mmg2d1n;
+
+int __wrap_MMG2D_analys(MMG5_pMesh mesh) {
+    if (!mmgwasm_progress_enter(MMGWASM_PHASE_ANALYSIS)) {
         return 0;
     }
-    return MMG2D_loadSol(g_handles_2d[handle].mesh, g_handles_2d[handle].sol, filename);
+    int ier = __real_MMG2D_analys(mesh);
+    mmgwasm_progress_leave(MMGWASM_PHASE_ANALYSIS);
+    return ier;
 }
 
-/**
- * Save a solution to a file in the virtual filesystem.
- * @param handle - The mesh handle
- * @param filename - Path to save the solution file in the virtual filesystem
- * @returns 1 on success, 0 on failure
- */
-EMSCRIPTEN_KEEPALIVE
-int mmg2d_save_sol(int handle, const char* filename) {
-    if (!validate_handle_2d(handle)) {
+int __wrap_MMG2D_mmg2d1n(MMG5_pMesh mesh, MMG5_pSol met) {
+    if (!mmgwasm_progress_enter(MMGWASM_PHASE_MESHING)) {
         return 0;
     }
-    return MMG2D_saveSol(g_handles_2d[handle].mesh, g_handles_2d[handle].sol, filename);
+    int ier = __real_MMG2D_mmg2d1n(mesh, met);
+    mmgwasm_progress_leave(MMGWASM_PHASE_MESHING);
+    return ier;
 }
 
-/**
- * Get the quality of a single triangle.
- * @param handle - The mesh handle
- * @param k - The triangle index (1-indexed, MMG convention)
- * @returns Quality value between 0 (degenerate) and 1 (best), or 0 on failure
+/*
+ * Run MMG2D on a handle inside the remesh gate (see threads.h).
+ * Tensor metrics select MMG's anisotropic kernels, which must not overlap
+ * with isotropic runs.
+ * When progress tracking is enabled, an abort stops MMG2D at its next phase
+ * hook, and the run returns MMGWASM_REMESH_ABORTED with the mesh MMG2D
+ * returned (see progress.h).
  */
-EMSCRIPTEN_KEEPALIVE
-double mmg2d_get_triangle_quality(int handle, int k) {
-    if (!validate_handle_2d(handle)) {
-        return 0.0;
+static int run_remesh_2d(int handle) {
+    MMG5_pMesh mesh = HANDLE_2D(handle).mesh;
+    MMG5_pSol sol = HANDLE_2D(handle).sol;
+    int aniso = sol && sol->size == 3;
+    int result = MMGWASM_REMESH_ABORTED;
+
+    MmgwasmArena* outer = mmgwasm_arena_enter(&HANDLE_2D(handle).arena);
+    mmgwasm_remesh_enter(MMGWASM_GATE_KEY(MMGWASM_GATE_2D, aniso));
+    HandleEntry2D* entry = &HANDLE_2D(handle);
+    if (mmgwasm_progress_begin(&entry->progress, &entry->stats,
+                               &mesh->info.imprim)) {
+        result = MMG2D_mmg2dlib(mesh, sol);
+        if (mmgwasm_progress_end()) {
+            result = MMGWASM_REMESH_ABORTED;
+        }
     }
-    return MMG2D_Get_triangleQuality(
-        g_handles_2d[handle].mesh,
-        g_handles_2d[handle].sol,
-        (MMG5_int)k
-    );
+    mmgwasm_remesh_leave();
+    mmgwasm_arena_leave(outer);
+
+    mark_modified_2d(handle);  /* the mesh may be modified even on failure */
+    return result;
 }
 
 /**
- * Get quality values for all triangles.
- * Allocates and returns a pointer to the quality array.
- * out_count receives the number of triangles.
- * Caller must free the returned pointer using mmg2d_free_array.
- * Returns NULL on failure.
+ * Run the MMG2D remeshing algorithm.
+ * Returns MMG5_SUCCESS (0) on success, or an error code
+ * (MMGWASM_REMESH_ABORTED if aborted through the progress record).
  */
 EMSCRIPTEN_KEEPALIVE
-double* mmg2d_get_triangles_qualities(int handle, int* out_count) {
+int mmg2d_remesh(int handle) {
     if (!validate_handle_2d(handle)) {
-        if (out_count) *out_count = 0;
-        return NULL;
+        return -1;
     }
 
-    MMG5_int np, nt, nquad, na;
-    if (MMG2D_Get_meshSize(g_handles_2d[handle].mesh, &np, &nt, &nquad, &na) != 1) {
-        if (out_count) *out_count = 0;
-        return NULL;
+    MMGWASM_LOCK(g_handles_lock_2d);
+    int busy = HANDLE_2D(handle).busy;
+    MMGWASM_UNLOCK(g_handles_lock_2d);
+    if (busy) {
+        return -1;  /* An asynchronous remesh is running on this handle */
     }
 
-    if (nt == 0) {
-        if (out_count) *out_count = 0;
-        return NULL;
+    mmgwasm_progress_reset(&HANDLE_2D(handle).progress);
+    return run_remesh_2d(handle);
+}
+
+#ifdef __EMSCRIPTEN_PTHREADS__
+/* Worker thread body for mmg2d_remesh_async */
+static void* remesh_thread_2d(void* arg) {
+    int handle = (int)(intptr_t)arg;
+    int result = run_remesh_2d(handle);
+
+    MMGWASM_LOCK(g_handles_lock_2d);
+    HANDLE_2D(handle).async_result = result;
+    HANDLE_2D(handle).busy = 0;
+    MMGWASM_UNLOCK(g_handles_lock_2d);
+    return NULL;
+}
+#endif
+
+/**
+ * Start remeshing a handle without blocking the caller.
+ * In the pthreads build the remesh runs on a worker thread from the pool, so
+ * several handles can be remeshed at once in the same heap; otherwise it runs
+ * synchronously before returning. Poll mmg2d_remesh_status for completion.
+ * The handle must not be used or freed until the remesh has finished.
+ * Returns 1 if the remesh was started, 0 on failure (invalid or busy handle).
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg2d_remesh_async(int handle) {
+    if (!validate_handle_2d(handle)) {
+        return 0;
+    }
+
+    MMGWASM_LOCK(g_handles_lock_2d);
+    if (HANDLE_2D(handle).busy) {
+        MMGWASM_UNLOCK(g_handles_lock_2d);
+        return 0;
+    }
+    HANDLE_2D(handle).busy = 1;
+    HANDLE_2D(handle).async_result = MMGWASM_REMESH_RUNNING;
+    mmgwasm_progress_reset(&HANDLE_2D(handle).progress);
+    MMGWASM_UNLOCK(g_handles_lock_2d);
+
+#ifdef __EMSCRIPTEN_PTHREADS__
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, remesh_thread_2d, (void*)(intptr_t)handle) == 0) {
+        pthread_detach(thread);
+        return 1;
+    }
+    /* Thread creation failed, fall back to running inline */
+#endif
+
+    int result = run_remesh_2d(handle);
+
+    MMGWASM_LOCK(g_handles_lock_2d);
+    HANDLE_2D(handle).async_result = result;
+    HANDLE_2D(handle).busy = 0;
+    MMGWASM_UNLOCK(g_handles_lock_2d);
+    return 1;
+}
+
+/**
+ * Get the state of the last asynchronous remesh of a handle.
+ * Returns MMGWASM_REMESH_RUNNING (-2) while it is running, its MMG return
+ * code once finished, or -1 for an invalid handle or if none was started.
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg2d_remesh_status(int handle) {
+    if (!validate_handle_2d(handle)) {
+        return -1;
+    }
+
+    MMGWASM_LOCK(g_handles_lock_2d);
+    int status = HANDLE_2D(handle).busy
+        ? MMGWASM_REMESH_RUNNING
+        : HANDLE_2D(handle).async_result;
+    MMGWASM_UNLOCK(g_handles_lock_2d);
+    return status;
+}
+
+/**
+ * Get the progress record of a handle (see progress.h).
+ * Set its enabled field to track the next remeshes of the handle and its
+ * abort field to cancel a running one. The record keeps its address for the
+ * lifetime of the handle.
+ * Returns NULL for an invalid handle.
+ */
+EMSCRIPTEN_KEEPALIVE
+MmgwasmProgress* mmg2d_get_progress(int handle) {
+    if (!validate_handle_2d(handle)) {
+        return NULL;
+    }
+    return &HANDLE_2D(handle).progress;
+}
+
+/**
+ * Copy the statistics of the last remesh of a handle to out (see stats.h).
+ * Returns 1 on success, 0 for an invalid handle or a build without
+ * instrumentation (MMG_WASM_STATS).
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg2d_get_stats(int handle, MmgwasmStats* out) {
+    if (!MMGWASM_STATS_ENABLED || !validate_handle_2d(handle) || !out) {
+        return 0;
+    }
+    *out = HANDLE_2D(handle).stats;
+    return 1;
+}
+
+/**
+ * Free an array returned by mmg2d_get_* functions.
+ */
+EMSCRIPTEN_KEEPALIVE
+void mmg2d_free_array(void* ptr) {
+    if (ptr) {
+        free(ptr);
+    }
+}
+
+/**
+ * Load a mesh from a file in the virtual filesystem.
+ * @param handle - The mesh handle
+ * @param filename - Path to the mesh file in the virtual filesystem
+ * @returns 1 on success, 0 on failure
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg2d_load_mesh(int handle, const char* filename) {
+    if (!validate_handle_2d(handle)) {
+        return 0;
+    }
+    MmgwasmArena* outer = mmgwasm_arena_enter(&HANDLE_2D(handle).arena);
+    int result = MMG2D_loadMesh(HANDLE_2D(handle).mesh, filename);
+    mmgwasm_arena_leave(outer);
+    mark_modified_2d(handle);  /* a failed load may leave a partial mesh */
+    return result;
+}
+
+/**
+ * Load a mesh from an in-memory file (see memfile.h), without going through
+ * the virtual filesystem.
+ * @param handle - The mesh handle
+ * @param file - Memfile holding the mesh file contents
+ * @param binary - 1 for the .meshb format, 0 for .mesh
+ * @returns 1 on success, 0 on failure
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg2d_load_mesh_from_memfile(int handle, MmgwasmMemFile* file, int binary) {
+    if (!validate_handle_2d(handle) || !file || file->size == 0) {
+        return 0;
+    }
+    mmgwasm_memfile_attach(file);
+    MmgwasmArena* outer = mmgwasm_arena_enter(&HANDLE_2D(handle).arena);
+    int result = MMG2D_loadMesh(HANDLE_2D(handle).mesh,
+        binary ? MMGWASM_MEMFILE_PATH ".meshb" : MMGWASM_MEMFILE_PATH ".mesh");
+    mmgwasm_arena_leave(outer);
+    mmgwasm_memfile_attach(NULL);
+    mark_modified_2d(handle);  /* a failed load may leave a partial mesh */
+    return result;
+}
+
+/**
+ * Save a mesh to a file in the virtual filesystem.
+ * @param handle - The mesh handle
+ * @param filename - Path to save the mesh file in the virtual filesystem
+ * @returns 1 on success, 0 on failure
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg2d_save_mesh(int handle, const char* filename) {
+    if (!validate_handle_2d(handle)) {
+        return 0;
+    }
+    return MMG2D_saveMesh(HANDLE_2D(handle).mesh, filename);
+}
+
+/**
+ * Save a mesh into an in-memory file (see memfile.h), replacing its contents.
+ * The bytes are serialized straight into the heap and read back through
+ * mmgwasm_memfile_data/mmgwasm_memfile_size.
+ * @param handle - The mesh handle
+ * @param file - Memfile receiving the mesh file contents
+ * @param binary - 1 for the .meshb format, 0 for .mesh
+ * @returns 1 on success, 0 on failure
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg2d_save_mesh_to_memfile(int handle, MmgwasmMemFile* file, int binary) {
+    if (!validate_handle_2d(handle) || !file) {
+        return 0;
+    }
+    mmgwasm_memfile_attach(file);
+    int result = MMG2D_saveMesh(HANDLE_2D(handle).mesh,
+        binary ? MMGWASM_MEMFILE_PATH ".meshb" : MMGWASM_MEMFILE_PATH ".mesh");
+    mmgwasm_memfile_attach(NULL);
+    return result;
+}
+
+/**
+ * Load a solution from a file in the virtual filesystem.
+ * @param handle - The mesh handle
+ * @param filename - Path to the solution file in the virtual filesystem
+ * @returns 1 on success, 0 on failure
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg2d_load_sol(int handle, const char* filename) {
+    if (!validate_handle_2d(handle)) {
+        return 0;
+    }
+    MmgwasmArena* outer = mmgwasm_arena_enter(&HANDLE_2D(handle).arena);
+    int result = MMG2D_loadSol(HANDLE_2D(handle).mesh, HANDLE_2D(handle).sol,
+        filename);
+    mmgwasm_arena_leave(outer);
+    return result;
+}
+
+/**
+ * Load a solution from an in-memory file (see memfile.h), without going
+ * through the virtual filesystem.
+ * @param handle - The mesh handle
+ * @param file - Memfile holding the solution file contents
+ * @param binary - 1 for the .solb format, 0 for .sol
+ * @returns 1 on success, 0 on failure
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg2d_load_sol_from_memfile(int handle, MmgwasmMemFile* file, int binary) {
+    if (!validate_handle_2d(handle) || !file || file->size == 0) {
+        return 0;
+    }
+    mmgwasm_memfile_attach(file);
+    MmgwasmArena* outer = mmgwasm_arena_enter(&HANDLE_2D(handle).arena);
+    int result = MMG2D_loadSol(HANDLE_2D(handle).mesh, HANDLE_2D(handle).sol,
+        binary ? MMGWASM_MEMFILE_PATH ".solb" : MMGWASM_MEMFILE_PATH ".sol");
+    mmgwasm_arena_leave(outer);
+    mmgwasm_memfile_attach(NULL);
+    return result;
+}
+
+/**
+ * Save a solution to a file in the virtual filesystem.
+ * @param handle - The mesh handle
+ * @param filename - Path to save the solution file in the virtual filesystem
+ * @returns 1 on success, 0 on failure
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg2d_save_sol(int handle, const char* filename) {
+    if (!validate_handle_2d(handle)) {
+        return 0;
+    }
+    return MMG2D_saveSol(HANDLE_2D(handle).mesh, HANDLE_2D(handle).sol, filename);
+}
+
+/**
+ * Save the solution into an in-memory file (see memfile.h), replacing its
+ * contents.
+ * @param handle - The mesh handle
+ * @param file - Memfile receiving the solution file contents
+ * @param binary - 1 for the .solb format, 0 for .sol
+ * @returns 1 on success, 0 on failure
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg2d_save_sol_to_memfile(int handle, MmgwasmMemFile* file, int binary) {
+    if (!validate_handle_2d(handle) || !file) {
+        return 0;
+    }
+    mmgwasm_memfile_attach(file);
+    int result = MMG2D_saveSol(HANDLE_2D(handle).mesh, HANDLE_2D(handle).sol,
+        binary ? MMGWASM_MEMFILE_PATH ".solb" : MMGWASM_MEMFILE_PATH ".sol");
+    mmgwasm_memfile_attach(NULL);
+    return result;
+}
+
+/**
+ * Get the quality of a single triangle.
+ * @param handle - The mesh handle
+ * @param k - The triangle index (1-indexed, MMG convention)
+ * @returns Quality value between 0 (degenerate) and 1 (best), or 0 on failure
+ */
+EMSCRIPTEN_KEEPALIVE
+double mmg2d_get_triangle_quality(int handle, int k) {
+    if (!validate_handle_2d(handle)) {
+        return 0.0;
+    }
+    return MMG2D_Get_triangleQuality(
+        HANDLE_2D(handle).mesh,
+        HANDLE_2D(handle).sol,
+        (MMG5_int)k
+    );
+}
+
+/**
+ * Get quality values for all triangles.
+ * Allocates and returns a pointer to the quality array.
+ * out_count receives the number of triangles.
+ * Caller must free the returned pointer using mmg2d_free_array.
+ * Returns NULL on failure.
+ */
+EMSCRIPTEN_KEEPALIVE
+double* mmg2d_get_triangles_qualities(int handle, int* out_count) {
+    if (!validate_handle_2d(handle)) {
+        if (out_count) *out_count = 0;
+        return NULL;
+    }
+
+    MMG5_int np, nt, nquad, na;
+    if (MMG2D_Get_meshSize(HANDLE_2D(handle).mesh, &np, &nt, &nquad, &na) != 1) {
+        if (out_count) *out_count = 0;
+        return NULL;
+    }
+
+    if (nt == 0) {
+        if (out_count) *out_count = 0;
+        return NULL;
     }
 
     /* Allocate output array */
@@ -848,8 +1658,8 @@ double* mmg2d_get_triangles_qualities(int handle, int* out_count) {
     /* Get quality for each triangle (1-indexed) */
     for (MMG5_int k = 1; k <= nt; k++) {
         qualities[k - 1] = MMG2D_Get_triangleQuality(
-            g_handles_2d[handle].mesh,
-            g_handles_2d[handle].sol,
+            HANDLE_2D(handle).mesh,
+            HANDLE_2D(handle).sol,
             k
         );
     }
@@ -857,3 +1667,531 @@ double* mmg2d_get_triangles_qualities(int handle, int* out_count) {
     if (out_count) *out_count = (int)nt;
     return qualities;
 }
+
+/*
+ * Quality statistics written by mmg2d_get_quality_stats.
+ * The layout (32 bytes) is mirrored by the TypeScript bindings.
+ */
+typedef struct {
+    double min;
+    double max;
+    double mean;
+    int count;   /* number of triangles */
+    int nbins;   /* number of histogram bins filled */
+} QualityStats;
+
+/**
+ * Compute quality statistics for all triangles in a single pass.
+ * stats receives min/max/mean over all triangles (all 0 for an empty mesh).
+ * histogram (optional, may be NULL when nbins is 0) receives nbins counts for
+ * uniform quality bins over [0, 1]; a quality of exactly 1 goes in the last bin.
+ * No intermediate array is allocated.
+ * Returns 1 on success, 0 on failure.
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg2d_get_quality_stats(int handle, int nbins, QualityStats* stats, int* histogram) {
+    if (!validate_handle_2d(handle) || !stats || nbins < 0 || (nbins > 0 && !histogram)) {
+        return 0;
+    }
+
+    MMG5_pMesh mesh = HANDLE_2D(handle).mesh;
+    MMG5_pSol sol = HANDLE_2D(handle).sol;
+    MMG5_int ne = mesh->tria ? mesh->nt : 0;
+
+    memset(stats, 0, sizeof(*stats));
+    if (nbins > 0) {
+        memset(histogram, 0, (size_t)nbins * sizeof(int));
+    }
+    stats->nbins = nbins;
+
+    if (ne == 0) {
+        return 1;
+    }
+
+    double min = 1.0e300, max = -1.0e300, sum = 0.0;
+    for (MMG5_int k = 1; k <= ne; k++) {
+        double q = MMG2D_Get_triangleQuality(mesh, sol, k);
+        if (q < min) min = q;
+        if (q > max) max = q;
+        sum += q;
+
+        if (nbins > 0) {
+            int bin = (int)(q * nbins);
+            if (bin < 0) bin = 0;
+            if (bin >= nbins) bin = nbins - 1;
+            histogram[bin]++;
+        }
+    }
+
+    stats->min = min;
+    stats->max = max;
+    stats->mean = sum / (double)ne;
+    stats->count = (int)ne;
+
+    return 1;
+}
+
+/*
+ * Point location
+ *
+ * Points are located through an element hierarchy kept in the handle (see
+ * locate.h). It is built by the first query and reused until the mesh is
+ * modified.
+ */
+
+/* Element arrays of a mesh, read in place by the locator */
+static MmgwasmElements mesh_elements(MMG5_pMesh mesh) {
+    MmgwasmElements elements = {2, 3, NULL, sizeof(MMG5_Point),
+                                NULL, sizeof(MMG5_Tria), 0};
+    if (mesh->point && mesh->tria && mesh->nt > 0) {
+        elements.coords = mesh->point[1].c;
+        elements.elems = mesh->tria[1].v;
+        elements.nelem = (int)mesh->nt;
+    }
+    return elements;
+}
+
+/* Locator of a handle, rebuilt if the mesh changed, NULL on failure */
+static const MmgwasmLocator* get_locator(int handle, MmgwasmElements* elements) {
+    HandleEntry2D* entry = &HANDLE_2D(handle);
+    *elements = mesh_elements(entry->mesh);
+    if (entry->locator.generation != entry->generation) {
+        if (!mmgwasm_locator_build(&entry->locator, elements)) {
+            return NULL;
+        }
+        entry->locator.generation = entry->generation;
+    }
+    return &entry->locator;
+}
+
+/**
+ * Locate n points (2 coordinates each) in the mesh, finding the triangle
+ * containing each point.
+ * out_elements receives n 1-indexed triangles, 0 outside the mesh.
+ * out_bary, if not NULL, receives 3 barycentric coordinates per point.
+ * Returns the number of points located, or -1 on failure.
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg2d_locate_points(int handle, const double* points, int n,
+                        int* out_elements, double* out_bary) {
+    if (!validate_handle_2d(handle) || n < 0 || (n > 0 && (!points || !out_elements))) {
+        return -1;
+    }
+
+    MmgwasmElements elements;
+    const MmgwasmLocator* locator = get_locator(handle, &elements);
+    if (!locator) {
+        return -1;
+    }
+
+    int located = 0;
+    for (int i = 0; i < n; i++) {
+        double* bary = out_bary ? out_bary + (size_t)i * 3 : NULL;
+        out_elements[i] = mmgwasm_locate(locator, &elements,
+                                         points + (size_t)i * 2, bary);
+        located += out_elements[i] != 0;
+    }
+    return located;
+}
+
+/**
+ * Interpolate the solution at n points (2 coordinates each), linearly in
+ * the triangle containing each point.
+ * out receives n * (solution size) values, NaN for points outside the mesh.
+ * Returns the number of points located, or -1 on failure (no vertex solution).
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg2d_sample_sol(int handle, const double* points, int n, double* out) {
+    if (!validate_handle_2d(handle) || n < 0 || (n > 0 && (!points || !out))) {
+        return -1;
+    }
+
+    MMG5_pMesh mesh = HANDLE_2D(handle).mesh;
+    MMG5_pSol sol = HANDLE_2D(handle).sol;
+    if (!sol || !sol->m || sol->size <= 0 || sol->np != mesh->np) {
+        return -1;
+    }
+
+    MmgwasmElements elements;
+    const MmgwasmLocator* locator = get_locator(handle, &elements);
+    if (!locator) {
+        return -1;
+    }
+    return mmgwasm_locate_sample(locator, &elements, &sol->m[sol->size],
+                                 sol->size, points, n, out);
+}
+
+/**
+ * Interpolate user fields from the vertices of source onto the vertices of
+ * handle, typically from a mesh kept from before a remesh onto its result.
+ * values: stride doubles per source vertex (fields interleaved per vertex).
+ * out receives stride doubles per vertex of handle. Vertices outside the
+ * source mesh take the values of its closest point.
+ * Returns 1 on success, 0 on failure.
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg2d_interpolate_fields(int handle, int source, const double* values,
+                             int stride, double* out) {
+    if (!validate_handle_2d(handle) || !validate_handle_2d(source) || stride <= 0 ||
+        !values || !out) {
+        return 0;
+    }
+
+    MMG5_pMesh mesh = HANDLE_2D(handle).mesh;
+    if (!mesh->point || mesh->np == 0) {
+        return 0;
+    }
+    MmgwasmElements elements;
+    const MmgwasmLocator* locator = get_locator(source, &elements);
+    if (!locator) {
+        return 0;
+    }
+    return mmgwasm_locate_transfer(locator, &elements, values, stride,
+                                   mesh->point[1].c, sizeof(MMG5_Point),
+                                   (int)mesh->np, out);
+}
+
+/*
+ * Zero-copy views
+ *
+ * The view_* functions pack mesh data into a buffer owned by the handle and
+ * return a pointer into it, so JavaScript can wrap the result in a typed-array
+ * subarray of the WASM heap without copying. Repeated calls are free while the
+ * mesh is unchanged. The pointer stays valid until the mesh is modified (see
+ * mmg2d_get_generation) or the handle is freed; it must NOT be passed to
+ * mmg2d_free_array.
+ */
+
+/**
+ * Get the modification generation of a mesh.
+ * The value changes whenever the mesh is modified or remeshed, which
+ * invalidates views obtained earlier.
+ * Returns a non-zero generation, or 0 for an invalid handle.
+ */
+EMSCRIPTEN_KEEPALIVE
+unsigned int mmg2d_get_generation(int handle) {
+    if (!validate_handle_2d(handle)) {
+        return 0;
+    }
+    return HANDLE_2D(handle).generation;
+}
+
+/**
+ * Get a view of all vertex coordinates [x0, y0, x1, y1, ...].
+ * out_count receives the number of vertices.
+ * Returns NULL on failure or for an empty mesh.
+ */
+EMSCRIPTEN_KEEPALIVE
+double* mmg2d_view_vertices(int handle, int* out_count) {
+    if (!validate_handle_2d(handle)) {
+        return fail_with_count(out_count);
+    }
+
+    HandleEntry2D* entry = &HANDLE_2D(handle);
+    ViewBuffer* view = &entry->view_vertices;
+
+    if (view->generation != entry->generation) {
+        MMG5_pMesh mesh = entry->mesh;
+        MMG5_int np = mesh->point ? mesh->np : 0;
+
+        double* out = view_reserve(view, (size_t)np * 2 * sizeof(double));
+        if (np > 0 && !out) {
+            return fail_with_count(out_count);
+        }
+
+        for (MMG5_int k = 1; k <= np; k++) {
+            const double* c = mesh->point[k].c;
+            out[2 * (k - 1) + 0] = c[0];
+            out[2 * (k - 1) + 1] = c[1];
+        }
+
+        view->count = (int)np;
+        view->generation = entry->generation;
+    }
+
+    if (out_count) *out_count = view->count;
+    return view->count > 0 ? (double*)view->data : NULL;
+}
+
+/**
+ * Get a view of all triangles [v0, v1, v2, ...] (1-indexed vertices).
+ * out_count receives the number of triangles.
+ * Returns NULL on failure or for an empty mesh.
+ */
+EMSCRIPTEN_KEEPALIVE
+int* mmg2d_view_triangles(int handle, int* out_count) {
+    if (!validate_handle_2d(handle)) {
+        return fail_with_count(out_count);
+    }
+
+    HandleEntry2D* entry = &HANDLE_2D(handle);
+    ViewBuffer* view = &entry->view_triangles;
+
+    if (view->generation != entry->generation) {
+        MMG5_pMesh mesh = entry->mesh;
+        MMG5_int nt = mesh->tria ? mesh->nt : 0;
+
+        MMG5_int* out = view_reserve(view, (size_t)nt * 3 * sizeof(MMG5_int));
+        if (nt > 0 && !out) {
+            return fail_with_count(out_count);
+        }
+
+        for (MMG5_int k = 1; k <= nt; k++) {
+            memcpy(&out[3 * (k - 1)], mesh->tria[k].v, 3 * sizeof(MMG5_int));
+        }
+
+        view->count = (int)nt;
+        view->generation = entry->generation;
+    }
+
+    if (out_count) *out_count = view->count;
+    return view->count > 0 ? (int*)view->data : NULL;
+}
+
+/**
+ * Get a view of all edges [v0, v1, ...] (1-indexed vertices).
+ * out_count receives the number of edges.
+ * Returns NULL on failure or for a mesh without edges.
+ */
+EMSCRIPTEN_KEEPALIVE
+int* mmg2d_view_edges(int handle, int* out_count) {
+    if (!validate_handle_2d(handle)) {
+        return fail_with_count(out_count);
+    }
+
+    HandleEntry2D* entry = &HANDLE_2D(handle);
+    ViewBuffer* view = &entry->view_edges;
+
+    if (view->generation != entry->generation) {
+        MMG5_pMesh mesh = entry->mesh;
+        MMG5_int na = mesh->edge ? mesh->na : 0;
+
+        MMG5_int* out = view_reserve(view, (size_t)na * 2 * sizeof(MMG5_int));
+        if (na > 0 && !out) {
+            return fail_with_count(out_count);
+        }
+
+        for (MMG5_int k = 1; k <= na; k++) {
+            out[2 * (k - 1) + 0] = mesh->edge[k].a;
+            out[2 * (k - 1) + 1] = mesh->edge[k].b;
+        }
+
+        view->count = (int)na;
+        view->generation = entry->generation;
+    }
+
+    if (out_count) *out_count = view->count;
+    return view->count > 0 ? (int*)view->data : NULL;
+}
+
+/**
+ * Get a view of the solution values [s0_0, ..., s0_{size-1}, s1_0, ...].
+ * Unlike the other views it aliases MMG's own storage, so nothing is packed;
+ * it is also invalidated when the solution is resized.
+ * out_count receives the number of entities and out_size the number of
+ * values per entity (1 for a scalar, 3 for a tensor).
+ * Returns NULL on failure or for an empty solution.
+ */
+EMSCRIPTEN_KEEPALIVE
+double* mmg2d_view_sols(int handle, int* out_count, int* out_size) {
+    if (out_count) *out_count = 0;
+    if (out_size) *out_size = 0;
+    if (!validate_handle_2d(handle)) {
+        return NULL;
+    }
+
+    MMG5_pSol sol = HANDLE_2D(handle).sol;
+    if (!sol || !sol->m || sol->np <= 0) {
+        return NULL;
+    }
+
+    if (out_count) *out_count = (int)sol->np;
+    if (out_size) *out_size = sol->size;
+    /* MMG stores entities from index 1 */
+    return sol->m + sol->size;
+}
+
+/**
+ * Pack the mesh into the compact wire format (see pack.h): float32 or
+ * quantized coordinates, triangles and edges with 0-based indices.
+ * flags: MMGWASM_PACK_QUANTIZE and/or MMGWASM_PACK_BOUNDARY_ONLY.
+ * out_size receives the number of bytes. The buffer is owned by the handle
+ * and overwritten by the next call; it must NOT be passed to mmg2d_free_array.
+ * Returns NULL on failure.
+ */
+EMSCRIPTEN_KEEPALIVE
+const void* mmg2d_pack_mesh(int handle, int flags, int* out_size) {
+    if (out_size) *out_size = 0;
+    if (!validate_handle_2d(handle)) {
+        return NULL;
+    }
+
+    HandleEntry2D* entry = &HANDLE_2D(handle);
+    MMG5_pMesh mesh = entry->mesh;
+    MmgwasmPackInput in = {
+        2, NULL, sizeof(MMG5_Point), 0,
+        {NULL, sizeof(MMG5_Tria), 3, 0},
+        {NULL, sizeof(MMG5_Edge), 2, 0}
+    };
+    if (mesh->point && mesh->np > 0) {
+        in.coords = mesh->point[1].c;
+        in.np = (int)mesh->np;
+    }
+    if (mesh->tria && mesh->nt > 0) {
+        in.cells.verts = mesh->tria[1].v;
+        in.cells.count = (int)mesh->nt;
+    }
+    if (mesh->edge && mesh->na > 0) {
+        in.boundary.verts = &mesh->edge[1].a;
+        in.boundary.count = (int)mesh->na;
+    }
+
+    size_t bytes = mmgwasm_pack_size(&in, flags);
+    if (bytes > INT32_MAX) {
+        return NULL;
+    }
+    void* out = view_reserve(&entry->packed, bytes);
+    if (!out) {
+        return NULL;
+    }
+    mmgwasm_pack_write(&in, flags, out);
+
+    if (out_size) *out_size = (int)bytes;
+    return out;
+}
+
+/*
+ * Batch remeshing
+ *
+ * Many small meshes are remeshed in one call and their results written to
+ * one buffer (see batch.h).
+ */
+
+/* Entities of a mesh (none for NULL), read in place by the batch writer */
+static MmgwasmBatchMesh batch_mesh_2d(MMG5_pMesh mesh) {
+    MmgwasmBatchMesh out = {
+        2, NULL, NULL, sizeof(MMG5_Point), 0,
+        {NULL, NULL, sizeof(MMG5_Tria), 3, 0},
+        {NULL, NULL, sizeof(MMG5_Edge), 2, 0}
+    };
+    if (!mesh) {
+        return out;
+    }
+    if (mesh->point && mesh->np > 0) {
+        out.coords = mesh->point[1].c;
+        out.refs = &mesh->point[1].ref;
+        out.np = (int)mesh->np;
+    }
+    if (mesh->tria && mesh->nt > 0) {
+        out.cells.verts = mesh->tria[1].v;
+        out.cells.refs = &mesh->tria[1].ref;
+        out.cells.count = (int)mesh->nt;
+    }
+    if (mesh->edge && mesh->na > 0) {
+        out.boundary.verts = &mesh->edge[1].a;
+        out.boundary.refs = &mesh->edge[1].ref;
+        out.boundary.count = (int)mesh->na;
+    }
+    return out;
+}
+
+/*
+ * Import a mesh into a new handle, set the batch parameters and remesh it,
+ * filling the statistics of record.
+ * Returns the handle, to free once its result is written, or -1 if the mesh
+ * could not be imported.
+ */
+static int remesh_batch_entry_2d(const MmgwasmMeshImport* desc,
+                                 const MmgwasmBatchParameter* params,
+                                 int nparams, MmgwasmBatchRecord* record) {
+    memset(record, 0, sizeof(*record));
+    record->status = -1;
+
+    int handle = mmg2d_init();
+    if (handle < 0) {
+        return -1;
+    }
+    int ok = mmg2d_import_mesh(handle, desc);
+    for (int i = 0; ok && i < nparams; i++) {
+        ok = params[i].kind == MMGWASM_BATCH_DOUBLE
+            ? mmg2d_set_dparameter(handle, params[i].param, params[i].value)
+            : mmg2d_set_iparameter(handle, params[i].param,
+                                   (int)params[i].value);
+    }
+    if (!ok) {
+        mmg2d_free(handle);
+        return -1;
+    }
+
+    QualityStats stats;
+    double start = emscripten_get_now();
+    mmg2d_get_quality_stats(handle, 0, &stats, NULL);
+    record->quality_before = stats.min;
+    double remesh_start = emscripten_get_now();
+    record->status = run_remesh_2d(handle);
+    double remesh_end = emscripten_get_now();
+    mmg2d_get_quality_stats(handle, 0, &stats, NULL);
+    record->quality_after = stats.min;
+    record->remesh_ms = remesh_end - remesh_start;
+    record->quality_ms =
+        (remesh_start - start) + (emscripten_get_now() - remesh_end);
+    return handle;
+}
+
+/**
+ * Remesh count meshes one after another with the same parameters, writing
+ * every result into one buffer (see batch.h).
+ * meshes holds count import descriptors (see import.h); params holds nparams
+ * parameters, set on each mesh over the defaults. Every mesh goes through a
+ * new handle, which recycles the same slot and arena, since MMG keeps the
+ * adjacency and computed sizes of a mesh it has remeshed. Meshes whose
+ * remesh fails strongly (return code 2 or more) get an empty record.
+ * out_size receives the number of bytes. The buffer is owned by handle and
+ * overwritten by the next batch; it must NOT be passed to mmg2d_free_array.
+ * Returns NULL on failure.
+ */
+EMSCRIPTEN_KEEPALIVE
+const void* mmg2d_remesh_batch(int handle, const MmgwasmMeshImport* meshes,
+                               int count, const MmgwasmBatchParameter* params,
+                               int nparams, int* out_size) {
+    if (out_size) *out_size = 0;
+    if (!validate_handle_2d(handle) || count < 0 || nparams < 0 ||
+        (count > 0 && !meshes) || (nparams > 0 && !params)) {
+        return NULL;
+    }
+
+    ViewBuffer* out = &HANDLE_2D(handle).batch;
+    size_t used = MMGWASM_BATCH_HEADER_BYTES;
+    if (!view_reserve(out, used)) {
+        return NULL;
+    }
+
+    for (int i = 0; i < count; i++) {
+        MmgwasmBatchRecord record;
+        int scratch = remesh_batch_entry_2d(&meshes[i], params, nparams,
+                                            &record);
+        MmgwasmBatchMesh result = batch_mesh_2d(NULL);
+        if (scratch >= 0 && record.status >= 0 && record.status <= 1) {
+            result = batch_mesh_2d(HANDLE_2D(scratch).mesh);
+        }
+
+        size_t bytes = mmgwasm_batch_record_size(&result);
+        char* data = view_reserve(out, used + bytes);
+        if (data) {
+            mmgwasm_batch_write(&result, &record, data + used);
+            used += bytes;
+        }
+        if (scratch >= 0) {
+            mmg2d_free(scratch);
+        }
+        if (!data || used > INT32_MAX) {
+            return NULL;
+        }
+    }
+
+    int32_t* header = (int32_t*)out->data;
+    header[0] = count;
+    header[1] = 0;
+    if (out_size) *out_size = (int)used;
+    return out->data;
+}
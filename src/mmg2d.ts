@@ -5,8 +5,40 @@
  * Uses Emscripten's cwrap to call the C wrapper functions.
  */
 
-import type { EmscriptenFS } from "./fs";
-import type { WasmModule } from "./memory";
+import {
+  BATCH_PARAMETER_BYTES,
+  decodeBatch,
+  writeBatchParameters,
+} from "./batch";
+import type { EmscriptenFS, OPFSModule } from "./fs";
+import { type InitOptions, loadModule } from "./loader";
+import {
+  type MemFileModule,
+  appendStreamToMemFile,
+  appendToMemFile,
+  createMemFile,
+  freeMemFile,
+  readMemFile,
+} from "./memfile";
+import {
+  type MeshImportData,
+  type MeshImportLayout,
+  packMeshImport,
+  packMeshImports,
+} from "./import";
+import {
+  type HandleMemoryUsage,
+  type HeapReserveModule,
+  type NativeMemoryModule,
+  releaseScratchMemory,
+  scratchMemory,
+} from "./memory";
+import type { PointerSizeModule } from "./memory64";
+import type { OptionParameter } from "./options";
+import { type PackOptions, packFlags } from "./packed";
+import type { BatchRemeshResult, RemeshStats } from "./result";
+import { SIZING_STRIDE } from "./sizing";
+import { STATS_BYTES, readRemeshStats } from "./stats";
 
 /**
  * Integer parameters for MMG2D (matching MMG2D_Param enum in libmmg2d.h)
@@ -69,6 +101,7 @@ export const MMG_RETURN_CODES_2D = {
   SUCCESS: 0,
   LOWFAILURE: 1, // The mesh is not suitable for remeshing
   STRONGFAILURE: 2, // The mesh is not valid
+  ABORTED: -3, // The remesh was cancelled with abortRemesh()
 } as const;
 
 /**
@@ -96,12 +129,64 @@ export interface SolInfo2D {
   typSol: number;
 }
 
+/** Element quality statistics computed in a single pass */
+export interface QualityStats2D {
+  /** Minimum element quality (0 for an empty mesh) */
+  min: number;
+  /** Maximum element quality (0 for an empty mesh) */
+  max: number;
+  /** Mean element quality (0 for an empty mesh) */
+  mean: number;
+  /** Number of triangles */
+  count: number;
+  /** Element counts per uniform quality bin over [0, 1] */
+  histogram: Int32Array;
+}
+
+/** Result of locating points in a mesh */
+export interface PointLocation2D {
+  /** 1-indexed triangle containing each point (0 outside the mesh) */
+  elements: Int32Array;
+  /** 3 barycentric coordinates per point, in the triangle vertex order */
+  barycentric: Float64Array;
+  /** Number of points located */
+  located: number;
+}
+
+/** Phase of a remesh, as reported by MMG */
+export type RemeshPhase2D =
+  | "idle"
+  | "analysis"
+  | "meshing"
+  | "finalize"
+  | "done";
+
+/** Progress of a remesh on a handle with progress tracking enabled */
+export interface RemeshProgress2D {
+  /** Current phase */
+  phase: RemeshPhase2D;
+  /** Progress estimate (0-100) */
+  percent: number;
+  /** Passes of the meshing phase, always 0: MMG2D only reports phases */
+  iterations: number;
+}
+
 /** Internal module interface (raw Emscripten functions) */
-export interface MMG2DModule extends WasmModule {
+export interface MMG2DModule
+  extends MemFileModule,
+    HeapReserveModule,
+    NativeMemoryModule,
+    OPFSModule,
+    PointerSizeModule {
   _mmg2d_init(): number;
   _mmg2d_free(handle: number): number;
+  _mmg2d_clone(handle: number): number;
   _mmg2d_get_available_handles(): number;
   _mmg2d_get_max_handles(): number;
+  _mmg2d_set_max_handles(maxHandles: number): number;
+  _mmg2d_set_arena_mode(enabled: number): void;
+  _mmg2d_get_memory_usage(handle: number, outPtr: number): number;
+  _mmg2d_import_mesh(handle: number, descriptorPtr: number): number;
   _mmg2d_set_mesh_size(
     handle: number,
     np: number,
@@ -170,14 +255,94 @@ export interface MMG2DModule extends WasmModule {
   _mmg2d_get_scalar_sols(handle: number, outCountPtr: number): number;
   _mmg2d_set_tensor_sols(handle: number, valuesPtr: number): number;
   _mmg2d_get_tensor_sols(handle: number, outCountPtr: number): number;
+  _mmg2d_apply_sizing(
+    handle: number,
+    constraintsPtr: number,
+    count: number,
+  ): number;
+  _mmg2d_freeze_outside(
+    handle: number,
+    regionsPtr: number,
+    count: number,
+    margin: number,
+  ): number;
+  _mmg2d_thaw(handle: number): number;
+  _mmg2d_locate_points(
+    handle: number,
+    pointsPtr: number,
+    n: number,
+    outElementsPtr: number,
+    outBaryPtr: number,
+  ): number;
+  _mmg2d_sample_sol(
+    handle: number,
+    pointsPtr: number,
+    n: number,
+    outPtr: number,
+  ): number;
+  _mmg2d_interpolate_fields(
+    handle: number,
+    source: number,
+    valuesPtr: number,
+    stride: number,
+    outPtr: number,
+  ): number;
   _mmg2d_remesh(handle: number): number;
+  _mmg2d_remesh_async(handle: number): number;
+  _mmg2d_remesh_status(handle: number): number;
+  _mmg2d_get_progress(handle: number): number;
+  _mmg2d_get_stats(handle: number, outPtr: number): number;
   _mmg2d_free_array(ptr: number): void;
   _mmg2d_load_mesh(handle: number, filenamePtr: number): number;
+  _mmg2d_load_mesh_from_memfile(
+    handle: number,
+    file: number,
+    binary: number,
+  ): number;
   _mmg2d_save_mesh(handle: number, filenamePtr: number): number;
+  _mmg2d_save_mesh_to_memfile(
+    handle: number,
+    file: number,
+    binary: number,
+  ): number;
   _mmg2d_load_sol(handle: number, filenamePtr: number): number;
+  _mmg2d_load_sol_from_memfile(
+    handle: number,
+    file: number,
+    binary: number,
+  ): number;
   _mmg2d_save_sol(handle: number, filenamePtr: number): number;
+  _mmg2d_save_sol_to_memfile(
+    handle: number,
+    file: number,
+    binary: number,
+  ): number;
   _mmg2d_get_triangle_quality(handle: number, k: number): number;
   _mmg2d_get_triangles_qualities(handle: number, outCountPtr: number): number;
+  _mmg2d_get_quality_stats(
+    handle: number,
+    nbins: number,
+    statsPtr: number,
+    histogramPtr: number,
+  ): number;
+  _mmg2d_get_generation(handle: number): number;
+  _mmg2d_view_vertices(handle: number, outCountPtr: number): number;
+  _mmg2d_view_triangles(handle: number, outCountPtr: number): number;
+  _mmg2d_view_edges(handle: number, outCountPtr: number): number;
+  _mmg2d_view_sols(
+    handle: number,
+    outCountPtr: number,
+    outSizePtr: number,
+  ): number;
+  _mmg2d_pack_mesh(handle: number, flags: number, outSizePtr: number): number;
+  _mmg2d_remesh_batch(
+    handle: number,
+    meshesPtr: number,
+    count: number,
+    parametersPtr: number,
+    nparameters: number,
+    outSizePtr: number,
+  ): number;
   getValue(ptr: number, type: string): number;
   setValue(ptr: number, value: number, type: string): void;
   lengthBytesUTF8(str: string): number;
@@ -185,22 +350,58 @@ export interface MMG2DModule extends WasmModule {
   FS: EmscriptenFS;
 }
 
+// Entity sizes for importMesh
+const IMPORT_LAYOUT: MeshImportLayout = {
+  dim: 2,
+  cellSize: 3,
+  boundarySize: 2,
+  tensorSize: 3,
+};
+
+// Status reported by the C wrapper while an asynchronous remesh is running
+const REMESH_RUNNING = -2;
+// Polling interval for asynchronous remesh completion (ms)
+const REMESH_POLL_MS = 4;
+// Int32 field offsets of the C progress record (MmgwasmProgress)
+const PROGRESS_ENABLED = 0;
+const PROGRESS_ABORT = 1;
+const PROGRESS_PHASE = 2;
+const PROGRESS_PERCENT = 3;
+const PROGRESS_ITERATIONS = 4;
+const REMESH_PHASES: RemeshPhase2D[] = [
+  "idle",
+  "analysis",
+  "meshing",
+  "finalize",
+  "done",
+];
+
 let module: MMG2DModule | null = null;
 
 /**
  * Initialize the MMG2D WASM module.
  * Must be called before using any MMG2D functions.
+ *
+ * @param options - Optional settings, e.g. the maximum number of handles
  */
-export async function initMMG2D(): Promise<void> {
-  if (module) {
-    return; // Already initialized
+export async function initMMG2D(options: InitOptions = {}): Promise<void> {
+  if (!module) {
+    // Instance of the Emscripten-generated module shared with the other
+    // mesh types, or of this type's own module (see setSplitModules). It
+    // doesn't have TypeScript declarations, so we cast through unknown to
+    // the properly typed interface
+    module = (await loadModule(
+      "mmg2d",
+      options.heapBytes,
+    )) as unknown as MMG2DModule;
   }
 
-  // Dynamic import of the Emscripten-generated module
-  // The Emscripten-generated module doesn't have TypeScript declarations,
-  // so we cast through unknown to the properly typed interface
-  const createModule = (await import("../build/dist/mmg.js")).default;
-  module = (await createModule()) as unknown as MMG2DModule;
+  if (options.maxHandles !== undefined) {
+    MMG2D.setMaxHandles(options.maxHandles);
+  }
+  if (options.arena !== undefined) {
+    MMG2D.setArenaMode(options.arena);
+  }
 }
 
 /**
@@ -258,6 +459,28 @@ export const MMG2D = {
     if (result !== 1) {
       throw new Error("Failed to free MMG2D mesh (invalid handle?)");
     }
+    // The scratch memory of the transfers goes with the last mesh
+    if (m._mmg2d_get_available_handles() === m._mmg2d_get_max_handles()) {
+      releaseScratchMemory(m);
+    }
+  },
+
+  /**
+   * Duplicate a mesh, including refs, tags and the solution/metric field.
+   * The copy is made entirely inside WASM memory.
+   * @param handle - The mesh handle to clone
+   * @returns A new, independent mesh handle
+   * @throws Error if the handle is invalid or no handle slot is available
+   */
+  clone(handle: MeshHandle2D): MeshHandle2D {
+    const m = getModule();
+    const cloned = m._mmg2d_clone(handle);
+    if (cloned < 0) {
+      throw new Error(
+        "Failed to clone MMG2D mesh (invalid handle or max handles reached?)",
+      );
+    }
+    return cloned as MeshHandle2D;
   },
 
   /**
@@ -271,13 +494,60 @@ export const MMG2D = {
 
   /**
    * Get the maximum number of concurrent mesh handles supported.
-   * @returns Maximum number of handles (currently 64)
+   * @returns Maximum number of handles (1024 unless changed)
    */
   getMaxHandles(): number {
     const m = getModule();
     return m._mmg2d_get_max_handles();
   },
 
+  /**
+   * Set the maximum number of concurrent mesh handles.
+   * Handle slots are allocated on demand, so a large maximum costs nothing
+   * until it is used.
+   * @param maxHandles - New maximum (at most 65536)
+   * @throws Error if maxHandles is out of range or below the number of handle
+   *   slots already in use
+   */
+  setMaxHandles(maxHandles: number): void {
+    const m = getModule();
+    if (m._mmg2d_set_max_handles(maxHandles) !== 1) {
+      throw new Error(`Failed to set MMG2D max handles to ${maxHandles}`);
+    }
+  },
+
+  /**
+   * Allocate MMG's memory for handles created from now on from a per-handle
+   * arena, returned to the heap in one step when the handle is freed. This
+   * keeps long-lived modules from fragmenting their heap across many jobs.
+   * Existing handles keep their mode.
+   * @param enabled - true for arena mode, false for the regular heap
+   */
+  setArenaMode(enabled: boolean): void {
+    const m = getModule();
+    m._mmg2d_set_arena_mode(enabled ? 1 : 0);
+  },
+
+  /**
+   * Get the memory held for a mesh handle: what MMG allocated for it, its
+   * memory limit and the size of its arena.
+   * @param handle - The mesh handle
+   * @returns Memory usage in bytes
+   * @throws Error if the handle is invalid
+   */
+  getMemoryUsage(handle: MeshHandle2D): HandleMemoryUsage {
+    const m = getModule();
+    const [ptr] = scratchMemory(m, [3 * 8]);
+    if (m._mmg2d_get_memory_usage(handle, ptr) !== 1) {
+      throw new Error("Failed to get memory usage");
+    }
+    return {
+      used: m.HEAPF64[ptr / 8],
+      max: m.HEAPF64[ptr / 8 + 1],
+      arena: m.HEAPF64[ptr / 8 + 2],
+    };
+  },
+
   /**
    * Set the mesh size (allocate memory for mesh entities).
    * @param handle - The mesh handle
@@ -315,33 +585,41 @@ export const MMG2D = {
   getMeshSize(handle: MeshHandle2D): MeshSize2D {
     const m = getModule();
 
-    // Allocate space for 4 integers
-    const ptr = m._malloc(4 * 4);
-    if (ptr === 0) {
-      throw new Error("Failed to allocate memory");
-    }
+    const [ptr] = scratchMemory(m, [4 * 4]);
+    const result = m._mmg2d_get_mesh_size(
+      handle,
+      ptr, // np
+      ptr + 4, // nt
+      ptr + 8, // nquad
+      ptr + 12, // na
+    );
 
-    try {
-      const result = m._mmg2d_get_mesh_size(
-        handle,
-        ptr, // np
-        ptr + 4, // nt
-        ptr + 8, // nquad
-        ptr + 12, // na
-      );
+    if (result !== 1) {
+      throw new Error("Failed to get mesh size");
+    }
 
-      if (result !== 1) {
-        throw new Error("Failed to get mesh size");
-      }
+    return {
+      nVertices: m.getValue(ptr, "i32"),
+      nTriangles: m.getValue(ptr + 4, "i32"),
+      nQuads: m.getValue(ptr + 8, "i32"),
+      nEdges: m.getValue(ptr + 12, "i32"),
+    };
+  },
 
-      return {
-        nVertices: m.getValue(ptr, "i32"),
-        nTriangles: m.getValue(ptr + 4, "i32"),
-        nQuads: m.getValue(ptr + 8, "i32"),
-        nEdges: m.getValue(ptr + 12, "i32"),
-      };
-    } finally {
-      m._free(ptr);
+  /**
+   * Size and fill a mesh and its metric in one call.
+   * All arrays are copied into a single staging buffer and set natively at
+   * once, instead of one allocation, copy and call per array.
+   * @param handle - The mesh handle
+   * @param data - Vertices, triangles, boundary edges, their references and an optional
+   *   metric (1 or 3 values per vertex)
+   * @throws Error if an array has the wrong length or the import fails
+   */
+  importMesh(handle: MeshHandle2D, data: MeshImportData): void {
+    const m = getModule();
+    const ptr = packMeshImport(m, data, IMPORT_LAYOUT);
+    if (m._mmg2d_import_mesh(handle, ptr) !== 1) {
+      throw new Error("Failed to import mesh");
     }
   },
 
@@ -392,35 +670,22 @@ export const MMG2D = {
 
     const m = getModule();
 
-    // Allocate and copy vertices to WASM heap
-    const verticesPtr = m._malloc(vertices.byteLength);
-    if (verticesPtr === 0) {
-      throw new Error("Failed to allocate memory for vertices");
+    const [verticesPtr, refsPtr] = scratchMemory(m, [
+      vertices.byteLength,
+      refs ? refs.byteLength : 0,
+    ]);
+    m.HEAPF64.set(vertices, verticesPtr / 8);
+    if (refs) {
+      m.HEAP32.set(refs, refsPtr / 4);
     }
 
-    let refsPtr = 0;
-    try {
-      // Copy vertices to WASM heap
-      m.HEAPF64.set(vertices, verticesPtr / 8);
-
-      // Handle refs if provided
-      if (refs) {
-        refsPtr = m._malloc(refs.byteLength);
-        if (refsPtr === 0) {
-          throw new Error("Failed to allocate memory for refs");
-        }
-        m.HEAP32.set(refs, refsPtr / 4);
-      }
-
-      const result = m._mmg2d_set_vertices(handle, verticesPtr, refsPtr);
-      if (result !== 1) {
-        throw new Error("Failed to set vertices");
-      }
-    } finally {
-      m._free(verticesPtr);
-      if (refsPtr !== 0) {
-        m._free(refsPtr);
-      }
+    const result = m._mmg2d_set_vertices(
+      handle,
+      verticesPtr,
+      refs ? refsPtr : 0,
+    );
+    if (result !== 1) {
+      throw new Error("Failed to set vertices");
     }
   },
 
@@ -430,37 +695,9 @@ export const MMG2D = {
    * @returns Float64Array of vertex coordinates [x0, y0, x1, y1, ...]
    */
   getVertices(handle: MeshHandle2D): Float64Array {
-    const m = getModule();
-
-    // Allocate space for output count
-    const countPtr = m._malloc(4);
-    if (countPtr === 0) {
-      throw new Error("Failed to allocate memory");
-    }
-
-    try {
-      const dataPtr = m._mmg2d_get_vertices(handle, countPtr);
-      if (dataPtr === 0) {
-        // Check if there are simply no vertices
-        const count = m.getValue(countPtr, "i32");
-        if (count === 0) {
-          return new Float64Array(0);
-        }
-        throw new Error("Failed to get vertices");
-      }
-
-      try {
-        const count = m.getValue(countPtr, "i32");
-        // Copy data from WASM heap (2D: 2 coords per vertex)
-        const result = new Float64Array(count * 2);
-        result.set(m.HEAPF64.subarray(dataPtr / 8, dataPtr / 8 + count * 2));
-        return result;
-      } finally {
-        m._mmg2d_free_array(dataPtr);
-      }
-    } finally {
-      m._free(countPtr);
-    }
+    // Copied out of the packed view buffer, which the handle keeps and
+    // only repacks after the mesh changes
+    return this.getVerticesView(handle).slice();
   },
 
   /**
@@ -510,35 +747,18 @@ export const MMG2D = {
 
     const m = getModule();
 
-    // Allocate and copy triangles to WASM heap
-    const triaPtr = m._malloc(triangles.byteLength);
-    if (triaPtr === 0) {
-      throw new Error("Failed to allocate memory for triangles");
+    const [triaPtr, refsPtr] = scratchMemory(m, [
+      triangles.byteLength,
+      refs ? refs.byteLength : 0,
+    ]);
+    m.HEAP32.set(triangles, triaPtr / 4);
+    if (refs) {
+      m.HEAP32.set(refs, refsPtr / 4);
     }
 
-    let refsPtr = 0;
-    try {
-      // Copy triangles to WASM heap
-      m.HEAP32.set(triangles, triaPtr / 4);
-
-      // Handle refs if provided
-      if (refs) {
-        refsPtr = m._malloc(refs.byteLength);
-        if (refsPtr === 0) {
-          throw new Error("Failed to allocate memory for refs");
-        }
-        m.HEAP32.set(refs, refsPtr / 4);
-      }
-
-      const result = m._mmg2d_set_triangles(handle, triaPtr, refsPtr);
-      if (result !== 1) {
-        throw new Error("Failed to set triangles");
-      }
-    } finally {
-      m._free(triaPtr);
-      if (refsPtr !== 0) {
-        m._free(refsPtr);
-      }
+    const result = m._mmg2d_set_triangles(handle, triaPtr, refs ? refsPtr : 0);
+    if (result !== 1) {
+      throw new Error("Failed to set triangles");
     }
   },
 
@@ -548,37 +768,7 @@ export const MMG2D = {
    * @returns Int32Array of vertex indices [v0_0, v1_0, v2_0, ...] (1-indexed)
    */
   getTriangles(handle: MeshHandle2D): Int32Array {
-    const m = getModule();
-
-    // Allocate space for output count
-    const countPtr = m._malloc(4);
-    if (countPtr === 0) {
-      throw new Error("Failed to allocate memory");
-    }
-
-    try {
-      const dataPtr = m._mmg2d_get_triangles(handle, countPtr);
-      if (dataPtr === 0) {
-        // Check if there are simply no triangles
-        const count = m.getValue(countPtr, "i32");
-        if (count === 0) {
-          return new Int32Array(0);
-        }
-        throw new Error("Failed to get triangles");
-      }
-
-      try {
-        const count = m.getValue(countPtr, "i32");
-        // Copy data from WASM heap
-        const result = new Int32Array(count * 3);
-        result.set(m.HEAP32.subarray(dataPtr / 4, dataPtr / 4 + count * 3));
-        return result;
-      } finally {
-        m._mmg2d_free_array(dataPtr);
-      }
-    } finally {
-      m._free(countPtr);
-    }
+    return this.getTrianglesView(handle).slice();
   },
 
   /**
@@ -623,35 +813,18 @@ export const MMG2D = {
 
     const m = getModule();
 
-    // Allocate and copy edges to WASM heap
-    const edgesPtr = m._malloc(edges.byteLength);
-    if (edgesPtr === 0) {
-      throw new Error("Failed to allocate memory for edges");
+    const [edgesPtr, refsPtr] = scratchMemory(m, [
+      edges.byteLength,
+      refs ? refs.byteLength : 0,
+    ]);
+    m.HEAP32.set(edges, edgesPtr / 4);
+    if (refs) {
+      m.HEAP32.set(refs, refsPtr / 4);
     }
 
-    let refsPtr = 0;
-    try {
-      // Copy edges to WASM heap
-      m.HEAP32.set(edges, edgesPtr / 4);
-
-      // Handle refs if provided
-      if (refs) {
-        refsPtr = m._malloc(refs.byteLength);
-        if (refsPtr === 0) {
-          throw new Error("Failed to allocate memory for refs");
-        }
-        m.HEAP32.set(refs, refsPtr / 4);
-      }
-
-      const result = m._mmg2d_set_edges(handle, edgesPtr, refsPtr);
-      if (result !== 1) {
-        throw new Error("Failed to set edges");
-      }
-    } finally {
-      m._free(edgesPtr);
-      if (refsPtr !== 0) {
-        m._free(refsPtr);
-      }
+    const result = m._mmg2d_set_edges(handle, edgesPtr, refs ? refsPtr : 0);
+    if (result !== 1) {
+      throw new Error("Failed to set edges");
     }
   },
 
@@ -661,37 +834,7 @@ export const MMG2D = {
    * @returns Int32Array of vertex indices [v0_0, v1_0, ...] (1-indexed)
    */
   getEdges(handle: MeshHandle2D): Int32Array {
-    const m = getModule();
-
-    // Allocate space for output count
-    const countPtr = m._malloc(4);
-    if (countPtr === 0) {
-      throw new Error("Failed to allocate memory");
-    }
-
-    try {
-      const dataPtr = m._mmg2d_get_edges(handle, countPtr);
-      if (dataPtr === 0) {
-        // Check if there are simply no edges
-        const count = m.getValue(countPtr, "i32");
-        if (count === 0) {
-          return new Int32Array(0);
-        }
-        throw new Error("Failed to get edges");
-      }
-
-      try {
-        const count = m.getValue(countPtr, "i32");
-        // Copy data from WASM heap (2 vertices per edge)
-        const result = new Int32Array(count * 2);
-        result.set(m.HEAP32.subarray(dataPtr / 4, dataPtr / 4 + count * 2));
-        return result;
-      } finally {
-        m._mmg2d_free_array(dataPtr);
-      }
-    } finally {
-      m._free(countPtr);
-    }
+    return this.getEdgesView(handle).slice();
   },
 
   /**
@@ -752,26 +895,17 @@ export const MMG2D = {
   getSolSize(handle: MeshHandle2D): SolInfo2D {
     const m = getModule();
 
-    // Allocate space for 3 integers
-    const ptr = m._malloc(3 * 4);
-    if (ptr === 0) {
-      throw new Error("Failed to allocate memory for solution size");
+    const [ptr] = scratchMemory(m, [3 * 4]);
+    const result = m._mmg2d_get_sol_size(handle, ptr, ptr + 4, ptr + 8);
+    if (result !== 1) {
+      throw new Error("Failed to get solution size");
     }
 
-    try {
-      const result = m._mmg2d_get_sol_size(handle, ptr, ptr + 4, ptr + 8);
-      if (result !== 1) {
-        throw new Error("Failed to get solution size");
-      }
-
-      return {
-        typEntity: m.getValue(ptr, "i32"),
-        nEntities: m.getValue(ptr + 4, "i32"),
-        typSol: m.getValue(ptr + 8, "i32"),
-      };
-    } finally {
-      m._free(ptr);
-    }
+    return {
+      typEntity: m.getValue(ptr, "i32"),
+      nEntities: m.getValue(ptr + 4, "i32"),
+      typSol: m.getValue(ptr + 8, "i32"),
+    };
   },
 
   /**
@@ -784,19 +918,11 @@ export const MMG2D = {
   setScalarSols(handle: MeshHandle2D, values: Float64Array): void {
     const m = getModule();
 
-    const valuesPtr = m._malloc(values.byteLength);
-    if (valuesPtr === 0) {
-      throw new Error("Failed to allocate memory for solution values");
-    }
-
-    try {
-      m.HEAPF64.set(values, valuesPtr / 8);
-      const result = m._mmg2d_set_scalar_sols(handle, valuesPtr);
-      if (result !== 1) {
-        throw new Error("Failed to set scalar solution values");
-      }
-    } finally {
-      m._free(valuesPtr);
+    const [valuesPtr] = scratchMemory(m, [values.byteLength]);
+    m.HEAPF64.set(values, valuesPtr / 8);
+    const result = m._mmg2d_set_scalar_sols(handle, valuesPtr);
+    if (result !== 1) {
+      throw new Error("Failed to set scalar solution values");
     }
   },
 
@@ -809,30 +935,15 @@ export const MMG2D = {
   getScalarSols(handle: MeshHandle2D): Float64Array {
     const m = getModule();
 
-    const countPtr = m._malloc(4);
-    if (countPtr === 0) {
-      throw new Error("Failed to allocate memory for count");
-    }
-
-    try {
-      const dataPtr = m._mmg2d_get_scalar_sols(handle, countPtr);
-      if (dataPtr === 0) {
-        throw new Error(
-          "Failed to get scalar solution values (wrong type or empty?)",
-        );
-      }
-
-      try {
-        const count = m.getValue(countPtr, "i32");
-        const result = new Float64Array(count);
-        result.set(m.HEAPF64.subarray(dataPtr / 8, dataPtr / 8 + count));
-        return result;
-      } finally {
-        m._mmg2d_free_array(dataPtr);
-      }
-    } finally {
-      m._free(countPtr);
+    const [countPtr, sizePtr] = scratchMemory(m, [4, 4]);
+    const dataPtr = m._mmg2d_view_sols(handle, countPtr, sizePtr);
+    const count = m.getValue(countPtr, "i32");
+    if (dataPtr === 0 || m.getValue(sizePtr, "i32") !== 1) {
+      throw new Error(
+        "Failed to get scalar solution values (wrong type or empty?)",
+      );
     }
+    return m.HEAPF64.slice(dataPtr / 8, dataPtr / 8 + count);
   },
 
   /**
@@ -845,19 +956,11 @@ export const MMG2D = {
   setTensorSols(handle: MeshHandle2D, values: Float64Array): void {
     const m = getModule();
 
-    const valuesPtr = m._malloc(values.byteLength);
-    if (valuesPtr === 0) {
-      throw new Error("Failed to allocate memory for tensor values");
-    }
-
-    try {
-      m.HEAPF64.set(values, valuesPtr / 8);
-      const result = m._mmg2d_set_tensor_sols(handle, valuesPtr);
-      if (result !== 1) {
-        throw new Error("Failed to set tensor solution values");
-      }
-    } finally {
-      m._free(valuesPtr);
+    const [valuesPtr] = scratchMemory(m, [values.byteLength]);
+    m.HEAPF64.set(values, valuesPtr / 8);
+    const result = m._mmg2d_set_tensor_sols(handle, valuesPtr);
+    if (result !== 1) {
+      throw new Error("Failed to set tensor solution values");
     }
   },
 
@@ -870,33 +973,206 @@ export const MMG2D = {
   getTensorSols(handle: MeshHandle2D): Float64Array {
     const m = getModule();
 
-    const countPtr = m._malloc(4);
-    if (countPtr === 0) {
-      throw new Error("Failed to allocate memory for count");
+    const [countPtr, sizePtr] = scratchMemory(m, [4, 4]);
+    const dataPtr = m._mmg2d_view_sols(handle, countPtr, sizePtr);
+    const count = m.getValue(countPtr, "i32");
+    if (dataPtr === 0 || m.getValue(sizePtr, "i32") !== 3) {
+      throw new Error(
+        "Failed to get tensor solution values (wrong type or empty?)",
+      );
     }
+    return m.HEAPF64.slice(dataPtr / 8, dataPtr / 8 + count * 3);
+  },
 
-    try {
-      const dataPtr = m._mmg2d_get_tensor_sols(handle, countPtr);
-      if (dataPtr === 0) {
-        throw new Error(
-          "Failed to get tensor solution values (wrong type or empty?)",
-        );
-      }
+  /**
+   * Evaluate packed local sizing constraints into the scalar metric.
+   * All constraints are evaluated natively in a single pass over the
+   * vertices, writing straight into the solution (which is replaced).
+   * Vertices outside every region get a fifth of the bounding box diagonal.
+   * @param handle - The mesh handle
+   * @param constraints - Packed constraints (see encodeSizingConstraints)
+   * @throws Error if a constraint is invalid or evaluation fails
+   */
+  applySizing(handle: MeshHandle2D, constraints: Float64Array): void {
+    if (constraints.length % SIZING_STRIDE !== 0) {
+      throw new Error(
+        `Packed constraints length must be a multiple of ${SIZING_STRIDE}`,
+      );
+    }
+    const m = getModule();
 
-      try {
-        const count = m.getValue(countPtr, "i32");
-        // 3 components per vertex for 2D tensor
-        const result = new Float64Array(count * 3);
-        result.set(m.HEAPF64.subarray(dataPtr / 8, dataPtr / 8 + count * 3));
-        return result;
-      } finally {
-        m._mmg2d_free_array(dataPtr);
-      }
-    } finally {
-      m._free(countPtr);
+    const [constraintsPtr] = scratchMemory(m, [constraints.byteLength]);
+    m.HEAPF64.set(constraints, constraintsPtr / 8);
+    const count = constraints.length / SIZING_STRIDE;
+    if (m._mmg2d_apply_sizing(handle, constraintsPtr, count) !== 1) {
+      throw new Error("Failed to apply sizing constraints");
     }
   },
 
+  /**
+   * Prepare a local remesh: tag as required every element with no vertex
+   * inside the packed regions, grown by margin, so the next remesh only
+   * reworks the elements around them. Undo with thaw once remeshed.
+   * @param handle - The mesh handle
+   * @param regions - Packed constraints (see encodeSizingConstraints)
+   * @param margin - Distance the regions are grown by (default: 0)
+   * @returns The number of frozen triangles
+   * @throws Error if the mesh already has required entities, or on failure
+   */
+  freezeOutside(
+    handle: MeshHandle2D,
+    regions: Float64Array,
+    margin = 0,
+  ): number {
+    if (regions.length % SIZING_STRIDE !== 0) {
+      throw new Error(
+        `Packed constraints length must be a multiple of ${SIZING_STRIDE}`,
+      );
+    }
+    const m = getModule();
+
+    const [regionsPtr] = scratchMemory(m, [regions.byteLength]);
+    m.HEAPF64.set(regions, regionsPtr / 8);
+    const count = regions.length / SIZING_STRIDE;
+    const frozen = m._mmg2d_freeze_outside(handle, regionsPtr, count, margin);
+    if (frozen === -2) {
+      throw new Error(
+        "Local remeshing needs a mesh without required entities",
+      );
+    }
+    if (frozen < 0) {
+      throw new Error("Failed to freeze elements outside the local regions");
+    }
+    return frozen;
+  },
+
+  /**
+   * Clear the required tags of every entity, after a local remesh
+   * @param handle - The mesh handle
+   * @throws Error if the handle is invalid
+   */
+  thaw(handle: MeshHandle2D): void {
+    const m = getModule();
+    if (m._mmg2d_thaw(handle) !== 1) {
+      throw new Error("Failed to clear required tags");
+    }
+  },
+
+  /**
+   * Locate points in the mesh, finding the triangle containing each one.
+   * The element hierarchy is built by the first query and reused until the
+   * mesh is modified.
+   * @param handle - The mesh handle
+   * @param points - Float64Array of point coordinates [x0, y0, x1, y1, ...]
+   * @returns The triangle of every point and its barycentric coordinates
+   * @throws Error if the lookup fails
+   */
+  locatePoints(handle: MeshHandle2D, points: Float64Array): PointLocation2D {
+    if (points.length % 2 !== 0) {
+      throw new Error("Point coordinates length must be a multiple of 2");
+    }
+    const m = getModule();
+    const n = points.length / 2;
+
+    const [pointsPtr, elementsPtr, baryPtr] = scratchMemory(m, [
+      points.byteLength,
+      n * 4,
+      n * 3 * 8,
+    ]);
+    m.HEAPF64.set(points, pointsPtr / 8);
+    const located = m._mmg2d_locate_points(
+      handle,
+      pointsPtr,
+      n,
+      elementsPtr,
+      baryPtr,
+    );
+    if (located < 0) {
+      throw new Error("Failed to locate points");
+    }
+    return {
+      elements: m.HEAP32.slice(elementsPtr / 4, elementsPtr / 4 + n),
+      barycentric: m.HEAPF64.slice(baryPtr / 8, baryPtr / 8 + n * 3),
+      located,
+    };
+  },
+
+  /**
+   * Interpolate the solution at arbitrary points, linearly in the triangle
+   * containing each point. Points outside the mesh get NaN.
+   * @param handle - The mesh handle
+   * @param points - Float64Array of point coordinates [x0, y0, x1, y1, ...]
+   * @returns Float64Array of the solution components at every point
+   * @throws Error if the mesh has no vertex solution
+   */
+  sampleSolution(handle: MeshHandle2D, points: Float64Array): Float64Array {
+    if (points.length % 2 !== 0) {
+      throw new Error("Point coordinates length must be a multiple of 2");
+    }
+    const { typSol } = this.getSolSize(handle);
+    const components =
+      typSol === SOL_TYPE_2D.SCALAR ? 1 : typSol === SOL_TYPE_2D.VECTOR ? 2 : 3;
+    const m = getModule();
+    const n = points.length / 2;
+
+    const [pointsPtr, outPtr] = scratchMemory(m, [
+      points.byteLength,
+      n * components * 8,
+    ]);
+    m.HEAPF64.set(points, pointsPtr / 8);
+    if (m._mmg2d_sample_sol(handle, pointsPtr, n, outPtr) < 0) {
+      throw new Error("Failed to sample solution");
+    }
+    return m.HEAPF64.slice(outPtr / 8, outPtr / 8 + n * components);
+  },
+
+  /**
+   * Interpolate user fields from the vertices of another mesh, typically the
+   * mesh this one was remeshed from, onto the vertices of this mesh.
+   * Vertices outside the source mesh take the values of its closest point.
+   * @param handle - The mesh handle receiving the fields
+   * @param source - The mesh handle the fields are defined on
+   * @param fields - Float64Array of stride values per source vertex
+   * @param stride - Number of interleaved values per vertex (default: 1)
+   * @returns Float64Array of stride values per vertex of handle
+   * @throws Error if the interpolation fails
+   */
+  interpolateFields(
+    handle: MeshHandle2D,
+    source: MeshHandle2D,
+    fields: Float64Array,
+    stride = 1,
+  ): Float64Array {
+    if (!Number.isInteger(stride) || stride <= 0) {
+      throw new Error(`Invalid field stride: ${stride}`);
+    }
+    const expected = this.getMeshSize(source).nVertices * stride;
+    if (fields.length !== expected) {
+      throw new Error(
+        `Expected ${expected} field values, got ${fields.length}`,
+      );
+    }
+    const nVertices = this.getMeshSize(handle).nVertices;
+    const m = getModule();
+
+    const [valuesPtr, outPtr] = scratchMemory(m, [
+      fields.byteLength,
+      nVertices * stride * 8,
+    ]);
+    m.HEAPF64.set(fields, valuesPtr / 8);
+    const result = m._mmg2d_interpolate_fields(
+      handle,
+      source,
+      valuesPtr,
+      stride,
+      outPtr,
+    );
+    if (result !== 1) {
+      throw new Error("Failed to interpolate fields");
+    }
+    return m.HEAPF64.slice(outPtr / 8, outPtr / 8 + nVertices * stride);
+  },
+
   /**
    * Run the MMG2D remeshing algorithm.
    * @param handle - The mesh handle
@@ -907,6 +1183,134 @@ export const MMG2D = {
     return m._mmg2d_remesh(handle);
   },
 
+  /**
+   * Run the MMG2D remeshing algorithm without blocking the caller.
+   *
+   * With the pthreads build the remesh runs on a pool thread sharing the
+   * module heap, so several handles can be remeshed concurrently; other builds
+   * run it synchronously. The handle must not be used until the promise
+   * settles.
+   * @param handle - The mesh handle
+   * @param onProgress - Called whenever the progress of the remesh changes
+   *   (enables progress tracking on the handle)
+   * @returns Return code (0 = success, 1 = low failure, 2 = strong failure,
+   *   -3 = aborted with abortRemesh())
+   * @throws Error if the remesh could not be started (invalid or busy handle)
+   */
+  async mmg2dlibAsync(
+    handle: MeshHandle2D,
+    onProgress?: (progress: RemeshProgress2D) => void,
+  ): Promise<number> {
+    const m = getModule();
+    if (onProgress) {
+      MMG2D.setProgressTracking(handle, true);
+    }
+    if (m._mmg2d_remesh_async(handle) !== 1) {
+      throw new Error(
+        "Failed to start MMG2D remeshing (invalid handle or remesh in progress)",
+      );
+    }
+
+    let status = m._mmg2d_remesh_status(handle);
+    let reported = -1;
+    const report = () => {
+      const progress = MMG2D.getProgress(handle);
+      if (progress.percent !== reported) {
+        reported = progress.percent;
+        onProgress?.(progress);
+      }
+    };
+    while (status === REMESH_RUNNING) {
+      if (onProgress) {
+        report();
+      }
+      await new Promise((resolve) => setTimeout(resolve, REMESH_POLL_MS));
+      status = m._mmg2d_remesh_status(handle);
+    }
+    if (onProgress) {
+      report();
+    }
+    return status;
+  },
+
+  /**
+   * Enable or disable progress tracking for the next remeshes of a handle.
+   *
+   * While tracking is enabled MMG2D's phases update the progress record (see
+   * getProgress), and the remesh can be cancelled with abortRemesh().
+   * @param handle - The mesh handle
+   * @param enabled - Whether to track progress
+   * @throws Error if the handle is invalid
+   */
+  setProgressTracking(handle: MeshHandle2D, enabled: boolean): void {
+    const m = getModule();
+    const ptr = m._mmg2d_get_progress(handle);
+    if (ptr === 0) {
+      throw new Error("Invalid MMG2D handle");
+    }
+    Atomics.store(m.HEAP32, ptr / 4 + PROGRESS_ENABLED, enabled ? 1 : 0);
+  },
+
+  /**
+   * Get the progress of the current (or last) remesh of a handle.
+   *
+   * Only updated while progress tracking is enabled. The record is read from
+   * the heap, so with the pthreads build it can be polled while the remesh
+   * runs on another thread.
+   * @param handle - The mesh handle
+   * @returns Current phase, progress estimate and pass count
+   * @throws Error if the handle is invalid
+   */
+  getProgress(handle: MeshHandle2D): RemeshProgress2D {
+    const m = getModule();
+    const ptr = m._mmg2d_get_progress(handle);
+    if (ptr === 0) {
+      throw new Error("Invalid MMG2D handle");
+    }
+    const base = ptr / 4;
+    return {
+      phase: REMESH_PHASES[Atomics.load(m.HEAP32, base + PROGRESS_PHASE)],
+      percent: Atomics.load(m.HEAP32, base + PROGRESS_PERCENT),
+      iterations: Atomics.load(m.HEAP32, base + PROGRESS_ITERATIONS),
+    };
+  },
+
+  /**
+   * Get the statistics of the last remesh of a handle.
+   *
+   * Only recorded by the instrumentation build (MMG_WASM_STATS): other builds
+   * return undefined, as they do for an invalid handle.
+   * @param handle - The mesh handle
+   * @returns Phase timings and operation counts of MMG, or undefined
+   */
+  getStats(handle: MeshHandle2D): RemeshStats | undefined {
+    const m = getModule();
+    const [statsPtr] = scratchMemory(m, [STATS_BYTES]);
+    if (m._mmg2d_get_stats(handle, statsPtr) !== 1) {
+      return undefined;
+    }
+    return readRemeshStats(m, statsPtr);
+  },
+
+  /**
+   * Request cancellation of the running remesh of a handle.
+   *
+   * The remesh stops at the next phase boundary and returns
+   * MMG_RETURN_CODES_2D.ABORTED, through MMG2D's own failure path: the handle
+   * keeps a valid, partially remeshed mesh. Requires progress tracking to
+   * have been enabled before the remesh started.
+   * @param handle - The mesh handle
+   * @throws Error if the handle is invalid
+   */
+  abortRemesh(handle: MeshHandle2D): void {
+    const m = getModule();
+    const ptr = m._mmg2d_get_progress(handle);
+    if (ptr === 0) {
+      throw new Error("Invalid MMG2D handle");
+    }
+    Atomics.store(m.HEAP32, ptr / 4 + PROGRESS_ABORT, 1);
+  },
+
   /**
    * Load a mesh from a file in the virtual filesystem.
    * Use FS.writeFile() to write mesh data to the virtual filesystem first.
@@ -917,18 +1321,81 @@ export const MMG2D = {
   loadMesh(handle: MeshHandle2D, filename: string): void {
     const m = getModule();
     const filenameLen = m.lengthBytesUTF8(filename) + 1;
-    const filenamePtr = m._malloc(filenameLen);
-    if (filenamePtr === 0) {
-      throw new Error("Failed to allocate memory for filename");
+    const [filenamePtr] = scratchMemory(m, [filenameLen]);
+    m.stringToUTF8(filename, filenamePtr, filenameLen);
+    const result = m._mmg2d_load_mesh(handle, filenamePtr);
+    if (result !== 1) {
+      throw new Error(`Failed to load mesh from ${filename}`);
     }
+  },
+
+  /**
+   * Load a mesh from .mesh/.meshb file contents held in memory.
+   * The bytes are copied once into WASM memory and parsed there, without
+   * going through the virtual filesystem.
+   * @param handle - The mesh handle
+   * @param data - Contents of the mesh file
+   * @param format - File format (default: "mesh")
+   * @throws Error if loading fails
+   */
+  loadMeshFromBuffer(
+    handle: MeshHandle2D,
+    data: Uint8Array,
+    format: "mesh" | "meshb" = "mesh",
+  ): void {
+    const m = getModule();
+    const file = createMemFile(m, data.length);
     try {
-      m.stringToUTF8(filename, filenamePtr, filenameLen);
-      const result = m._mmg2d_load_mesh(handle, filenamePtr);
-      if (result !== 1) {
-        throw new Error(`Failed to load mesh from ${filename}`);
-      }
+      appendToMemFile(m, file, data);
+      MMG2D.loadMeshFromMemFile(handle, file, format);
+    } finally {
+      freeMemFile(m, file);
+    }
+  },
+
+  /**
+   * Load a mesh from a stream of .mesh/.meshb file contents (e.g. a fetch
+   * body). Chunks are copied into WASM memory as they arrive, so the file is
+   * never held in full on the JS side.
+   * @param handle - The mesh handle
+   * @param stream - Byte stream of the mesh file
+   * @param format - File format (default: "mesh")
+   * @param sizeHint - Expected size in bytes (e.g. Content-Length), used to
+   *   preallocate the buffer
+   * @throws Error if reading the stream or loading fails
+   */
+  async loadMeshFromStream(
+    handle: MeshHandle2D,
+    stream: ReadableStream<Uint8Array>,
+    format: "mesh" | "meshb" = "mesh",
+    sizeHint = 0,
+  ): Promise<void> {
+    const m = getModule();
+    const file = createMemFile(m, sizeHint);
+    try {
+      await appendStreamToMemFile(m, file, stream.getReader());
+      MMG2D.loadMeshFromMemFile(handle, file, format);
     } finally {
-      m._free(filenamePtr);
+      freeMemFile(m, file);
+    }
+  },
+
+  /**
+   * Load a mesh from a memfile (see createMemFile).
+   * @param handle - The mesh handle
+   * @param file - Memfile holding the mesh file contents
+   * @param format - File format (default: "mesh")
+   * @throws Error if loading fails
+   */
+  loadMeshFromMemFile(
+    handle: MeshHandle2D,
+    file: number,
+    format: "mesh" | "meshb" = "mesh",
+  ): void {
+    const m = getModule();
+    const binary = format === "meshb" ? 1 : 0;
+    if (m._mmg2d_load_mesh_from_memfile(handle, file, binary) !== 1) {
+      throw new Error(`Failed to load MMG2D mesh from memory (${format})`);
     }
   },
 
@@ -942,18 +1409,37 @@ export const MMG2D = {
   saveMesh(handle: MeshHandle2D, filename: string): void {
     const m = getModule();
     const filenameLen = m.lengthBytesUTF8(filename) + 1;
-    const filenamePtr = m._malloc(filenameLen);
-    if (filenamePtr === 0) {
-      throw new Error("Failed to allocate memory for filename");
+    const [filenamePtr] = scratchMemory(m, [filenameLen]);
+    m.stringToUTF8(filename, filenamePtr, filenameLen);
+    const result = m._mmg2d_save_mesh(handle, filenamePtr);
+    if (result !== 1) {
+      throw new Error(`Failed to save mesh to ${filename}`);
     }
+  },
+
+  /**
+   * Save a mesh to .mesh/.meshb file contents in memory.
+   * The file is serialized straight into the WASM heap and copied out once,
+   * without going through the virtual filesystem.
+   * @param handle - The mesh handle
+   * @param format - File format (default: "mesh")
+   * @returns Contents of the mesh file
+   * @throws Error if saving fails
+   */
+  saveMeshToBuffer(
+    handle: MeshHandle2D,
+    format: "mesh" | "meshb" = "mesh",
+  ): Uint8Array {
+    const m = getModule();
+    const file = createMemFile(m);
     try {
-      m.stringToUTF8(filename, filenamePtr, filenameLen);
-      const result = m._mmg2d_save_mesh(handle, filenamePtr);
-      if (result !== 1) {
-        throw new Error(`Failed to save mesh to ${filename}`);
+      const binary = format === "meshb" ? 1 : 0;
+      if (m._mmg2d_save_mesh_to_memfile(handle, file, binary) !== 1) {
+        throw new Error(`Failed to save MMG2D mesh to memory (${format})`);
       }
+      return readMemFile(m, file);
     } finally {
-      m._free(filenamePtr);
+      freeMemFile(m, file);
     }
   },
 
@@ -967,18 +1453,39 @@ export const MMG2D = {
   loadSol(handle: MeshHandle2D, filename: string): void {
     const m = getModule();
     const filenameLen = m.lengthBytesUTF8(filename) + 1;
-    const filenamePtr = m._malloc(filenameLen);
-    if (filenamePtr === 0) {
-      throw new Error("Failed to allocate memory for filename");
+    const [filenamePtr] = scratchMemory(m, [filenameLen]);
+    m.stringToUTF8(filename, filenamePtr, filenameLen);
+    const result = m._mmg2d_load_sol(handle, filenamePtr);
+    if (result !== 1) {
+      throw new Error(`Failed to load solution from ${filename}`);
     }
+  },
+
+  /**
+   * Load a solution from .sol/.solb file contents held in memory, without
+   * going through the virtual filesystem.
+   * @param handle - The mesh handle
+   * @param data - Contents of the solution file
+   * @param format - File format (default: "sol")
+   * @throws Error if loading fails
+   */
+  loadSolFromBuffer(
+    handle: MeshHandle2D,
+    data: Uint8Array,
+    format: "sol" | "solb" = "sol",
+  ): void {
+    const m = getModule();
+    const file = createMemFile(m, data.length);
     try {
-      m.stringToUTF8(filename, filenamePtr, filenameLen);
-      const result = m._mmg2d_load_sol(handle, filenamePtr);
-      if (result !== 1) {
-        throw new Error(`Failed to load solution from ${filename}`);
+      appendToMemFile(m, file, data);
+      const binary = format === "solb" ? 1 : 0;
+      if (m._mmg2d_load_sol_from_memfile(handle, file, binary) !== 1) {
+        throw new Error(
+          `Failed to load MMG2D solution from memory (${format})`,
+        );
       }
     } finally {
-      m._free(filenamePtr);
+      freeMemFile(m, file);
     }
   },
 
@@ -992,18 +1499,36 @@ export const MMG2D = {
   saveSol(handle: MeshHandle2D, filename: string): void {
     const m = getModule();
     const filenameLen = m.lengthBytesUTF8(filename) + 1;
-    const filenamePtr = m._malloc(filenameLen);
-    if (filenamePtr === 0) {
-      throw new Error("Failed to allocate memory for filename");
+    const [filenamePtr] = scratchMemory(m, [filenameLen]);
+    m.stringToUTF8(filename, filenamePtr, filenameLen);
+    const result = m._mmg2d_save_sol(handle, filenamePtr);
+    if (result !== 1) {
+      throw new Error(`Failed to save solution to ${filename}`);
     }
+  },
+
+  /**
+   * Save the solution to .sol/.solb file contents in memory, without going
+   * through the virtual filesystem.
+   * @param handle - The mesh handle
+   * @param format - File format (default: "sol")
+   * @returns Contents of the solution file
+   * @throws Error if saving fails
+   */
+  saveSolToBuffer(
+    handle: MeshHandle2D,
+    format: "sol" | "solb" = "sol",
+  ): Uint8Array {
+    const m = getModule();
+    const file = createMemFile(m);
     try {
-      m.stringToUTF8(filename, filenamePtr, filenameLen);
-      const result = m._mmg2d_save_sol(handle, filenamePtr);
-      if (result !== 1) {
-        throw new Error(`Failed to save solution to ${filename}`);
+      const binary = format === "solb" ? 1 : 0;
+      if (m._mmg2d_save_sol_to_memfile(handle, file, binary) !== 1) {
+        throw new Error(`Failed to save MMG2D solution to memory (${format})`);
       }
+      return readMemFile(m, file);
     } finally {
-      m._free(filenamePtr);
+      freeMemFile(m, file);
     }
   },
 
@@ -1028,31 +1553,200 @@ export const MMG2D = {
   getTrianglesQualities(handle: MeshHandle2D): Float64Array {
     const m = getModule();
 
-    const countPtr = m._malloc(4);
-    if (countPtr === 0) {
-      throw new Error("Failed to allocate memory");
+    const [countPtr] = scratchMemory(m, [4]);
+    const dataPtr = m._mmg2d_get_triangles_qualities(handle, countPtr);
+    if (dataPtr === 0) {
+      const count = m.getValue(countPtr, "i32");
+      if (count === 0) {
+        return new Float64Array(0);
+      }
+      throw new Error("Failed to get triangles qualities");
     }
 
     try {
-      const dataPtr = m._mmg2d_get_triangles_qualities(handle, countPtr);
-      if (dataPtr === 0) {
-        const count = m.getValue(countPtr, "i32");
-        if (count === 0) {
-          return new Float64Array(0);
-        }
-        throw new Error("Failed to get triangles qualities");
-      }
+      const count = m.getValue(countPtr, "i32");
+      const result = new Float64Array(count);
+      result.set(m.HEAPF64.subarray(dataPtr / 8, dataPtr / 8 + count));
+      return result;
+    } finally {
+      m._mmg2d_free_array(dataPtr);
+    }
+  },
+
+  /**
+   * Compute element quality statistics without copying per-element qualities
+   * out of WASM memory.
+   * @param handle - The mesh handle
+   * @param nbins - Number of uniform histogram bins over [0, 1] (default 10)
+   * @returns Min, max and mean quality, element count and histogram
+   */
+  getQualityStats(handle: MeshHandle2D, nbins = 10): QualityStats2D {
+    if (!Number.isInteger(nbins) || nbins < 0) {
+      throw new Error(`Invalid histogram bin count: ${nbins}`);
+    }
 
-      try {
-        const count = m.getValue(countPtr, "i32");
-        const result = new Float64Array(count);
-        result.set(m.HEAPF64.subarray(dataPtr / 8, dataPtr / 8 + count));
-        return result;
-      } finally {
-        m._mmg2d_free_array(dataPtr);
+    const m = getModule();
+
+    // QualityStats struct: 3 doubles + 2 ints (32 bytes)
+    const [statsPtr, histogramPtr] = scratchMemory(m, [32, nbins * 4]);
+    const result = m._mmg2d_get_quality_stats(
+      handle,
+      nbins,
+      statsPtr,
+      histogramPtr,
+    );
+    if (result !== 1) {
+      throw new Error("Failed to compute quality statistics");
+    }
+
+    return {
+      min: m.HEAPF64[statsPtr / 8],
+      max: m.HEAPF64[statsPtr / 8 + 1],
+      mean: m.HEAPF64[statsPtr / 8 + 2],
+      count: m.HEAP32[(statsPtr + 24) / 4],
+      histogram: m.HEAP32.slice(histogramPtr / 4, histogramPtr / 4 + nbins),
+    };
+  },
+
+  /**
+   * Get the modification generation of a mesh.
+   * The value changes whenever the mesh is set, loaded or remeshed, which
+   * invalidates views obtained from the get*View methods.
+   * @param handle - The mesh handle
+   * @returns A non-zero generation number
+   * @throws Error if the handle is invalid
+   */
+  getGeneration(handle: MeshHandle2D): number {
+    const m = getModule();
+    const generation = m._mmg2d_get_generation(handle) >>> 0;
+    if (generation === 0) {
+      throw new Error("Invalid MMG2D mesh handle");
+    }
+    return generation;
+  },
+
+  /**
+   * Get a zero-copy view of all vertex coordinates.
+   *
+   * The returned array aliases a buffer owned by the mesh handle inside the
+   * WASM heap, so no data is copied. It is only valid until the mesh is
+   * modified (see getGeneration), the handle is freed, or the heap grows
+   * (see isHeapViewValid); call again to obtain a fresh view. Copy it with
+   * `slice()` to keep the data.
+   * @param handle - The mesh handle
+   * @returns Float64Array view of vertex coordinates [x0, y0, x1, y1, ...]
+   */
+  getVerticesView(handle: MeshHandle2D): Float64Array {
+    const m = getModule();
+    const [countPtr] = scratchMemory(m, [4]);
+    const dataPtr = m._mmg2d_view_vertices(handle, countPtr);
+    const count = m.getValue(countPtr, "i32");
+    if (dataPtr === 0) {
+      return new Float64Array(0);
+    }
+    return m.HEAPF64.subarray(dataPtr / 8, dataPtr / 8 + count * 2);
+  },
+
+  /**
+   * Get a zero-copy view of all triangles.
+   * Same validity rules as getVerticesView.
+   * @param handle - The mesh handle
+   * @returns Int32Array view of vertex indices (1-indexed), 3 per element
+   */
+  getTrianglesView(handle: MeshHandle2D): Int32Array {
+    const m = getModule();
+    const [countPtr] = scratchMemory(m, [4]);
+    const dataPtr = m._mmg2d_view_triangles(handle, countPtr);
+    const count = m.getValue(countPtr, "i32");
+    if (dataPtr === 0) {
+      return new Int32Array(0);
+    }
+    return m.HEAP32.subarray(dataPtr / 4, dataPtr / 4 + count * 3);
+  },
+
+  /**
+   * Get a zero-copy view of all edges.
+   * Same validity rules as getVerticesView.
+   * @param handle - The mesh handle
+   * @returns Int32Array view of vertex indices (1-indexed), 2 per element
+   */
+  getEdgesView(handle: MeshHandle2D): Int32Array {
+    const m = getModule();
+    const [countPtr] = scratchMemory(m, [4]);
+    const dataPtr = m._mmg2d_view_edges(handle, countPtr);
+    const count = m.getValue(countPtr, "i32");
+    if (dataPtr === 0) {
+      return new Int32Array(0);
+    }
+    return m.HEAP32.subarray(dataPtr / 4, dataPtr / 4 + count * 2);
+  },
+
+  /**
+   * Pack the mesh into the compact wire format (see decodePackedMesh):
+   * float32 or quantized positions, triangles and edges with 0-based
+   * indices, in one buffer that can be transferred to another thread.
+   * @param handle - The mesh handle
+   * @param options - Quantization and boundary-only packing
+   * @returns Copy of the packed mesh
+   * @throws Error if packing fails
+   */
+  packMesh(handle: MeshHandle2D, options: PackOptions = {}): Uint8Array {
+    const m = getModule();
+    const [sizePtr] = scratchMemory(m, [4]);
+    const dataPtr = m._mmg2d_pack_mesh(handle, packFlags(options), sizePtr);
+    if (dataPtr === 0) {
+      throw new Error("Failed to pack mesh");
+    }
+    return m.HEAPU8.slice(dataPtr, dataPtr + m.getValue(sizePtr, "i32"));
+  },
+
+  /**
+   * Remesh many meshes in one native call, with the same parameters.
+   * Every mesh is staged in one buffer, remeshed in a fresh MMG structure
+   * and written into one result buffer, copied back at once.
+   * @param meshes - Vertices, triangles, boundary edges, their
+   *   references and an optional metric (1 or 3 values per vertex) of
+   *   each mesh
+   * @param parameters - MMG parameters set on every mesh (see
+   *   optionParameters)
+   * @returns One result per mesh, in order
+   * @throws Error if an array has the wrong length or the batch fails
+   */
+  remeshBatch(
+    meshes: MeshImportData[],
+    parameters: OptionParameter[] = [],
+  ): BatchRemeshResult[] {
+    const m = getModule();
+    const handle = m._mmg2d_init();
+    if (handle < 0) {
+      throw new Error("Failed to initialize MMG2D mesh (max handles reached?)");
+    }
+    try {
+      const [meshesPtr, parametersPtr, sizePtr] = packMeshImports(
+        m,
+        meshes,
+        IMPORT_LAYOUT,
+        [parameters.length * BATCH_PARAMETER_BYTES, 4],
+      );
+      writeBatchParameters(m, parametersPtr, parameters);
+      const dataPtr = m._mmg2d_remesh_batch(
+        handle,
+        meshesPtr,
+        meshes.length,
+        parametersPtr,
+        parameters.length,
+        sizePtr,
+      );
+      if (dataPtr === 0) {
+        throw new Error("Failed to remesh batch");
       }
+      const bytes = m.HEAPU8.slice(
+        dataPtr,
+        dataPtr + m.getValue(sizePtr, "i32"),
+      );
+      return decodeBatch(bytes, IMPORT_LAYOUT, meshes);
     } finally {
-      m._free(countPtr);
+      m._mmg2d_free(handle);
     }
   },
 };
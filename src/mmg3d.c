@@ -10,10 +10,24 @@
  */
 
 #include <emscripten.h>
+#include <math.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include "arena.h"
+#include "batch.h"
+#include "import.h"
+#include "locate.h"
+#include "memfile.h"
+#include "pack.h"
+#include "partition.h"
+#include "progress.h"
+#include "sizing.h"
+#include "stats.h"
+#include "surface.h"
+#include "threads.h"
 #include "mmg/mmg3d/libmmg3d.h"
+#include "mmg3d/libmmg3d_private.h"
 
 /*
  * Verify MMG5_int is 32-bit. This assumption is used when casting between
@@ -24,65 +38,158 @@ _Static_assert(sizeof(MMG5_int) == sizeof(int32_t),
     "MMG5_int must be 32-bit for JavaScript bindings");
 
 /*
- * Maximum number of concurrent mesh handles.
- * This limit exists because handles are stored in a fixed-size array.
- * For typical browser usage, 64 concurrent meshes should be sufficient.
- * Use mmg3d_get_available_handles() to check current capacity.
+ * Handle registry limits.
+ * Entries live in pages of HANDLE_PAGE_SIZE slots allocated on demand, so the
+ * table grows up to the configured maximum without ever moving an entry.
+ * The maximum defaults to DEFAULT_MAX_HANDLES and can be changed with
+ * mmg3d_set_max_handles(), up to HANDLE_LIMIT.
  */
-#define MAX_HANDLES 64
+#define HANDLE_PAGE_SIZE 64
+#define HANDLE_MAX_PAGES 1024
+#define HANDLE_LIMIT (HANDLE_PAGE_SIZE * HANDLE_MAX_PAGES)
+#define DEFAULT_MAX_HANDLES 1024
+
+/*
+ * Wrapper-owned packed buffer backing a zero-copy view.
+ * The buffer only grows and is repacked lazily when the mesh generation
+ * differs from the one it was packed at.
+ */
+typedef struct {
+    void* data;
+    size_t capacity;          /* allocated bytes */
+    int count;                /* number of packed entities */
+    unsigned int generation;  /* mesh generation at pack time, 0 = never */
+} ViewBuffer;
 
 /* Handle table entry storing mesh and solution pointers */
 typedef struct {
     MMG5_pMesh mesh;
     MMG5_pSol sol;
-    int active;
+    int active;               /* 0 = free, 1 = in use, -1 = reserved */
+    int next_free;            /* next slot on the free list, -1 = end */
+    int busy;                 /* 1 while an asynchronous remesh is running */
+    int async_result;         /* return code of the last asynchronous remesh */
+    unsigned int generation;  /* bumped whenever the mesh is modified */
+    MmgwasmProgress progress; /* progress/abort record shared with JS */
+    MmgwasmStats stats;       /* last remesh, instrumentation build only */
+    ViewBuffer view_vertices;
+    ViewBuffer view_tetrahedra;
+    ViewBuffer view_triangles;
+    ViewBuffer packed;        /* last mesh packed by mmg3d_pack_mesh */
+    ViewBuffer batch;         /* results of the last mmg3d_remesh_batch */
+    MmgwasmLocator locator;   /* element index for point queries */
+    MmgwasmSurface surface;   /* last display surface extracted */
+    MmgwasmArena arena;       /* MMG allocations in arena mode */
 } HandleEntry;
 
-/* Global handle table */
-static HandleEntry g_handles[MAX_HANDLES];
-static int g_initialized = 0;
+/*
+ * Global handle registry.
+ * Slots below g_handle_count have been handed out at least once; released
+ * ones are chained into a free list, so allocation and release are O(1).
+ */
+static HandleEntry* g_handle_pages[HANDLE_MAX_PAGES];
+static int g_handle_count = 0;   /* slots handed out so far */
+static int g_free_head = -1;     /* most recently released slot, -1 = none */
+static int g_free_count = 0;     /* number of slots on the free list */
+static int g_max_handles = DEFAULT_MAX_HANDLES;
+static int g_arena_mode = 0;      /* 1: new handles allocate from arenas */
 
-/* Initialize the handle table (called automatically on first use) */
-static void ensure_initialized(void) {
-    if (!g_initialized) {
-        memset(g_handles, 0, sizeof(g_handles));
-        g_initialized = 1;
-    }
-}
+/* Entry for a handle, which must be below g_handle_count */
+#define HANDLE(h) \
+    (g_handle_pages[(h) / HANDLE_PAGE_SIZE][(h) % HANDLE_PAGE_SIZE])
 
-/* Find a free handle slot, returns -1 if none available */
+/* Protects the handle table in the pthreads build (no-op otherwise) */
+MMGWASM_MUTEX(g_handles_lock);
+
+/* Global generation counter, so generations stay unique across slot reuse */
+static unsigned int g_generation = 0;
+
+/*
+ * Reserve a handle slot, returns -1 if the maximum is reached.
+ * Reuses the most recently released slot, otherwise takes the next unused
+ * one, allocating its page on first use.
+ * The slot must then be activated or released by the caller.
+ */
 static int find_free_handle(void) {
-    ensure_initialized();
-    for (int i = 0; i < MAX_HANDLES; i++) {
-        if (!g_handles[i].active) {
-            return i;
+    int handle = -1;
+    MMGWASM_LOCK(g_handles_lock);
+    if (g_free_head >= 0) {
+        handle = g_free_head;
+        g_free_head = HANDLE(handle).next_free;
+        g_free_count--;
+    } else if (g_handle_count < g_max_handles) {
+        int page = g_handle_count / HANDLE_PAGE_SIZE;
+        if (!g_handle_pages[page]) {
+            g_handle_pages[page] = (HandleEntry*)calloc(HANDLE_PAGE_SIZE, sizeof(HandleEntry));
         }
+        if (g_handle_pages[page]) {
+            handle = g_handle_count++;
+        }
+    }
+    if (handle >= 0) {
+        HANDLE(handle).active = -1;
     }
-    return -1;
+    MMGWASM_UNLOCK(g_handles_lock);
+    return handle;
+}
+
+/* Release a reserved handle slot onto the free list */
+static void release_handle(int handle) {
+    MMGWASM_LOCK(g_handles_lock);
+    memset(&HANDLE(handle), 0, sizeof(HandleEntry));
+    HANDLE(handle).next_free = g_free_head;
+    g_free_head = handle;
+    g_free_count++;
+    MMGWASM_UNLOCK(g_handles_lock);
 }
 
 /* Validate a handle, returns 1 if valid, 0 otherwise */
 static int validate_handle(int handle) {
-    ensure_initialized();
-    if (handle < 0 || handle >= MAX_HANDLES) {
-        return 0;
+    MMGWASM_LOCK(g_handles_lock);
+    int valid = handle >= 0 && handle < g_handle_count &&
+        HANDLE(handle).active == 1;
+    MMGWASM_UNLOCK(g_handles_lock);
+    return valid;
+}
+
+/* Record that the mesh behind a handle changed, invalidating its views */
+static void mark_modified(int handle) {
+    MMGWASM_LOCK(g_handles_lock);
+    if (++g_generation == 0) {
+        g_generation = 1;  /* 0 is reserved for "never packed" */
+    }
+    HANDLE(handle).generation = g_generation;
+    MMGWASM_UNLOCK(g_handles_lock);
+}
+
+/* Grow a view buffer to at least bytes, returns NULL on allocation failure */
+static void* view_reserve(ViewBuffer* view, size_t bytes) {
+    if (bytes > view->capacity) {
+        void* data = realloc(view->data, bytes);
+        if (!data) {
+            return NULL;
+        }
+        view->data = data;
+        view->capacity = bytes;
     }
-    return g_handles[handle].active;
+    return view->data;
+}
+
+/* Release a view buffer */
+static void view_release(ViewBuffer* view) {
+    free(view->data);
+    memset(view, 0, sizeof(*view));
 }
 
 /**
  * Get the number of available (free) mesh handle slots.
- * Returns a value between 0 and MAX_HANDLES.
+ * Returns a value between 0 and the maximum number of handles.
  */
 EMSCRIPTEN_KEEPALIVE
 int mmg3d_get_available_handles(void) {
-    ensure_initialized();
-    int count = 0;
-    for (int i = 0; i < MAX_HANDLES; i++) {
-        if (!g_handles[i].active) {
-            count++;
-        }
-    }
+    MMGWASM_LOCK(g_handles_lock);
+    int count = g_max_handles - g_handle_count + g_free_count;
+    MMGWASM_UNLOCK(g_handles_lock);
     return count;
 }
 
@@ -91,12 +198,65 @@ int mmg3d_get_available_handles(void) {
  */
 EMSCRIPTEN_KEEPALIVE
 int mmg3d_get_max_handles(void) {
-    return MAX_HANDLES;
+    MMGWASM_LOCK(g_handles_lock);
+    int max_handles = g_max_handles;
+    MMGWASM_UNLOCK(g_handles_lock);
+    return max_handles;
+}
+
+/**
+ * Set the maximum number of concurrent mesh handles.
+ * The maximum cannot be lowered below the number of slots already handed
+ * out, nor raised above HANDLE_LIMIT.
+ * Returns 1 on success, 0 on failure.
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg3d_set_max_handles(int max_handles) {
+    int result = 0;
+    MMGWASM_LOCK(g_handles_lock);
+    if (max_handles > 0 && max_handles <= HANDLE_LIMIT &&
+        max_handles >= g_handle_count) {
+        g_max_handles = max_handles;
+        result = 1;
+    }
+    MMGWASM_UNLOCK(g_handles_lock);
+    return result;
+}
+
+/**
+ * Choose whether handles created from now on allocate MMG's memory from a
+ * per-handle arena (see arena.h), released in one step by mmg3d_free.
+ * Existing handles keep their mode.
+ */
+EMSCRIPTEN_KEEPALIVE
+void mmg3d_set_arena_mode(int enabled) {
+    MMGWASM_LOCK(g_handles_lock);
+    g_arena_mode = enabled != 0;
+    MMGWASM_UNLOCK(g_handles_lock);
+}
+
+/**
+ * Get the memory held for a handle.
+ * out receives 3 doubles: the bytes MMG accounts to the mesh and solution
+ * (mesh->memCur), MMG's memory limit for them (mesh->memMax, set through the
+ * mem parameter) and the bytes of the handle's arena (0 outside arena mode).
+ * Returns 1 on success, 0 on failure.
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg3d_get_memory_usage(int handle, double* out) {
+    if (!validate_handle(handle) || !out) {
+        return 0;
+    }
+    MMG5_pMesh mesh = HANDLE(handle).mesh;
+    out[0] = (double)mesh->memCur;
+    out[1] = (double)mesh->memMax;
+    out[2] = (double)HANDLE(handle).arena.capacity;
+    return 1;
 }
 
 /**
  * Initialize a new MMG3D mesh and solution structure.
- * Returns a handle (0-63) on success, -1 on failure.
+ * Returns a handle (0 to max handles - 1) on success, -1 on failure.
  */
 EMSCRIPTEN_KEEPALIVE
 int mmg3d_init(void) {
@@ -108,24 +268,37 @@ int mmg3d_init(void) {
     MMG5_pMesh mesh = NULL;
     MMG5_pSol sol = NULL;
 
+    MMGWASM_LOCK(g_handles_lock);
+    HANDLE(handle).arena.enabled = g_arena_mode;
+    MMGWASM_UNLOCK(g_handles_lock);
+
+    MmgwasmArena* outer = mmgwasm_arena_enter(&HANDLE(handle).arena);
     int result = MMG3D_Init_mesh(
         MMG5_ARG_start,
         MMG5_ARG_ppMesh, &mesh,
         MMG5_ARG_ppMet, &sol,
         MMG5_ARG_end
     );
+    if (result == 1 && mesh != NULL) {
+        /* Initialize default parameters */
+        MMG3D_Init_parameters(mesh);
+    }
+    mmgwasm_arena_leave(outer);
 
     if (result != 1 || mesh == NULL) {
+        mmgwasm_arena_release(&HANDLE(handle).arena);
+        release_handle(handle);
         return -1;  /* Initialization failed */
     }
 
-    /* Initialize default parameters */
-    MMG3D_Init_parameters(mesh);
-
     /* Store in handle table */
-    g_handles[handle].mesh = mesh;
-    g_handles[handle].sol = sol;
-    g_handles[handle].active = 1;
+    MMGWASM_LOCK(g_handles_lock);
+    HANDLE(handle).mesh = mesh;
+    HANDLE(handle).sol = sol;
+    HANDLE(handle).async_result = -1;
+    HANDLE(handle).active = 1;
+    MMGWASM_UNLOCK(g_handles_lock);
+    mark_modified(handle);
 
     return handle;
 }
@@ -136,27 +309,200 @@ int mmg3d_init(void) {
  */
 EMSCRIPTEN_KEEPALIVE
 int mmg3d_free(int handle) {
-    if (!validate_handle(handle)) {
-        return 0;
+    /* Reserve the slot so it cannot be reused or freed twice meanwhile */
+    MMGWASM_LOCK(g_handles_lock);
+    if (handle < 0 || handle >= g_handle_count ||
+        HANDLE(handle).active != 1 || HANDLE(handle).busy) {
+        MMGWASM_UNLOCK(g_handles_lock);
+        return 0;  /* Invalid handle, or a remesh is still running */
     }
+    HANDLE(handle).active = -1;
+    MMGWASM_UNLOCK(g_handles_lock);
 
-    MMG5_pMesh mesh = g_handles[handle].mesh;
-    MMG5_pSol sol = g_handles[handle].sol;
+    MMG5_pMesh mesh = HANDLE(handle).mesh;
+    MMG5_pSol sol = HANDLE(handle).sol;
 
+    MmgwasmArena* outer = mmgwasm_arena_enter(&HANDLE(handle).arena);
     MMG3D_Free_all(
         MMG5_ARG_start,
         MMG5_ARG_ppMesh, &mesh,
         MMG5_ARG_ppMet, &sol,
         MMG5_ARG_end
     );
+    mmgwasm_arena_leave(outer);
+    mmgwasm_arena_release(&HANDLE(handle).arena);
+
+    view_release(&HANDLE(handle).view_vertices);
+    view_release(&HANDLE(handle).view_tetrahedra);
+    view_release(&HANDLE(handle).view_triangles);
+    view_release(&HANDLE(handle).packed);
+    view_release(&HANDLE(handle).batch);
+    mmgwasm_locator_free(&HANDLE(handle).locator);
+    mmgwasm_surface_free(&HANDLE(handle).surface);
+    release_handle(handle);
+
+    return 1;
+}
+
+/**
+ * Copy the mesh entities of src into dst, preserving refs and tags.
+ * dst must be a freshly initialized mesh. Scratch arrays are sized for the
+ * largest entity family and reused for each one.
+ * Returns 1 on success, 0 on failure.
+ */
+static int clone_mesh_3d(MMG5_pMesh src, MMG5_pMesh dst) {
+    MMG5_int np, ne, nprism, nt, nquad, na;
+    if (MMG3D_Get_meshSize(src, &np, &ne, &nprism, &nt, &nquad, &na) != 1) {
+        return 0;
+    }
+    if (MMG3D_Set_meshSize(dst, np, ne, nprism, nt, nquad, na) != 1) {
+        return 0;
+    }
+
+    MMG5_int n = np;
+    if (ne > n) n = ne;
+    if (nprism > n) n = nprism;
+    if (nt > n) n = nt;
+    if (nquad > n) n = nquad;
+    if (na > n) n = na;
+    if (n == 0) {
+        return 1;
+    }
+
+    int ok = 0;
+    double* coords = NULL;
+    MMG5_int* ids = NULL;
+    MMG5_int* refs = NULL;
+    int* flags_a = NULL;
+    int* flags_b = NULL;
+
+    coords = (double*)malloc((3 * np + 1) * sizeof(double));
+    ids = (MMG5_int*)malloc(6 * n * sizeof(MMG5_int));  /* prisms have 6 vertices */
+    refs = (MMG5_int*)malloc(n * sizeof(MMG5_int));
+    flags_a = (int*)malloc(n * sizeof(int));
+    flags_b = (int*)malloc(n * sizeof(int));
+    if (!coords || !ids || !refs || !flags_a || !flags_b) {
+        goto cleanup;
+    }
+
+    if (np > 0) {
+        /* flags_a: corners, flags_b: required */
+        if (MMG3D_Get_vertices(src, coords, refs, flags_a, flags_b) != 1) goto cleanup;
+        if (MMG3D_Set_vertices(dst, coords, refs) != 1) goto cleanup;
+        for (MMG5_int k = 0; k < np; k++) {
+            if (flags_a[k] && MMG3D_Set_corner(dst, k + 1) != 1) goto cleanup;
+            if (flags_b[k] && MMG3D_Set_requiredVertex(dst, k + 1) != 1) goto cleanup;
+        }
+    }
+
+    if (ne > 0) {
+        if (MMG3D_Get_tetrahedra(src, ids, refs, flags_b) != 1) goto cleanup;
+        if (MMG3D_Set_tetrahedra(dst, ids, refs) != 1) goto cleanup;
+        for (MMG5_int k = 0; k < ne; k++) {
+            if (flags_b[k] && MMG3D_Set_requiredTetrahedron(dst, k + 1) != 1) goto cleanup;
+        }
+    }
+
+    if (nprism > 0) {
+        if (MMG3D_Get_prisms(src, ids, refs, flags_b) != 1) goto cleanup;
+        if (MMG3D_Set_prisms(dst, ids, refs) != 1) goto cleanup;
+    }
+
+    if (nt > 0) {
+        if (MMG3D_Get_triangles(src, ids, refs, flags_b) != 1) goto cleanup;
+        if (MMG3D_Set_triangles(dst, ids, refs) != 1) goto cleanup;
+        for (MMG5_int k = 0; k < nt; k++) {
+            if (flags_b[k] && MMG3D_Set_requiredTriangle(dst, k + 1) != 1) goto cleanup;
+        }
+    }
+
+    if (nquad > 0) {
+        if (MMG3D_Get_quadrilaterals(src, ids, refs, flags_b) != 1) goto cleanup;
+        if (MMG3D_Set_quadrilaterals(dst, ids, refs) != 1) goto cleanup;
+    }
+
+    if (na > 0) {
+        /* flags_a: ridges, flags_b: required */
+        if (MMG3D_Get_edges(src, ids, refs, flags_a, flags_b) != 1) goto cleanup;
+        if (MMG3D_Set_edges(dst, ids, refs) != 1) goto cleanup;
+        for (MMG5_int k = 0; k < na; k++) {
+            if (flags_a[k] && MMG3D_Set_ridge(dst, k + 1) != 1) goto cleanup;
+            if (flags_b[k] && MMG3D_Set_requiredEdge(dst, k + 1) != 1) goto cleanup;
+        }
+    }
+
+    ok = 1;
 
-    g_handles[handle].mesh = NULL;
-    g_handles[handle].sol = NULL;
-    g_handles[handle].active = 0;
+cleanup:
+    free(coords);
+    free(ids);
+    free(refs);
+    free(flags_a);
+    free(flags_b);
+    return ok;
+}
+
+/**
+ * Copy the solution (metric) field of src into dst.
+ * The values are copied straight from sol->m, whatever the solution type.
+ * Returns 1 on success (including when src has no solution), 0 on failure.
+ */
+static int clone_sol_3d(MMG5_pMesh src_mesh, MMG5_pSol src,
+                        MMG5_pMesh dst_mesh, MMG5_pSol dst) {
+    int typEntity, typSol;
+    MMG5_int np;
+    if (MMG3D_Get_solSize(src_mesh, src, &typEntity, &np, &typSol) != 1) {
+        return 0;
+    }
+    if (np == 0 || !src->m) {
+        return 1;
+    }
+    if (MMG3D_Set_solSize(dst_mesh, dst, typEntity, np, typSol) != 1) {
+        return 0;
+    }
 
+    /* sol->m is 1-indexed: entity k occupies m[k*size .. k*size+size-1] */
+    memcpy(dst->m, src->m, (size_t)(np + 1) * src->size * sizeof(double));
     return 1;
 }
 
+/**
+ * Duplicate a mesh and its solution into a new handle.
+ * Vertices, elements, boundary entities, refs, corner/ridge/required tags
+ * and the metric field are copied inside WASM memory; parameters other than
+ * verbosity keep their defaults.
+ * Returns the new handle on success, -1 on failure.
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg3d_clone(int handle) {
+    if (!validate_handle(handle)) {
+        return -1;
+    }
+
+    int clone = mmg3d_init();
+    if (clone < 0) {
+        return -1;
+    }
+
+    HandleEntry* src = &HANDLE(handle);
+    HandleEntry* dst = &HANDLE(clone);
+
+    MmgwasmArena* outer = mmgwasm_arena_enter(&dst->arena);
+    int ok = clone_mesh_3d(src->mesh, dst->mesh) &&
+        clone_sol_3d(src->mesh, src->sol, dst->mesh, dst->sol);
+    mmgwasm_arena_leave(outer);
+    if (!ok) {
+        mmg3d_free(clone);
+        return -1;
+    }
+
+    MMG3D_Set_iparameter(dst->mesh, dst->sol, MMG3D_IPARAM_verbose,
+                         src->mesh->info.imprim);
+    mark_modified(clone);
+
+    return clone;
+}
+
 /**
  * Set mesh size (allocate memory for mesh entities).
  * Returns 1 on success, 0 on failure.
@@ -167,8 +513,9 @@ int mmg3d_set_mesh_size(int handle, int np, int ne, int nprism, int nt, int nqua
         return 0;
     }
 
-    return MMG3D_Set_meshSize(
-        g_handles[handle].mesh,
+    MmgwasmArena* outer = mmgwasm_arena_enter(&HANDLE(handle).arena);
+    int result = MMG3D_Set_meshSize(
+        HANDLE(handle).mesh,
         (MMG5_int)np,      /* number of vertices */
         (MMG5_int)ne,      /* number of tetrahedra */
         (MMG5_int)nprism,  /* number of prisms */
@@ -176,6 +523,11 @@ int mmg3d_set_mesh_size(int handle, int np, int ne, int nprism, int nt, int nqua
         (MMG5_int)nquad,   /* number of quadrilaterals */
         (MMG5_int)na       /* number of edges */
     );
+    mmgwasm_arena_leave(outer);
+    if (result == 1) {
+        mark_modified(handle);
+    }
+    return result;
 }
 
 /**
@@ -192,7 +544,7 @@ int mmg3d_get_mesh_size(int handle, int* np, int* ne, int* nprism, int* nt, int*
     MMG5_int _np, _ne, _nprism, _nt, _nquad, _na;
 
     int result = MMG3D_Get_meshSize(
-        g_handles[handle].mesh,
+        HANDLE(handle).mesh,
         &_np, &_ne, &_nprism, &_nt, &_nquad, &_na
     );
 
@@ -219,12 +571,16 @@ int mmg3d_set_vertex(int handle, double x, double y, double z, int ref, int pos)
         return 0;
     }
 
-    return MMG3D_Set_vertex(
-        g_handles[handle].mesh,
+    int result = MMG3D_Set_vertex(
+        HANDLE(handle).mesh,
         x, y, z,
         (MMG5_int)ref,
         (MMG5_int)pos
     );
+    if (result == 1) {
+        mark_modified(handle);
+    }
+    return result;
 }
 
 /**
@@ -239,11 +595,15 @@ int mmg3d_set_vertices(int handle, double* vertices, int* refs) {
         return 0;
     }
 
-    return MMG3D_Set_vertices(
-        g_handles[handle].mesh,
+    int result = MMG3D_Set_vertices(
+        HANDLE(handle).mesh,
         vertices,
         (MMG5_int*)refs
     );
+    if (result == 1) {
+        mark_modified(handle);
+    }
+    return result;
 }
 
 /**
@@ -261,7 +621,7 @@ double* mmg3d_get_vertices(int handle, int* out_count) {
     }
 
     MMG5_int np, ne, nprism, nt, nquad, na;
-    if (MMG3D_Get_meshSize(g_handles[handle].mesh, &np, &ne, &nprism, &nt, &nquad, &na) != 1) {
+    if (MMG3D_Get_meshSize(HANDLE(handle).mesh, &np, &ne, &nprism, &nt, &nquad, &na) != 1) {
         if (out_count) *out_count = 0;
         return NULL;
     }
@@ -293,7 +653,7 @@ double* mmg3d_get_vertices(int handle, int* out_count) {
     }
 
     int result = MMG3D_Get_vertices(
-        g_handles[handle].mesh,
+        HANDLE(handle).mesh,
         vertices,
         refs,
         corners,
@@ -326,12 +686,16 @@ int mmg3d_set_tetrahedron(int handle, int v0, int v1, int v2, int v3, int ref, i
         return 0;
     }
 
-    return MMG3D_Set_tetrahedron(
-        g_handles[handle].mesh,
+    int result = MMG3D_Set_tetrahedron(
+        HANDLE(handle).mesh,
         (MMG5_int)v0, (MMG5_int)v1, (MMG5_int)v2, (MMG5_int)v3,
         (MMG5_int)ref,
         (MMG5_int)pos
     );
+    if (result == 1) {
+        mark_modified(handle);
+    }
+    return result;
 }
 
 /**
@@ -346,11 +710,15 @@ int mmg3d_set_tetrahedra(int handle, int* tetra, int* refs) {
         return 0;
     }
 
-    return MMG3D_Set_tetrahedra(
-        g_handles[handle].mesh,
+    int result = MMG3D_Set_tetrahedra(
+        HANDLE(handle).mesh,
         (MMG5_int*)tetra,
         (MMG5_int*)refs
     );
+    if (result == 1) {
+        mark_modified(handle);
+    }
+    return result;
 }
 
 /**
@@ -368,7 +736,7 @@ int* mmg3d_get_tetrahedra(int handle, int* out_count) {
     }
 
     MMG5_int np, ne, nprism, nt, nquad, na;
-    if (MMG3D_Get_meshSize(g_handles[handle].mesh, &np, &ne, &nprism, &nt, &nquad, &na) != 1) {
+    if (MMG3D_Get_meshSize(HANDLE(handle).mesh, &np, &ne, &nprism, &nt, &nquad, &na) != 1) {
         if (out_count) *out_count = 0;
         return NULL;
     }
@@ -398,7 +766,7 @@ int* mmg3d_get_tetrahedra(int handle, int* out_count) {
     }
 
     int result = MMG3D_Get_tetrahedra(
-        g_handles[handle].mesh,
+        HANDLE(handle).mesh,
         tetra,
         refs,
         required
@@ -429,12 +797,16 @@ int mmg3d_set_triangle(int handle, int v0, int v1, int v2, int ref, int pos) {
         return 0;
     }
 
-    return MMG3D_Set_triangle(
-        g_handles[handle].mesh,
+    int result = MMG3D_Set_triangle(
+        HANDLE(handle).mesh,
         (MMG5_int)v0, (MMG5_int)v1, (MMG5_int)v2,
         (MMG5_int)ref,
         (MMG5_int)pos
     );
+    if (result == 1) {
+        mark_modified(handle);
+    }
+    return result;
 }
 
 /**
@@ -449,11 +821,15 @@ int mmg3d_set_triangles(int handle, int* tria, int* refs) {
         return 0;
     }
 
-    return MMG3D_Set_triangles(
-        g_handles[handle].mesh,
+    int result = MMG3D_Set_triangles(
+        HANDLE(handle).mesh,
         (MMG5_int*)tria,
         (MMG5_int*)refs
     );
+    if (result == 1) {
+        mark_modified(handle);
+    }
+    return result;
 }
 
 /**
@@ -471,7 +847,7 @@ int* mmg3d_get_triangles(int handle, int* out_count) {
     }
 
     MMG5_int np, ne, nprism, nt, nquad, na;
-    if (MMG3D_Get_meshSize(g_handles[handle].mesh, &np, &ne, &nprism, &nt, &nquad, &na) != 1) {
+    if (MMG3D_Get_meshSize(HANDLE(handle).mesh, &np, &ne, &nprism, &nt, &nquad, &na) != 1) {
         if (out_count) *out_count = 0;
         return NULL;
     }
@@ -501,7 +877,7 @@ int* mmg3d_get_triangles(int handle, int* out_count) {
     }
 
     int result = MMG3D_Get_triangles(
-        g_handles[handle].mesh,
+        HANDLE(handle).mesh,
         tria,
         refs,
         required
@@ -531,12 +907,16 @@ int mmg3d_set_iparameter(int handle, int iparam, int val) {
         return 0;
     }
 
-    return MMG3D_Set_iparameter(
-        g_handles[handle].mesh,
-        g_handles[handle].sol,
+    /* Some parameters allocate (e.g. the local parameter array) */
+    MmgwasmArena* outer = mmgwasm_arena_enter(&HANDLE(handle).arena);
+    int result = MMG3D_Set_iparameter(
+        HANDLE(handle).mesh,
+        HANDLE(handle).sol,
         iparam,
         (MMG5_int)val
     );
+    mmgwasm_arena_leave(outer);
+    return result;
 }
 
 /**
@@ -551,8 +931,8 @@ int mmg3d_set_dparameter(int handle, int dparam, double val) {
     }
 
     return MMG3D_Set_dparameter(
-        g_handles[handle].mesh,
-        g_handles[handle].sol,
+        HANDLE(handle).mesh,
+        HANDLE(handle).sol,
         dparam,
         val
     );
@@ -571,13 +951,16 @@ int mmg3d_set_sol_size(int handle, int typEntity, int np, int typSol) {
         return 0;
     }
 
-    return MMG3D_Set_solSize(
-        g_handles[handle].mesh,
-        g_handles[handle].sol,
+    MmgwasmArena* outer = mmgwasm_arena_enter(&HANDLE(handle).arena);
+    int result = MMG3D_Set_solSize(
+        HANDLE(handle).mesh,
+        HANDLE(handle).sol,
         typEntity,
         (MMG5_int)np,
         typSol
     );
+    mmgwasm_arena_leave(outer);
+    return result;
 }
 
 /**
@@ -595,8 +978,8 @@ int mmg3d_get_sol_size(int handle, int* typEntity, int* np, int* typSol) {
     int _typEntity, _typSol;
 
     int result = MMG3D_Get_solSize(
-        g_handles[handle].mesh,
-        g_handles[handle].sol,
+        HANDLE(handle).mesh,
+        HANDLE(handle).sol,
         &_typEntity,
         &_np,
         &_typSol
@@ -622,7 +1005,7 @@ int mmg3d_set_scalar_sols(int handle, double* values) {
         return 0;
     }
 
-    return MMG3D_Set_scalarSols(g_handles[handle].sol, values);
+    return MMG3D_Set_scalarSols(HANDLE(handle).sol, values);
 }
 
 /**
@@ -642,7 +1025,7 @@ double* mmg3d_get_scalar_sols(int handle, int* out_count) {
     /* Get solution size to determine number of entities */
     int typEntity, typSol;
     MMG5_int np;
-    if (MMG3D_Get_solSize(g_handles[handle].mesh, g_handles[handle].sol,
+    if (MMG3D_Get_solSize(HANDLE(handle).mesh, HANDLE(handle).sol,
                           &typEntity, &np, &typSol) != 1) {
         if (out_count) *out_count = 0;
         return NULL;
@@ -660,7 +1043,7 @@ double* mmg3d_get_scalar_sols(int handle, int* out_count) {
         return NULL;
     }
 
-    int result = MMG3D_Get_scalarSols(g_handles[handle].sol, values);
+    int result = MMG3D_Get_scalarSols(HANDLE(handle).sol, values);
     if (result != 1) {
         free(values);
         if (out_count) *out_count = 0;
@@ -682,7 +1065,54 @@ int mmg3d_set_tensor_sols(int handle, double* values) {
         return 0;
     }
 
-    return MMG3D_Set_tensorSols(g_handles[handle].sol, values);
+    return MMG3D_Set_tensorSols(HANDLE(handle).sol, values);
+}
+
+/**
+ * Import a whole mesh from a packed descriptor (see import.h): sizes the
+ * mesh, sets vertices, tetrahedra, boundary triangles and their references,
+ * and fills the metric when one is given (metric_size 1 or 6).
+ * Returns 1 on success, 0 on failure.
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg3d_import_mesh(int handle, const MmgwasmMeshImport* desc) {
+    if (!validate_handle(handle) || !desc || desc->np < 0 || desc->ne < 0 ||
+        desc->nb < 0 || (desc->np > 0 && !desc->vertices) ||
+        (desc->ne > 0 && !desc->cells) || (desc->nb > 0 && !desc->boundary) ||
+        (desc->metric_size != 0 && desc->metric_size != 1 &&
+         desc->metric_size != 6) ||
+        (desc->metric_size != 0 && (!desc->metric || desc->np == 0))) {
+        return 0;
+    }
+
+    MMG5_pMesh mesh = HANDLE(handle).mesh;
+    MMG5_pSol sol = HANDLE(handle).sol;
+    MmgwasmArena* outer = mmgwasm_arena_enter(&HANDLE(handle).arena);
+    int result = MMG3D_Set_meshSize(mesh, desc->np, desc->ne, 0, desc->nb,
+                                    0, 0) == 1;
+    if (result && desc->np > 0) {
+        result = MMG3D_Set_vertices(mesh, (double*)desc->vertices,
+                                    (MMG5_int*)desc->vertex_refs) == 1;
+    }
+    if (result && desc->ne > 0) {
+        result = MMG3D_Set_tetrahedra(mesh, (MMG5_int*)desc->cells,
+                                      (MMG5_int*)desc->cell_refs) == 1;
+    }
+    if (result && desc->nb > 0) {
+        result = MMG3D_Set_triangles(mesh, (MMG5_int*)desc->boundary,
+                                     (MMG5_int*)desc->boundary_refs) == 1;
+    }
+    if (result && desc->metric_size != 0) {
+        int scalar = desc->metric_size == 1;
+        result = MMG3D_Set_solSize(mesh, sol, MMG5_Vertex, desc->np,
+                                   scalar ? MMG5_Scalar : MMG5_Tensor) == 1 &&
+            (scalar ? MMG3D_Set_scalarSols(sol, (double*)desc->metric)
+                    : MMG3D_Set_tensorSols(sol, (double*)desc->metric)) == 1;
+    }
+    mmgwasm_arena_leave(outer);
+
+    mark_modified(handle);  /* a failed import may leave a partial mesh */
+    return result;
 }
 
 /**
@@ -702,7 +1132,7 @@ double* mmg3d_get_tensor_sols(int handle, int* out_count) {
     /* Get solution size to determine number of entities */
     int typEntity, typSol;
     MMG5_int np;
-    if (MMG3D_Get_solSize(g_handles[handle].mesh, g_handles[handle].sol,
+    if (MMG3D_Get_solSize(HANDLE(handle).mesh, HANDLE(handle).sol,
                           &typEntity, &np, &typSol) != 1) {
         if (out_count) *out_count = 0;
         return NULL;
@@ -720,7 +1150,7 @@ double* mmg3d_get_tensor_sols(int handle, int* out_count) {
         return NULL;
     }
 
-    int result = MMG3D_Get_tensorSols(g_handles[handle].sol, values);
+    int result = MMG3D_Get_tensorSols(HANDLE(handle).sol, values);
     if (result != 1) {
         free(values);
         if (out_count) *out_count = 0;
@@ -732,107 +1162,565 @@ double* mmg3d_get_tensor_sols(int handle, int* out_count) {
 }
 
 /**
- * Run the MMG3D remeshing algorithm.
- * Returns MMG5_SUCCESS (0) on success, or an error code.
+ * Evaluate local sizing constraints into a scalar metric, in a single pass
+ * over the vertices that writes straight into the solution.
+ * constraints: count packed constraints of MMGWASM_SIZING_STRIDE doubles
+ * (see sizing.h). Vertices outside every region get a default size.
+ * Replaces any previous solution.
+ * Returns 1 on success, 0 on failure.
  */
 EMSCRIPTEN_KEEPALIVE
-int mmg3d_remesh(int handle) {
+int mmg3d_apply_sizing(int handle, const double* constraints, int count) {
     if (!validate_handle(handle)) {
-        return -1;
+        return 0;
     }
 
-    return MMG3D_mmg3dlib(
-        g_handles[handle].mesh,
-        g_handles[handle].sol
-    );
+    MMG5_pMesh mesh = HANDLE(handle).mesh;
+    MMG5_pSol sol = HANDLE(handle).sol;
+    MmgwasmArena* outer = mmgwasm_arena_enter(&HANDLE(handle).arena);
+    int sized = mesh->np > 0 &&
+        MMG3D_Set_solSize(mesh, sol, MMG5_Vertex, mesh->np, MMG5_Scalar) == 1;
+    mmgwasm_arena_leave(outer);
+    if (!sized) {
+        return 0;
+    }
+    return mmgwasm_sizing_apply(constraints, count, 3, mesh->point[1].c,
+                                sizeof(MMG5_Point), (int)mesh->np, &sol->m[1]);
 }
 
-/**
- * Free an array returned by mmg3d_get_* functions.
+/*
+ * Whether any vertex, edge, boundary triangle or tetrahedron is tagged
+ * required, as the getters report it (a triangle when all its edges are),
+ * read from the tags so that the getters' counters stay where they were.
  */
-EMSCRIPTEN_KEEPALIVE
-void mmg3d_free_array(void* ptr) {
-    if (ptr) {
-        free(ptr);
+static int has_required_3d(MMG5_pMesh mesh) {
+    for (MMG5_int k = 1; k <= mesh->np; k++) {
+        if (mesh->point[k].tag & MG_REQ) {
+            return 1;
+        }
+    }
+    for (MMG5_int k = 1; k <= mesh->na; k++) {
+        if (mesh->edge[k].tag & MG_REQ) {
+            return 1;
+        }
+    }
+    for (MMG5_int k = 1; k <= mesh->nt; k++) {
+        const int16_t* tag = mesh->tria[k].tag;
+        if ((tag[0] & MG_REQ) && (tag[1] & MG_REQ) && (tag[2] & MG_REQ)) {
+            return 1;
+        }
+    }
+    for (MMG5_int k = 1; k <= mesh->ne; k++) {
+        if (mesh->tetra[k].tag & MG_REQ) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Whether none of the n vertices v lies in a local region */
+static int outside(const unsigned char* inside, const MMG5_int* v, int n) {
+    for (int j = 0; j < n; j++) {
+        if (inside[v[j] - 1]) {
+            return 0;
+        }
     }
+    return 1;
 }
 
 /**
- * Load a mesh from a file in the virtual filesystem.
- * @param handle - The mesh handle
- * @param filename - Path to the mesh file in the virtual filesystem
- * @returns 1 on success, 0 on failure
+ * Prepare a local remesh: tag as required every tetrahedron and boundary
+ * triangle with no vertex inside the given regions, grown by margin, so
+ * MMG3D only reworks the elements around them.
+ * regions: count packed constraints of MMGWASM_SIZING_STRIDE doubles
+ * (see sizing.h), usually the sizing constraints of the remesh.
+ * The tags are cleared by mmg3d_thaw, which cannot tell them apart from
+ * the user's, so meshes with required entities are refused.
+ * Returns the number of frozen tetrahedra, -2 if the mesh already has
+ * required entities, -1 on failure.
  */
 EMSCRIPTEN_KEEPALIVE
-int mmg3d_load_mesh(int handle, const char* filename) {
+int mmg3d_freeze_outside(int handle, const double* regions, int count,
+                         double margin) {
     if (!validate_handle(handle)) {
+        return -1;
+    }
+
+    MMG5_pMesh mesh = HANDLE(handle).mesh;
+    if (mesh->np == 0) {
         return 0;
     }
-    return MMG3D_loadMesh(g_handles[handle].mesh, filename);
+    if (has_required_3d(mesh)) {
+        return -2;
+    }
+
+    unsigned char* inside = (unsigned char*)malloc((size_t)mesh->np);
+    if (!inside) {
+        return -1;
+    }
+    if (!mmgwasm_sizing_contains(regions, count, 3, mesh->point[1].c,
+                                 sizeof(MMG5_Point), (int)mesh->np, margin,
+                                 inside)) {
+        free(inside);
+        return -1;
+    }
+
+    int frozen = 0;
+    for (MMG5_int k = 1; k <= mesh->ne; k++) {
+        if (outside(inside, mesh->tetra[k].v, 4)) {
+            MMG3D_Set_requiredTetrahedron(mesh, k);
+            frozen++;
+        }
+    }
+    for (MMG5_int k = 1; k <= mesh->nt; k++) {
+        if (outside(inside, mesh->tria[k].v, 3)) {
+            MMG3D_Set_requiredTriangle(mesh, k);
+        }
+    }
+    free(inside);
+    return frozen;
 }
 
 /**
- * Save a mesh to a file in the virtual filesystem.
- * @param handle - The mesh handle
- * @param filename - Path to save the mesh file in the virtual filesystem
- * @returns 1 on success, 0 on failure
+ * Clear the required tags of every entity after a local remesh, including
+ * any MMG3D propagated from the frozen elements to their vertices and
+ * edges, so the result remeshes freely afterwards.
+ * Returns 1 on success, 0 on failure.
  */
 EMSCRIPTEN_KEEPALIVE
-int mmg3d_save_mesh(int handle, const char* filename) {
+int mmg3d_thaw(int handle) {
     if (!validate_handle(handle)) {
         return 0;
     }
-    return MMG3D_saveMesh(g_handles[handle].mesh, filename);
+
+    MMG5_pMesh mesh = HANDLE(handle).mesh;
+    for (MMG5_int k = 1; k <= mesh->np; k++) {
+        MMG3D_Unset_requiredVertex(mesh, k);
+    }
+    for (MMG5_int k = 1; k <= mesh->na; k++) {
+        MMG3D_Unset_requiredEdge(mesh, k);
+    }
+    for (MMG5_int k = 1; k <= mesh->nt; k++) {
+        MMG3D_Unset_requiredTriangle(mesh, k);
+    }
+    for (MMG5_int k = 1; k <= mesh->ne; k++) {
+        MMG3D_Unset_requiredTetrahedron(mesh, k);
+    }
+    return 1;
 }
 
-/**
- * Load a solution from a file in the virtual filesystem.
- * @param handle - The mesh handle
- * @param filename - Path to the solution file in the virtual filesystem
- * @returns 1 on success, 0 on failure
+/*
+ * Phase hooks (see progress.h), linked with -Wl,--wrap over the functions
+ * MMG3D_mmg3dlib runs its phases with, and over the swap and move passes its
+ * Delaunay meshing phase runs in every wavefront. A hook that sees the abort
+ * flag returns the failure value of the function it replaces, which
+ * MMG3D_mmg3dlib handles by rebuilding, unscaling and packing the mesh
+ * before returning MMG5_LOWFAILURE. The declarations take the prototypes of
+ * MMG's private header, so a signature change fails to compile.
  */
-EMSCRIPTEN_KEEPALIVE
-int mmg3d_load_sol(int handle, const char* filename) {
-    if (!validate_handle(handle)) {
+__typeof__(MMG3D_analys) __real_MMG3D_analys, __wrap_MMG3D_analys;
+__typeof__(MMG5_mmg3d1_delone) __real_MMG5_mmg3d1_delone,
+    __wrap_MMG5_mmg3d1_delone;
+__typeof__(MMG5_swptet) __real_MMG5_swptet, __wrap_MMG5_swptet;
+__typeof__(MMG5_movtet) __real_MMG5_movtet, __wrap_MMG5_movtet;
+
+int __wrap_MMG3D_analys(MMG5_pMesh mesh) {
+    if (!mmgwasm_progress_enter(MMGWASM_PHASE_ANALYSIS)) {
         return 0;
     }
-    return MMG3D_loadSol(g_handles[handle].mesh, g_handles[handle].sol, filename);
+    int ier = __real_MMG3D_analys(mesh);
+    mmgwasm_progress_leave(MMGWASM_PHASE_ANALYSIS);
+    return ier;
 }
 
-/**
- * Save a solution to a file in the virtual filesystem.
- * @param handle - The mesh handle
- * @param filename - Path to save the solution file in the virtual filesystem
- * @returns 1 on success, 0 on failure
- */
-EMSCRIPTEN_KEEPALIVE
-int mmg3d_save_sol(int handle, const char* filename) {
-    if (!validate_handle(handle)) {
+int __wrap_MMG5_mmg3d1_delone(MMG5_pMesh mesh, MMG5_pSol met,
+                              MMG5_int* permNodGlob) {
+    if (!mmgwasm_progress_enter(MMGWASM_PHASE_MESHING)) {
         return 0;
     }
-    return MMG3D_saveSol(g_handles[handle].mesh, g_handles[handle].sol, filename);
+    int ier = __real_MMG5_mmg3d1_delone(mesh, met, permNodGlob);
+    mmgwasm_progress_leave(MMGWASM_PHASE_MESHING);
+    return ier;
 }
 
-/**
- * Get the quality of a single tetrahedron.
- * @param handle - The mesh handle
- * @param k - The tetrahedron index (1-indexed, MMG convention)
- * @returns Quality value between 0 (degenerate) and 1 (best), or 0 on failure
+MMG5_int __wrap_MMG5_swptet(MMG5_pMesh mesh, MMG5_pSol met, double crit,
+                            double declic, MMG3D_pPROctree PROctree,
+                            int typchk, MMG5_int testmark) {
+    if (!mmgwasm_progress_step()) {
+        return -1;
+    }
+    return __real_MMG5_swptet(mesh, met, crit, declic, PROctree, typchk,
+                              testmark);
+}
+
+int __wrap_MMG5_movtet(MMG5_pMesh mesh, MMG5_pSol met,
+                       MMG3D_pPROctree PROctree, double clickSurf,
+                       double clickVol, int moveVol, int improveSurf,
+                       int improveVolSurf, int improveVol, int maxit,
+                       MMG5_int testmark) {
+    if (!mmgwasm_progress_step()) {
+        return -1;
+    }
+    return __real_MMG5_movtet(mesh, met, PROctree, clickSurf, clickVol,
+                              moveVol, improveSurf, improveVolSurf,
+                              improveVol, maxit, testmark);
+}
+
+/*
+ * Run MMG3D on a handle inside the remesh gate (see threads.h).
+ * Tensor metrics select MMG's anisotropic kernels, which must not overlap
+ * with isotropic runs.
+ * When progress tracking is enabled, an abort stops MMG3D at its next phase
+ * hook, and the run returns MMGWASM_REMESH_ABORTED with the mesh MMG3D
+ * returned (see progress.h).
  */
-EMSCRIPTEN_KEEPALIVE
-double mmg3d_get_tetrahedron_quality(int handle, int k) {
-    if (!validate_handle(handle)) {
-        return 0.0;
+static int run_remesh(int handle) {
+    MMG5_pMesh mesh = HANDLE(handle).mesh;
+    MMG5_pSol sol = HANDLE(handle).sol;
+    int aniso = sol && sol->size == 6;
+    int result = MMGWASM_REMESH_ABORTED;
+
+    MmgwasmArena* outer = mmgwasm_arena_enter(&HANDLE(handle).arena);
+    mmgwasm_remesh_enter(MMGWASM_GATE_KEY(MMGWASM_GATE_3D, aniso));
+    if (mmgwasm_progress_begin(&HANDLE(handle).progress, &HANDLE(handle).stats,
+                               &mesh->info.imprim)) {
+        result = MMG3D_mmg3dlib(mesh, sol);
+        if (mmgwasm_progress_end()) {
+            result = MMGWASM_REMESH_ABORTED;
+        }
     }
-    return MMG3D_Get_tetrahedronQuality(
-        g_handles[handle].mesh,
-        g_handles[handle].sol,
-        (MMG5_int)k
-    );
+    mmgwasm_remesh_leave();
+    mmgwasm_arena_leave(outer);
+
+    mark_modified(handle);  /* the mesh may be modified even on failure */
+    return result;
 }
 
 /**
- * Get quality values for all tetrahedra.
+ * Run the MMG3D remeshing algorithm.
+ * Returns MMG5_SUCCESS (0) on success, or an error code
+ * (MMGWASM_REMESH_ABORTED if aborted through the progress record).
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg3d_remesh(int handle) {
+    if (!validate_handle(handle)) {
+        return -1;
+    }
+
+    MMGWASM_LOCK(g_handles_lock);
+    int busy = HANDLE(handle).busy;
+    MMGWASM_UNLOCK(g_handles_lock);
+    if (busy) {
+        return -1;  /* An asynchronous remesh is running on this handle */
+    }
+
+    mmgwasm_progress_reset(&HANDLE(handle).progress);
+    return run_remesh(handle);
+}
+
+#ifdef __EMSCRIPTEN_PTHREADS__
+/* Worker thread body for mmg3d_remesh_async */
+static void* remesh_thread(void* arg) {
+    int handle = (int)(intptr_t)arg;
+    int result = run_remesh(handle);
+
+    MMGWASM_LOCK(g_handles_lock);
+    HANDLE(handle).async_result = result;
+    HANDLE(handle).busy = 0;
+    MMGWASM_UNLOCK(g_handles_lock);
+    return NULL;
+}
+#endif
+
+/**
+ * Start remeshing a handle without blocking the caller.
+ * In the pthreads build the remesh runs on a worker thread from the pool, so
+ * several handles can be remeshed at once in the same heap; otherwise it runs
+ * synchronously before returning. Poll mmg3d_remesh_status for completion.
+ * The handle must not be used or freed until the remesh has finished.
+ * Returns 1 if the remesh was started, 0 on failure (invalid or busy handle).
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg3d_remesh_async(int handle) {
+    if (!validate_handle(handle)) {
+        return 0;
+    }
+
+    MMGWASM_LOCK(g_handles_lock);
+    if (HANDLE(handle).busy) {
+        MMGWASM_UNLOCK(g_handles_lock);
+        return 0;
+    }
+    HANDLE(handle).busy = 1;
+    HANDLE(handle).async_result = MMGWASM_REMESH_RUNNING;
+    mmgwasm_progress_reset(&HANDLE(handle).progress);
+    MMGWASM_UNLOCK(g_handles_lock);
+
+#ifdef __EMSCRIPTEN_PTHREADS__
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, remesh_thread, (void*)(intptr_t)handle) == 0) {
+        pthread_detach(thread);
+        return 1;
+    }
+    /* Thread creation failed, fall back to running inline */
+#endif
+
+    int result = run_remesh(handle);
+
+    MMGWASM_LOCK(g_handles_lock);
+    HANDLE(handle).async_result = result;
+    HANDLE(handle).busy = 0;
+    MMGWASM_UNLOCK(g_handles_lock);
+    return 1;
+}
+
+/**
+ * Get the state of the last asynchronous remesh of a handle.
+ * Returns MMGWASM_REMESH_RUNNING (-2) while it is running, its MMG return
+ * code once finished, or -1 for an invalid handle or if none was started.
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg3d_remesh_status(int handle) {
+    if (!validate_handle(handle)) {
+        return -1;
+    }
+
+    MMGWASM_LOCK(g_handles_lock);
+    int status = HANDLE(handle).busy
+        ? MMGWASM_REMESH_RUNNING
+        : HANDLE(handle).async_result;
+    MMGWASM_UNLOCK(g_handles_lock);
+    return status;
+}
+
+/**
+ * Get the progress record of a handle (see progress.h).
+ * Set its enabled field to track the next remeshes of the handle and its
+ * abort field to cancel a running one. The record keeps its address for the
+ * lifetime of the handle.
+ * Returns NULL for an invalid handle.
+ */
+EMSCRIPTEN_KEEPALIVE
+MmgwasmProgress* mmg3d_get_progress(int handle) {
+    if (!validate_handle(handle)) {
+        return NULL;
+    }
+    return &HANDLE(handle).progress;
+}
+
+/**
+ * Copy the statistics of the last remesh of a handle to out (see stats.h).
+ * Returns 1 on success, 0 for an invalid handle or a build without
+ * instrumentation (MMG_WASM_STATS).
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg3d_get_stats(int handle, MmgwasmStats* out) {
+    if (!MMGWASM_STATS_ENABLED || !validate_handle(handle) || !out) {
+        return 0;
+    }
+    *out = HANDLE(handle).stats;
+    return 1;
+}
+
+/**
+ * Free an array returned by mmg3d_get_* functions.
+ */
+EMSCRIPTEN_KEEPALIVE
+void mmg3d_free_array(void* ptr) {
+    if (ptr) {
+        free(ptr);
+    }
+}
+
+/**
+ * Load a mesh from a file in the virtual filesystem.
+ * @param handle - The mesh handle
+ * @param filename - Path to the mesh file in the virtual filesystem
+ * @returns 1 on success, 0 on failure
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg3d_load_mesh(int handle, const char* filename) {
+    if (!validate_handle(handle)) {
+        return 0;
+    }
+    MmgwasmArena* outer = mmgwasm_arena_enter(&HANDLE(handle).arena);
+    int result = MMG3D_loadMesh(HANDLE(handle).mesh, filename);
+    mmgwasm_arena_leave(outer);
+    mark_modified(handle);  /* a failed load may leave a partial mesh */
+    return result;
+}
+
+/**
+ * Load a mesh from an in-memory file (see memfile.h), without going through
+ * the virtual filesystem.
+ * @param handle - The mesh handle
+ * @param file - Memfile holding the mesh file contents
+ * @param binary - 1 for the .meshb format, 0 for .mesh
+ * @returns 1 on success, 0 on failure
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg3d_load_mesh_from_memfile(int handle, MmgwasmMemFile* file, int binary) {
+    if (!validate_handle(handle) || !file || file->size == 0) {
+        return 0;
+    }
+    mmgwasm_memfile_attach(file);
+    MmgwasmArena* outer = mmgwasm_arena_enter(&HANDLE(handle).arena);
+    int result = MMG3D_loadMesh(HANDLE(handle).mesh,
+        binary ? MMGWASM_MEMFILE_PATH ".meshb" : MMGWASM_MEMFILE_PATH ".mesh");
+    mmgwasm_arena_leave(outer);
+    mmgwasm_memfile_attach(NULL);
+    mark_modified(handle);  /* a failed load may leave a partial mesh */
+    return result;
+}
+
+/**
+ * Save a mesh to a file in the virtual filesystem.
+ * @param handle - The mesh handle
+ * @param filename - Path to save the mesh file in the virtual filesystem
+ * @returns 1 on success, 0 on failure
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg3d_save_mesh(int handle, const char* filename) {
+    if (!validate_handle(handle)) {
+        return 0;
+    }
+    return MMG3D_saveMesh(HANDLE(handle).mesh, filename);
+}
+
+/**
+ * Save a mesh into an in-memory file (see memfile.h), replacing its contents.
+ * The bytes are serialized straight into the heap and read back through
+ * mmgwasm_memfile_data/mmgwasm_memfile_size.
+ * @param handle - The mesh handle
+ * @param file - Memfile receiving the mesh file contents
+ * @param binary - 1 for the .meshb format, 0 for .mesh
+ * @returns 1 on success, 0 on failure
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg3d_save_mesh_to_memfile(int handle, MmgwasmMemFile* file, int binary) {
+    if (!validate_handle(handle) || !file) {
+        return 0;
+    }
+    mmgwasm_memfile_attach(file);
+    int result = MMG3D_saveMesh(HANDLE(handle).mesh,
+        binary ? MMGWASM_MEMFILE_PATH ".meshb" : MMGWASM_MEMFILE_PATH ".mesh");
+    mmgwasm_memfile_attach(NULL);
+    return result;
+}
+
+/**
+ * Load a solution from a file in the virtual filesystem.
+ * @param handle - The mesh handle
+ * @param filename - Path to the solution file in the virtual filesystem
+ * @returns 1 on success, 0 on failure
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg3d_load_sol(int handle, const char* filename) {
+    if (!validate_handle(handle)) {
+        return 0;
+    }
+    MmgwasmArena* outer = mmgwasm_arena_enter(&HANDLE(handle).arena);
+    int result = MMG3D_loadSol(HANDLE(handle).mesh, HANDLE(handle).sol,
+        filename);
+    mmgwasm_arena_leave(outer);
+    return result;
+}
+
+/**
+ * Load a solution from an in-memory file (see memfile.h), without going
+ * through the virtual filesystem.
+ * @param handle - The mesh handle
+ * @param file - Memfile holding the solution file contents
+ * @param binary - 1 for the .solb format, 0 for .sol
+ * @returns 1 on success, 0 on failure
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg3d_load_sol_from_memfile(int handle, MmgwasmMemFile* file, int binary) {
+    if (!validate_handle(handle) || !file || file->size == 0) {
+        return 0;
+    }
+    mmgwasm_memfile_attach(file);
+    MmgwasmArena* outer = mmgwasm_arena_enter(&HANDLE(handle).arena);
+    int result = MMG3D_loadSol(HANDLE(handle).mesh, HANDLE(handle).sol,
+        binary ? MMGWASM_MEMFILE_PATH ".solb" : MMGWASM_MEMFILE_PATH ".sol");
+    mmgwasm_arena_leave(outer);
+    mmgwasm_memfile_attach(NULL);
+    return result;
+}
+
+/**
+ * Save a solution to a file in the virtual filesystem.
+ * @param handle - The mesh handle
+ * @param filename - Path to save the solution file in the virtual filesystem
+ * @returns 1 on success, 0 on failure
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg3d_save_sol(int handle, const char* filename) {
+    if (!validate_handle(handle)) {
+        return 0;
+    }
+    return MMG3D_saveSol(HANDLE(handle).mesh, HANDLE(handle).sol, filename);
+}
+
+/**
+ * Save the solution into an in-memory file (see memfile.h), replacing its
+ * contents.
+ * @param handle - The mesh handle
+ * @param file - Memfile receiving the solution file contents
+ * @param binary - 1 for the .solb format, 0 for .sol
+ * @returns 1 on success, 0 on failure
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg3d_save_sol_to_memfile(int handle, MmgwasmMemFile* file, int binary) {
+    if (!validate_handle(handle) || !file) {
+        return 0;
+    }
+    mmgwasm_memfile_attach(file);
+    int result = MMG3D_saveSol(HANDLE(handle).mesh, HANDLE(handle).sol,
+        binary ? MMGWASM_MEMFILE_PATH ".solb" : MMGWASM_MEMFILE_PATH ".sol");
+    mmgwasm_memfile_attach(NULL);
+    return result;
+}
+
+/* Quality function of MMG matching a solution, as chosen by setfunc */
+typedef double (*TetraQuality)(MMG5_pMesh mesh, MMG5_pSol met, MMG5_pTetra pt);
+
+static TetraQuality tetra_quality_function(MMG5_pMesh mesh, MMG5_pSol sol) {
+    if (!sol || !sol->m || sol->size == 1) {
+        return MMG5_caltet_iso;
+    }
+    return mesh->info.metRidTyp ? MMG5_caltet_ani : MMG5_caltet33_ani;
+}
+
+/*
+ * Quality of tetrahedron pt in [0, 1], as MMG3D_Get_tetrahedronQuality
+ * computes it without its per-call index checks and function choice
+ */
+static double tetra_quality(TetraQuality caltet, MMG5_pMesh mesh,
+                            MMG5_pSol sol, MMG5_pTetra pt) {
+    return MG_EOK(pt) ? MMG3D_ALPHAD * caltet(mesh, sol, pt) : 0.0;
+}
+
+/**
+ * Get the quality of a single tetrahedron.
+ * @param handle - The mesh handle
+ * @param k - The tetrahedron index (1-indexed, MMG convention)
+ * @returns Quality value between 0 (degenerate) and 1 (best), or 0 on failure
+ */
+EMSCRIPTEN_KEEPALIVE
+double mmg3d_get_tetrahedron_quality(int handle, int k) {
+    if (!validate_handle(handle)) {
+        return 0.0;
+    }
+    return MMG3D_Get_tetrahedronQuality(
+        HANDLE(handle).mesh,
+        HANDLE(handle).sol,
+        (MMG5_int)k
+    );
+}
+
+/**
+ * Get quality values for all tetrahedra.
  * Allocates and returns a pointer to the quality array.
  * out_count receives the number of tetrahedra.
  * Caller must free the returned pointer using mmg3d_free_array.
@@ -846,7 +1734,7 @@ double* mmg3d_get_tetrahedra_qualities(int handle, int* out_count) {
     }
 
     MMG5_int np, ne, nprism, nt, nquad, na;
-    if (MMG3D_Get_meshSize(g_handles[handle].mesh, &np, &ne, &nprism, &nt, &nquad, &na) != 1) {
+    if (MMG3D_Get_meshSize(HANDLE(handle).mesh, &np, &ne, &nprism, &nt, &nquad, &na) != 1) {
         if (out_count) *out_count = 0;
         return NULL;
     }
@@ -864,15 +1752,1137 @@ double* mmg3d_get_tetrahedra_qualities(int handle, int* out_count) {
     }
 
     /* Get quality for each tetrahedron (1-indexed) */
+    MMG5_pMesh mesh = HANDLE(handle).mesh;
+    MMG5_pSol sol = HANDLE(handle).sol;
+    TetraQuality caltet = tetra_quality_function(mesh, sol);
     for (MMG5_int k = 1; k <= ne; k++) {
-        qualities[k - 1] = MMG3D_Get_tetrahedronQuality(
-            g_handles[handle].mesh,
-            g_handles[handle].sol,
-            k
-        );
+        qualities[k - 1] = tetra_quality(caltet, mesh, sol, &mesh->tetra[k]);
     }
 
     if (out_count) *out_count = (int)ne;
     return qualities;
 }
 
+
+/*
+ * Quality statistics written by mmg3d_get_quality_stats.
+ * The layout (32 bytes) is mirrored by the TypeScript bindings.
+ */
+typedef struct {
+    double min;
+    double max;
+    double mean;
+    int count;   /* number of tetrahedra */
+    int nbins;   /* number of histogram bins filled */
+} QualityStats;
+
+/**
+ * Compute quality statistics for all tetrahedra in a single pass.
+ * stats receives min/max/mean over all tetrahedra (all 0 for an empty mesh).
+ * histogram (optional, may be NULL when nbins is 0) receives nbins counts for
+ * uniform quality bins over [0, 1]; a quality of exactly 1 goes in the last bin.
+ * No intermediate array is allocated.
+ * Returns 1 on success, 0 on failure.
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg3d_get_quality_stats(int handle, int nbins, QualityStats* stats, int* histogram) {
+    if (!validate_handle(handle) || !stats || nbins < 0 || (nbins > 0 && !histogram)) {
+        return 0;
+    }
+
+    MMG5_pMesh mesh = HANDLE(handle).mesh;
+    MMG5_pSol sol = HANDLE(handle).sol;
+    MMG5_int ne = mesh->tetra ? mesh->ne : 0;
+
+    memset(stats, 0, sizeof(*stats));
+    if (nbins > 0) {
+        memset(histogram, 0, (size_t)nbins * sizeof(int));
+    }
+    stats->nbins = nbins;
+
+    if (ne == 0) {
+        return 1;
+    }
+
+    TetraQuality caltet = tetra_quality_function(mesh, sol);
+    double min = 1.0e300, max = -1.0e300, sum = 0.0;
+    for (MMG5_int k = 1; k <= ne; k++) {
+        double q = tetra_quality(caltet, mesh, sol, &mesh->tetra[k]);
+        if (q < min) min = q;
+        if (q > max) max = q;
+        sum += q;
+
+        if (nbins > 0) {
+            int bin = (int)(q * nbins);
+            if (bin < 0) bin = 0;
+            if (bin >= nbins) bin = nbins - 1;
+            histogram[bin]++;
+        }
+    }
+
+    stats->min = min;
+    stats->max = max;
+    stats->mean = sum / (double)ne;
+    stats->count = (int)ne;
+
+    return 1;
+}
+
+/*
+ * Point location
+ *
+ * Points are located through an element hierarchy kept in the handle (see
+ * locate.h). It is built by the first query and reused until the mesh is
+ * modified.
+ */
+
+/* Element arrays of a mesh, read in place by the locator */
+static MmgwasmElements mesh_elements(MMG5_pMesh mesh) {
+    MmgwasmElements elements = {3, 4, NULL, sizeof(MMG5_Point),
+                                NULL, sizeof(MMG5_Tetra), 0};
+    if (mesh->point && mesh->tetra && mesh->ne > 0) {
+        elements.coords = mesh->point[1].c;
+        elements.elems = mesh->tetra[1].v;
+        elements.nelem = (int)mesh->ne;
+    }
+    return elements;
+}
+
+/* Locator of a handle, rebuilt if the mesh changed, NULL on failure */
+static const MmgwasmLocator* get_locator(int handle, MmgwasmElements* elements) {
+    HandleEntry* entry = &HANDLE(handle);
+    *elements = mesh_elements(entry->mesh);
+    if (entry->locator.generation != entry->generation) {
+        if (!mmgwasm_locator_build(&entry->locator, elements)) {
+            return NULL;
+        }
+        entry->locator.generation = entry->generation;
+    }
+    return &entry->locator;
+}
+
+/**
+ * Locate n points (3 coordinates each) in the mesh, finding the tetrahedron
+ * containing each point.
+ * out_elements receives n 1-indexed tetrahedra, 0 outside the mesh.
+ * out_bary, if not NULL, receives 4 barycentric coordinates per point.
+ * Returns the number of points located, or -1 on failure.
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg3d_locate_points(int handle, const double* points, int n,
+                        int* out_elements, double* out_bary) {
+    if (!validate_handle(handle) || n < 0 || (n > 0 && (!points || !out_elements))) {
+        return -1;
+    }
+
+    MmgwasmElements elements;
+    const MmgwasmLocator* locator = get_locator(handle, &elements);
+    if (!locator) {
+        return -1;
+    }
+
+    int located = 0;
+    for (int i = 0; i < n; i++) {
+        double* bary = out_bary ? out_bary + (size_t)i * 4 : NULL;
+        out_elements[i] = mmgwasm_locate(locator, &elements,
+                                         points + (size_t)i * 3, bary);
+        located += out_elements[i] != 0;
+    }
+    return located;
+}
+
+/**
+ * Interpolate the solution at n points (3 coordinates each), linearly in
+ * the tetrahedron containing each point.
+ * out receives n * (solution size) values, NaN for points outside the mesh.
+ * Returns the number of points located, or -1 on failure (no vertex solution).
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg3d_sample_sol(int handle, const double* points, int n, double* out) {
+    if (!validate_handle(handle) || n < 0 || (n > 0 && (!points || !out))) {
+        return -1;
+    }
+
+    MMG5_pMesh mesh = HANDLE(handle).mesh;
+    MMG5_pSol sol = HANDLE(handle).sol;
+    if (!sol || !sol->m || sol->size <= 0 || sol->np != mesh->np) {
+        return -1;
+    }
+
+    MmgwasmElements elements;
+    const MmgwasmLocator* locator = get_locator(handle, &elements);
+    if (!locator) {
+        return -1;
+    }
+    return mmgwasm_locate_sample(locator, &elements, &sol->m[sol->size],
+                                 sol->size, points, n, out);
+}
+
+/**
+ * Interpolate user fields from the vertices of source onto the vertices of
+ * handle, typically from a mesh kept from before a remesh onto its result.
+ * values: stride doubles per source vertex (fields interleaved per vertex).
+ * out receives stride doubles per vertex of handle. Vertices outside the
+ * source mesh take the values of its closest point.
+ * Returns 1 on success, 0 on failure.
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg3d_interpolate_fields(int handle, int source, const double* values,
+                             int stride, double* out) {
+    if (!validate_handle(handle) || !validate_handle(source) || stride <= 0 ||
+        !values || !out) {
+        return 0;
+    }
+
+    MMG5_pMesh mesh = HANDLE(handle).mesh;
+    if (!mesh->point || mesh->np == 0) {
+        return 0;
+    }
+    MmgwasmElements elements;
+    const MmgwasmLocator* locator = get_locator(source, &elements);
+    if (!locator) {
+        return 0;
+    }
+    return mmgwasm_locate_transfer(locator, &elements, values, stride,
+                                   mesh->point[1].c, sizeof(MMG5_Point),
+                                   (int)mesh->np, out);
+}
+
+/*
+ * Zero-copy views
+ *
+ * The view_* functions pack mesh data into a buffer owned by the handle and
+ * return a pointer into it, so JavaScript can wrap the result in a typed-array
+ * subarray of the WASM heap without copying. Repeated calls are free while the
+ * mesh is unchanged. The pointer stays valid until the mesh is modified (see
+ * mmg3d_get_generation) or the handle is freed; it must NOT be passed to
+ * mmg3d_free_array.
+ */
+
+/**
+ * Get the modification generation of a mesh.
+ * The value changes whenever the mesh is modified or remeshed, which
+ * invalidates views obtained earlier.
+ * Returns a non-zero generation, or 0 for an invalid handle.
+ */
+EMSCRIPTEN_KEEPALIVE
+unsigned int mmg3d_get_generation(int handle) {
+    if (!validate_handle(handle)) {
+        return 0;
+    }
+    return HANDLE(handle).generation;
+}
+
+/**
+ * Get a view of all vertex coordinates [x0, y0, z0, x1, y1, z1, ...].
+ * out_count receives the number of vertices.
+ * Returns NULL on failure or for an empty mesh.
+ */
+EMSCRIPTEN_KEEPALIVE
+double* mmg3d_view_vertices(int handle, int* out_count) {
+    if (!validate_handle(handle)) {
+        if (out_count) *out_count = 0;
+        return NULL;
+    }
+
+    HandleEntry* entry = &HANDLE(handle);
+    ViewBuffer* view = &entry->view_vertices;
+
+    if (view->generation != entry->generation) {
+        MMG5_pMesh mesh = entry->mesh;
+        MMG5_int np = mesh->point ? mesh->np : 0;
+
+        double* out = view_reserve(view, (size_t)np * 3 * sizeof(double));
+        if (np > 0 && !out) {
+            if (out_count) *out_count = 0;
+            return NULL;
+        }
+
+        for (MMG5_int k = 1; k <= np; k++) {
+            const double* c = mesh->point[k].c;
+            out[3 * (k - 1) + 0] = c[0];
+            out[3 * (k - 1) + 1] = c[1];
+            out[3 * (k - 1) + 2] = c[2];
+        }
+
+        view->count = (int)np;
+        view->generation = entry->generation;
+    }
+
+    if (out_count) *out_count = view->count;
+    return view->count > 0 ? (double*)view->data : NULL;
+}
+
+/**
+ * Get a view of all tetrahedra [v0, v1, v2, v3, ...] (1-indexed vertices).
+ * out_count receives the number of tetrahedra.
+ * Returns NULL on failure or for an empty mesh.
+ */
+EMSCRIPTEN_KEEPALIVE
+int* mmg3d_view_tetrahedra(int handle, int* out_count) {
+    if (!validate_handle(handle)) {
+        if (out_count) *out_count = 0;
+        return NULL;
+    }
+
+    HandleEntry* entry = &HANDLE(handle);
+    ViewBuffer* view = &entry->view_tetrahedra;
+
+    if (view->generation != entry->generation) {
+        MMG5_pMesh mesh = entry->mesh;
+        MMG5_int ne = mesh->tetra ? mesh->ne : 0;
+
+        MMG5_int* out = view_reserve(view, (size_t)ne * 4 * sizeof(MMG5_int));
+        if (ne > 0 && !out) {
+            if (out_count) *out_count = 0;
+            return NULL;
+        }
+
+        for (MMG5_int k = 1; k <= ne; k++) {
+            memcpy(&out[4 * (k - 1)], mesh->tetra[k].v, 4 * sizeof(MMG5_int));
+        }
+
+        view->count = (int)ne;
+        view->generation = entry->generation;
+    }
+
+    if (out_count) *out_count = view->count;
+    return view->count > 0 ? (int*)view->data : NULL;
+}
+
+/**
+ * Get a view of all boundary triangles [v0, v1, v2, ...] (1-indexed vertices).
+ * out_count receives the number of triangles.
+ * Returns NULL on failure or for an empty mesh.
+ */
+EMSCRIPTEN_KEEPALIVE
+int* mmg3d_view_triangles(int handle, int* out_count) {
+    if (!validate_handle(handle)) {
+        if (out_count) *out_count = 0;
+        return NULL;
+    }
+
+    HandleEntry* entry = &HANDLE(handle);
+    ViewBuffer* view = &entry->view_triangles;
+
+    if (view->generation != entry->generation) {
+        MMG5_pMesh mesh = entry->mesh;
+        MMG5_int nt = mesh->tria ? mesh->nt : 0;
+
+        MMG5_int* out = view_reserve(view, (size_t)nt * 3 * sizeof(MMG5_int));
+        if (nt > 0 && !out) {
+            if (out_count) *out_count = 0;
+            return NULL;
+        }
+
+        for (MMG5_int k = 1; k <= nt; k++) {
+            memcpy(&out[3 * (k - 1)], mesh->tria[k].v, 3 * sizeof(MMG5_int));
+        }
+
+        view->count = (int)nt;
+        view->generation = entry->generation;
+    }
+
+    if (out_count) *out_count = view->count;
+    return view->count > 0 ? (int*)view->data : NULL;
+}
+
+/**
+ * Get a view of the solution values [s0_0, ..., s0_{size-1}, s1_0, ...].
+ * Unlike the other views it aliases MMG's own storage, so nothing is packed;
+ * it is also invalidated when the solution is resized.
+ * out_count receives the number of entities and out_size the number of
+ * values per entity (1 for a scalar, 6 for a tensor).
+ * Returns NULL on failure or for an empty solution.
+ */
+EMSCRIPTEN_KEEPALIVE
+double* mmg3d_view_sols(int handle, int* out_count, int* out_size) {
+    if (out_count) *out_count = 0;
+    if (out_size) *out_size = 0;
+    if (!validate_handle(handle)) {
+        return NULL;
+    }
+
+    MMG5_pSol sol = HANDLE(handle).sol;
+    if (!sol || !sol->m || sol->np <= 0) {
+        return NULL;
+    }
+
+    if (out_count) *out_count = (int)sol->np;
+    if (out_size) *out_size = sol->size;
+    /* MMG stores entities from index 1 */
+    return sol->m + sol->size;
+}
+
+/**
+ * Pack the mesh into the compact wire format (see pack.h): float32 or
+ * quantized coordinates, tetrahedra and boundary triangles with 0-based indices.
+ * flags: MMGWASM_PACK_QUANTIZE and/or MMGWASM_PACK_BOUNDARY_ONLY.
+ * out_size receives the number of bytes. The buffer is owned by the handle
+ * and overwritten by the next call; it must NOT be passed to mmg3d_free_array.
+ * Returns NULL on failure.
+ */
+EMSCRIPTEN_KEEPALIVE
+const void* mmg3d_pack_mesh(int handle, int flags, int* out_size) {
+    if (out_size) *out_size = 0;
+    if (!validate_handle(handle)) {
+        return NULL;
+    }
+
+    HandleEntry* entry = &HANDLE(handle);
+    MMG5_pMesh mesh = entry->mesh;
+    MmgwasmPackInput in = {
+        3, NULL, sizeof(MMG5_Point), 0,
+        {NULL, sizeof(MMG5_Tetra), 4, 0},
+        {NULL, sizeof(MMG5_Tria), 3, 0}
+    };
+    if (mesh->point && mesh->np > 0) {
+        in.coords = mesh->point[1].c;
+        in.np = (int)mesh->np;
+    }
+    if (mesh->tetra && mesh->ne > 0) {
+        in.cells.verts = mesh->tetra[1].v;
+        in.cells.count = (int)mesh->ne;
+    }
+    if (mesh->tria && mesh->nt > 0) {
+        in.boundary.verts = mesh->tria[1].v;
+        in.boundary.count = (int)mesh->nt;
+    }
+
+    size_t bytes = mmgwasm_pack_size(&in, flags);
+    if (bytes > INT32_MAX) {
+        return NULL;
+    }
+    void* out = view_reserve(&entry->packed, bytes);
+    if (!out) {
+        return NULL;
+    }
+    mmgwasm_pack_write(&in, flags, out);
+
+    if (out_size) *out_size = (int)bytes;
+    return out;
+}
+
+/**
+ * Extract the display surface of the mesh (see surface.h): the boundary
+ * faces of its tetrahedra with compacted float32 positions, vertex normals
+ * and 0-based indices, ready for a GPU buffer.
+ * plane: NULL for the whole mesh, or (nx, ny, nz, d) to keep the tetrahedra
+ * whose centroid c satisfies dot(c, n) <= d and show the cut.
+ * The buffer is owned by the handle and overwritten by the next call; it
+ * must NOT be passed to mmg3d_free_array.
+ * Returns NULL on failure.
+ */
+EMSCRIPTEN_KEEPALIVE
+const void* mmg3d_extract_surface(int handle, const double* plane) {
+    if (!validate_handle(handle)) {
+        return NULL;
+    }
+
+    HandleEntry* entry = &HANDLE(handle);
+    MmgwasmElements elements = mesh_elements(entry->mesh);
+    int np = elements.coords ? (int)entry->mesh->np : 0;
+    return mmgwasm_surface_extract(&entry->surface, &elements, np, plane);
+}
+
+/**
+ * Split the tetrahedra of the mesh into nparts parts for a parallel remesh
+ * (see partition.h). pass 0 cuts along the longest axes, later passes along
+ * the other ones, so that they move the interfaces of the previous pass.
+ * out receives the 0-based part of each tetrahedron (ne ints).
+ * Parts are remeshed with frozen interfaces, which the welded mesh cannot
+ * tell apart from the user's required entities, so those are refused.
+ * Returns 1 on success, -2 if the mesh has required entities, 0 on failure.
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg3d_partition(int handle, int nparts, int pass, int* out) {
+    if (!validate_handle(handle)) {
+        return 0;
+    }
+
+    MMG5_pMesh mesh = HANDLE(handle).mesh;
+    if (has_required_3d(mesh)) {
+        return -2;
+    }
+    MmgwasmElements elements = mesh_elements(mesh);
+    return mmgwasm_partition(&elements, nparts, pass, out);
+}
+
+/* Vertices of face i of a tetrahedron (opposite vertex i), facing out */
+static const int FACE_VERTICES[4][3] = {
+    {1, 2, 3}, {0, 3, 2}, {0, 1, 3}, {0, 2, 1}
+};
+
+/* Scratch arrays of a subdomain extraction */
+typedef struct {
+    int* adjacency;      /* 4 * ne: tetrahedron across each face, or -1 */
+    int* face_triangle;  /* 4 * ne: triangle on each face, or -1 */
+    MMG5_int* map;       /* np + 1: vertex in the subdomain, or 0 */
+} Subdomain;
+
+/*
+ * What face code of a tetrahedron of part becomes in the subdomain: 0 for
+ * nothing, 1 for the triangle lying on it, 2 for a frozen interface.
+ * A triangle between two tetrahedra of the part is kept once, and a
+ * triangle on an interface is kept by the part of its lower tetrahedron.
+ */
+static int subdomain_face(const Subdomain* s, const int* parts, int part,
+                          int code) {
+    int k = code / 4;
+    int other = s->adjacency[code];
+    int triangle = s->face_triangle[code];
+    if (other >= 0 && parts[other] != part) {
+        return triangle >= 0 && k < other ? 1 : 2;
+    }
+    return triangle >= 0 && (other < 0 || k < other) ? 1 : 0;
+}
+
+/* Copy the tetrahedra of part, their faces and edges into dst */
+static int fill_subdomain(MMG5_pMesh src, MMG5_pMesh dst, const int* parts,
+                          int part, const Subdomain* s) {
+    MMG5_int np = 0, ne = 0, nt = 0, na = 0;
+    for (MMG5_int k = 1; k <= src->ne; k++) {
+        if (parts[k - 1] != part) {
+            continue;
+        }
+        ne++;
+        for (int j = 0; j < 4; j++) {
+            MMG5_int v = src->tetra[k].v[j];
+            if (!s->map[v]) {
+                s->map[v] = ++np;
+            }
+        }
+        for (int i = 0; i < 4; i++) {
+            nt += subdomain_face(s, parts, part, 4 * (int)(k - 1) + i) != 0;
+        }
+    }
+    for (MMG5_int k = 1; k <= src->na; k++) {
+        na += s->map[src->edge[k].a] && s->map[src->edge[k].b];
+    }
+    if (MMG3D_Set_meshSize(dst, np, ne, 0, nt, 0, na) != 1) {
+        return 0;
+    }
+
+    for (MMG5_int v = 1; v <= src->np; v++) {
+        const MMG5_Point* p = &src->point[v];
+        if (s->map[v] &&
+            MMG3D_Set_vertex(dst, p->c[0], p->c[1], p->c[2], p->ref,
+                             s->map[v]) != 1) {
+            return 0;
+        }
+    }
+
+    MMG5_int e = 0, t = 0;
+    for (MMG5_int k = 1; k <= src->ne; k++) {
+        if (parts[k - 1] != part) {
+            continue;
+        }
+        const MMG5_Tetra* tet = &src->tetra[k];
+        if (MMG3D_Set_tetrahedron(dst, s->map[tet->v[0]], s->map[tet->v[1]],
+                                  s->map[tet->v[2]], s->map[tet->v[3]],
+                                  tet->ref, ++e) != 1) {
+            return 0;
+        }
+        for (int i = 0; i < 4; i++) {
+            int code = 4 * (int)(k - 1) + i;
+            int kind = subdomain_face(s, parts, part, code);
+            if (kind == 0) {
+                continue;
+            }
+            MMG5_int v[3], ref = MMGWASM_INTERFACE_REF;
+            if (kind == 1) {
+                const MMG5_Tria* tria = &src->tria[s->face_triangle[code] + 1];
+                v[0] = tria->v[0];
+                v[1] = tria->v[1];
+                v[2] = tria->v[2];
+                ref = tria->ref;
+            } else {
+                for (int j = 0; j < 3; j++) {
+                    v[j] = tet->v[FACE_VERTICES[i][j]];
+                }
+            }
+            if (MMG3D_Set_triangle(dst, s->map[v[0]], s->map[v[1]],
+                                   s->map[v[2]], ref, ++t) != 1) {
+                return 0;
+            }
+            /* Faces between parts stay as they are, on both sides */
+            if (s->adjacency[code] >= 0 && parts[s->adjacency[code]] != part) {
+                MMG3D_Set_requiredTriangle(dst, t);
+                for (int j = 0; j < 3; j++) {
+                    MMG3D_Set_requiredVertex(dst, s->map[v[j]]);
+                }
+            }
+        }
+    }
+
+    MMG5_int a = 0;
+    for (MMG5_int k = 1; k <= src->na; k++) {
+        const MMG5_Edge* edge = &src->edge[k];
+        if (s->map[edge->a] && s->map[edge->b] &&
+            MMG3D_Set_edge(dst, s->map[edge->a], s->map[edge->b], edge->ref,
+                           ++a) != 1) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* MMG5_Scalar, MMG5_Vector or MMG5_Tensor solution of size values per
+   vertex, or MMG5_Notype if sol is not a solution at the np vertices */
+static int vertex_sol_type(MMG5_pSol sol, MMG5_int np) {
+    if (!sol || !sol->m || np == 0 || sol->np != np) {
+        return MMG5_Notype;
+    }
+    switch (sol->size) {
+        case 1:
+            return MMG5_Scalar;
+        case 3:
+            return MMG5_Vector;
+        case 6:
+            return MMG5_Tensor;
+    }
+    return MMG5_Notype;
+}
+
+/* Copy the solution of the src vertices onto their map in dst */
+static int fill_subdomain_sol(MMG5_pMesh src, MMG5_pSol src_sol,
+                              MMG5_pMesh dst, MMG5_pSol dst_sol,
+                              const MMG5_int* map) {
+    int type = vertex_sol_type(src_sol, src->np);
+    if (type == MMG5_Notype) {
+        return 1;
+    }
+    if (MMG3D_Set_solSize(dst, dst_sol, MMG5_Vertex, dst->np, type) != 1) {
+        return 0;
+    }
+    size_t size = (size_t)src_sol->size;
+    for (MMG5_int v = 1; v <= src->np; v++) {
+        if (map[v]) {
+            memcpy(&dst_sol->m[size * map[v]], &src_sol->m[size * v],
+                   size * sizeof(double));
+        }
+    }
+    return 1;
+}
+
+/**
+ * Extract one part of a partition (see mmg3d_partition) as a new mesh
+ * handle: its tetrahedra, the boundary triangles on their faces, and the
+ * faces shared with other parts as required triangles of reference
+ * MMGWASM_INTERFACE_REF with required vertices.
+ * Edges are kept when both ends are in the part, and so is the solution
+ * (the metric) of its vertices. Corners are left out, MMG detects them
+ * again.
+ * Returns the new handle, or -1 on failure.
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg3d_extract_subdomain(int handle, const int* parts, int part) {
+    if (!validate_handle(handle) || !parts) {
+        return -1;
+    }
+
+    MMG5_pMesh src = HANDLE(handle).mesh;
+    MmgwasmElements tetrahedra = mesh_elements(src);
+    MmgwasmElements triangles = {3, 3, tetrahedra.coords, sizeof(MMG5_Point),
+                                 NULL, sizeof(MMG5_Tria), 0};
+    if (src->tria && src->nt > 0) {
+        triangles.elems = src->tria[1].v;
+        triangles.nelem = (int)src->nt;
+    }
+    size_t faces = 4 * (size_t)(src->ne > 0 ? src->ne : 1);
+    Subdomain s = {
+        (int*)malloc(faces * sizeof(int)),
+        (int*)malloc(faces * sizeof(int)),
+        (MMG5_int*)calloc((size_t)src->np + 1, sizeof(MMG5_int)),
+    };
+    int subdomain = -1;
+    if (s.adjacency && s.face_triangle && s.map &&
+        mmgwasm_match_faces(&tetrahedra, (int)src->np, &triangles,
+                            s.adjacency, s.face_triangle)) {
+        subdomain = mmg3d_init();
+    }
+
+    if (subdomain >= 0) {
+        HandleEntry* dst = &HANDLE(subdomain);
+        MmgwasmArena* outer = mmgwasm_arena_enter(&dst->arena);
+        int ok = fill_subdomain(src, dst->mesh, parts, part, &s) &&
+                 fill_subdomain_sol(src, HANDLE(handle).sol, dst->mesh,
+                                    dst->sol, s.map);
+        mmgwasm_arena_leave(outer);
+        if (ok) {
+            MMG3D_Set_iparameter(dst->mesh, dst->sol, MMG3D_IPARAM_verbose,
+                                 src->info.imprim);
+            mark_modified(subdomain);
+        } else {
+            mmg3d_free(subdomain);
+            subdomain = -1;
+        }
+    }
+    free(s.map);
+    free(s.face_triangle);
+    free(s.adjacency);
+    return subdomain;
+}
+
+/* Edge of the welded mesh, sorted to drop the copies of several parts */
+typedef struct {
+    MMG5_int a, b, ref;
+    int ridge;
+} WeldedEdge;
+
+static int compare_edges(const void* x, const void* y) {
+    const WeldedEdge* e = (const WeldedEdge*)x;
+    const WeldedEdge* f = (const WeldedEdge*)y;
+    if (e->a != f->a) return e->a < f->a ? -1 : 1;
+    if (e->b != f->b) return e->b < f->b ? -1 : 1;
+    return 0;
+}
+
+/*
+ * Side of a boundary triangle of the welded mesh between two interface
+ * vertices, to look up the triangles around an edge along an interface
+ */
+typedef struct {
+    MMG5_int a, b, ref;
+    double n[3];  /* unit normal of the triangle */
+} WeldedSide;
+
+static int compare_sides(const void* x, const void* y) {
+    const WeldedSide* e = (const WeldedSide*)x;
+    const WeldedSide* f = (const WeldedSide*)y;
+    if (e->a != f->a) return e->a < f->a ? -1 : 1;
+    if (e->b != f->b) return e->b < f->b ? -1 : 1;
+    return 0;
+}
+
+/* Unit normal of a triangle */
+static void tria_normal(MMG5_pMesh mesh, const MMG5_Tria* tria, double* n) {
+    const double* p0 = mesh->point[tria->v[0]].c;
+    const double* p1 = mesh->point[tria->v[1]].c;
+    const double* p2 = mesh->point[tria->v[2]].c;
+    double u[3], w[3];
+    for (int d = 0; d < 3; d++) {
+        u[d] = p1[d] - p0[d];
+        w[d] = p2[d] - p0[d];
+    }
+    n[0] = u[1] * w[2] - u[2] * w[1];
+    n[1] = u[2] * w[0] - u[0] * w[2];
+    n[2] = u[0] * w[1] - u[1] * w[0];
+    double len = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    for (int d = 0; d < 3; d++) {
+        n[d] = len > 0.0 ? n[d] / len : 0.0;
+    }
+}
+
+/*
+ * Whether an edge along an interface is a feature of the welded mesh, as
+ * MMG would detect it: not between exactly two boundary triangles, between
+ * two references, or a ridge sharper than the detection angle dhd (a
+ * cosine, -1 when detection is off). MMG sees the frozen interface of a
+ * part as boundary, so it reports the edges around it as features too.
+ */
+static int is_welded_feature(const WeldedSide* sides, MMG5_int count,
+                             const WeldedEdge* edge, double dhd,
+                             int* ridge) {
+    WeldedSide key = {edge->a, edge->b, 0, {0.0, 0.0, 0.0}};
+    MMG5_int lo = 0, hi = count;
+    while (lo < hi) {
+        MMG5_int mid = lo + (hi - lo) / 2;
+        if (compare_sides(&sides[mid], &key) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    MMG5_int end = lo;
+    while (end < count && !compare_sides(&sides[end], &key)) {
+        end++;
+    }
+    if (end - lo != 2) {
+        return end > lo;
+    }
+    const double* n = sides[lo].n;
+    const double* m = sides[lo + 1].n;
+    *ridge = n[0] * m[0] + n[1] * m[1] + n[2] * m[2] <= dhd;
+    return *ridge || sides[lo].ref != sides[lo + 1].ref;
+}
+
+/*
+ * Copy count remeshed parts into dst, given the welded vertex of each of
+ * their vertices (in order of the parts). The solution is copied too when
+ * every part has one of the same type.
+ */
+static int fill_welded(const int* handles, int count, MMG5_pMesh dst,
+                       MMG5_pSol dst_sol, const int* welded, int np,
+                       size_t total) {
+    MMG5_int ne = 0, nt = 0, na = 0;
+    int sol_type = vertex_sol_type(HANDLE(handles[0]).sol,
+                                   HANDLE(handles[0]).mesh->np);
+    for (int h = 0; h < count; h++) {
+        MMG5_pMesh part = HANDLE(handles[h]).mesh;
+        if (vertex_sol_type(HANDLE(handles[h]).sol, part->np) != sol_type) {
+            sol_type = MMG5_Notype;
+        }
+        ne += part->ne;
+        na += part->na;
+        for (MMG5_int k = 1; k <= part->nt; k++) {
+            nt += part->tria[k].ref != MMGWASM_INTERFACE_REF;
+        }
+    }
+
+    /* Vertices of the interface triangles, in order of the parts */
+    unsigned char* on_interface = (unsigned char*)calloc(
+        total > 0 ? total : 1, 1);
+    WeldedEdge* edges = (WeldedEdge*)malloc((na > 0 ? (size_t)na : 1) *
+                                            sizeof(WeldedEdge));
+    WeldedSide* sides = NULL;
+    MMG5_int nsides = 0;
+    int ok = on_interface && edges;
+    int offset = 0;
+    for (int h = 0; h < count && ok; h++) {
+        MMG5_pMesh part = HANDLE(handles[h]).mesh;
+        for (MMG5_int k = 1; k <= part->nt; k++) {
+            if (part->tria[k].ref == MMGWASM_INTERFACE_REF) {
+                for (int i = 0; i < 3; i++) {
+                    on_interface[offset + part->tria[k].v[i] - 1] = 1;
+                }
+            }
+        }
+        offset += (int)part->np;
+    }
+
+    /* Sides of the boundary triangles along the interfaces: count, fill */
+    for (int pass = 0; pass < 2 && ok; pass++) {
+        MMG5_int m = 0;
+        offset = 0;
+        for (int h = 0; h < count; h++) {
+            MMG5_pMesh part = HANDLE(handles[h]).mesh;
+            for (MMG5_int k = 1; k <= part->nt; k++) {
+                const MMG5_Tria* tria = &part->tria[k];
+                if (tria->ref == MMGWASM_INTERFACE_REF) {
+                    continue;
+                }
+                double n[3];
+                if (pass) {
+                    tria_normal(part, tria, n);
+                }
+                for (int i = 0; i < 3; i++) {
+                    MMG5_int u = offset + tria->v[i] - 1;
+                    MMG5_int w = offset + tria->v[(i + 1) % 3] - 1;
+                    if (!on_interface[u] || !on_interface[w]) {
+                        continue;
+                    }
+                    if (pass) {
+                        MMG5_int a = welded[u] + 1, b = welded[w] + 1;
+                        sides[m] = (WeldedSide){a < b ? a : b, a < b ? b : a,
+                                                tria->ref,
+                                                {n[0], n[1], n[2]}};
+                    }
+                    m++;
+                }
+            }
+            offset += (int)part->np;
+        }
+        if (!pass) {
+            sides = (WeldedSide*)malloc((m > 0 ? (size_t)m : 1) *
+                                        sizeof(WeldedSide));
+            ok = sides != NULL;
+        }
+        nsides = m;
+    }
+    if (ok) {
+        qsort(sides, (size_t)nsides, sizeof(WeldedSide), compare_sides);
+    }
+
+    /* Keep the edges along an interface only if they are features */
+    MMG5_int n = 0;
+    offset = 0;
+    for (int h = 0; h < count && ok; h++) {
+        MMG5_pMesh part = HANDLE(handles[h]).mesh;
+        for (MMG5_int k = 1; k <= part->na; k++) {
+            const MMG5_Edge* edge = &part->edge[k];
+            MMG5_int u = offset + edge->a - 1;
+            MMG5_int w = offset + edge->b - 1;
+            MMG5_int a = welded[u] + 1, b = welded[w] + 1;
+            WeldedEdge e = {a < b ? a : b, a < b ? b : a, edge->ref,
+                            (edge->tag & MG_GEO) != 0};
+            if (!on_interface[u] || !on_interface[w] ||
+                is_welded_feature(sides, nsides, &e, part->info.dhd,
+                                  &e.ridge)) {
+                edges[n++] = e;
+            }
+        }
+        offset += (int)part->np;
+    }
+    free(sides);
+    free(on_interface);
+    qsort(edges, (size_t)n, sizeof(WeldedEdge), compare_edges);
+    MMG5_int unique = 0;
+    for (MMG5_int k = 0; k < n; k++) {
+        if (unique == 0 || compare_edges(&edges[unique - 1], &edges[k])) {
+            edges[unique++] = edges[k];
+        }
+    }
+
+    ok = ok && MMG3D_Set_meshSize(dst, np, ne, 0, nt, 0, unique) == 1;
+    ok = ok && (sol_type == MMG5_Notype ||
+                MMG3D_Set_solSize(dst, dst_sol, MMG5_Vertex, np,
+                                  sol_type) == 1);
+
+    /* Welded vertices are numbered in order of their first copy */
+    MMG5_int e = 0, t = 0, v = 0;
+    offset = 0;
+    for (int h = 0; h < count && ok; h++) {
+        MMG5_pMesh part = HANDLE(handles[h]).mesh;
+        for (MMG5_int k = 1; ok && k <= part->np; k++) {
+            if (welded[offset + k - 1] == v) {
+                const MMG5_Point* p = &part->point[k];
+                ok = MMG3D_Set_vertex(dst, p->c[0], p->c[1], p->c[2], p->ref,
+                                      ++v) == 1;
+                if (ok && sol_type != MMG5_Notype) {
+                    MMG5_pSol sol = HANDLE(handles[h]).sol;
+                    size_t size = (size_t)sol->size;
+                    memcpy(&dst_sol->m[size * v], &sol->m[size * k],
+                           size * sizeof(double));
+                }
+            }
+        }
+        for (MMG5_int k = 1; ok && k <= part->ne; k++) {
+            const MMG5_int* tv = part->tetra[k].v;
+            ok = MMG3D_Set_tetrahedron(dst, welded[offset + tv[0] - 1] + 1,
+                                       welded[offset + tv[1] - 1] + 1,
+                                       welded[offset + tv[2] - 1] + 1,
+                                       welded[offset + tv[3] - 1] + 1,
+                                       part->tetra[k].ref, ++e) == 1;
+        }
+        for (MMG5_int k = 1; ok && k <= part->nt; k++) {
+            const MMG5_Tria* tria = &part->tria[k];
+            if (tria->ref == MMGWASM_INTERFACE_REF) {
+                continue;
+            }
+            ok = MMG3D_Set_triangle(dst, welded[offset + tria->v[0] - 1] + 1,
+                                    welded[offset + tria->v[1] - 1] + 1,
+                                    welded[offset + tria->v[2] - 1] + 1,
+                                    tria->ref, ++t) == 1;
+        }
+        offset += (int)part->np;
+    }
+    for (MMG5_int k = 0; ok && k < unique; k++) {
+        ok = MMG3D_Set_edge(dst, edges[k].a, edges[k].b, edges[k].ref,
+                            k + 1) == 1 &&
+             (!edges[k].ridge || MMG3D_Set_ridge(dst, k + 1) == 1);
+    }
+    free(edges);
+    return ok;
+}
+
+/**
+ * Weld remeshed parts back into one new mesh handle (see partition.h).
+ * Vertices closer than MMGWASM_WELD_TOLERANCE of the bounding box diagonal
+ * are merged, the interface triangles are dropped and so are the required
+ * tags that froze them. Edges shared by several parts are kept once, and
+ * edges along the interfaces only if they are features of the welded mesh.
+ * The solution (the metric) of the parts is kept if they all have one.
+ * Returns the new handle, or -1 on failure.
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmg3d_merge_subdomains(const int* handles, int count) {
+    if (!handles || count < 1) {
+        return -1;
+    }
+    size_t total = 0;
+    for (int h = 0; h < count; h++) {
+        if (!validate_handle(handles[h])) {
+            return -1;
+        }
+        total += (size_t)HANDLE(handles[h]).mesh->np;
+    }
+    if (total > INT32_MAX) {
+        return -1;
+    }
+
+    double* coords = (double*)malloc((total > 0 ? total : 1) * 3 *
+                                     sizeof(double));
+    int* welded = (int*)malloc((total > 0 ? total : 1) * sizeof(int));
+    if (!coords || !welded) {
+        free(welded);
+        free(coords);
+        return -1;
+    }
+    double min[3] = {HUGE_VAL, HUGE_VAL, HUGE_VAL};
+    double max[3] = {-HUGE_VAL, -HUGE_VAL, -HUGE_VAL};
+    size_t i = 0;
+    for (int h = 0; h < count; h++) {
+        MMG5_pMesh part = HANDLE(handles[h]).mesh;
+        for (MMG5_int k = 1; k <= part->np; k++, i++) {
+            for (int d = 0; d < 3; d++) {
+                double x = part->point[k].c[d];
+                coords[3 * i + d] = x;
+                if (x < min[d]) min[d] = x;
+                if (x > max[d]) max[d] = x;
+            }
+        }
+    }
+    double diag2 = 0.0;
+    for (int d = 0; total > 0 && d < 3; d++) {
+        diag2 += (max[d] - min[d]) * (max[d] - min[d]);
+    }
+    int np = mmgwasm_weld(coords, 3 * sizeof(double), (int)total,
+                          sqrt(diag2) * MMGWASM_WELD_TOLERANCE, welded);
+    free(coords);
+
+    int merged = np >= 0 ? mmg3d_init() : -1;
+    if (merged >= 0) {
+        HandleEntry* dst = &HANDLE(merged);
+        MmgwasmArena* outer = mmgwasm_arena_enter(&dst->arena);
+        int ok = fill_welded(handles, count, dst->mesh, dst->sol, welded, np,
+                             total);
+        mmgwasm_arena_leave(outer);
+        if (ok) {
+            MMG3D_Set_iparameter(dst->mesh, dst->sol, MMG3D_IPARAM_verbose,
+                                 HANDLE(handles[0]).mesh->info.imprim);
+            mark_modified(merged);
+        } else {
+            mmg3d_free(merged);
+            merged = -1;
+        }
+    }
+    free(welded);
+    return merged;
+}
+
+/*
+ * Batch remeshing
+ *
+ * Many small meshes are remeshed in one call and their results written to
+ * one buffer (see batch.h).
+ */
+
+/* Entities of a mesh (none for NULL), read in place by the batch writer */
+static MmgwasmBatchMesh batch_mesh_3d(MMG5_pMesh mesh) {
+    MmgwasmBatchMesh out = {
+        3, NULL, NULL, sizeof(MMG5_Point), 0,
+        {NULL, NULL, sizeof(MMG5_Tetra), 4, 0},
+        {NULL, NULL, sizeof(MMG5_Tria), 3, 0}
+    };
+    if (!mesh) {
+        return out;
+    }
+    if (mesh->point && mesh->np > 0) {
+        out.coords = mesh->point[1].c;
+        out.refs = &mesh->point[1].ref;
+        out.np = (int)mesh->np;
+    }
+    if (mesh->tetra && mesh->ne > 0) {
+        out.cells.verts = mesh->tetra[1].v;
+        out.cells.refs = &mesh->tetra[1].ref;
+        out.cells.count = (int)mesh->ne;
+    }
+    if (mesh->tria && mesh->nt > 0) {
+        out.boundary.verts = mesh->tria[1].v;
+        out.boundary.refs = &mesh->tria[1].ref;
+        out.boundary.count = (int)mesh->nt;
+    }
+    return out;
+}
+
+/*
+ * Import a mesh into a new handle, set the batch parameters and remesh it,
+ * filling the statistics of record.
+ * Returns the handle, to free once its result is written, or -1 if the mesh
+ * could not be imported.
+ */
+static int remesh_batch_entry_3d(const MmgwasmMeshImport* desc,
+                                 const MmgwasmBatchParameter* params,
+                                 int nparams, MmgwasmBatchRecord* record) {
+    memset(record, 0, sizeof(*record));
+    record->status = -1;
+
+    int handle = mmg3d_init();
+    if (handle < 0) {
+        return -1;
+    }
+    int ok = mmg3d_import_mesh(handle, desc);
+    for (int i = 0; ok && i < nparams; i++) {
+        ok = params[i].kind == MMGWASM_BATCH_DOUBLE
+            ? mmg3d_set_dparameter(handle, params[i].param, params[i].value)
+            : mmg3d_set_iparameter(handle, params[i].param,
+                                   (int)params[i].value);
+    }
+    if (!ok) {
+        mmg3d_free(handle);
+        return -1;
+    }
+
+    QualityStats stats;
+    double start = emscripten_get_now();
+    mmg3d_get_quality_stats(handle, 0, &stats, NULL);
+    record->quality_before = stats.min;
+    double remesh_start = emscripten_get_now();
+    record->status = run_remesh(handle);
+    double remesh_end = emscripten_get_now();
+    mmg3d_get_quality_stats(handle, 0, &stats, NULL);
+    record->quality_after = stats.min;
+    record->remesh_ms = remesh_end - remesh_start;
+    record->quality_ms =
+        (remesh_start - start) + (emscripten_get_now() - remesh_end);
+    return handle;
+}
+
+/**
+ * Remesh count meshes one after another with the same parameters, writing
+ * every result into one buffer (see batch.h).
+ * meshes holds count import descriptors (see import.h); params holds nparams
+ * parameters, set on each mesh over the defaults. Every mesh goes through a
+ * new handle, which recycles the same slot and arena, since MMG keeps the
+ * adjacency and computed sizes of a mesh it has remeshed. Meshes whose
+ * remesh fails strongly (return code 2 or more) get an empty record.
+ * out_size receives the number of bytes. The buffer is owned by handle and
+ * overwritten by the next batch; it must NOT be passed to mmg3d_free_array.
+ * Returns NULL on failure.
+ */
+EMSCRIPTEN_KEEPALIVE
+const void* mmg3d_remesh_batch(int handle, const MmgwasmMeshImport* meshes,
+                               int count, const MmgwasmBatchParameter* params,
+                               int nparams, int* out_size) {
+    if (out_size) *out_size = 0;
+    if (!validate_handle(handle) || count < 0 || nparams < 0 ||
+        (count > 0 && !meshes) || (nparams > 0 && !params)) {
+        return NULL;
+    }
+
+    ViewBuffer* out = &HANDLE(handle).batch;
+    size_t used = MMGWASM_BATCH_HEADER_BYTES;
+    if (!view_reserve(out, used)) {
+        return NULL;
+    }
+
+    for (int i = 0; i < count; i++) {
+        MmgwasmBatchRecord record;
+        int scratch = remesh_batch_entry_3d(&meshes[i], params, nparams,
+                                            &record);
+        MmgwasmBatchMesh result = batch_mesh_3d(NULL);
+        if (scratch >= 0 && record.status >= 0 && record.status <= 1) {
+            result = batch_mesh_3d(HANDLE(scratch).mesh);
+        }
+
+        size_t bytes = mmgwasm_batch_record_size(&result);
+        char* data = view_reserve(out, used + bytes);
+        if (data) {
+            mmgwasm_batch_write(&result, &record, data + used);
+            used += bytes;
+        }
+        if (scratch >= 0) {
+            mmg3d_free(scratch);
+        }
+        if (!data || used > INT32_MAX) {
+            return NULL;
+        }
+    }
+
+    int32_t* header = (int32_t*)out->data;
+    header[0] = count;
+    header[1] = 0;
+    if (out_size) *out_size = (int)used;
+    return out->data;
+}
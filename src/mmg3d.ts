@@ -5,8 +5,40 @@
  * Uses Emscripten's cwrap to call the C wrapper functions.
  */
 
-import type { EmscriptenFS } from "./fs";
-import type { WasmModule } from "./memory";
+import {
+  BATCH_PARAMETER_BYTES,
+  decodeBatch,
+  writeBatchParameters,
+} from "./batch";
+import type { EmscriptenFS, OPFSModule } from "./fs";
+import { type InitOptions, loadModule } from "./loader";
+import {
+  type MemFileModule,
+  appendStreamToMemFile,
+  appendToMemFile,
+  createMemFile,
+  freeMemFile,
+  readMemFile,
+} from "./memfile";
+import {
+  type MeshImportData,
+  type MeshImportLayout,
+  packMeshImport,
+  packMeshImports,
+} from "./import";
+import {
+  type HandleMemoryUsage,
+  type HeapReserveModule,
+  type NativeMemoryModule,
+  releaseScratchMemory,
+  scratchMemory,
+} from "./memory";
+import type { PointerSizeModule } from "./memory64";
+import type { OptionParameter } from "./options";
+import { type PackOptions, packFlags } from "./packed";
+import type { BatchRemeshResult, RemeshStats } from "./result";
+import { SIZING_STRIDE } from "./sizing";
+import { STATS_BYTES, readRemeshStats } from "./stats";
 
 /**
  * Integer parameters for MMG3D (matching MMG3D_Param enum in libmmg3d.h)
@@ -75,8 +107,16 @@ export const MMG_RETURN_CODES = {
   SUCCESS: 0,
   LOWFAILURE: 1, // The mesh is not suitable for remeshing
   STRONGFAILURE: 2, // The mesh is not valid
+  ABORTED: -3, // The remesh was cancelled with abortRemesh()
 } as const;
 
+/**
+ * Reference of the triangles that freeze the faces between the parts of a
+ * partitioned remesh (MMGWASM_INTERFACE_REF in src/partition.h). Boundary
+ * triangles of partitioned meshes must not use it.
+ */
+export const SUBDOMAIN_INTERFACE_REF = 2147483647;
+
 /**
  * Solution entity types (matching MMG5_entities enum)
  * Specifies where solution values are defined
@@ -102,12 +142,85 @@ export interface SolInfo {
   typSol: number;
 }
 
+/** Element quality statistics computed in a single pass */
+export interface QualityStats {
+  /** Minimum element quality (0 for an empty mesh) */
+  min: number;
+  /** Maximum element quality (0 for an empty mesh) */
+  max: number;
+  /** Mean element quality (0 for an empty mesh) */
+  mean: number;
+  /** Number of tetrahedra */
+  count: number;
+  /** Element counts per uniform quality bin over [0, 1] */
+  histogram: Int32Array;
+}
+
+/**
+ * Clipping plane of a display surface: tetrahedra whose centroid c satisfies
+ * dot(c, normal) <= offset are kept
+ */
+export interface SurfaceClip {
+  normal: [number, number, number];
+  offset: number;
+}
+
+/** Display surface of a tetrahedral mesh, ready for GPU buffers */
+export interface SurfaceGeometry {
+  /** Positions of the surface vertices, 3 per vertex */
+  positions: Float32Array;
+  /** Unit vertex normals, area-weighted over the adjacent faces */
+  normals: Float32Array;
+  /** Triangle vertex indices (0-based), counter-clockwise seen from outside */
+  indices: Uint32Array;
+  /** 0-based tetrahedron each triangle is a face of, e.g. for colouring */
+  cells: Int32Array;
+}
+
+/** Result of locating points in a mesh */
+export interface PointLocation {
+  /** 1-indexed tetrahedron containing each point (0 outside the mesh) */
+  elements: Int32Array;
+  /** 4 barycentric coordinates per point, in the tetrahedron vertex order */
+  barycentric: Float64Array;
+  /** Number of points located */
+  located: number;
+}
+
+/** Phase of a remesh, as reported by MMG */
+export type RemeshPhase =
+  | "idle"
+  | "analysis"
+  | "meshing"
+  | "finalize"
+  | "done";
+
+/** Progress of a remesh on a handle with progress tracking enabled */
+export interface RemeshProgress {
+  /** Current phase */
+  phase: RemeshPhase;
+  /** Progress estimate (0-100) */
+  percent: number;
+  /** Swap and move passes of the meshing phase started so far */
+  iterations: number;
+}
+
 /** Internal module interface (raw Emscripten functions) */
-export interface MMG3DModule extends WasmModule {
+export interface MMG3DModule
+  extends MemFileModule,
+    HeapReserveModule,
+    NativeMemoryModule,
+    OPFSModule,
+    PointerSizeModule {
   _mmg3d_init(): number;
   _mmg3d_free(handle: number): number;
+  _mmg3d_clone(handle: number): number;
   _mmg3d_get_available_handles(): number;
   _mmg3d_get_max_handles(): number;
+  _mmg3d_set_max_handles(maxHandles: number): number;
+  _mmg3d_set_arena_mode(enabled: number): void;
+  _mmg3d_get_memory_usage(handle: number, outPtr: number): number;
+  _mmg3d_import_mesh(handle: number, descriptorPtr: number): number;
   _mmg3d_set_mesh_size(
     handle: number,
     np: number,
@@ -187,14 +300,107 @@ export interface MMG3DModule extends WasmModule {
   _mmg3d_get_scalar_sols(handle: number, outCountPtr: number): number;
   _mmg3d_set_tensor_sols(handle: number, valuesPtr: number): number;
   _mmg3d_get_tensor_sols(handle: number, outCountPtr: number): number;
+  _mmg3d_apply_sizing(
+    handle: number,
+    constraintsPtr: number,
+    count: number,
+  ): number;
+  _mmg3d_freeze_outside(
+    handle: number,
+    regionsPtr: number,
+    count: number,
+    margin: number,
+  ): number;
+  _mmg3d_thaw(handle: number): number;
+  _mmg3d_locate_points(
+    handle: number,
+    pointsPtr: number,
+    n: number,
+    outElementsPtr: number,
+    outBaryPtr: number,
+  ): number;
+  _mmg3d_sample_sol(
+    handle: number,
+    pointsPtr: number,
+    n: number,
+    outPtr: number,
+  ): number;
+  _mmg3d_interpolate_fields(
+    handle: number,
+    source: number,
+    valuesPtr: number,
+    stride: number,
+    outPtr: number,
+  ): number;
   _mmg3d_remesh(handle: number): number;
+  _mmg3d_remesh_async(handle: number): number;
+  _mmg3d_remesh_status(handle: number): number;
+  _mmg3d_get_progress(handle: number): number;
+  _mmg3d_get_stats(handle: number, outPtr: number): number;
   _mmg3d_free_array(ptr: number): void;
   _mmg3d_load_mesh(handle: number, filenamePtr: number): number;
+  _mmg3d_load_mesh_from_memfile(
+    handle: number,
+    file: number,
+    binary: number,
+  ): number;
   _mmg3d_save_mesh(handle: number, filenamePtr: number): number;
+  _mmg3d_save_mesh_to_memfile(
+    handle: number,
+    file: number,
+    binary: number,
+  ): number;
   _mmg3d_load_sol(handle: number, filenamePtr: number): number;
+  _mmg3d_load_sol_from_memfile(
+    handle: number,
+    file: number,
+    binary: number,
+  ): number;
   _mmg3d_save_sol(handle: number, filenamePtr: number): number;
+  _mmg3d_save_sol_to_memfile(
+    handle: number,
+    file: number,
+    binary: number,
+  ): number;
   _mmg3d_get_tetrahedron_quality(handle: number, k: number): number;
   _mmg3d_get_tetrahedra_qualities(handle: number, outCountPtr: number): number;
+  _mmg3d_get_quality_stats(
+    handle: number,
+    nbins: number,
+    statsPtr: number,
+    histogramPtr: number,
+  ): number;
+  _mmg3d_get_generation(handle: number): number;
+  _mmg3d_view_vertices(handle: number, outCountPtr: number): number;
+  _mmg3d_view_tetrahedra(handle: number, outCountPtr: number): number;
+  _mmg3d_view_triangles(handle: number, outCountPtr: number): number;
+  _mmg3d_view_sols(
+    handle: number,
+    outCountPtr: number,
+    outSizePtr: number,
+  ): number;
+  _mmg3d_pack_mesh(handle: number, flags: number, outSizePtr: number): number;
+  _mmg3d_remesh_batch(
+    handle: number,
+    meshesPtr: number,
+    count: number,
+    parametersPtr: number,
+    nparameters: number,
+    outSizePtr: number,
+  ): number;
+  _mmg3d_extract_surface(handle: number, planePtr: number): number;
+  _mmg3d_partition(
+    handle: number,
+    nparts: number,
+    pass: number,
+    outPtr: number,
+  ): number;
+  _mmg3d_extract_subdomain(
+    handle: number,
+    partsPtr: number,
+    part: number,
+  ): number;
+  _mmg3d_merge_subdomains(handlesPtr: number, count: number): number;
   getValue(ptr: number, type: string): number;
   setValue(ptr: number, value: number, type: string): void;
   lengthBytesUTF8(str: string): number;
@@ -202,22 +408,58 @@ export interface MMG3DModule extends WasmModule {
   FS: EmscriptenFS;
 }
 
+// Entity sizes for importMesh
+const IMPORT_LAYOUT: MeshImportLayout = {
+  dim: 3,
+  cellSize: 4,
+  boundarySize: 3,
+  tensorSize: 6,
+};
+
+// Status reported by the C wrapper while an asynchronous remesh is running
+const REMESH_RUNNING = -2;
+// Polling interval for asynchronous remesh completion (ms)
+const REMESH_POLL_MS = 4;
+// Int32 field offsets of the C progress record (MmgwasmProgress)
+const PROGRESS_ENABLED = 0;
+const PROGRESS_ABORT = 1;
+const PROGRESS_PHASE = 2;
+const PROGRESS_PERCENT = 3;
+const PROGRESS_ITERATIONS = 4;
+const REMESH_PHASES: RemeshPhase[] = [
+  "idle",
+  "analysis",
+  "meshing",
+  "finalize",
+  "done",
+];
+
 let module: MMG3DModule | null = null;
 
 /**
  * Initialize the MMG3D WASM module.
  * Must be called before using any MMG3D functions.
+ *
+ * @param options - Optional settings, e.g. the maximum number of handles
  */
-export async function initMMG3D(): Promise<void> {
-  if (module) {
-    return; // Already initialized
+export async function initMMG3D(options: InitOptions = {}): Promise<void> {
+  if (!module) {
+    // Instance of the Emscripten-generated module shared with the other
+    // mesh types, or of this type's own module (see setSplitModules). It
+    // doesn't have TypeScript declarations, so we cast through unknown to
+    // the properly typed interface
+    module = (await loadModule(
+      "mmg3d",
+      options.heapBytes,
+    )) as unknown as MMG3DModule;
   }
 
-  // Dynamic import of the Emscripten-generated module
-  // The Emscripten-generated module doesn't have TypeScript declarations,
-  // so we cast through unknown to the properly typed interface
-  const createModule = (await import("../build/dist/mmg.js")).default;
-  module = (await createModule()) as unknown as MMG3DModule;
+  if (options.maxHandles !== undefined) {
+    MMG3D.setMaxHandles(options.maxHandles);
+  }
+  if (options.arena !== undefined) {
+    MMG3D.setArenaMode(options.arena);
+  }
 }
 
 /**
@@ -275,6 +517,28 @@ export const MMG3D = {
     if (result !== 1) {
       throw new Error("Failed to free MMG3D mesh (invalid handle?)");
     }
+    // The scratch memory of the transfers goes with the last mesh
+    if (m._mmg3d_get_available_handles() === m._mmg3d_get_max_handles()) {
+      releaseScratchMemory(m);
+    }
+  },
+
+  /**
+   * Duplicate a mesh, including refs, tags and the solution/metric field.
+   * The copy is made entirely inside WASM memory.
+   * @param handle - The mesh handle to clone
+   * @returns A new, independent mesh handle
+   * @throws Error if the handle is invalid or no handle slot is available
+   */
+  clone(handle: MeshHandle): MeshHandle {
+    const m = getModule();
+    const cloned = m._mmg3d_clone(handle);
+    if (cloned < 0) {
+      throw new Error(
+        "Failed to clone MMG3D mesh (invalid handle or max handles reached?)",
+      );
+    }
+    return cloned as MeshHandle;
   },
 
   /**
@@ -288,13 +552,60 @@ export const MMG3D = {
 
   /**
    * Get the maximum number of concurrent mesh handles supported.
-   * @returns Maximum number of handles (currently 64)
+   * @returns Maximum number of handles (1024 unless changed)
    */
   getMaxHandles(): number {
     const m = getModule();
     return m._mmg3d_get_max_handles();
   },
 
+  /**
+   * Set the maximum number of concurrent mesh handles.
+   * Handle slots are allocated on demand, so a large maximum costs nothing
+   * until it is used.
+   * @param maxHandles - New maximum (at most 65536)
+   * @throws Error if maxHandles is out of range or below the number of handle
+   *   slots already in use
+   */
+  setMaxHandles(maxHandles: number): void {
+    const m = getModule();
+    if (m._mmg3d_set_max_handles(maxHandles) !== 1) {
+      throw new Error(`Failed to set MMG3D max handles to ${maxHandles}`);
+    }
+  },
+
+  /**
+   * Allocate MMG's memory for handles created from now on from a per-handle
+   * arena, returned to the heap in one step when the handle is freed. This
+   * keeps long-lived modules from fragmenting their heap across many jobs.
+   * Existing handles keep their mode.
+   * @param enabled - true for arena mode, false for the regular heap
+   */
+  setArenaMode(enabled: boolean): void {
+    const m = getModule();
+    m._mmg3d_set_arena_mode(enabled ? 1 : 0);
+  },
+
+  /**
+   * Get the memory held for a mesh handle: what MMG allocated for it, its
+   * memory limit and the size of its arena.
+   * @param handle - The mesh handle
+   * @returns Memory usage in bytes
+   * @throws Error if the handle is invalid
+   */
+  getMemoryUsage(handle: MeshHandle): HandleMemoryUsage {
+    const m = getModule();
+    const [ptr] = scratchMemory(m, [3 * 8]);
+    if (m._mmg3d_get_memory_usage(handle, ptr) !== 1) {
+      throw new Error("Failed to get memory usage");
+    }
+    return {
+      used: m.HEAPF64[ptr / 8],
+      max: m.HEAPF64[ptr / 8 + 1],
+      arena: m.HEAPF64[ptr / 8 + 2],
+    };
+  },
+
   /**
    * Set the mesh size (allocate memory for mesh entities).
    * @param handle - The mesh handle
@@ -338,37 +649,45 @@ export const MMG3D = {
   getMeshSize(handle: MeshHandle): MeshSize {
     const m = getModule();
 
-    // Allocate space for 6 integers
-    const ptr = m._malloc(6 * 4);
-    if (ptr === 0) {
-      throw new Error("Failed to allocate memory");
-    }
+    const [ptr] = scratchMemory(m, [6 * 4]);
+    const result = m._mmg3d_get_mesh_size(
+      handle,
+      ptr, // np
+      ptr + 4, // ne
+      ptr + 8, // nprism
+      ptr + 12, // nt
+      ptr + 16, // nquad
+      ptr + 20, // na
+    );
 
-    try {
-      const result = m._mmg3d_get_mesh_size(
-        handle,
-        ptr, // np
-        ptr + 4, // ne
-        ptr + 8, // nprism
-        ptr + 12, // nt
-        ptr + 16, // nquad
-        ptr + 20, // na
-      );
+    if (result !== 1) {
+      throw new Error("Failed to get mesh size");
+    }
 
-      if (result !== 1) {
-        throw new Error("Failed to get mesh size");
-      }
+    return {
+      nVertices: m.getValue(ptr, "i32"),
+      nTetrahedra: m.getValue(ptr + 4, "i32"),
+      nPrisms: m.getValue(ptr + 8, "i32"),
+      nTriangles: m.getValue(ptr + 12, "i32"),
+      nQuads: m.getValue(ptr + 16, "i32"),
+      nEdges: m.getValue(ptr + 20, "i32"),
+    };
+  },
 
-      return {
-        nVertices: m.getValue(ptr, "i32"),
-        nTetrahedra: m.getValue(ptr + 4, "i32"),
-        nPrisms: m.getValue(ptr + 8, "i32"),
-        nTriangles: m.getValue(ptr + 12, "i32"),
-        nQuads: m.getValue(ptr + 16, "i32"),
-        nEdges: m.getValue(ptr + 20, "i32"),
-      };
-    } finally {
-      m._free(ptr);
+  /**
+   * Size and fill a mesh and its metric in one call.
+   * All arrays are copied into a single staging buffer and set natively at
+   * once, instead of one allocation, copy and call per array.
+   * @param handle - The mesh handle
+   * @param data - Vertices, tetrahedra, boundary triangles, their references and an optional
+   *   metric (1 or 6 values per vertex)
+   * @throws Error if an array has the wrong length or the import fails
+   */
+  importMesh(handle: MeshHandle, data: MeshImportData): void {
+    const m = getModule();
+    const ptr = packMeshImport(m, data, IMPORT_LAYOUT);
+    if (m._mmg3d_import_mesh(handle, ptr) !== 1) {
+      throw new Error("Failed to import mesh");
     }
   },
 
@@ -421,35 +740,22 @@ export const MMG3D = {
 
     const m = getModule();
 
-    // Allocate and copy vertices to WASM heap
-    const verticesPtr = m._malloc(vertices.byteLength);
-    if (verticesPtr === 0) {
-      throw new Error("Failed to allocate memory for vertices");
+    const [verticesPtr, refsPtr] = scratchMemory(m, [
+      vertices.byteLength,
+      refs ? refs.byteLength : 0,
+    ]);
+    m.HEAPF64.set(vertices, verticesPtr / 8);
+    if (refs) {
+      m.HEAP32.set(refs, refsPtr / 4);
     }
 
-    let refsPtr = 0;
-    try {
-      // Copy vertices to WASM heap
-      m.HEAPF64.set(vertices, verticesPtr / 8);
-
-      // Handle refs if provided
-      if (refs) {
-        refsPtr = m._malloc(refs.byteLength);
-        if (refsPtr === 0) {
-          throw new Error("Failed to allocate memory for refs");
-        }
-        m.HEAP32.set(refs, refsPtr / 4);
-      }
-
-      const result = m._mmg3d_set_vertices(handle, verticesPtr, refsPtr);
-      if (result !== 1) {
-        throw new Error("Failed to set vertices");
-      }
-    } finally {
-      m._free(verticesPtr);
-      if (refsPtr !== 0) {
-        m._free(refsPtr);
-      }
+    const result = m._mmg3d_set_vertices(
+      handle,
+      verticesPtr,
+      refs ? refsPtr : 0,
+    );
+    if (result !== 1) {
+      throw new Error("Failed to set vertices");
     }
   },
 
@@ -459,37 +765,9 @@ export const MMG3D = {
    * @returns Float64Array of vertex coordinates [x0, y0, z0, x1, y1, z1, ...]
    */
   getVertices(handle: MeshHandle): Float64Array {
-    const m = getModule();
-
-    // Allocate space for output count
-    const countPtr = m._malloc(4);
-    if (countPtr === 0) {
-      throw new Error("Failed to allocate memory");
-    }
-
-    try {
-      const dataPtr = m._mmg3d_get_vertices(handle, countPtr);
-      if (dataPtr === 0) {
-        // Check if there are simply no vertices
-        const count = m.getValue(countPtr, "i32");
-        if (count === 0) {
-          return new Float64Array(0);
-        }
-        throw new Error("Failed to get vertices");
-      }
-
-      try {
-        const count = m.getValue(countPtr, "i32");
-        // Copy data from WASM heap
-        const result = new Float64Array(count * 3);
-        result.set(m.HEAPF64.subarray(dataPtr / 8, dataPtr / 8 + count * 3));
-        return result;
-      } finally {
-        m._mmg3d_free_array(dataPtr);
-      }
-    } finally {
-      m._free(countPtr);
-    }
+    // Copied out of the packed view buffer, which the handle keeps and
+    // only repacks after the mesh changes
+    return this.getVerticesView(handle).slice();
   },
 
   /**
@@ -540,35 +818,22 @@ export const MMG3D = {
 
     const m = getModule();
 
-    // Allocate and copy tetrahedra to WASM heap
-    const tetraPtr = m._malloc(tetrahedra.byteLength);
-    if (tetraPtr === 0) {
-      throw new Error("Failed to allocate memory for tetrahedra");
+    const [tetraPtr, refsPtr] = scratchMemory(m, [
+      tetrahedra.byteLength,
+      refs ? refs.byteLength : 0,
+    ]);
+    m.HEAP32.set(tetrahedra, tetraPtr / 4);
+    if (refs) {
+      m.HEAP32.set(refs, refsPtr / 4);
     }
 
-    let refsPtr = 0;
-    try {
-      // Copy tetrahedra to WASM heap
-      m.HEAP32.set(tetrahedra, tetraPtr / 4);
-
-      // Handle refs if provided
-      if (refs) {
-        refsPtr = m._malloc(refs.byteLength);
-        if (refsPtr === 0) {
-          throw new Error("Failed to allocate memory for refs");
-        }
-        m.HEAP32.set(refs, refsPtr / 4);
-      }
-
-      const result = m._mmg3d_set_tetrahedra(handle, tetraPtr, refsPtr);
-      if (result !== 1) {
-        throw new Error("Failed to set tetrahedra");
-      }
-    } finally {
-      m._free(tetraPtr);
-      if (refsPtr !== 0) {
-        m._free(refsPtr);
-      }
+    const result = m._mmg3d_set_tetrahedra(
+      handle,
+      tetraPtr,
+      refs ? refsPtr : 0,
+    );
+    if (result !== 1) {
+      throw new Error("Failed to set tetrahedra");
     }
   },
 
@@ -578,37 +843,7 @@ export const MMG3D = {
    * @returns Int32Array of vertex indices [v0_0, v1_0, v2_0, v3_0, ...] (1-indexed)
    */
   getTetrahedra(handle: MeshHandle): Int32Array {
-    const m = getModule();
-
-    // Allocate space for output count
-    const countPtr = m._malloc(4);
-    if (countPtr === 0) {
-      throw new Error("Failed to allocate memory");
-    }
-
-    try {
-      const dataPtr = m._mmg3d_get_tetrahedra(handle, countPtr);
-      if (dataPtr === 0) {
-        // Check if there are simply no tetrahedra
-        const count = m.getValue(countPtr, "i32");
-        if (count === 0) {
-          return new Int32Array(0);
-        }
-        throw new Error("Failed to get tetrahedra");
-      }
-
-      try {
-        const count = m.getValue(countPtr, "i32");
-        // Copy data from WASM heap
-        const result = new Int32Array(count * 4);
-        result.set(m.HEAP32.subarray(dataPtr / 4, dataPtr / 4 + count * 4));
-        return result;
-      } finally {
-        m._mmg3d_free_array(dataPtr);
-      }
-    } finally {
-      m._free(countPtr);
-    }
+    return this.getTetrahedraView(handle).slice();
   },
 
   /**
@@ -658,35 +893,18 @@ export const MMG3D = {
 
     const m = getModule();
 
-    // Allocate and copy triangles to WASM heap
-    const triaPtr = m._malloc(triangles.byteLength);
-    if (triaPtr === 0) {
-      throw new Error("Failed to allocate memory for triangles");
+    const [triaPtr, refsPtr] = scratchMemory(m, [
+      triangles.byteLength,
+      refs ? refs.byteLength : 0,
+    ]);
+    m.HEAP32.set(triangles, triaPtr / 4);
+    if (refs) {
+      m.HEAP32.set(refs, refsPtr / 4);
     }
 
-    let refsPtr = 0;
-    try {
-      // Copy triangles to WASM heap
-      m.HEAP32.set(triangles, triaPtr / 4);
-
-      // Handle refs if provided
-      if (refs) {
-        refsPtr = m._malloc(refs.byteLength);
-        if (refsPtr === 0) {
-          throw new Error("Failed to allocate memory for refs");
-        }
-        m.HEAP32.set(refs, refsPtr / 4);
-      }
-
-      const result = m._mmg3d_set_triangles(handle, triaPtr, refsPtr);
-      if (result !== 1) {
-        throw new Error("Failed to set triangles");
-      }
-    } finally {
-      m._free(triaPtr);
-      if (refsPtr !== 0) {
-        m._free(refsPtr);
-      }
+    const result = m._mmg3d_set_triangles(handle, triaPtr, refs ? refsPtr : 0);
+    if (result !== 1) {
+      throw new Error("Failed to set triangles");
     }
   },
 
@@ -696,37 +914,7 @@ export const MMG3D = {
    * @returns Int32Array of vertex indices [v0_0, v1_0, v2_0, ...] (1-indexed)
    */
   getTriangles(handle: MeshHandle): Int32Array {
-    const m = getModule();
-
-    // Allocate space for output count
-    const countPtr = m._malloc(4);
-    if (countPtr === 0) {
-      throw new Error("Failed to allocate memory");
-    }
-
-    try {
-      const dataPtr = m._mmg3d_get_triangles(handle, countPtr);
-      if (dataPtr === 0) {
-        // Check if there are simply no triangles
-        const count = m.getValue(countPtr, "i32");
-        if (count === 0) {
-          return new Int32Array(0);
-        }
-        throw new Error("Failed to get triangles");
-      }
-
-      try {
-        const count = m.getValue(countPtr, "i32");
-        // Copy data from WASM heap
-        const result = new Int32Array(count * 3);
-        result.set(m.HEAP32.subarray(dataPtr / 4, dataPtr / 4 + count * 3));
-        return result;
-      } finally {
-        m._mmg3d_free_array(dataPtr);
-      }
-    } finally {
-      m._free(countPtr);
-    }
+    return this.getTrianglesView(handle).slice();
   },
 
   /**
@@ -787,26 +975,17 @@ export const MMG3D = {
   getSolSize(handle: MeshHandle): SolInfo {
     const m = getModule();
 
-    // Allocate space for 3 integers
-    const ptr = m._malloc(3 * 4);
-    if (ptr === 0) {
-      throw new Error("Failed to allocate memory for solution size");
+    const [ptr] = scratchMemory(m, [3 * 4]);
+    const result = m._mmg3d_get_sol_size(handle, ptr, ptr + 4, ptr + 8);
+    if (result !== 1) {
+      throw new Error("Failed to get solution size");
     }
 
-    try {
-      const result = m._mmg3d_get_sol_size(handle, ptr, ptr + 4, ptr + 8);
-      if (result !== 1) {
-        throw new Error("Failed to get solution size");
-      }
-
-      return {
-        typEntity: m.getValue(ptr, "i32"),
-        nEntities: m.getValue(ptr + 4, "i32"),
-        typSol: m.getValue(ptr + 8, "i32"),
-      };
-    } finally {
-      m._free(ptr);
-    }
+    return {
+      typEntity: m.getValue(ptr, "i32"),
+      nEntities: m.getValue(ptr + 4, "i32"),
+      typSol: m.getValue(ptr + 8, "i32"),
+    };
   },
 
   /**
@@ -819,19 +998,11 @@ export const MMG3D = {
   setScalarSols(handle: MeshHandle, values: Float64Array): void {
     const m = getModule();
 
-    const valuesPtr = m._malloc(values.byteLength);
-    if (valuesPtr === 0) {
-      throw new Error("Failed to allocate memory for solution values");
-    }
-
-    try {
-      m.HEAPF64.set(values, valuesPtr / 8);
-      const result = m._mmg3d_set_scalar_sols(handle, valuesPtr);
-      if (result !== 1) {
-        throw new Error("Failed to set scalar solution values");
-      }
-    } finally {
-      m._free(valuesPtr);
+    const [valuesPtr] = scratchMemory(m, [values.byteLength]);
+    m.HEAPF64.set(values, valuesPtr / 8);
+    const result = m._mmg3d_set_scalar_sols(handle, valuesPtr);
+    if (result !== 1) {
+      throw new Error("Failed to set scalar solution values");
     }
   },
 
@@ -844,30 +1015,15 @@ export const MMG3D = {
   getScalarSols(handle: MeshHandle): Float64Array {
     const m = getModule();
 
-    const countPtr = m._malloc(4);
-    if (countPtr === 0) {
-      throw new Error("Failed to allocate memory for count");
-    }
-
-    try {
-      const dataPtr = m._mmg3d_get_scalar_sols(handle, countPtr);
-      if (dataPtr === 0) {
-        throw new Error(
-          "Failed to get scalar solution values (wrong type or empty?)",
-        );
-      }
-
-      try {
-        const count = m.getValue(countPtr, "i32");
-        const result = new Float64Array(count);
-        result.set(m.HEAPF64.subarray(dataPtr / 8, dataPtr / 8 + count));
-        return result;
-      } finally {
-        m._mmg3d_free_array(dataPtr);
-      }
-    } finally {
-      m._free(countPtr);
+    const [countPtr, sizePtr] = scratchMemory(m, [4, 4]);
+    const dataPtr = m._mmg3d_view_sols(handle, countPtr, sizePtr);
+    const count = m.getValue(countPtr, "i32");
+    if (dataPtr === 0 || m.getValue(sizePtr, "i32") !== 1) {
+      throw new Error(
+        "Failed to get scalar solution values (wrong type or empty?)",
+      );
     }
+    return m.HEAPF64.slice(dataPtr / 8, dataPtr / 8 + count);
   },
 
   /**
@@ -880,19 +1036,11 @@ export const MMG3D = {
   setTensorSols(handle: MeshHandle, values: Float64Array): void {
     const m = getModule();
 
-    const valuesPtr = m._malloc(values.byteLength);
-    if (valuesPtr === 0) {
-      throw new Error("Failed to allocate memory for tensor values");
-    }
-
-    try {
-      m.HEAPF64.set(values, valuesPtr / 8);
-      const result = m._mmg3d_set_tensor_sols(handle, valuesPtr);
-      if (result !== 1) {
-        throw new Error("Failed to set tensor solution values");
-      }
-    } finally {
-      m._free(valuesPtr);
+    const [valuesPtr] = scratchMemory(m, [values.byteLength]);
+    m.HEAPF64.set(values, valuesPtr / 8);
+    const result = m._mmg3d_set_tensor_sols(handle, valuesPtr);
+    if (result !== 1) {
+      throw new Error("Failed to set tensor solution values");
     }
   },
 
@@ -905,33 +1053,202 @@ export const MMG3D = {
   getTensorSols(handle: MeshHandle): Float64Array {
     const m = getModule();
 
-    const countPtr = m._malloc(4);
-    if (countPtr === 0) {
-      throw new Error("Failed to allocate memory for count");
+    const [countPtr, sizePtr] = scratchMemory(m, [4, 4]);
+    const dataPtr = m._mmg3d_view_sols(handle, countPtr, sizePtr);
+    const count = m.getValue(countPtr, "i32");
+    if (dataPtr === 0 || m.getValue(sizePtr, "i32") !== 6) {
+      throw new Error(
+        "Failed to get tensor solution values (wrong type or empty?)",
+      );
     }
+    return m.HEAPF64.slice(dataPtr / 8, dataPtr / 8 + count * 6);
+  },
 
-    try {
-      const dataPtr = m._mmg3d_get_tensor_sols(handle, countPtr);
-      if (dataPtr === 0) {
-        throw new Error(
-          "Failed to get tensor solution values (wrong type or empty?)",
-        );
-      }
+  /**
+   * Evaluate packed local sizing constraints into the scalar metric.
+   * All constraints are evaluated natively in a single pass over the
+   * vertices, writing straight into the solution (which is replaced).
+   * Vertices outside every region get a fifth of the bounding box diagonal.
+   * @param handle - The mesh handle
+   * @param constraints - Packed constraints (see encodeSizingConstraints)
+   * @throws Error if a constraint is invalid or evaluation fails
+   */
+  applySizing(handle: MeshHandle, constraints: Float64Array): void {
+    if (constraints.length % SIZING_STRIDE !== 0) {
+      throw new Error(
+        `Packed constraints length must be a multiple of ${SIZING_STRIDE}`,
+      );
+    }
+    const m = getModule();
 
-      try {
-        const count = m.getValue(countPtr, "i32");
-        // 6 components per vertex for 3D tensor
-        const result = new Float64Array(count * 6);
-        result.set(m.HEAPF64.subarray(dataPtr / 8, dataPtr / 8 + count * 6));
-        return result;
-      } finally {
-        m._mmg3d_free_array(dataPtr);
-      }
-    } finally {
-      m._free(countPtr);
+    const [constraintsPtr] = scratchMemory(m, [constraints.byteLength]);
+    m.HEAPF64.set(constraints, constraintsPtr / 8);
+    const count = constraints.length / SIZING_STRIDE;
+    if (m._mmg3d_apply_sizing(handle, constraintsPtr, count) !== 1) {
+      throw new Error("Failed to apply sizing constraints");
     }
   },
 
+  /**
+   * Prepare a local remesh: tag as required every element with no vertex
+   * inside the packed regions, grown by margin, so the next remesh only
+   * reworks the elements around them. Undo with thaw once remeshed.
+   * @param handle - The mesh handle
+   * @param regions - Packed constraints (see encodeSizingConstraints)
+   * @param margin - Distance the regions are grown by (default: 0)
+   * @returns The number of frozen tetrahedra
+   * @throws Error if the mesh already has required entities, or on failure
+   */
+  freezeOutside(handle: MeshHandle, regions: Float64Array, margin = 0): number {
+    if (regions.length % SIZING_STRIDE !== 0) {
+      throw new Error(
+        `Packed constraints length must be a multiple of ${SIZING_STRIDE}`,
+      );
+    }
+    const m = getModule();
+
+    const [regionsPtr] = scratchMemory(m, [regions.byteLength]);
+    m.HEAPF64.set(regions, regionsPtr / 8);
+    const count = regions.length / SIZING_STRIDE;
+    const frozen = m._mmg3d_freeze_outside(handle, regionsPtr, count, margin);
+    if (frozen === -2) {
+      throw new Error(
+        "Local remeshing needs a mesh without required entities",
+      );
+    }
+    if (frozen < 0) {
+      throw new Error("Failed to freeze elements outside the local regions");
+    }
+    return frozen;
+  },
+
+  /**
+   * Clear the required tags of every entity, after a local remesh
+   * @param handle - The mesh handle
+   * @throws Error if the handle is invalid
+   */
+  thaw(handle: MeshHandle): void {
+    const m = getModule();
+    if (m._mmg3d_thaw(handle) !== 1) {
+      throw new Error("Failed to clear required tags");
+    }
+  },
+
+  /**
+   * Locate points in the mesh, finding the tetrahedron containing each one.
+   * The element hierarchy is built by the first query and reused until the
+   * mesh is modified.
+   * @param handle - The mesh handle
+   * @param points - Float64Array of point coordinates [x0, y0, z0, ...]
+   * @returns The tetrahedron of every point and its barycentric coordinates
+   * @throws Error if the lookup fails
+   */
+  locatePoints(handle: MeshHandle, points: Float64Array): PointLocation {
+    if (points.length % 3 !== 0) {
+      throw new Error("Point coordinates length must be a multiple of 3");
+    }
+    const m = getModule();
+    const n = points.length / 3;
+
+    const [pointsPtr, elementsPtr, baryPtr] = scratchMemory(m, [
+      points.byteLength,
+      n * 4,
+      n * 4 * 8,
+    ]);
+    m.HEAPF64.set(points, pointsPtr / 8);
+    const located = m._mmg3d_locate_points(
+      handle,
+      pointsPtr,
+      n,
+      elementsPtr,
+      baryPtr,
+    );
+    if (located < 0) {
+      throw new Error("Failed to locate points");
+    }
+    return {
+      elements: m.HEAP32.slice(elementsPtr / 4, elementsPtr / 4 + n),
+      barycentric: m.HEAPF64.slice(baryPtr / 8, baryPtr / 8 + n * 4),
+      located,
+    };
+  },
+
+  /**
+   * Interpolate the solution at arbitrary points, linearly in the tetrahedron
+   * containing each point. Points outside the mesh get NaN.
+   * @param handle - The mesh handle
+   * @param points - Float64Array of point coordinates [x0, y0, z0, ...]
+   * @returns Float64Array of the solution components at every point
+   * @throws Error if the mesh has no vertex solution
+   */
+  sampleSolution(handle: MeshHandle, points: Float64Array): Float64Array {
+    if (points.length % 3 !== 0) {
+      throw new Error("Point coordinates length must be a multiple of 3");
+    }
+    const { typSol } = this.getSolSize(handle);
+    const components =
+      typSol === SOL_TYPE.SCALAR ? 1 : typSol === SOL_TYPE.VECTOR ? 3 : 6;
+    const m = getModule();
+    const n = points.length / 3;
+
+    const [pointsPtr, outPtr] = scratchMemory(m, [
+      points.byteLength,
+      n * components * 8,
+    ]);
+    m.HEAPF64.set(points, pointsPtr / 8);
+    if (m._mmg3d_sample_sol(handle, pointsPtr, n, outPtr) < 0) {
+      throw new Error("Failed to sample solution");
+    }
+    return m.HEAPF64.slice(outPtr / 8, outPtr / 8 + n * components);
+  },
+
+  /**
+   * Interpolate user fields from the vertices of another mesh, typically the
+   * mesh this one was remeshed from, onto the vertices of this mesh.
+   * Vertices outside the source mesh take the values of its closest point.
+   * @param handle - The mesh handle receiving the fields
+   * @param source - The mesh handle the fields are defined on
+   * @param fields - Float64Array of stride values per source vertex
+   * @param stride - Number of interleaved values per vertex (default: 1)
+   * @returns Float64Array of stride values per vertex of handle
+   * @throws Error if the interpolation fails
+   */
+  interpolateFields(
+    handle: MeshHandle,
+    source: MeshHandle,
+    fields: Float64Array,
+    stride = 1,
+  ): Float64Array {
+    if (!Number.isInteger(stride) || stride <= 0) {
+      throw new Error(`Invalid field stride: ${stride}`);
+    }
+    const expected = this.getMeshSize(source).nVertices * stride;
+    if (fields.length !== expected) {
+      throw new Error(
+        `Expected ${expected} field values, got ${fields.length}`,
+      );
+    }
+    const nVertices = this.getMeshSize(handle).nVertices;
+    const m = getModule();
+
+    const [valuesPtr, outPtr] = scratchMemory(m, [
+      fields.byteLength,
+      nVertices * stride * 8,
+    ]);
+    m.HEAPF64.set(fields, valuesPtr / 8);
+    const result = m._mmg3d_interpolate_fields(
+      handle,
+      source,
+      valuesPtr,
+      stride,
+      outPtr,
+    );
+    if (result !== 1) {
+      throw new Error("Failed to interpolate fields");
+    }
+    return m.HEAPF64.slice(outPtr / 8, outPtr / 8 + nVertices * stride);
+  },
+
   /**
    * Run the MMG3D remeshing algorithm.
    * @param handle - The mesh handle
@@ -942,6 +1259,135 @@ export const MMG3D = {
     return m._mmg3d_remesh(handle);
   },
 
+  /**
+   * Run the MMG3D remeshing algorithm without blocking the caller.
+   *
+   * With the pthreads build the remesh runs on a pool thread sharing the
+   * module heap, so several handles can be remeshed concurrently; other builds
+   * run it synchronously. The handle must not be used until the promise
+   * settles.
+   * @param handle - The mesh handle
+   * @param onProgress - Called whenever the progress of the remesh changes
+   *   (enables progress tracking on the handle)
+   * @returns Return code (0 = success, 1 = low failure, 2 = strong failure,
+   *   -3 = aborted with abortRemesh())
+   * @throws Error if the remesh could not be started (invalid or busy handle)
+   */
+  async mmg3dlibAsync(
+    handle: MeshHandle,
+    onProgress?: (progress: RemeshProgress) => void,
+  ): Promise<number> {
+    const m = getModule();
+    if (onProgress) {
+      MMG3D.setProgressTracking(handle, true);
+    }
+    if (m._mmg3d_remesh_async(handle) !== 1) {
+      throw new Error(
+        "Failed to start MMG3D remeshing (invalid handle or remesh in progress)",
+      );
+    }
+
+    let status = m._mmg3d_remesh_status(handle);
+    let reported = -1;
+    const report = () => {
+      const progress = MMG3D.getProgress(handle);
+      if (progress.percent !== reported) {
+        reported = progress.percent;
+        onProgress?.(progress);
+      }
+    };
+    while (status === REMESH_RUNNING) {
+      if (onProgress) {
+        report();
+      }
+      await new Promise((resolve) => setTimeout(resolve, REMESH_POLL_MS));
+      status = m._mmg3d_remesh_status(handle);
+    }
+    if (onProgress) {
+      report();
+    }
+    return status;
+  },
+
+  /**
+   * Enable or disable progress tracking for the next remeshes of a handle.
+   *
+   * While tracking is enabled MMG3D's phases and the passes of its
+   * wavefronts update the progress record (see getProgress), and the remesh
+   * can be cancelled with abortRemesh().
+   * @param handle - The mesh handle
+   * @param enabled - Whether to track progress
+   * @throws Error if the handle is invalid
+   */
+  setProgressTracking(handle: MeshHandle, enabled: boolean): void {
+    const m = getModule();
+    const ptr = m._mmg3d_get_progress(handle);
+    if (ptr === 0) {
+      throw new Error("Invalid MMG3D handle");
+    }
+    Atomics.store(m.HEAP32, ptr / 4 + PROGRESS_ENABLED, enabled ? 1 : 0);
+  },
+
+  /**
+   * Get the progress of the current (or last) remesh of a handle.
+   *
+   * Only updated while progress tracking is enabled. The record is read from
+   * the heap, so with the pthreads build it can be polled while the remesh
+   * runs on another thread.
+   * @param handle - The mesh handle
+   * @returns Current phase, progress estimate and pass count
+   * @throws Error if the handle is invalid
+   */
+  getProgress(handle: MeshHandle): RemeshProgress {
+    const m = getModule();
+    const ptr = m._mmg3d_get_progress(handle);
+    if (ptr === 0) {
+      throw new Error("Invalid MMG3D handle");
+    }
+    const base = ptr / 4;
+    return {
+      phase: REMESH_PHASES[Atomics.load(m.HEAP32, base + PROGRESS_PHASE)],
+      percent: Atomics.load(m.HEAP32, base + PROGRESS_PERCENT),
+      iterations: Atomics.load(m.HEAP32, base + PROGRESS_ITERATIONS),
+    };
+  },
+
+  /**
+   * Get the statistics of the last remesh of a handle.
+   *
+   * Only recorded by the instrumentation build (MMG_WASM_STATS): other builds
+   * return undefined, as they do for an invalid handle.
+   * @param handle - The mesh handle
+   * @returns Phase timings and operation counts of MMG, or undefined
+   */
+  getStats(handle: MeshHandle): RemeshStats | undefined {
+    const m = getModule();
+    const [statsPtr] = scratchMemory(m, [STATS_BYTES]);
+    if (m._mmg3d_get_stats(handle, statsPtr) !== 1) {
+      return undefined;
+    }
+    return readRemeshStats(m, statsPtr);
+  },
+
+  /**
+   * Request cancellation of the running remesh of a handle.
+   *
+   * The remesh stops at the next phase or wavefront pass and returns
+   * MMG_RETURN_CODES.ABORTED, through MMG3D's own failure path: the handle
+   * keeps a valid, partially remeshed mesh. Requires progress tracking to
+   * have been enabled before the remesh started.
+   * @param handle - The mesh handle
+   * @throws Error if the handle is invalid
+   */
+  abortRemesh(handle: MeshHandle): void {
+    const m = getModule();
+    const ptr = m._mmg3d_get_progress(handle);
+    if (ptr === 0) {
+      throw new Error("Invalid MMG3D handle");
+    }
+    Atomics.store(m.HEAP32, ptr / 4 + PROGRESS_ABORT, 1);
+  },
+
   /**
    * Load a mesh from a file in the virtual filesystem.
    * Use FS.writeFile() to write mesh data to the virtual filesystem first.
@@ -952,18 +1398,81 @@ export const MMG3D = {
   loadMesh(handle: MeshHandle, filename: string): void {
     const m = getModule();
     const filenameLen = m.lengthBytesUTF8(filename) + 1;
-    const filenamePtr = m._malloc(filenameLen);
-    if (filenamePtr === 0) {
-      throw new Error("Failed to allocate memory for filename");
+    const [filenamePtr] = scratchMemory(m, [filenameLen]);
+    m.stringToUTF8(filename, filenamePtr, filenameLen);
+    const result = m._mmg3d_load_mesh(handle, filenamePtr);
+    if (result !== 1) {
+      throw new Error(`Failed to load mesh from ${filename}`);
+    }
+  },
+
+  /**
+   * Load a mesh from .mesh/.meshb file contents held in memory.
+   * The bytes are copied once into WASM memory and parsed there, without
+   * going through the virtual filesystem.
+   * @param handle - The mesh handle
+   * @param data - Contents of the mesh file
+   * @param format - File format (default: "mesh")
+   * @throws Error if loading fails
+   */
+  loadMeshFromBuffer(
+    handle: MeshHandle,
+    data: Uint8Array,
+    format: "mesh" | "meshb" = "mesh",
+  ): void {
+    const m = getModule();
+    const file = createMemFile(m, data.length);
+    try {
+      appendToMemFile(m, file, data);
+      MMG3D.loadMeshFromMemFile(handle, file, format);
+    } finally {
+      freeMemFile(m, file);
     }
+  },
+
+  /**
+   * Load a mesh from a stream of .mesh/.meshb file contents (e.g. a fetch
+   * body). Chunks are copied into WASM memory as they arrive, so the file is
+   * never held in full on the JS side.
+   * @param handle - The mesh handle
+   * @param stream - Byte stream of the mesh file
+   * @param format - File format (default: "mesh")
+   * @param sizeHint - Expected size in bytes (e.g. Content-Length), used to
+   *   preallocate the buffer
+   * @throws Error if reading the stream or loading fails
+   */
+  async loadMeshFromStream(
+    handle: MeshHandle,
+    stream: ReadableStream<Uint8Array>,
+    format: "mesh" | "meshb" = "mesh",
+    sizeHint = 0,
+  ): Promise<void> {
+    const m = getModule();
+    const file = createMemFile(m, sizeHint);
     try {
-      m.stringToUTF8(filename, filenamePtr, filenameLen);
-      const result = m._mmg3d_load_mesh(handle, filenamePtr);
-      if (result !== 1) {
-        throw new Error(`Failed to load mesh from ${filename}`);
-      }
+      await appendStreamToMemFile(m, file, stream.getReader());
+      MMG3D.loadMeshFromMemFile(handle, file, format);
     } finally {
-      m._free(filenamePtr);
+      freeMemFile(m, file);
+    }
+  },
+
+  /**
+   * Load a mesh from a memfile (see createMemFile).
+   * @param handle - The mesh handle
+   * @param file - Memfile holding the mesh file contents
+   * @param format - File format (default: "mesh")
+   * @throws Error if loading fails
+   */
+  loadMeshFromMemFile(
+    handle: MeshHandle,
+    file: number,
+    format: "mesh" | "meshb" = "mesh",
+  ): void {
+    const m = getModule();
+    const binary = format === "meshb" ? 1 : 0;
+    if (m._mmg3d_load_mesh_from_memfile(handle, file, binary) !== 1) {
+      throw new Error(`Failed to load MMG3D mesh from memory (${format})`);
     }
   },
 
@@ -977,18 +1486,37 @@ export const MMG3D = {
   saveMesh(handle: MeshHandle, filename: string): void {
     const m = getModule();
     const filenameLen = m.lengthBytesUTF8(filename) + 1;
-    const filenamePtr = m._malloc(filenameLen);
-    if (filenamePtr === 0) {
-      throw new Error("Failed to allocate memory for filename");
+    const [filenamePtr] = scratchMemory(m, [filenameLen]);
+    m.stringToUTF8(filename, filenamePtr, filenameLen);
+    const result = m._mmg3d_save_mesh(handle, filenamePtr);
+    if (result !== 1) {
+      throw new Error(`Failed to save mesh to ${filename}`);
     }
+  },
+
+  /**
+   * Save a mesh to .mesh/.meshb file contents in memory.
+   * The file is serialized straight into the WASM heap and copied out once,
+   * without going through the virtual filesystem.
+   * @param handle - The mesh handle
+   * @param format - File format (default: "mesh")
+   * @returns Contents of the mesh file
+   * @throws Error if saving fails
+   */
+  saveMeshToBuffer(
+    handle: MeshHandle,
+    format: "mesh" | "meshb" = "mesh",
+  ): Uint8Array {
+    const m = getModule();
+    const file = createMemFile(m);
     try {
-      m.stringToUTF8(filename, filenamePtr, filenameLen);
-      const result = m._mmg3d_save_mesh(handle, filenamePtr);
-      if (result !== 1) {
-        throw new Error(`Failed to save mesh to ${filename}`);
+      const binary = format === "meshb" ? 1 : 0;
+      if (m._mmg3d_save_mesh_to_memfile(handle, file, binary) !== 1) {
+        throw new Error(`Failed to save MMG3D mesh to memory (${format})`);
       }
+      return readMemFile(m, file);
     } finally {
-      m._free(filenamePtr);
+      freeMemFile(m, file);
     }
   },
 
@@ -1002,18 +1530,39 @@ export const MMG3D = {
   loadSol(handle: MeshHandle, filename: string): void {
     const m = getModule();
     const filenameLen = m.lengthBytesUTF8(filename) + 1;
-    const filenamePtr = m._malloc(filenameLen);
-    if (filenamePtr === 0) {
-      throw new Error("Failed to allocate memory for filename");
+    const [filenamePtr] = scratchMemory(m, [filenameLen]);
+    m.stringToUTF8(filename, filenamePtr, filenameLen);
+    const result = m._mmg3d_load_sol(handle, filenamePtr);
+    if (result !== 1) {
+      throw new Error(`Failed to load solution from ${filename}`);
     }
+  },
+
+  /**
+   * Load a solution from .sol/.solb file contents held in memory, without
+   * going through the virtual filesystem.
+   * @param handle - The mesh handle
+   * @param data - Contents of the solution file
+   * @param format - File format (default: "sol")
+   * @throws Error if loading fails
+   */
+  loadSolFromBuffer(
+    handle: MeshHandle,
+    data: Uint8Array,
+    format: "sol" | "solb" = "sol",
+  ): void {
+    const m = getModule();
+    const file = createMemFile(m, data.length);
     try {
-      m.stringToUTF8(filename, filenamePtr, filenameLen);
-      const result = m._mmg3d_load_sol(handle, filenamePtr);
-      if (result !== 1) {
-        throw new Error(`Failed to load solution from ${filename}`);
+      appendToMemFile(m, file, data);
+      const binary = format === "solb" ? 1 : 0;
+      if (m._mmg3d_load_sol_from_memfile(handle, file, binary) !== 1) {
+        throw new Error(
+          `Failed to load MMG3D solution from memory (${format})`,
+        );
       }
     } finally {
-      m._free(filenamePtr);
+      freeMemFile(m, file);
     }
   },
 
@@ -1027,18 +1576,36 @@ export const MMG3D = {
   saveSol(handle: MeshHandle, filename: string): void {
     const m = getModule();
     const filenameLen = m.lengthBytesUTF8(filename) + 1;
-    const filenamePtr = m._malloc(filenameLen);
-    if (filenamePtr === 0) {
-      throw new Error("Failed to allocate memory for filename");
+    const [filenamePtr] = scratchMemory(m, [filenameLen]);
+    m.stringToUTF8(filename, filenamePtr, filenameLen);
+    const result = m._mmg3d_save_sol(handle, filenamePtr);
+    if (result !== 1) {
+      throw new Error(`Failed to save solution to ${filename}`);
     }
+  },
+
+  /**
+   * Save the solution to .sol/.solb file contents in memory, without going
+   * through the virtual filesystem.
+   * @param handle - The mesh handle
+   * @param format - File format (default: "sol")
+   * @returns Contents of the solution file
+   * @throws Error if saving fails
+   */
+  saveSolToBuffer(
+    handle: MeshHandle,
+    format: "sol" | "solb" = "sol",
+  ): Uint8Array {
+    const m = getModule();
+    const file = createMemFile(m);
     try {
-      m.stringToUTF8(filename, filenamePtr, filenameLen);
-      const result = m._mmg3d_save_sol(handle, filenamePtr);
-      if (result !== 1) {
-        throw new Error(`Failed to save solution to ${filename}`);
+      const binary = format === "solb" ? 1 : 0;
+      if (m._mmg3d_save_sol_to_memfile(handle, file, binary) !== 1) {
+        throw new Error(`Failed to save MMG3D solution to memory (${format})`);
       }
+      return readMemFile(m, file);
     } finally {
-      m._free(filenamePtr);
+      freeMemFile(m, file);
     }
   },
 
@@ -1063,31 +1630,312 @@ export const MMG3D = {
   getTetrahedraQualities(handle: MeshHandle): Float64Array {
     const m = getModule();
 
-    const countPtr = m._malloc(4);
-    if (countPtr === 0) {
-      throw new Error("Failed to allocate memory");
+    const [countPtr] = scratchMemory(m, [4]);
+    const dataPtr = m._mmg3d_get_tetrahedra_qualities(handle, countPtr);
+    if (dataPtr === 0) {
+      const count = m.getValue(countPtr, "i32");
+      if (count === 0) {
+        return new Float64Array(0);
+      }
+      throw new Error("Failed to get tetrahedra qualities");
     }
 
     try {
-      const dataPtr = m._mmg3d_get_tetrahedra_qualities(handle, countPtr);
-      if (dataPtr === 0) {
-        const count = m.getValue(countPtr, "i32");
-        if (count === 0) {
-          return new Float64Array(0);
-        }
-        throw new Error("Failed to get tetrahedra qualities");
-      }
+      const count = m.getValue(countPtr, "i32");
+      const result = new Float64Array(count);
+      result.set(m.HEAPF64.subarray(dataPtr / 8, dataPtr / 8 + count));
+      return result;
+    } finally {
+      m._mmg3d_free_array(dataPtr);
+    }
+  },
+
+  /**
+   * Compute element quality statistics without copying per-element qualities
+   * out of WASM memory.
+   * @param handle - The mesh handle
+   * @param nbins - Number of uniform histogram bins over [0, 1] (default 10)
+   * @returns Min, max and mean quality, element count and histogram
+   */
+  getQualityStats(handle: MeshHandle, nbins = 10): QualityStats {
+    if (!Number.isInteger(nbins) || nbins < 0) {
+      throw new Error(`Invalid histogram bin count: ${nbins}`);
+    }
+
+    const m = getModule();
+
+    // QualityStats struct: 3 doubles + 2 ints (32 bytes)
+    const [statsPtr, histogramPtr] = scratchMemory(m, [32, nbins * 4]);
+    const result = m._mmg3d_get_quality_stats(
+      handle,
+      nbins,
+      statsPtr,
+      histogramPtr,
+    );
+    if (result !== 1) {
+      throw new Error("Failed to compute quality statistics");
+    }
+
+    return {
+      min: m.HEAPF64[statsPtr / 8],
+      max: m.HEAPF64[statsPtr / 8 + 1],
+      mean: m.HEAPF64[statsPtr / 8 + 2],
+      count: m.HEAP32[(statsPtr + 24) / 4],
+      histogram: m.HEAP32.slice(histogramPtr / 4, histogramPtr / 4 + nbins),
+    };
+  },
+
+  /**
+   * Get the modification generation of a mesh.
+   * The value changes whenever the mesh is set, loaded or remeshed, which
+   * invalidates views obtained from the get*View methods.
+   * @param handle - The mesh handle
+   * @returns A non-zero generation number
+   * @throws Error if the handle is invalid
+   */
+  getGeneration(handle: MeshHandle): number {
+    const m = getModule();
+    const generation = m._mmg3d_get_generation(handle) >>> 0;
+    if (generation === 0) {
+      throw new Error("Invalid MMG3D mesh handle");
+    }
+    return generation;
+  },
+
+  /**
+   * Get a zero-copy view of all vertex coordinates.
+   *
+   * The returned array aliases a buffer owned by the mesh handle inside the
+   * WASM heap, so no data is copied. It is only valid until the mesh is
+   * modified (see getGeneration), the handle is freed, or the heap grows
+   * (see isHeapViewValid); call again to obtain a fresh view. Copy it with
+   * `slice()` to keep the data.
+   * @param handle - The mesh handle
+   * @returns Float64Array view of vertex coordinates [x0, y0, z0, x1, y1, z1, ...]
+   */
+  getVerticesView(handle: MeshHandle): Float64Array {
+    const m = getModule();
+    const [countPtr] = scratchMemory(m, [4]);
+    const dataPtr = m._mmg3d_view_vertices(handle, countPtr);
+    const count = m.getValue(countPtr, "i32");
+    if (dataPtr === 0) {
+      return new Float64Array(0);
+    }
+    return m.HEAPF64.subarray(dataPtr / 8, dataPtr / 8 + count * 3);
+  },
+
+  /**
+   * Get a zero-copy view of all tetrahedra.
+   * Same validity rules as getVerticesView.
+   * @param handle - The mesh handle
+   * @returns Int32Array view of vertex indices (1-indexed), 4 per element
+   */
+  getTetrahedraView(handle: MeshHandle): Int32Array {
+    const m = getModule();
+    const [countPtr] = scratchMemory(m, [4]);
+    const dataPtr = m._mmg3d_view_tetrahedra(handle, countPtr);
+    const count = m.getValue(countPtr, "i32");
+    if (dataPtr === 0) {
+      return new Int32Array(0);
+    }
+    return m.HEAP32.subarray(dataPtr / 4, dataPtr / 4 + count * 4);
+  },
+
+  /**
+   * Get a zero-copy view of all boundary triangles.
+   * Same validity rules as getVerticesView.
+   * @param handle - The mesh handle
+   * @returns Int32Array view of vertex indices (1-indexed), 3 per element
+   */
+  getTrianglesView(handle: MeshHandle): Int32Array {
+    const m = getModule();
+    const [countPtr] = scratchMemory(m, [4]);
+    const dataPtr = m._mmg3d_view_triangles(handle, countPtr);
+    const count = m.getValue(countPtr, "i32");
+    if (dataPtr === 0) {
+      return new Int32Array(0);
+    }
+    return m.HEAP32.subarray(dataPtr / 4, dataPtr / 4 + count * 3);
+  },
+
+  /**
+   * Pack the mesh into the compact wire format (see decodePackedMesh):
+   * float32 or quantized positions, tetrahedra and boundary triangles with
+   * 0-based indices, in one buffer that can be transferred to another thread.
+   * @param handle - The mesh handle
+   * @param options - Quantization and boundary-only packing
+   * @returns Copy of the packed mesh
+   * @throws Error if packing fails
+   */
+  packMesh(handle: MeshHandle, options: PackOptions = {}): Uint8Array {
+    const m = getModule();
+    const [sizePtr] = scratchMemory(m, [4]);
+    const dataPtr = m._mmg3d_pack_mesh(handle, packFlags(options), sizePtr);
+    if (dataPtr === 0) {
+      throw new Error("Failed to pack mesh");
+    }
+    return m.HEAPU8.slice(dataPtr, dataPtr + m.getValue(sizePtr, "i32"));
+  },
+
+  /**
+   * Extract the display surface of the mesh natively: the faces of its
+   * tetrahedra that no other displayed tetrahedron shares, with the vertices
+   * they use, vertex normals and 0-based indices. Without a clipping plane
+   * this is the boundary of the mesh; with one, the boundary of the kept
+   * tetrahedra, which shows the cut.
+   * @param handle - The mesh handle
+   * @param clip - Optional clipping plane
+   * @returns Copies of the surface buffers
+   * @throws Error if extraction fails
+   */
+  extractSurface(handle: MeshHandle, clip?: SurfaceClip): SurfaceGeometry {
+    const m = getModule();
+    let planePtr = 0;
+    if (clip) {
+      [planePtr] = scratchMemory(m, [4 * 8]);
+      m.HEAPF64.set([...clip.normal, clip.offset], planePtr / 8);
+    }
+    const ptr = m._mmg3d_extract_surface(handle, planePtr);
+    if (ptr === 0) {
+      throw new Error("Failed to extract surface");
+    }
+
+    const nv = m.HEAP32[ptr / 4];
+    const nt = m.HEAP32[ptr / 4 + 1];
+    // Header (nv, nt), then positions, normals, indices and cells
+    const buffer = m.HEAPU8.buffer;
+    const positionsAt = ptr + 8;
+    const normalsAt = positionsAt + nv * 12;
+    const indicesAt = normalsAt + nv * 12;
+    const cellsAt = indicesAt + nt * 12;
+    return {
+      positions: new Float32Array(buffer, positionsAt, nv * 3).slice(),
+      normals: new Float32Array(buffer, normalsAt, nv * 3).slice(),
+      indices: new Uint32Array(buffer, indicesAt, nt * 3).slice(),
+      cells: new Int32Array(buffer, cellsAt, nt).slice(),
+    };
+  },
+
+  /**
+   * Split the tetrahedra into compact parts of balanced size for a parallel
+   * remesh, by recursive coordinate bisection. Pass 0 cuts along the
+   * longest axes and later passes along the next ones, so that they remesh
+   * the interfaces of the previous pass.
+   * @param handle - The mesh handle
+   * @param parts - Number of parts
+   * @param pass - Remeshing pass the parts are for (default: 0)
+   * @returns The 0-based part of every tetrahedron
+   * @throws Error if the mesh has required entities, or on failure
+   */
+  partition(handle: MeshHandle, parts: number, pass = 0): Int32Array {
+    const m = getModule();
+    const { ne } = MMG3D.getMeshSize(handle);
+
+    const [outPtr] = scratchMemory(m, [ne * 4]);
+    const result = m._mmg3d_partition(handle, parts, pass, outPtr);
+    if (result === -2) {
+      throw new Error(
+        "Partitioned remeshing needs a mesh without required entities",
+      );
+    }
+    if (result !== 1) {
+      throw new Error("Failed to partition mesh");
+    }
+    return m.HEAP32.slice(outPtr / 4, outPtr / 4 + ne);
+  },
 
-      try {
-        const count = m.getValue(countPtr, "i32");
-        const result = new Float64Array(count);
-        result.set(m.HEAPF64.subarray(dataPtr / 8, dataPtr / 8 + count));
-        return result;
-      } finally {
-        m._mmg3d_free_array(dataPtr);
+  /**
+   * Extract one part of a partition as a new mesh, whose faces shared with
+   * other parts are required triangles (with reference
+   * SUBDOMAIN_INTERFACE_REF) so that remeshing it keeps them as they are
+   * @param handle - The mesh handle
+   * @param parts - Part of every tetrahedron (see partition)
+   * @param part - Part to extract
+   * @returns Handle of the new mesh, to free once done
+   * @throws Error if extraction fails
+   */
+  extractSubdomain(
+    handle: MeshHandle,
+    parts: Int32Array,
+    part: number,
+  ): MeshHandle {
+    const m = getModule();
+
+    const [partsPtr] = scratchMemory(m, [parts.byteLength]);
+    m.HEAP32.set(parts, partsPtr / 4);
+    const subdomain = m._mmg3d_extract_subdomain(handle, partsPtr, part);
+    if (subdomain < 0) {
+      throw new Error("Failed to extract subdomain");
+    }
+    return subdomain as MeshHandle;
+  },
+
+  /**
+   * Weld remeshed parts back into one new mesh: vertices that coincide up
+   * to rounding are merged and the interface triangles dropped
+   * @param handles - Handles of the parts
+   * @returns Handle of the new mesh, to free once done
+   * @throws Error if merging fails
+   */
+  mergeSubdomains(handles: MeshHandle[]): MeshHandle {
+    const m = getModule();
+
+    const [handlesPtr] = scratchMemory(m, [handles.length * 4]);
+    m.HEAP32.set(handles, handlesPtr / 4);
+    const merged = m._mmg3d_merge_subdomains(handlesPtr, handles.length);
+    if (merged < 0) {
+      throw new Error("Failed to merge subdomains");
+    }
+    return merged as MeshHandle;
+  },
+
+  /**
+   * Remesh many meshes in one native call, with the same parameters.
+   * Every mesh is staged in one buffer, remeshed in a fresh MMG structure
+   * and written into one result buffer, copied back at once.
+   * @param meshes - Vertices, tetrahedra, boundary triangles, their
+   *   references and an optional metric (1 or 6 values per vertex) of
+   *   each mesh
+   * @param parameters - MMG parameters set on every mesh (see
+   *   optionParameters)
+   * @returns One result per mesh, in order
+   * @throws Error if an array has the wrong length or the batch fails
+   */
+  remeshBatch(
+    meshes: MeshImportData[],
+    parameters: OptionParameter[] = [],
+  ): BatchRemeshResult[] {
+    const m = getModule();
+    const handle = m._mmg3d_init();
+    if (handle < 0) {
+      throw new Error("Failed to initialize MMG3D mesh (max handles reached?)");
+    }
+    try {
+      const [meshesPtr, parametersPtr, sizePtr] = packMeshImports(
+        m,
+        meshes,
+        IMPORT_LAYOUT,
+        [parameters.length * BATCH_PARAMETER_BYTES, 4],
+      );
+      writeBatchParameters(m, parametersPtr, parameters);
+      const dataPtr = m._mmg3d_remesh_batch(
+        handle,
+        meshesPtr,
+        meshes.length,
+        parametersPtr,
+        parameters.length,
+        sizePtr,
+      );
+      if (dataPtr === 0) {
+        throw new Error("Failed to remesh batch");
       }
+      const bytes = m.HEAPU8.slice(
+        dataPtr,
+        dataPtr + m.getValue(sizePtr, "i32"),
+      );
+      return decodeBatch(bytes, IMPORT_LAYOUT, meshes);
     } finally {
-      m._free(countPtr);
+      m._mmg3d_free(handle);
     }
   },
 };
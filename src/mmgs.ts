@@ -8,8 +8,40 @@
  * Unlike MMG3D, it has no tetrahedra. Unlike MMG2D, it has 3D vertices.
  */
 
-import type { EmscriptenFS } from "./fs";
-import type { WasmModule } from "./memory";
+import {
+  BATCH_PARAMETER_BYTES,
+  decodeBatch,
+  writeBatchParameters,
+} from "./batch";
+import type { EmscriptenFS, OPFSModule } from "./fs";
+import { type InitOptions, loadModule } from "./loader";
+import {
+  type MemFileModule,
+  appendStreamToMemFile,
+  appendToMemFile,
+  createMemFile,
+  freeMemFile,
+  readMemFile,
+} from "./memfile";
+import {
+  type MeshImportData,
+  type MeshImportLayout,
+  packMeshImport,
+  packMeshImports,
+} from "./import";
+import {
+  type HandleMemoryUsage,
+  type HeapReserveModule,
+  type NativeMemoryModule,
+  releaseScratchMemory,
+  scratchMemory,
+} from "./memory";
+import type { PointerSizeModule } from "./memory64";
+import type { OptionParameter } from "./options";
+import { type PackOptions, packFlags } from "./packed";
+import type { BatchRemeshResult, RemeshStats } from "./result";
+import { SIZING_STRIDE } from "./sizing";
+import { STATS_BYTES, readRemeshStats } from "./stats";
 
 /**
  * Integer parameters for MMGS (matching MMGS_Param enum in libmmgs.h)
@@ -70,6 +102,7 @@ export const MMG_RETURN_CODES_S = {
   SUCCESS: 0,
   LOWFAILURE: 1, // The mesh is not suitable for remeshing
   STRONGFAILURE: 2, // The mesh is not valid
+  ABORTED: -3, // The remesh was cancelled with abortRemesh()
 } as const;
 
 /**
@@ -97,12 +130,64 @@ export interface SolInfoS {
   typSol: number;
 }
 
+/** Element quality statistics computed in a single pass */
+export interface QualityStatsS {
+  /** Minimum element quality (0 for an empty mesh) */
+  min: number;
+  /** Maximum element quality (0 for an empty mesh) */
+  max: number;
+  /** Mean element quality (0 for an empty mesh) */
+  mean: number;
+  /** Number of triangles */
+  count: number;
+  /** Element counts per uniform quality bin over [0, 1] */
+  histogram: Int32Array;
+}
+
+/** Result of locating points in a mesh */
+export interface PointLocationS {
+  /** 1-indexed triangle closest to each point */
+  elements: Int32Array;
+  /** 3 barycentric coordinates per point, in the triangle vertex order */
+  barycentric: Float64Array;
+  /** Number of points located */
+  located: number;
+}
+
+/** Phase of a remesh, as reported by MMG */
+export type RemeshPhaseS =
+  | "idle"
+  | "analysis"
+  | "meshing"
+  | "finalize"
+  | "done";
+
+/** Progress of a remesh on a handle with progress tracking enabled */
+export interface RemeshProgressS {
+  /** Current phase */
+  phase: RemeshPhaseS;
+  /** Progress estimate (0-100) */
+  percent: number;
+  /** Passes of the meshing phase, always 0: MMGS only reports phases */
+  iterations: number;
+}
+
 /** Internal module interface (raw Emscripten functions) */
-export interface MMGSModule extends WasmModule {
+export interface MMGSModule
+  extends MemFileModule,
+    HeapReserveModule,
+    NativeMemoryModule,
+    OPFSModule,
+    PointerSizeModule {
   _mmgs_init(): number;
   _mmgs_free(handle: number): number;
+  _mmgs_clone(handle: number): number;
   _mmgs_get_available_handles(): number;
   _mmgs_get_max_handles(): number;
+  _mmgs_set_max_handles(maxHandles: number): number;
+  _mmgs_set_arena_mode(enabled: number): void;
+  _mmgs_get_memory_usage(handle: number, outPtr: number): number;
+  _mmgs_import_mesh(handle: number, descriptorPtr: number): number;
   _mmgs_set_mesh_size(
     handle: number,
     np: number,
@@ -166,14 +251,94 @@ export interface MMGSModule extends WasmModule {
   _mmgs_get_scalar_sols(handle: number, outCountPtr: number): number;
   _mmgs_set_tensor_sols(handle: number, valuesPtr: number): number;
   _mmgs_get_tensor_sols(handle: number, outCountPtr: number): number;
+  _mmgs_apply_sizing(
+    handle: number,
+    constraintsPtr: number,
+    count: number,
+  ): number;
+  _mmgs_freeze_outside(
+    handle: number,
+    regionsPtr: number,
+    count: number,
+    margin: number,
+  ): number;
+  _mmgs_thaw(handle: number): number;
+  _mmgs_locate_points(
+    handle: number,
+    pointsPtr: number,
+    n: number,
+    outElementsPtr: number,
+    outBaryPtr: number,
+  ): number;
+  _mmgs_sample_sol(
+    handle: number,
+    pointsPtr: number,
+    n: number,
+    outPtr: number,
+  ): number;
+  _mmgs_interpolate_fields(
+    handle: number,
+    source: number,
+    valuesPtr: number,
+    stride: number,
+    outPtr: number,
+  ): number;
   _mmgs_remesh(handle: number): number;
+  _mmgs_remesh_async(handle: number): number;
+  _mmgs_remesh_status(handle: number): number;
+  _mmgs_get_progress(handle: number): number;
+  _mmgs_get_stats(handle: number, outPtr: number): number;
   _mmgs_free_array(ptr: number): void;
   _mmgs_load_mesh(handle: number, filenamePtr: number): number;
+  _mmgs_load_mesh_from_memfile(
+    handle: number,
+    file: number,
+    binary: number,
+  ): number;
   _mmgs_save_mesh(handle: number, filenamePtr: number): number;
+  _mmgs_save_mesh_to_memfile(
+    handle: number,
+    file: number,
+    binary: number,
+  ): number;
   _mmgs_load_sol(handle: number, filenamePtr: number): number;
+  _mmgs_load_sol_from_memfile(
+    handle: number,
+    file: number,
+    binary: number,
+  ): number;
   _mmgs_save_sol(handle: number, filenamePtr: number): number;
+  _mmgs_save_sol_to_memfile(
+    handle: number,
+    file: number,
+    binary: number,
+  ): number;
   _mmgs_get_triangle_quality(handle: number, k: number): number;
   _mmgs_get_triangles_qualities(handle: number, outCountPtr: number): number;
+  _mmgs_get_quality_stats(
+    handle: number,
+    nbins: number,
+    statsPtr: number,
+    histogramPtr: number,
+  ): number;
+  _mmgs_get_generation(handle: number): number;
+  _mmgs_view_vertices(handle: number, outCountPtr: number): number;
+  _mmgs_view_triangles(handle: number, outCountPtr: number): number;
+  _mmgs_view_edges(handle: number, outCountPtr: number): number;
+  _mmgs_view_sols(
+    handle: number,
+    outCountPtr: number,
+    outSizePtr: number,
+  ): number;
+  _mmgs_pack_mesh(handle: number, flags: number, outSizePtr: number): number;
+  _mmgs_remesh_batch(
+    handle: number,
+    meshesPtr: number,
+    count: number,
+    parametersPtr: number,
+    nparameters: number,
+    outSizePtr: number,
+  ): number;
   getValue(ptr: number, type: string): number;
   setValue(ptr: number, value: number, type: string): void;
   lengthBytesUTF8(str: string): number;
@@ -181,22 +346,58 @@ export interface MMGSModule extends WasmModule {
   FS: EmscriptenFS;
 }
 
+// Entity sizes for importMesh
+const IMPORT_LAYOUT: MeshImportLayout = {
+  dim: 3,
+  cellSize: 3,
+  boundarySize: 2,
+  tensorSize: 6,
+};
+
+// Status reported by the C wrapper while an asynchronous remesh is running
+const REMESH_RUNNING = -2;
+// Polling interval for asynchronous remesh completion (ms)
+const REMESH_POLL_MS = 4;
+// Int32 field offsets of the C progress record (MmgwasmProgress)
+const PROGRESS_ENABLED = 0;
+const PROGRESS_ABORT = 1;
+const PROGRESS_PHASE = 2;
+const PROGRESS_PERCENT = 3;
+const PROGRESS_ITERATIONS = 4;
+const REMESH_PHASES: RemeshPhaseS[] = [
+  "idle",
+  "analysis",
+  "meshing",
+  "finalize",
+  "done",
+];
+
 let module: MMGSModule | null = null;
 
 /**
  * Initialize the MMGS WASM module.
  * Must be called before using any MMGS functions.
+ *
+ * @param options - Optional settings, e.g. the maximum number of handles
  */
-export async function initMMGS(): Promise<void> {
-  if (module) {
-    return; // Already initialized
+export async function initMMGS(options: InitOptions = {}): Promise<void> {
+  if (!module) {
+    // Instance of the Emscripten-generated module shared with the other
+    // mesh types, or of this type's own module (see setSplitModules). It
+    // doesn't have TypeScript declarations, so we cast through unknown to
+    // the properly typed interface
+    module = (await loadModule(
+      "mmgs",
+      options.heapBytes,
+    )) as unknown as MMGSModule;
   }
 
-  // Dynamic import of the Emscripten-generated module
-  // The Emscripten-generated module doesn't have TypeScript declarations,
-  // so we cast through unknown to the properly typed interface
-  const createModule = (await import("../build/dist/mmg.js")).default;
-  module = (await createModule()) as unknown as MMGSModule;
+  if (options.maxHandles !== undefined) {
+    MMGS.setMaxHandles(options.maxHandles);
+  }
+  if (options.arena !== undefined) {
+    MMGS.setArenaMode(options.arena);
+  }
 }
 
 /**
@@ -254,6 +455,28 @@ export const MMGS = {
     if (result !== 1) {
       throw new Error("Failed to free MMGS mesh (invalid handle?)");
     }
+    // The scratch memory of the transfers goes with the last mesh
+    if (m._mmgs_get_available_handles() === m._mmgs_get_max_handles()) {
+      releaseScratchMemory(m);
+    }
+  },
+
+  /**
+   * Duplicate a mesh, including refs, tags and the solution/metric field.
+   * The copy is made entirely inside WASM memory.
+   * @param handle - The mesh handle to clone
+   * @returns A new, independent mesh handle
+   * @throws Error if the handle is invalid or no handle slot is available
+   */
+  clone(handle: MeshHandleS): MeshHandleS {
+    const m = getModule();
+    const cloned = m._mmgs_clone(handle);
+    if (cloned < 0) {
+      throw new Error(
+        "Failed to clone MMGS mesh (invalid handle or max handles reached?)",
+      );
+    }
+    return cloned as MeshHandleS;
   },
 
   /**
@@ -267,13 +490,60 @@ export const MMGS = {
 
   /**
    * Get the maximum number of concurrent mesh handles supported.
-   * @returns Maximum number of handles (currently 64)
+   * @returns Maximum number of handles (1024 unless changed)
    */
   getMaxHandles(): number {
     const m = getModule();
     return m._mmgs_get_max_handles();
   },
 
+  /**
+   * Set the maximum number of concurrent mesh handles.
+   * Handle slots are allocated on demand, so a large maximum costs nothing
+   * until it is used.
+   * @param maxHandles - New maximum (at most 65536)
+   * @throws Error if maxHandles is out of range or below the number of handle
+   *   slots already in use
+   */
+  setMaxHandles(maxHandles: number): void {
+    const m = getModule();
+    if (m._mmgs_set_max_handles(maxHandles) !== 1) {
+      throw new Error(`Failed to set MMGS max handles to ${maxHandles}`);
+    }
+  },
+
+  /**
+   * Allocate MMG's memory for handles created from now on from a per-handle
+   * arena, returned to the heap in one step when the handle is freed. This
+   * keeps long-lived modules from fragmenting their heap across many jobs.
+   * Existing handles keep their mode.
+   * @param enabled - true for arena mode, false for the regular heap
+   */
+  setArenaMode(enabled: boolean): void {
+    const m = getModule();
+    m._mmgs_set_arena_mode(enabled ? 1 : 0);
+  },
+
+  /**
+   * Get the memory held for a mesh handle: what MMG allocated for it, its
+   * memory limit and the size of its arena.
+   * @param handle - The mesh handle
+   * @returns Memory usage in bytes
+   * @throws Error if the handle is invalid
+   */
+  getMemoryUsage(handle: MeshHandleS): HandleMemoryUsage {
+    const m = getModule();
+    const [ptr] = scratchMemory(m, [3 * 8]);
+    if (m._mmgs_get_memory_usage(handle, ptr) !== 1) {
+      throw new Error("Failed to get memory usage");
+    }
+    return {
+      used: m.HEAPF64[ptr / 8],
+      max: m.HEAPF64[ptr / 8 + 1],
+      arena: m.HEAPF64[ptr / 8 + 2],
+    };
+  },
+
   /**
    * Set the mesh size (allocate memory for mesh entities).
    * @param handle - The mesh handle
@@ -303,31 +573,39 @@ export const MMGS = {
   getMeshSize(handle: MeshHandleS): MeshSizeS {
     const m = getModule();
 
-    // Allocate space for 3 integers
-    const ptr = m._malloc(3 * 4);
-    if (ptr === 0) {
-      throw new Error("Failed to allocate memory");
-    }
+    const [ptr] = scratchMemory(m, [3 * 4]);
+    const result = m._mmgs_get_mesh_size(
+      handle,
+      ptr, // np
+      ptr + 4, // nt
+      ptr + 8, // na
+    );
 
-    try {
-      const result = m._mmgs_get_mesh_size(
-        handle,
-        ptr, // np
-        ptr + 4, // nt
-        ptr + 8, // na
-      );
+    if (result !== 1) {
+      throw new Error("Failed to get mesh size");
+    }
 
-      if (result !== 1) {
-        throw new Error("Failed to get mesh size");
-      }
+    return {
+      nVertices: m.getValue(ptr, "i32"),
+      nTriangles: m.getValue(ptr + 4, "i32"),
+      nEdges: m.getValue(ptr + 8, "i32"),
+    };
+  },
 
-      return {
-        nVertices: m.getValue(ptr, "i32"),
-        nTriangles: m.getValue(ptr + 4, "i32"),
-        nEdges: m.getValue(ptr + 8, "i32"),
-      };
-    } finally {
-      m._free(ptr);
+  /**
+   * Size and fill a mesh and its metric in one call.
+   * All arrays are copied into a single staging buffer and set natively at
+   * once, instead of one allocation, copy and call per array.
+   * @param handle - The mesh handle
+   * @param data - Vertices, triangles, boundary edges, their references and an optional
+   *   metric (1 or 6 values per vertex)
+   * @throws Error if an array has the wrong length or the import fails
+   */
+  importMesh(handle: MeshHandleS, data: MeshImportData): void {
+    const m = getModule();
+    const ptr = packMeshImport(m, data, IMPORT_LAYOUT);
+    if (m._mmgs_import_mesh(handle, ptr) !== 1) {
+      throw new Error("Failed to import mesh");
     }
   },
 
@@ -380,35 +658,22 @@ export const MMGS = {
 
     const m = getModule();
 
-    // Allocate and copy vertices to WASM heap
-    const verticesPtr = m._malloc(vertices.byteLength);
-    if (verticesPtr === 0) {
-      throw new Error("Failed to allocate memory for vertices");
+    const [verticesPtr, refsPtr] = scratchMemory(m, [
+      vertices.byteLength,
+      refs ? refs.byteLength : 0,
+    ]);
+    m.HEAPF64.set(vertices, verticesPtr / 8);
+    if (refs) {
+      m.HEAP32.set(refs, refsPtr / 4);
     }
 
-    let refsPtr = 0;
-    try {
-      // Copy vertices to WASM heap
-      m.HEAPF64.set(vertices, verticesPtr / 8);
-
-      // Handle refs if provided
-      if (refs) {
-        refsPtr = m._malloc(refs.byteLength);
-        if (refsPtr === 0) {
-          throw new Error("Failed to allocate memory for refs");
-        }
-        m.HEAP32.set(refs, refsPtr / 4);
-      }
-
-      const result = m._mmgs_set_vertices(handle, verticesPtr, refsPtr);
-      if (result !== 1) {
-        throw new Error("Failed to set vertices");
-      }
-    } finally {
-      m._free(verticesPtr);
-      if (refsPtr !== 0) {
-        m._free(refsPtr);
-      }
+    const result = m._mmgs_set_vertices(
+      handle,
+      verticesPtr,
+      refs ? refsPtr : 0,
+    );
+    if (result !== 1) {
+      throw new Error("Failed to set vertices");
     }
   },
 
@@ -418,37 +683,9 @@ export const MMGS = {
    * @returns Float64Array of vertex coordinates [x0, y0, z0, x1, y1, z1, ...]
    */
   getVertices(handle: MeshHandleS): Float64Array {
-    const m = getModule();
-
-    // Allocate space for output count
-    const countPtr = m._malloc(4);
-    if (countPtr === 0) {
-      throw new Error("Failed to allocate memory");
-    }
-
-    try {
-      const dataPtr = m._mmgs_get_vertices(handle, countPtr);
-      if (dataPtr === 0) {
-        // Check if there are simply no vertices
-        const count = m.getValue(countPtr, "i32");
-        if (count === 0) {
-          return new Float64Array(0);
-        }
-        throw new Error("Failed to get vertices");
-      }
-
-      try {
-        const count = m.getValue(countPtr, "i32");
-        // Copy data from WASM heap (3D: 3 coords per vertex)
-        const result = new Float64Array(count * 3);
-        result.set(m.HEAPF64.subarray(dataPtr / 8, dataPtr / 8 + count * 3));
-        return result;
-      } finally {
-        m._mmgs_free_array(dataPtr);
-      }
-    } finally {
-      m._free(countPtr);
-    }
+    // Copied out of the packed view buffer, which the handle keeps and
+    // only repacks after the mesh changes
+    return this.getVerticesView(handle).slice();
   },
 
   /**
@@ -498,35 +735,18 @@ export const MMGS = {
 
     const m = getModule();
 
-    // Allocate and copy triangles to WASM heap
-    const triaPtr = m._malloc(triangles.byteLength);
-    if (triaPtr === 0) {
-      throw new Error("Failed to allocate memory for triangles");
+    const [triaPtr, refsPtr] = scratchMemory(m, [
+      triangles.byteLength,
+      refs ? refs.byteLength : 0,
+    ]);
+    m.HEAP32.set(triangles, triaPtr / 4);
+    if (refs) {
+      m.HEAP32.set(refs, refsPtr / 4);
     }
 
-    let refsPtr = 0;
-    try {
-      // Copy triangles to WASM heap
-      m.HEAP32.set(triangles, triaPtr / 4);
-
-      // Handle refs if provided
-      if (refs) {
-        refsPtr = m._malloc(refs.byteLength);
-        if (refsPtr === 0) {
-          throw new Error("Failed to allocate memory for refs");
-        }
-        m.HEAP32.set(refs, refsPtr / 4);
-      }
-
-      const result = m._mmgs_set_triangles(handle, triaPtr, refsPtr);
-      if (result !== 1) {
-        throw new Error("Failed to set triangles");
-      }
-    } finally {
-      m._free(triaPtr);
-      if (refsPtr !== 0) {
-        m._free(refsPtr);
-      }
+    const result = m._mmgs_set_triangles(handle, triaPtr, refs ? refsPtr : 0);
+    if (result !== 1) {
+      throw new Error("Failed to set triangles");
     }
   },
 
@@ -536,37 +756,7 @@ export const MMGS = {
    * @returns Int32Array of vertex indices [v0_0, v1_0, v2_0, ...] (1-indexed)
    */
   getTriangles(handle: MeshHandleS): Int32Array {
-    const m = getModule();
-
-    // Allocate space for output count
-    const countPtr = m._malloc(4);
-    if (countPtr === 0) {
-      throw new Error("Failed to allocate memory");
-    }
-
-    try {
-      const dataPtr = m._mmgs_get_triangles(handle, countPtr);
-      if (dataPtr === 0) {
-        // Check if there are simply no triangles
-        const count = m.getValue(countPtr, "i32");
-        if (count === 0) {
-          return new Int32Array(0);
-        }
-        throw new Error("Failed to get triangles");
-      }
-
-      try {
-        const count = m.getValue(countPtr, "i32");
-        // Copy data from WASM heap
-        const result = new Int32Array(count * 3);
-        result.set(m.HEAP32.subarray(dataPtr / 4, dataPtr / 4 + count * 3));
-        return result;
-      } finally {
-        m._mmgs_free_array(dataPtr);
-      }
-    } finally {
-      m._free(countPtr);
-    }
+    return this.getTrianglesView(handle).slice();
   },
 
   /**
@@ -611,35 +801,18 @@ export const MMGS = {
 
     const m = getModule();
 
-    // Allocate and copy edges to WASM heap
-    const edgesPtr = m._malloc(edges.byteLength);
-    if (edgesPtr === 0) {
-      throw new Error("Failed to allocate memory for edges");
+    const [edgesPtr, refsPtr] = scratchMemory(m, [
+      edges.byteLength,
+      refs ? refs.byteLength : 0,
+    ]);
+    m.HEAP32.set(edges, edgesPtr / 4);
+    if (refs) {
+      m.HEAP32.set(refs, refsPtr / 4);
     }
 
-    let refsPtr = 0;
-    try {
-      // Copy edges to WASM heap
-      m.HEAP32.set(edges, edgesPtr / 4);
-
-      // Handle refs if provided
-      if (refs) {
-        refsPtr = m._malloc(refs.byteLength);
-        if (refsPtr === 0) {
-          throw new Error("Failed to allocate memory for refs");
-        }
-        m.HEAP32.set(refs, refsPtr / 4);
-      }
-
-      const result = m._mmgs_set_edges(handle, edgesPtr, refsPtr);
-      if (result !== 1) {
-        throw new Error("Failed to set edges");
-      }
-    } finally {
-      m._free(edgesPtr);
-      if (refsPtr !== 0) {
-        m._free(refsPtr);
-      }
+    const result = m._mmgs_set_edges(handle, edgesPtr, refs ? refsPtr : 0);
+    if (result !== 1) {
+      throw new Error("Failed to set edges");
     }
   },
 
@@ -649,37 +822,7 @@ export const MMGS = {
    * @returns Int32Array of vertex indices [v0_0, v1_0, ...] (1-indexed)
    */
   getEdges(handle: MeshHandleS): Int32Array {
-    const m = getModule();
-
-    // Allocate space for output count
-    const countPtr = m._malloc(4);
-    if (countPtr === 0) {
-      throw new Error("Failed to allocate memory");
-    }
-
-    try {
-      const dataPtr = m._mmgs_get_edges(handle, countPtr);
-      if (dataPtr === 0) {
-        // Check if there are simply no edges
-        const count = m.getValue(countPtr, "i32");
-        if (count === 0) {
-          return new Int32Array(0);
-        }
-        throw new Error("Failed to get edges");
-      }
-
-      try {
-        const count = m.getValue(countPtr, "i32");
-        // Copy data from WASM heap (2 vertices per edge)
-        const result = new Int32Array(count * 2);
-        result.set(m.HEAP32.subarray(dataPtr / 4, dataPtr / 4 + count * 2));
-        return result;
-      } finally {
-        m._mmgs_free_array(dataPtr);
-      }
-    } finally {
-      m._free(countPtr);
-    }
+    return this.getEdgesView(handle).slice();
   },
 
   /**
@@ -740,26 +883,17 @@ export const MMGS = {
   getSolSize(handle: MeshHandleS): SolInfoS {
     const m = getModule();
 
-    // Allocate space for 3 integers
-    const ptr = m._malloc(3 * 4);
-    if (ptr === 0) {
-      throw new Error("Failed to allocate memory for solution size");
+    const [ptr] = scratchMemory(m, [3 * 4]);
+    const result = m._mmgs_get_sol_size(handle, ptr, ptr + 4, ptr + 8);
+    if (result !== 1) {
+      throw new Error("Failed to get solution size");
     }
 
-    try {
-      const result = m._mmgs_get_sol_size(handle, ptr, ptr + 4, ptr + 8);
-      if (result !== 1) {
-        throw new Error("Failed to get solution size");
-      }
-
-      return {
-        typEntity: m.getValue(ptr, "i32"),
-        nEntities: m.getValue(ptr + 4, "i32"),
-        typSol: m.getValue(ptr + 8, "i32"),
-      };
-    } finally {
-      m._free(ptr);
-    }
+    return {
+      typEntity: m.getValue(ptr, "i32"),
+      nEntities: m.getValue(ptr + 4, "i32"),
+      typSol: m.getValue(ptr + 8, "i32"),
+    };
   },
 
   /**
@@ -772,19 +906,11 @@ export const MMGS = {
   setScalarSols(handle: MeshHandleS, values: Float64Array): void {
     const m = getModule();
 
-    const valuesPtr = m._malloc(values.byteLength);
-    if (valuesPtr === 0) {
-      throw new Error("Failed to allocate memory for solution values");
-    }
-
-    try {
-      m.HEAPF64.set(values, valuesPtr / 8);
-      const result = m._mmgs_set_scalar_sols(handle, valuesPtr);
-      if (result !== 1) {
-        throw new Error("Failed to set scalar solution values");
-      }
-    } finally {
-      m._free(valuesPtr);
+    const [valuesPtr] = scratchMemory(m, [values.byteLength]);
+    m.HEAPF64.set(values, valuesPtr / 8);
+    const result = m._mmgs_set_scalar_sols(handle, valuesPtr);
+    if (result !== 1) {
+      throw new Error("Failed to set scalar solution values");
     }
   },
 
@@ -797,30 +923,15 @@ export const MMGS = {
   getScalarSols(handle: MeshHandleS): Float64Array {
     const m = getModule();
 
-    const countPtr = m._malloc(4);
-    if (countPtr === 0) {
-      throw new Error("Failed to allocate memory for count");
-    }
-
-    try {
-      const dataPtr = m._mmgs_get_scalar_sols(handle, countPtr);
-      if (dataPtr === 0) {
-        throw new Error(
-          "Failed to get scalar solution values (wrong type or empty?)",
-        );
-      }
-
-      try {
-        const count = m.getValue(countPtr, "i32");
-        const result = new Float64Array(count);
-        result.set(m.HEAPF64.subarray(dataPtr / 8, dataPtr / 8 + count));
-        return result;
-      } finally {
-        m._mmgs_free_array(dataPtr);
-      }
-    } finally {
-      m._free(countPtr);
+    const [countPtr, sizePtr] = scratchMemory(m, [4, 4]);
+    const dataPtr = m._mmgs_view_sols(handle, countPtr, sizePtr);
+    const count = m.getValue(countPtr, "i32");
+    if (dataPtr === 0 || m.getValue(sizePtr, "i32") !== 1) {
+      throw new Error(
+        "Failed to get scalar solution values (wrong type or empty?)",
+      );
     }
+    return m.HEAPF64.slice(dataPtr / 8, dataPtr / 8 + count);
   },
 
   /**
@@ -833,19 +944,11 @@ export const MMGS = {
   setTensorSols(handle: MeshHandleS, values: Float64Array): void {
     const m = getModule();
 
-    const valuesPtr = m._malloc(values.byteLength);
-    if (valuesPtr === 0) {
-      throw new Error("Failed to allocate memory for tensor values");
-    }
-
-    try {
-      m.HEAPF64.set(values, valuesPtr / 8);
-      const result = m._mmgs_set_tensor_sols(handle, valuesPtr);
-      if (result !== 1) {
-        throw new Error("Failed to set tensor solution values");
-      }
-    } finally {
-      m._free(valuesPtr);
+    const [valuesPtr] = scratchMemory(m, [values.byteLength]);
+    m.HEAPF64.set(values, valuesPtr / 8);
+    const result = m._mmgs_set_tensor_sols(handle, valuesPtr);
+    if (result !== 1) {
+      throw new Error("Failed to set tensor solution values");
     }
   },
 
@@ -858,33 +961,207 @@ export const MMGS = {
   getTensorSols(handle: MeshHandleS): Float64Array {
     const m = getModule();
 
-    const countPtr = m._malloc(4);
-    if (countPtr === 0) {
-      throw new Error("Failed to allocate memory for count");
+    const [countPtr, sizePtr] = scratchMemory(m, [4, 4]);
+    const dataPtr = m._mmgs_view_sols(handle, countPtr, sizePtr);
+    const count = m.getValue(countPtr, "i32");
+    if (dataPtr === 0 || m.getValue(sizePtr, "i32") !== 6) {
+      throw new Error(
+        "Failed to get tensor solution values (wrong type or empty?)",
+      );
     }
+    return m.HEAPF64.slice(dataPtr / 8, dataPtr / 8 + count * 6);
+  },
 
-    try {
-      const dataPtr = m._mmgs_get_tensor_sols(handle, countPtr);
-      if (dataPtr === 0) {
-        throw new Error(
-          "Failed to get tensor solution values (wrong type or empty?)",
-        );
-      }
+  /**
+   * Evaluate packed local sizing constraints into the scalar metric.
+   * All constraints are evaluated natively in a single pass over the
+   * vertices, writing straight into the solution (which is replaced).
+   * Vertices outside every region get a fifth of the bounding box diagonal.
+   * @param handle - The mesh handle
+   * @param constraints - Packed constraints (see encodeSizingConstraints)
+   * @throws Error if a constraint is invalid or evaluation fails
+   */
+  applySizing(handle: MeshHandleS, constraints: Float64Array): void {
+    if (constraints.length % SIZING_STRIDE !== 0) {
+      throw new Error(
+        `Packed constraints length must be a multiple of ${SIZING_STRIDE}`,
+      );
+    }
+    const m = getModule();
 
-      try {
-        const count = m.getValue(countPtr, "i32");
-        // 6 components per vertex for 3D surface tensor
-        const result = new Float64Array(count * 6);
-        result.set(m.HEAPF64.subarray(dataPtr / 8, dataPtr / 8 + count * 6));
-        return result;
-      } finally {
-        m._mmgs_free_array(dataPtr);
-      }
-    } finally {
-      m._free(countPtr);
+    const [constraintsPtr] = scratchMemory(m, [constraints.byteLength]);
+    m.HEAPF64.set(constraints, constraintsPtr / 8);
+    const count = constraints.length / SIZING_STRIDE;
+    if (m._mmgs_apply_sizing(handle, constraintsPtr, count) !== 1) {
+      throw new Error("Failed to apply sizing constraints");
+    }
+  },
+
+  /**
+   * Prepare a local remesh: tag as required every element with no vertex
+   * inside the packed regions, grown by margin, so the next remesh only
+   * reworks the elements around them. Undo with thaw once remeshed.
+   * @param handle - The mesh handle
+   * @param regions - Packed constraints (see encodeSizingConstraints)
+   * @param margin - Distance the regions are grown by (default: 0)
+   * @returns The number of frozen triangles
+   * @throws Error if the mesh already has required entities, or on failure
+   */
+  freezeOutside(
+    handle: MeshHandleS,
+    regions: Float64Array,
+    margin = 0,
+  ): number {
+    if (regions.length % SIZING_STRIDE !== 0) {
+      throw new Error(
+        `Packed constraints length must be a multiple of ${SIZING_STRIDE}`,
+      );
+    }
+    const m = getModule();
+
+    const [regionsPtr] = scratchMemory(m, [regions.byteLength]);
+    m.HEAPF64.set(regions, regionsPtr / 8);
+    const count = regions.length / SIZING_STRIDE;
+    const frozen = m._mmgs_freeze_outside(handle, regionsPtr, count, margin);
+    if (frozen === -2) {
+      throw new Error(
+        "Local remeshing needs a mesh without required entities",
+      );
+    }
+    if (frozen < 0) {
+      throw new Error("Failed to freeze elements outside the local regions");
+    }
+    return frozen;
+  },
+
+  /**
+   * Clear the required tags of every entity, after a local remesh
+   * @param handle - The mesh handle
+   * @throws Error if the handle is invalid
+   */
+  thaw(handle: MeshHandleS): void {
+    const m = getModule();
+    if (m._mmgs_thaw(handle) !== 1) {
+      throw new Error("Failed to clear required tags");
     }
   },
 
+  /**
+   * Locate points on the surface by projecting each onto its closest
+   * triangle. The triangle hierarchy is built by the first query and reused
+   * until the mesh is modified.
+   * @param handle - The mesh handle
+   * @param points - Float64Array of point coordinates [x0, y0, z0, ...]
+   * @returns The closest triangle of every point and the barycentric
+   *   coordinates of the projection
+   * @throws Error if the lookup fails
+   */
+  locatePoints(handle: MeshHandleS, points: Float64Array): PointLocationS {
+    if (points.length % 3 !== 0) {
+      throw new Error("Point coordinates length must be a multiple of 3");
+    }
+    const m = getModule();
+    const n = points.length / 3;
+
+    const [pointsPtr, elementsPtr, baryPtr] = scratchMemory(m, [
+      points.byteLength,
+      n * 4,
+      n * 3 * 8,
+    ]);
+    m.HEAPF64.set(points, pointsPtr / 8);
+    const located = m._mmgs_locate_points(
+      handle,
+      pointsPtr,
+      n,
+      elementsPtr,
+      baryPtr,
+    );
+    if (located < 0) {
+      throw new Error("Failed to locate points");
+    }
+    return {
+      elements: m.HEAP32.slice(elementsPtr / 4, elementsPtr / 4 + n),
+      barycentric: m.HEAPF64.slice(baryPtr / 8, baryPtr / 8 + n * 3),
+      located,
+    };
+  },
+
+  /**
+   * Interpolate the solution at arbitrary points, linearly in the triangle
+   * closest to each point.
+   * @param handle - The mesh handle
+   * @param points - Float64Array of point coordinates [x0, y0, z0, ...]
+   * @returns Float64Array of the solution components at every point
+   * @throws Error if the mesh has no vertex solution
+   */
+  sampleSolution(handle: MeshHandleS, points: Float64Array): Float64Array {
+    if (points.length % 3 !== 0) {
+      throw new Error("Point coordinates length must be a multiple of 3");
+    }
+    const { typSol } = this.getSolSize(handle);
+    const components =
+      typSol === SOL_TYPE_S.SCALAR ? 1 : typSol === SOL_TYPE_S.VECTOR ? 3 : 6;
+    const m = getModule();
+    const n = points.length / 3;
+
+    const [pointsPtr, outPtr] = scratchMemory(m, [
+      points.byteLength,
+      n * components * 8,
+    ]);
+    m.HEAPF64.set(points, pointsPtr / 8);
+    if (m._mmgs_sample_sol(handle, pointsPtr, n, outPtr) < 0) {
+      throw new Error("Failed to sample solution");
+    }
+    return m.HEAPF64.slice(outPtr / 8, outPtr / 8 + n * components);
+  },
+
+  /**
+   * Interpolate user fields from the vertices of another mesh, typically the
+   * mesh this one was remeshed from, onto the vertices of this mesh.
+   * Vertices outside the source mesh take the values of its closest point.
+   * @param handle - The mesh handle receiving the fields
+   * @param source - The mesh handle the fields are defined on
+   * @param fields - Float64Array of stride values per source vertex
+   * @param stride - Number of interleaved values per vertex (default: 1)
+   * @returns Float64Array of stride values per vertex of handle
+   * @throws Error if the interpolation fails
+   */
+  interpolateFields(
+    handle: MeshHandleS,
+    source: MeshHandleS,
+    fields: Float64Array,
+    stride = 1,
+  ): Float64Array {
+    if (!Number.isInteger(stride) || stride <= 0) {
+      throw new Error(`Invalid field stride: ${stride}`);
+    }
+    const expected = this.getMeshSize(source).nVertices * stride;
+    if (fields.length !== expected) {
+      throw new Error(
+        `Expected ${expected} field values, got ${fields.length}`,
+      );
+    }
+    const nVertices = this.getMeshSize(handle).nVertices;
+    const m = getModule();
+
+    const [valuesPtr, outPtr] = scratchMemory(m, [
+      fields.byteLength,
+      nVertices * stride * 8,
+    ]);
+    m.HEAPF64.set(fields, valuesPtr / 8);
+    const result = m._mmgs_interpolate_fields(
+      handle,
+      source,
+      valuesPtr,
+      stride,
+      outPtr,
+    );
+    if (result !== 1) {
+      throw new Error("Failed to interpolate fields");
+    }
+    return m.HEAPF64.slice(outPtr / 8, outPtr / 8 + nVertices * stride);
+  },
+
   /**
    * Run the MMGS remeshing algorithm.
    * @param handle - The mesh handle
@@ -895,6 +1172,134 @@ export const MMGS = {
     return m._mmgs_remesh(handle);
   },
 
+  /**
+   * Run the MMGS remeshing algorithm without blocking the caller.
+   *
+   * With the pthreads build the remesh runs on a pool thread sharing the
+   * module heap, so several handles can be remeshed concurrently; other builds
+   * run it synchronously. The handle must not be used until the promise
+   * settles.
+   * @param handle - The mesh handle
+   * @param onProgress - Called whenever the progress of the remesh changes
+   *   (enables progress tracking on the handle)
+   * @returns Return code (0 = success, 1 = low failure, 2 = strong failure,
+   *   -3 = aborted with abortRemesh())
+   * @throws Error if the remesh could not be started (invalid or busy handle)
+   */
+  async mmgslibAsync(
+    handle: MeshHandleS,
+    onProgress?: (progress: RemeshProgressS) => void,
+  ): Promise<number> {
+    const m = getModule();
+    if (onProgress) {
+      MMGS.setProgressTracking(handle, true);
+    }
+    if (m._mmgs_remesh_async(handle) !== 1) {
+      throw new Error(
+        "Failed to start MMGS remeshing (invalid handle or remesh in progress)",
+      );
+    }
+
+    let status = m._mmgs_remesh_status(handle);
+    let reported = -1;
+    const report = () => {
+      const progress = MMGS.getProgress(handle);
+      if (progress.percent !== reported) {
+        reported = progress.percent;
+        onProgress?.(progress);
+      }
+    };
+    while (status === REMESH_RUNNING) {
+      if (onProgress) {
+        report();
+      }
+      await new Promise((resolve) => setTimeout(resolve, REMESH_POLL_MS));
+      status = m._mmgs_remesh_status(handle);
+    }
+    if (onProgress) {
+      report();
+    }
+    return status;
+  },
+
+  /**
+   * Enable or disable progress tracking for the next remeshes of a handle.
+   *
+   * While tracking is enabled MMGS's phases update the progress record (see
+   * getProgress), and the remesh can be cancelled with abortRemesh().
+   * @param handle - The mesh handle
+   * @param enabled - Whether to track progress
+   * @throws Error if the handle is invalid
+   */
+  setProgressTracking(handle: MeshHandleS, enabled: boolean): void {
+    const m = getModule();
+    const ptr = m._mmgs_get_progress(handle);
+    if (ptr === 0) {
+      throw new Error("Invalid MMGS handle");
+    }
+    Atomics.store(m.HEAP32, ptr / 4 + PROGRESS_ENABLED, enabled ? 1 : 0);
+  },
+
+  /**
+   * Get the progress of the current (or last) remesh of a handle.
+   *
+   * Only updated while progress tracking is enabled. The record is read from
+   * the heap, so with the pthreads build it can be polled while the remesh
+   * runs on another thread.
+   * @param handle - The mesh handle
+   * @returns Current phase, progress estimate and pass count
+   * @throws Error if the handle is invalid
+   */
+  getProgress(handle: MeshHandleS): RemeshProgressS {
+    const m = getModule();
+    const ptr = m._mmgs_get_progress(handle);
+    if (ptr === 0) {
+      throw new Error("Invalid MMGS handle");
+    }
+    const base = ptr / 4;
+    return {
+      phase: REMESH_PHASES[Atomics.load(m.HEAP32, base + PROGRESS_PHASE)],
+      percent: Atomics.load(m.HEAP32, base + PROGRESS_PERCENT),
+      iterations: Atomics.load(m.HEAP32, base + PROGRESS_ITERATIONS),
+    };
+  },
+
+  /**
+   * Get the statistics of the last remesh of a handle.
+   *
+   * Only recorded by the instrumentation build (MMG_WASM_STATS): other builds
+   * return undefined, as they do for an invalid handle.
+   * @param handle - The mesh handle
+   * @returns Phase timings and operation counts of MMG, or undefined
+   */
+  getStats(handle: MeshHandleS): RemeshStats | undefined {
+    const m = getModule();
+    const [statsPtr] = scratchMemory(m, [STATS_BYTES]);
+    if (m._mmgs_get_stats(handle, statsPtr) !== 1) {
+      return undefined;
+    }
+    return readRemeshStats(m, statsPtr);
+  },
+
+  /**
+   * Request cancellation of the running remesh of a handle.
+   *
+   * The remesh stops at the next phase boundary and returns
+   * MMG_RETURN_CODES_S.ABORTED, through MMGS's own failure path: the handle
+   * keeps a valid, partially remeshed mesh. Requires progress tracking to
+   * have been enabled before the remesh started.
+   * @param handle - The mesh handle
+   * @throws Error if the handle is invalid
+   */
+  abortRemesh(handle: MeshHandleS): void {
+    const m = getModule();
+    const ptr = m._mmgs_get_progress(handle);
+    if (ptr === 0) {
+      throw new Error("Invalid MMGS handle");
+    }
+    Atomics.store(m.HEAP32, ptr / 4 + PROGRESS_ABORT, 1);
+  },
+
   /**
    * Load a mesh from a file in the virtual filesystem.
    * Use FS.writeFile() to write mesh data to the virtual filesystem first.
@@ -905,18 +1310,81 @@ export const MMGS = {
   loadMesh(handle: MeshHandleS, filename: string): void {
     const m = getModule();
     const filenameLen = m.lengthBytesUTF8(filename) + 1;
-    const filenamePtr = m._malloc(filenameLen);
-    if (filenamePtr === 0) {
-      throw new Error("Failed to allocate memory for filename");
+    const [filenamePtr] = scratchMemory(m, [filenameLen]);
+    m.stringToUTF8(filename, filenamePtr, filenameLen);
+    const result = m._mmgs_load_mesh(handle, filenamePtr);
+    if (result !== 1) {
+      throw new Error(`Failed to load mesh from ${filename}`);
     }
+  },
+
+  /**
+   * Load a mesh from .mesh/.meshb file contents held in memory.
+   * The bytes are copied once into WASM memory and parsed there, without
+   * going through the virtual filesystem.
+   * @param handle - The mesh handle
+   * @param data - Contents of the mesh file
+   * @param format - File format (default: "mesh")
+   * @throws Error if loading fails
+   */
+  loadMeshFromBuffer(
+    handle: MeshHandleS,
+    data: Uint8Array,
+    format: "mesh" | "meshb" = "mesh",
+  ): void {
+    const m = getModule();
+    const file = createMemFile(m, data.length);
     try {
-      m.stringToUTF8(filename, filenamePtr, filenameLen);
-      const result = m._mmgs_load_mesh(handle, filenamePtr);
-      if (result !== 1) {
-        throw new Error(`Failed to load mesh from ${filename}`);
-      }
+      appendToMemFile(m, file, data);
+      MMGS.loadMeshFromMemFile(handle, file, format);
     } finally {
-      m._free(filenamePtr);
+      freeMemFile(m, file);
+    }
+  },
+
+  /**
+   * Load a mesh from a stream of .mesh/.meshb file contents (e.g. a fetch
+   * body). Chunks are copied into WASM memory as they arrive, so the file is
+   * never held in full on the JS side.
+   * @param handle - The mesh handle
+   * @param stream - Byte stream of the mesh file
+   * @param format - File format (default: "mesh")
+   * @param sizeHint - Expected size in bytes (e.g. Content-Length), used to
+   *   preallocate the buffer
+   * @throws Error if reading the stream or loading fails
+   */
+  async loadMeshFromStream(
+    handle: MeshHandleS,
+    stream: ReadableStream<Uint8Array>,
+    format: "mesh" | "meshb" = "mesh",
+    sizeHint = 0,
+  ): Promise<void> {
+    const m = getModule();
+    const file = createMemFile(m, sizeHint);
+    try {
+      await appendStreamToMemFile(m, file, stream.getReader());
+      MMGS.loadMeshFromMemFile(handle, file, format);
+    } finally {
+      freeMemFile(m, file);
+    }
+  },
+
+  /**
+   * Load a mesh from a memfile (see createMemFile).
+   * @param handle - The mesh handle
+   * @param file - Memfile holding the mesh file contents
+   * @param format - File format (default: "mesh")
+   * @throws Error if loading fails
+   */
+  loadMeshFromMemFile(
+    handle: MeshHandleS,
+    file: number,
+    format: "mesh" | "meshb" = "mesh",
+  ): void {
+    const m = getModule();
+    const binary = format === "meshb" ? 1 : 0;
+    if (m._mmgs_load_mesh_from_memfile(handle, file, binary) !== 1) {
+      throw new Error(`Failed to load MMGS mesh from memory (${format})`);
     }
   },
 
@@ -930,18 +1398,37 @@ export const MMGS = {
   saveMesh(handle: MeshHandleS, filename: string): void {
     const m = getModule();
     const filenameLen = m.lengthBytesUTF8(filename) + 1;
-    const filenamePtr = m._malloc(filenameLen);
-    if (filenamePtr === 0) {
-      throw new Error("Failed to allocate memory for filename");
+    const [filenamePtr] = scratchMemory(m, [filenameLen]);
+    m.stringToUTF8(filename, filenamePtr, filenameLen);
+    const result = m._mmgs_save_mesh(handle, filenamePtr);
+    if (result !== 1) {
+      throw new Error(`Failed to save mesh to ${filename}`);
     }
+  },
+
+  /**
+   * Save a mesh to .mesh/.meshb file contents in memory.
+   * The file is serialized straight into the WASM heap and copied out once,
+   * without going through the virtual filesystem.
+   * @param handle - The mesh handle
+   * @param format - File format (default: "mesh")
+   * @returns Contents of the mesh file
+   * @throws Error if saving fails
+   */
+  saveMeshToBuffer(
+    handle: MeshHandleS,
+    format: "mesh" | "meshb" = "mesh",
+  ): Uint8Array {
+    const m = getModule();
+    const file = createMemFile(m);
     try {
-      m.stringToUTF8(filename, filenamePtr, filenameLen);
-      const result = m._mmgs_save_mesh(handle, filenamePtr);
-      if (result !== 1) {
-        throw new Error(`Failed to save mesh to ${filename}`);
+      const binary = format === "meshb" ? 1 : 0;
+      if (m._mmgs_save_mesh_to_memfile(handle, file, binary) !== 1) {
+        throw new Error(`Failed to save MMGS mesh to memory (${format})`);
       }
+      return readMemFile(m, file);
     } finally {
-      m._free(filenamePtr);
+      freeMemFile(m, file);
     }
   },
 
@@ -955,18 +1442,37 @@ export const MMGS = {
   loadSol(handle: MeshHandleS, filename: string): void {
     const m = getModule();
     const filenameLen = m.lengthBytesUTF8(filename) + 1;
-    const filenamePtr = m._malloc(filenameLen);
-    if (filenamePtr === 0) {
-      throw new Error("Failed to allocate memory for filename");
+    const [filenamePtr] = scratchMemory(m, [filenameLen]);
+    m.stringToUTF8(filename, filenamePtr, filenameLen);
+    const result = m._mmgs_load_sol(handle, filenamePtr);
+    if (result !== 1) {
+      throw new Error(`Failed to load solution from ${filename}`);
     }
+  },
+
+  /**
+   * Load a solution from .sol/.solb file contents held in memory, without
+   * going through the virtual filesystem.
+   * @param handle - The mesh handle
+   * @param data - Contents of the solution file
+   * @param format - File format (default: "sol")
+   * @throws Error if loading fails
+   */
+  loadSolFromBuffer(
+    handle: MeshHandleS,
+    data: Uint8Array,
+    format: "sol" | "solb" = "sol",
+  ): void {
+    const m = getModule();
+    const file = createMemFile(m, data.length);
     try {
-      m.stringToUTF8(filename, filenamePtr, filenameLen);
-      const result = m._mmgs_load_sol(handle, filenamePtr);
-      if (result !== 1) {
-        throw new Error(`Failed to load solution from ${filename}`);
+      appendToMemFile(m, file, data);
+      const binary = format === "solb" ? 1 : 0;
+      if (m._mmgs_load_sol_from_memfile(handle, file, binary) !== 1) {
+        throw new Error(`Failed to load MMGS solution from memory (${format})`);
       }
     } finally {
-      m._free(filenamePtr);
+      freeMemFile(m, file);
     }
   },
 
@@ -980,18 +1486,36 @@ export const MMGS = {
   saveSol(handle: MeshHandleS, filename: string): void {
     const m = getModule();
     const filenameLen = m.lengthBytesUTF8(filename) + 1;
-    const filenamePtr = m._malloc(filenameLen);
-    if (filenamePtr === 0) {
-      throw new Error("Failed to allocate memory for filename");
+    const [filenamePtr] = scratchMemory(m, [filenameLen]);
+    m.stringToUTF8(filename, filenamePtr, filenameLen);
+    const result = m._mmgs_save_sol(handle, filenamePtr);
+    if (result !== 1) {
+      throw new Error(`Failed to save solution to ${filename}`);
     }
+  },
+
+  /**
+   * Save the solution to .sol/.solb file contents in memory, without going
+   * through the virtual filesystem.
+   * @param handle - The mesh handle
+   * @param format - File format (default: "sol")
+   * @returns Contents of the solution file
+   * @throws Error if saving fails
+   */
+  saveSolToBuffer(
+    handle: MeshHandleS,
+    format: "sol" | "solb" = "sol",
+  ): Uint8Array {
+    const m = getModule();
+    const file = createMemFile(m);
     try {
-      m.stringToUTF8(filename, filenamePtr, filenameLen);
-      const result = m._mmgs_save_sol(handle, filenamePtr);
-      if (result !== 1) {
-        throw new Error(`Failed to save solution to ${filename}`);
+      const binary = format === "solb" ? 1 : 0;
+      if (m._mmgs_save_sol_to_memfile(handle, file, binary) !== 1) {
+        throw new Error(`Failed to save MMGS solution to memory (${format})`);
       }
+      return readMemFile(m, file);
     } finally {
-      m._free(filenamePtr);
+      freeMemFile(m, file);
     }
   },
 
@@ -1016,31 +1540,200 @@ export const MMGS = {
   getTrianglesQualities(handle: MeshHandleS): Float64Array {
     const m = getModule();
 
-    const countPtr = m._malloc(4);
-    if (countPtr === 0) {
-      throw new Error("Failed to allocate memory");
+    const [countPtr] = scratchMemory(m, [4]);
+    const dataPtr = m._mmgs_get_triangles_qualities(handle, countPtr);
+    if (dataPtr === 0) {
+      const count = m.getValue(countPtr, "i32");
+      if (count === 0) {
+        return new Float64Array(0);
+      }
+      throw new Error("Failed to get triangles qualities");
     }
 
     try {
-      const dataPtr = m._mmgs_get_triangles_qualities(handle, countPtr);
-      if (dataPtr === 0) {
-        const count = m.getValue(countPtr, "i32");
-        if (count === 0) {
-          return new Float64Array(0);
-        }
-        throw new Error("Failed to get triangles qualities");
-      }
+      const count = m.getValue(countPtr, "i32");
+      const result = new Float64Array(count);
+      result.set(m.HEAPF64.subarray(dataPtr / 8, dataPtr / 8 + count));
+      return result;
+    } finally {
+      m._mmgs_free_array(dataPtr);
+    }
+  },
+
+  /**
+   * Compute element quality statistics without copying per-element qualities
+   * out of WASM memory.
+   * @param handle - The mesh handle
+   * @param nbins - Number of uniform histogram bins over [0, 1] (default 10)
+   * @returns Min, max and mean quality, element count and histogram
+   */
+  getQualityStats(handle: MeshHandleS, nbins = 10): QualityStatsS {
+    if (!Number.isInteger(nbins) || nbins < 0) {
+      throw new Error(`Invalid histogram bin count: ${nbins}`);
+    }
 
-      try {
-        const count = m.getValue(countPtr, "i32");
-        const result = new Float64Array(count);
-        result.set(m.HEAPF64.subarray(dataPtr / 8, dataPtr / 8 + count));
-        return result;
-      } finally {
-        m._mmgs_free_array(dataPtr);
+    const m = getModule();
+
+    // QualityStats struct: 3 doubles + 2 ints (32 bytes)
+    const [statsPtr, histogramPtr] = scratchMemory(m, [32, nbins * 4]);
+    const result = m._mmgs_get_quality_stats(
+      handle,
+      nbins,
+      statsPtr,
+      histogramPtr,
+    );
+    if (result !== 1) {
+      throw new Error("Failed to compute quality statistics");
+    }
+
+    return {
+      min: m.HEAPF64[statsPtr / 8],
+      max: m.HEAPF64[statsPtr / 8 + 1],
+      mean: m.HEAPF64[statsPtr / 8 + 2],
+      count: m.HEAP32[(statsPtr + 24) / 4],
+      histogram: m.HEAP32.slice(histogramPtr / 4, histogramPtr / 4 + nbins),
+    };
+  },
+
+  /**
+   * Get the modification generation of a mesh.
+   * The value changes whenever the mesh is set, loaded or remeshed, which
+   * invalidates views obtained from the get*View methods.
+   * @param handle - The mesh handle
+   * @returns A non-zero generation number
+   * @throws Error if the handle is invalid
+   */
+  getGeneration(handle: MeshHandleS): number {
+    const m = getModule();
+    const generation = m._mmgs_get_generation(handle) >>> 0;
+    if (generation === 0) {
+      throw new Error("Invalid MMGS mesh handle");
+    }
+    return generation;
+  },
+
+  /**
+   * Get a zero-copy view of all vertex coordinates.
+   *
+   * The returned array aliases a buffer owned by the mesh handle inside the
+   * WASM heap, so no data is copied. It is only valid until the mesh is
+   * modified (see getGeneration), the handle is freed, or the heap grows
+   * (see isHeapViewValid); call again to obtain a fresh view. Copy it with
+   * `slice()` to keep the data.
+   * @param handle - The mesh handle
+   * @returns Float64Array view of vertex coordinates [x0, y0, z0, x1, y1, z1, ...]
+   */
+  getVerticesView(handle: MeshHandleS): Float64Array {
+    const m = getModule();
+    const [countPtr] = scratchMemory(m, [4]);
+    const dataPtr = m._mmgs_view_vertices(handle, countPtr);
+    const count = m.getValue(countPtr, "i32");
+    if (dataPtr === 0) {
+      return new Float64Array(0);
+    }
+    return m.HEAPF64.subarray(dataPtr / 8, dataPtr / 8 + count * 3);
+  },
+
+  /**
+   * Get a zero-copy view of all triangles.
+   * Same validity rules as getVerticesView.
+   * @param handle - The mesh handle
+   * @returns Int32Array view of vertex indices (1-indexed), 3 per element
+   */
+  getTrianglesView(handle: MeshHandleS): Int32Array {
+    const m = getModule();
+    const [countPtr] = scratchMemory(m, [4]);
+    const dataPtr = m._mmgs_view_triangles(handle, countPtr);
+    const count = m.getValue(countPtr, "i32");
+    if (dataPtr === 0) {
+      return new Int32Array(0);
+    }
+    return m.HEAP32.subarray(dataPtr / 4, dataPtr / 4 + count * 3);
+  },
+
+  /**
+   * Get a zero-copy view of all edges.
+   * Same validity rules as getVerticesView.
+   * @param handle - The mesh handle
+   * @returns Int32Array view of vertex indices (1-indexed), 2 per element
+   */
+  getEdgesView(handle: MeshHandleS): Int32Array {
+    const m = getModule();
+    const [countPtr] = scratchMemory(m, [4]);
+    const dataPtr = m._mmgs_view_edges(handle, countPtr);
+    const count = m.getValue(countPtr, "i32");
+    if (dataPtr === 0) {
+      return new Int32Array(0);
+    }
+    return m.HEAP32.subarray(dataPtr / 4, dataPtr / 4 + count * 2);
+  },
+
+  /**
+   * Pack the mesh into the compact wire format (see decodePackedMesh):
+   * float32 or quantized positions, triangles and edges with 0-based
+   * indices, in one buffer that can be transferred to another thread.
+   * @param handle - The mesh handle
+   * @param options - Quantization and boundary-only packing
+   * @returns Copy of the packed mesh
+   * @throws Error if packing fails
+   */
+  packMesh(handle: MeshHandleS, options: PackOptions = {}): Uint8Array {
+    const m = getModule();
+    const [sizePtr] = scratchMemory(m, [4]);
+    const dataPtr = m._mmgs_pack_mesh(handle, packFlags(options), sizePtr);
+    if (dataPtr === 0) {
+      throw new Error("Failed to pack mesh");
+    }
+    return m.HEAPU8.slice(dataPtr, dataPtr + m.getValue(sizePtr, "i32"));
+  },
+
+  /**
+   * Remesh many meshes in one native call, with the same parameters.
+   * Every mesh is staged in one buffer, remeshed in a fresh MMG structure
+   * and written into one result buffer, copied back at once.
+   * @param meshes - Vertices, triangles, boundary edges, their
+   *   references and an optional metric (1 or 6 values per vertex) of
+   *   each mesh
+   * @param parameters - MMG parameters set on every mesh (see
+   *   optionParameters)
+   * @returns One result per mesh, in order
+   * @throws Error if an array has the wrong length or the batch fails
+   */
+  remeshBatch(
+    meshes: MeshImportData[],
+    parameters: OptionParameter[] = [],
+  ): BatchRemeshResult[] {
+    const m = getModule();
+    const handle = m._mmgs_init();
+    if (handle < 0) {
+      throw new Error("Failed to initialize MMGS mesh (max handles reached?)");
+    }
+    try {
+      const [meshesPtr, parametersPtr, sizePtr] = packMeshImports(
+        m,
+        meshes,
+        IMPORT_LAYOUT,
+        [parameters.length * BATCH_PARAMETER_BYTES, 4],
+      );
+      writeBatchParameters(m, parametersPtr, parameters);
+      const dataPtr = m._mmgs_remesh_batch(
+        handle,
+        meshesPtr,
+        meshes.length,
+        parametersPtr,
+        parameters.length,
+        sizePtr,
+      );
+      if (dataPtr === 0) {
+        throw new Error("Failed to remesh batch");
       }
+      const bytes = m.HEAPU8.slice(
+        dataPtr,
+        dataPtr + m.getValue(sizePtr, "i32"),
+      );
+      return decodeBatch(bytes, IMPORT_LAYOUT, meshes);
     } finally {
-      m._free(countPtr);
+      m._mmgs_free(handle);
     }
   },
 };
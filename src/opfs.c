@@ -0,0 +1,41 @@
+/**
+ * Disk-backed files through WASMFS and OPFS (see opfs.h)
+ */
+
+#include <emscripten.h>
+#include "opfs.h"
+
+#ifdef MMGWASM_WASMFS
+#include <emscripten/wasmfs.h>
+#endif
+
+/**
+ * Check whether this build can mount OPFS directories.
+ * Returns 1 for the OPFS (WASMFS) build, 0 otherwise.
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmgwasm_has_opfs(void) {
+#ifdef MMGWASM_WASMFS
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Mount an OPFS-backed directory at path.
+ * Returns 1 on success, 0 otherwise.
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmgwasm_mount_opfs(const char* path) {
+#ifdef MMGWASM_WASMFS
+    backend_t backend = wasmfs_create_opfs_backend();
+    if (!backend) {
+        return 0;
+    }
+    return wasmfs_create_directory(path, 0777, backend) == 0 ? 1 : 0;
+#else
+    (void)path;
+    return 0;
+#endif
+}
@@ -0,0 +1,29 @@
+/**
+ * Disk-backed files through WASMFS and the Origin Private File System
+ *
+ * With the default filesystem (MEMFS) a file MMG reads or writes lives whole
+ * in the heap, next to MMG's own mesh structures. The OPFS build
+ * (MMG_WASM_WASMFS, see cmake/EmscriptenConfig.cmake) replaces MEMFS with
+ * WASMFS, under which a directory can be mounted on the browser's Origin
+ * Private File System: files there are read and written in place on disk, so
+ * mmgX_load_mesh, mmgX_save_mesh, mmgX_load_sol and mmgX_save_sol stream
+ * through fopen without ever holding a whole file in memory.
+ *
+ * The OPFS backend blocks on a helper thread, so it needs the pthreads build
+ * and must only be used from a worker, never the browser's main thread.
+ */
+
+#ifndef MMGWASM_OPFS_H
+#define MMGWASM_OPFS_H
+
+/* Returns 1 if this build can mount OPFS directories, 0 otherwise */
+int mmgwasm_has_opfs(void);
+
+/*
+ * Create the directory path backed by the Origin Private File System.
+ * Returns 1 on success, 0 if the build has no OPFS support or the directory
+ * cannot be created (e.g. it already exists).
+ */
+int mmgwasm_mount_opfs(const char* path);
+
+#endif /* MMGWASM_OPFS_H */
@@ -134,6 +134,28 @@ export interface RemeshOptions {
    */
   nomove?: boolean;
 
+  // =====================
+  // Local remeshing
+  // =====================
+
+  /**
+   * Only remesh around the local sizing regions
+   *
+   * Elements with no vertex inside a sizing region (see
+   * Mesh.setSizeSphere and friends) are kept exactly as they are, so
+   * refining a small area of a large mesh only reworks that area. The mesh
+   * must have sizing regions and no required entities of its own.
+   * @default false
+   */
+  local?: boolean;
+
+  /**
+   * Distance the sizing regions are grown by to select the elements
+   * reworked by a local remesh, leaving room for the size transition
+   * @default 0
+   */
+  localMargin?: number;
+
   // =====================
   // Output control
   // =====================
@@ -187,6 +209,7 @@ export function validateOptions(options: RemeshOptions): void {
     "hausd",
     "hgrad",
     "angleDetection",
+    "localMargin",
     "verbose",
   ];
   for (const field of numericFields) {
@@ -236,6 +259,10 @@ export function validateOptions(options: RemeshOptions): void {
     }
   }
 
+  if (options.localMargin !== undefined && options.localMargin < 0) {
+    throw new RemeshOptionsError("localMargin must be non-negative");
+  }
+
   if (options.verbose !== undefined) {
     if (
       !Number.isInteger(options.verbose) ||
@@ -348,46 +375,39 @@ export const RemeshPresets = {
 };
 
 /**
- * Apply RemeshOptions to an MMG handle
- *
- * Maps the high-level options to the corresponding MMG parameters
- * for the specified mesh type.
+ * MMG parameter set by a remesh option
+ * @internal
+ */
+export interface OptionParameter {
+  /** Whether the parameter is set as an integer or a double */
+  kind: "integer" | "double";
+  /** IPARAM or DPARAM constant of the mesh type */
+  param: number;
+  value: number;
+}
+
+/**
+ * List the MMG parameters RemeshOptions set for a mesh type
  *
- * @param handle - MMG mesh handle
- * @param type - Mesh type (determines which MMG library to use)
- * @param options - Remeshing options to apply
+ * @param type - Mesh type (determines the parameter constants)
+ * @param options - Remeshing options
+ * @returns The parameters, in the order they are applied
  * @throws RemeshOptionsError if options are invalid
  *
  * @internal
  */
-export function applyOptions(
-  handle: MeshHandle | MeshHandle2D | MeshHandleS,
+export function optionParameters(
   type: MeshType,
   options: RemeshOptions,
-): void {
+): OptionParameter[] {
   // Validate first
   validateOptions(options);
 
-  // Get the appropriate setters based on mesh type
-  const setD =
-    type === MeshType.Mesh2D
-      ? (param: number, value: number) =>
-          MMG2D.setDParam(handle as MeshHandle2D, param, value)
-      : type === MeshType.MeshS
-        ? (param: number, value: number) =>
-            MMGS.setDParam(handle as MeshHandleS, param, value)
-        : (param: number, value: number) =>
-            MMG3D.setDParam(handle as MeshHandle, param, value);
-
-  const setI =
-    type === MeshType.Mesh2D
-      ? (param: number, value: number) =>
-          MMG2D.setIParam(handle as MeshHandle2D, param, value)
-      : type === MeshType.MeshS
-        ? (param: number, value: number) =>
-            MMGS.setIParam(handle as MeshHandleS, param, value)
-        : (param: number, value: number) =>
-            MMG3D.setIParam(handle as MeshHandle, param, value);
+  const parameters: OptionParameter[] = [];
+  const setD = (param: number, value: number) =>
+    parameters.push({ kind: "double", param, value });
+  const setI = (param: number, value: number) =>
+    parameters.push({ kind: "integer", param, value });
 
   // Get the appropriate parameter constants
   const dparam =
@@ -443,4 +463,53 @@ export function applyOptions(
   if (options.debug) {
     setI(iparam.debug, 1);
   }
+  return parameters;
+}
+
+/**
+ * Apply RemeshOptions to an MMG handle
+ *
+ * Maps the high-level options to the corresponding MMG parameters
+ * for the specified mesh type.
+ *
+ * @param handle - MMG mesh handle
+ * @param type - Mesh type (determines which MMG library to use)
+ * @param options - Remeshing options to apply
+ * @throws RemeshOptionsError if options are invalid
+ *
+ * @internal
+ */
+export function applyOptions(
+  handle: MeshHandle | MeshHandle2D | MeshHandleS,
+  type: MeshType,
+  options: RemeshOptions,
+): void {
+  // Get the appropriate setters based on mesh type
+  const setD =
+    type === MeshType.Mesh2D
+      ? (param: number, value: number) =>
+          MMG2D.setDParam(handle as MeshHandle2D, param, value)
+      : type === MeshType.MeshS
+        ? (param: number, value: number) =>
+            MMGS.setDParam(handle as MeshHandleS, param, value)
+        : (param: number, value: number) =>
+            MMG3D.setDParam(handle as MeshHandle, param, value);
+
+  const setI =
+    type === MeshType.Mesh2D
+      ? (param: number, value: number) =>
+          MMG2D.setIParam(handle as MeshHandle2D, param, value)
+      : type === MeshType.MeshS
+        ? (param: number, value: number) =>
+            MMGS.setIParam(handle as MeshHandleS, param, value)
+        : (param: number, value: number) =>
+            MMG3D.setIParam(handle as MeshHandle, param, value);
+
+  for (const { kind, param, value } of optionParameters(type, options)) {
+    if (kind === "double") {
+      setD(param, value);
+    } else {
+      setI(param, value);
+    }
+  }
 }
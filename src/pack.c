@@ -0,0 +1,124 @@
+/**
+ * Compact mesh wire format (see pack.h)
+ */
+
+#include <math.h>
+#include <string.h>
+#include "pack.h"
+
+/* Largest quantized coordinate */
+#define QUANT_MAX 65535.0
+
+/* Round a section size up to the 4-byte alignment of the next one */
+static size_t align4(size_t bytes) {
+    return (bytes + 3) & ~(size_t)3;
+}
+
+/* Only the requested flags, plus INDEX16 when every vertex fits */
+static int effective_flags(const MmgwasmPackInput* in, int flags) {
+    flags &= MMGWASM_PACK_QUANTIZE | MMGWASM_PACK_BOUNDARY_ONLY;
+    if (in->np <= 65536) {
+        flags |= MMGWASM_PACK_INDEX16;
+    }
+    return flags;
+}
+
+static int cell_count(const MmgwasmPackInput* in, int flags) {
+    return (flags & MMGWASM_PACK_BOUNDARY_ONLY) ? 0 : in->cells.count;
+}
+
+static size_t positions_bytes(const MmgwasmPackInput* in, int flags) {
+    size_t scalar = (flags & MMGWASM_PACK_QUANTIZE) ? 2 : 4;
+    return align4((size_t)in->np * (size_t)in->dim * scalar);
+}
+
+static size_t indices_bytes(int count, int size, int flags) {
+    size_t index = (flags & MMGWASM_PACK_INDEX16) ? 2 : 4;
+    return align4((size_t)count * (size_t)size * index);
+}
+
+size_t mmgwasm_pack_size(const MmgwasmPackInput* in, int flags) {
+    flags = effective_flags(in, flags);
+    return sizeof(MmgwasmPackHeader) + positions_bytes(in, flags) +
+           indices_bytes(cell_count(in, flags), in->cells.size, flags) +
+           indices_bytes(in->boundary.count, in->boundary.size, flags);
+}
+
+static const double* coords_of(const MmgwasmPackInput* in, int k) {
+    return (const double*)((const char*)in->coords +
+                           (size_t)k * in->coord_stride);
+}
+
+/* Write the vertex indices of count entities, made 0-based */
+static char* write_indices(char* out, const MmgwasmPackEntities* entities,
+                           int count, int flags) {
+    for (int k = 0; k < count; k++) {
+        const int* v = (const int*)((const char*)entities->verts +
+                                    (size_t)k * entities->stride);
+        for (int j = 0; j < entities->size; j++) {
+            size_t at = (size_t)k * entities->size + j;
+            if (flags & MMGWASM_PACK_INDEX16) {
+                ((uint16_t*)out)[at] = (uint16_t)(v[j] - 1);
+            } else {
+                ((uint32_t*)out)[at] = (uint32_t)(v[j] - 1);
+            }
+        }
+    }
+    return out + indices_bytes(count, entities->size, flags);
+}
+
+void mmgwasm_pack_write(const MmgwasmPackInput* in, int flags, void* out) {
+    flags = effective_flags(in, flags);
+
+    MmgwasmPackHeader* header = (MmgwasmPackHeader*)out;
+    memset(header, 0, sizeof(*header));
+    header->magic = MMGWASM_PACK_MAGIC;
+    header->flags = (uint32_t)flags;
+    header->dim = in->dim;
+    header->np = in->np;
+    header->ne = cell_count(in, flags);
+    header->cell_size = in->cells.size;
+    header->nb = in->boundary.count;
+    header->boundary_size = in->boundary.size;
+
+    char* cursor = (char*)out + sizeof(MmgwasmPackHeader);
+
+    if (flags & MMGWASM_PACK_QUANTIZE) {
+        double lo[3] = {0.0, 0.0, 0.0};
+        double hi[3] = {0.0, 0.0, 0.0};
+        for (int k = 0; k < in->np; k++) {
+            const double* c = coords_of(in, k);
+            for (int d = 0; d < in->dim; d++) {
+                if (k == 0 || c[d] < lo[d]) lo[d] = c[d];
+                if (k == 0 || c[d] > hi[d]) hi[d] = c[d];
+            }
+        }
+        for (int d = 0; d < in->dim; d++) {
+            header->origin[d] = lo[d];
+            header->step[d] = (hi[d] - lo[d]) / QUANT_MAX;
+        }
+
+        uint16_t* positions = (uint16_t*)cursor;
+        for (int k = 0; k < in->np; k++) {
+            const double* c = coords_of(in, k);
+            for (int d = 0; d < in->dim; d++) {
+                double q = header->step[d] > 0.0
+                    ? (c[d] - lo[d]) / header->step[d]
+                    : 0.0;
+                positions[(size_t)k * in->dim + d] = (uint16_t)lround(q);
+            }
+        }
+    } else {
+        float* positions = (float*)cursor;
+        for (int k = 0; k < in->np; k++) {
+            const double* c = coords_of(in, k);
+            for (int d = 0; d < in->dim; d++) {
+                positions[(size_t)k * in->dim + d] = (float)c[d];
+            }
+        }
+    }
+    cursor += positions_bytes(in, flags);
+
+    cursor = write_indices(cursor, &in->cells, header->ne, flags);
+    write_indices(cursor, &in->boundary, in->boundary.count, flags);
+}
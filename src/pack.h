@@ -0,0 +1,76 @@
+/**
+ * Compact mesh wire format
+ *
+ * Display-only consumers (worker previews, viewers) need neither double
+ * precision nor MMG's 1-based 32-bit indices. A packed mesh holds everything
+ * in one buffer that can be transferred between threads as is:
+ *
+ *   MmgwasmPackHeader
+ *   positions  np * dim float32, or uint16 quantized in the bounding box
+ *   cells      ne * cell_size vertex indices (none with BOUNDARY_ONLY)
+ *   boundary   nb * boundary_size vertex indices
+ *
+ * Indices are 0-based, uint16 when every vertex fits and uint32 otherwise.
+ * Every section starts on a 4-byte boundary. A quantized coordinate q
+ * decodes to origin + q * step.
+ */
+
+#ifndef MMGWASM_PACK_H
+#define MMGWASM_PACK_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* "MMPK" in little-endian byte order */
+#define MMGWASM_PACK_MAGIC 0x4b504d4du
+
+/* Encoding flags: QUANTIZE and BOUNDARY_ONLY are requested, INDEX16 is chosen */
+enum {
+    MMGWASM_PACK_QUANTIZE = 1,      /* uint16 positions instead of float32 */
+    MMGWASM_PACK_INDEX16 = 2,       /* uint16 indices instead of uint32 */
+    MMGWASM_PACK_BOUNDARY_ONLY = 4  /* cells left out */
+};
+
+typedef struct {
+    uint32_t magic;
+    uint32_t flags;         /* MMGWASM_PACK_* the sections are encoded with */
+    int32_t dim;            /* coordinates per vertex, 2 or 3 */
+    int32_t np;
+    int32_t ne;
+    int32_t cell_size;      /* vertices per cell */
+    int32_t nb;
+    int32_t boundary_size;  /* vertices per boundary element */
+    double origin[3];       /* quantization box, unused without QUANTIZE */
+    double step[3];
+} MmgwasmPackHeader;
+
+/*
+ * Entities read in place from MMG's structures: consecutive entries are
+ * stride bytes apart, and vertex indices are 1-based as in MMG.
+ */
+typedef struct {
+    const int* verts;       /* vertex indices of entity 1 */
+    size_t stride;
+    int size;               /* vertices per entity */
+    int count;
+} MmgwasmPackEntities;
+
+typedef struct {
+    int dim;
+    const double* coords;   /* coordinates of vertex 1 */
+    size_t coord_stride;
+    int np;
+    MmgwasmPackEntities cells;
+    MmgwasmPackEntities boundary;
+} MmgwasmPackInput;
+
+/* Bytes of the packed mesh for the requested flags */
+size_t mmgwasm_pack_size(const MmgwasmPackInput* in, int flags);
+
+/*
+ * Pack a mesh into out, which must hold mmgwasm_pack_size bytes and be
+ * 8-byte aligned.
+ */
+void mmgwasm_pack_write(const MmgwasmPackInput* in, int flags, void* out);
+
+#endif /* MMGWASM_PACK_H */
@@ -0,0 +1,143 @@
+/**
+ * Compact mesh wire format
+ *
+ * Previews and viewers only display a mesh, so they need neither double
+ * precision coordinates nor MMG's 1-based 32-bit indices. The mmgX_pack_mesh
+ * wrappers write a mesh as one buffer (src/pack.h) with float32 or quantized
+ * uint16 positions and 0-based uint16/uint32 indices, which is a fraction of
+ * the size of the separate arrays and can be transferred between threads.
+ */
+
+/**
+ * How to pack a mesh
+ */
+export interface PackOptions {
+  /**
+   * Quantize positions to 16 bits in the bounding box of the mesh, which
+   * halves their size at a precision of 1/65535 of the box (default: false)
+   */
+  quantize?: boolean;
+  /**
+   * Leave the cells out and only keep the boundary, enough to display a
+   * volume mesh (default: false)
+   */
+  boundaryOnly?: boolean;
+}
+
+/**
+ * Mesh decoded from the wire format
+ */
+export interface PackedMesh {
+  /** Coordinates per vertex (2 or 3) */
+  dim: number;
+  /** Number of vertices */
+  nVertices: number;
+  /** Vertex positions, dim per vertex */
+  positions: Float32Array;
+  /** Vertices per cell: 4 for tetrahedra, 3 for triangles */
+  cellSize: number;
+  /** Cell vertex indices (0-based), empty when packed boundary only */
+  cells: Uint16Array | Uint32Array;
+  /** Vertices per boundary element: 3 for triangles, 2 for edges */
+  boundarySize: number;
+  /** Boundary vertex indices (0-based) */
+  boundary: Uint16Array | Uint32Array;
+}
+
+/** "MMPK" in little-endian byte order */
+const PACK_MAGIC = 0x4b504d4d;
+
+/** Flags of MmgwasmPackHeader (src/pack.h) */
+const PACK_QUANTIZE = 1;
+const PACK_INDEX16 = 2;
+const PACK_BOUNDARY_ONLY = 4;
+
+/** Bytes of MmgwasmPackHeader: 8 ints and 6 doubles */
+const HEADER_BYTES = 80;
+
+/**
+ * Flags of the mmgX_pack_mesh wrappers for pack options
+ * @internal
+ */
+export function packFlags(options: PackOptions = {}): number {
+  return (
+    (options.quantize ? PACK_QUANTIZE : 0) |
+    (options.boundaryOnly ? PACK_BOUNDARY_ONLY : 0)
+  );
+}
+
+/**
+ * Decode a packed mesh
+ *
+ * Float32 positions and indices are views of the buffer, so nothing is
+ * copied unless the positions were quantized.
+ *
+ * @param bytes - Packed mesh, as returned by packMesh
+ * @returns The decoded arrays
+ * @throws Error if the buffer is not a packed mesh or is truncated
+ */
+export function decodePackedMesh(bytes: ArrayBuffer | Uint8Array): PackedMesh {
+  const buffer = bytes instanceof Uint8Array ? bytes.buffer : bytes;
+  const base = bytes instanceof Uint8Array ? bytes.byteOffset : 0;
+  const length = bytes.byteLength;
+  if (length < HEADER_BYTES || base % 4 !== 0) {
+    throw new Error("Invalid packed mesh: truncated or misaligned buffer");
+  }
+
+  const view = new DataView(buffer, base, length);
+  if (view.getUint32(0, true) !== PACK_MAGIC) {
+    throw new Error("Invalid packed mesh: bad magic number");
+  }
+  const flags = view.getUint32(4, true);
+  const dim = view.getInt32(8, true);
+  const np = view.getInt32(12, true);
+  const ne = view.getInt32(16, true);
+  const cellSize = view.getInt32(20, true);
+  const nb = view.getInt32(24, true);
+  const boundarySize = view.getInt32(28, true);
+
+  const align4 = (n: number) => (n + 3) & ~3;
+  const scalarBytes = flags & PACK_QUANTIZE ? 2 : 4;
+  const indexBytes = flags & PACK_INDEX16 ? 2 : 4;
+  const positionsBytes = align4(np * dim * scalarBytes);
+  const cellsBytes = align4(ne * cellSize * indexBytes);
+  const boundaryBytes = align4(nb * boundarySize * indexBytes);
+  if (HEADER_BYTES + positionsBytes + cellsBytes + boundaryBytes > length) {
+    throw new Error("Invalid packed mesh: truncated buffer");
+  }
+
+  let offset = base + HEADER_BYTES;
+  let positions: Float32Array;
+  if (flags & PACK_QUANTIZE) {
+    const quantized = new Uint16Array(buffer, offset, np * dim);
+    positions = new Float32Array(np * dim);
+    for (let d = 0; d < dim; d++) {
+      const origin = view.getFloat64(32 + 8 * d, true);
+      const step = view.getFloat64(56 + 8 * d, true);
+      for (let i = d; i < quantized.length; i += dim) {
+        positions[i] = origin + quantized[i] * step;
+      }
+    }
+  } else {
+    positions = new Float32Array(buffer, offset, np * dim);
+  }
+  offset += positionsBytes;
+
+  const indices = (count: number) =>
+    flags & PACK_INDEX16
+      ? new Uint16Array(buffer, offset, count)
+      : new Uint32Array(buffer, offset, count);
+  const cells = indices(ne * cellSize);
+  offset += cellsBytes;
+  const boundary = indices(nb * boundarySize);
+
+  return {
+    dim,
+    nVertices: np,
+    positions,
+    cellSize,
+    cells,
+    boundarySize,
+    boundary,
+  };
+}
@@ -0,0 +1,317 @@
+/**
+ * Domain decomposition of tetrahedral meshes (see partition.h)
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "partition.h"
+
+/* Vertices of face i, the one opposite vertex i */
+static const int FACE_VERTICES[4][3] = {
+    {1, 2, 3}, {0, 3, 2}, {0, 1, 3}, {0, 2, 1}
+};
+
+/* Coordinates of a 1-based vertex */
+static const double* vertex(const MmgwasmElements* e, int v) {
+    return (const double*)((const char*)e->coords +
+                           (size_t)(v - 1) * e->coord_stride);
+}
+
+/* Vertex indices of a 0-based element */
+static const int* element(const MmgwasmElements* e, int k) {
+    return (const int*)((const char*)e->elems + (size_t)k * e->elem_stride);
+}
+
+/* Coordinate d of the centroid of tetrahedron k, times 4 */
+static double centroid(const MmgwasmElements* e, int k, int d) {
+    const int* v = element(e, k);
+    return vertex(e, v[0])[d] + vertex(e, v[1])[d] + vertex(e, v[2])[d] +
+           vertex(e, v[3])[d];
+}
+
+/*
+ * Reorder ids so that ids[rank] holds the tetrahedron of that rank along
+ * axis, with smaller centroids before it and larger ones after it
+ */
+static void select_rank(const MmgwasmElements* e, int* ids, int n, int rank,
+                        int axis) {
+    int lo = 0;
+    int hi = n - 1;
+    while (lo < hi) {
+        double pivot = centroid(e, ids[lo + (hi - lo) / 2], axis);
+        int i = lo;
+        int j = hi;
+        while (i <= j) {
+            while (centroid(e, ids[i], axis) < pivot) i++;
+            while (centroid(e, ids[j], axis) > pivot) j--;
+            if (i <= j) {
+                int t = ids[i];
+                ids[i++] = ids[j];
+                ids[j--] = t;
+            }
+        }
+        if (rank <= j) {
+            hi = j;
+        } else if (rank >= i) {
+            lo = i;
+        } else {
+            return;
+        }
+    }
+}
+
+/* Split n tetrahedra into parts first .. first + nparts - 1 */
+static void bisect(const MmgwasmElements* e, int* ids, int n, int first,
+                   int nparts, int pass, int* part) {
+    if (nparts == 1 || n <= 1) {
+        for (int i = 0; i < n; i++) {
+            part[ids[i]] = first;
+        }
+        return;
+    }
+
+    double min[3] = {HUGE_VAL, HUGE_VAL, HUGE_VAL};
+    double max[3] = {-HUGE_VAL, -HUGE_VAL, -HUGE_VAL};
+    for (int i = 0; i < n; i++) {
+        for (int d = 0; d < 3; d++) {
+            double c = centroid(e, ids[i], d);
+            if (c < min[d]) min[d] = c;
+            if (c > max[d]) max[d] = c;
+        }
+    }
+    /* Axes by decreasing extent, the pass picks one */
+    int order[3] = {0, 1, 2};
+    for (int a = 0; a < 2; a++) {
+        for (int b = 0; b < 2 - a; b++) {
+            if (max[order[b]] - min[order[b]] <
+                max[order[b + 1]] - min[order[b + 1]]) {
+                int t = order[b];
+                order[b] = order[b + 1];
+                order[b + 1] = t;
+            }
+        }
+    }
+    int axis = order[pass % 3];
+
+    /* Sizes proportional to the part counts keep every part non-empty */
+    int left = nparts / 2;
+    int nleft = (int)((int64_t)n * left / nparts);
+    select_rank(e, ids, n, nleft, axis);
+    bisect(e, ids, nleft, first, left, pass, part);
+    bisect(e, ids + nleft, n - nleft, first + left, nparts - left, pass, part);
+}
+
+int mmgwasm_partition(const MmgwasmElements* tetrahedra, int nparts, int pass,
+                      int* part) {
+    int ne = tetrahedra->elems ? tetrahedra->nelem : 0;
+    if (nparts < 1 || pass < 0 || ne < 0 || (ne > 0 && !part)) {
+        return 0;
+    }
+
+    int* ids = (int*)malloc((ne > 0 ? (size_t)ne : 1) * sizeof(int));
+    if (!ids) {
+        return 0;
+    }
+    for (int k = 0; k < ne; k++) {
+        ids[k] = k;
+    }
+    bisect(tetrahedra, ids, ne, 0, nparts, pass, part);
+    free(ids);
+    return 1;
+}
+
+/* Sort three vertex indices in increasing order */
+static void sort3(int* f) {
+    for (int j = 0; j < 2; j++) {
+        for (int l = 0; l < 2 - j; l++) {
+            if (f[l] > f[l + 1]) {
+                int t = f[l];
+                f[l] = f[l + 1];
+                f[l + 1] = t;
+            }
+        }
+    }
+}
+
+/* Vertices of face code (4 * tetrahedron + face) in increasing order */
+static void sorted_face(const MmgwasmElements* e, int code, int* f) {
+    const int* v = element(e, code / 4);
+    for (int j = 0; j < 3; j++) {
+        f[j] = v[FACE_VERTICES[code % 4][j]];
+    }
+    sort3(f);
+}
+
+/*
+ * Faces bucketed by their smallest vertex: the codes of vertex v's faces
+ * are faces[start[v] .. start[v + 1]). start holds np + 2 zeroed ints and
+ * cursor np + 1 ints.
+ */
+static void bucket_faces(const MmgwasmElements* e, int np, int ne, int* start,
+                         int* cursor, int* faces) {
+    for (int code = 0; code < 4 * ne; code++) {
+        int f[3];
+        sorted_face(e, code, f);
+        start[f[0] + 1]++;
+    }
+    for (int v = 1; v <= np + 1; v++) {
+        start[v] += start[v - 1];
+    }
+    for (int v = 0; v <= np; v++) {
+        cursor[v] = start[v];
+    }
+    for (int code = 0; code < 4 * ne; code++) {
+        int f[3];
+        sorted_face(e, code, f);
+        faces[cursor[f[0]]++] = code;
+    }
+}
+
+int mmgwasm_match_faces(const MmgwasmElements* tetrahedra, int np,
+                        const MmgwasmElements* triangles, int* adjacency,
+                        int* face_triangle) {
+    int ne = tetrahedra->elems ? tetrahedra->nelem : 0;
+    int nt = triangles && triangles->elems ? triangles->nelem : 0;
+    if (np < 0 || ne < 0 || ne > INT32_MAX / 4 || nt < 0) {
+        return 0;
+    }
+
+    int* start = (int*)calloc((size_t)np + 2, sizeof(int));
+    int* cursor = (int*)malloc(((size_t)np + 1) * sizeof(int));
+    int* faces = (int*)malloc((ne > 0 ? 4 * (size_t)ne : 1) * sizeof(int));
+    if (!start || !cursor || !faces) {
+        free(faces);
+        free(cursor);
+        free(start);
+        return 0;
+    }
+    bucket_faces(tetrahedra, np, ne, start, cursor, faces);
+
+    for (int code = 0; code < 4 * ne; code++) {
+        adjacency[code] = -1;
+        if (face_triangle) {
+            face_triangle[code] = -1;
+        }
+    }
+
+    for (int v = 1; v <= np; v++) {
+        for (int i = start[v]; i < start[v + 1]; i++) {
+            int f[3];
+            sorted_face(tetrahedra, faces[i], f);
+            for (int j = i + 1; j < start[v + 1]; j++) {
+                int g[3];
+                sorted_face(tetrahedra, faces[j], g);
+                if (g[1] == f[1] && g[2] == f[2]) {
+                    adjacency[faces[i]] = faces[j] / 4;
+                    adjacency[faces[j]] = faces[i] / 4;
+                }
+            }
+        }
+    }
+
+    for (int t = 0; face_triangle && t < nt; t++) {
+        const int* tv = element(triangles, t);
+        int g[3] = {tv[0], tv[1], tv[2]};
+        sort3(g);
+        if (g[0] < 1 || g[2] > np) {
+            continue;
+        }
+        for (int i = start[g[0]]; i < start[g[0] + 1]; i++) {
+            int f[3];
+            sorted_face(tetrahedra, faces[i], f);
+            if (f[1] == g[1] && f[2] == g[2]) {
+                face_triangle[faces[i]] = t;
+            }
+        }
+    }
+
+    free(faces);
+    free(cursor);
+    free(start);
+    return 1;
+}
+
+/* Bucket of a grid cell */
+static size_t cell_bucket(int64_t ix, int64_t iy, int64_t iz, size_t mask) {
+    uint64_t h = (uint64_t)ix * 73856093u ^ (uint64_t)iy * 19349663u ^
+                 (uint64_t)iz * 83492791u;
+    return (size_t)(h ^ (h >> 29)) & mask;
+}
+
+int mmgwasm_weld(const double* coords, size_t stride, int n, double tolerance,
+                 int* out) {
+    if (n <= 0) {
+        return 0;
+    }
+
+    /* Grid cells of the tolerance: a match lies in one of 27 cells */
+    double cell = tolerance > 0.0 ? tolerance : 1.0;
+    double tol2 = tolerance > 0.0 ? tolerance * tolerance : 0.0;
+    double min[3] = {HUGE_VAL, HUGE_VAL, HUGE_VAL};
+    const char* base = (const char*)coords;
+    for (int i = 0; i < n; i++) {
+        const double* x = (const double*)(base + (size_t)i * stride);
+        for (int d = 0; d < 3; d++) {
+            if (x[d] < min[d]) min[d] = x[d];
+        }
+    }
+
+    size_t buckets = 1;
+    while (buckets < 2 * (size_t)n) {
+        buckets <<= 1;
+    }
+    int* head = (int*)malloc(buckets * sizeof(int));
+    int* next = (int*)malloc((size_t)n * sizeof(int));
+    if (!head || !next) {
+        free(next);
+        free(head);
+        return -1;
+    }
+    for (size_t b = 0; b < buckets; b++) {
+        head[b] = -1;
+    }
+
+    int distinct = 0;
+    for (int i = 0; i < n; i++) {
+        const double* x = (const double*)(base + (size_t)i * stride);
+        int64_t c[3];
+        for (int d = 0; d < 3; d++) {
+            c[d] = (int64_t)floor((x[d] - min[d]) / cell);
+        }
+
+        int match = -1;
+        for (int dx = -1; dx <= 1 && match < 0; dx++) {
+            for (int dy = -1; dy <= 1 && match < 0; dy++) {
+                for (int dz = -1; dz <= 1 && match < 0; dz++) {
+                    size_t b = cell_bucket(c[0] + dx, c[1] + dy, c[2] + dz,
+                                           buckets - 1);
+                    for (int j = head[b]; j >= 0; j = next[j]) {
+                        const double* y =
+                            (const double*)(base + (size_t)j * stride);
+                        double d0 = x[0] - y[0];
+                        double d1 = x[1] - y[1];
+                        double d2 = x[2] - y[2];
+                        if (d0 * d0 + d1 * d1 + d2 * d2 <= tol2) {
+                            match = j;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        if (match >= 0) {
+            out[i] = out[match];
+        } else {
+            size_t b = cell_bucket(c[0], c[1], c[2], buckets - 1);
+            next[i] = head[b];
+            head[b] = i;
+            out[i] = distinct++;
+        }
+    }
+
+    free(next);
+    free(head);
+    return distinct;
+}
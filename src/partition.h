@@ -0,0 +1,60 @@
+/**
+ * Domain decomposition of tetrahedral meshes
+ *
+ * A single MMG3D run uses one core, so a large mesh is split into parts that
+ * workers remesh side by side, then welded back into one mesh. Parts come
+ * from recursive coordinate bisection of the tetrahedra, which keeps them
+ * compact and balanced in element count. The faces between two parts are
+ * frozen (required) while the parts are remeshed, so both sides still match
+ * afterwards; a later pass cuts along other axes to remesh them as well.
+ *
+ * MMG scales every mesh into a unit box while remeshing, so the frozen
+ * interface vertices come back with rounding differences of each part's box:
+ * parts are welded by position within a tolerance, not by exact equality.
+ */
+
+#ifndef MMGWASM_PARTITION_H
+#define MMGWASM_PARTITION_H
+
+#include <stddef.h>
+#include "locate.h"
+
+/* Reference of the triangles freezing the interfaces between parts */
+#define MMGWASM_INTERFACE_REF 2147483647
+
+/* Welding tolerance, relative to the bounding box diagonal */
+#define MMGWASM_WELD_TOLERANCE 1e-9
+
+/*
+ * Assign each tetrahedron to one of nparts compact parts of balanced size.
+ * Every subset is halved at the median centroid along an axis: the longest
+ * one of the subset on pass 0, the next ones on later passes, so successive
+ * passes cut the mesh in different places.
+ * part receives the 0-based part of each tetrahedron.
+ * Returns 1 on success, 0 on invalid arguments or allocation failure.
+ */
+int mmgwasm_partition(const MmgwasmElements* tetrahedra, int nparts, int pass,
+                      int* part);
+
+/*
+ * Match the faces of np vertices' tetrahedra with each other and with
+ * boundary triangles. Face i of tetrahedron k (opposite vertex i) is entry
+ * 4 * k + i: adjacency receives the 0-based tetrahedron on its other side, or
+ * -1 on the boundary, and face_triangle, if not NULL, the 0-based triangle
+ * lying on it, or -1.
+ * Returns 1 on success, 0 on allocation failure.
+ */
+int mmgwasm_match_faces(const MmgwasmElements* tetrahedra, int np,
+                        const MmgwasmElements* triangles, int* adjacency,
+                        int* face_triangle);
+
+/*
+ * Weld n points of 3 coordinates, stride bytes apart, that lie within
+ * tolerance of an earlier one. out receives the 0-based index of each point
+ * among the distinct ones, numbered in order of first appearance.
+ * Returns the number of distinct points, or -1 on allocation failure.
+ */
+int mmgwasm_weld(const double* coords, size_t stride, int n, double tolerance,
+                 int* out);
+
+#endif /* MMGWASM_PARTITION_H */
@@ -0,0 +1,149 @@
+/**
+ * Progress reporting and cooperative cancellation (see progress.h)
+ */
+
+#include <string.h>
+#include "progress.h"
+#include "stats.h"
+
+/* Share of the progress estimate given to each phase (percent) */
+#define PERCENT_ANALYSIS_END 10
+#define PERCENT_MESHING_END 90
+
+/* Remesh being tracked on the current thread */
+static _Thread_local struct {
+    MmgwasmProgress* progress;  /* NULL when the hooks are not armed */
+    MmgwasmStats* stats;        /* NULL unless instrumented */
+    int tracking;               /* 1 to update the progress record */
+    int aborted;
+} t_run;
+
+/* Move to a phase, never letting the estimate go backwards */
+static void set_progress(MmgwasmProgress* progress, int phase, int percent) {
+    if (!t_run.tracking) {
+        return;
+    }
+    __atomic_store_n(&progress->phase, phase, __ATOMIC_RELAXED);
+    if (percent > __atomic_load_n(&progress->percent, __ATOMIC_RELAXED)) {
+        __atomic_store_n(&progress->percent, percent, __ATOMIC_RELAXED);
+    }
+}
+
+/* Time an MMG phase (0 once completed) when instrumented */
+static void set_stats_phase(int phase) {
+    if (t_run.stats) {
+        mmgwasm_stats_phase(t_run.stats, phase);
+    }
+}
+
+/* Whether the tracked remesh must stop, latching the abort */
+static int should_abort(void) {
+    if (!t_run.aborted &&
+        __atomic_load_n(&t_run.progress->abort, __ATOMIC_RELAXED)) {
+        t_run.aborted = 1;
+    }
+    return t_run.aborted;
+}
+
+void mmgwasm_progress_reset(MmgwasmProgress* progress) {
+    __atomic_store_n(&progress->abort, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&progress->phase, MMGWASM_PHASE_IDLE, __ATOMIC_RELAXED);
+    __atomic_store_n(&progress->percent, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&progress->iterations, 0, __ATOMIC_RELAXED);
+}
+
+int mmgwasm_progress_begin(MmgwasmProgress* progress, MmgwasmStats* stats,
+                           int* imprim) {
+    int tracking = __atomic_load_n(&progress->enabled, __ATOMIC_RELAXED);
+    if (!MMGWASM_STATS_ENABLED) {
+        stats = NULL;
+    }
+    if (!tracking && !stats) {
+        return 1;
+    }
+    if (__atomic_load_n(&progress->abort, __ATOMIC_RELAXED)) {
+        return 0;
+    }
+
+    t_run.progress = progress;
+    t_run.stats = stats;
+    t_run.tracking = tracking;
+    t_run.aborted = 0;
+    if (stats) {
+        mmgwasm_stats_begin(stats, imprim);
+    }
+    return 1;
+}
+
+int mmgwasm_progress_end(void) {
+    MmgwasmProgress* progress = t_run.progress;
+    if (!progress) {
+        return 0;
+    }
+
+    int aborted = t_run.aborted;
+    if (t_run.stats) {
+        mmgwasm_stats_end(t_run.stats);
+    }
+    if (!aborted) {
+        set_progress(progress, MMGWASM_PHASE_DONE, 100);
+    }
+    memset(&t_run, 0, sizeof(t_run));
+    return aborted;
+}
+
+int mmgwasm_progress_enter(int phase) {
+    MmgwasmProgress* progress = t_run.progress;
+    if (!progress) {
+        return 1;
+    }
+    if (should_abort()) {
+        return 0;
+    }
+
+    if (phase == MMGWASM_PHASE_ANALYSIS) {
+        set_progress(progress, MMGWASM_PHASE_ANALYSIS, 1);
+    } else {
+        set_progress(progress, MMGWASM_PHASE_MESHING, PERCENT_ANALYSIS_END);
+    }
+    set_stats_phase(phase);
+    return 1;
+}
+
+int mmgwasm_progress_step(void) {
+    MmgwasmProgress* progress = t_run.progress;
+    if (!progress) {
+        return 1;
+    }
+    if (should_abort()) {
+        return 0;
+    }
+
+    /*
+     * The number of passes is not known in advance, so the estimate
+     * approaches the end of the phase asymptotically.
+     */
+    if (t_run.tracking) {
+        int it = __atomic_add_fetch(&progress->iterations, 1, __ATOMIC_RELAXED);
+        set_progress(progress, MMGWASM_PHASE_MESHING,
+            PERCENT_ANALYSIS_END +
+            (PERCENT_MESHING_END - PERCENT_ANALYSIS_END) * it / (it + 8));
+    }
+    return 1;
+}
+
+void mmgwasm_progress_leave(int phase) {
+    MmgwasmProgress* progress = t_run.progress;
+    if (!progress || t_run.aborted) {
+        return;
+    }
+
+    if (phase == MMGWASM_PHASE_ANALYSIS) {
+        set_progress(progress, MMGWASM_PHASE_ANALYSIS, PERCENT_ANALYSIS_END);
+        set_stats_phase(0);
+    } else {
+        /* Everything after the meshing phase is MMG packing its output */
+        set_progress(progress, MMGWASM_PHASE_FINALIZE, PERCENT_MESHING_END);
+        set_stats_phase(MMGWASM_PHASE_FINALIZE);
+    }
+}
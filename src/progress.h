@@ -0,0 +1,81 @@
+/**
+ * Progress reporting and cooperative cancellation for MMG remeshes
+ *
+ * MMG has no callback API, but its remesh drivers (MMGX_mmgXlib) call their
+ * phases and operators through functions of other translation units. The
+ * wrappers hook a few of them with -Wl,--wrap (see CMakeLists.txt and the
+ * "Phase hooks" of mmg3d.c, mmg2d.c and mmgs.c): the analysis and meshing
+ * phases, and in 3D the swap and move passes of every wavefront. Each hook
+ * updates a per-handle MmgwasmProgress record in linear memory and, when the
+ * abort flag is set, returns MMG's own failure value instead of running, so
+ * MMG unwinds through its normal error path: the mesh is unscaled, packed and
+ * returned consistent, only partially remeshed. MMG prints the failure of the
+ * hooked function on stderr, as for any low failure.
+ *
+ * JavaScript reads the record and writes the abort flag directly through the
+ * heap, which the pthreads build shares with the thread running the remesh.
+ */
+
+#ifndef MMGWASM_PROGRESS_H
+#define MMGWASM_PROGRESS_H
+
+#include "stats.h"
+
+/* Value returned by a remesh that was aborted through its progress record */
+#define MMGWASM_REMESH_ABORTED (-3)
+
+/* Remesh phases reported in MmgwasmProgress.phase */
+enum {
+    MMGWASM_PHASE_IDLE = 0,
+    MMGWASM_PHASE_ANALYSIS = 1,  /* MMG phase 1: analysis */
+    MMGWASM_PHASE_MESHING = 2,   /* MMG phase 2: split/collapse/swap/move */
+    MMGWASM_PHASE_FINALIZE = 3,  /* MMG phase 3: packing the mesh */
+    MMGWASM_PHASE_DONE = 4
+};
+
+/*
+ * Progress record of a handle, laid out as 32-bit ints so JavaScript can
+ * access it with a single Int32Array view (see mmgX_get_progress).
+ */
+typedef struct {
+    int enabled;     /* set by the caller to track the next remesh */
+    int abort;       /* set by the caller to cancel the running remesh */
+    int phase;       /* MMGWASM_PHASE_* reached so far */
+    int percent;     /* progress estimate, 0 to 100 */
+    int iterations;  /* operator passes of the meshing phase (3D only) */
+} MmgwasmProgress;
+
+/* Clear the abort flag and counters before a remesh is started */
+void mmgwasm_progress_reset(MmgwasmProgress* progress);
+
+/*
+ * Arm the phase hooks for a remesh running on the current thread.
+ * stats receives the statistics of the remesh in the instrumentation build
+ * and is ignored otherwise; imprim points at the mesh verbosity, which only
+ * that build raises (see stats.h). Does nothing unless progress->enabled or
+ * statistics are recorded.
+ * Returns 0 if the abort flag is already set, in which case the hooks are
+ * not armed and MMG must not be called.
+ */
+int mmgwasm_progress_begin(MmgwasmProgress* progress, MmgwasmStats* stats,
+                           int* imprim);
+
+/*
+ * Disarm the hooks, marking the run done if it was not aborted.
+ * Returns 1 if a hook saw the abort flag, 0 otherwise.
+ */
+int mmgwasm_progress_end(void);
+
+/*
+ * Phase hooks, called by the wrappers of MMG's phase functions.
+ * mmgwasm_progress_enter is called before a phase (MMGWASM_PHASE_ANALYSIS or
+ * MMGWASM_PHASE_MESHING) and mmgwasm_progress_step before an operator pass
+ * of the meshing phase: both return 0 when the remesh must abort, and the
+ * wrapper then returns MMG's failure value without running the function.
+ * mmgwasm_progress_leave is called once a phase has returned.
+ */
+int mmgwasm_progress_enter(int phase);
+int mmgwasm_progress_step(void);
+void mmgwasm_progress_leave(int phase);
+
+#endif /* MMGWASM_PROGRESS_H */
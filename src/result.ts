@@ -4,7 +4,71 @@
  * Contains the remeshed mesh along with statistics and quality metrics.
  */
 
-import type { Mesh } from "./mesh";
+import type { Mesh, MeshData } from "./mesh";
+import type { PackedMesh } from "./packed";
+
+/**
+ * Time spent in each step of a remesh, in milliseconds
+ *
+ * The steps run in this order and together make up `RemeshResult.elapsed`
+ * (up to timer resolution).
+ */
+export interface RemeshTimings {
+  /** Copying the input mesh to a working handle (native) */
+  clone: number;
+
+  /** Evaluating local sizing constraints into a metric (0 without any) */
+  sizing: number;
+
+  /** Quality passes over the input and output meshes */
+  quality: number;
+
+  /** MMG itself, including option setup */
+  remesh: number;
+}
+
+/**
+ * Time spent in each phase of MMG, in milliseconds
+ */
+export interface RemeshPhases {
+  /** Phase 1: analysis of the input mesh */
+  analysis: number;
+
+  /** Phase 2: split/collapse/swap/move wavefronts */
+  meshing: number;
+
+  /** Phase 3: packing the output mesh */
+  output: number;
+
+  /** Whole MMG call, phases included */
+  total: number;
+}
+
+/**
+ * Statistics of a remesh recorded inside MMG (instrumentation build only)
+ *
+ * MMG interleaves its operators inside every wavefront, so the operators are
+ * counted one by one but timed together as the meshing phase.
+ */
+export interface RemeshStats {
+  /** Time spent in each phase of MMG */
+  phases: RemeshPhases;
+
+  /** Edges split (points inserted) */
+  splits: number;
+
+  /** Edges collapsed */
+  collapses: number;
+
+  /** Edges or faces swapped */
+  swaps: number;
+
+  /** Points relocated */
+  moves: number;
+
+  /** Wavefronts (iterations of the meshing phase) */
+  wavefronts: number;
+}
 
 /**
  * Result of a mesh remeshing operation
@@ -39,6 +103,9 @@ export interface RemeshResult {
   /** Elapsed time in milliseconds */
   elapsed: number;
 
+  /** Breakdown of the elapsed time */
+  timings: RemeshTimings;
+
   /**
    * Minimum element quality before remeshing (0-1, higher is better)
    *
@@ -84,14 +151,16 @@ export interface RemeshResult {
   /**
    * Number of edges/faces swapped during remeshing
    *
-   * Note: MMG does not expose this statistic, always 0.
+   * Note: MMG does not expose this statistic, always 0 unless built with
+   * instrumentation (see stats).
    */
   nSwapped: number;
 
   /**
    * Number of vertices relocated during remeshing
    *
-   * Note: MMG does not expose this statistic, always 0.
+   * Note: MMG does not expose this statistic, always 0 unless built with
+   * instrumentation (see stats).
    */
   nMoved: number;
 
@@ -100,4 +169,66 @@ export interface RemeshResult {
 
   /** Warning messages from MMG (if any) */
   warnings: string[];
+
+  /** Memory of the worker that ran the remesh (MeshWorker results only) */
+  memory?: RemeshMemory;
+
+  /**
+   * Phase timings and operation counts of MMG, only recorded by the
+   * instrumentation build (MMG_WASM_STATS)
+   */
+  stats?: RemeshStats;
+
+  /**
+   * Whether the result was read from a RemeshCache instead of being
+   * computed; elapsed and timings then measure the read
+   */
+  cached?: boolean;
+}
+
+/**
+ * Memory of a worker's WASM module, measured once a job has finished and
+ * its meshes are freed
+ */
+export interface RemeshMemory {
+  /** WASM heap size in bytes (it never shrinks) */
+  heapSize: number;
+  /** Bytes still held by the C side, MMG included */
+  nativeUsed: number;
+  /** Most bytes the C side held at once during the job */
+  nativePeak: number;
+}
+
+/**
+ * Result of a remesh whose mesh only came back for display (see
+ * MeshWorker.preview): same statistics as RemeshResult, with the mesh decoded
+ * from the compact wire format
+ */
+export interface PreviewResult extends Omit<RemeshResult, "mesh"> {
+  /** Remeshed mesh, float32 positions and 0-based indices */
+  mesh: PackedMesh;
+}
+
+/**
+ * Result of a remesh whose mesh came back as an MMG binary file (see
+ * MeshWorker.remeshBuffer): same statistics as RemeshResult, with a mesh that
+ * keeps its references and required entities across threads
+ */
+export interface BufferRemeshResult extends Omit<RemeshResult, "mesh"> {
+  /** Remeshed mesh in .meshb format (see Mesh.load) */
+  mesh: Uint8Array;
+  /** Metric at the vertices of the remeshed mesh (see Mesh.metric) */
+  metric?: Float64Array;
+}
+
+/**
+ * Result of one mesh of a batch remesh (see Mesh.remeshBatch): same
+ * statistics as RemeshResult, with the mesh as plain arrays (views of one
+ * buffer for the whole batch) to pass to new Mesh() when needed. Timings only
+ * cover the native quality passes and MMG, as the batch has no clone or
+ * sizing step.
+ */
+export interface BatchRemeshResult extends Omit<RemeshResult, "mesh"> {
+  /** Remeshed mesh, empty if remeshing failed */
+  mesh: MeshData;
 }
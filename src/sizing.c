@@ -0,0 +1,368 @@
+/**
+ * Native evaluation of local sizing constraints (see sizing.h)
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include "bvh.h"
+#include "sizing.h"
+
+/* Default size as a fraction of the bounding box diagonal */
+#define DEFAULT_SIZE_FRACTION 0.2
+
+/* Below this many constraints a linear scan beats building a hierarchy */
+#define BVH_MIN_CONSTRAINTS 8
+
+/* Constraint with its derived quantities computed once */
+typedef struct {
+    int kind;
+    double size;
+    double a[3];     /* ball center, box min, cylinder p1 */
+    double b[3];     /* box max, cylinder axis (p2 - p1) */
+    double r2;       /* squared radius */
+    double len2;     /* squared cylinder axis length */
+} Constraint;
+
+/* Unpack and validate constraints, returns NULL on failure */
+static Constraint* prepare(const double* packed, int count) {
+    Constraint* prepared = (Constraint*)malloc(
+        (count > 0 ? (size_t)count : 1) * sizeof(Constraint));
+    if (!prepared) {
+        return NULL;
+    }
+
+    for (int i = 0; i < count; i++) {
+        const double* p = packed + (size_t)i * MMGWASM_SIZING_STRIDE;
+        Constraint* c = &prepared[i];
+        c->kind = (int)p[0];
+        c->size = p[1];
+        if (!(c->size > 0.0) || !isfinite(c->size)) {
+            free(prepared);
+            return NULL;
+        }
+
+        for (int d = 0; d < 3; d++) {
+            c->a[d] = p[2 + d];
+        }
+        switch (c->kind) {
+        case MMGWASM_SIZING_BALL:
+            c->r2 = p[5] * p[5];
+            break;
+        case MMGWASM_SIZING_BOX:
+            for (int d = 0; d < 3; d++) {
+                c->b[d] = p[5 + d];
+            }
+            break;
+        case MMGWASM_SIZING_CYLINDER:
+            c->len2 = 0.0;
+            for (int d = 0; d < 3; d++) {
+                c->b[d] = p[5 + d] - p[2 + d];
+                c->len2 += c->b[d] * c->b[d];
+            }
+            c->r2 = p[8] * p[8];
+            if (c->len2 == 0.0) {
+                free(prepared);
+                return NULL;
+            }
+            break;
+        default:
+            free(prepared);
+            return NULL;
+        }
+    }
+    return prepared;
+}
+
+/* Check whether point x (dim coordinates) lies in a constraint region */
+static int contains(const Constraint* c, const double* x, int dim) {
+    switch (c->kind) {
+    case MMGWASM_SIZING_BALL: {
+        double dist2 = 0.0;
+        for (int d = 0; d < dim; d++) {
+            double dx = x[d] - c->a[d];
+            dist2 += dx * dx;
+        }
+        return dist2 <= c->r2;
+    }
+    case MMGWASM_SIZING_BOX:
+        for (int d = 0; d < dim; d++) {
+            if (x[d] < c->a[d] || x[d] > c->b[d]) {
+                return 0;
+            }
+        }
+        return 1;
+    case MMGWASM_SIZING_CYLINDER: {
+        /* Distance to the axis segment (the end caps are rounded) */
+        double t = 0.0;
+        for (int d = 0; d < 3; d++) {
+            t += (x[d] - c->a[d]) * c->b[d];
+        }
+        t /= c->len2;
+        t = t < 0.0 ? 0.0 : (t > 1.0 ? 1.0 : t);
+
+        double dist2 = 0.0;
+        for (int d = 0; d < 3; d++) {
+            double dx = x[d] - (c->a[d] + t * c->b[d]);
+            dist2 += dx * dx;
+        }
+        return dist2 <= c->r2;
+    }
+    default:
+        return 0;
+    }
+}
+
+/* Bounding box of a constraint region (min xyz, max xyz) */
+static void region_bounds(const Constraint* c, int dim, double* box) {
+    for (int d = 0; d < 3; d++) {
+        double lo, hi;
+        switch (c->kind) {
+        case MMGWASM_SIZING_BALL: {
+            double r = sqrt(c->r2);
+            lo = c->a[d] - r;
+            hi = c->a[d] + r;
+            break;
+        }
+        case MMGWASM_SIZING_BOX:
+            lo = c->a[d];
+            hi = c->b[d];
+            break;
+        default: {  /* cylinder */
+            double r = sqrt(c->r2);
+            double end = c->a[d] + c->b[d];
+            lo = (c->a[d] < end ? c->a[d] : end) - r;
+            hi = (c->a[d] > end ? c->a[d] : end) + r;
+            break;
+        }
+        }
+        /* Points of 2D meshes are looked up with z = 0 */
+        box[d] = d < dim ? lo : 0.0;
+        box[3 + d] = d < dim ? hi : 0.0;
+    }
+}
+
+/* Constraints indexed by their bounds, with the smallest size under each node */
+typedef struct {
+    MmgwasmBvh bvh;
+    double* node_size;
+} Index;
+
+static int build_index(Index* index, const Constraint* constraints,
+                       int count, int dim) {
+    double* boxes = (double*)malloc((size_t)count * 6 * sizeof(double));
+    if (!boxes) {
+        return 0;
+    }
+    for (int i = 0; i < count; i++) {
+        region_bounds(&constraints[i], dim, boxes + (size_t)i * 6);
+    }
+    int ok = mmgwasm_bvh_build(&index->bvh, boxes, count);
+    free(boxes);
+    if (!ok) {
+        return 0;
+    }
+
+    index->node_size = (double*)malloc((size_t)index->bvh.nnodes * sizeof(double));
+    if (!index->node_size) {
+        mmgwasm_bvh_free(&index->bvh);
+        return 0;
+    }
+    /* Children follow their parent, so a backward sweep sees them first */
+    for (int n = index->bvh.nnodes - 1; n >= 0; n--) {
+        const MmgwasmBvhNode* node = &index->bvh.nodes[n];
+        double h = HUGE_VAL;
+        if (node->count > 0) {
+            for (int i = 0; i < node->count; i++) {
+                double size = constraints[index->bvh.order[node->first + i]].size;
+                if (size < h) h = size;
+            }
+        } else {
+            double left = index->node_size[n + 1];
+            double right = index->node_size[node->first];
+            h = left < right ? left : right;
+        }
+        index->node_size[n] = h;
+    }
+    return 1;
+}
+
+/*
+ * Smallest size of the constraints containing x, visiting only the nodes
+ * whose bounds contain it and that could still lower the size
+ */
+static double query_index(const Index* index, const Constraint* constraints,
+                          const double* x, int dim) {
+    double p[3] = {x[0], x[1], dim == 3 ? x[2] : 0.0};
+    double h = HUGE_VAL;
+    int stack[MMGWASM_BVH_MAX_DEPTH];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        int n = stack[--top];
+        const MmgwasmBvhNode* node = &index->bvh.nodes[n];
+        if (index->node_size[n] >= h || !mmgwasm_bvh_node_contains(node, p)) {
+            continue;
+        }
+        if (node->count > 0) {
+            for (int i = 0; i < node->count; i++) {
+                const Constraint* c = &constraints[index->bvh.order[node->first + i]];
+                if (c->size < h && contains(c, x, dim)) {
+                    h = c->size;
+                }
+            }
+        } else {
+            stack[top++] = node->first;
+            stack[top++] = n + 1;
+        }
+    }
+    return h;
+}
+
+/* Prepared constraints, indexed by their bounds when there are many */
+typedef struct {
+    Constraint* constraints;
+    int count;
+    int indexed;
+    Index index;
+} Regions;
+
+/* Grow a constraint region by margin in every direction */
+static void grow(Constraint* c, double margin) {
+    switch (c->kind) {
+    case MMGWASM_SIZING_BOX:
+        for (int d = 0; d < 3; d++) {
+            c->a[d] -= margin;
+            c->b[d] += margin;
+        }
+        break;
+    default: {  /* ball, cylinder */
+        double r = sqrt(c->r2) + margin;
+        c->r2 = r * r;
+        break;
+    }
+    }
+}
+
+/*
+ * Validate and prepare count packed constraints, grown by margin.
+ * Returns 1 on success, 0 on an invalid constraint or allocation failure.
+ */
+static int open_regions(Regions* regions, const double* constraints,
+                        int count, int dim, double margin) {
+    if (count < 0 || (count > 0 && !constraints) || (dim != 2 && dim != 3)) {
+        return 0;
+    }
+    /* Cylinders are 3D regions */
+    for (int i = 0; i < count; i++) {
+        if (dim == 2 &&
+            (int)constraints[(size_t)i * MMGWASM_SIZING_STRIDE] ==
+                MMGWASM_SIZING_CYLINDER) {
+            return 0;
+        }
+    }
+
+    regions->constraints = prepare(constraints, count);
+    if (!regions->constraints) {
+        return 0;
+    }
+    for (int i = 0; margin > 0.0 && i < count; i++) {
+        grow(&regions->constraints[i], margin);
+    }
+    regions->count = count;
+    regions->index = (Index){{0}, NULL};
+    regions->indexed = count >= BVH_MIN_CONSTRAINTS;
+    if (regions->indexed &&
+        !build_index(&regions->index, regions->constraints, count, dim)) {
+        free(regions->constraints);
+        return 0;
+    }
+    return 1;
+}
+
+static void close_regions(Regions* regions) {
+    if (regions->indexed) {
+        mmgwasm_bvh_free(&regions->index.bvh);
+        free(regions->index.node_size);
+    }
+    free(regions->constraints);
+}
+
+/*
+ * Smallest size of the regions containing x, HUGE_VAL outside all of them.
+ * Many constraints are looked up through a hierarchy of their bounds, so a
+ * point only tests the few regions around it.
+ */
+static double region_size(const Regions* regions, const double* x, int dim) {
+    if (regions->indexed) {
+        return query_index(&regions->index, regions->constraints, x, dim);
+    }
+    double h = HUGE_VAL;
+    for (int k = 0; k < regions->count; k++) {
+        const Constraint* c = &regions->constraints[k];
+        if (c->size < h && contains(c, x, dim)) {
+            h = c->size;
+        }
+    }
+    return h;
+}
+
+int mmgwasm_sizing_apply(const double* constraints, int count, int dim,
+                         const double* coords, size_t stride, int np,
+                         double* out) {
+    Regions regions;
+    if (np < 0 || (np > 0 && (!coords || !out)) ||
+        !open_regions(&regions, constraints, count, dim, 0.0)) {
+        return 0;
+    }
+
+    /* Single pass: size of every vertex, and the bounding box on the way */
+    double min[3] = {HUGE_VAL, HUGE_VAL, HUGE_VAL};
+    double max[3] = {-HUGE_VAL, -HUGE_VAL, -HUGE_VAL};
+    int unconstrained = 0;
+    const char* point = (const char*)coords;
+    for (int i = 0; i < np; i++, point += stride) {
+        const double* x = (const double*)point;
+        for (int d = 0; d < dim; d++) {
+            if (x[d] < min[d]) min[d] = x[d];
+            if (x[d] > max[d]) max[d] = x[d];
+        }
+
+        double h = region_size(&regions, x, dim);
+        out[i] = h;
+        unconstrained |= h == HUGE_VAL;
+    }
+    close_regions(&regions);
+
+    if (unconstrained) {
+        double diag2 = 0.0;
+        for (int d = 0; d < dim; d++) {
+            double extent = max[d] - min[d];
+            diag2 += extent * extent;
+        }
+        double fallback = diag2 > 0.0
+            ? sqrt(diag2) * DEFAULT_SIZE_FRACTION : 1.0;
+        for (int i = 0; i < np; i++) {
+            if (out[i] == HUGE_VAL) {
+                out[i] = fallback;
+            }
+        }
+    }
+    return 1;
+}
+
+int mmgwasm_sizing_contains(const double* constraints, int count, int dim,
+                            const double* coords, size_t stride, int np,
+                            double margin, unsigned char* out) {
+    Regions regions;
+    if (np < 0 || (np > 0 && (!coords || !out)) || !(margin >= 0.0) ||
+        !open_regions(&regions, constraints, count, dim, margin)) {
+        return 0;
+    }
+
+    const char* point = (const char*)coords;
+    for (int i = 0; i < np; i++, point += stride) {
+        out[i] = region_size(&regions, (const double*)point, dim) < HUGE_VAL;
+    }
+    close_regions(&regions);
+    return 1;
+}
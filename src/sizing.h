@@ -0,0 +1,57 @@
+/**
+ * Native evaluation of local sizing constraints
+ *
+ * JavaScript describes refinement regions (balls, boxes, cylinders) as a
+ * packed array of doubles, MMGWASM_SIZING_STRIDE per constraint:
+ *
+ *   [kind, size, p0, p1, p2, p3, p4, p5, p6]
+ *
+ *   MMGWASM_SIZING_BALL      center (p0..p2), radius (p3)
+ *   MMGWASM_SIZING_BOX       min corner (p0..p2), max corner (p3..p5)
+ *   MMGWASM_SIZING_CYLINDER  axis end points (p0..p2, p3..p5), radius (p6)
+ *
+ * Unused parameters are ignored, and so are z coordinates in 2D (a 2D ball
+ * is a circle). The mmgX_apply_sizing wrappers evaluate every constraint in
+ * a single pass over the mesh vertices and write the minimum size straight
+ * into the scalar metric. The same regions also select the part of a mesh
+ * that a local remesh reworks (mmgX_freeze_outside).
+ */
+
+#ifndef MMGWASM_SIZING_H
+#define MMGWASM_SIZING_H
+
+#include <stddef.h>
+
+/* Doubles per packed constraint */
+#define MMGWASM_SIZING_STRIDE 9
+
+/* Constraint kinds, the first double of a packed constraint */
+enum {
+    MMGWASM_SIZING_BALL = 1,
+    MMGWASM_SIZING_BOX = 2,
+    MMGWASM_SIZING_CYLINDER = 3
+};
+
+/*
+ * Evaluate count packed constraints at np points of dimension dim (2 or 3).
+ * coords points at the coordinates of the first point, and consecutive points
+ * are stride bytes apart (so MMG5_Point arrays can be read in place).
+ * out[i] receives the smallest size of the constraints containing point i,
+ * or a fifth of the bounding box diagonal when none does.
+ * Returns 1 on success, 0 on an invalid constraint or allocation failure.
+ */
+int mmgwasm_sizing_apply(const double* constraints, int count, int dim,
+                         const double* coords, size_t stride, int np,
+                         double* out);
+
+/*
+ * Flag which of np points (read as in mmgwasm_sizing_apply) lie inside at
+ * least one of count packed constraints, each grown by margin (>= 0) in
+ * every direction. out[i] receives 1 inside, 0 outside.
+ * Returns 1 on success, 0 on an invalid constraint or allocation failure.
+ */
+int mmgwasm_sizing_contains(const double* constraints, int count, int dim,
+                            const double* coords, size_t stride, int np,
+                            double margin, unsigned char* out);
+
+#endif /* MMGWASM_SIZING_H */
@@ -11,12 +11,28 @@ export type Vec2 = [number, number];
 /** 3D point/vector */
 export type Vec3 = [number, number, number];
 
+/** Numbers per packed constraint (MMGWASM_SIZING_STRIDE in src/sizing.h) */
+export const SIZING_STRIDE = 9;
+
+/** Kinds of packed constraints, the first number of each */
+export const SIZING_KIND = {
+  BALL: 1,
+  BOX: 2,
+  CYLINDER: 3,
+} as const;
+
 /**
  * Interface for local sizing constraints
  */
 export interface LocalSizingConstraint {
   /** Compute target sizes for all vertices */
   compute(vertices: Float64Array, dimension: 2 | 3): Float64Array;
+
+  /**
+   * Pack the constraint for native evaluation:
+   * `[kind, size, ...parameters]`, SIZING_STRIDE numbers (see src/sizing.h)
+   */
+  encode(dimension: 2 | 3): number[];
 }
 
 /**
@@ -47,6 +63,13 @@ export class SphereSizingConstraint implements LocalSizingConstraint {
     }
   }
 
+  encode(dimension: 2 | 3): number[] {
+    if (dimension !== 3) {
+      throw new Error("SphereSizingConstraint only works with 3D meshes");
+    }
+    return [SIZING_KIND.BALL, this.size, ...this.center, this.radius, 0, 0, 0];
+  }
+
   compute(vertices: Float64Array, dimension: 2 | 3): Float64Array {
     if (dimension !== 3) {
       throw new Error("SphereSizingConstraint only works with 3D meshes");
@@ -106,6 +129,14 @@ export class CircleSizingConstraint implements LocalSizingConstraint {
     }
   }
 
+  encode(dimension: 2 | 3): number[] {
+    if (dimension !== 2) {
+      throw new Error("CircleSizingConstraint only works with 2D meshes");
+    }
+    const [cx, cy] = this.center;
+    return [SIZING_KIND.BALL, this.size, cx, cy, 0, this.radius, 0, 0, 0];
+  }
+
   compute(vertices: Float64Array, dimension: 2 | 3): Float64Array {
     if (dimension !== 2) {
       throw new Error("CircleSizingConstraint only works with 2D meshes");
@@ -174,6 +205,23 @@ export class BoxSizingConstraint implements LocalSizingConstraint {
     this.maxCoords = Array.from(max);
   }
 
+  encode(dimension: 2 | 3): number[] {
+    if (dimension !== this.expectedDim) {
+      throw new Error(
+        `${this.expectedDim}D BoxSizingConstraint cannot be used with ${dimension}D meshes`,
+      );
+    }
+    const pad = (coords: number[]) =>
+      coords.length === 3 ? coords : [...coords, 0];
+    return [
+      SIZING_KIND.BOX,
+      this.size,
+      ...pad(this.minCoords),
+      ...pad(this.maxCoords),
+      0,
+    ];
+  }
+
   compute(vertices: Float64Array, dimension: 2 | 3): Float64Array {
     if (dimension !== this.expectedDim) {
       throw new Error(
@@ -260,6 +308,19 @@ export class CylinderSizingConstraint implements LocalSizingConstraint {
     }
   }
 
+  encode(dimension: 2 | 3): number[] {
+    if (dimension !== 3) {
+      throw new Error("CylinderSizingConstraint only works with 3D meshes");
+    }
+    return [
+      SIZING_KIND.CYLINDER,
+      this.size,
+      ...this.p1,
+      ...this.p2,
+      this.radius,
+    ];
+  }
+
   compute(vertices: Float64Array, dimension: 2 | 3): Float64Array {
     if (dimension !== 3) {
       throw new Error("CylinderSizingConstraint only works with 3D meshes");
@@ -314,8 +375,30 @@ export class CylinderSizingConstraint implements LocalSizingConstraint {
   }
 }
 
+/**
+ * Pack constraints for native evaluation (the `applySizing` module functions)
+ *
+ * @param constraints - Constraints to pack
+ * @param dimension - Dimension of the mesh they apply to
+ * @returns SIZING_STRIDE numbers per constraint
+ * @throws Error if a constraint does not apply to this dimension
+ */
+export function encodeSizingConstraints(
+  constraints: LocalSizingConstraint[],
+  dimension: 2 | 3,
+): Float64Array {
+  const packed = new Float64Array(constraints.length * SIZING_STRIDE);
+  constraints.forEach((constraint, i) => {
+    packed.set(constraint.encode(dimension), i * SIZING_STRIDE);
+  });
+  return packed;
+}
+
 /**
  * Combine multiple sizing constraints by taking the minimum size at each vertex
+ *
+ * This evaluates the constraints in JS on a copy of the vertices; remeshing
+ * evaluates them natively instead (see encodeSizingConstraints).
  */
 export function combineSizingConstraints(
   constraints: LocalSizingConstraint[],
@@ -0,0 +1,242 @@
+/**
+ * Remesh instrumentation (see stats.h)
+ */
+
+#include <emscripten.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "stats.h"
+
+/* Verbosity at which MMG reports every wavefront */
+#define WAVEFRONT_IMPRIM 5
+
+/* Remesh being recorded on the current thread */
+static _Thread_local struct {
+    MmgwasmStats* stats;        /* NULL when the output hook is not armed */
+    int* imprim;
+    int saved_imprim;
+    int quiet;                  /* 1 to drop output the caller did not ask for */
+    int quiet_wavefronts;       /* 1 to drop only the wavefront lines */
+} t_run;
+
+void mmgwasm_stats_begin(MmgwasmStats* stats, int* imprim) {
+    memset(stats, 0, sizeof(*stats));
+    stats->start = emscripten_get_now();
+
+    /*
+     * Below verbosity 1 MMG prints nothing at all: raise it and drop the
+     * extra output. A caller that asked for output keeps exactly that, with
+     * the wavefront lines it did not ask for dropped.
+     */
+    t_run.stats = stats;
+    t_run.imprim = imprim;
+    t_run.saved_imprim = *imprim;
+    t_run.quiet = *imprim < 1;
+    t_run.quiet_wavefronts = !t_run.quiet && *imprim < WAVEFRONT_IMPRIM;
+    if (*imprim < WAVEFRONT_IMPRIM) {
+        *imprim = WAVEFRONT_IMPRIM;
+    }
+}
+
+void mmgwasm_stats_end(MmgwasmStats* stats) {
+    mmgwasm_stats_phase(stats, 0);
+    stats->total_ms = emscripten_get_now() - stats->start;
+
+    if (t_run.stats == stats) {
+        *t_run.imprim = t_run.saved_imprim;
+        memset(&t_run, 0, sizeof(t_run));
+    }
+}
+
+void mmgwasm_stats_phase(MmgwasmStats* stats, int phase) {
+    double now = emscripten_get_now();
+    double elapsed = now - stats->phase_start;
+    switch (stats->phase) {
+        case 1:
+            stats->analysis_ms += elapsed;
+            break;
+        case 2:
+            stats->meshing_ms += elapsed;
+            break;
+        case 3:
+            stats->output_ms += elapsed;
+            break;
+    }
+    stats->phase = phase;
+    stats->phase_start = now;
+}
+
+#ifdef MMGWASM_STATS
+
+int __real_fputs(const char* s, FILE* stream);
+int __real_puts(const char* s);
+size_t __real_fwrite(const void* ptr, size_t size, size_t nmemb, FILE* stream);
+
+/* Counter of a wavefront line word: "   123 splitted," adds 123 to splits */
+static int32_t* counter(MmgwasmStats* stats, const char* word, size_t len) {
+    static const struct {
+        const char* word;
+        size_t offset;
+    } COUNTERS[] = {
+        {"splitted", offsetof(MmgwasmStats, splits)},
+        {"inserted", offsetof(MmgwasmStats, splits)},
+        {"collapsed", offsetof(MmgwasmStats, collapses)},
+        {"swapped", offsetof(MmgwasmStats, swaps)},
+        {"moved", offsetof(MmgwasmStats, moves)},
+    };
+    for (size_t i = 0; i < sizeof(COUNTERS) / sizeof(COUNTERS[0]); i++) {
+        size_t n = strlen(COUNTERS[i].word);
+        if (len >= n && memcmp(word, COUNTERS[i].word, n) == 0) {
+            return (int32_t*)((char*)stats + COUNTERS[i].offset);
+        }
+    }
+    return NULL;
+}
+
+static int is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+/* Add up the operation counts of a wavefront line of len bytes */
+static void add_wavefront(MmgwasmStats* stats, const char* text, size_t len) {
+    stats->wavefronts++;
+
+    /* Every count is right-aligned before the word naming its operator */
+    size_t i = 0;
+    while (i < len) {
+        if (!is_digit(text[i])) {
+            i++;
+            continue;
+        }
+        int32_t value = 0;
+        while (i < len && is_digit(text[i])) {
+            value = value * 10 + (text[i++] - '0');
+        }
+        while (i < len && text[i] == ' ') {
+            i++;
+        }
+        int32_t* count = counter(stats, text + i, len - i);
+        if (count) {
+            *count += value;
+        }
+    }
+}
+
+/* Check whether the len bytes at text contain needle */
+static int contains(const char* text, size_t len, const char* needle) {
+    size_t n = strlen(needle);
+    for (size_t i = 0; i + n <= len; i++) {
+        if (memcmp(text + i, needle, n) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Inspect text written by the library while the hook is armed, counting the
+ * operations of the wavefront lines of the meshing phase.
+ * Returns 1 if the text should be written, 0 to drop it.
+ */
+static int on_output(FILE* stream, const char* text, size_t len) {
+    MmgwasmStats* stats = t_run.stats;
+    if (!stats || (stream != stdout && stream != stderr)) {
+        return 1;
+    }
+
+    int wavefront = stream == stdout && stats->phase == 2 &&
+                    contains(text, len, " iter");
+    if (wavefront) {
+        add_wavefront(stats, text, len);
+        if (t_run.quiet_wavefronts) {
+            return 0;
+        }
+    }
+    /* Errors are printed at any verbosity, keep them */
+    return !t_run.quiet || (stream == stderr && contains(text, len, "## Error"));
+}
+
+/*
+ * stdio hooks, installed with -Wl,--wrap so that they see every call made by
+ * libmmg. The compiler lowers fprintf/printf calls without arguments to
+ * fwrite/fputs/puts, and Emscripten lowers those without floating-point
+ * arguments to __small_fprintf/__small_printf, so all of them are covered.
+ */
+
+static int hooked_vfprintf(FILE* stream, const char* format, va_list args) {
+    if (!t_run.stats) {
+        return vfprintf(stream, format, args);
+    }
+
+    char text[256];
+    va_list copy;
+    va_copy(copy, args);
+    int n = vsnprintf(text, sizeof(text), format, copy);
+    va_end(copy);
+    if (n < 0) {
+        return n;
+    }
+
+    size_t len = (size_t)n < sizeof(text) ? (size_t)n : sizeof(text) - 1;
+    if (!on_output(stream, text, len)) {
+        return n;
+    }
+    return vfprintf(stream, format, args);
+}
+
+int __wrap_fprintf(FILE* stream, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int n = hooked_vfprintf(stream, format, args);
+    va_end(args);
+    return n;
+}
+
+int __wrap_printf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int n = hooked_vfprintf(stdout, format, args);
+    va_end(args);
+    return n;
+}
+
+int __wrap___small_fprintf(FILE* stream, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int n = hooked_vfprintf(stream, format, args);
+    va_end(args);
+    return n;
+}
+
+int __wrap___small_printf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int n = hooked_vfprintf(stdout, format, args);
+    va_end(args);
+    return n;
+}
+
+size_t __wrap_fwrite(const void* ptr, size_t size, size_t nmemb, FILE* stream) {
+    if (t_run.stats && !on_output(stream, (const char*)ptr, size * nmemb)) {
+        return nmemb;
+    }
+    return __real_fwrite(ptr, size, nmemb, stream);
+}
+
+int __wrap_fputs(const char* s, FILE* stream) {
+    if (t_run.stats && !on_output(stream, s, strlen(s))) {
+        return 0;
+    }
+    return __real_fputs(s, stream);
+}
+
+int __wrap_puts(const char* s) {
+    if (t_run.stats && !on_output(stdout, s, strlen(s))) {
+        return 0;
+    }
+    return __real_puts(s);
+}
+
+#endif /* MMGWASM_STATS */
@@ -0,0 +1,64 @@
+/**
+ * Remesh instrumentation
+ *
+ * "MMG took 12 s" is all a production remesh tells: MMG has no profiling API.
+ * The instrumentation build (MMG_WASM_STATS, see cmake/EmscriptenConfig.cmake)
+ * arms the phase hooks of progress.h on every remesh to time MMG's phases,
+ * and routes MMG's stdio calls through an output hook (linked with
+ * -Wl,--wrap in that build only) that adds up the operation counts of its
+ * wavefront lines into a per-handle MmgwasmStats record, read with
+ * mmgX_get_stats. The lines are only printed at verbosity 5, so the hook
+ * raises MMG's verbosity for the remesh and drops the output the caller did
+ * not ask for.
+ *
+ * MMG interleaves its operators inside every wavefront, so splits, collapses,
+ * swaps and moves are counted one by one but timed together as the meshing
+ * phase.
+ *
+ * In other builds the record is never armed, no stdio call is hooked and
+ * mmgX_get_stats reports the record as unavailable.
+ */
+
+#ifndef MMGWASM_STATS_H
+#define MMGWASM_STATS_H
+
+#include <stdint.h>
+
+#ifdef MMGWASM_STATS
+#define MMGWASM_STATS_ENABLED 1
+#else
+#define MMGWASM_STATS_ENABLED 0
+#endif
+
+/*
+ * Statistics of the last remesh of a handle, read from JavaScript as four
+ * doubles followed by five ints; the fields after those are internal
+ */
+typedef struct {
+    double analysis_ms;    /* MMG phase 1: analysis */
+    double meshing_ms;     /* MMG phase 2: split/collapse/swap/move */
+    double output_ms;      /* MMG phase 3: packing the mesh */
+    double total_ms;       /* whole MMG call, phases included */
+    int32_t splits;        /* edges split (points inserted) */
+    int32_t collapses;     /* edges collapsed */
+    int32_t swaps;         /* edges or faces swapped */
+    int32_t moves;         /* points relocated */
+    int32_t wavefronts;    /* wavefront lines reported by MMG */
+    int32_t phase;         /* MMG phase being timed, 0 outside MMG */
+    double start;          /* start of the remesh (emscripten_get_now) */
+    double phase_start;    /* start of the phase being timed */
+} MmgwasmStats;
+
+/*
+ * Clear a record and start recording a remesh running on the current thread.
+ * imprim points at the mesh verbosity, raised until mmgwasm_stats_end.
+ */
+void mmgwasm_stats_begin(MmgwasmStats* stats, int* imprim);
+
+/* Close the phase being timed and the remesh, restoring the verbosity */
+void mmgwasm_stats_end(MmgwasmStats* stats);
+
+/* Record the start (1, 2 or 3) of an MMG phase, closing the previous one */
+void mmgwasm_stats_phase(MmgwasmStats* stats, int phase);
+
+#endif /* MMGWASM_STATS_H */
@@ -0,0 +1,79 @@
+/**
+ * Remesh instrumentation
+ *
+ * The instrumentation build (MMG_WASM_STATS) records the phase timings and
+ * operation counts of every remesh in a per-handle record (src/stats.h), read
+ * back after the remesh with the getStats function of each module. Remesh
+ * steps and MMG phases can also be emitted as performance.measure spans (see
+ * RemeshControl.trace) so they show up in browser traces.
+ */
+
+import type { WasmModule } from "./memory";
+import type { RemeshStats, RemeshTimings } from "./result";
+
+/** Bytes of MmgwasmStats, internal fields included */
+export const STATS_BYTES = 72;
+
+/**
+ * Decode an MmgwasmStats record
+ *
+ * @internal Used by the getStats function of each module.
+ * @param module - The WASM module
+ * @param ptr - 8-byte aligned record filled by mmgX_get_stats
+ * @returns Phase timings and operation counts
+ */
+export function readRemeshStats(module: WasmModule, ptr: number): RemeshStats {
+  const doubles = ptr / 8;
+  const ints = (ptr + 32) / 4;
+  return {
+    phases: {
+      analysis: module.HEAPF64[doubles],
+      meshing: module.HEAPF64[doubles + 1],
+      output: module.HEAPF64[doubles + 2],
+      total: module.HEAPF64[doubles + 3],
+    },
+    splits: module.HEAP32[ints],
+    collapses: module.HEAP32[ints + 1],
+    swaps: module.HEAP32[ints + 2],
+    moves: module.HEAP32[ints + 3],
+    wavefronts: module.HEAP32[ints + 4],
+  };
+}
+
+/**
+ * Emit the span of one remesh step as `${trace}:${step}`
+ *
+ * @internal Used by Mesh.remesh.
+ */
+export function measureStep(
+  trace: string,
+  step: keyof RemeshTimings,
+  start: number,
+  end: number,
+): void {
+  performance.measure(`${trace}:${step}`, { start, end });
+}
+
+/**
+ * Emit the MMG phases of a remesh as `${trace}:mmg:${phase}` spans
+ *
+ * Phases are only timed by duration, so they are laid end to end, finishing
+ * when MMG returned.
+ *
+ * @internal Used by Mesh.remesh.
+ * @param trace - Span name prefix
+ * @param stats - Statistics of the remesh
+ * @param end - performance.now() once MMG returned
+ */
+export function measurePhases(
+  trace: string,
+  stats: RemeshStats,
+  end: number,
+): void {
+  let start = end - stats.phases.total;
+  for (const phase of ["analysis", "meshing", "output"] as const) {
+    const duration = stats.phases[phase];
+    performance.measure(`${trace}:mmg:${phase}`, { start, duration });
+    start += duration;
+  }
+}
@@ -11,6 +11,14 @@ const char* mmgwasm_version(void) {
     return "0.0.1";
 }
 
+/* Size of pointers in this build: 4 (wasm32) or 8 (memory64) */
+EMSCRIPTEN_KEEPALIVE
+int mmgwasm_pointer_size(void) {
+    return (int)sizeof(void*);
+}
+
+/* The 2D and surface modules don't link MMG3D (MMG_WASM_SPLIT_MODULES) */
+#ifndef MMGWASM_NO_MMG3D
 EMSCRIPTEN_KEEPALIVE
 int mmg_test_init(void) {
     MMG5_pMesh mesh = NULL;
@@ -36,3 +44,5 @@ int mmg_test_init(void) {
 
     return 1;
 }
+
+#endif /* MMGWASM_NO_MMG3D */
@@ -0,0 +1,216 @@
+/**
+ * Native display surface of tetrahedral meshes (see surface.h)
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "partition.h"
+#include "surface.h"
+
+/* Vertices of face i (opposite vertex i), outward for positive tetrahedra */
+static const int FACE_VERTICES[4][3] = {
+    {1, 2, 3}, {0, 3, 2}, {0, 1, 3}, {0, 2, 1}
+};
+
+/* Bytes of the header: nv and nt */
+#define HEADER_BYTES (2 * sizeof(int32_t))
+
+/* Coordinates of a 1-based vertex */
+static const double* vertex(const MmgwasmElements* e, int v) {
+    return (const double*)((const char*)e->coords +
+                           (size_t)(v - 1) * e->coord_stride);
+}
+
+/* Vertex indices of a 0-based tetrahedron */
+static const int* tetrahedron(const MmgwasmElements* e, int k) {
+    return (const int*)((const char*)e->elems + (size_t)k * e->elem_stride);
+}
+
+/* Vertices of face code (4 * tetrahedron + face) */
+static void face_vertices(const MmgwasmElements* e, int code, int* f) {
+    const int* v = tetrahedron(e, code / 4);
+    for (int j = 0; j < 3; j++) {
+        f[j] = v[FACE_VERTICES[code % 4][j]];
+    }
+}
+
+static void cross(const double* u, const double* v, double* w) {
+    w[0] = u[1] * v[2] - u[2] * v[1];
+    w[1] = u[2] * v[0] - u[0] * v[2];
+    w[2] = u[0] * v[1] - u[1] * v[0];
+}
+
+/*
+ * Vertices of face code in an order whose normal points away from the
+ * opposite vertex, whatever the orientation of the tetrahedron, and the
+ * (area-weighted) normal itself
+ */
+static void oriented_face(const MmgwasmElements* e, int code, int* f,
+                          double* normal) {
+    face_vertices(e, code, f);
+    const double* a = vertex(e, f[0]);
+    const double* b = vertex(e, f[1]);
+    const double* c = vertex(e, f[2]);
+    const double* opposite = vertex(e, tetrahedron(e, code / 4)[code % 4]);
+
+    double u[3], v[3], w[3];
+    for (int d = 0; d < 3; d++) {
+        u[d] = b[d] - a[d];
+        v[d] = c[d] - a[d];
+        w[d] = opposite[d] - a[d];
+    }
+    cross(u, v, normal);
+    if (normal[0] * w[0] + normal[1] * w[1] + normal[2] * w[2] > 0.0) {
+        int t = f[1];
+        f[1] = f[2];
+        f[2] = t;
+        for (int d = 0; d < 3; d++) {
+            normal[d] = -normal[d];
+        }
+    }
+}
+
+/* Whether a tetrahedron is displayed: centroid on the kept side of plane */
+static int kept(const MmgwasmElements* e, int k, const double* plane) {
+    if (!plane) {
+        return 1;
+    }
+    const int* v = tetrahedron(e, k);
+    double side = 0.0;
+    for (int j = 0; j < 4; j++) {
+        const double* x = vertex(e, v[j]);
+        side += x[0] * plane[0] + x[1] * plane[1] + x[2] * plane[2];
+    }
+    return side * 0.25 <= plane[3];
+}
+
+/* Whether face code is shown: kept, and not shared with a kept tetrahedron */
+static int shown(const int* adjacency, const unsigned char* keep, int code) {
+    int other = adjacency[code];
+    return keep[code / 4] && (other < 0 || !keep[other]);
+}
+
+/*
+ * Faces of the displayed tetrahedra of e that no other displayed tetrahedron
+ * shares, written to surface. adjacency (4 * ne ints, see
+ * mmgwasm_match_faces), map (np + 1 ints) and keep (ne flags) are scratch
+ * memory.
+ */
+static const void* extract(MmgwasmSurface* surface, const MmgwasmElements* e,
+                           int np, int ne, const double* plane,
+                           const int* adjacency, int* map,
+                           unsigned char* keep) {
+    int nf = 4 * ne;
+    for (int k = 0; k < ne; k++) {
+        keep[k] = (unsigned char)kept(e, k, plane);
+    }
+
+    /* Compact the vertices of the remaining faces, in order of first use */
+    for (int v = 0; v <= np; v++) {
+        map[v] = -1;
+    }
+    int nt = 0;
+    int nv = 0;
+    for (int i = 0; i < nf; i++) {
+        if (!shown(adjacency, keep, i)) {
+            continue;
+        }
+        int f[3];
+        face_vertices(e, i, f);
+        for (int j = 0; j < 3; j++) {
+            if (map[f[j]] < 0) {
+                map[f[j]] = nv++;
+            }
+        }
+        nt++;
+    }
+
+    size_t bytes = HEADER_BYTES + (size_t)nv * 6 * sizeof(float) +
+                   (size_t)nt * 4 * sizeof(int32_t);
+    if (bytes > surface->capacity) {
+        void* data = realloc(surface->data, bytes);
+        if (!data) {
+            return NULL;
+        }
+        surface->data = data;
+        surface->capacity = bytes;
+    }
+
+    int32_t* header = (int32_t*)surface->data;
+    float* positions = (float*)(header + 2);
+    float* normals = positions + (size_t)nv * 3;
+    uint32_t* indices = (uint32_t*)(normals + (size_t)nv * 3);
+    int32_t* cells = (int32_t*)(indices + (size_t)nt * 3);
+    header[0] = nv;
+    header[1] = nt;
+
+    for (int v = 1; v <= np; v++) {
+        if (map[v] >= 0) {
+            const double* x = vertex(e, v);
+            for (int d = 0; d < 3; d++) {
+                positions[(size_t)map[v] * 3 + d] = (float)x[d];
+                normals[(size_t)map[v] * 3 + d] = 0.0f;
+            }
+        }
+    }
+
+    int t = 0;
+    for (int i = 0; i < nf; i++) {
+        if (!shown(adjacency, keep, i)) {
+            continue;
+        }
+        int f[3];
+        double normal[3];
+        oriented_face(e, i, f, normal);
+        for (int j = 0; j < 3; j++) {
+            size_t at = (size_t)map[f[j]];
+            indices[(size_t)t * 3 + j] = (uint32_t)at;
+            for (int d = 0; d < 3; d++) {
+                normals[at * 3 + d] += (float)normal[d];
+            }
+        }
+        cells[t++] = i / 4;
+    }
+
+    for (int k = 0; k < nv; k++) {
+        float* n = normals + (size_t)k * 3;
+        float length = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        if (length > 0.0f) {
+            n[0] /= length;
+            n[1] /= length;
+            n[2] /= length;
+        }
+    }
+
+    return surface->data;
+}
+
+const void* mmgwasm_surface_extract(MmgwasmSurface* surface,
+                                    const MmgwasmElements* tetrahedra, int np,
+                                    const double* plane) {
+    int ne = tetrahedra->elems ? tetrahedra->nelem : 0;
+    if (np < 0 || ne < 0 || ne > INT32_MAX / 4) {
+        return NULL;
+    }
+
+    int* adjacency = (int*)malloc((ne > 0 ? 4 * (size_t)ne : 1) * sizeof(int));
+    int* map = (int*)malloc(((size_t)np + 1) * sizeof(int));
+    unsigned char* keep = (unsigned char*)malloc(ne > 0 ? (size_t)ne : 1);
+    const void* result = NULL;
+    if (adjacency && map && keep &&
+        mmgwasm_match_faces(tetrahedra, np, NULL, adjacency, NULL)) {
+        result = extract(surface, tetrahedra, np, ne, plane, adjacency, map,
+                         keep);
+    }
+    free(keep);
+    free(map);
+    free(adjacency);
+    return result;
+}
+
+void mmgwasm_surface_free(MmgwasmSurface* surface) {
+    free(surface->data);
+    surface->data = NULL;
+    surface->capacity = 0;
+}
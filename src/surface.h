@@ -0,0 +1,42 @@
+/**
+ * Native display surface of tetrahedral meshes
+ *
+ * Renderers draw triangles, so a volume mesh is shown through the faces of
+ * its tetrahedra that no other displayed tetrahedron shares: the boundary of
+ * the mesh, or with a clipping plane, the boundary of the tetrahedra whose
+ * centroid lies on its negative side (a cut-away view of the interior).
+ * Extraction compacts the vertices used by those faces and computes
+ * area-weighted vertex normals, so the result is ready for a GPU buffer:
+ *
+ *   int32     nv, nt
+ *   float32   positions  nv * 3
+ *   float32   normals    nv * 3
+ *   uint32    indices    nt * 3, 0-based, counter-clockwise seen from outside
+ *   int32     cells      nt 0-based source tetrahedra (for per-face colours)
+ */
+
+#ifndef MMGWASM_SURFACE_H
+#define MMGWASM_SURFACE_H
+
+#include <stddef.h>
+#include "locate.h"
+
+typedef struct {
+    void* data;               /* layout above, NULL until first extraction */
+    size_t capacity;
+} MmgwasmSurface;
+
+/*
+ * Extract the display surface of np vertices and their tetrahedra, replacing
+ * the previous one. plane, if not NULL, holds (nx, ny, nz, d): tetrahedra
+ * are kept when the dot product of their centroid with n is at most d.
+ * Returns the buffer (owned by surface), or NULL on allocation failure.
+ */
+const void* mmgwasm_surface_extract(MmgwasmSurface* surface,
+                                    const MmgwasmElements* tetrahedra, int np,
+                                    const double* plane);
+
+/* Release the memory of a surface and reset it to empty */
+void mmgwasm_surface_free(MmgwasmSurface* surface);
+
+#endif /* MMGWASM_SURFACE_H */
@@ -0,0 +1,56 @@
+/**
+ * Threading helpers shared by the MMG wrappers (see threads.h)
+ */
+
+#include <emscripten.h>
+#include "threads.h"
+
+#ifdef __EMSCRIPTEN_PTHREADS__
+
+static pthread_mutex_t g_gate_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_gate_cond = PTHREAD_COND_INITIALIZER;
+static int g_gate_key = -1;     /* key of the running remeshes, -1 if none */
+static int g_gate_active = 0;   /* number of running remeshes */
+
+void mmgwasm_remesh_enter(int key) {
+    pthread_mutex_lock(&g_gate_mutex);
+    while (g_gate_active > 0 && g_gate_key != key) {
+        pthread_cond_wait(&g_gate_cond, &g_gate_mutex);
+    }
+    g_gate_key = key;
+    g_gate_active++;
+    pthread_mutex_unlock(&g_gate_mutex);
+}
+
+void mmgwasm_remesh_leave(void) {
+    pthread_mutex_lock(&g_gate_mutex);
+    if (--g_gate_active == 0) {
+        g_gate_key = -1;
+        pthread_cond_broadcast(&g_gate_cond);
+    }
+    pthread_mutex_unlock(&g_gate_mutex);
+}
+
+#else
+
+void mmgwasm_remesh_enter(int key) {
+    (void)key;
+}
+
+void mmgwasm_remesh_leave(void) {
+}
+
+#endif
+
+/**
+ * Check whether this build runs remeshes on worker threads.
+ * Returns 1 for the pthreads build, 0 otherwise.
+ */
+EMSCRIPTEN_KEEPALIVE
+int mmgwasm_has_threads(void) {
+#ifdef __EMSCRIPTEN_PTHREADS__
+    return 1;
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,51 @@
+/**
+ * Threading helpers shared by the MMG wrappers
+ *
+ * In the pthreads build (-pthread, __EMSCRIPTEN_PTHREADS__ defined) the handle
+ * tables are protected by mutexes and remeshing can run on worker threads that
+ * share one WASM heap. In the regular single-threaded build every helper
+ * compiles to a no-op, so the wrappers keep a single code path.
+ */
+
+#ifndef MMGWASM_THREADS_H
+#define MMGWASM_THREADS_H
+
+#ifdef __EMSCRIPTEN_PTHREADS__
+#include <pthread.h>
+
+#define MMGWASM_MUTEX(name) static pthread_mutex_t name = PTHREAD_MUTEX_INITIALIZER
+#define MMGWASM_LOCK(name) pthread_mutex_lock(&(name))
+#define MMGWASM_UNLOCK(name) pthread_mutex_unlock(&(name))
+#else
+#define MMGWASM_MUTEX(name) static int name __attribute__((unused))
+#define MMGWASM_LOCK(name) ((void)0)
+#define MMGWASM_UNLOCK(name) ((void)0)
+#endif
+
+/* Value returned by mmgX_remesh_status while a remesh is still running */
+#define MMGWASM_REMESH_RUNNING (-2)
+
+/*
+ * Remesh gate keys.
+ * MMG selects its quality/length kernels through process-wide function
+ * pointers (MMGxx_setfunc), chosen per module and per metric kind. Remeshes
+ * may only overlap when they would install the same pointers, so each run is
+ * tagged with its module and whether its metric is anisotropic.
+ */
+enum {
+    MMGWASM_GATE_3D = 0,
+    MMGWASM_GATE_2D = 2,
+    MMGWASM_GATE_S = 4
+};
+#define MMGWASM_GATE_KEY(module, aniso) ((module) + ((aniso) ? 1 : 0))
+
+/* Wait until a remesh with the given gate key may run, then enter the gate */
+void mmgwasm_remesh_enter(int key);
+
+/* Leave the gate entered with mmgwasm_remesh_enter */
+void mmgwasm_remesh_leave(void);
+
+/* Returns 1 if this build can run remeshes on worker threads, 0 otherwise */
+int mmgwasm_has_threads(void);
+
+#endif /* MMGWASM_THREADS_H */
@@ -25,6 +25,8 @@
 
 import type { BufferAttribute, BufferGeometry } from "three";
 import { Mesh, MeshType } from "../mesh";
+import type { SurfaceClip } from "../mmg3d";
+import type { PackedMesh } from "../packed";
 
 /**
  * Options for converting Three.js BufferGeometry to mmg-wasm Mesh
@@ -166,6 +168,14 @@ export function fromThreeGeometry(
   });
 }
 
+/**
+ * Options for converting the display surface of a 3D mesh
+ */
+export interface ToThreeSurfaceOptions {
+  /** Clipping plane: only tetrahedra on its negative side are shown */
+  clip?: SurfaceClip;
+}
+
 /**
  * Convert an mmg-wasm Mesh to a Three.js BufferGeometry
  *
@@ -337,3 +347,99 @@ export function toThreeGeometrySync(
 
   return geometry;
 }
+
+/**
+ * Convert a packed mesh (see MeshWorker.preview) to a Three.js BufferGeometry
+ *
+ * Packed meshes already hold float32 positions and 0-based indices, so 3D
+ * positions and the index buffer are used as is. Tetrahedral meshes are
+ * displayed through their boundary triangles.
+ *
+ * @param packed - The decoded packed mesh
+ * @param THREE - The Three.js module
+ * @param options - Conversion options
+ * @returns A new Three.js BufferGeometry
+ *
+ * @example
+ * ```typescript
+ * import * as THREE from 'three';
+ * import { packedMeshToThreeGeometry } from 'mmg-wasm/three';
+ *
+ * const preview = await worker.preview(mesh, { hmax: 0.1 });
+ * const geometry = packedMeshToThreeGeometry(preview.mesh, THREE);
+ * ```
+ */
+export function packedMeshToThreeGeometry(
+  packed: PackedMesh,
+  THREE: typeof import("three"),
+  options: ToThreeOptions = {},
+): BufferGeometry {
+  const { computeNormals = true } = options;
+
+  const geometry = new THREE.BufferGeometry();
+
+  // 2D positions get z=0
+  let positions = packed.positions;
+  if (packed.dim === 2) {
+    positions = new Float32Array(packed.nVertices * 3);
+    for (let i = 0; i < packed.nVertices; i++) {
+      positions[i * 3] = packed.positions[i * 2];
+      positions[i * 3 + 1] = packed.positions[i * 2 + 1];
+    }
+  }
+  geometry.setAttribute("position", new THREE.BufferAttribute(positions, 3));
+
+  // Tetrahedra are shown through the boundary triangles
+  const indices = packed.cellSize === 4 ? packed.boundary : packed.cells;
+  geometry.setIndex(new THREE.BufferAttribute(indices, 1));
+
+  if (computeNormals) {
+    geometry.computeVertexNormals();
+  }
+
+  return geometry;
+}
+
+/**
+ * Convert the display surface of a 3D mesh to a Three.js BufferGeometry
+ *
+ * The boundary faces (or a clipping-plane cut), normals and indices are
+ * extracted in WASM (see Mesh.extractSurface), so no per-tetrahedron work is
+ * done in JavaScript. The geometry only holds the surface vertices; use
+ * Mesh.extractSurface for the tetrahedron of each face (e.g. for colours).
+ *
+ * @param mesh - The 3D mmg-wasm Mesh to convert
+ * @param THREE - The Three.js module
+ * @param options - Conversion options
+ * @returns A new Three.js BufferGeometry with position, normal and index
+ * @throws Error if the mesh is not a 3D mesh
+ *
+ * @example
+ * ```typescript
+ * import * as THREE from 'three';
+ * import { toThreeSurfaceGeometry } from 'mmg-wasm/three';
+ *
+ * const geometry = toThreeSurfaceGeometry(mesh, THREE, {
+ *   clip: { normal: [1, 0, 0], offset: 0.5 },
+ * });
+ * ```
+ */
+export function toThreeSurfaceGeometry(
+  mesh: Mesh,
+  THREE: typeof import("three"),
+  options: ToThreeSurfaceOptions = {},
+): BufferGeometry {
+  const surface = mesh.extractSurface(options.clip);
+
+  const geometry = new THREE.BufferGeometry();
+  geometry.setAttribute(
+    "position",
+    new THREE.BufferAttribute(surface.positions, 3),
+  );
+  geometry.setAttribute(
+    "normal",
+    new THREE.BufferAttribute(surface.normals, 3),
+  );
+  geometry.setIndex(new THREE.BufferAttribute(surface.indices, 1));
+  return geometry;
+}
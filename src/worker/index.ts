@@ -4,25 +4,56 @@
  * Provides MeshWorker class and remeshInWorker helper for background remeshing.
  */
 
-import { Mesh, type MeshData } from "../mesh";
+import { getCompiledModule } from "../loader";
+import { Mesh, type MeshData, type MeshType } from "../mesh";
 import type { RemeshOptions } from "../options";
-import type { RemeshResult } from "../result";
+import { type PackOptions, decodePackedMesh } from "../packed";
 import type {
+  BufferRemeshResult,
+  PreviewResult,
+  RemeshResult,
+} from "../result";
+import type { PipelineResult } from "./pipeline";
+import type {
+  PipelineStage,
   ProgressInfo,
+  SerializedBufferResult,
   SerializedMeshData,
+  SerializedPipelineResult,
+  SerializedPreviewResult,
   SerializedRemeshResult,
   WorkerRequestMessage,
   WorkerResponseMessage,
 } from "./types";
 
 // Re-export types
-export type { ProgressInfo } from "./types";
+export type {
+  PipelineStage,
+  PipelineStageReport,
+  ProgressInfo,
+  SizingRegion,
+} from "./types";
+export type { PartitionOptions, PartRemesher } from "./partition";
+export { remeshPartitioned } from "./partition";
+export type { PipelineControl, PipelineResult } from "./pipeline";
+export { runPipeline, validatePipeline } from "./pipeline";
+export type {
+  PoolWorker,
+  WorkerPoolOptions,
+  WorkerPoolStats,
+} from "./pool";
+export { estimateJobCost, MeshWorkerPool } from "./pool";
+
+/**
+ * Result of any worker operation
+ */
+type OperationResult = RemeshResult | PreviewResult | BufferRemeshResult;
 
 /**
  * Pending operation tracking
  */
 interface PendingOperation {
-  resolve: (result: RemeshResult) => void;
+  resolve: (result: OperationResult) => void;
   reject: (error: Error) => void;
 }
 
@@ -51,9 +82,25 @@ function serializeMesh(mesh: Mesh): SerializedMeshData {
 }
 
 /**
- * Deserialize worker result to RemeshResult
+ * Deserialize worker result to RemeshResult (PipelineResult for pipelines,
+ * PreviewResult for packed meshes, BufferRemeshResult for .meshb files)
  */
-function deserializeResult(serialized: SerializedRemeshResult): RemeshResult {
+function deserializeResult(
+  serialized:
+    | SerializedRemeshResult
+    | SerializedPipelineResult
+    | SerializedPreviewResult
+    | SerializedBufferResult,
+): OperationResult {
+  if ("packedMesh" in serialized) {
+    const { packedMesh, ...stats } = serialized;
+    return { ...stats, mesh: decodePackedMesh(packedMesh) };
+  }
+  if ("meshBuffer" in serialized) {
+    const { meshBuffer, ...stats } = serialized;
+    return { ...stats, mesh: new Uint8Array(meshBuffer) };
+  }
+
   // Create a Mesh from the serialized data
   const meshData: MeshData = {
     vertices: serialized.mesh.vertices,
@@ -66,12 +113,13 @@ function deserializeResult(serialized: SerializedRemeshResult): RemeshResult {
 
   const mesh = new Mesh(meshData);
 
-  return {
+  const result: RemeshResult = {
     mesh,
     nVertices: serialized.nVertices,
     nCells: serialized.nCells,
     nBoundaryFaces: serialized.nBoundaryFaces,
     elapsed: serialized.elapsed,
+    timings: serialized.timings,
     qualityBefore: serialized.qualityBefore,
     qualityAfter: serialized.qualityAfter,
     qualityImprovement: serialized.qualityImprovement,
@@ -81,7 +129,12 @@ function deserializeResult(serialized: SerializedRemeshResult): RemeshResult {
     nMoved: serialized.nMoved,
     success: serialized.success,
     warnings: serialized.warnings,
+    memory: serialized.memory,
+    stats: serialized.stats,
   };
+  return "stages" in serialized
+    ? { ...result, stages: serialized.stages }
+    : result;
 }
 
 /**
@@ -154,7 +207,7 @@ export class MeshWorker {
     };
 
     // Wait for ready message
-    this.ready = new Promise<void>((resolve) => {
+    const workerReady = new Promise<void>((resolve) => {
       const checkReady = (event: MessageEvent<WorkerResponseMessage>) => {
         if (event.data.type === "ready") {
           resolve();
@@ -162,6 +215,21 @@ export class MeshWorker {
       };
       this.worker.addEventListener("message", checkReady, { once: true });
     });
+
+    // Share the compiled WASM module before the first request, so the worker
+    // only instantiates it (compiled once per page, not once per worker)
+    this.ready = Promise.all([workerReady, getCompiledModule()]).then(
+      ([, compiled]) => {
+        if (compiled && !this.terminated) {
+          const message: WorkerRequestMessage = {
+            type: "init",
+            payload: compiled,
+          };
+          this.worker.postMessage(message);
+        }
+      },
+      () => workerReady,
+    );
   }
 
   /**
@@ -228,31 +296,154 @@ export class MeshWorker {
     // Wait for worker to be ready
     await this.ready;
 
-    const id = generateId();
+    return this.send(mesh, (id, meshData) => ({
+      type: "remesh",
+      id,
+      payload: { meshData, options },
+    })) as Promise<RemeshResult>;
+  }
+
+  /**
+   * Remesh a mesh in the worker thread for display only
+   *
+   * The result mesh comes back in the compact wire format (see
+   * decodePackedMesh) as a single transferred buffer, about half the bytes
+   * of remesh() and already in the 0-based form renderers use, but it is
+   * not a Mesh and cannot be remeshed further.
+   *
+   * @param mesh - Mesh to remesh
+   * @param options - Remeshing options
+   * @param pack - Quantization and boundary-only packing of the result
+   * @returns Promise resolving to PreviewResult
+   * @throws Error if worker has been terminated or remeshing fails
+   */
+  async preview(
+    mesh: Mesh,
+    options?: RemeshOptions,
+    pack: PackOptions = {},
+  ): Promise<PreviewResult> {
+    if (this.terminated) {
+      throw new Error("Worker has been terminated");
+    }
+
+    // Wait for worker to be ready
+    await this.ready;
 
+    return this.send(mesh, (id, meshData) => ({
+      type: "remesh",
+      id,
+      payload: { meshData, options, pack },
+    })) as Promise<PreviewResult>;
+  }
+
+  /**
+   * Run a multi-stage adaptive pipeline in the worker thread
+   *
+   * The mesh is transferred once and stays in the worker's WASM memory while
+   * every stage remeshes it; only the final mesh is sent back. Progress
+   * updates name the stage being run. The original mesh is not modified.
+   *
+   * @param mesh - Mesh to adapt
+   * @param stages - Stages, run in order (see runPipeline)
+   * @returns Promise resolving to the final mesh with per-stage reports
+   * @throws Error if worker has been terminated, a stage is invalid or fails
+   */
+  async pipeline(mesh: Mesh, stages: PipelineStage[]): Promise<PipelineResult> {
+    if (this.terminated) {
+      throw new Error("Worker has been terminated");
+    }
+
+    // Wait for worker to be ready
+    await this.ready;
+
+    return this.send(mesh, (id, meshData) => ({
+      type: "pipeline",
+      id,
+      payload: { meshData, stages },
+    })) as Promise<PipelineResult>;
+  }
+
+  /**
+   * Remesh a mesh given as a .meshb file in the worker thread
+   *
+   * The file is copied and transferred as is, and the result comes back as
+   * a .meshb file too, so references and required entities (which the
+   * vertex and element arrays of remesh() leave out) survive both ways.
+   * Partitioned remeshing sends its parts this way (see
+   * MeshWorkerPool.remeshPartitioned).
+   *
+   * The file has no metric, so one goes alongside it, and the metric of the
+   * remeshed mesh comes back with the result.
+   *
+   * @param buffer - Mesh in .meshb format (see Mesh.toArrayBuffer)
+   * @param type - Type of the mesh
+   * @param options - Remeshing options
+   * @param metric - Metric at the vertices of the mesh (see Mesh.metric)
+   * @returns Promise resolving to the statistics, remeshed .meshb file and
+   *   its metric
+   * @throws Error if worker has been terminated or remeshing fails
+   */
+  async remeshBuffer(
+    buffer: Uint8Array,
+    type: MeshType,
+    options?: RemeshOptions,
+    metric?: Float64Array,
+  ): Promise<BufferRemeshResult> {
+    if (this.terminated) {
+      throw new Error("Worker has been terminated");
+    }
+
+    // Wait for worker to be ready
+    await this.ready;
+
+    // Copy to avoid transfer issues
+    const file = buffer.slice().buffer as ArrayBuffer;
+    const values = metric?.slice();
+    return this.post(
+      (id) => ({
+        type: "remeshBuffer",
+        id,
+        payload: { buffer: file, meshType: type, options, metric: values },
+      }),
+      values ? [file, values.buffer as ArrayBuffer] : [file],
+    ) as Promise<BufferRemeshResult>;
+  }
+
+  /**
+   * Send a request carrying a mesh and track its pending result
+   */
+  private send(
+    mesh: Mesh,
+    request: (id: string, meshData: SerializedMeshData) => WorkerRequestMessage,
+  ): Promise<OperationResult> {
     // Serialize mesh data
     const meshData = serializeMesh(mesh);
 
-    return new Promise<RemeshResult>((resolve, reject) => {
-      this.pending.set(id, { resolve, reject });
+    // Prepare transferable buffers
+    const transferables: Transferable[] = [
+      meshData.vertices.buffer,
+      meshData.cells.buffer,
+    ];
+    if (meshData.boundaryFaces) {
+      transferables.push(meshData.boundaryFaces.buffer);
+    }
 
-      // Prepare transferable buffers
-      const transferables: Transferable[] = [
-        meshData.vertices.buffer,
-        meshData.cells.buffer,
-      ];
-      if (meshData.boundaryFaces) {
-        transferables.push(meshData.boundaryFaces.buffer);
-      }
+    return this.post((id) => request(id, meshData), transferables);
+  }
 
-      // Send remesh request
-      const message: WorkerRequestMessage = {
-        type: "remesh",
-        id,
-        payload: { meshData, options },
-      };
+  /**
+   * Post a request with its transferable buffers and track its pending
+   * result
+   */
+  private post(
+    request: (id: string) => WorkerRequestMessage,
+    transferables: Transferable[],
+  ): Promise<OperationResult> {
+    const id = generateId();
 
-      this.worker.postMessage(message, transferables);
+    return new Promise<OperationResult>((resolve, reject) => {
+      this.pending.set(id, { resolve, reject });
+      this.worker.postMessage(request(id), transferables);
     });
   }
 
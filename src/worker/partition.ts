@@ -0,0 +1,232 @@
+/**
+ * Domain-decomposed remeshing of large 3D meshes
+ *
+ * A single MMG3D remesh runs on one core, however many workers are idle. A
+ * partitioned remesh splits the mesh into balanced parts
+ * (Mesh.splitSubdomains), remeshes them side by side with the faces between
+ * them frozen, and welds the results back (Mesh.mergeSubdomains). Each pass
+ * cuts along other axes, so the interfaces frozen by one pass lie inside a
+ * part of the next one and get remeshed too.
+ */
+
+import { Mesh, MeshType } from "../mesh";
+import type { RemeshOptions } from "../options";
+import type {
+  BufferRemeshResult,
+  RemeshResult,
+  RemeshTimings,
+} from "../result";
+
+/** Parts of a partitioned remesh when not given */
+const DEFAULT_PARTS = 4;
+
+/** Passes of a partitioned remesh when not given */
+const DEFAULT_PASSES = 2;
+
+/**
+ * How a partitioned remesh splits its mesh
+ */
+export interface PartitionOptions {
+  /**
+   * Number of parts remeshed side by side, at most one per tetrahedron
+   * (default: 4, or the pool size with MeshWorkerPool)
+   */
+  parts?: number;
+  /**
+   * Split, remesh and merge passes; passes after the first remesh the
+   * interfaces frozen by the previous one (default: 2)
+   */
+  passes?: number;
+}
+
+/**
+ * Remesh of one part, sent to a worker as a .meshb file so its frozen
+ * interface survives the transfer, with the metric of the part when it is
+ * to be remeshed to it (see MeshWorker.remeshBuffer)
+ */
+export type PartRemesher = (
+  part: Mesh,
+  options: RemeshOptions,
+  metric: Float64Array | undefined,
+) => Promise<BufferRemeshResult>;
+
+/**
+ * Wait for every promise, then reject with the first error if any failed
+ *
+ * Parts are freed once their remesh settles, so none may still be running.
+ */
+async function settleAll<T>(promises: Promise<T>[]): Promise<T[]> {
+  const settled = await Promise.allSettled(promises);
+  for (const outcome of settled) {
+    if (outcome.status === "rejected") {
+      throw outcome.reason instanceof Error
+        ? outcome.reason
+        : new Error(String(outcome.reason));
+    }
+  }
+  return settled.map((outcome) => (outcome as PromiseFulfilledResult<T>).value);
+}
+
+/**
+ * Whether sizes come from the options alone: MMG rejects a metric together
+ * with hsiz or optim
+ */
+function ignoresMetric(options: RemeshOptions): boolean {
+  return options.hsiz !== undefined || options.optim === true;
+}
+
+/**
+ * Split a mesh, remesh its parts and weld them back
+ *
+ * @returns The welded mesh (owned by the caller) and the result of each part
+ */
+async function remeshPass(
+  mesh: Mesh,
+  pass: number,
+  parts: number,
+  options: RemeshOptions,
+  remeshPart: PartRemesher,
+): Promise<{ mesh: Mesh; results: BufferRemeshResult[] }> {
+  const subdomains = mesh.splitSubdomains(parts, pass);
+  const carryMetric = !ignoresMetric(options);
+  const remeshed: Mesh[] = [];
+  try {
+    const results = await settleAll(
+      subdomains.map((part) =>
+        remeshPart(part, options, carryMetric ? part.metric : undefined),
+      ),
+    );
+    for (const result of results) {
+      const part = await Mesh.load(result.mesh, {
+        type: MeshType.Mesh3D,
+        format: "meshb",
+      });
+      remeshed.push(part);
+      if (result.metric?.length === part.nVertices) {
+        part.setMetric(result.metric);
+      } else if (result.metric) {
+        part.setMetricTensor(result.metric);
+      }
+    }
+    return { mesh: Mesh.mergeSubdomains(remeshed), results };
+  } finally {
+    for (const part of [...subdomains, ...remeshed]) {
+      part.free();
+    }
+  }
+}
+
+/**
+ * Remesh a 3D mesh part by part, in parallel
+ *
+ * Every part is remeshed with the same options and the metric of its
+ * vertices, with the local sizing regions of the mesh evaluated over the
+ * whole mesh first (see Mesh.splitSubdomains), so sizes follow the metric,
+ * the regions and the options as in a single remesh. With hsiz or optim the
+ * options alone set the sizes and the metric is left out, as MMG rejects
+ * the combination. Timings add up the remeshes of all parts, so they
+ * measure work rather than elapsed time.
+ *
+ * @param input - Mesh to remesh, left unchanged
+ * @param options - Remeshing options of every part
+ * @param partition - Number of parts and passes
+ * @param remeshPart - Remeshes one part, typically on a worker
+ * @returns The welded mesh (owned by the caller) with statistics over all
+ *   parts and passes
+ * @throws Error if the mesh is not 3D or has required entities, an option is
+ *   invalid or conflicts with its sizing regions, or a part fails
+ */
+export async function remeshPartitioned(
+  input: Mesh,
+  options: RemeshOptions = {},
+  partition: PartitionOptions = {},
+  remeshPart: PartRemesher,
+): Promise<RemeshResult> {
+  if (input.type !== MeshType.Mesh3D) {
+    throw new Error("Partitioned remeshing is only available for 3D meshes");
+  }
+  if (options.local) {
+    throw new Error("Partitioned remeshing does not support local remeshing");
+  }
+  if (input.localSizeCount > 0 && ignoresMetric(options)) {
+    throw new Error(
+      "Local sizing regions cannot be combined with hsiz or optim",
+    );
+  }
+  const parts = partition.parts ?? DEFAULT_PARTS;
+  const passes = partition.passes ?? DEFAULT_PASSES;
+  if (!Number.isInteger(parts) || parts < 1) {
+    throw new Error("Number of parts must be a positive integer");
+  }
+  if (!Number.isInteger(passes) || passes < 1) {
+    throw new Error("Number of passes must be a positive integer");
+  }
+
+  const startTime = performance.now();
+  const timings: RemeshTimings = { clone: 0, sizing: 0, quality: 0, remesh: 0 };
+  const warnings: string[] = [];
+  const originalVertexCount = input.nVertices;
+  let qualityBefore = Number.POSITIVE_INFINITY;
+  let qualityAfter = Number.POSITIVE_INFINITY;
+  let success = true;
+
+  // Mesh split by the next pass, owned here unless it is input
+  let current = input;
+  try {
+    for (let pass = 0; pass < passes; pass++) {
+      const { mesh, results } = await remeshPass(
+        current,
+        pass,
+        parts,
+        options,
+        remeshPart,
+      );
+      if (current !== input) {
+        current.free();
+      }
+      current = mesh;
+
+      qualityAfter = Number.POSITIVE_INFINITY;
+      for (const result of results) {
+        if (pass === 0) {
+          qualityBefore = Math.min(qualityBefore, result.qualityBefore);
+        }
+        qualityAfter = Math.min(qualityAfter, result.qualityAfter);
+        for (const step of Object.keys(timings) as (keyof RemeshTimings)[]) {
+          timings[step] += result.timings[step];
+        }
+        success &&= result.success;
+        for (const warning of result.warnings) {
+          warnings.push(`Pass ${pass + 1}: ${warning}`);
+        }
+      }
+    }
+  } catch (error) {
+    if (current !== input) {
+      current.free();
+    }
+    throw error;
+  }
+
+  const vertexDelta = current.nVertices - originalVertexCount;
+  return {
+    mesh: current,
+    nVertices: current.nVertices,
+    nCells: current.nCells,
+    nBoundaryFaces: current.nBoundaryFaces,
+    elapsed: performance.now() - startTime,
+    timings,
+    qualityBefore,
+    qualityAfter,
+    qualityImprovement:
+      qualityBefore > 0
+        ? qualityAfter / qualityBefore
+        : Number.POSITIVE_INFINITY,
+    nInserted: vertexDelta > 0 ? vertexDelta : 0,
+    nDeleted: vertexDelta < 0 ? -vertexDelta : 0,
+    nSwapped: 0, // MMG doesn't expose this
+    nMoved: 0, // MMG doesn't expose this
+    success,
+    warnings,
+  };
+}
@@ -0,0 +1,242 @@
+/**
+ * Multi-stage adaptive remeshing pipeline
+ *
+ * Runs a sequence of remesh stages on a mesh that stays resident in WASM
+ * memory: every run remeshes the output of the previous one, so nothing is
+ * copied out of the heap until the final mesh. The worker runs pipelines
+ * through `MeshWorker.pipeline()`, paying the transfer cost once instead of
+ * once per adaptation step.
+ */
+
+import type { Mesh } from "../mesh";
+import type { RemeshProgress } from "../mmg3d";
+import type { RemeshResult, RemeshTimings } from "../result";
+import type {
+  PipelineStage,
+  PipelineStageReport,
+  SizingRegion,
+} from "./types";
+
+/**
+ * Result of a pipeline: the final mesh with statistics over the whole run
+ * (quality before the first remesh, after the last one, summed timings) and
+ * a report per stage
+ */
+export interface PipelineResult extends RemeshResult {
+  stages: PipelineStageReport[];
+}
+
+/**
+ * Progress reporting and cancellation for runPipeline()
+ */
+export interface PipelineControl {
+  /**
+   * Called as remesh runs progress, with the stage index, the remesh run
+   * across the whole pipeline and the total number of runs planned (stages
+   * that converge early end up running fewer)
+   */
+  onProgress?: (
+    stage: number,
+    run: number,
+    plannedRuns: number,
+    progress: RemeshProgress,
+  ) => void;
+  /** Aborts the current remesh, and the pipeline before its next run */
+  signal?: AbortSignal;
+}
+
+/**
+ * Check the stages of a pipeline before running any of them
+ *
+ * @throws Error if there is no stage or a stage has invalid criteria
+ */
+export function validatePipeline(stages: PipelineStage[]): void {
+  if (stages.length === 0) {
+    throw new Error("A pipeline needs at least one stage");
+  }
+  stages.forEach((stage, i) => {
+    const iterations = stage.iterations ?? 1;
+    if (!Number.isInteger(iterations) || iterations < 1) {
+      throw new Error(`Stage ${i + 1}: iterations must be a positive integer`);
+    }
+    if (stage.vertexTolerance !== undefined && !(stage.vertexTolerance >= 0)) {
+      throw new Error(`Stage ${i + 1}: vertexTolerance must be non-negative`);
+    }
+  });
+}
+
+/**
+ * Replace the local sizing regions of a mesh
+ */
+function applySizingRegions(mesh: Mesh, regions: SizingRegion[] = []): void {
+  mesh.clearLocalSizes();
+  for (const region of regions) {
+    switch (region.shape) {
+      case "sphere":
+        mesh.setSizeSphere(region.center, region.radius, region.size);
+        break;
+      case "circle":
+        mesh.setSizeCircle(region.center, region.radius, region.size);
+        break;
+      case "box":
+        mesh.setSizeBox(region.min, region.max, region.size);
+        break;
+      case "cylinder":
+        mesh.setSizeCylinder(region.p1, region.p2, region.radius, region.size);
+        break;
+    }
+  }
+}
+
+/**
+ * Run the stages of a pipeline on a mesh
+ *
+ * Each stage remeshes up to `iterations` times with its options and sizing
+ * regions, stopping early once one of its stopping criteria is met; stages
+ * without sizing regions adapt to the metric carried over from the previous
+ * run. The input mesh is left unchanged and intermediate meshes are freed as
+ * soon as the next run has replaced them.
+ *
+ * @param input - Mesh to adapt
+ * @param stages - Stages, run in order
+ * @param control - Optional progress callback and abort signal
+ * @returns The final mesh (owned by the caller) with pipeline statistics
+ * @throws Error if a stage fails, misses its quality threshold or is aborted
+ */
+export async function runPipeline(
+  input: Mesh,
+  stages: PipelineStage[],
+  control: PipelineControl = {},
+): Promise<PipelineResult> {
+  validatePipeline(stages);
+
+  const startTime = performance.now();
+  const plannedRuns = stages.reduce(
+    (total, stage) => total + (stage.iterations ?? 1),
+    0,
+  );
+  const timings: RemeshTimings = { clone: 0, sizing: 0, quality: 0, remesh: 0 };
+  const reports: PipelineStageReport[] = [];
+  const warnings: string[] = [];
+  const originalVertexCount = input.nVertices;
+  let qualityBefore = Number.NaN;
+  let success = true;
+  let run = 0;
+
+  // Mesh remeshed by the next run, owned by the pipeline unless it is input
+  let current = input;
+  let last: RemeshResult | null = null;
+
+  try {
+    for (let s = 0; s < stages.length; s++) {
+      const stage = stages[s];
+      const iterations = stage.iterations ?? 1;
+      const stageStart = performance.now();
+      let stageQualityBefore = Number.NaN;
+      let converged = false;
+      let runs = 0;
+
+      while (runs < iterations && !converged) {
+        if (control.signal?.aborted) {
+          throw new Error("Remeshing aborted");
+        }
+
+        applySizingRegions(current, stage.sizing);
+        const { onProgress } = control;
+        const runIndex = run;
+        const result = await current.remesh(stage.options, {
+          signal: control.signal,
+          onProgress: onProgress
+            ? (progress) => onProgress(s, runIndex, plannedRuns, progress)
+            : undefined,
+        });
+        run++;
+        runs++;
+
+        const previousVertexCount = current.nVertices;
+        if (current !== input) {
+          current.free();
+        }
+        current = result.mesh;
+        last = result;
+
+        if (runs === 1) {
+          stageQualityBefore = result.qualityBefore;
+          if (s === 0) {
+            qualityBefore = result.qualityBefore;
+          }
+        }
+        for (const step of Object.keys(timings) as (keyof RemeshTimings)[]) {
+          timings[step] += result.timings[step];
+        }
+        success &&= result.success;
+        for (const warning of result.warnings) {
+          warnings.push(`Stage ${s + 1}: ${warning}`);
+        }
+
+        // Stopping criteria
+        if (
+          stage.targetQuality !== undefined &&
+          result.qualityAfter >= stage.targetQuality
+        ) {
+          converged = true;
+        }
+        if (
+          stage.vertexTolerance !== undefined &&
+          Math.abs(result.nVertices - previousVertexCount) <=
+            stage.vertexTolerance * previousVertexCount
+        ) {
+          converged = true;
+        }
+      }
+
+      const qualityAfter = (last as RemeshResult).qualityAfter;
+      reports.push({
+        stage: s,
+        iterations: runs,
+        converged,
+        nVertices: current.nVertices,
+        nCells: current.nCells,
+        qualityBefore: stageQualityBefore,
+        qualityAfter,
+        elapsed: performance.now() - stageStart,
+      });
+
+      if (stage.minQuality !== undefined && qualityAfter < stage.minQuality) {
+        throw new Error(
+          `Stage ${s + 1} ended with quality ${qualityAfter.toFixed(4)}, ` +
+            `below the required ${stage.minQuality}`,
+        );
+      }
+    }
+  } catch (error) {
+    if (current !== input) {
+      current.free();
+    }
+    throw error;
+  }
+
+  const final = last as RemeshResult;
+  const vertexDelta = current.nVertices - originalVertexCount;
+  return {
+    mesh: current,
+    nVertices: final.nVertices,
+    nCells: final.nCells,
+    nBoundaryFaces: final.nBoundaryFaces,
+    elapsed: performance.now() - startTime,
+    timings,
+    qualityBefore,
+    qualityAfter: final.qualityAfter,
+    qualityImprovement:
+      qualityBefore > 0
+        ? final.qualityAfter / qualityBefore
+        : Number.POSITIVE_INFINITY,
+    nInserted: vertexDelta > 0 ? vertexDelta : 0,
+    nDeleted: vertexDelta < 0 ? -vertexDelta : 0,
+    nSwapped: 0, // MMG doesn't expose this
+    nMoved: 0, // MMG doesn't expose this
+    success,
+    warnings,
+    stages: reports,
+  };
+}
@@ -0,0 +1,451 @@
+/**
+ * Pool of mesh workers with cost-aware scheduling
+ *
+ * Jobs wait in a single queue ordered by estimated cost, so a few large 3D
+ * remeshes don't hold back a batch of small ones, and a job that has waited
+ * too long is served first so large jobs still make progress. Workers only
+ * load the MMG modules of the mesh types they run, and jobs go to an idle
+ * worker that already has their module whenever there is one. Workers report
+ * their memory after each job, so the pool replaces a worker whose heap grew
+ * large or whose leftover allocations leave too little room for the next job.
+ * With a RemeshCache, remeshes already done are served from it without
+ * reaching a worker.
+ */
+
+import type { RemeshCache } from "../cache";
+import { type Mesh, MeshType, loadCachedRemesh } from "../mesh";
+import { estimateMeshMemory } from "../memory";
+import type { RemeshOptions } from "../options";
+import type {
+  BufferRemeshResult,
+  RemeshMemory,
+  RemeshResult,
+} from "../result";
+import { MeshWorker } from "./index";
+import { type PartitionOptions, remeshPartitioned } from "./partition";
+import type { PipelineResult } from "./pipeline";
+import type { PipelineStage } from "./types";
+
+/** WASM32 heaps cannot grow beyond 2GB */
+const DEFAULT_MAX_WORKER_MEMORY = 2 * 1024 * 1024 * 1024;
+
+/** Queued jobs older than this are served before cheaper ones */
+const DEFAULT_MAX_WAIT = 10000;
+
+/**
+ * Worker interface used by the pool (implemented by MeshWorker)
+ */
+export interface PoolWorker {
+  remesh(mesh: Mesh, options?: RemeshOptions): Promise<RemeshResult>;
+  pipeline(mesh: Mesh, stages: PipelineStage[]): Promise<PipelineResult>;
+  remeshBuffer(
+    buffer: Uint8Array,
+    type: MeshType,
+    options?: RemeshOptions,
+    metric?: Float64Array,
+  ): Promise<BufferRemeshResult>;
+  terminate(): void;
+}
+
+/**
+ * Options for MeshWorkerPool
+ */
+export interface WorkerPoolOptions {
+  /** Maximum number of workers (default: hardware concurrency, or 4) */
+  size?: number;
+  /**
+   * Estimated memory above which a job is rejected instead of being sent to
+   * a worker where it would run out of heap (default: 2GB)
+   */
+  maxWorkerMemory?: number;
+  /**
+   * WASM heaps never shrink, so a worker whose heap grew above this is
+   * replaced after its job to release the memory (default: a quarter of
+   * maxWorkerMemory). Jobs that report no memory use their estimate.
+   */
+  recycleMemory?: number;
+  /** Milliseconds after which a queued job jumps ahead of cheaper ones */
+  maxWait?: number;
+  /** Worker factory (default: creates a MeshWorker) */
+  createWorker?: () => PoolWorker;
+  /**
+   * Cache consulted by remesh() before a job is queued, and filled with the
+   * results of successful jobs
+   */
+  cache?: RemeshCache;
+}
+
+/**
+ * Snapshot of the pool's activity
+ */
+export interface WorkerPoolStats {
+  /** Workers alive */
+  workers: number;
+  /** Workers running a job */
+  busy: number;
+  /** Jobs waiting for a worker */
+  queued: number;
+}
+
+/** Result of a pool job, with the memory its worker reported */
+type PoolResult = RemeshResult | BufferRemeshResult;
+
+interface PoolJob {
+  type: MeshType;
+  cost: number;
+  queuedAt: number;
+  run: (worker: PoolWorker) => Promise<PoolResult>;
+  resolve: (result: PoolResult) => void;
+  reject: (error: Error) => void;
+}
+
+interface PoolSlot {
+  worker: PoolWorker;
+  busy: boolean;
+  /** Mesh types whose module the worker has loaded */
+  types: Set<MeshType>;
+  /** Memory reported after the worker's last job */
+  memory?: RemeshMemory;
+}
+
+/**
+ * Estimate the memory a remesh of a mesh needs, used as its scheduling cost
+ *
+ * @param mesh - Mesh to remesh
+ * @returns Estimated bytes (see estimateMeshMemory)
+ */
+export function estimateJobCost(mesh: Mesh): number {
+  if (mesh.type === MeshType.Mesh3D) {
+    return estimateMeshMemory(mesh.nVertices, mesh.nCells, mesh.nBoundaryFaces);
+  }
+  return estimateMeshMemory(mesh.nVertices, 0, mesh.nCells);
+}
+
+/**
+ * MeshWorkerPool - Runs remeshing jobs on a bounded set of workers
+ *
+ * Workers are created on demand up to the pool size. Each one runs a single
+ * job at a time, so the mesh passed to a job must stay alive until its
+ * promise settles.
+ *
+ * @example
+ * ```typescript
+ * import { MeshWorkerPool } from 'mmg-wasm/worker';
+ *
+ * const pool = new MeshWorkerPool({ size: 4 });
+ * const results = await Promise.all(
+ *   meshes.map((mesh) => pool.remesh(mesh, { hmax: 0.1 })),
+ * );
+ * pool.terminate();
+ * ```
+ */
+export class MeshWorkerPool {
+  private readonly size: number;
+  private readonly maxWorkerMemory: number;
+  private readonly recycleMemory: number;
+  private readonly maxWait: number;
+  private readonly createWorker: () => PoolWorker;
+  private readonly cache?: RemeshCache;
+  private slots: PoolSlot[] = [];
+  private queue: PoolJob[] = [];
+  private terminated = false;
+
+  /**
+   * Create a new MeshWorkerPool
+   *
+   * @param options - Pool size, memory limits and worker factory
+   * @throws Error if an option is out of range
+   */
+  constructor(options: WorkerPoolOptions = {}) {
+    this.size =
+      options.size ??
+      ((typeof navigator !== "undefined" && navigator.hardwareConcurrency) ||
+        4);
+    if (!Number.isInteger(this.size) || this.size < 1) {
+      throw new Error("Pool size must be a positive integer");
+    }
+    this.maxWorkerMemory = options.maxWorkerMemory ?? DEFAULT_MAX_WORKER_MEMORY;
+    this.recycleMemory = options.recycleMemory ?? this.maxWorkerMemory / 4;
+    this.maxWait = options.maxWait ?? DEFAULT_MAX_WAIT;
+    if (!(this.maxWorkerMemory > 0) || !(this.recycleMemory > 0)) {
+      throw new Error("Worker memory limits must be positive");
+    }
+    this.createWorker = options.createWorker ?? (() => new MeshWorker());
+    this.cache = options.cache;
+  }
+
+  /**
+   * Remesh a mesh on the first suitable worker
+   *
+   * With a cache, a remesh found in it is returned without queuing a job.
+   *
+   * @param mesh - Mesh to remesh, kept alive until the promise settles
+   * @param options - Remeshing options
+   * @returns Promise resolving to RemeshResult
+   * @throws Error if the pool is terminated, the job exceeds the worker
+   *   memory limit or remeshing fails
+   */
+  remesh(mesh: Mesh, options?: RemeshOptions): Promise<RemeshResult> {
+    if (this.cache && !this.terminated) {
+      return this.remeshCached(this.cache, mesh, options);
+    }
+    return this.submit(mesh, (worker) =>
+      worker.remesh(mesh, options),
+    ) as Promise<RemeshResult>;
+  }
+
+  /**
+   * Run a multi-stage pipeline on the first suitable worker
+   *
+   * @param mesh - Mesh to adapt, kept alive until the promise settles
+   * @param stages - Stages, run in order (see runPipeline)
+   * @returns Promise resolving to the final mesh with per-stage reports
+   * @throws Error if the pool is terminated, the job exceeds the worker
+   *   memory limit or a stage fails
+   */
+  pipeline(mesh: Mesh, stages: PipelineStage[]): Promise<PipelineResult> {
+    return this.submit(mesh, (worker) =>
+      worker.pipeline(mesh, stages),
+    ) as Promise<PipelineResult>;
+  }
+
+  /**
+   * Remesh a large 3D mesh on several workers at once
+   *
+   * The mesh is split into one part per worker by default, each part
+   * remeshed as its own job with the faces it shares with the others
+   * frozen, and the parts welded back; later passes split elsewhere to
+   * remesh the previous interfaces (see remeshPartitioned). Parts travel as
+   * .meshb files, which keep their frozen interfaces, with their metric.
+   *
+   * @param mesh - 3D mesh to remesh, kept alive until the promise settles
+   * @param options - Remeshing options of every part
+   * @param partition - Number of parts (default: the pool size) and passes
+   * @returns Promise resolving to the welded mesh (owned by the caller)
+   * @throws Error if the pool is terminated, the mesh is not 3D or has
+   *   required entities, a part exceeds the worker memory limit or fails
+   */
+  remeshPartitioned(
+    mesh: Mesh,
+    options?: RemeshOptions,
+    partition: PartitionOptions = {},
+  ): Promise<RemeshResult> {
+    if (this.terminated) {
+      return Promise.reject(new Error("Worker pool terminated"));
+    }
+    return remeshPartitioned(
+      mesh,
+      options,
+      { parts: this.size, ...partition },
+      (part, partOptions, metric) =>
+        this.submit(part, (worker) =>
+          worker.remeshBuffer(
+            part.toArrayBuffer("meshb"),
+            MeshType.Mesh3D,
+            partOptions,
+            metric,
+          ),
+        ) as Promise<BufferRemeshResult>,
+    );
+  }
+
+  /**
+   * Current number of workers, busy workers and queued jobs
+   */
+  get stats(): WorkerPoolStats {
+    return {
+      workers: this.slots.length,
+      busy: this.slots.filter((slot) => slot.busy).length,
+      queued: this.queue.length,
+    };
+  }
+
+  /**
+   * Check if the pool has been terminated
+   */
+  get isTerminated(): boolean {
+    return this.terminated;
+  }
+
+  /**
+   * Terminate every worker
+   *
+   * Queued jobs are rejected, and running jobs reject as their worker is
+   * terminated. The pool cannot be used afterwards.
+   */
+  terminate(): void {
+    if (this.terminated) {
+      return;
+    }
+    this.terminated = true;
+
+    const error = new Error("Worker pool terminated");
+    for (const job of this.queue) {
+      job.reject(error);
+    }
+    this.queue = [];
+
+    for (const slot of this.slots) {
+      slot.worker.terminate();
+    }
+    this.slots = [];
+  }
+
+  /**
+   * Serve a remesh from the cache, or run it and store its result
+   */
+  private async remeshCached(
+    cache: RemeshCache,
+    mesh: Mesh,
+    options?: RemeshOptions,
+  ): Promise<RemeshResult> {
+    const startTime = performance.now();
+    const key = await mesh.contentHash(options);
+    const hit = await loadCachedRemesh(cache, key, mesh.type, startTime);
+    if (hit) {
+      return hit;
+    }
+    const result = (await this.submit(mesh, (worker) =>
+      worker.remesh(mesh, options),
+    )) as RemeshResult;
+    await cache.save(key, result);
+    return result;
+  }
+
+  /**
+   * Queue a job and dispatch what can run
+   */
+  private submit(
+    mesh: Mesh,
+    run: (worker: PoolWorker) => Promise<PoolResult>,
+  ): Promise<PoolResult> {
+    if (this.terminated) {
+      return Promise.reject(new Error("Worker pool terminated"));
+    }
+
+    const cost = estimateJobCost(mesh);
+    if (cost > this.maxWorkerMemory) {
+      return Promise.reject(
+        new Error(
+          `Job needs an estimated ${cost} bytes, above the worker limit of ` +
+            `${this.maxWorkerMemory} bytes`,
+        ),
+      );
+    }
+
+    return new Promise<PoolResult>((resolve, reject) => {
+      this.queue.push({
+        type: mesh.type,
+        cost,
+        queuedAt: performance.now(),
+        run,
+        resolve,
+        reject,
+      });
+      this.dispatch();
+    });
+  }
+
+  /**
+   * Start queued jobs while workers are available
+   */
+  private dispatch(): void {
+    while (this.queue.length > 0) {
+      const index = this.nextJob();
+      const slot = this.acquireSlot(this.queue[index]);
+      if (!slot) {
+        return;
+      }
+      const [job] = this.queue.splice(index, 1);
+      this.start(slot, job);
+    }
+  }
+
+  /**
+   * Index of the next job: the oldest one past maxWait, else the cheapest
+   * (the oldest among equal costs)
+   */
+  private nextJob(): number {
+    const now = performance.now();
+    let best = 0;
+    for (let i = 0; i < this.queue.length; i++) {
+      const job = this.queue[i];
+      if (now - job.queuedAt >= this.maxWait) {
+        return i;
+      }
+      if (job.cost < this.queue[best].cost) {
+        best = i;
+      }
+    }
+    return best;
+  }
+
+  /**
+   * Idle worker for a job: one with room for it that already loaded its
+   * module, else a new worker while the pool can grow, else any idle worker
+   * with room, else a fresh replacement for an idle worker without room
+   */
+  private acquireSlot(job: PoolJob): PoolSlot | null {
+    const idle = this.slots.filter((slot) => !slot.busy);
+    const roomy = idle.filter(
+      (slot) =>
+        (slot.memory?.nativeUsed ?? 0) + job.cost <= this.maxWorkerMemory,
+    );
+    const warm = roomy.find((slot) => slot.types.has(job.type));
+    if (warm) {
+      return warm;
+    }
+    if (this.slots.length < this.size) {
+      const slot = this.createSlot();
+      this.slots.push(slot);
+      return slot;
+    }
+    if (roomy.length > 0) {
+      // Fewest modules loaded keeps the other workers specialized
+      return roomy.reduce((a, b) => (b.types.size < a.types.size ? b : a));
+    }
+    if (idle.length === 0) {
+      return null;
+    }
+    idle[0].worker.terminate();
+    const slot = this.createSlot();
+    this.slots[this.slots.indexOf(idle[0])] = slot;
+    return slot;
+  }
+
+  private createSlot(): PoolSlot {
+    return { worker: this.createWorker(), busy: false, types: new Set() };
+  }
+
+  /**
+   * Run a job on a worker, then recycle the worker if needed and dispatch
+   */
+  private start(slot: PoolSlot, job: PoolJob): void {
+    slot.busy = true;
+    slot.types.add(job.type);
+
+    slot.memory = undefined;
+    job
+      .run(slot.worker)
+      .then(
+        (result) => {
+          slot.memory = result.memory;
+          job.resolve(result);
+        },
+        (error: unknown) =>
+          job.reject(error instanceof Error ? error : new Error(String(error))),
+      )
+      .finally(() => {
+        slot.busy = false;
+        if (this.terminated) {
+          return;
+        }
+        const heap = slot.memory?.heapSize ?? job.cost;
+        if (heap > this.recycleMemory) {
+          slot.worker.terminate();
+          this.slots.splice(this.slots.indexOf(slot), 1);
+        }
+        this.dispatch();
+      });
+  }
+}
@@ -5,13 +5,29 @@
  * to prevent blocking the main UI thread.
  */
 
+import { setCompiledModule } from "../loader";
 import { Mesh, MeshType } from "../mesh";
-import { initMMG2D } from "../mmg2d";
-import { initMMG3D } from "../mmg3d";
-import { initMMGS } from "../mmgs";
+import {
+  type HeapReserveModule,
+  getMemoryStats,
+  reserveMemory,
+  resetNativePeak,
+} from "../memory";
+import { getWasmModule2D, initMMG2D } from "../mmg2d";
+import { getWasmModule, initMMG3D } from "../mmg3d";
+import { getWasmModuleS, initMMGS } from "../mmgs";
+import type { RemeshOptions } from "../options";
+import type { PackOptions } from "../packed";
+import type { RemeshResult } from "../result";
+import { type PipelineResult, runPipeline } from "./pipeline";
+import { estimateJobCost } from "./pool";
 import type {
+  PipelineStage,
   ProgressInfo,
+  SerializedBufferResult,
   SerializedMeshData,
+  SerializedPipelineResult,
+  SerializedPreviewResult,
   SerializedRemeshResult,
   WorkerRequestMessage,
   WorkerResponseMessage,
@@ -25,33 +41,66 @@ let mmgsReady = false;
 // Current operation ID for cancellation
 let currentOperationId: string | null = null;
 let cancelled = false;
+// Aborts the WASM remesh of the current operation
+let remeshAbort: AbortController | null = null;
+
+// Share of the overall progress covered by the WASM remesh (20% to 90%)
+const REMESH_PROGRESS_START = 20;
+const REMESH_PROGRESS_SPAN = 70;
+
+// Stage shown for each remesh phase reported by MMG
+const REMESH_STAGES: Record<string, string> = {
+  idle: "Remeshing",
+  analysis: "Analyzing mesh",
+  meshing: "Remeshing",
+  finalize: "Finalizing mesh",
+  done: "Remeshing",
+};
 
 /**
  * Initialize the appropriate MMG module
+ *
+ * Workers run one job after another for their whole life, so handles use
+ * arena mode: freeing a job's meshes returns all of MMG's memory for them at
+ * once instead of leaving the heap fragmented for the next job.
  */
 async function ensureModuleReady(type: MeshType): Promise<void> {
   switch (type) {
     case MeshType.Mesh2D:
       if (!mmg2dReady) {
-        await initMMG2D();
+        await initMMG2D({ arena: true });
         mmg2dReady = true;
       }
       break;
     case MeshType.Mesh3D:
       if (!mmg3dReady) {
-        await initMMG3D();
+        await initMMG3D({ arena: true });
         mmg3dReady = true;
       }
       break;
     case MeshType.MeshS:
       if (!mmgsReady) {
-        await initMMGS();
+        await initMMGS({ arena: true });
         mmgsReady = true;
       }
       break;
   }
 }
 
+/**
+ * WASM module of a mesh type, once ensureModuleReady() has loaded it
+ */
+function wasmModule(type: MeshType): HeapReserveModule {
+  switch (type) {
+    case MeshType.Mesh2D:
+      return getWasmModule2D();
+    case MeshType.Mesh3D:
+      return getWasmModule();
+    case MeshType.MeshS:
+      return getWasmModuleS();
+  }
+}
+
 /**
  * Send a message back to the main thread
  */
@@ -94,27 +143,110 @@ function serializeMesh(mesh: Mesh): SerializedMeshData {
 }
 
 /**
- * Handle remesh request
+ * How the result mesh of an operation is sent back
+ */
+interface ResultOutput {
+  /** Pack the mesh for display (see MeshWorker.preview) */
+  pack?: PackOptions;
+  /** Send the mesh as a .meshb file (see MeshWorker.remeshBuffer) */
+  meshb?: boolean;
+}
+
+/**
+ * Serialize a remesh or pipeline result, with the mesh in the form `output`
+ * asks for
+ */
+function serializeResult(
+  result: RemeshResult | PipelineResult,
+  output: ResultOutput,
+):
+  | SerializedRemeshResult
+  | SerializedPipelineResult
+  | SerializedPreviewResult
+  | SerializedBufferResult {
+  const stats: Omit<SerializedRemeshResult, "mesh"> = {
+    nVertices: result.nVertices,
+    nCells: result.nCells,
+    nBoundaryFaces: result.nBoundaryFaces,
+    elapsed: result.elapsed,
+    timings: result.timings,
+    qualityBefore: result.qualityBefore,
+    qualityAfter: result.qualityAfter,
+    qualityImprovement: result.qualityImprovement,
+    nInserted: result.nInserted,
+    nDeleted: result.nDeleted,
+    nSwapped: result.nSwapped,
+    nMoved: result.nMoved,
+    success: result.success,
+    warnings: result.warnings,
+    stats: result.stats,
+  };
+  if (output.meshb) {
+    const file = result.mesh.toArrayBuffer("meshb");
+    return {
+      ...stats,
+      meshBuffer: file.buffer as ArrayBuffer,
+      metric: result.mesh.metric,
+    };
+  }
+  if (output.pack) {
+    const packed = result.mesh.toPackedBuffer(output.pack);
+    return { ...stats, packedMesh: packed.buffer as ArrayBuffer };
+  }
+  const serialized: SerializedRemeshResult = {
+    ...stats,
+    mesh: serializeMesh(result.mesh),
+  };
+  return "stages" in result
+    ? { ...serialized, stages: result.stages }
+    : serialized;
+}
+
+/**
+ * Rebuild a mesh from serialized data
+ */
+function deserializeMesh(meshData: SerializedMeshData): Mesh {
+  return new Mesh({
+    vertices: meshData.vertices,
+    cells: meshData.cells,
+    type: meshData.type,
+    boundaryFaces: meshData.boundaryFaces,
+    vertexRefs: meshData.vertexRefs,
+    cellRefs: meshData.cellRefs,
+  });
+}
+
+/**
+ * Run an operation on a mesh of the given type built by `load`, and post its
+ * result (or error) back
  *
- * Cancellation is cooperative: the `cancelled` flag is only checked between
- * JavaScript stages (module init, mesh creation, post-remesh extraction).
- * Once the WASM remeshing computation begins (`mesh.remesh()`), it cannot
- * be interrupted until it returns.
+ * Cancellation is cooperative: the `cancelled` flag is checked between
+ * JavaScript stages (module init, mesh creation, post-remesh extraction), and
+ * the WASM remesh itself is aborted through its progress record at MMG's next
+ * phase or wavefront boundary. Progress and mid-remesh cancellation need the
+ * pthreads build, where the remesh runs on another thread and this worker
+ * keeps handling messages; other builds block until the remesh returns.
  */
-async function handleRemesh(
+async function handleOperation(
   id: string,
-  meshData: SerializedMeshData,
-  options?: import("../options").RemeshOptions,
+  type: MeshType,
+  load: () => Mesh | Promise<Mesh>,
+  run: (
+    mesh: Mesh,
+    signal: AbortSignal,
+  ) => Promise<RemeshResult | PipelineResult>,
+  output: ResultOutput = {},
 ): Promise<void> {
   currentOperationId = id;
   cancelled = false;
+  remeshAbort = new AbortController();
 
   try {
     // Progress: Initializing
     sendProgress(id, { percent: 0, stage: "Initializing module" });
 
     // Ensure the appropriate module is loaded
-    await ensureModuleReady(meshData.type);
+    await ensureModuleReady(type);
 
     if (cancelled) {
       throw new Error("Operation cancelled");
@@ -123,26 +255,31 @@ async function handleRemesh(
     // Progress: Creating mesh
     sendProgress(id, { percent: 10, stage: "Creating mesh" });
 
-    // Create mesh from serialized data
-    const mesh = new Mesh({
-      vertices: meshData.vertices,
-      cells: meshData.cells,
-      type: meshData.type,
-      boundaryFaces: meshData.boundaryFaces,
-      vertexRefs: meshData.vertexRefs,
-      cellRefs: meshData.cellRefs,
-    });
+    // Create mesh from serialized data or a file
+    const mesh = await load();
 
     if (cancelled) {
       mesh.free();
       throw new Error("Operation cancelled");
     }
 
+    // Grow the heap once for the input, output and MMG's working memory
+    // rather than step by step during the remesh. A failed reservation is
+    // not fatal: the estimate is rough and MMG reports real exhaustion
+    const wasm = wasmModule(type);
+    reserveMemory(wasm, 2 * estimateJobCost(mesh));
+    resetNativePeak(wasm);
+
     // Progress: Remeshing
     sendProgress(id, { percent: 20, stage: "Remeshing" });
 
-    // Perform remeshing
-    const result = await mesh.remesh(options);
+    let result: RemeshResult | PipelineResult;
+    try {
+      result = await run(mesh, remeshAbort.signal);
+    } catch (error) {
+      mesh.free();
+      throw cancelled ? new Error("Operation cancelled") : error;
+    }
 
     if (cancelled) {
       result.mesh.free();
@@ -154,38 +291,37 @@ async function handleRemesh(
     sendProgress(id, { percent: 90, stage: "Extracting result" });
 
     // Serialize the result mesh
-    const serializedResult: SerializedRemeshResult = {
-      mesh: serializeMesh(result.mesh),
-      nVertices: result.nVertices,
-      nCells: result.nCells,
-      nBoundaryFaces: result.nBoundaryFaces,
-      elapsed: result.elapsed,
-      qualityBefore: result.qualityBefore,
-      qualityAfter: result.qualityAfter,
-      qualityImprovement: result.qualityImprovement,
-      nInserted: result.nInserted,
-      nDeleted: result.nDeleted,
-      nSwapped: result.nSwapped,
-      nMoved: result.nMoved,
-      success: result.success,
-      warnings: result.warnings,
-    };
+    const serializedResult = serializeResult(result, output);
 
     // Collect transferable buffers
-    const transferables: ArrayBuffer[] = [
-      serializedResult.mesh.vertices.buffer as ArrayBuffer,
-      serializedResult.mesh.cells.buffer as ArrayBuffer,
-    ];
-    if (serializedResult.mesh.boundaryFaces) {
+    const transferables: ArrayBuffer[] = [];
+    if ("packedMesh" in serializedResult) {
+      transferables.push(serializedResult.packedMesh);
+    } else if ("meshBuffer" in serializedResult) {
+      transferables.push(serializedResult.meshBuffer);
+      if (serializedResult.metric) {
+        transferables.push(serializedResult.metric.buffer as ArrayBuffer);
+      }
+    } else {
       transferables.push(
-        serializedResult.mesh.boundaryFaces.buffer as ArrayBuffer,
+        serializedResult.mesh.vertices.buffer as ArrayBuffer,
+        serializedResult.mesh.cells.buffer as ArrayBuffer,
       );
+      if (serializedResult.mesh.boundaryFaces) {
+        transferables.push(
+          serializedResult.mesh.boundaryFaces.buffer as ArrayBuffer,
+        );
+      }
     }
 
     // Clean up original mesh (result.mesh ownership transferred via serialization)
     result.mesh.free();
     mesh.free();
 
+    // Lets the pool see how much memory the job really used
+    const { heapSize, nativeUsed, nativePeak } = getMemoryStats(wasm);
+    serializedResult.memory = { heapSize, nativeUsed, nativePeak };
+
     // Progress: Complete
     sendProgress(id, { percent: 100, stage: "Complete" });
 
@@ -212,9 +348,119 @@ async function handleRemesh(
     });
   } finally {
     currentOperationId = null;
+    remeshAbort = null;
   }
 }
 
+/**
+ * Remesh with options, reporting MMG's progress
+ */
+function remeshWithProgress(
+  id: string,
+  options?: RemeshOptions,
+): (mesh: Mesh, signal: AbortSignal) => Promise<RemeshResult> {
+  return (mesh, signal) =>
+    mesh.remesh(options, {
+      signal,
+      onProgress: (progress) => {
+        sendProgress(id, {
+          percent:
+            REMESH_PROGRESS_START +
+            Math.round((progress.percent * REMESH_PROGRESS_SPAN) / 100),
+          stage: REMESH_STAGES[progress.phase],
+        });
+      },
+    });
+}
+
+/**
+ * Handle remesh request
+ */
+function handleRemesh(
+  id: string,
+  meshData: SerializedMeshData,
+  options?: RemeshOptions,
+  pack?: PackOptions,
+): Promise<void> {
+  return handleOperation(
+    id,
+    meshData.type,
+    () => deserializeMesh(meshData),
+    remeshWithProgress(id, options),
+    { pack },
+  );
+}
+
+/**
+ * Handle remesh request on a .meshb file, sending the result back as one
+ *
+ * Unlike the vertex and element arrays, the file keeps every reference and
+ * required entity, which partitioned remeshing relies on to freeze the
+ * interfaces between parts. The metric comes alongside the file.
+ */
+function handleRemeshBuffer(
+  id: string,
+  buffer: ArrayBuffer,
+  type: MeshType,
+  options?: RemeshOptions,
+  metric?: Float64Array,
+): Promise<void> {
+  return handleOperation(
+    id,
+    type,
+    async () => {
+      const mesh = await Mesh.load(buffer, { type, format: "meshb" });
+      if (metric) {
+        try {
+          if (metric.length === mesh.nVertices) {
+            mesh.setMetric(metric);
+          } else {
+            mesh.setMetricTensor(metric);
+          }
+        } catch (error) {
+          mesh.free();
+          throw error;
+        }
+      }
+      return mesh;
+    },
+    remeshWithProgress(id, options),
+    { meshb: true },
+  );
+}
+
+/**
+ * Handle pipeline request
+ *
+ * The mesh stays in this worker's WASM heap across every stage; only the
+ * final mesh is serialized back. Progress is spread over the planned runs.
+ */
+function handlePipeline(
+  id: string,
+  meshData: SerializedMeshData,
+  stages: PipelineStage[],
+): Promise<void> {
+  return handleOperation(
+    id,
+    meshData.type,
+    () => deserializeMesh(meshData),
+    (mesh, signal) =>
+      runPipeline(mesh, stages, {
+        signal,
+        onProgress: (stage, run, plannedRuns, progress) => {
+          const done = (run + progress.percent / 100) / plannedRuns;
+          sendProgress(id, {
+            percent:
+              REMESH_PROGRESS_START + Math.round(done * REMESH_PROGRESS_SPAN),
+            stage:
+              `Stage ${stage + 1}/${stages.length}: ` +
+              REMESH_STAGES[progress.phase],
+          });
+        },
+      }),
+  );
+}
+
 /**
  * Handle cancel request
  *
@@ -224,6 +470,7 @@ async function handleRemesh(
 function handleCancel(id?: string): void {
   if (id === undefined || id === currentOperationId) {
     cancelled = true;
+    remeshAbort?.abort();
   }
 }
 
@@ -234,11 +481,34 @@ self.onmessage = async (event: MessageEvent<WorkerRequestMessage>) => {
   const message = event.data;
 
   switch (message.type) {
+    case "init":
+      setCompiledModule(message.payload);
+      break;
+
     case "remesh":
       await handleRemesh(
         message.id,
         message.payload.meshData,
         message.payload.options,
+        message.payload.pack,
+      );
+      break;
+
+    case "remeshBuffer":
+      await handleRemeshBuffer(
+        message.id,
+        message.payload.buffer,
+        message.payload.meshType,
+        message.payload.options,
+        message.payload.metric,
+      );
+      break;
+
+    case "pipeline":
+      await handlePipeline(
+        message.id,
+        message.payload.meshData,
+        message.payload.stages,
       );
       break;
 
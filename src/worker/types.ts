@@ -4,8 +4,12 @@
  * Defines the protocol for main thread <-> worker communication
  */
 
+import type { CompiledModule } from "../loader";
 import type { MeshType } from "../mesh";
 import type { RemeshOptions } from "../options";
+import type { PackOptions } from "../packed";
+import type { RemeshMemory, RemeshStats, RemeshTimings } from "../result";
+import type { Vec2, Vec3 } from "../sizing";
 
 /**
  * Serializable mesh data for worker transfer
@@ -41,6 +45,8 @@ export interface SerializedRemeshResult {
   nBoundaryFaces: number;
   /** Elapsed time in milliseconds */
   elapsed: number;
+  /** Breakdown of the elapsed time */
+  timings: RemeshTimings;
   /** Quality before remeshing */
   qualityBefore: number;
   /** Quality after remeshing */
@@ -51,14 +57,105 @@ export interface SerializedRemeshResult {
   nInserted: number;
   /** Vertices deleted */
   nDeleted: number;
-  /** Edges/faces swapped (always 0) */
+  /** Edges/faces swapped (0 without instrumentation) */
   nSwapped: number;
-  /** Vertices moved (always 0) */
+  /** Vertices moved (0 without instrumentation) */
   nMoved: number;
   /** Success status */
   success: boolean;
   /** Warning messages */
   warnings: string[];
+  /** Memory of the worker once the job finished */
+  memory?: RemeshMemory;
+  /** MMG statistics (instrumentation build only) */
+  stats?: RemeshStats;
+}
+
+/**
+ * Serialized preview result: the statistics of a remesh, with the mesh in
+ * the compact wire format (see decodePackedMesh) instead of separate arrays
+ */
+export interface SerializedPreviewResult
+  extends Omit<SerializedRemeshResult, "mesh"> {
+  /** Packed remeshed mesh, transferred */
+  packedMesh: ArrayBuffer;
+}
+
+/**
+ * Serialized result of a remesh run on an MMG binary file: the statistics of
+ * a remesh, with the mesh as a .meshb file that keeps references and
+ * required entities
+ */
+export interface SerializedBufferResult
+  extends Omit<SerializedRemeshResult, "mesh"> {
+  /** Remeshed mesh in .meshb format, transferred */
+  meshBuffer: ArrayBuffer;
+  /** Metric at the remeshed vertices, transferred (none without one) */
+  metric?: Float64Array;
+}
+
+/**
+ * Local sizing region of a pipeline stage, as plain data so it survives
+ * postMessage (see Mesh.setSizeSphere and friends)
+ */
+export type SizingRegion =
+  | { shape: "sphere"; center: Vec3; radius: number; size: number }
+  | { shape: "circle"; center: Vec2; radius: number; size: number }
+  | { shape: "box"; min: Vec2 | Vec3; max: Vec2 | Vec3; size: number }
+  | { shape: "cylinder"; p1: Vec3; p2: Vec3; radius: number; size: number };
+
+/**
+ * One stage of an adaptive remeshing pipeline
+ */
+export interface PipelineStage {
+  /** Remesh options of every run of the stage */
+  options?: RemeshOptions;
+  /**
+   * Sizing regions evaluated on the current vertices before every run. Without
+   * them the stage adapts to the metric carried over from the previous run.
+   */
+  sizing?: SizingRegion[];
+  /** Maximum number of remesh runs (default: 1) */
+  iterations?: number;
+  /** Stop repeating once the minimum element quality reaches this value */
+  targetQuality?: number;
+  /**
+   * Stop repeating once a run changes the vertex count by at most this
+   * fraction (e.g. 0.02 for 2%)
+   */
+  vertexTolerance?: number;
+  /** Fail the pipeline if the stage ends below this minimum quality */
+  minQuality?: number;
+}
+
+/**
+ * Outcome of one pipeline stage
+ */
+export interface PipelineStageReport {
+  /** Index of the stage in the pipeline */
+  stage: number;
+  /** Remesh runs performed */
+  iterations: number;
+  /** Whether a stopping criterion ended the stage before its last run */
+  converged: boolean;
+  /** Number of vertices after the stage */
+  nVertices: number;
+  /** Number of cells after the stage */
+  nCells: number;
+  /** Minimum quality before the first run of the stage */
+  qualityBefore: number;
+  /** Minimum quality after the last run of the stage */
+  qualityAfter: number;
+  /** Elapsed time of the stage in milliseconds */
+  elapsed: number;
+}
+
+/**
+ * Serialized pipeline result: the final mesh and overall statistics, plus a
+ * report per stage
+ */
+export interface SerializedPipelineResult extends SerializedRemeshResult {
+  stages: PipelineStageReport[];
 }
 
 /**
@@ -81,15 +178,58 @@ export interface RemeshMessage {
   payload: {
     meshData: SerializedMeshData;
     options?: RemeshOptions;
+    /** Send the result mesh back packed for display (see MeshWorker.preview) */
+    pack?: PackOptions;
   };
 }
 
+/**
+ * Remesh of a mesh sent as an MMG binary file, for meshes whose references
+ * and required entities must survive the transfer (see
+ * MeshWorker.remeshBuffer)
+ */
+export interface RemeshBufferMessage {
+  type: "remeshBuffer";
+  id: string;
+  payload: {
+    /** Mesh in .meshb format, transferred */
+    buffer: ArrayBuffer;
+    meshType: MeshType;
+    options?: RemeshOptions;
+    /** Metric at the vertices of the mesh, transferred */
+    metric?: Float64Array;
+  };
+}
+
+export interface PipelineMessage {
+  type: "pipeline";
+  id: string;
+  payload: {
+    meshData: SerializedMeshData;
+    stages: PipelineStage[];
+  };
+}
+
+/**
+ * Compiled WASM module of the main thread, sent before any other request so
+ * the worker instantiates it instead of compiling the binary again
+ */
+export interface InitMessage {
+  type: "init";
+  payload: CompiledModule;
+}
+
 export interface CancelMessage {
   type: "cancel";
   id?: string;
 }
 
-export type WorkerRequestMessage = RemeshMessage | CancelMessage;
+export type WorkerRequestMessage =
+  | InitMessage
+  | RemeshMessage
+  | RemeshBufferMessage
+  | PipelineMessage
+  | CancelMessage;
 
 // =====================
 // Message types: Worker -> Main
@@ -98,7 +238,11 @@ export type WorkerRequestMessage = RemeshMessage | CancelMessage;
 export interface ResultMessage {
   type: "result";
   id: string;
-  payload: SerializedRemeshResult;
+  payload:
+    | SerializedRemeshResult
+    | SerializedPipelineResult
+    | SerializedPreviewResult
+    | SerializedBufferResult;
 }
 
 export interface ProgressMessage {
@@ -3,11 +3,17 @@
  *
  * Run with: bun test test/benchmark.test.ts
  *
- * These benchmarks measure the performance of remeshing operations
- * on various mesh sizes to track performance regressions.
+ * These benchmarks are a quick wall-clock check of remeshing operations on a
+ * few mesh sizes. The full suite, with per-phase timings and baseline
+ * comparison, is bench/run.ts (bun run bench).
  */
 
 import { describe, expect, it } from "bun:test";
+import {
+  generateCubeMesh,
+  generateSphereMesh,
+  generateSquareMesh,
+} from "../bench/fixtures";
 import { Mesh, MeshType, type RemeshResult } from "../src";
 
 interface BenchmarkResult {
@@ -21,130 +27,6 @@ interface BenchmarkResult {
   throughput: number;
 }
 
-/**
- * Generate a simple cube mesh for 3D benchmarks
- */
-function generateCubeMesh(gridSize: number): {
-  vertices: Float64Array;
-  cells: Int32Array;
-} {
-  const n = gridSize;
-  const vertices: number[] = [];
-  const tetrahedra: number[] = [];
-
-  for (let i = 0; i <= n; i++) {
-    for (let j = 0; j <= n; j++) {
-      for (let k = 0; k <= n; k++) {
-        vertices.push(i / n, j / n, k / n);
-      }
-    }
-  }
-
-  const idx = (i: number, j: number, k: number) =>
-    i * (n + 1) * (n + 1) + j * (n + 1) + k + 1;
-
-  for (let i = 0; i < n; i++) {
-    for (let j = 0; j < n; j++) {
-      for (let k = 0; k < n; k++) {
-        const v0 = idx(i, j, k);
-        const v1 = idx(i + 1, j, k);
-        const v2 = idx(i + 1, j + 1, k);
-        const v3 = idx(i, j + 1, k);
-        const v4 = idx(i, j, k + 1);
-        const v6 = idx(i + 1, j + 1, k + 1);
-        const v7 = idx(i, j + 1, k + 1);
-
-        tetrahedra.push(v0, v1, v3, v4);
-        tetrahedra.push(v1, v2, v3, v6);
-        tetrahedra.push(v3, v4, v6, v7);
-        tetrahedra.push(v1, v3, v4, v6);
-      }
-    }
-  }
-
-  return {
-    vertices: new Float64Array(vertices),
-    cells: new Int32Array(tetrahedra),
-  };
-}
-
-/**
- * Generate a 2D square mesh
- */
-function generateSquareMesh(gridSize: number): {
-  vertices: Float64Array;
-  cells: Int32Array;
-} {
-  const n = gridSize;
-  const vertices: number[] = [];
-  const triangles: number[] = [];
-
-  for (let i = 0; i <= n; i++) {
-    for (let j = 0; j <= n; j++) {
-      vertices.push(i / n, j / n);
-    }
-  }
-
-  const idx = (i: number, j: number) => i * (n + 1) + j + 1;
-
-  for (let i = 0; i < n; i++) {
-    for (let j = 0; j < n; j++) {
-      const v0 = idx(i, j);
-      const v1 = idx(i + 1, j);
-      const v2 = idx(i + 1, j + 1);
-      const v3 = idx(i, j + 1);
-
-      triangles.push(v0, v1, v2);
-      triangles.push(v0, v2, v3);
-    }
-  }
-
-  return {
-    vertices: new Float64Array(vertices),
-    cells: new Int32Array(triangles),
-  };
-}
-
-/**
- * Generate a surface mesh (sphere approximation)
- */
-function generateSphereMesh(segments: number): {
-  vertices: Float64Array;
-  cells: Int32Array;
-} {
-  const vertices: number[] = [];
-  const triangles: number[] = [];
-
-  for (let i = 0; i <= segments; i++) {
-    const theta = (i * Math.PI) / segments;
-    for (let j = 0; j <= segments; j++) {
-      const phi = (j * 2 * Math.PI) / segments;
-      vertices.push(
-        Math.sin(theta) * Math.cos(phi),
-        Math.sin(theta) * Math.sin(phi),
-        Math.cos(theta)
-      );
-    }
-  }
-
-  for (let i = 0; i < segments; i++) {
-    for (let j = 0; j < segments; j++) {
-      const v0 = i * (segments + 1) + j + 1;
-      const v1 = v0 + segments + 1;
-      const v2 = v0 + 1;
-      const v3 = v1 + 1;
-
-      triangles.push(v0, v1, v2);
-      triangles.push(v2, v1, v3);
-    }
-  }
-
-  return {
-    vertices: new Float64Array(vertices),
-    cells: new Int32Array(triangles),
-  };
-}
-
 async function runBenchmark(
   createMesh: () => { vertices: Float64Array; cells: Int32Array },
   meshType: MeshType,
@@ -752,4 +752,299 @@ describe("File I/O", () => {
       });
     });
   });
+
+  describe("In-memory I/O", () => {
+    // Split data into a stream of fixed-size chunks
+    const chunkedStream = (
+      data: Uint8Array,
+      chunkSize: number,
+    ): ReadableStream<Uint8Array> => {
+      let offset = 0;
+      return new ReadableStream({
+        pull(controller) {
+          if (offset >= data.length) {
+            controller.close();
+            return;
+          }
+          controller.enqueue(data.slice(offset, offset + chunkSize));
+          offset += chunkSize;
+        },
+      });
+    };
+
+    describe("MMG3D", () => {
+      const handles: MeshHandle[] = [];
+      const cubeData = new Uint8Array(
+        readFileSync(join(__dirname, "fixtures", "cube.mesh")),
+      );
+
+      beforeAll(async () => {
+        await initMMG3D();
+      });
+
+      afterEach(() => {
+        for (const handle of handles) {
+          try {
+            MMG3D.free(handle);
+          } catch {
+            // Ignore errors from already-freed handles
+          }
+        }
+        handles.length = 0;
+      });
+
+      const loadFromFile = (path: string, data: Uint8Array): MeshHandle => {
+        const FS = getFS();
+        FS.writeFile(path, data);
+        const handle = MMG3D.init();
+        handles.push(handle);
+        MMG3D.setIParam(handle, IPARAM.verbose, -1);
+        MMG3D.loadMesh(handle, path);
+        FS.unlink(path);
+        return handle;
+      };
+
+      it("should load an ASCII mesh from a buffer", () => {
+        const expected = loadFromFile("/cube.mesh", cubeData);
+
+        const handle = MMG3D.init();
+        handles.push(handle);
+        MMG3D.setIParam(handle, IPARAM.verbose, -1);
+        MMG3D.loadMeshFromBuffer(handle, cubeData);
+
+        expect(MMG3D.getMeshSize(handle)).toEqual(MMG3D.getMeshSize(expected));
+        expect(MMG3D.getVertices(handle)).toEqual(MMG3D.getVertices(expected));
+        expect(MMG3D.getTetrahedra(handle)).toEqual(
+          MMG3D.getTetrahedra(expected),
+        );
+      });
+
+      it("should load a binary mesh from a buffer", () => {
+        const FS = getFS();
+        const source = loadFromFile("/cube.mesh", cubeData);
+        MMG3D.saveMesh(source, "/cube.meshb");
+        const binaryData = FS.readFile("/cube.meshb", { encoding: "binary" });
+        FS.unlink("/cube.meshb");
+
+        const handle = MMG3D.init();
+        handles.push(handle);
+        MMG3D.setIParam(handle, IPARAM.verbose, -1);
+        MMG3D.loadMeshFromBuffer(handle, binaryData, "meshb");
+
+        expect(MMG3D.getMeshSize(handle)).toEqual(MMG3D.getMeshSize(source));
+        expect(MMG3D.getVertices(handle)).toEqual(MMG3D.getVertices(source));
+      });
+
+      it("should load a mesh from a chunked stream", async () => {
+        const expected = loadFromFile("/cube.mesh", cubeData);
+
+        const handle = MMG3D.init();
+        handles.push(handle);
+        MMG3D.setIParam(handle, IPARAM.verbose, -1);
+        await MMG3D.loadMeshFromStream(handle, chunkedStream(cubeData, 97));
+
+        expect(MMG3D.getMeshSize(handle)).toEqual(MMG3D.getMeshSize(expected));
+        expect(MMG3D.getVertices(handle)).toEqual(MMG3D.getVertices(expected));
+      });
+
+      it("should not touch the virtual filesystem", () => {
+        const FS = getFS();
+        const before = FS.readdir("/");
+
+        const handle = MMG3D.init();
+        handles.push(handle);
+        MMG3D.setIParam(handle, IPARAM.verbose, -1);
+        MMG3D.loadMeshFromBuffer(handle, cubeData);
+
+        expect(FS.readdir("/")).toEqual(before);
+      });
+
+      it("should save a mesh to the same bytes as a file", () => {
+        const FS = getFS();
+        const source = loadFromFile("/cube.mesh", cubeData);
+
+        for (const format of ["mesh", "meshb"] as const) {
+          MMG3D.saveMesh(source, `/saved.${format}`);
+          const expected = FS.readFile(`/saved.${format}`, {
+            encoding: "binary",
+          });
+          FS.unlink(`/saved.${format}`);
+
+          expect(MMG3D.saveMeshToBuffer(source, format)).toEqual(expected);
+        }
+      });
+
+      it("should round-trip a mesh through buffers", () => {
+        const FS = getFS();
+        const source = loadFromFile("/cube.mesh", cubeData);
+        const before = FS.readdir("/");
+
+        for (const format of ["mesh", "meshb"] as const) {
+          const data = MMG3D.saveMeshToBuffer(source, format);
+
+          const handle = MMG3D.init();
+          handles.push(handle);
+          MMG3D.setIParam(handle, IPARAM.verbose, -1);
+          MMG3D.loadMeshFromBuffer(handle, data, format);
+
+          expect(MMG3D.getMeshSize(handle)).toEqual(MMG3D.getMeshSize(source));
+          expect(MMG3D.getVertices(handle)).toEqual(MMG3D.getVertices(source));
+        }
+        expect(FS.readdir("/")).toEqual(before);
+      });
+
+      it("should save a solution to a buffer", () => {
+        const FS = getFS();
+        const handle = loadFromFile("/cube.mesh", cubeData);
+        const nVertices = MMG3D.getMeshSize(handle).nVertices;
+        MMG3D.setSolSize(handle, SOL_ENTITY.VERTEX, nVertices, SOL_TYPE.SCALAR);
+        MMG3D.setScalarSols(
+          handle,
+          new Float64Array(nVertices).map((_, i) => 0.1 + i * 0.01),
+        );
+
+        for (const format of ["sol", "solb"] as const) {
+          const data = MMG3D.saveSolToBuffer(handle, format);
+          expect(data.length).toBeGreaterThan(0);
+
+          MMG3D.saveSol(handle, `/saved.${format}`);
+          const expected = FS.readFile(`/saved.${format}`, {
+            encoding: "binary",
+          });
+          FS.unlink(`/saved.${format}`);
+          expect(data).toEqual(expected);
+        }
+      });
+
+      it("should throw for an empty or invalid buffer", () => {
+        const handle = MMG3D.init();
+        handles.push(handle);
+        MMG3D.setIParam(handle, IPARAM.verbose, -1);
+
+        expect(() =>
+          MMG3D.loadMeshFromBuffer(handle, new Uint8Array(0)),
+        ).toThrow();
+        expect(() =>
+          MMG3D.loadMeshFromBuffer(-1 as MeshHandle, cubeData),
+        ).toThrow();
+        expect(() => MMG3D.saveMeshToBuffer(-1 as MeshHandle)).toThrow();
+      });
+    });
+
+    describe("MMG2D", () => {
+      const handles: MeshHandle2D[] = [];
+
+      beforeAll(async () => {
+        await initMMG2D();
+      });
+
+      afterEach(() => {
+        for (const handle of handles) {
+          MMG2D.free(handle);
+        }
+        handles.length = 0;
+      });
+
+      it("should load a mesh from a buffer and a stream", async () => {
+        const data = new Uint8Array(
+          readFileSync(join(__dirname, "fixtures", "square.mesh")),
+        );
+
+        const fromBuffer = MMG2D.init();
+        handles.push(fromBuffer);
+        MMG2D.setIParam(fromBuffer, IPARAM_2D.verbose, -1);
+        MMG2D.loadMeshFromBuffer(fromBuffer, data);
+
+        const fromStream = MMG2D.init();
+        handles.push(fromStream);
+        MMG2D.setIParam(fromStream, IPARAM_2D.verbose, -1);
+        await MMG2D.loadMeshFromStream(fromStream, chunkedStream(data, 64));
+
+        const size = MMG2D.getMeshSize(fromBuffer);
+        expect(size.nVertices).toBeGreaterThan(0);
+        expect(size.nTriangles).toBeGreaterThan(0);
+        expect(MMG2D.getMeshSize(fromStream)).toEqual(size);
+      });
+
+      it("should round-trip a mesh through a buffer", () => {
+        const data = new Uint8Array(
+          readFileSync(join(__dirname, "fixtures", "square.mesh")),
+        );
+        const source = MMG2D.init();
+        handles.push(source);
+        MMG2D.setIParam(source, IPARAM_2D.verbose, -1);
+        MMG2D.loadMeshFromBuffer(source, data);
+
+        for (const format of ["mesh", "meshb"] as const) {
+          const handle = MMG2D.init();
+          handles.push(handle);
+          MMG2D.setIParam(handle, IPARAM_2D.verbose, -1);
+          MMG2D.loadMeshFromBuffer(
+            handle,
+            MMG2D.saveMeshToBuffer(source, format),
+            format,
+          );
+          expect(MMG2D.getMeshSize(handle)).toEqual(MMG2D.getMeshSize(source));
+        }
+      });
+    });
+
+    describe("MMGS", () => {
+      const handles: MeshHandleS[] = [];
+
+      beforeAll(async () => {
+        await initMMGS();
+      });
+
+      afterEach(() => {
+        for (const handle of handles) {
+          MMGS.free(handle);
+        }
+        handles.length = 0;
+      });
+
+      it("should load a mesh from a buffer and a stream", async () => {
+        const data = new Uint8Array(
+          readFileSync(join(__dirname, "fixtures", "cube-surface.mesh")),
+        );
+
+        const fromBuffer = MMGS.init();
+        handles.push(fromBuffer);
+        MMGS.setIParam(fromBuffer, IPARAM_S.verbose, -1);
+        MMGS.loadMeshFromBuffer(fromBuffer, data);
+
+        const fromStream = MMGS.init();
+        handles.push(fromStream);
+        MMGS.setIParam(fromStream, IPARAM_S.verbose, -1);
+        await MMGS.loadMeshFromStream(fromStream, chunkedStream(data, 64));
+
+        const size = MMGS.getMeshSize(fromBuffer);
+        expect(size.nVertices).toBeGreaterThan(0);
+        expect(size.nTriangles).toBeGreaterThan(0);
+        expect(MMGS.getMeshSize(fromStream)).toEqual(size);
+      });
+
+      it("should round-trip a mesh through a buffer", () => {
+        const data = new Uint8Array(
+          readFileSync(join(__dirname, "fixtures", "cube-surface.mesh")),
+        );
+        const source = MMGS.init();
+        handles.push(source);
+        MMGS.setIParam(source, IPARAM_S.verbose, -1);
+        MMGS.loadMeshFromBuffer(source, data);
+
+        for (const format of ["mesh", "meshb"] as const) {
+          const handle = MMGS.init();
+          handles.push(handle);
+          MMGS.setIParam(handle, IPARAM_S.verbose, -1);
+          MMGS.loadMeshFromBuffer(
+            handle,
+            MMGS.saveMeshToBuffer(source, format),
+            format,
+          );
+          expect(MMGS.getMeshSize(handle)).toEqual(MMGS.getMeshSize(source));
+        }
+      });
+    });
+  });
 });
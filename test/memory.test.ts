@@ -1,4 +1,5 @@
 import { beforeAll, beforeEach, describe, expect, it, mock } from "bun:test";
+import { getWasmVariant } from "../src/loader";
 import {
   MemoryError,
   checkMemoryAvailable,
@@ -9,12 +10,30 @@ import {
   fromWasmInt32,
   fromWasmUint32,
   getMemoryStats,
+  isHeapViewValid,
+  releaseScratchMemory,
+  reserveMemory,
   resetMemoryTracking,
+  resetNativePeak,
+  scratchMemory,
   toWasmFloat64,
   toWasmInt32,
   toWasmUint32,
 } from "../src/memory";
-import { type MMG3DModule, getWasmModule, initMMG3D } from "../src/mmg3d";
+import {
+  pointerSize,
+  readPointerSignatures,
+  wrapPointerExports,
+} from "../src/memory64";
+import {
+  DPARAM,
+  IPARAM,
+  MMG3D,
+  type MMG3DModule,
+  MMG_RETURN_CODES,
+  getWasmModule,
+  initMMG3D,
+} from "../src/mmg3d";
 
 describe("Memory Utilities", () => {
   let module: MMG3DModule;
@@ -331,6 +350,22 @@ describe("Memory Utilities", () => {
     });
   });
 
+  describe("isHeapViewValid", () => {
+    it("should accept views over the current heap", () => {
+      const view = module.HEAPF64.subarray(0, 4);
+      expect(isHeapViewValid(module, view)).toBe(true);
+    });
+
+    it("should reject views over another buffer", () => {
+      const view = new Float64Array(4);
+      expect(isHeapViewValid(module, view)).toBe(false);
+    });
+
+    it("should accept empty views", () => {
+      expect(isHeapViewValid(module, new Float64Array(0))).toBe(true);
+    });
+  });
+
   describe("getMemoryStats", () => {
     beforeEach(() => {
       resetMemoryTracking(module);
@@ -407,6 +442,85 @@ describe("Memory Utilities", () => {
     });
   });
 
+  describe("Native memory accounting", () => {
+    it("should count MMG's allocations in nativeUsed", () => {
+      const before = getMemoryStats(module).nativeUsed;
+      const handle = MMG3D.init();
+      try {
+        MMG3D.setMeshSize(handle, 10000, 50000, 0, 0, 0, 0);
+        const during = getMemoryStats(module);
+        // 10000 points and 50000 tetrahedra take well over a megabyte
+        expect(during.nativeUsed - before).toBeGreaterThan(1024 * 1024);
+        expect(during.nativePeak).toBeGreaterThanOrEqual(during.nativeUsed);
+      } finally {
+        MMG3D.free(handle);
+      }
+      expect(getMemoryStats(module).nativeUsed).toBeLessThan(
+        before + 64 * 1024,
+      );
+    });
+
+    it("should restart the peak from the current usage", () => {
+      const handle = MMG3D.init();
+      MMG3D.setMeshSize(handle, 10000, 50000, 0, 0, 0, 0);
+      MMG3D.free(handle);
+      expect(getMemoryStats(module).nativePeak).toBeGreaterThan(
+        getMemoryStats(module).nativeUsed,
+      );
+
+      resetNativePeak(module);
+      const stats = getMemoryStats(module);
+      expect(stats.nativePeak).toBe(stats.nativeUsed);
+    });
+
+    it("should return to its start value after remeshes", () => {
+      const cycle = () => {
+        const handle = MMG3D.init();
+        try {
+          MMG3D.setMeshSize(handle, 4, 1, 0, 4, 0, 0);
+          MMG3D.setVertices(
+            handle,
+            new Float64Array([
+              0, 0, 0, 1, 0, 0, 0.5, 0.866, 0, 0.5, 0.289, 0.816,
+            ]),
+          );
+          MMG3D.setTetrahedra(handle, new Int32Array([1, 2, 3, 4]));
+          MMG3D.setTriangles(
+            handle,
+            new Int32Array([1, 3, 2, 1, 2, 4, 2, 3, 4, 3, 1, 4]),
+          );
+          MMG3D.setIParam(handle, IPARAM.verbose, -1);
+          MMG3D.setDParam(handle, DPARAM.hmax, 0.2);
+          expect(MMG3D.mmg3dlib(handle)).toBe(MMG_RETURN_CODES.SUCCESS);
+        } finally {
+          MMG3D.free(handle);
+        }
+      };
+      // The first remesh leaves the allocations libc keeps for good
+      cycle();
+      const start = getMemoryStats(module).nativeUsed;
+
+      for (let i = 0; i < 5; i++) {
+        cycle();
+      }
+      expect(getMemoryStats(module).nativeUsed).toBe(start);
+    });
+
+    it("should count native memory in checkMemoryAvailable", () => {
+      resetMemoryTracking(module);
+      const handle = MMG3D.init();
+      try {
+        MMG3D.setMeshSize(handle, 10000, 50000, 0, 0, 0, 0);
+        const { nativeUsed, heapMax } = getMemoryStats(module);
+        configureMemory(module, { errorThreshold: nativeUsed / heapMax });
+        expect(() => checkMemoryAvailable(module, 1024)).toThrow(MemoryError);
+      } finally {
+        configureMemory(module, { errorThreshold: 0.95 });
+        MMG3D.free(handle);
+      }
+    });
+  });
+
   describe("Round-trip tests", () => {
     it("should round-trip Float64Array through WASM heap", () => {
       const original = new Float64Array([
@@ -690,6 +804,129 @@ describe("Memory Utilities", () => {
     });
   });
 
+  describe("reserveMemory", () => {
+    it("should grow the heap once for the reserved bytes", () => {
+      const reserved = 8 * 1024 * 1024;
+      expect(reserveMemory(module, module.HEAPU8.byteLength + reserved)).toBe(
+        true,
+      );
+      const heapSize = module.HEAPU8.byteLength;
+
+      // Allocations within the reservation don't grow the heap again
+      const view = module.HEAPU8;
+      const ptr = module._malloc(reserved);
+      expect(module.HEAPU8.byteLength).toBe(heapSize);
+      expect(isHeapViewValid(module, view)).toBe(true);
+      module._free(ptr);
+    });
+
+    it("should accept empty reservations", () => {
+      expect(reserveMemory(module, 0)).toBe(true);
+    });
+
+    it("should fail for reservations beyond the 32-bit heap", () => {
+      const heapSize = module.HEAPU8.byteLength;
+      expect(reserveMemory(module, 8 * 1024 * 1024 * 1024)).toBe(false);
+      expect(module.HEAPU8.byteLength).toBe(heapSize);
+    });
+  });
+
+  describe("scratchMemory", () => {
+    it("should carve 8-byte aligned buffers out of one region", () => {
+      const [a, b, c] = scratchMemory(module, [4, 12, 0]);
+      expect(a % 8).toBe(0);
+      expect(b).toBe(a + 8);
+      expect(c).toBe(b + 16);
+    });
+
+    it("should reuse the region while it is large enough", () => {
+      const [first] = scratchMemory(module, [1024]);
+      const [second] = scratchMemory(module, [16, 512]);
+      expect(second).toBe(first);
+    });
+
+    it("should grow the region without shrinking it", () => {
+      scratchMemory(module, [64]);
+      const [large] = scratchMemory(module, [4 * 1024 * 1024]);
+      expect(large).not.toBe(0);
+      expect(scratchMemory(module, [64])[0]).toBe(large);
+      expect(scratchMemory(module, [2 * 1024 * 1024])[0]).toBe(large);
+    });
+
+    it("should not count towards tracked allocations", () => {
+      resetMemoryTracking(module);
+      scratchMemory(module, [256 * 1024]);
+      expect(getMemoryStats(module).heapUsed).toBe(0);
+    });
+
+    // Heap that records its allocations, to see what scratchMemory keeps
+    const createHeap = () => {
+      const live = new Map<number, number>();
+      let next = 8;
+      return {
+        live,
+        _malloc: (bytes: number) => {
+          const ptr = next;
+          next += bytes;
+          live.set(ptr, bytes);
+          return ptr;
+        },
+        _free: (ptr: number) => {
+          live.delete(ptr);
+        },
+      };
+    };
+
+    it("should free transfers above 16 MB on the next call", () => {
+      const heap = createHeap();
+      const fake = heap as unknown as MMG3DModule;
+      const [small] = scratchMemory(fake, [64]);
+      const [huge] = scratchMemory(fake, [32 * 1024 * 1024]);
+      expect(huge).not.toBe(small);
+      expect(heap.live.get(huge)).toBe(32 * 1024 * 1024);
+
+      expect(scratchMemory(fake, [64])[0]).toBe(small);
+      expect(heap.live.has(huge)).toBe(false);
+      expect(heap.live.size).toBe(1);
+    });
+
+    it("should not grow the region past 16 MB", () => {
+      const heap = createHeap();
+      const fake = heap as unknown as MMG3DModule;
+      scratchMemory(fake, [12 * 1024 * 1024]);
+      const [region] = scratchMemory(fake, [14 * 1024 * 1024]);
+      expect(heap.live.get(region)).toBe(16 * 1024 * 1024);
+    });
+
+    it("should give the region back on release", () => {
+      const heap = createHeap();
+      const fake = heap as unknown as MMG3DModule;
+      scratchMemory(fake, [1024]);
+      scratchMemory(fake, [20 * 1024 * 1024]);
+      releaseScratchMemory(fake);
+      expect(heap.live.size).toBe(0);
+      releaseScratchMemory(fake);
+      expect(scratchMemory(fake, [64])[0]).not.toBe(0);
+    });
+
+    it("should release the region along with the last mesh", () => {
+      const last = MMG3D.getAvailableHandles() === MMG3D.getMaxHandles();
+      const handle = MMG3D.init();
+      const [ptr] = scratchMemory(module, [1024]);
+      const freed = mock(module._free);
+      const original = module._free;
+      module._free = freed;
+      try {
+        MMG3D.free(handle);
+      } finally {
+        module._free = original;
+      }
+      // Only the last mesh takes it along
+      const released = freed.mock.calls.some(([freedPtr]) => freedPtr === ptr);
+      expect(released).toBe(last);
+    });
+  });
+
   describe("resetMemoryTracking", () => {
     it("should reset heapUsed to 0", () => {
       const data = new Float64Array(1000);
@@ -1208,3 +1445,30 @@ describe("Memory Utilities", () => {
     });
   });
 });
+
+describe("Memory64 pointers", () => {
+  // (module (func (export "f") (param i64 i32) (result i64) local.get 0))
+  const binary = new Uint8Array([
+    0, 97, 115, 109, 1, 0, 0, 0, 1, 7, 1, 96, 2, 126, 127, 1, 126, 3, 2, 1, 0,
+    7, 5, 1, 1, 102, 0, 0, 10, 6, 1, 4, 0, 32, 0, 11,
+  ]);
+
+  it("should read the i64 parameters and results of exports", () => {
+    expect(readPointerSignatures(binary)).toEqual({ f: "ppi" });
+  });
+
+  it("should convert i64 values to and from numbers", async () => {
+    const { instance } = await WebAssembly.instantiate(binary);
+    const wrapped: Record<string, unknown> = { _f: instance.exports.f };
+    wrapPointerExports(wrapped, readPointerSignatures(binary));
+    const f = wrapped._f as (ptr: number, value: number) => number;
+    expect(f(8, 1)).toBe(8);
+    expect(f(2 ** 40, 1)).toBe(2 ** 40);
+  });
+
+  it("should report the pointer size of the build", async () => {
+    await initMMG3D();
+    const expected = getWasmVariant() === "memory64" ? 8 : 4;
+    expect(pointerSize(getWasmModule())).toBe(expected);
+  });
+});
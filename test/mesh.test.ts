@@ -1,7 +1,13 @@
 import { afterEach, beforeAll, describe, expect, it } from "bun:test";
 import { readFileSync } from "node:fs";
 import { join } from "node:path";
-import { Mesh, MeshType, RemeshPresets } from "../src";
+import {
+  MemoryCacheStore,
+  Mesh,
+  MeshType,
+  RemeshCache,
+  RemeshPresets,
+} from "../src";
 import { initMMG2D } from "../src/mmg2d";
 import { initMMG3D } from "../src/mmg3d";
 import { initMMGS } from "../src/mmgs";
@@ -164,6 +170,25 @@ describe("Mesh Class", () => {
       expect(cells).toBeInstanceOf(Int32Array);
       expect(cells.length).toBe(24); // 6 tetrahedra * 4 vertices
     });
+
+    it("should accept references and a metric in the constructor", () => {
+      const metric = new Float64Array(8).fill(0.5);
+      const mesh = new Mesh({
+        vertices: cubeVertices,
+        cells: cubeTetrahedra,
+        boundaryFaces: cubeTriangles,
+        vertexRefs: new Int32Array(8).fill(1),
+        cellRefs: new Int32Array(6).fill(2),
+        boundaryRefs: new Int32Array(12).fill(3),
+        metric,
+      });
+      meshes.push(mesh);
+
+      expect(mesh.nVertices).toBe(8);
+      expect(mesh.nCells).toBe(6);
+      expect(mesh.nBoundaryFaces).toBe(12);
+      expect(Array.from(mesh.vertices)).toEqual(Array.from(cubeVertices));
+    });
   });
 
   describe("Mesh.create() async factory", () => {
@@ -261,6 +286,34 @@ describe("Mesh Class", () => {
     });
   });
 
+  describe("Mesh.load() from stream", () => {
+    it("should load a mesh streamed in small chunks", async () => {
+      const data = new Uint8Array(
+        readFileSync(join(__dirname, "fixtures", "cube.mesh")),
+      );
+      let offset = 0;
+      const stream = new ReadableStream<Uint8Array>({
+        pull(controller) {
+          if (offset >= data.length) {
+            controller.close();
+            return;
+          }
+          controller.enqueue(data.slice(offset, offset + 128));
+          offset += 128;
+        },
+      });
+
+      const mesh = await Mesh.load(stream);
+      meshes.push(mesh);
+      const expected = await Mesh.load(data);
+      meshes.push(expected);
+
+      expect(mesh.type).toBe(MeshType.Mesh3D);
+      expect(mesh.nVertices).toBe(expected.nVertices);
+      expect(mesh.nCells).toBe(expected.nCells);
+    });
+  });
+
   describe("toArrayBuffer() export", () => {
     beforeAll(async () => {
       await initMMG3D();
@@ -392,6 +445,16 @@ describe("Mesh Class", () => {
         });
       }).toThrow();
     });
+
+    it("should throw for references that do not match the cells", () => {
+      expect(() => {
+        new Mesh({
+          vertices: cubeVertices,
+          cells: cubeTetrahedra,
+          cellRefs: new Int32Array(5),
+        });
+      }).toThrow();
+    });
   });
 
   describe("Surface mesh specific", () => {
@@ -548,6 +611,23 @@ describe("Mesh Class", () => {
         expect(result.qualityImprovement).toBeGreaterThan(0);
       });
 
+      it("should report quality statistics", () => {
+        const mesh = new Mesh({
+          vertices: cubeVertices,
+          cells: cubeTetrahedra,
+          boundaryFaces: cubeTriangles,
+        });
+        meshes.push(mesh);
+
+        const stats = mesh.getQualityStats(5);
+        expect(stats.count).toBe(mesh.nCells);
+        expect(stats.min).toBeGreaterThan(0);
+        expect(stats.min).toBeLessThanOrEqual(stats.mean);
+        expect(stats.mean).toBeLessThanOrEqual(stats.max);
+        expect(stats.max).toBeLessThanOrEqual(1);
+        expect(stats.histogram.length).toBe(5);
+      });
+
       it("should improve quality with optimization mode", async () => {
         const mesh = new Mesh({
           vertices: cubeVertices,
@@ -567,6 +647,135 @@ describe("Mesh Class", () => {
       });
     });
 
+    describe("Progress and cancellation", () => {
+      it("should report progress up to completion", async () => {
+        const mesh = new Mesh({
+          vertices: cubeVertices,
+          cells: cubeTetrahedra,
+          boundaryFaces: cubeTriangles,
+        });
+        meshes.push(mesh);
+
+        const reported: number[] = [];
+        const result = await mesh.remesh(
+          { hmax: 0.3 },
+          { onProgress: (progress) => reported.push(progress.percent) },
+        );
+        meshes.push(result.mesh);
+
+        expect(result.success).toBe(true);
+        expect(reported.length).toBeGreaterThan(0);
+        expect(reported[reported.length - 1]).toBe(100);
+        for (let i = 1; i < reported.length; i++) {
+          expect(reported[i]).toBeGreaterThanOrEqual(reported[i - 1]);
+        }
+      });
+
+      it("should reject when the signal is already aborted", async () => {
+        const mesh = new Mesh({
+          vertices: cubeVertices,
+          cells: cubeTetrahedra,
+          boundaryFaces: cubeTriangles,
+        });
+        meshes.push(mesh);
+
+        await expect(
+          mesh.remesh({ hmax: 0.3 }, { signal: AbortSignal.abort() }),
+        ).rejects.toThrow("Remeshing aborted");
+      });
+
+      it("should emit trace spans for every step", async () => {
+        const mesh = new Mesh({
+          vertices: cubeVertices,
+          cells: cubeTetrahedra,
+          boundaryFaces: cubeTriangles,
+        });
+        meshes.push(mesh);
+
+        performance.clearMeasures();
+        const result = await mesh.remesh({ hmax: 0.3 }, { trace: "cube" });
+        meshes.push(result.mesh);
+
+        const names = performance
+          .getEntriesByType("measure")
+          .map((entry) => entry.name);
+        expect(names).toContain("cube:clone");
+        expect(names).toContain("cube:quality");
+        expect(names).toContain("cube:remesh");
+        // The MMG phases are only timed by the instrumentation build
+        expect(names.includes("cube:mmg:meshing")).toBe(!!result.stats);
+        performance.clearMeasures();
+      });
+
+      it("should serve repeated remeshes from a cache", async () => {
+        const mesh = new Mesh({
+          vertices: squareVertices,
+          cells: squareTriangles,
+          boundaryFaces: squareEdges,
+        });
+        meshes.push(mesh);
+        const cache = new RemeshCache(new MemoryCacheStore());
+
+        const first = await mesh.remesh({ hsiz: 0.2 }, { cache });
+        meshes.push(first.mesh);
+        expect(first.cached).toBeUndefined();
+
+        const again = await mesh.remesh({ hsiz: 0.2, verbose: -1 }, { cache });
+        meshes.push(again.mesh);
+        expect(again.cached).toBe(true);
+        expect(again.nVertices).toBe(first.nVertices);
+        expect(again.mesh.nCells).toBe(first.mesh.nCells);
+        expect(again.qualityAfter).toBe(first.qualityAfter);
+        // The sizes MMG computed come back with the mesh
+        expect(first.mesh.metric).toBeDefined();
+        expect(again.mesh.metric).toEqual(first.mesh.metric);
+
+        const other = await mesh.remesh({ hsiz: 0.3 }, { cache });
+        meshes.push(other.mesh);
+        expect(other.cached).toBeUndefined();
+      });
+
+      it("should hash the options and sizing constraints", async () => {
+        const mesh = new Mesh({
+          vertices: squareVertices,
+          cells: squareTriangles,
+          boundaryFaces: squareEdges,
+        });
+        meshes.push(mesh);
+
+        const hash = await mesh.contentHash({ hmax: 0.1 });
+        expect(hash).toMatch(/^[0-9a-f]{64}$/);
+        expect(await mesh.contentHash({ hmax: 0.1, verbose: 3 })).toBe(hash);
+        expect(await mesh.contentHash({ hmax: 0.2 })).not.toBe(hash);
+        mesh.setSizeCircle([0.5, 0.5], 0.2, 0.05);
+        expect(await mesh.contentHash({ hmax: 0.1 })).not.toBe(hash);
+      });
+
+      it("should count MMG operations when instrumented", async () => {
+        const mesh = new Mesh({
+          vertices: cubeVertices,
+          cells: cubeTetrahedra,
+          boundaryFaces: cubeTriangles,
+        });
+        meshes.push(mesh);
+
+        const result = await mesh.remesh({ hmax: 0.3 });
+        meshes.push(result.mesh);
+        if (!result.stats) {
+          expect(result.nSwapped).toBe(0);
+          return;
+        }
+        const { phases, splits, swaps, moves, wavefronts } = result.stats;
+        expect(splits).toBeGreaterThan(0);
+        expect(wavefronts).toBeGreaterThan(0);
+        expect(result.nSwapped).toBe(swaps);
+        expect(result.nMoved).toBe(moves);
+        expect(phases.total).toBeGreaterThanOrEqual(
+          phases.analysis + phases.meshing + phases.output,
+        );
+      });
+    });
+
     describe("Remesh with options", () => {
       it("should create finer mesh with small hmax", async () => {
         const mesh = new Mesh({
@@ -676,6 +885,28 @@ describe("Mesh Class", () => {
 
         expect(result.elapsed).toBeGreaterThan(0);
       });
+
+      it("should break the elapsed time down by step", async () => {
+        const mesh = new Mesh({
+          vertices: cubeVertices,
+          cells: cubeTetrahedra,
+          boundaryFaces: cubeTriangles,
+        });
+        meshes.push(mesh);
+
+        const result = await mesh.remesh();
+        meshes.push(result.mesh);
+
+        const { clone, sizing, quality, remesh } = result.timings;
+        expect(remesh).toBeGreaterThan(0);
+        expect(sizing).toBe(0);
+        for (const step of [clone, quality]) {
+          expect(step).toBeGreaterThanOrEqual(0);
+        }
+        expect(clone + sizing + quality + remesh).toBeLessThanOrEqual(
+          result.elapsed + 1e-6,
+        );
+      });
     });
 
     describe("Error handling", () => {
@@ -1035,6 +1266,120 @@ describe("Mesh Class", () => {
       });
     });
 
+    describe("Local remeshing", () => {
+      // Vertices of a 2D mesh with both coordinates above a threshold
+      const verticesAbove = (mesh: Mesh, threshold: number): string[] => {
+        const vertices = mesh.vertices;
+        const kept: string[] = [];
+        for (let i = 0; i < vertices.length; i += 2) {
+          if (vertices[i] > threshold && vertices[i + 1] > threshold) {
+            kept.push(`${vertices[i]},${vertices[i + 1]}`);
+          }
+        }
+        return kept.sort();
+      };
+
+      // Triangles of a 2D mesh with every vertex above a threshold, by the
+      // exact coordinates of their vertices
+      const trianglesAbove = (mesh: Mesh, threshold: number): string[] => {
+        const vertices = mesh.vertices;
+        const cells = mesh.cells;
+        const kept: string[] = [];
+        for (let i = 0; i < cells.length; i += 3) {
+          const corners = [cells[i], cells[i + 1], cells[i + 2]].map((v) => [
+            vertices[2 * (v - 1)],
+            vertices[2 * (v - 1) + 1],
+          ]);
+          if (corners.every(([x, y]) => x > threshold && y > threshold)) {
+            kept.push(
+              corners
+                .map(([x, y]) => `${x},${y}`)
+                .sort()
+                .join(" "),
+            );
+          }
+        }
+        return kept.sort();
+      };
+
+      it("should leave the mesh away from the regions untouched", async () => {
+        const square = new Mesh({
+          vertices: squareVertices,
+          cells: squareTriangles,
+          boundaryFaces: squareEdges,
+        });
+        meshes.push(square);
+        const base = (await square.remesh({ hsiz: 0.1 })).mesh;
+        meshes.push(base);
+
+        base.setSizeCircle([0.1, 0.1], 0.15, 0.02);
+        const result = await base.remesh({ local: true, localMargin: 0.05 });
+        meshes.push(result.mesh);
+
+        expect(result.success).toBe(true);
+        expect(result.nVertices).toBeGreaterThan(base.nVertices);
+        // Numbers print back to the same double, so this is bit for bit
+        expect(verticesAbove(result.mesh, 0.5)).toEqual(
+          verticesAbove(base, 0.5),
+        );
+        expect(trianglesAbove(result.mesh, 0.5)).toEqual(
+          trianglesAbove(base, 0.5),
+        );
+        expect(trianglesAbove(base, 0.5).length).toBeGreaterThan(0);
+      });
+
+      it("should leave no required entities in the result", async () => {
+        const square = new Mesh({
+          vertices: squareVertices,
+          cells: squareTriangles,
+          boundaryFaces: squareEdges,
+        });
+        meshes.push(square);
+        const base = (await square.remesh({ hsiz: 0.1 })).mesh;
+        meshes.push(base);
+
+        base.setSizeCircle([0.1, 0.1], 0.15, 0.02);
+        const local = (await base.remesh({ local: true })).mesh;
+        meshes.push(local);
+
+        // The .mesh export lists required entities in Required* sections
+        const text = new TextDecoder().decode(local.toArrayBuffer("mesh"));
+        expect(text).not.toMatch(/^Required/m);
+      });
+
+      it("should let the result remesh everywhere again", async () => {
+        const square = new Mesh({
+          vertices: squareVertices,
+          cells: squareTriangles,
+          boundaryFaces: squareEdges,
+        });
+        meshes.push(square);
+        const base = (await square.remesh({ hsiz: 0.1 })).mesh;
+        meshes.push(base);
+
+        base.setSizeCircle([0.1, 0.1], 0.15, 0.02);
+        const local = (await base.remesh({ local: true })).mesh;
+        meshes.push(local);
+
+        const coarse = await local.remesh({ hsiz: 0.3 });
+        meshes.push(coarse.mesh);
+        expect(coarse.nVertices).toBeLessThan(base.nVertices);
+      });
+
+      it("should throw without sizing regions", async () => {
+        const mesh = new Mesh({
+          vertices: cubeVertices,
+          cells: cubeTetrahedra,
+          boundaryFaces: cubeTriangles,
+        });
+        meshes.push(mesh);
+
+        await expect(mesh.remesh({ local: true })).rejects.toThrow(
+          "Local remeshing needs at least one sizing region",
+        );
+      });
+    });
+
     describe("setMetric()", () => {
       it("should set isotropic metric on 3D mesh", async () => {
         const mesh = new Mesh({
@@ -1526,4 +1871,295 @@ describe("Mesh Class", () => {
       });
     });
   });
+
+  describe("interpolateFrom()", () => {
+    beforeAll(async () => {
+      await initMMG2D();
+      await initMMG3D();
+    });
+
+    it("should transfer linear fields exactly", async () => {
+      const mesh = new Mesh({
+        vertices: cubeVertices,
+        cells: cubeTetrahedra,
+        boundaryFaces: cubeTriangles,
+      });
+      meshes.push(mesh);
+
+      // Two interleaved fields: f = x + 2y + 3z and -f
+      const linear = (v: Float64Array, i: number) =>
+        v[3 * i] + 2 * v[3 * i + 1] + 3 * v[3 * i + 2];
+      const fields = new Float64Array(mesh.nVertices * 2);
+      for (let i = 0; i < mesh.nVertices; i++) {
+        fields[2 * i] = linear(cubeVertices, i);
+        fields[2 * i + 1] = -linear(cubeVertices, i);
+      }
+
+      const result = await mesh.remesh({ hmax: 0.3 });
+      meshes.push(result.mesh);
+      const values = result.mesh.interpolateFrom(mesh, fields, 2);
+
+      const vertices = result.mesh.vertices;
+      expect(values.length).toBe(result.nVertices * 2);
+      for (let i = 0; i < result.nVertices; i++) {
+        expect(values[2 * i]).toBeCloseTo(linear(vertices, i), 6);
+        expect(values[2 * i + 1]).toBeCloseTo(-linear(vertices, i), 6);
+      }
+    });
+
+    it("should reject mismatched meshes and field sizes", () => {
+      const cube = new Mesh({
+        vertices: cubeVertices,
+        cells: cubeTetrahedra,
+        boundaryFaces: cubeTriangles,
+      });
+      const square = new Mesh({
+        vertices: squareVertices,
+        cells: squareTriangles,
+        boundaryFaces: squareEdges,
+      });
+      meshes.push(cube, square);
+
+      const fields = new Float64Array(square.nVertices);
+      expect(() => cube.interpolateFrom(square, fields)).toThrow();
+      expect(() =>
+        square.interpolateFrom(square, fields.subarray(1)),
+      ).toThrow();
+    });
+  });
+
+  describe("splitSubdomains() and mergeSubdomains()", () => {
+    beforeAll(async () => {
+      await initMMG2D();
+      await initMMG3D();
+    });
+
+    // Cube remeshed finely enough for every part to hold many tetrahedra
+    const createFineCube = async (): Promise<Mesh> => {
+      const cube = new Mesh({
+        vertices: cubeVertices,
+        cells: cubeTetrahedra,
+        boundaryFaces: cubeTriangles,
+      });
+      meshes.push(cube);
+      const fine = (await cube.remesh({ hsiz: 0.2 })).mesh;
+      meshes.push(fine);
+      return fine;
+    };
+
+    it("should split into balanced parts that weld back", async () => {
+      const mesh = await createFineCube();
+
+      const parts = mesh.splitSubdomains(4);
+      meshes.push(...parts);
+      expect(parts.length).toBe(4);
+      const cells = parts.map((part) => part.nCells);
+      expect(cells.reduce((a, b) => a + b, 0)).toBe(mesh.nCells);
+      expect(Math.max(...cells) - Math.min(...cells)).toBeLessThanOrEqual(1);
+      // Interface triangles come on top of the shared boundary
+      const faces = parts.reduce(
+        (total, part) => total + part.nBoundaryFaces,
+        0,
+      );
+      expect(faces).toBeGreaterThan(mesh.nBoundaryFaces);
+
+      const merged = Mesh.mergeSubdomains(parts);
+      meshes.push(merged);
+      expect(merged.nVertices).toBe(mesh.nVertices);
+      expect(merged.nCells).toBe(mesh.nCells);
+      expect(merged.nBoundaryFaces).toBe(mesh.nBoundaryFaces);
+    });
+
+    it("should not add edges along the interfaces", async () => {
+      const mesh = await createFineCube();
+      // Size of a section of the .mesh export
+      const count = (of: Mesh, keyword: string) => {
+        const text = new TextDecoder().decode(of.toArrayBuffer("mesh"));
+        const match = text.match(new RegExp(`^${keyword}\\s+(\\d+)`, "m"));
+        return match ? Number(match[1]) : 0;
+      };
+      expect(count(mesh, "Ridges")).toBeGreaterThan(0);
+
+      // MMG analyses the parts, frozen interfaces included, but keeps them
+      const parts = mesh.splitSubdomains(4);
+      meshes.push(...parts);
+      const remeshed: Mesh[] = [];
+      for (const part of parts) {
+        const result = await part.remesh({
+          noinsert: true,
+          noswap: true,
+          nomove: true,
+          verbose: -1,
+        });
+        meshes.push(result.mesh);
+        remeshed.push(result.mesh);
+      }
+
+      const merged = Mesh.mergeSubdomains(remeshed);
+      meshes.push(merged);
+      expect(merged.nVertices).toBe(mesh.nVertices);
+      expect(count(merged, "Edges")).toBe(count(mesh, "Edges"));
+      expect(count(merged, "Ridges")).toBe(count(mesh, "Ridges"));
+    });
+
+    it("should carry the metric to the parts and back", async () => {
+      const mesh = await createFineCube();
+      mesh.setMetric(new Float64Array(mesh.nVertices).fill(0.05));
+
+      const parts = mesh.splitSubdomains(3);
+      meshes.push(...parts);
+      for (const part of parts) {
+        expect(part.metric).toEqual(
+          new Float64Array(part.nVertices).fill(0.05),
+        );
+      }
+
+      const merged = Mesh.mergeSubdomains(parts);
+      meshes.push(merged);
+      expect(merged.metric).toEqual(
+        new Float64Array(mesh.nVertices).fill(0.05),
+      );
+    });
+
+    it("should size the parts from regions of the whole mesh", async () => {
+      const mesh = await createFineCube();
+      mesh.setSizeSphere([0, 0, 0], 0.5, 0.05);
+
+      const parts = mesh.splitSubdomains(4);
+      meshes.push(...parts);
+      const outside = new Set<number>();
+      for (const part of parts) {
+        const metric = part.metric as Float64Array;
+        const vertices = part.vertices;
+        expect(metric.length).toBe(part.nVertices);
+        for (let i = 0; i < part.nVertices; i++) {
+          const r = Math.hypot(
+            vertices[3 * i],
+            vertices[3 * i + 1],
+            vertices[3 * i + 2],
+          );
+          if (r < 0.5) {
+            expect(metric[i]).toBe(0.05);
+          } else if (r > 0.5) {
+            outside.add(metric[i]);
+          }
+        }
+      }
+      // One default size for every part, from the bounds of the whole mesh
+      expect(outside.size).toBe(1);
+      expect(mesh.localSizeCount).toBe(1);
+    });
+
+    it("should keep interfaces through a .meshb round trip", async () => {
+      const mesh = await createFineCube();
+      const parts = mesh.splitSubdomains(2, 1);
+      meshes.push(...parts);
+
+      const remeshed: Mesh[] = [];
+      for (const part of parts) {
+        const loaded = await Mesh.load(part.toArrayBuffer("meshb"), {
+          type: MeshType.Mesh3D,
+          format: "meshb",
+        });
+        meshes.push(loaded);
+        const result = await loaded.remesh({ hsiz: 0.15 });
+        meshes.push(result.mesh);
+        remeshed.push(result.mesh);
+      }
+
+      const merged = Mesh.mergeSubdomains(remeshed);
+      meshes.push(merged);
+      expect(merged.nCells).toBe(
+        remeshed.reduce((total, part) => total + part.nCells, 0),
+      );
+      expect(merged.getQualityStats().min).toBeGreaterThan(0);
+    });
+
+    it("should reject other mesh types and invalid counts", () => {
+      const square = new Mesh({
+        vertices: squareVertices,
+        cells: squareTriangles,
+        boundaryFaces: squareEdges,
+      });
+      const cube = new Mesh({
+        vertices: cubeVertices,
+        cells: cubeTetrahedra,
+        boundaryFaces: cubeTriangles,
+      });
+      meshes.push(square, cube);
+
+      expect(() => square.splitSubdomains(2)).toThrow(/only available/);
+      expect(() => cube.splitSubdomains(0)).toThrow(/positive integer/);
+      expect(() => Mesh.mergeSubdomains([])).toThrow(/No subdomains/);
+      expect(() => Mesh.mergeSubdomains([square])).toThrow(/only available/);
+    });
+  });
+
+  describe("Mesh.remeshBatch()", () => {
+    beforeAll(async () => {
+      await initMMG2D();
+      await initMMG3D();
+    });
+
+    const square = {
+      vertices: squareVertices,
+      cells: squareTriangles,
+      boundaryFaces: squareEdges,
+    };
+
+    it("should remesh every mesh like a single remesh", async () => {
+      const results = await Mesh.remeshBatch([square, square, square], {
+        hsiz: 0.1,
+      });
+      expect(results.length).toBe(3);
+
+      const mesh = new Mesh(square);
+      meshes.push(mesh);
+      const single = await mesh.remesh({ hsiz: 0.1, verbose: -1 });
+      meshes.push(single.mesh);
+      for (const result of results) {
+        expect(result.success).toBe(true);
+        expect(result.nVertices).toBe(single.nVertices);
+        expect(result.nCells).toBe(single.nCells);
+        expect(result.mesh.vertices.length).toBe(result.nVertices * 2);
+        expect(result.mesh.cells.length).toBe(result.nCells * 3);
+        expect(result.qualityAfter).toBeGreaterThan(0);
+      }
+    });
+
+    it("should return meshes usable with new Mesh()", async () => {
+      const [result] = await Mesh.remeshBatch(
+        [
+          {
+            vertices: cubeVertices,
+            cells: cubeTetrahedra,
+            boundaryFaces: cubeTriangles,
+          },
+        ],
+        { hsiz: 0.3 },
+      );
+      expect(result.success).toBe(true);
+      expect(result.mesh.type).toBe(MeshType.Mesh3D);
+
+      const mesh = new Mesh(result.mesh);
+      meshes.push(mesh);
+      expect(mesh.nVertices).toBe(result.nVertices);
+      expect(mesh.nCells).toBe(result.nCells);
+      expect(mesh.nBoundaryFaces).toBe(result.nBoundaryFaces);
+      expect(mesh.getQualityStats().min).toBeGreaterThan(0);
+    });
+
+    it("should reject mixed types and local remeshing", async () => {
+      expect(await Mesh.remeshBatch([])).toEqual([]);
+      await expect(
+        Mesh.remeshBatch([
+          square,
+          { vertices: cubeVertices, cells: cubeTetrahedra },
+        ]),
+      ).rejects.toThrow(/single type/);
+      await expect(Mesh.remeshBatch([square], { local: true })).rejects.toThrow(
+        /local remeshing/,
+      );
+    });
+  });
 });
@@ -7,8 +7,15 @@ import {
   type MeshHandle2D,
   SOL_ENTITY_2D,
   SOL_TYPE_2D,
+  getWasmModule2D,
   initMMG2D,
 } from "../src/mmg2d";
+import {
+  BoxSizingConstraint,
+  CircleSizingConstraint,
+  SphereSizingConstraint,
+  encodeSizingConstraints,
+} from "../src/sizing";
 
 describe("MMG2D", () => {
   // Track handles for cleanup
@@ -53,8 +60,8 @@ describe("MMG2D", () => {
       expect(() => MMG2D.free(handle)).toThrow();
     });
 
-    it("should report max handles as 64", () => {
-      expect(MMG2D.getMaxHandles()).toBe(64);
+    it("should report max handles as 1024 by default", () => {
+      expect(MMG2D.getMaxHandles()).toBe(1024);
     });
 
     it("should track available handles correctly", () => {
@@ -458,6 +465,101 @@ describe("MMG2D", () => {
     });
   });
 
+  describe("Arena mode", () => {
+    afterEach(() => {
+      MMG2D.setArenaMode(false);
+    });
+
+    it("should remesh and free handles allocating from arenas", () => {
+      MMG2D.setArenaMode(true);
+      for (let i = 0; i < 5; i++) {
+        const handle = MMG2D.init();
+        MMG2D.setMeshSize(handle, 4, 2, 0, 4);
+        MMG2D.setVertices(handle, new Float64Array([0, 0, 1, 0, 1, 1, 0, 1]));
+        MMG2D.setTriangles(handle, new Int32Array([1, 2, 3, 1, 3, 4]));
+        MMG2D.setEdges(handle, new Int32Array([1, 2, 2, 3, 3, 4, 4, 1]));
+        MMG2D.setIParam(handle, IPARAM_2D.verbose, -1);
+        MMG2D.setDParam(handle, DPARAM_2D.hmax, 0.2);
+        expect(MMG2D.mmg2dlib(handle)).toBe(MMG_RETURN_CODES_2D.SUCCESS);
+
+        const clone = MMG2D.clone(handle);
+        const size = MMG2D.getMeshSize(handle);
+        MMG2D.free(handle);
+        expect(MMG2D.getMeshSize(clone)).toEqual(size);
+        expect(MMG2D.getTriangles(clone).length).toBe(size.nTriangles * 3);
+        MMG2D.free(clone);
+      }
+    });
+  });
+
+  describe("Cloning", () => {
+    it("should clone mesh entities and metric into a new handle", () => {
+      const handle = MMG2D.init();
+      handles.push(handle);
+
+      MMG2D.setMeshSize(handle, 4, 2, 0, 4);
+      const vertices = new Float64Array([0, 0, 1, 0, 1, 1, 0, 1]);
+      MMG2D.setVertices(handle, vertices, new Int32Array([1, 2, 3, 4]));
+      MMG2D.setTriangles(handle, new Int32Array([1, 2, 3, 1, 3, 4]));
+      MMG2D.setEdges(handle, new Int32Array([1, 2, 2, 3, 3, 4, 4, 1]));
+      MMG2D.setSolSize(handle, SOL_ENTITY_2D.VERTEX, 4, SOL_TYPE_2D.SCALAR);
+      const metric = new Float64Array([0.1, 0.2, 0.3, 0.4]);
+      MMG2D.setScalarSols(handle, metric);
+
+      const clone = MMG2D.clone(handle);
+      handles.push(clone);
+
+      expect(clone).not.toBe(handle);
+      expect(MMG2D.getMeshSize(clone)).toEqual(MMG2D.getMeshSize(handle));
+      expect(MMG2D.getVertices(clone)).toEqual(vertices);
+      expect(MMG2D.getTriangles(clone)).toEqual(MMG2D.getTriangles(handle));
+      expect(MMG2D.getEdges(clone)).toEqual(MMG2D.getEdges(handle));
+      expect(MMG2D.getScalarSols(clone)).toEqual(metric);
+    });
+
+    it("should throw when cloning an invalid handle", () => {
+      expect(() => MMG2D.clone(-1 as MeshHandle2D)).toThrow();
+    });
+  });
+
+  describe("Zero-copy Views", () => {
+    it("should expose mesh data as views over the WASM heap", () => {
+      const handle = MMG2D.init();
+      handles.push(handle);
+
+      MMG2D.setMeshSize(handle, 4, 2, 0, 4);
+      const vertices = new Float64Array([0, 0, 1, 0, 1, 1, 0, 1]);
+      MMG2D.setVertices(handle, vertices);
+      MMG2D.setTriangles(handle, new Int32Array([1, 2, 3, 1, 3, 4]));
+      MMG2D.setEdges(handle, new Int32Array([1, 2, 2, 3, 3, 4, 4, 1]));
+
+      const view = MMG2D.getVerticesView(handle);
+      expect(view).toEqual(vertices);
+      expect(view.buffer).toBe(getWasmModule2D().HEAPF64.buffer);
+      expect(MMG2D.getTrianglesView(handle)).toEqual(
+        MMG2D.getTriangles(handle),
+      );
+      expect(MMG2D.getEdgesView(handle)).toEqual(MMG2D.getEdges(handle));
+    });
+
+    it("should bump the generation when the mesh changes", () => {
+      const handle = MMG2D.init();
+      handles.push(handle);
+
+      MMG2D.setMeshSize(handle, 3, 1, 0, 0);
+      MMG2D.setVertices(handle, new Float64Array([0, 0, 1, 0, 0, 1]));
+      const before = MMG2D.getGeneration(handle);
+
+      MMG2D.setVertex(handle, 2, 2, 0, 1);
+      expect(MMG2D.getGeneration(handle)).not.toBe(before);
+      expect(MMG2D.getVerticesView(handle)[0]).toBe(2);
+    });
+
+    it("should throw for the generation of an invalid handle", () => {
+      expect(() => MMG2D.getGeneration(-1 as MeshHandle2D)).toThrow();
+    });
+  });
+
   describe("Multiple Handles", () => {
     it("should work with multiple independent meshes", () => {
       const handle1 = MMG2D.init();
@@ -623,4 +725,78 @@ describe("MMG2D", () => {
       expect(newSize.nTriangles).toBeGreaterThan(2);
     });
   });
+
+  describe("Native sizing", () => {
+    it("should evaluate circles and boxes in the plane", () => {
+      const handle = MMG2D.init();
+      handles.push(handle);
+      MMG2D.setMeshSize(handle, 4, 0, 0, 0);
+      const vertices = new Float64Array([0, 0, 1, 0, 1, 1, 0, 1]);
+      MMG2D.setVertices(handle, vertices);
+
+      const constraints = [
+        new CircleSizingConstraint([0, 0], 0.5, 0.05),
+        new BoxSizingConstraint([0.5, 0.5], [1.5, 1.5], 0.1),
+      ];
+      MMG2D.applySizing(handle, encodeSizingConstraints(constraints, 2));
+
+      const sizes = MMG2D.getScalarSols(handle);
+      expect(sizes[0]).toBeCloseTo(0.05);
+      expect(sizes[2]).toBeCloseTo(0.1);
+      // Outside every region: a fifth of the bounding box diagonal
+      expect(sizes[1]).toBeCloseTo(Math.SQRT2 * 0.2);
+      expect(sizes[3]).toBeCloseTo(Math.SQRT2 * 0.2);
+    });
+
+    it("should reject 3D-only constraints", () => {
+      expect(() =>
+        encodeSizingConstraints(
+          [new SphereSizingConstraint([0, 0, 0], 0.5, 0.1)],
+          2,
+        ),
+      ).toThrow(/only works with 3D meshes/);
+    });
+  });
+
+  describe("Point location", () => {
+    // Unit square split along its diagonal, carrying the field x + 2y
+    const createSquare = (): MeshHandle2D => {
+      const handle = MMG2D.init();
+      handles.push(handle);
+      MMG2D.setMeshSize(handle, 4, 2, 0, 0);
+      MMG2D.setVertices(handle, new Float64Array([0, 0, 1, 0, 1, 1, 0, 1]));
+      MMG2D.setTriangles(handle, new Int32Array([1, 2, 3, 1, 3, 4]));
+      MMG2D.setSolSize(handle, SOL_ENTITY_2D.VERTEX, 4, SOL_TYPE_2D.SCALAR);
+      MMG2D.setScalarSols(handle, new Float64Array([0, 1, 3, 2]));
+      return handle;
+    };
+
+    it("should find the triangle containing each point", () => {
+      const handle = createSquare();
+      const points = new Float64Array([0.75, 0.25, 0.25, 0.75, 2, 2]);
+
+      const { elements, barycentric, located } = MMG2D.locatePoints(
+        handle,
+        points,
+      );
+
+      expect(located).toBe(2);
+      expect(Array.from(elements)).toEqual([1, 2, 0]);
+      const expected = [0.25, 0.5, 0.25];
+      for (let i = 0; i < 3; i++) {
+        expect(barycentric[i]).toBeCloseTo(expected[i]);
+      }
+    });
+
+    it("should interpolate the solution at arbitrary points", () => {
+      const handle = createSquare();
+      const points = new Float64Array([0.75, 0.25, 0.5, 0.5, -1, 0]);
+
+      const values = MMG2D.sampleSolution(handle, points);
+
+      expect(values[0]).toBeCloseTo(1.25);
+      expect(values[1]).toBeCloseTo(1.5);
+      expect(values[2]).toBeNaN();
+    });
+  });
 });
@@ -1,4 +1,5 @@
 import { afterEach, beforeAll, describe, expect, it } from "bun:test";
+import { getMemoryStats, isHeapViewValid } from "../src/memory";
 import {
   DPARAM,
   IPARAM,
@@ -7,8 +8,18 @@ import {
   type MeshHandle,
   SOL_ENTITY,
   SOL_TYPE,
+  getWasmModule,
   initMMG3D,
 } from "../src/mmg3d";
+import { decodePackedMesh } from "../src/packed";
+import {
+  BoxSizingConstraint,
+  CylinderSizingConstraint,
+  SIZING_STRIDE,
+  SphereSizingConstraint,
+  combineSizingConstraints,
+  encodeSizingConstraints,
+} from "../src/sizing";
 
 describe("MMG3D", () => {
   // Track handles for cleanup
@@ -53,8 +64,40 @@ describe("MMG3D", () => {
       expect(() => MMG3D.free(handle)).toThrow();
     });
 
-    it("should report max handles as 64", () => {
-      expect(MMG3D.getMaxHandles()).toBe(64);
+    it("should report max handles as 1024 by default", () => {
+      expect(MMG3D.getMaxHandles()).toBe(1024);
+    });
+
+    it("should allocate more than 64 handles at once", () => {
+      for (let i = 0; i < 100; i++) {
+        handles.push(MMG3D.init());
+      }
+      expect(new Set(handles).size).toBe(100);
+    });
+
+    it("should reuse the most recently freed handle", () => {
+      const handle = MMG3D.init();
+      MMG3D.free(handle);
+      const reused = MMG3D.init();
+      handles.push(reused);
+      expect(reused).toBe(handle);
+    });
+
+    it("should change the max handles with setMaxHandles", () => {
+      const previous = MMG3D.getMaxHandles();
+      try {
+        MMG3D.setMaxHandles(2048);
+        expect(MMG3D.getMaxHandles()).toBe(2048);
+        expect(() => MMG3D.setMaxHandles(0)).toThrow();
+        expect(() => MMG3D.setMaxHandles(65537)).toThrow();
+      } finally {
+        MMG3D.setMaxHandles(previous);
+      }
+    });
+
+    it("should not lower max handles below the slots in use", () => {
+      handles.push(MMG3D.init(), MMG3D.init());
+      expect(() => MMG3D.setMaxHandles(1)).toThrow();
     });
 
     it("should track available handles correctly", () => {
@@ -394,6 +437,321 @@ describe("MMG3D", () => {
       const newTetra = MMG3D.getTetrahedra(handle);
       expect(newTetra.length).toBe(newSize.nTetrahedra * 4);
     });
+
+    it("should remesh several handles with mmg3dlibAsync", async () => {
+      const setup = (): MeshHandle => {
+        const handle = MMG3D.init();
+        handles.push(handle);
+        MMG3D.setMeshSize(handle, 4, 1, 0, 4, 0, 0);
+        MMG3D.setVertices(
+          handle,
+          new Float64Array([
+            0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.5, 0.866, 0.0, 0.5, 0.289, 0.816,
+          ]),
+        );
+        MMG3D.setTetrahedra(handle, new Int32Array([1, 2, 3, 4]));
+        MMG3D.setTriangles(
+          handle,
+          new Int32Array([1, 3, 2, 1, 2, 4, 2, 3, 4, 3, 1, 4]),
+        );
+        MMG3D.setIParam(handle, IPARAM.verbose, -1);
+        MMG3D.setDParam(handle, DPARAM.hmax, 0.3);
+        return handle;
+      };
+
+      const handle1 = setup();
+      const handle2 = setup();
+      const results = await Promise.all([
+        MMG3D.mmg3dlibAsync(handle1),
+        MMG3D.mmg3dlibAsync(handle2),
+      ]);
+
+      expect(results).toEqual([
+        MMG_RETURN_CODES.SUCCESS,
+        MMG_RETURN_CODES.SUCCESS,
+      ]);
+      expect(MMG3D.getMeshSize(handle1).nVertices).toBeGreaterThan(4);
+      expect(MMG3D.getMeshSize(handle2)).toEqual(MMG3D.getMeshSize(handle1));
+    });
+
+    it("should reject mmg3dlibAsync on an invalid handle", async () => {
+      await expect(MMG3D.mmg3dlibAsync(-1 as MeshHandle)).rejects.toThrow();
+    });
+
+    it("should report idle progress before any remesh", () => {
+      const handle = MMG3D.init();
+      handles.push(handle);
+      expect(MMG3D.getProgress(handle)).toEqual({
+        phase: "idle",
+        percent: 0,
+        iterations: 0,
+      });
+    });
+
+    it("should report the phases of a tracked remesh", () => {
+      const handle = MMG3D.init();
+      handles.push(handle);
+      MMG3D.setMeshSize(handle, 4, 1, 0, 4, 0, 0);
+      MMG3D.setVertices(
+        handle,
+        new Float64Array([
+          0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.5, 0.866, 0.0, 0.5, 0.289, 0.816,
+        ]),
+      );
+      MMG3D.setTetrahedra(handle, new Int32Array([1, 2, 3, 4]));
+      MMG3D.setTriangles(
+        handle,
+        new Int32Array([1, 3, 2, 1, 2, 4, 2, 3, 4, 3, 1, 4]),
+      );
+      MMG3D.setIParam(handle, IPARAM.verbose, -1);
+      MMG3D.setDParam(handle, DPARAM.hmax, 0.3);
+      MMG3D.setProgressTracking(handle, true);
+
+      expect(MMG3D.mmg3dlib(handle)).toBe(MMG_RETURN_CODES.SUCCESS);
+      const progress = MMG3D.getProgress(handle);
+      expect(progress.phase).toBe("done");
+      expect(progress.percent).toBe(100);
+      expect(progress.iterations).toBeGreaterThan(0);
+    });
+
+    it("should throw on progress access with an invalid handle", () => {
+      expect(() => MMG3D.getProgress(-1 as MeshHandle)).toThrow();
+      expect(() => MMG3D.abortRemesh(-1 as MeshHandle)).toThrow();
+      expect(() => MMG3D.setProgressTracking(-1 as MeshHandle, true)).toThrow();
+    });
+  });
+
+  describe("Arena mode", () => {
+    afterEach(() => {
+      MMG3D.setArenaMode(false);
+    });
+
+    // Remesh a unit tetrahedron in a new handle, returning the handle
+    function remeshTetrahedron(): MeshHandle {
+      const handle = MMG3D.init();
+      MMG3D.setMeshSize(handle, 4, 1, 0, 4, 0, 0);
+      MMG3D.setVertices(
+        handle,
+        new Float64Array([0, 0, 0, 1, 0, 0, 0.5, 0.866, 0, 0.5, 0.289, 0.816]),
+      );
+      MMG3D.setTetrahedra(handle, new Int32Array([1, 2, 3, 4]));
+      MMG3D.setTriangles(
+        handle,
+        new Int32Array([1, 3, 2, 1, 2, 4, 2, 3, 4, 3, 1, 4]),
+      );
+      MMG3D.setIParam(handle, IPARAM.verbose, -1);
+      MMG3D.setDParam(handle, DPARAM.hmax, 0.2);
+      expect(MMG3D.mmg3dlib(handle)).toBe(MMG_RETURN_CODES.SUCCESS);
+      return handle;
+    }
+
+    it("should remesh and free handles allocating from arenas", () => {
+      MMG3D.setArenaMode(true);
+      const first = remeshTetrahedron();
+      const expected = MMG3D.getMeshSize(first);
+      MMG3D.free(first);
+
+      for (let i = 0; i < 5; i++) {
+        const handle = remeshTetrahedron();
+        const clone = MMG3D.clone(handle);
+        MMG3D.free(handle);
+        expect(MMG3D.getMeshSize(clone)).toEqual(expected);
+        expect(MMG3D.getTetrahedra(clone).length).toBe(
+          expected.nTetrahedra * 4,
+        );
+        MMG3D.free(clone);
+      }
+    });
+
+    it("should give arena handles the same result as heap handles", () => {
+      const heap = remeshTetrahedron();
+      handles.push(heap);
+      MMG3D.setArenaMode(true);
+      const arena = remeshTetrahedron();
+      handles.push(arena);
+
+      expect(MMG3D.getMeshSize(arena)).toEqual(MMG3D.getMeshSize(heap));
+      expect(MMG3D.getVertices(arena)).toEqual(MMG3D.getVertices(heap));
+    });
+
+    it("should report the memory held by a handle", () => {
+      const handle = MMG3D.init();
+      handles.push(handle);
+      const empty = MMG3D.getMemoryUsage(handle);
+      expect(empty.max).toBeGreaterThan(0);
+      expect(empty.arena).toBe(0);
+
+      MMG3D.setMeshSize(handle, 1000, 5000, 0, 0, 0, 0);
+      expect(MMG3D.getMemoryUsage(handle).used).toBeGreaterThan(empty.used);
+
+      MMG3D.setArenaMode(true);
+      const arena = remeshTetrahedron();
+      handles.push(arena);
+      expect(MMG3D.getMemoryUsage(arena).arena).toBeGreaterThan(0);
+      expect(() => MMG3D.getMemoryUsage(-1 as MeshHandle)).toThrow();
+    });
+
+    it("should reuse freed arena memory across remeshes", () => {
+      MMG3D.setArenaMode(true);
+      const handle = remeshTetrahedron();
+      handles.push(handle);
+      expect(MMG3D.mmg3dlib(handle)).toBe(MMG_RETURN_CODES.SUCCESS);
+      const settled = MMG3D.getMemoryUsage(handle).arena;
+
+      for (let i = 0; i < 5; i++) {
+        expect(MMG3D.mmg3dlib(handle)).toBe(MMG_RETURN_CODES.SUCCESS);
+      }
+      expect(MMG3D.getMemoryUsage(handle).arena).toBeLessThanOrEqual(
+        2 * settled,
+      );
+    });
+
+    it("should keep the mode of existing handles", () => {
+      MMG3D.setArenaMode(true);
+      const handle = MMG3D.init();
+      handles.push(handle);
+      MMG3D.setArenaMode(false);
+
+      MMG3D.setMeshSize(handle, 4, 1, 0, 0, 0, 0);
+      expect(MMG3D.getMeshSize(handle).nVertices).toBe(4);
+    });
+  });
+
+  describe("Cloning", () => {
+    it("should clone mesh entities and metric into a new handle", () => {
+      const handle = MMG3D.init();
+      handles.push(handle);
+
+      MMG3D.setMeshSize(handle, 4, 1, 0, 4, 0, 0);
+      const vertices = new Float64Array([
+        0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.5, 0.866, 0.0, 0.5, 0.289, 0.816,
+      ]);
+      MMG3D.setVertices(handle, vertices, new Int32Array([1, 2, 3, 4]));
+      MMG3D.setTetrahedra(handle, new Int32Array([1, 2, 3, 4]));
+      MMG3D.setTriangles(
+        handle,
+        new Int32Array([1, 3, 2, 1, 2, 4, 2, 3, 4, 3, 1, 4]),
+      );
+      MMG3D.setSolSize(handle, SOL_ENTITY.VERTEX, 4, SOL_TYPE.SCALAR);
+      const metric = new Float64Array([0.1, 0.2, 0.3, 0.4]);
+      MMG3D.setScalarSols(handle, metric);
+
+      const clone = MMG3D.clone(handle);
+      handles.push(clone);
+
+      expect(clone).not.toBe(handle);
+      expect(MMG3D.getMeshSize(clone)).toEqual(MMG3D.getMeshSize(handle));
+      expect(MMG3D.getVertices(clone)).toEqual(vertices);
+      expect(MMG3D.getTetrahedra(clone)).toEqual(MMG3D.getTetrahedra(handle));
+      expect(MMG3D.getTriangles(clone)).toEqual(MMG3D.getTriangles(handle));
+      expect(MMG3D.getScalarSols(clone)).toEqual(metric);
+    });
+
+    it("should produce an independent handle", () => {
+      const handle = MMG3D.init();
+      MMG3D.setMeshSize(handle, 4, 1, 0, 0, 0, 0);
+      MMG3D.setVertices(
+        handle,
+        new Float64Array([0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1]),
+      );
+      MMG3D.setTetrahedra(handle, new Int32Array([1, 2, 3, 4]));
+
+      const clone = MMG3D.clone(handle);
+      handles.push(clone);
+      MMG3D.free(handle);
+
+      expect(MMG3D.getMeshSize(clone).nVertices).toBe(4);
+      expect(MMG3D.getTetrahedra(clone)).toEqual(new Int32Array([1, 2, 3, 4]));
+    });
+
+    it("should throw when cloning an invalid handle", () => {
+      expect(() => MMG3D.clone(-1 as MeshHandle)).toThrow();
+    });
+  });
+
+  describe("Zero-copy Views", () => {
+    it("should expose mesh data as views over the WASM heap", () => {
+      const handle = MMG3D.init();
+      handles.push(handle);
+
+      MMG3D.setMeshSize(handle, 4, 1, 0, 4, 0, 0);
+      const vertices = new Float64Array([0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1]);
+      MMG3D.setVertices(handle, vertices);
+      MMG3D.setTetrahedra(handle, new Int32Array([1, 2, 3, 4]));
+      MMG3D.setTriangles(
+        handle,
+        new Int32Array([1, 3, 2, 1, 2, 4, 2, 3, 4, 3, 1, 4]),
+      );
+
+      const view = MMG3D.getVerticesView(handle);
+      expect(view).toEqual(vertices);
+      expect(view.buffer).toBe(getWasmModule().HEAPF64.buffer);
+      expect(isHeapViewValid(getWasmModule(), view)).toBe(true);
+      expect(MMG3D.getTetrahedraView(handle)).toEqual(
+        MMG3D.getTetrahedra(handle),
+      );
+      expect(MMG3D.getTrianglesView(handle)).toEqual(
+        MMG3D.getTriangles(handle),
+      );
+    });
+
+    it("should bump the generation when the mesh changes", () => {
+      const handle = MMG3D.init();
+      handles.push(handle);
+
+      MMG3D.setMeshSize(handle, 4, 1, 0, 0, 0, 0);
+      MMG3D.setVertices(
+        handle,
+        new Float64Array([0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1]),
+      );
+      const before = MMG3D.getGeneration(handle);
+      expect(MMG3D.getGeneration(handle)).toBe(before);
+
+      MMG3D.setVertex(handle, 2, 2, 2, 0, 1);
+      expect(MMG3D.getGeneration(handle)).not.toBe(before);
+      expect(MMG3D.getVerticesView(handle)[0]).toBe(2);
+    });
+
+    it("should return empty views for an empty mesh", () => {
+      const handle = MMG3D.init();
+      handles.push(handle);
+
+      expect(MMG3D.getVerticesView(handle).length).toBe(0);
+      expect(MMG3D.getTetrahedraView(handle).length).toBe(0);
+    });
+
+    it("should throw for the generation of an invalid handle", () => {
+      expect(() => MMG3D.getGeneration(-1 as MeshHandle)).toThrow();
+    });
+
+    it("should copy mesh data out without allocating on repeated reads", () => {
+      const handle = MMG3D.init();
+      handles.push(handle);
+
+      MMG3D.setMeshSize(handle, 4, 1, 0, 0, 0, 0);
+      const vertices = new Float64Array([0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1]);
+      MMG3D.setVertices(handle, vertices);
+      MMG3D.setTetrahedra(handle, new Int32Array([1, 2, 3, 4]));
+      MMG3D.setSolSize(handle, SOL_ENTITY.VERTEX, 4, SOL_TYPE.SCALAR);
+      MMG3D.setScalarSols(handle, new Float64Array([0.1, 0.2, 0.3, 0.4]));
+
+      const copy = MMG3D.getVertices(handle);
+      expect(copy.buffer).not.toBe(getWasmModule().HEAPF64.buffer);
+      copy[0] = 5;
+      expect(MMG3D.getVertices(handle)).toEqual(vertices);
+
+      // The first reads pack the view buffers of the handle
+      MMG3D.getTetrahedra(handle);
+      const module = getWasmModule();
+      const used = getMemoryStats(module).nativeUsed;
+      for (let i = 0; i < 10; i++) {
+        MMG3D.getVertices(handle);
+        MMG3D.getTetrahedra(handle);
+        MMG3D.getScalarSols(handle);
+        MMG3D.getMeshSize(handle);
+      }
+      expect(getMemoryStats(module).nativeUsed).toBe(used);
+    });
   });
 
   describe("Multiple Handles", () => {
@@ -416,6 +774,217 @@ describe("MMG3D", () => {
     });
   });
 
+  describe("Bulk import", () => {
+    const vertices = new Float64Array([
+      0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.5, 1.0, 0.0, 0.5, 0.5, 1.0,
+    ]);
+    const tetrahedra = new Int32Array([1, 2, 3, 4]);
+    const triangles = new Int32Array([1, 3, 2, 1, 2, 4, 2, 3, 4, 1, 4, 3]);
+
+    it("should import a whole mesh in one call", () => {
+      const handle = MMG3D.init();
+      handles.push(handle);
+
+      const metric = new Float64Array([0.1, 0.2, 0.15, 0.25]);
+      MMG3D.importMesh(handle, {
+        vertices,
+        vertexRefs: new Int32Array([1, 1, 2, 2]),
+        cells: tetrahedra,
+        cellRefs: new Int32Array([3]),
+        boundary: triangles,
+        boundaryRefs: new Int32Array([4, 4, 5, 5]),
+        metric,
+      });
+
+      const size = MMG3D.getMeshSize(handle);
+      expect(size.nVertices).toBe(4);
+      expect(size.nTetrahedra).toBe(1);
+      expect(size.nTriangles).toBe(4);
+      expect(Array.from(MMG3D.getVertices(handle))).toEqual(
+        Array.from(vertices),
+      );
+      expect(Array.from(MMG3D.getTetrahedra(handle))).toEqual([1, 2, 3, 4]);
+      expect(Array.from(MMG3D.getTriangles(handle))).toEqual(
+        Array.from(triangles),
+      );
+
+      const sols = MMG3D.getScalarSols(handle);
+      for (let i = 0; i < 4; i++) {
+        expect(sols[i]).toBeCloseTo(metric[i]);
+      }
+    });
+
+    it("should import a tensor metric", () => {
+      const handle = MMG3D.init();
+      handles.push(handle);
+
+      const metric = new Float64Array(24);
+      for (let i = 0; i < 4; i++) {
+        metric.set([100, 0, 0, 100, 0, 100], i * 6);
+      }
+      MMG3D.importMesh(handle, { vertices, cells: tetrahedra, metric });
+
+      expect(MMG3D.getSolSize(handle).typSol).toBe(SOL_TYPE.TENSOR);
+      expect(Array.from(MMG3D.getTensorSols(handle))).toEqual(
+        Array.from(metric),
+      );
+    });
+
+    it("should reject arrays of the wrong length", () => {
+      const handle = MMG3D.init();
+      handles.push(handle);
+
+      expect(() =>
+        MMG3D.importMesh(handle, { vertices, cells: new Int32Array([1, 2]) }),
+      ).toThrow();
+      expect(() =>
+        MMG3D.importMesh(handle, {
+          vertices,
+          cells: tetrahedra,
+          cellRefs: new Int32Array([1, 2]),
+        }),
+      ).toThrow();
+      expect(() =>
+        MMG3D.importMesh(handle, {
+          vertices,
+          cells: tetrahedra,
+          metric: new Float64Array(8),
+        }),
+      ).toThrow();
+    });
+  });
+
+  describe("Packed meshes", () => {
+    const vertices = new Float64Array([
+      0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.5, 1.0, 0.0, 0.5, 0.5, 1.0,
+    ]);
+    const tetrahedra = new Int32Array([1, 2, 3, 4]);
+    const triangles = new Int32Array([1, 3, 2, 1, 2, 4, 2, 3, 4, 1, 4, 3]);
+
+    const createTetrahedron = (): MeshHandle => {
+      const handle = MMG3D.init();
+      handles.push(handle);
+      MMG3D.importMesh(handle, {
+        vertices,
+        cells: tetrahedra,
+        boundary: triangles,
+      });
+      return handle;
+    };
+
+    it("should pack float32 positions and 0-based uint16 indices", () => {
+      const handle = createTetrahedron();
+
+      const packed = decodePackedMesh(MMG3D.packMesh(handle));
+      expect(packed.dim).toBe(3);
+      expect(packed.nVertices).toBe(4);
+      expect(Array.from(packed.positions)).toEqual(Array.from(vertices));
+      expect(packed.cellSize).toBe(4);
+      expect(packed.cells).toBeInstanceOf(Uint16Array);
+      expect(Array.from(packed.cells)).toEqual([0, 1, 2, 3]);
+      expect(packed.boundarySize).toBe(3);
+      expect(Array.from(packed.boundary)).toEqual(
+        Array.from(triangles, (v) => v - 1),
+      );
+    });
+
+    it("should quantize positions within the bounding box", () => {
+      const handle = createTetrahedron();
+
+      const full = MMG3D.packMesh(handle);
+      const quantized = MMG3D.packMesh(handle, { quantize: true });
+      expect(quantized.byteLength).toBeLessThan(full.byteLength);
+
+      const packed = decodePackedMesh(quantized);
+      for (let i = 0; i < vertices.length; i++) {
+        expect(Math.abs(packed.positions[i] - vertices[i])).toBeLessThan(1e-4);
+      }
+    });
+
+    it("should leave the cells out when packing the boundary only", () => {
+      const handle = createTetrahedron();
+
+      const packed = decodePackedMesh(
+        MMG3D.packMesh(handle, { boundaryOnly: true }),
+      );
+      expect(packed.cells.length).toBe(0);
+      expect(packed.boundary.length).toBe(triangles.length);
+    });
+
+    it("should reject buffers that are not packed meshes", () => {
+      expect(() => decodePackedMesh(new Uint8Array(8))).toThrow();
+      expect(() => decodePackedMesh(new Uint8Array(80))).toThrow();
+
+      const handle = createTetrahedron();
+      const bytes = MMG3D.packMesh(handle);
+      const truncated = bytes.slice(0, bytes.length - 8);
+      expect(() => decodePackedMesh(truncated)).toThrow();
+    });
+  });
+
+  describe("Surface extraction", () => {
+    // Two tetrahedra sharing the face 2-3-4, on either side of x = 0.5
+    const createPair = (): MeshHandle => {
+      const handle = MMG3D.init();
+      handles.push(handle);
+      MMG3D.importMesh(handle, {
+        vertices: new Float64Array([
+          0, 0, 0, 0.5, 0, 0, 0.5, 1, 0, 0.5, 0, 1, 1, 0.5, 0.5,
+        ]),
+        cells: new Int32Array([1, 2, 3, 4, 2, 4, 3, 5]),
+      });
+      return handle;
+    };
+
+    it("should extract the boundary with outward faces and normals", () => {
+      const handle = createPair();
+
+      const surface = MMG3D.extractSurface(handle);
+      expect(surface.indices.length).toBe(6 * 3);
+      expect(surface.positions.length).toBe(5 * 3);
+      expect(surface.normals.length).toBe(5 * 3);
+      expect(surface.cells.length).toBe(6);
+
+      // Every face normal points away from the centre of the pair
+      const { positions, indices } = surface;
+      const p = (v: number, d: number) => positions[indices[v] * 3 + d];
+      for (let t = 0; t < indices.length; t += 3) {
+        const u = [0, 1, 2].map((d) => p(t + 1, d) - p(t, d));
+        const w = [0, 1, 2].map((d) => p(t + 2, d) - p(t, d));
+        const n = [
+          u[1] * w[2] - u[2] * w[1],
+          u[2] * w[0] - u[0] * w[2],
+          u[0] * w[1] - u[1] * w[0],
+        ];
+        const centroid = [0, 1, 2].map(
+          (d) => (p(t, d) + p(t + 1, d) + p(t + 2, d)) / 3,
+        );
+        const outward =
+          n[0] * (centroid[0] - 0.5) +
+          n[1] * (centroid[1] - 0.4) +
+          n[2] * (centroid[2] - 0.4);
+        expect(outward).toBeGreaterThan(0);
+      }
+    });
+
+    it("should show the cut face when clipping", () => {
+      const handle = createPair();
+
+      const surface = MMG3D.extractSurface(handle, {
+        normal: [1, 0, 0],
+        offset: 0.5,
+      });
+      expect(Array.from(surface.cells)).toEqual([0, 0, 0, 0]);
+      expect(surface.positions.length).toBe(4 * 3);
+
+      const none = MMG3D.extractSurface(handle, {
+        normal: [1, 0, 0],
+        offset: -1,
+      });
+      expect(none.indices.length).toBe(0);
+    });
+  });
+
   describe("Solution/Metric Fields", () => {
     it("should set and get solution size for scalar metric", () => {
       const handle = MMG3D.init();
@@ -571,4 +1140,174 @@ describe("MMG3D", () => {
       expect(newSize.nTetrahedra).toBeGreaterThan(1);
     });
   });
+
+  describe("Native sizing", () => {
+    // 3x3x3 grid of vertices in the unit cube
+    const gridVertices = (): Float64Array => {
+      const coords: number[] = [];
+      for (let i = 0; i <= 2; i++) {
+        for (let j = 0; j <= 2; j++) {
+          for (let k = 0; k <= 2; k++) {
+            coords.push(i / 2, j / 2, k / 2);
+          }
+        }
+      }
+      return new Float64Array(coords);
+    };
+
+    const createGrid = (): MeshHandle => {
+      const handle = MMG3D.init();
+      handles.push(handle);
+      MMG3D.setMeshSize(handle, 27, 0, 0, 0, 0, 0);
+      MMG3D.setVertices(handle, gridVertices());
+      return handle;
+    };
+
+    it("should match the JS evaluation of the constraints", () => {
+      const handle = createGrid();
+      const constraints = [
+        new SphereSizingConstraint([0, 0, 0], 0.6, 0.05),
+        new BoxSizingConstraint([0.4, 0.4, 0.4], [1, 1, 1], 0.1),
+        new CylinderSizingConstraint([0, 1, 0], [1, 1, 0], 0.2, 0.02),
+      ];
+
+      MMG3D.applySizing(handle, encodeSizingConstraints(constraints, 3));
+
+      const expected = combineSizingConstraints(constraints, gridVertices(), 3);
+      const fallback = Math.sqrt(3) * 0.2;
+      const sizes = MMG3D.getScalarSols(handle);
+      expect(sizes.length).toBe(27);
+      for (let i = 0; i < 27; i++) {
+        const value = Number.isFinite(expected[i]) ? expected[i] : fallback;
+        expect(sizes[i]).toBeCloseTo(value);
+      }
+      expect(MMG3D.getSolSize(handle).typSol).toBe(SOL_TYPE.SCALAR);
+    });
+
+    it("should take the smallest size of overlapping regions", () => {
+      const handle = createGrid();
+      const constraints = encodeSizingConstraints(
+        [
+          new SphereSizingConstraint([0.5, 0.5, 0.5], 0.1, 0.3),
+          new SphereSizingConstraint([0.5, 0.5, 0.5], 0.1, 0.07),
+        ],
+        3,
+      );
+
+      MMG3D.applySizing(handle, constraints);
+
+      // Vertex 14 is the center of the grid
+      expect(MMG3D.getScalarSols(handle)[13]).toBeCloseTo(0.07);
+    });
+
+    it("should reject invalid constraints", () => {
+      const handle = createGrid();
+      const constraints = encodeSizingConstraints(
+        [new SphereSizingConstraint([0, 0, 0], 0.5, 0.1)],
+        3,
+      );
+
+      const unknownKind = constraints.slice();
+      unknownKind[0] = 42;
+      expect(() => MMG3D.applySizing(handle, unknownKind)).toThrow();
+      expect(() =>
+        MMG3D.applySizing(handle, constraints.subarray(0, SIZING_STRIDE - 1)),
+      ).toThrow();
+      expect(() =>
+        MMG3D.applySizing(-1 as MeshHandle, constraints),
+      ).toThrow();
+    });
+
+    it("should index many constraints like a linear scan", () => {
+      const handle = createGrid();
+      // Small balls around every grid vertex, enough to build a hierarchy
+      const constraints: SphereSizingConstraint[] = [];
+      for (let i = 0; i <= 2; i++) {
+        for (let j = 0; j <= 2; j++) {
+          for (let k = 0; k <= 2; k++) {
+            const size = 0.01 * (constraints.length + 1);
+            const center: [number, number, number] = [i / 2, j / 2, k / 2];
+            constraints.push(new SphereSizingConstraint(center, 0.1, size));
+          }
+        }
+      }
+
+      MMG3D.applySizing(handle, encodeSizingConstraints(constraints, 3));
+
+      const sizes = MMG3D.getScalarSols(handle);
+      for (let i = 0; i < 27; i++) {
+        expect(sizes[i]).toBeCloseTo(0.01 * (i + 1));
+      }
+    });
+  });
+
+  describe("Point location", () => {
+    // Unit tetrahedron carrying the scalar field x + 2y + 3z
+    const createTetrahedron = (): MeshHandle => {
+      const handle = MMG3D.init();
+      handles.push(handle);
+      MMG3D.setMeshSize(handle, 4, 1, 0, 0, 0, 0);
+      MMG3D.setVertices(
+        handle,
+        new Float64Array([0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1]),
+      );
+      MMG3D.setTetrahedra(handle, new Int32Array([1, 2, 3, 4]));
+      MMG3D.setSolSize(handle, SOL_ENTITY.VERTEX, 4, SOL_TYPE.SCALAR);
+      MMG3D.setScalarSols(handle, new Float64Array([0, 1, 2, 3]));
+      return handle;
+    };
+
+    it("should locate points with barycentric coordinates", () => {
+      const handle = createTetrahedron();
+      const points = new Float64Array([0.1, 0.2, 0.3, 1, 1, 1, 0, 0, 0]);
+
+      const { elements, barycentric, located } = MMG3D.locatePoints(
+        handle,
+        points,
+      );
+
+      expect(located).toBe(2);
+      expect(Array.from(elements)).toEqual([1, 0, 1]);
+      const expected = [0.4, 0.1, 0.2, 0.3];
+      for (let i = 0; i < 4; i++) {
+        expect(barycentric[i]).toBeCloseTo(expected[i]);
+      }
+    });
+
+    it("should interpolate the solution at arbitrary points", () => {
+      const handle = createTetrahedron();
+      const points = new Float64Array([
+        0.1, 0.2, 0.3, 0.25, 0.25, 0.25, 2, 0, 0,
+      ]);
+
+      const values = MMG3D.sampleSolution(handle, points);
+
+      expect(values.length).toBe(3);
+      expect(values[0]).toBeCloseTo(0.1 + 0.4 + 0.9);
+      expect(values[1]).toBeCloseTo(1.5);
+      expect(values[2]).toBeNaN();
+    });
+
+    it("should follow mesh modifications", () => {
+      const handle = createTetrahedron();
+      const point = new Float64Array([0.9, 0.9, 0.9]);
+      expect(MMG3D.locatePoints(handle, point).located).toBe(0);
+
+      // Scaling the tetrahedron by 3 brings the point inside
+      MMG3D.setVertex(handle, 2, 3, 0, 0);
+      MMG3D.setVertex(handle, 3, 0, 3, 0);
+      MMG3D.setVertex(handle, 4, 0, 0, 3);
+      expect(MMG3D.locatePoints(handle, point).elements[0]).toBe(1);
+    });
+
+    it("should reject invalid input", () => {
+      const handle = createTetrahedron();
+      expect(() =>
+        MMG3D.locatePoints(handle, new Float64Array([0, 0])),
+      ).toThrow();
+      expect(() =>
+        MMG3D.locatePoints(-1 as MeshHandle, new Float64Array(3)),
+      ).toThrow();
+    });
+  });
 });
@@ -7,6 +7,7 @@ import {
   type MeshHandleS,
   SOL_ENTITY_S,
   SOL_TYPE_S,
+  getWasmModuleS,
   initMMGS,
 } from "../src/mmgs";
 
@@ -53,8 +54,8 @@ describe("MMGS", () => {
       expect(() => MMGS.free(handle)).toThrow();
     });
 
-    it("should report max handles as 64", () => {
-      expect(MMGS.getMaxHandles()).toBe(64);
+    it("should report max handles as 1024 by default", () => {
+      expect(MMGS.getMaxHandles()).toBe(1024);
     });
 
     it("should track available handles correctly", () => {
@@ -533,6 +534,111 @@ describe("MMGS", () => {
     });
   });
 
+  describe("Arena mode", () => {
+    afterEach(() => {
+      MMGS.setArenaMode(false);
+    });
+
+    it("should remesh and free handles allocating from arenas", () => {
+      MMGS.setArenaMode(true);
+      for (let i = 0; i < 5; i++) {
+        const handle = MMGS.init();
+        MMGS.setMeshSize(handle, 4, 4, 0);
+        MMGS.setVertices(
+          handle,
+          new Float64Array([0, 0, 0, 1, 0, 0, 0.5, 1, 0, 0.5, 0.5, 1]),
+        );
+        MMGS.setTriangles(
+          handle,
+          new Int32Array([1, 3, 2, 1, 2, 4, 2, 3, 4, 3, 1, 4]),
+        );
+        MMGS.setIParam(handle, IPARAM_S.verbose, -1);
+        MMGS.setDParam(handle, DPARAM_S.hmax, 0.3);
+        expect(MMGS.mmgslib(handle)).toBe(MMG_RETURN_CODES_S.SUCCESS);
+
+        const clone = MMGS.clone(handle);
+        const size = MMGS.getMeshSize(handle);
+        MMGS.free(handle);
+        expect(MMGS.getMeshSize(clone)).toEqual(size);
+        expect(MMGS.getTriangles(clone).length).toBe(size.nTriangles * 3);
+        MMGS.free(clone);
+      }
+    });
+  });
+
+  describe("Cloning", () => {
+    it("should clone mesh entities and metric into a new handle", () => {
+      const handle = MMGS.init();
+      handles.push(handle);
+
+      MMGS.setMeshSize(handle, 4, 4, 0);
+      const vertices = new Float64Array([
+        0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.5, 1.0, 0.0, 0.5, 0.5, 1.0,
+      ]);
+      MMGS.setVertices(handle, vertices);
+      MMGS.setTriangles(
+        handle,
+        new Int32Array([1, 3, 2, 1, 2, 4, 2, 3, 4, 3, 1, 4]),
+      );
+      MMGS.setSolSize(handle, SOL_ENTITY_S.VERTEX, 4, SOL_TYPE_S.SCALAR);
+      const metric = new Float64Array([0.1, 0.2, 0.3, 0.4]);
+      MMGS.setScalarSols(handle, metric);
+
+      const clone = MMGS.clone(handle);
+      handles.push(clone);
+
+      expect(clone).not.toBe(handle);
+      expect(MMGS.getMeshSize(clone)).toEqual(MMGS.getMeshSize(handle));
+      expect(MMGS.getVertices(clone)).toEqual(vertices);
+      expect(MMGS.getTriangles(clone)).toEqual(MMGS.getTriangles(handle));
+      expect(MMGS.getScalarSols(clone)).toEqual(metric);
+    });
+
+    it("should throw when cloning an invalid handle", () => {
+      expect(() => MMGS.clone(-1 as MeshHandleS)).toThrow();
+    });
+  });
+
+  describe("Zero-copy Views", () => {
+    it("should expose mesh data as views over the WASM heap", () => {
+      const handle = MMGS.init();
+      handles.push(handle);
+
+      MMGS.setMeshSize(handle, 4, 4, 0);
+      const vertices = new Float64Array([
+        0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.5, 1.0, 0.0, 0.5, 0.5, 1.0,
+      ]);
+      MMGS.setVertices(handle, vertices);
+      MMGS.setTriangles(
+        handle,
+        new Int32Array([1, 3, 2, 1, 2, 4, 2, 3, 4, 3, 1, 4]),
+      );
+
+      const view = MMGS.getVerticesView(handle);
+      expect(view).toEqual(vertices);
+      expect(view.buffer).toBe(getWasmModuleS().HEAPF64.buffer);
+      expect(MMGS.getTrianglesView(handle)).toEqual(MMGS.getTriangles(handle));
+      expect(MMGS.getEdgesView(handle).length).toBe(0);
+    });
+
+    it("should bump the generation when the mesh changes", () => {
+      const handle = MMGS.init();
+      handles.push(handle);
+
+      MMGS.setMeshSize(handle, 3, 1, 0);
+      MMGS.setVertices(handle, new Float64Array([0, 0, 0, 1, 0, 0, 0, 1, 0]));
+      const before = MMGS.getGeneration(handle);
+
+      MMGS.setVertex(handle, 2, 2, 2, 0, 1);
+      expect(MMGS.getGeneration(handle)).not.toBe(before);
+      expect(MMGS.getVerticesView(handle)[0]).toBe(2);
+    });
+
+    it("should throw for the generation of an invalid handle", () => {
+      expect(() => MMGS.getGeneration(-1 as MeshHandleS)).toThrow();
+    });
+  });
+
   describe("Multiple Handles", () => {
     it("should work with multiple independent meshes", () => {
       const handle1 = MMGS.init();
@@ -707,4 +813,33 @@ describe("MMGS", () => {
       expect(newSize.nTriangles).toBeGreaterThan(4);
     });
   });
+
+  describe("Point location", () => {
+    it("should project points onto the closest triangle", () => {
+      const handle = MMGS.init();
+      handles.push(handle);
+      MMGS.setMeshSize(handle, 4, 2, 0);
+      MMGS.setVertices(
+        handle,
+        new Float64Array([0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0]),
+      );
+      MMGS.setTriangles(handle, new Int32Array([1, 2, 3, 1, 3, 4]));
+      MMGS.setSolSize(handle, SOL_ENTITY_S.VERTEX, 4, SOL_TYPE_S.SCALAR);
+      MMGS.setScalarSols(handle, new Float64Array([0, 1, 3, 2]));
+
+      // Above the first triangle, and beyond the corner of the square
+      const points = new Float64Array([0.75, 0.25, 1, 2, 2, -1]);
+      const { elements, barycentric } = MMGS.locatePoints(handle, points);
+
+      expect(elements[0]).toBe(1);
+      const expected = [0.25, 0.5, 0.25];
+      for (let i = 0; i < 3; i++) {
+        expect(barycentric[i]).toBeCloseTo(expected[i]);
+      }
+      // Projected onto the shared vertex (1, 1, 0)
+      const values = MMGS.sampleSolution(handle, points);
+      expect(values[0]).toBeCloseTo(1.25);
+      expect(values[1]).toBeCloseTo(3);
+    });
+  });
 });
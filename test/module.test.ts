@@ -2,13 +2,25 @@ import { afterEach, beforeAll, describe, expect, it } from "bun:test";
 import {
   DPARAM,
   IPARAM,
+  MMG2D,
   MMG3D,
   type MMG3DModule,
   MMG_RETURN_CODES,
   type MeshHandle,
+  getCompiledModule,
   getWasmModule,
+  getWasmModule2D,
+  getWasmModuleS,
+  getWasmVariant,
+  initMMG2D,
   initMMG3D,
+  initMMGS,
+  isMemory64Supported,
+  isOPFSAvailable,
+  isSimdSupported,
+  mountOPFS,
 } from "../src/index";
+import { loadModule, loadSharedModule, setSplitModules } from "../src/loader";
 
 describe("WASM Module Loading", () => {
   // Track handles for cleanup
@@ -167,3 +179,87 @@ describe("Environment Compatibility", () => {
     expect(elapsed).toBeLessThan(5000);
   });
 });
+
+describe("Build Variant Selection", () => {
+  beforeAll(async () => {
+    await initMMG3D();
+  });
+
+  it("detects SIMD support consistently", () => {
+    const supported = isSimdSupported();
+    expect(typeof supported).toBe("boolean");
+    expect(isSimdSupported()).toBe(supported);
+  });
+
+  it("detects Memory64 support consistently", () => {
+    const supported = isMemory64Supported();
+    expect(typeof supported).toBe("boolean");
+    expect(isMemory64Supported()).toBe(supported);
+  });
+
+  it("reports the loaded variant", () => {
+    const variant = getWasmVariant();
+    expect(variant === "simd" || variant === "scalar").toBe(true);
+    if (!isSimdSupported()) {
+      expect(variant).toBe("scalar");
+    }
+  });
+
+  it("only mounts OPFS from the opfs build", () => {
+    const module = getWasmModule();
+    expect(isOPFSAvailable(module)).toBe(getWasmVariant() === "opfs");
+    if (!isOPFSAvailable(module)) {
+      expect(() => mountOPFS(module)).toThrow("opfs build");
+    }
+  });
+});
+
+describe("Shared Module Instance", () => {
+  beforeAll(async () => {
+    await Promise.all([initMMG3D(), initMMG2D(), initMMGS()]);
+  });
+
+  it("shares one instance across mesh types", () => {
+    const module = getWasmModule();
+    expect(getWasmModule2D() as unknown).toBe(module);
+    expect(getWasmModuleS() as unknown).toBe(module);
+  });
+
+  it("keeps handle registries separate per mesh type", () => {
+    const available2D = MMG2D.getAvailableHandles();
+    const available3D = MMG3D.getAvailableHandles();
+    const handle = MMG3D.init();
+    try {
+      expect(MMG3D.getAvailableHandles()).toBe(available3D - 1);
+      expect(MMG2D.getAvailableHandles()).toBe(available2D);
+    } finally {
+      MMG3D.free(handle);
+    }
+  });
+
+  it("caches the compiled module of the loaded variant", async () => {
+    const compiled = await getCompiledModule();
+    expect(await getCompiledModule()).toBe(compiled);
+    if (compiled) {
+      expect(compiled.variant).toBe(getWasmVariant() as string);
+      expect(compiled.module).toBeInstanceOf(WebAssembly.Module);
+    }
+  });
+});
+
+describe("Split Modules", () => {
+  afterEach(() => {
+    setSplitModules(false);
+  });
+
+  it("loads the shared module unless split modules are enabled", async () => {
+    expect(await loadModule("mmg2d")).toBe(await loadSharedModule());
+  });
+
+  it("loads a module with the wrappers of its mesh type", async () => {
+    setSplitModules(true);
+    const module = (await loadModule("mmgs")) as Record<string, unknown>;
+    expect(typeof module._mmgs_init).toBe("function");
+    expect(await loadModule("mmgs")).toBe(module);
+  });
+});
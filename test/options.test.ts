@@ -126,6 +126,27 @@ describe("RemeshOptions Validation", () => {
     });
   });
 
+  describe("localMargin constraints", () => {
+    it("throws when localMargin < 0", () => {
+      expect(() => validateOptions({ localMargin: -0.1 })).toThrow(
+        "localMargin must be non-negative",
+      );
+    });
+
+    it("throws when localMargin is NaN", () => {
+      expect(() => validateOptions({ localMargin: Number.NaN })).toThrow(
+        "localMargin must not be NaN",
+      );
+    });
+
+    it("allows zero and positive localMargin", () => {
+      expect(() => validateOptions({ localMargin: 0 })).not.toThrow();
+      expect(() =>
+        validateOptions({ local: true, localMargin: 0.5 }),
+      ).not.toThrow();
+    });
+  });
+
   describe("verbose constraints", () => {
     it("throws when verbose < -1", () => {
       expect(() => validateOptions({ verbose: -2 })).toThrow(
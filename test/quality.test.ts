@@ -1,6 +1,13 @@
 import { afterEach, beforeAll, describe, expect, it } from "bun:test";
 import { IPARAM_2D, MMG2D, type MeshHandle2D, initMMG2D } from "../src/mmg2d";
-import { IPARAM, MMG3D, type MeshHandle, initMMG3D } from "../src/mmg3d";
+import {
+  IPARAM,
+  MMG3D,
+  type MeshHandle,
+  SOL_ENTITY,
+  SOL_TYPE,
+  initMMG3D,
+} from "../src/mmg3d";
 import { IPARAM_S, MMGS, type MeshHandleS, initMMGS } from "../src/mmgs";
 import {
   nTriangles as cubeNTriangles,
@@ -113,6 +120,38 @@ describe("Quality Functions", () => {
       const qualities = MMG2D.getTrianglesQualities(handle);
       expect(qualities.length).toBe(0);
     });
+
+    it("should compute quality stats matching per-element qualities", () => {
+      const handle = MMG2D.init();
+      handles.push(handle);
+
+      MMG2D.setIParam(handle, IPARAM_2D.verbose, -1);
+      MMG2D.setMeshSize(
+        handle,
+        squareNVertices,
+        squareNTriangles,
+        0,
+        squareNEdges,
+      );
+      MMG2D.setVertices(handle, squareVertices);
+      MMG2D.setTriangles(handle, squareTriangles);
+      MMG2D.setEdges(handle, squareEdges);
+
+      const qualities = MMG2D.getTrianglesQualities(handle);
+      const stats = MMG2D.getQualityStats(handle, 4);
+
+      expect(stats.count).toBe(squareNTriangles);
+      expect(stats.min).toBeCloseTo(Math.min(...qualities), 12);
+      expect(stats.max).toBeCloseTo(Math.max(...qualities), 12);
+      expect(stats.mean).toBeCloseTo(
+        qualities.reduce((a, b) => a + b, 0) / qualities.length,
+        12,
+      );
+      expect(stats.histogram.length).toBe(4);
+      expect(stats.histogram.reduce((a, b) => a + b, 0)).toBe(
+        squareNTriangles,
+      );
+    });
   });
 
   describe("MMGS Quality", () => {
@@ -196,6 +235,39 @@ describe("Quality Functions", () => {
       expect(q1).toBeCloseTo(qualities[0] ?? 0, 10);
       expect(qLast).toBeCloseTo(qualities[3] ?? 0, 10);
     });
+
+    it("should compute quality stats matching per-element qualities", () => {
+      const handle = MMGS.init();
+      handles.push(handle);
+
+      MMGS.setIParam(handle, IPARAM_S.verbose, -1);
+      MMGS.setMeshSize(handle, 4, 4, 6);
+
+      // Simple tetrahedron surface mesh (4 triangular faces)
+      const vertices = new Float64Array([
+        0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.5, 0.87, 0.0, 0.5, 0.29, 0.82,
+      ]);
+      MMGS.setVertices(handle, vertices);
+
+      const triangles = new Int32Array([1, 3, 2, 1, 2, 4, 2, 3, 4, 3, 1, 4]);
+      MMGS.setTriangles(handle, triangles);
+
+      const edges = new Int32Array([1, 2, 2, 3, 3, 1, 1, 4, 2, 4, 3, 4]);
+      MMGS.setEdges(handle, edges);
+
+      const qualities = MMGS.getTrianglesQualities(handle);
+      const stats = MMGS.getQualityStats(handle, 4);
+
+      expect(stats.count).toBe(4);
+      expect(stats.min).toBeCloseTo(Math.min(...qualities), 12);
+      expect(stats.max).toBeCloseTo(Math.max(...qualities), 12);
+      expect(stats.mean).toBeCloseTo(
+        qualities.reduce((a, b) => a + b, 0) / qualities.length,
+        12,
+      );
+      expect(stats.histogram.length).toBe(4);
+      expect(stats.histogram.reduce((a, b) => a + b, 0)).toBe(4);
+    });
   });
 
   describe("MMG3D Quality", () => {
@@ -330,5 +402,80 @@ describe("Quality Functions", () => {
         expect(q).toBeLessThanOrEqual(1);
       }
     });
+
+    it("should compute quality stats matching per-element qualities", () => {
+      const handle = MMG3D.init();
+      handles.push(handle);
+
+      MMG3D.setIParam(handle, IPARAM.verbose, -1);
+      MMG3D.setMeshSize(
+        handle,
+        cubeNVertices,
+        nTetrahedra,
+        0,
+        cubeNTriangles,
+        0,
+        0,
+      );
+      MMG3D.setVertices(handle, cubeVertices);
+      MMG3D.setTetrahedra(handle, cubeTetrahedra);
+      MMG3D.setTriangles(handle, cubeTriangles);
+
+      const qualities = MMG3D.getTetrahedraQualities(handle);
+      const stats = MMG3D.getQualityStats(handle, 4);
+
+      expect(stats.count).toBe(nTetrahedra);
+      expect(stats.min).toBeCloseTo(Math.min(...qualities), 12);
+      expect(stats.max).toBeCloseTo(Math.max(...qualities), 12);
+      expect(stats.mean).toBeCloseTo(
+        qualities.reduce((a, b) => a + b, 0) / qualities.length,
+        12,
+      );
+      expect(stats.histogram.length).toBe(4);
+      expect(stats.histogram.reduce((a, b) => a + b, 0)).toBe(nTetrahedra);
+    });
+
+    it("should match MMG's quality of each tetrahedron under a metric", () => {
+      const handle = MMG3D.init();
+      handles.push(handle);
+
+      MMG3D.setIParam(handle, IPARAM.verbose, -1);
+      MMG3D.setMeshSize(
+        handle,
+        cubeNVertices,
+        nTetrahedra,
+        0,
+        cubeNTriangles,
+        0,
+        0,
+      );
+      MMG3D.setVertices(handle, cubeVertices);
+      MMG3D.setTetrahedra(handle, cubeTetrahedra);
+      MMG3D.setTriangles(handle, cubeTriangles);
+      MMG3D.setSolSize(
+        handle,
+        SOL_ENTITY.VERTEX,
+        cubeNVertices,
+        SOL_TYPE.TENSOR,
+      );
+      // Stretched along x, so that the anisotropic quality differs
+      const tensors = new Float64Array(cubeNVertices * 6);
+      for (let i = 0; i < cubeNVertices; i++) {
+        tensors.set([100, 0, 0, 1, 0, 1], i * 6);
+      }
+      MMG3D.setTensorSols(handle, tensors);
+
+      const expected = Array.from({ length: nTetrahedra }, (_, k) =>
+        MMG3D.getTetrahedronQuality(handle, k + 1),
+      );
+      const qualities = MMG3D.getTetrahedraQualities(handle);
+      const stats = MMG3D.getQualityStats(handle, 4);
+
+      for (let k = 0; k < nTetrahedra; k++) {
+        expect(qualities[k]).toBe(expected[k]);
+      }
+      expect(stats.min).toBe(Math.min(...expected));
+      expect(stats.max).toBe(Math.max(...expected));
+    });
   });
 });
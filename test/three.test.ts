@@ -1,10 +1,13 @@
 import { afterEach, beforeAll, describe, expect, it } from "bun:test";
 import * as THREE from "three";
 import { Mesh, MeshType, initMMG2D, initMMG3D, initMMGS } from "../src";
+import { decodePackedMesh } from "../src/packed";
 import {
 	fromThreeGeometry,
+	packedMeshToThreeGeometry,
 	toThreeGeometry,
 	toThreeGeometrySync,
+	toThreeSurfaceGeometry,
 } from "../src/three";
 import { cubeTetrahedra, cubeTriangles, cubeVertices } from "./fixtures/cube";
 import { squareEdges, squareTriangles, squareVertices } from "./fixtures/square";
@@ -270,6 +273,82 @@ describe("Three.js Integration", () => {
 		});
 	});
 
+	describe("packedMeshToThreeGeometry", () => {
+		it("should match the geometry of the unpacked mesh", () => {
+			const mesh = new Mesh({
+				vertices: cubeVertices,
+				cells: cubeTetrahedra,
+				boundaryFaces: cubeTriangles,
+				type: MeshType.Mesh3D,
+			});
+			meshes.push(mesh);
+
+			const packed = decodePackedMesh(
+				mesh.toPackedBuffer({ boundaryOnly: true }),
+			);
+			const geometry = packedMeshToThreeGeometry(packed, THREE);
+			const expected = toThreeGeometrySync(mesh, THREE);
+			geometries.push(geometry, expected);
+
+			expect(Array.from(geometry.attributes.position.array)).toEqual(
+				Array.from(expected.attributes.position.array),
+			);
+			expect(Array.from(geometry.index?.array ?? [])).toEqual(
+				Array.from(expected.index?.array ?? []),
+			);
+		});
+
+		it("should pad 2D positions with z=0", () => {
+			const mesh = new Mesh({
+				vertices: squareVertices,
+				cells: squareTriangles,
+				boundaryFaces: squareEdges,
+				type: MeshType.Mesh2D,
+			});
+			meshes.push(mesh);
+
+			const packed = decodePackedMesh(mesh.toPackedBuffer());
+			const geometry = packedMeshToThreeGeometry(packed, THREE);
+			geometries.push(geometry);
+
+			const positions = geometry.attributes.position;
+			expect(positions.count).toBe(mesh.nVertices);
+			for (let i = 0; i < positions.count; i++) {
+				expect(positions.getZ(i)).toBe(0);
+			}
+			expect(geometry.index?.count).toBe(mesh.nCells * 3);
+		});
+	});
+
+	describe("toThreeSurfaceGeometry", () => {
+		it("should extract the boundary of a 3D mesh natively", () => {
+			const mesh = new Mesh({
+				vertices: cubeVertices,
+				cells: cubeTetrahedra,
+				type: MeshType.Mesh3D,
+			});
+			meshes.push(mesh);
+
+			const geometry = toThreeSurfaceGeometry(mesh, THREE);
+			geometries.push(geometry);
+
+			expect(geometry.attributes.position.count).toBe(8);
+			expect(geometry.attributes.normal.count).toBe(8);
+			expect(geometry.index?.count).toBe(12 * 3);
+		});
+
+		it("should reject non-volume meshes", () => {
+			const mesh = new Mesh({
+				vertices: cubeVertices,
+				cells: cubeTriangles,
+				type: MeshType.MeshS,
+			});
+			meshes.push(mesh);
+
+			expect(() => toThreeSurfaceGeometry(mesh, THREE)).toThrow();
+		});
+	});
+
 	describe("Round-trip conversion", () => {
 		it("should preserve vertex count in Three.js -> mmg -> Three.js", async () => {
 			const boxGeometry = new THREE.BoxGeometry(1, 1, 1);
@@ -1,5 +1,19 @@
 import { afterEach, beforeAll, describe, expect, it } from "bun:test";
-import { Mesh, MeshType, MeshWorker, remeshInWorker } from "../src";
+import {
+  MemoryCacheStore,
+  Mesh,
+  MeshType,
+  MeshWorker,
+  MeshWorkerPool,
+  type PoolWorker,
+  RemeshCache,
+  type RemeshMemory,
+  type RemeshResult,
+  estimateJobCost,
+  remeshInWorker,
+  runPipeline,
+  validatePipeline,
+} from "../src";
 import { initMMG2D } from "../src/mmg2d";
 import { initMMG3D } from "../src/mmg3d";
 import { initMMGS } from "../src/mmgs";
@@ -377,6 +391,481 @@ describe("Worker API - Direct Remesh Comparison", () => {
   });
 });
 
+describe("Worker Pipeline", () => {
+  // Pipelines run the same way inside the worker, so they are tested directly
+
+  const meshes: Mesh[] = [];
+
+  beforeAll(async () => {
+    await initMMG2D();
+    await initMMG3D();
+  });
+
+  afterEach(() => {
+    for (const mesh of meshes) {
+      try {
+        mesh.free();
+      } catch {
+        // Ignore
+      }
+    }
+    meshes.length = 0;
+  });
+
+  function createCube(): Mesh {
+    const mesh = new Mesh({
+      vertices: cubeVertices,
+      cells: cubeTetrahedra,
+      boundaryFaces: cubeTriangles,
+    });
+    meshes.push(mesh);
+    return mesh;
+  }
+
+  it("should run stages in order and report each one", async () => {
+    const mesh = createCube();
+    const inputVertices = mesh.nVertices;
+
+    const result = await runPipeline(mesh, [
+      { options: { hmax: 0.5 } },
+      {
+        options: { hmax: 0.5 },
+        sizing: [
+          { shape: "sphere", center: [0, 0, 0], radius: 0.4, size: 0.1 },
+        ],
+        iterations: 2,
+      },
+    ]);
+    meshes.push(result.mesh);
+
+    expect(result.success).toBe(true);
+    expect(result.stages).toHaveLength(2);
+    expect(result.stages[0].iterations).toBe(1);
+    expect(result.stages[1].iterations).toBeGreaterThanOrEqual(1);
+    expect(result.stages[1].nVertices).toBeGreaterThan(
+      result.stages[0].nVertices,
+    );
+    expect(result.nVertices).toBe(result.mesh.nVertices);
+    expect(result.qualityAfter).toBe(result.stages[1].qualityAfter);
+
+    // The input mesh is left unchanged
+    expect(mesh.nVertices).toBe(inputVertices);
+  });
+
+  it("should stop a stage once its vertex count settles", async () => {
+    const result = await runPipeline(createCube(), [
+      { options: { hmax: 0.3 }, iterations: 5, vertexTolerance: 0.5 },
+    ]);
+    meshes.push(result.mesh);
+
+    expect(result.stages[0].converged).toBe(true);
+    expect(result.stages[0].iterations).toBeLessThan(5);
+  });
+
+  it("should stop a stage once it reaches its target quality", async () => {
+    const result = await runPipeline(createCube(), [
+      { options: { hmax: 0.3 }, iterations: 3, targetQuality: 0 },
+    ]);
+    meshes.push(result.mesh);
+
+    expect(result.stages[0].converged).toBe(true);
+    expect(result.stages[0].iterations).toBe(1);
+  });
+
+  it("should run 2D pipelines", async () => {
+    const mesh = new Mesh({
+      vertices: squareVertices,
+      cells: squareTriangles,
+      boundaryFaces: squareEdges,
+    });
+    meshes.push(mesh);
+
+    const result = await runPipeline(mesh, [
+      { options: { hmax: 0.2 } },
+      {
+        sizing: [
+          { shape: "circle", center: [0.5, 0.5], radius: 0.2, size: 0.05 },
+        ],
+      },
+    ]);
+    meshes.push(result.mesh);
+
+    expect(result.mesh.type).toBe(MeshType.Mesh2D);
+    expect(result.stages).toHaveLength(2);
+  });
+
+  it("should fail a stage below its minimum quality", async () => {
+    await expect(
+      runPipeline(createCube(), [{ options: { hmax: 0.5 }, minQuality: 2 }]),
+    ).rejects.toThrow(/below the required/);
+  });
+
+  it("should reject invalid pipelines", () => {
+    expect(() => validatePipeline([])).toThrow(/at least one stage/);
+    expect(() => validatePipeline([{ iterations: 0 }])).toThrow(/iterations/);
+    expect(() => validatePipeline([{ iterations: 1.5 }])).toThrow(
+      /iterations/,
+    );
+    expect(() => validatePipeline([{ vertexTolerance: -1 }])).toThrow(
+      /vertexTolerance/,
+    );
+  });
+
+  it("should stop when aborted", async () => {
+    const controller = new AbortController();
+    controller.abort();
+    await expect(
+      runPipeline(createCube(), [{ options: { hmax: 0.5 } }], {
+        signal: controller.signal,
+      }),
+    ).rejects.toThrow(/aborted/);
+  });
+});
+
+describe("MeshWorkerPool", () => {
+  // Workers can't be spawned under Bun, so the pool schedules fake workers
+  // whose jobs complete when the test says so
+
+  const meshes: Mesh[] = [];
+
+  interface FakeWorker extends PoolWorker {
+    id: number;
+    terminated: boolean;
+  }
+
+  interface FakeJob {
+    worker: number;
+    mesh: Mesh;
+    finish: (memory?: RemeshMemory) => void;
+    fail: (error: Error) => void;
+  }
+
+  let workers: FakeWorker[];
+  let jobs: FakeJob[];
+
+  function createFakeWorker(): FakeWorker {
+    const worker: FakeWorker = {
+      id: workers.length,
+      terminated: false,
+      remesh: (mesh) =>
+        new Promise<RemeshResult>((resolve, reject) => {
+          jobs.push({
+            worker: worker.id,
+            mesh,
+            finish: (memory) => resolve({ mesh, memory } as RemeshResult),
+            fail: reject,
+          });
+        }),
+      pipeline: () => Promise.reject(new Error("Not used")),
+      // Parts of a partitioned remesh run in-process, right away
+      remeshBuffer: async (buffer, type, options, metric) => {
+        const mesh = await Mesh.load(buffer, { type, format: "meshb" });
+        try {
+          if (metric) {
+            mesh.setMetric(metric);
+          }
+          const result = await mesh.remesh(options);
+          const file = result.mesh.toArrayBuffer("meshb");
+          const sizes = result.mesh.metric;
+          result.mesh.free();
+          return { ...result, mesh: file, metric: sizes };
+        } finally {
+          mesh.free();
+        }
+      },
+      terminate: () => {
+        worker.terminated = true;
+        for (const job of jobs) {
+          if (job.worker === worker.id) {
+            job.fail(new Error("Worker terminated"));
+          }
+        }
+      },
+    };
+    workers.push(worker);
+    return worker;
+  }
+
+  // Let settled jobs release their worker and the pool dispatch again
+  const flush = () => new Promise((resolve) => setTimeout(resolve, 0));
+
+  // Submit a job whose outcome the test doesn't check
+  function submit(pool: MeshWorkerPool, mesh: Mesh): void {
+    pool.remesh(mesh).catch(() => undefined);
+  }
+
+  beforeAll(async () => {
+    await initMMG2D();
+    await initMMG3D();
+  });
+
+  afterEach(() => {
+    for (const mesh of meshes) {
+      try {
+        mesh.free();
+      } catch {
+        // Ignore
+      }
+    }
+    meshes.length = 0;
+  });
+
+  function createCube(): Mesh {
+    const mesh = new Mesh({
+      vertices: cubeVertices,
+      cells: cubeTetrahedra,
+      boundaryFaces: cubeTriangles,
+    });
+    meshes.push(mesh);
+    return mesh;
+  }
+
+  function createSquare(): Mesh {
+    const mesh = new Mesh({
+      vertices: squareVertices,
+      cells: squareTriangles,
+      boundaryFaces: squareEdges,
+    });
+    meshes.push(mesh);
+    return mesh;
+  }
+
+  function createPool(options = {}): MeshWorkerPool {
+    workers = [];
+    jobs = [];
+    return new MeshWorkerPool({ createWorker: createFakeWorker, ...options });
+  }
+
+  it("should estimate larger costs for larger meshes", () => {
+    expect(estimateJobCost(createCube())).toBeGreaterThan(
+      estimateJobCost(createSquare()),
+    );
+  });
+
+  it("should run cheaper queued jobs first", async () => {
+    const pool = createPool({ size: 1 });
+    const cube = createCube();
+    const square = createSquare();
+
+    const first = pool.remesh(createCube());
+    const large = pool.remesh(cube);
+    const small = pool.remesh(square);
+    expect(pool.stats).toEqual({ workers: 1, busy: 1, queued: 2 });
+
+    jobs[0].finish();
+    await first;
+    await flush();
+    expect(jobs[1].mesh).toBe(square);
+
+    jobs[1].finish();
+    expect((await small).mesh).toBe(square);
+    await flush();
+    expect(jobs[2].mesh).toBe(cube);
+    jobs[2].finish();
+    await large;
+    pool.terminate();
+  });
+
+  it("should serve jobs past their maximum wait first", async () => {
+    const pool = createPool({ size: 1, maxWait: 0 });
+    const cube = createCube();
+
+    submit(pool, createSquare());
+    submit(pool, cube);
+    submit(pool, createSquare());
+
+    jobs[0].finish();
+    await flush();
+    expect(jobs[1].mesh).toBe(cube);
+    pool.terminate();
+  });
+
+  it("should keep workers warm per mesh type", async () => {
+    const pool = createPool({ size: 2 });
+
+    const square = pool.remesh(createSquare());
+    const cube = pool.remesh(createCube());
+    expect(workers).toHaveLength(2);
+    jobs[0].finish();
+    jobs[1].finish();
+    await Promise.all([square, cube]);
+    await flush();
+
+    // Both workers are idle: each job goes to the worker of its type
+    submit(pool, createCube());
+    submit(pool, createSquare());
+    expect(jobs[2].worker).toBe(jobs[1].worker);
+    expect(jobs[3].worker).toBe(jobs[0].worker);
+    pool.terminate();
+  });
+
+  it("should reject jobs above the worker memory limit", async () => {
+    const pool = createPool({ maxWorkerMemory: 16 });
+    await expect(pool.remesh(createCube())).rejects.toThrow(/worker limit/);
+    expect(workers).toHaveLength(0);
+  });
+
+  it("should replace workers after large jobs", async () => {
+    const pool = createPool({ size: 1, recycleMemory: 16 });
+
+    const result = pool.remesh(createCube());
+    jobs[0].finish();
+    await result;
+    await flush();
+    expect(workers[0].terminated).toBe(true);
+    expect(pool.stats.workers).toBe(0);
+
+    submit(pool, createCube());
+    expect(workers).toHaveLength(2);
+    pool.terminate();
+  });
+
+  it("should replace workers whose heap grew large", async () => {
+    const pool = createPool({ size: 1, recycleMemory: 1024 * 1024 * 1024 });
+
+    const small = pool.remesh(createSquare());
+    jobs[0].finish({ heapSize: 16 << 20, nativeUsed: 0, nativePeak: 1 << 20 });
+    await small;
+    await flush();
+    expect(workers[0].terminated).toBe(false);
+
+    const large = pool.remesh(createSquare());
+    jobs[1].finish({ heapSize: 2 ** 31, nativeUsed: 0, nativePeak: 2 ** 30 });
+    await large;
+    await flush();
+    expect(workers[0].terminated).toBe(true);
+    expect(pool.stats.workers).toBe(0);
+    pool.terminate();
+  });
+
+  it("should not reuse a worker without room for the job", async () => {
+    const maxWorkerMemory = 64 * 1024 * 1024;
+    const pool = createPool({
+      size: 1,
+      maxWorkerMemory,
+      recycleMemory: maxWorkerMemory,
+    });
+
+    // The worker kept all but a few bytes of its limit after the first job
+    const first = pool.remesh(createCube());
+    const nativeUsed = maxWorkerMemory - 16;
+    jobs[0].finish({
+      heapSize: maxWorkerMemory,
+      nativeUsed,
+      nativePeak: nativeUsed,
+    });
+    await first;
+    await flush();
+
+    submit(pool, createCube());
+    expect(workers[0].terminated).toBe(true);
+    expect(workers).toHaveLength(2);
+    expect(jobs[1].worker).toBe(1);
+    pool.terminate();
+  });
+
+  it("should keep scheduling after a failed job", async () => {
+    const pool = createPool({ size: 1 });
+
+    const failed = pool.remesh(createSquare());
+    const next = pool.remesh(createSquare());
+    jobs[0].fail(new Error("Remeshing failed"));
+    await expect(failed).rejects.toThrow("Remeshing failed");
+    await flush();
+
+    jobs[1].finish();
+    await next;
+    expect(workers).toHaveLength(1);
+    pool.terminate();
+  });
+
+  it("should reject queued jobs on terminate", async () => {
+    const pool = createPool({ size: 1 });
+
+    submit(pool, createSquare());
+    const queued = pool.remesh(createSquare());
+    pool.terminate();
+
+    await expect(queued).rejects.toThrow("Worker pool terminated");
+    expect(workers[0].terminated).toBe(true);
+    await expect(pool.remesh(createSquare())).rejects.toThrow(
+      "Worker pool terminated",
+    );
+  });
+
+  it("should remesh a 3D mesh in parts on several workers", async () => {
+    const pool = createPool({ size: 2 });
+    const cube = createCube();
+    const fine = (await cube.remesh({ hsiz: 0.2 })).mesh;
+    meshes.push(fine);
+
+    const result = await pool.remeshPartitioned(fine, { hsiz: 0.1 });
+    meshes.push(result.mesh);
+
+    expect(workers.length).toBe(2);
+    expect(result.success).toBe(true);
+    expect(result.nVertices).toBeGreaterThan(fine.nVertices);
+    expect(result.mesh.nCells).toBe(result.nCells);
+    expect(result.qualityAfter).toBeGreaterThan(0);
+  });
+
+  it("should remesh the parts to the metric of the mesh", async () => {
+    const pool = createPool({ size: 2 });
+    const cube = createCube();
+    const fine = (await cube.remesh({ hsiz: 0.2 })).mesh;
+    meshes.push(fine);
+    fine.setMetric(new Float64Array(fine.nVertices).fill(0.1));
+
+    const result = await pool.remeshPartitioned(fine, {}, { passes: 1 });
+    meshes.push(result.mesh);
+
+    expect(result.success).toBe(true);
+    expect(result.nVertices).toBeGreaterThan(2 * fine.nVertices);
+    expect(result.mesh.metric?.length).toBe(result.nVertices);
+  });
+
+  it("should reject partitioned remeshing of other meshes", async () => {
+    const pool = createPool({ size: 2 });
+    await expect(pool.remeshPartitioned(createSquare())).rejects.toThrow(
+      "Partitioned remeshing is only available for 3D meshes",
+    );
+    await expect(
+      pool.remeshPartitioned(createCube(), {}, { passes: 0 }),
+    ).rejects.toThrow(/positive integer/);
+    const sized = createCube().setSizeSphere([0.5, 0.5, 0.5], 0.3, 0.05);
+    await expect(
+      pool.remeshPartitioned(sized, { hsiz: 0.1 }),
+    ).rejects.toThrow(/cannot be combined/);
+  });
+
+  it("should serve cached remeshes without dispatching a job", async () => {
+    const cache = new RemeshCache(new MemoryCacheStore());
+    const pool = createPool({ size: 1, cache });
+    const square = createSquare();
+    const stored = await square.remesh({ hsiz: 0.3 }, { cache });
+    meshes.push(stored.mesh);
+
+    const hit = await pool.remesh(square, { hsiz: 0.3 });
+    meshes.push(hit.mesh);
+    expect(hit.cached).toBe(true);
+    expect(hit.nVertices).toBe(stored.nVertices);
+    expect(workers.length).toBe(0);
+
+    // A miss hashes the mesh first, then queues its job
+    submit(pool, square);
+    for (let i = 0; i < 10 && jobs.length === 0; i++) {
+      await flush();
+    }
+    expect(jobs.length).toBe(1);
+    pool.terminate();
+  });
+
+  it("should validate its options", () => {
+    expect(() => createPool({ size: 0 })).toThrow(/positive integer/);
+    expect(() => createPool({ maxWorkerMemory: -1 })).toThrow(/positive/);
+  });
+});
+
 describe("Worker Message Types", () => {
   it("should have correct message structure types", async () => {
     // Import types to verify they compile correctly